@@ -0,0 +1,87 @@
+#include "BenchHarness.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// --- Allocation counting ---
+//
+// AtlasBench replaces the global allocation functions so every rep can
+// report how many heap allocations it made. Counters are relaxed
+// atomics: cheap, and exact once the measured work has joined. Kept
+// apart from BenchHarness.cpp so AtlasTests can link the harness
+// without taking over its allocator.
+
+namespace {
+
+std::atomic<uint64_t> s_allocCount{0};
+std::atomic<uint64_t> s_allocBytes{0};
+
+void* CountedAlloc(std::size_t size) {
+    s_allocCount.fetch_add(1, std::memory_order_relaxed);
+    s_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* CountedAlignedAlloc(std::size_t size, std::size_t align) {
+    s_allocCount.fetch_add(1, std::memory_order_relaxed);
+    s_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (align < sizeof(void*)) align = sizeof(void*);
+    void* p = nullptr;
+#if defined(_WIN32)
+    p = _aligned_malloc(size ? size : 1, align);
+#else
+    if (posix_memalign(&p, align, size ? size : 1) != 0) p = nullptr;
+#endif
+    return p;
+}
+
+void AlignedFree(void* p) {
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = CountedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = CountedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (void* p = CountedAlignedAlloc(size, static_cast<std::size_t>(align))) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    if (void* p = CountedAlignedAlloc(size, static_cast<std::size_t>(align))) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { AlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { AlignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { AlignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { AlignedFree(p); }
+
+namespace atlas::bench {
+
+uint64_t AllocationCount() {
+    return s_allocCount.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationBytes() {
+    return s_allocBytes.load(std::memory_order_relaxed);
+}
+
+}
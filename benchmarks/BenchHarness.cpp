@@ -0,0 +1,221 @@
+#include "BenchHarness.h"
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace atlas::bench {
+
+namespace {
+
+std::string s_section;
+std::vector<BenchResult> s_results;
+
+// Nearest-rank percentile of sorted samples
+double Percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    if (rank > 0) rank--;
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+void AppendEscaped(std::string& out, const std::string& text) {
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) < 0x20) continue;
+        out += c;
+    }
+}
+
+// Minimal reader for the flat format ResultsJson writes: an array of
+// objects whose values are strings or numbers
+class ResultsReader {
+public:
+    explicit ResultsReader(const std::string& text) : m_text(text) {}
+
+    bool Read(std::vector<BenchResult>& out) {
+        size_t results = m_text.find("\"results\"");
+        if (results == std::string::npos) return false;
+        m_pos = m_text.find('[', results);
+        if (m_pos == std::string::npos) return false;
+        ++m_pos;
+        for (;;) {
+            Skip();
+            if (m_pos >= m_text.size()) return false;
+            if (m_text[m_pos] == ']') return true;
+            if (m_text[m_pos] == ',') { ++m_pos; continue; }
+            if (m_text[m_pos] != '{') return false;
+            ++m_pos;
+            std::unordered_map<std::string, std::string> fields;
+            for (;;) {
+                Skip();
+                if (m_pos >= m_text.size()) return false;
+                if (m_text[m_pos] == '}') { ++m_pos; break; }
+                if (m_text[m_pos] == ',') { ++m_pos; continue; }
+                std::string key, value;
+                if (!String(key)) return false;
+                Skip();
+                if (m_pos >= m_text.size() || m_text[m_pos] != ':') return false;
+                ++m_pos;
+                Skip();
+                if (m_pos < m_text.size() && m_text[m_pos] == '"') {
+                    if (!String(value)) return false;
+                } else {
+                    size_t end = m_text.find_first_of(",}", m_pos);
+                    if (end == std::string::npos) return false;
+                    value = m_text.substr(m_pos, end - m_pos);
+                    m_pos = end;
+                }
+                fields[key] = value;
+            }
+            BenchResult r;
+            r.section = fields["section"];
+            r.name = fields["name"];
+            r.unit = fields["unit"];
+            r.items = Number(fields["items"]);
+            r.stats.reps = static_cast<int>(Number(fields["reps"]));
+            r.stats.warmup = static_cast<int>(Number(fields["warmup"]));
+            r.stats.medianMs = Number(fields["median_ms"]);
+            r.stats.p90Ms = Number(fields["p90_ms"]);
+            r.stats.minMs = Number(fields["min_ms"]);
+            r.stats.maxMs = Number(fields["max_ms"]);
+            r.stats.meanMs = Number(fields["mean_ms"]);
+            r.stats.allocs = Number(fields["allocs"]);
+            r.stats.allocBytes = Number(fields["alloc_bytes"]);
+            r.stats.ops = fields.count("ops") ? Number(fields["ops"]) : 1.0;
+            out.push_back(std::move(r));
+        }
+    }
+
+private:
+    void Skip() {
+        while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) ++m_pos;
+    }
+
+    bool String(std::string& out) {
+        if (m_pos >= m_text.size() || m_text[m_pos] != '"') return false;
+        for (++m_pos; m_pos < m_text.size(); ++m_pos) {
+            char c = m_text[m_pos];
+            if (c == '"') { ++m_pos; return true; }
+            if (c == '\\' && m_pos + 1 < m_text.size()) c = m_text[++m_pos];
+            out += c;
+        }
+        return false;
+    }
+
+    static double Number(const std::string& s) {
+        return s.empty() ? 0.0 : std::strtod(s.c_str(), nullptr);
+    }
+
+    const std::string& m_text;
+    size_t m_pos = 0;
+};
+
+}
+
+BenchStats Summarize(std::vector<double> samples, int warmup, uint64_t allocs, uint64_t bytes) {
+    BenchStats s;
+    s.reps = static_cast<int>(samples.size());
+    s.warmup = warmup;
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    s.medianMs = samples[samples.size() / 2];
+    s.p90Ms = Percentile(samples, 0.9);
+    s.minMs = samples.front();
+    s.maxMs = samples.back();
+    double total = 0.0;
+    for (double v : samples) total += v;
+    s.meanMs = total / static_cast<double>(samples.size());
+    s.allocs = static_cast<double>(allocs) / static_cast<double>(samples.size());
+    s.allocBytes = static_cast<double>(bytes) / static_cast<double>(samples.size());
+    return s;
+}
+
+void Report(const std::string& name, const BenchStats& stats, double items, const char* unit) {
+    double rate = stats.medianMs > 0.0 ? items / (stats.medianMs * 1000.0) : 0.0;
+    std::printf("  %-44s %10.3f ms  %10.2f M%s/s  p90 %9.3f  allocs %8.0f\n",
+                name.c_str(), stats.medianMs, rate, unit, stats.p90Ms, stats.allocs);
+    s_results.push_back({s_section, name, unit, items, stats});
+}
+
+void BeginSection(const std::string& section) {
+    s_section = section;
+}
+
+const std::vector<BenchResult>& Results() {
+    return s_results;
+}
+
+std::string ResultsJson(const std::vector<BenchResult>& results) {
+    std::string out = "{\n  \"schema\": 1,\n  \"results\": [";
+    char buf[512];
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        out += i ? ",\n    {" : "\n    {";
+        out += "\"section\": \"";
+        AppendEscaped(out, r.section);
+        out += "\", \"name\": \"";
+        AppendEscaped(out, r.name);
+        out += "\", \"unit\": \"";
+        AppendEscaped(out, r.unit);
+        std::snprintf(buf, sizeof(buf),
+                      "\", \"items\": %.17g, \"reps\": %d, \"warmup\": %d, "
+                      "\"median_ms\": %.6f, \"p90_ms\": %.6f, \"min_ms\": %.6f, \"max_ms\": %.6f, "
+                      "\"mean_ms\": %.6f, \"allocs\": %.3f, \"alloc_bytes\": %.1f, \"ops\": %.17g}",
+                      r.items, r.stats.reps, r.stats.warmup, r.stats.medianMs, r.stats.p90Ms,
+                      r.stats.minMs, r.stats.maxMs, r.stats.meanMs, r.stats.allocs, r.stats.allocBytes,
+                      r.stats.ops);
+        out += buf;
+    }
+    out += "\n  ]\n}\n";
+    return out;
+}
+
+bool WriteResultsJson(const std::string& path) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file << ResultsJson(s_results);
+    return static_cast<bool>(file);
+}
+
+bool LoadResultsJson(const std::string& path, std::vector<BenchResult>& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::stringstream ss;
+    ss << file.rdbuf();
+    std::string text = ss.str();
+    return ResultsReader(text).Read(out);
+}
+
+std::vector<Comparison> Compare(const std::vector<BenchResult>& baseline,
+                                const std::vector<BenchResult>& current,
+                                double threshold, double noiseFloorMs) {
+    std::unordered_map<std::string, const BenchResult*> byKey;
+    for (const auto& r : baseline) byKey[r.section + "/" + r.name] = &r;
+
+    std::vector<Comparison> out;
+    for (const auto& r : current) {
+        std::string key = r.section + "/" + r.name;
+        auto it = byKey.find(key);
+        if (it == byKey.end()) continue;
+        Comparison c;
+        c.key = key;
+        c.baselineMs = it->second->stats.medianMs;
+        c.currentMs = r.stats.medianMs;
+        c.change = c.baselineMs > 0.0 ? (c.currentMs - c.baselineMs) / c.baselineMs : 0.0;
+        // The fastest rep must have slowed down too, so one noisy rep
+        // cannot flag a result on its own
+        double baseMin = it->second->stats.minMs;
+        double minChange = baseMin > 0.0 ? (r.stats.minMs - baseMin) / baseMin : 0.0;
+        // The floor applies to what was actually timed: a per-op result
+        // is its whole rep divided by ops
+        bool measurable = c.baselineMs * it->second->stats.ops >= noiseFloorMs ||
+                          c.currentMs * r.stats.ops >= noiseFloorMs;
+        c.regression = measurable && c.change > threshold && minChange > threshold;
+        out.push_back(std::move(c));
+    }
+    return out;
+}
+
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Timing helpers shared by the benchmark translation units.
+//
+// Measure runs a workload `warmup` times untimed, then `reps` times
+// timed, and summarises the samples (median, p90, min, max, mean)
+// together with the heap allocations made per rep; AtlasBench counts
+// them through its global operator new. Report prints a result and
+// records it under the current section for the JSON output and the
+// baseline comparison (see main.cpp).
+
+namespace atlas::bench {
+
+struct BenchStats {
+    int reps = 0;
+    int warmup = 0;
+    double medianMs = 0.0;
+    double p90Ms = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+    double meanMs = 0.0;
+    double allocs = 0.0;        // heap allocations per rep
+    double allocBytes = 0.0;    // bytes requested per rep
+    double ops = 1.0;           // operations per timed rep (see PerOp)
+
+    /// The same run expressed per operation, for workloads that loop
+    /// `ops` times per rep.
+    BenchStats PerOp(double ops) const {
+        BenchStats s = *this;
+        s.medianMs /= ops; s.p90Ms /= ops; s.minMs /= ops; s.maxMs /= ops; s.meanMs /= ops;
+        s.allocs /= ops; s.allocBytes /= ops;
+        s.ops *= ops;
+        return s;
+    }
+};
+
+/// Heap allocations (count, bytes) since the process started, all
+/// threads. Defined in BenchAllocations.cpp, which only AtlasBench links.
+uint64_t AllocationCount();
+uint64_t AllocationBytes();
+
+BenchStats Summarize(std::vector<double> samples, int warmup, uint64_t allocs, uint64_t bytes);
+
+template <typename Fn>
+BenchStats Measure(int reps, Fn&& fn, int warmup = 1) {
+    for (int i = 0; i < warmup; ++i) fn();
+    std::vector<double> samples;
+    samples.reserve(reps);
+    uint64_t allocsBefore = AllocationCount();
+    uint64_t bytesBefore = AllocationBytes();
+    for (int i = 0; i < reps; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return Summarize(std::move(samples), warmup,
+                     AllocationCount() - allocsBefore, AllocationBytes() - bytesBefore);
+}
+
+/// Print a result line and record it for JSON output / comparison.
+/// `items` processed per rep give the throughput column.
+void Report(const std::string& name, const BenchStats& stats, double items, const char* unit);
+
+// --- Result collection (driven by main.cpp) ---
+
+struct BenchResult {
+    std::string section;
+    std::string name;
+    std::string unit;
+    double items = 0.0;
+    BenchStats stats;
+};
+
+void BeginSection(const std::string& section);
+const std::vector<BenchResult>& Results();
+
+std::string ResultsJson(const std::vector<BenchResult>& results);
+bool WriteResultsJson(const std::string& path);
+
+/// Reads a file written by WriteResultsJson.
+bool LoadResultsJson(const std::string& path, std::vector<BenchResult>& out);
+
+struct Comparison {
+    std::string key;            // "section/name"
+    double baselineMs = 0.0;
+    double currentMs = 0.0;
+    double change = 0.0;        // (current - baseline) / baseline
+    bool regression = false;
+};
+
+/// Match results by section and name and flag those whose median and
+/// fastest rep are both slower than the baseline by more than
+/// `threshold` (0.10 = 10%). Results whose timed rep (median times
+/// ops, so per-op results are judged by the whole loop) is faster than
+/// `noiseFloorMs` in both runs are never flagged.
+std::vector<Comparison> Compare(const std::vector<BenchResult>& baseline,
+                                const std::vector<BenchResult>& current,
+                                double threshold, double noiseFloorMs = 0.05);
+
+}
@@ -0,0 +1,94 @@
+#include "BenchHarness.h"
+#include "../engine/assets/AssetArchive.h"
+#include "../engine/assets/AssetRegistry.h"
+#include "../engine/sim/StateHasher.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace atlas::asset;
+
+// Startup cost of discovering and reading every cooked asset: a loose
+// directory (scan, then open/read/hash each file) against one packed
+// archive (open, then look up/view/hash each id). Both run on a warm
+// page cache, so this measures per-file syscall and lookup overhead
+// rather than disk seeks.
+void bench_asset_archive_startup() {
+    const int count = 2000;
+    const size_t size = 2048;
+    auto root = std::filesystem::temp_directory_path() / "atlas_bench_archive";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "loose");
+    std::string archivePath = (root / "assets.atlaspak").string();
+
+    AssetArchiveWriter writer;
+    std::vector<std::string> ids;
+    for (int i = 0; i < count; ++i) {
+        std::string id = "asset_" + std::to_string(i);
+        std::vector<uint8_t> data(size, static_cast<uint8_t>(i));
+        {
+            std::ofstream out(root / "loose" / (id + ".atlas"), std::ios::binary);
+            out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        }
+        writer.Add(id, std::move(data));
+        ids.push_back(id);
+    }
+    writer.Write(archivePath);
+
+    uint64_t sink = 0;
+    auto looseMs = atlas::bench::Measure(5, [&] {
+        AssetRegistry registry;
+        registry.Scan((root / "loose").string());
+        for (const auto& entry : registry.GetAll()) {
+            std::ifstream in(entry.path, std::ios::binary);
+            std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            sink ^= atlas::sim::StateHasher::HashCombine(0, bytes.data(), bytes.size());
+        }
+    });
+    atlas::bench::Report("asset startup loose files", looseMs, count, "asset");
+
+    auto archiveMs = atlas::bench::Measure(5, [&] {
+        AssetArchive archive;
+        archive.Open(archivePath);
+        AssetRegistry registry;
+        registry.ScanArchive(archive);
+        for (const auto& id : ids) {
+            auto view = archive.View(id);
+            sink ^= atlas::sim::StateHasher::HashCombine(0, view.data(), view.size());
+        }
+    });
+    atlas::bench::Report("asset startup packed archive", archiveMs, count, "asset");
+
+    if (sink == 1) std::filesystem::remove(archivePath);   // keep the hashes live
+    std::filesystem::remove_all(root);
+}
+
+// Idle hot-reload poll over a large registry: one stat per asset against
+// draining an empty change queue.
+void bench_asset_hot_reload_idle() {
+    const int count = 10000;
+    const int polls = 20;
+    auto root = std::filesystem::temp_directory_path() / "atlas_bench_hot_reload";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    for (int i = 0; i < count; ++i) {
+        std::ofstream(root / ("asset_" + std::to_string(i) + ".atlas")) << i;
+    }
+
+    AssetRegistry registry;
+    registry.Scan(root.string());
+    auto pollMs = atlas::bench::Measure(5, [&] {
+        for (int p = 0; p < polls; ++p) registry.PollHotReload();
+    });
+    atlas::bench::Report("hot reload idle poll (timestamps)", pollMs, static_cast<double>(polls) * count, "asset");
+
+    if (registry.EnableFileWatcher()) {
+        auto watchMs = atlas::bench::Measure(5, [&] {
+            for (int p = 0; p < polls; ++p) registry.PollHotReload();
+        });
+        atlas::bench::Report("hot reload idle poll (file watcher)", watchMs, static_cast<double>(polls) * count, "asset");
+    }
+
+    std::filesystem::remove_all(root);
+}
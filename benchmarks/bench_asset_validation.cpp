@@ -0,0 +1,56 @@
+#include "BenchHarness.h"
+#include "../engine/assets/ServerAssetValidator.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace atlas::asset;
+
+// Server boot validation of a manifest: serial FNV-1a (the previous
+// pipeline), the job pool with FNV-1a and XXH64, and a warm restart
+// served from the hash cache.
+void bench_server_asset_validation() {
+    const int count = 1000;
+    const size_t size = 64 * 1024;
+    auto root = std::filesystem::temp_directory_path() / "atlas_bench_validation";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+
+    std::vector<uint8_t> payload(size);
+    for (size_t i = 0; i < size; ++i) payload[i] = static_cast<uint8_t>(i * 31 + 7);
+    uint64_t fnv = HashAssetBytes(payload.data(), size, AssetHashAlgorithm::Fnv1a);
+    uint64_t xxh = HashAssetBytes(payload.data(), size, AssetHashAlgorithm::XXH64);
+    for (int i = 0; i < count; ++i) {
+        AssetHeader hdr;
+        hdr.size = static_cast<uint32_t>(size);
+        std::ofstream out(root / ("asset_" + std::to_string(i) + ".atlasb"), std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(size));
+    }
+
+    auto run = [&](const char* name, AssetHashAlgorithm algorithm, bool parallel, const std::string& cache) {
+        ServerAssetValidator validator;
+        for (int i = 0; i < count; ++i) {
+            validator.RegisterAsset("asset_" + std::to_string(i),
+                                    algorithm == AssetHashAlgorithm::XXH64 ? xxh : fnv, 1, algorithm);
+        }
+        validator.SetParallel(parallel);
+        uint32_t failed = 0;
+        // Each rep reloads the cache, so with one set only the first rep is cold
+        auto ms = atlas::bench::Measure(3, [&] {
+            validator.SetHashCachePath(cache);
+            std::vector<ServerValidationResult> results;
+            failed += validator.ValidateAll(root.string(), results);
+        });
+        atlas::bench::Report(failed ? "validation FAILED" : name, ms,
+                             static_cast<double>(count) * size, "B");
+    };
+
+    run("validate serial fnv1a", AssetHashAlgorithm::Fnv1a, false, "");
+    run("validate parallel fnv1a", AssetHashAlgorithm::Fnv1a, true, "");
+    run("validate parallel xxh64", AssetHashAlgorithm::XXH64, true, "");
+    std::string cache = (root / "hash.cache").string();
+    run("validate warm hash cache", AssetHashAlgorithm::XXH64, true, cache);
+
+    std::filesystem::remove_all(root);
+}
@@ -0,0 +1,52 @@
+#include "BenchHarness.h"
+#include "../engine/audio/AudioMixer.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace atlas::audio;
+
+void bench_audio_mixer_256_voices() {
+    MixerSettings settings;
+    settings.maxVoices = 256;
+    AudioMixer mixer(settings);
+
+    // Half mono, half stereo; a third at unity pitch (copy fast path)
+    std::vector<AudioClip> clips(2);
+    for (uint32_t c = 0; c < 2; ++c) {
+        clips[c].channels = c + 1;
+        clips[c].sampleRate = c ? 44100 : 48000;
+        clips[c].samples.resize(48000 * clips[c].channels);
+        for (size_t i = 0; i < clips[c].samples.size(); ++i) {
+            clips[c].samples[i] = std::sin(static_cast<float>(i) * 0.01f) * 0.1f;
+        }
+    }
+    for (uint16_t v = 0; v < settings.maxVoices; ++v) {
+        MixerCommand cmd;
+        cmd.type = MixerCommandType::Play;
+        cmd.voice = v;
+        cmd.sound = v + 1u;
+        cmd.clip = &clips[v & 1];
+        cmd.values[0] = 0.5f;
+        cmd.values[1] = (v % 3 == 0) ? 1.0f : 0.5f + (v % 7) * 0.2f;
+        cmd.values[2] = std::cos(v * 0.3f) * (1.0f + v % 20);
+        cmd.values[4] = std::sin(v * 0.3f) * (1.0f + v % 20);
+        cmd.looping = true;
+        cmd.spatial = v % 4 != 0;
+        mixer.Push(cmd);
+    }
+
+    std::vector<float> block(settings.blockFrames * 2);
+    const int blocks = 400;
+    auto ms = atlas::bench::Measure(3, [&] {
+        for (int b = 0; b < blocks; ++b) mixer.RenderBlock(block.data());
+    });
+
+    double frames = static_cast<double>(blocks) * settings.blockFrames;
+    atlas::bench::Report("256 voices, 256-frame blocks", ms, frames * settings.maxVoices, "voice-frames");
+    MixerStats stats = mixer.GetStats();
+    double audioMs = frames * 1000.0 / settings.sampleRate;
+    std::printf("  %-44s %10.2f us/block  %8.1f ns/voice-block  %6.2f%% of real time\n",
+                "  mixer stats", stats.MicrosPerBlock(), stats.NanosPerVoiceBlock(),
+                100.0 * ms.medianMs / audioMs);
+}
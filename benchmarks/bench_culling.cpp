@@ -0,0 +1,77 @@
+#include "BenchHarness.h"
+#include "../engine/camera/Culling.h"
+#include <cstdio>
+
+using namespace atlas::camera;
+
+namespace {
+
+// A 128 x 128 field of 16-unit terrain chunks plus scattered entities,
+// seen from just above the ground; a few walls close to the camera
+// hide much of what lies beyond them
+void BuildScene(AABBList& bounds) {
+    for (int z = -64; z < 64; ++z) {
+        for (int x = -64; x < 64; ++x) {
+            bounds.Add({x * 16.0f, -4.0f, z * 16.0f}, {x * 16.0f + 16.0f, 4.0f, z * 16.0f + 16.0f});
+        }
+    }
+    uint32_t seed = 7;
+    auto next = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / 16777216.0f;
+    };
+    for (int i = 0; i < 200000; ++i) {
+        Vec3 c{next() * 2048.0f - 1024.0f, next() * 8.0f, next() * 2048.0f - 1024.0f};
+        bounds.Add(c - Vec3{0.5f, 0.0f, 0.5f}, c + Vec3{0.5f, 2.0f, 0.5f});
+    }
+}
+
+}
+
+void bench_culling_render_lists() {
+    AABBList bounds;
+    BuildScene(bounds);
+    double items = static_cast<double>(bounds.Size());
+
+    Camera cam;
+    cam.SetPosition(0.0f, 6.0f, 0.0f);
+    cam.SetYawPitch(20.0f, -5.0f);
+    cam.SetFOV(70.0f);
+    cam.SetClipPlanes(0.5f, 1500.0f);
+
+    CullingStage stage;
+    stage.SetView(cam, 16.0f / 9.0f);
+    std::vector<uint32_t> visible;
+
+    // Everything the renderer would get without a culling stage
+    size_t sink = 0;
+    auto scalarMs = atlas::bench::Measure(5, [&] {
+        sink = 0;
+        for (size_t i = 0; i < bounds.Size(); ++i) {
+            sink += stage.GetFrustum().TestAABB({bounds.minX[i], bounds.minY[i], bounds.minZ[i]},
+                                                {bounds.maxX[i], bounds.maxY[i], bounds.maxZ[i]});
+        }
+    });
+    atlas::bench::Report("frustum, scalar AoS loop", scalarMs, items, "box");
+
+    auto serialMs = atlas::bench::Measure(5, [&] { stage.Cull(bounds, visible, bounds.Size()); });
+    atlas::bench::Report("frustum, SoA single job", serialMs, items, "box");
+
+    auto parallelMs = atlas::bench::Measure(5, [&] { stage.Cull(bounds, visible); });
+    atlas::bench::Report("frustum, SoA parallel", parallelMs, items, "box");
+    size_t frustumVisible = visible.size();
+
+    // Walls across the view 30-60 units out
+    for (int i = 0; i < 6; ++i) {
+        float x = -40.0f + i * 18.0f;
+        stage.Occlusion().AddOccluderBox({x, -4.0f, 40.0f + i * 4.0f}, {x + 16.0f, 30.0f, 42.0f + i * 4.0f});
+    }
+    auto rasterMs = atlas::bench::Measure(1, [&] { stage.Occlusion().BuildHiZ(); }, 0);
+    atlas::bench::Report("occlusion HiZ build (256x128)", rasterMs, 256.0 * 128.0, "px");
+
+    auto occlusionMs = atlas::bench::Measure(5, [&] { stage.Cull(bounds, visible); });
+    char name[64];
+    std::snprintf(name, sizeof(name), "frustum + occlusion (%zu -> %zu)", frustumVisible, visible.size());
+    atlas::bench::Report(name, occlusionMs, items, "box");
+    if (sink != frustumVisible) std::printf("  (scalar/SoA mismatch: %zu vs %zu)\n", sink, frustumVisible);
+}
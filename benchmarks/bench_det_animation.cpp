@@ -0,0 +1,68 @@
+#include "BenchHarness.h"
+#include "../engine/animation/DeterministicAnimationGraph.h"
+#include <cmath>
+#include <memory>
+
+using namespace atlas::animation;
+
+namespace {
+
+PoseInputNode* BuildLocomotionGraph(DeterministicAnimationGraph& graph) {
+    auto input = std::make_unique<PoseInputNode>();
+    PoseInputNode* inputNode = input.get();
+    auto inputID = graph.AddNode(std::move(input));
+    auto restID = graph.AddNode(std::make_unique<RestPoseNode>());
+    auto fkID = graph.AddNode(std::make_unique<FKNode>());
+    auto ikID = graph.AddNode(std::make_unique<IKNode>());
+    auto blendID = graph.AddNode(std::make_unique<BlendTreeNode>());
+    auto addID = graph.AddNode(std::make_unique<AdditiveBlendNode>());
+    graph.AddEdge({inputID, 0, fkID, 0});
+    graph.AddEdge({fkID, 0, ikID, 0});
+    graph.AddEdge({ikID, 0, blendID, 0});
+    graph.AddEdge({restID, 0, blendID, 1});
+    graph.AddEdge({blendID, 0, addID, 0});
+    graph.AddEdge({inputID, 0, addID, 1});
+    graph.Compile();
+    return inputNode;
+}
+
+}
+
+void bench_det_animation_crowd() {
+    const uint32_t skeletons = 512;
+    BoneContext ctx;
+    ctx.boneCount = 32;
+
+    CrowdPose poses;
+    poses.Resize(skeletons, ctx.boneCount);
+    for (uint32_t i = 0; i < skeletons; ++i) {
+        for (uint32_t b = 0; b < ctx.boneCount; ++b) {
+            BoneTransform t;
+            t.posX = std::sin(i * 0.37f + b);
+            t.posY = static_cast<float>(b) * 0.1f;
+            t.posZ = std::cos(i * 0.11f - b);
+            poses.SetBone(i, b, t);
+        }
+    }
+
+    DeterministicAnimationGraph single;
+    PoseInputNode* singleInput = BuildLocomotionGraph(single);
+    auto singleMs = atlas::bench::Measure(3, [&] {
+        for (uint32_t i = 0; i < skeletons; ++i) {
+            poses.GatherInstance(i, singleInput->pose);
+            single.Execute(ctx);
+        }
+    });
+
+    DeterministicAnimationGraph crowd;
+    BuildLocomotionGraph(crowd)->crowd = &poses;
+    CrowdEvalOptions serial;
+    serial.parallel = false;
+    auto crowdMs = atlas::bench::Measure(3, [&] { crowd.ExecuteCrowd(ctx, skeletons, serial); });
+    auto parallelMs = atlas::bench::Measure(3, [&] { crowd.ExecuteCrowd(ctx, skeletons); });
+
+    double bones = static_cast<double>(skeletons) * ctx.boneCount;
+    atlas::bench::Report("512 x 32 bones, per-skeleton Execute", singleMs, bones, "bones");
+    atlas::bench::Report("512 x 32 bones, ExecuteCrowd (1 thread)", crowdMs, bones, "bones");
+    atlas::bench::Report("512 x 32 bones, ExecuteCrowd (jobs)", parallelMs, bones, "bones");
+}
@@ -0,0 +1,86 @@
+#include "BenchHarness.h"
+#include "../engine/ecs/ECS.h"
+#include "../engine/net/Replication.h"
+#include <cstdio>
+
+using namespace atlas::ecs;
+
+namespace {
+
+struct BenchPosition { float x, y, z; };
+struct BenchVelocity { float x, y, z; };
+
+constexpr uint32_t kPositionTag = 1;
+constexpr uint32_t kVelocityTag = 2;
+
+// `count` entities with a position, every other one also moving
+void Populate(World& world, uint32_t count) {
+    world.RegisterComponent<BenchPosition>(kPositionTag);
+    world.RegisterComponent<BenchVelocity>(kVelocityTag);
+    for (uint32_t i = 0; i < count; ++i) {
+        EntityID e = world.CreateEntity();
+        world.AddComponent<BenchPosition>(e, {static_cast<float>(i), 0.0f, 0.0f});
+        if (i % 2 == 0) world.AddComponent<BenchVelocity>(e, {1.0f, 0.5f, 0.0f});
+    }
+}
+
+}
+
+void bench_ecs_iterate_and_serialize() {
+    const uint32_t entities = 10000;
+    World world;
+    Populate(world, entities);
+
+    auto iterateMs = atlas::bench::Measure(5, [&] {
+        for (EntityID e : world.GetEntities()) {
+            auto* v = world.GetComponent<BenchVelocity>(e);
+            if (!v) continue;
+            auto* p = world.GetComponent<BenchPosition>(e);
+            p->x += v->x; p->y += v->y; p->z += v->z;
+        }
+    });
+    atlas::bench::Report("ecs iterate position+velocity (10k)", iterateMs, entities, "entity");
+
+    std::vector<uint8_t> blob;
+    auto serializeMs = atlas::bench::Measure(5, [&] { blob = world.Serialize(); });
+    atlas::bench::Report("ecs serialize (10k)", serializeMs, entities, "entity");
+
+    World restored;
+    restored.RegisterComponent<BenchPosition>(kPositionTag);
+    restored.RegisterComponent<BenchVelocity>(kVelocityTag);
+    auto deserializeMs = atlas::bench::Measure(5, [&] { restored.Deserialize(blob); });
+    atlas::bench::Report("ecs deserialize (10k)", deserializeMs, entities, "entity");
+    if (restored.EntityCount() != entities) std::printf("  (restored %zu entities)\n", restored.EntityCount());
+}
+
+void bench_replication_delta_collection() {
+    const uint32_t entities = 5000;
+    World world;
+    Populate(world, entities);
+
+    atlas::net::ReplicationManager mgr;
+    mgr.SetWorld(&world);
+    atlas::net::ReplicationRule position;
+    position.typeTag = kPositionTag;
+    position.componentName = "Position";
+    mgr.AddRule(position);
+    atlas::net::ReplicationRule velocity;
+    velocity.typeTag = kVelocityTag;
+    velocity.componentName = "Velocity";
+    velocity.frequency = atlas::net::ReplicateFrequency::EveryTick;
+    velocity.reliable = false;
+    mgr.AddRule(velocity);
+
+    std::vector<EntityID> ids = world.GetEntities();
+    uint32_t tick = 0;
+    size_t bytes = 0;
+    // A quarter of the positions change each tick
+    auto deltaMs = atlas::bench::Measure(5, [&] {
+        ++tick;
+        for (size_t i = tick % 4; i < ids.size(); i += 4) mgr.MarkDirty(kPositionTag, ids[i]);
+        bytes = mgr.CollectDelta(tick).size() + mgr.CollectUnreliableDelta(tick).size();
+    });
+    char name[64];
+    std::snprintf(name, sizeof(name), "replication delta, 5k entities (%zu B)", bytes);
+    atlas::bench::Report(name, deltaMs, entities, "entity");
+}
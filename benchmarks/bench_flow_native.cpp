@@ -0,0 +1,72 @@
+#include "BenchHarness.h"
+#include "../engine/flow/FlowGraphNative.h"
+#include <cstdio>
+#include <filesystem>
+
+using namespace atlas::flow;
+
+namespace {
+
+// A chain of `stages` state machine steps:
+// State -> Transition <- Condition, Transition -> Timer -> next State
+FlowGraphIR MakeChain(uint32_t stages) {
+    FlowGraphIR ir;
+    ir.name = "BenchChain" + std::to_string(stages);
+    ir.graphType = "Gameplay";
+    uint32_t id = 1;
+    uint32_t prevTimer = 0;
+    for (uint32_t s = 0; s < stages; ++s) {
+        uint32_t state = id++, cond = id++, trans = id++, timer = id++;
+        FlowNodeIR n;
+        n.id = state; n.type = "State";
+        n.properties.push_back({"stateName", "Stage" + std::to_string(s)});
+        ir.nodes.push_back(n);
+        n.properties.clear();
+        n.id = cond; n.type = "Condition"; ir.nodes.push_back(n);
+        n.id = trans; n.type = "Transition"; ir.nodes.push_back(n);
+        n.id = timer; n.type = "Timer"; ir.nodes.push_back(n);
+        if (prevTimer) ir.edges.push_back({prevTimer, 0, state, 0});
+        ir.edges.push_back({state, 0, trans, 0});
+        ir.edges.push_back({cond, 0, trans, 1});
+        ir.edges.push_back({trans, 0, timer, 0});
+        prevTimer = timer;
+    }
+    return ir;
+}
+
+}
+
+void bench_flow_interpreted_vs_native() {
+    std::string dir = (std::filesystem::temp_directory_path() / "atlas_bench_flow").string();
+    for (uint32_t stages : {8u, 64u}) {
+        FlowGraphIR ir = MakeChain(stages);
+        FlowNativeBuildResult build = FlowGraphNativeBuilder::Build(ir, dir);
+        if (!build.success) {
+            std::printf("  native build failed: %s\n", build.log.c_str());
+            return;
+        }
+
+        FlowGraphRuntime interpreted;
+        interpreted.Load(ir);
+        FlowGraphRuntime native;
+        native.Load(ir, build.libraryPath);
+
+        const int runs = static_cast<int>(16000 / stages);
+        auto run = [&](FlowGraphRuntime& rt) {
+            for (int i = 0; i < runs; ++i) {
+                rt.Execute({static_cast<float>(i) * 0.01f, false, static_cast<uint32_t>(i)});
+            }
+        };
+        auto interpMs = atlas::bench::Measure(3, [&] { run(interpreted); });
+        auto nativeMs = atlas::bench::Measure(3, [&] { run(native); });
+
+        double nodes = static_cast<double>(runs) * ir.nodes.size();
+        char label[64];
+        std::snprintf(label, sizeof(label), "%zu nodes, interpreted", ir.nodes.size());
+        atlas::bench::Report(label, interpMs, nodes, "nodes");
+        std::snprintf(label, sizeof(label), "%zu nodes, native%s", ir.nodes.size(),
+                      native.IsNative() ? "" : " (fallback!)");
+        atlas::bench::Report(label, nativeMs, nodes, "nodes");
+    }
+    std::filesystem::remove_all(dir);
+}
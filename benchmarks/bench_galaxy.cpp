@@ -0,0 +1,49 @@
+#include "BenchHarness.h"
+#include "../engine/world/GalaxyGenerator.h"
+#include <cstdio>
+
+using namespace atlas::world;
+
+void bench_galaxy_region_streaming() {
+    GalaxyParams params;
+    params.systemCount = 1000000;
+    params.seed = 42;
+
+    size_t sink = 0;
+    auto fullMs = atlas::bench::Measure(1, [&] {
+        sink += GalaxyGenerator::Generate(params).size();
+    }, 0);
+    atlas::bench::Report("galaxy full generate (1M systems)", fullMs, 1e6, "system");
+
+    // A streaming window of ~2000 ly sliding across the inner disk
+    GalaxyGenerator generator(params);
+    auto setupMs = atlas::bench::Measure(1, [&] { GalaxyGenerator fresh(params); }, 0);
+    atlas::bench::Report("galaxy generator setup", setupMs, 1.0, "generator");
+
+    size_t found = 0;
+    auto coldMs = atlas::bench::Measure(1, [&] {
+        for (int step = 0; step < 20; ++step) {
+            double x = -20000.0 + step * 2000.0;
+            found += generator.Region(x, -1000.0, x + 2000.0, 1000.0).size();
+        }
+    }, 0);
+    char name[64];
+    std::snprintf(name, sizeof(name), "galaxy region cold (avg %zu systems)", found / 20);
+    atlas::bench::Report(name, coldMs.PerOp(20), 1.0, "region");
+
+    auto warmMs = atlas::bench::Measure(5, [&] {
+        for (int step = 0; step < 20; ++step) {
+            double x = -20000.0 + step * 2000.0;
+            sink += generator.Region(x, -1000.0, x + 2000.0, 1000.0).size();
+        }
+    });
+    atlas::bench::Report("galaxy region cached", warmMs.PerOp(20), 1.0, "region");
+
+    auto nearestMs = atlas::bench::Measure(5, [&] {
+        for (int i = 0; i < 100; ++i) {
+            sink += generator.Nearest(-15000.0 + i * 300.0, 0.0, 500.0, 16).size();
+        }
+    });
+    atlas::bench::Report("galaxy nearest k=16", nearestMs.PerOp(100), 1.0, "query");
+    if (sink == 0) std::printf("  (empty galaxy)\n");
+}
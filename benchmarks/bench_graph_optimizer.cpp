@@ -0,0 +1,67 @@
+#include "BenchHarness.h"
+#include "../engine/graphvm/GraphOptimizer.h"
+#include <cstdio>
+
+using namespace atlas::vm;
+
+namespace {
+
+// `statements` assignments of the shape
+//   v[k] = (v0 + c) * (v0 + c) + (a * b) - v1 / 1
+// with a constant-guarded branch every eighth statement.
+Bytecode MakeProgram(uint32_t statements) {
+    Bytecode bc;
+    auto constant = [&bc](Value v) {
+        bc.constants.push_back(v);
+        return static_cast<uint32_t>(bc.constants.size() - 1);
+    };
+    auto emit = [&bc](OpCode op, uint32_t a = 0) { bc.instructions.push_back({op, a, 0, 0}); };
+
+    for (uint32_t s = 0; s < statements; ++s) {
+        uint32_t c = constant(static_cast<Value>(s % 7));
+        emit(OpCode::LOAD_VAR, 0); emit(OpCode::LOAD_CONST, c); emit(OpCode::ADD);
+        emit(OpCode::LOAD_VAR, 0); emit(OpCode::LOAD_CONST, c); emit(OpCode::ADD);
+        emit(OpCode::MUL);
+        emit(OpCode::LOAD_CONST, constant(3)); emit(OpCode::LOAD_CONST, constant(4)); emit(OpCode::MUL);
+        emit(OpCode::ADD);
+        emit(OpCode::LOAD_VAR, 1); emit(OpCode::LOAD_CONST, constant(1)); emit(OpCode::DIV);
+        emit(OpCode::SUB);
+        emit(OpCode::STORE_VAR, 2 + s);
+        if (s % 8 == 7) {
+            // if (0) { v1 = 0 }
+            emit(OpCode::LOAD_CONST, constant(0));
+            emit(OpCode::JUMP_IF_FALSE, static_cast<uint32_t>(bc.instructions.size() + 3));
+            emit(OpCode::LOAD_CONST, constant(0));
+            emit(OpCode::STORE_VAR, 1);
+        }
+    }
+    emit(OpCode::END);
+    return bc;
+}
+
+}
+
+void bench_graph_optimizer_levels() {
+    const uint32_t statements = 256;
+    const int runs = 200;
+    Bytecode program = MakeProgram(statements);
+
+    for (OptLevel level : {OptLevel::O0, OptLevel::O1, OptLevel::O2}) {
+        OptimizerStats stats;
+        Bytecode bc = BytecodeOptimizer::Optimize(program, level, &stats);
+        VerifyOptions verify;
+        verify.trials = 16;
+        bool ok = VerifyEquivalence(program, bc, verify).equivalent;
+
+        GraphVM vm;
+        VMContext ctx;
+        ctx.inputs = {5, 9};
+        auto ms = atlas::bench::Measure(5, [&] {
+            for (int r = 0; r < runs; ++r) vm.Execute(bc, ctx);
+        });
+        char name[64];
+        std::snprintf(name, sizeof(name), "graph vm O%d (%u instructions)%s",
+                      static_cast<int>(level), stats.instructionsAfter, ok ? "" : " MISMATCH");
+        atlas::bench::Report(name, ms, static_cast<double>(runs) * statements, "stmt");
+    }
+}
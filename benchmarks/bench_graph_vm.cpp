@@ -0,0 +1,42 @@
+#include "BenchHarness.h"
+#include "../engine/graphvm/GraphVM.h"
+#include <cstdio>
+
+using namespace atlas::vm;
+
+namespace {
+
+// for (v0 = 0; v0 < iterations; ++v0) v1 = v1 + v0 * 3
+Bytecode MakeLoop(Value iterations) {
+    Bytecode bc;
+    bc.constants = {iterations, 1, 3};
+    auto emit = [&bc](OpCode op, uint32_t a = 0) { bc.instructions.push_back({op, a, 0, 0}); };
+    uint32_t top = 0;
+    emit(OpCode::LOAD_VAR, 0); emit(OpCode::LOAD_CONST, 0); emit(OpCode::CMP_LT);
+    emit(OpCode::JUMP_IF_FALSE, 15);
+    emit(OpCode::LOAD_VAR, 1); emit(OpCode::LOAD_VAR, 0); emit(OpCode::LOAD_CONST, 2); emit(OpCode::MUL);
+    emit(OpCode::ADD); emit(OpCode::STORE_VAR, 1);
+    emit(OpCode::LOAD_VAR, 0); emit(OpCode::LOAD_CONST, 1); emit(OpCode::ADD); emit(OpCode::STORE_VAR, 0);
+    emit(OpCode::JUMP, top);
+    emit(OpCode::END);
+    return bc;
+}
+
+}
+
+void bench_graph_vm_dispatch() {
+    const Value iterations = 20000;
+    Bytecode loop = MakeLoop(iterations);
+    GraphVM vm;
+    uint64_t steps = 0;
+    auto ms = atlas::bench::Measure(5, [&] {
+        VMContext ctx;
+        ctx.inputs = {0, 0};
+        vm.Execute(loop, ctx);
+        steps = vm.StepCount();
+    });
+    char name[64];
+    std::snprintf(name, sizeof(name), "graph vm dispatch loop (%llu steps)", static_cast<unsigned long long>(steps));
+    atlas::bench::Report(name, ms, static_cast<double>(steps), "instr");
+    if (vm.GetLocal(0) != iterations) std::printf("  (loop ended at %lld)\n", static_cast<long long>(vm.GetLocal(0)));
+}
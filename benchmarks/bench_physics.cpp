@@ -0,0 +1,28 @@
+#include "BenchHarness.h"
+#include "../engine/physics/PhysicsWorld.h"
+#include <cstdio>
+
+using namespace atlas::physics;
+
+void bench_physics_step() {
+    const uint32_t bodies = 1000;
+    PhysicsWorld world;
+    world.Init();
+    for (uint32_t i = 0; i < bodies; ++i) {
+        BodyID id = world.CreateBody(1.0f, i % 10 == 0);
+        world.SetPosition(id, static_cast<float>(i % 32), static_cast<float>(i / 32) * 0.9f, 0.0f);
+        world.SetVelocity(id, 0.1f, 0.0f, 0.0f);
+    }
+
+    const int steps = 10;
+    size_t contacts = 0;
+    auto ms = atlas::bench::Measure(3, [&] {
+        for (int s = 0; s < steps; ++s) {
+            world.Step(1.0f / 60.0f);
+            contacts = world.GetCollisions().size();
+        }
+    });
+    char name[64];
+    std::snprintf(name, sizeof(name), "physics step, 1000 bodies (%zu contacts)", contacts);
+    atlas::bench::Report(name, ms.PerOp(steps), bodies, "body");
+}
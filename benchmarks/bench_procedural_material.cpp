@@ -0,0 +1,51 @@
+#include "BenchHarness.h"
+#include "../engine/procedural/ProceduralMaterialGraph.h"
+#include <string>
+
+using namespace atlas::procedural;
+
+static void BuildChain(ProceduralMaterialGraph& graph, uint32_t size) {
+    std::string s = std::to_string(size);
+    auto noise = graph.AddNode(MaterialNodeType::Noise);
+    graph.SetNodeProperty(noise, "width", s);
+    graph.SetNodeProperty(noise, "height", s);
+    graph.SetNodeProperty(noise, "seed", "42");
+    auto checker = graph.AddNode(MaterialNodeType::Checker);
+    graph.SetNodeProperty(checker, "width", s);
+    graph.SetNodeProperty(checker, "height", s);
+    graph.SetNodeProperty(checker, "tileSize", "32");
+    auto blend = graph.AddNode(MaterialNodeType::Blend);
+    auto normal = graph.AddNode(MaterialNodeType::NormalMap);
+    auto out = graph.AddNode(MaterialNodeType::Output);
+    graph.AddEdge({noise, 0, blend, 0});
+    graph.AddEdge({checker, 0, blend, 1});
+    graph.AddEdge({blend, 0, normal, 0});
+    graph.AddEdge({normal, 0, out, 0});
+    graph.Compile();
+}
+
+void bench_material_full_vs_tiled() {
+    for (uint32_t size : {1024u, 2048u, 4096u}) {
+        ProceduralMaterialGraph graph;
+        BuildChain(graph, size);
+        double pixels = static_cast<double>(size) * size;
+        int reps = size >= 4096 ? 3 : 5;
+        std::string tag = std::to_string(size) + "^2 ";
+
+        auto full = atlas::bench::Measure(reps, [&] { graph.Execute(); });
+        atlas::bench::Report((tag + "full image").c_str(), full, pixels, "px");
+
+        TiledEvalOptions serial;
+        serial.parallel = false;
+        auto tiled = atlas::bench::Measure(reps, [&] { graph.ExecuteTiled(serial); });
+        atlas::bench::Report((tag + "tiled, 1 thread").c_str(), tiled, pixels, "px");
+
+        auto parallel = atlas::bench::Measure(reps, [&] { graph.ExecuteTiled(); });
+        atlas::bench::Report((tag + "tiled, job system").c_str(), parallel, pixels, "px");
+
+        TiledEvalOptions half;
+        half.format = MaterialPixelFormat::Float16;
+        auto halfMs = atlas::bench::Measure(reps, [&] { graph.ExecuteTiled(half); });
+        atlas::bench::Report((tag + "tiled, job system, fp16").c_str(), halfMs, pixels, "px");
+    }
+}
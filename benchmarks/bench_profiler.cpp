@@ -0,0 +1,59 @@
+#include "BenchHarness.h"
+#include "../engine/core/Profiler.h"
+#include <cstdio>
+
+using namespace atlas::profile;
+
+namespace {
+
+// Below the per-thread ring capacity, so nothing is dropped between drains
+constexpr int kScopes = 4096;
+
+void RunScopes(volatile uint64_t& sink) {
+    for (int i = 0; i < kScopes / 2; ++i) {
+        ATLAS_PROFILE_SCOPE("Bench.Outer");
+        {
+            ATLAS_PROFILE_SCOPE("Bench.Inner");
+            sink = sink + 1;
+        }
+    }
+}
+
+}
+
+void bench_profiler_scope_overhead() {
+    volatile uint64_t sink = 0;
+    double items = static_cast<double>(kScopes);
+
+    auto baselineMs = atlas::bench::Measure(21, [&] {
+        for (int i = 0; i < kScopes / 2; ++i) sink = sink + 1;
+    });
+
+    Profiler::SetEnabled(false);
+    auto disabledMs = atlas::bench::Measure(21, [&] { RunScopes(sink); });
+    atlas::bench::Report("scope, runtime disabled", disabledMs, items, "scope");
+
+    Profiler::SetEnabled(true);
+    Profiler::Get().EndFrame(0);
+    auto enabledMs = atlas::bench::Measure(21, [&] {
+        RunScopes(sink);
+        Profiler::SetEnabled(false);
+        Profiler::Get().EndFrame(0);
+        Profiler::SetEnabled(true);
+    });
+    // Drain cost on its own, to subtract from the enabled figure
+    auto drainMs = atlas::bench::Measure(21, [&] {
+        Profiler::SetEnabled(false);
+        Profiler::Get().EndFrame(0);
+        Profiler::SetEnabled(true);
+    });
+    Profiler::SetEnabled(false);
+    atlas::bench::Report("scope, enabled (incl. drain)", enabledMs, items, "scope");
+
+    double perScopeNs = (enabledMs.medianMs - drainMs.medianMs - baselineMs.medianMs) * 1e6 / items;
+    std::printf("  %-44s %10.1f ns\n", "per-scope overhead, enabled", perScopeNs);
+    std::printf("  %-44s %10.1f ns\n", "per-scope overhead, disabled", (disabledMs.medianMs - baselineMs.medianMs) * 1e6 / items);
+    if (Profiler::Get().DroppedCount() != 0) {
+        std::printf("  (dropped %llu events)\n", static_cast<unsigned long long>(Profiler::Get().DroppedCount()));
+    }
+}
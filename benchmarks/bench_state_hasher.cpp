@@ -0,0 +1,25 @@
+#include "BenchHarness.h"
+#include "../engine/sim/StateHasher.h"
+#include <cstdio>
+
+using namespace atlas::sim;
+
+void bench_state_hasher_ladder() {
+    // A 256 KiB world snapshot and a small input frame per tick
+    std::vector<uint8_t> state(256 * 1024);
+    std::vector<uint8_t> inputs(64);
+    for (size_t i = 0; i < state.size(); ++i) state[i] = static_cast<uint8_t>(i * 31 + 7);
+
+    const int ticks = 16;
+    StateHasher hasher;
+    auto ms = atlas::bench::Measure(5, [&] {
+        hasher.Reset(42);
+        for (int t = 0; t < ticks; ++t) {
+            state[static_cast<size_t>(t)] ^= 1;
+            hasher.AdvanceTick(static_cast<uint64_t>(t), state, inputs);
+        }
+    });
+    atlas::bench::Report("state hasher, 256 KiB per tick", ms.PerOp(ticks),
+                         static_cast<double>(state.size() + inputs.size()), "B");
+    if (hasher.CurrentHash() == 0) std::printf("  (zero hash)\n");
+}
@@ -0,0 +1,79 @@
+#include "BenchHarness.h"
+#include "../engine/tile/TileChunkBuilder.h"
+#include <cstdio>
+#include <map>
+#include <set>
+
+using namespace atlas::tile;
+using namespace atlas::editor;
+
+namespace {
+
+constexpr int32_t kMapSize = 4096;
+
+// The previous Build: scan the whole layer, sort the chunk's tiles
+size_t ScanBuild(const TileLayer& layer, const ChunkCoord& chunk) {
+    std::map<std::pair<int32_t, int32_t>, TileInstance> sorted;
+    for (const auto& [coord, tile] : layer.tiles) {
+        if (TileChunkBuilder::IsInsideChunk(coord, chunk)) sorted[{coord.x, coord.y}] = tile;
+    }
+    return sorted.size();
+}
+
+// Circular brush stamps along diagonal strokes, marking chunks dirty
+void Strokes(TileLayer& layer, std::set<ChunkCoord>& dirty, uint32_t tileId) {
+    const int32_t radius = 6;
+    for (int32_t stroke = 0; stroke < 32; ++stroke) {
+        int32_t x = 64 + stroke * 120, y = 100 + stroke * 37;
+        for (int32_t stamp = 0; stamp < 64; ++stamp, x += 3, y += 2) {
+            for (int32_t dy = -radius; dy <= radius; ++dy) {
+                for (int32_t dx = -radius; dx <= radius; ++dx) {
+                    if (dx * dx + dy * dy > radius * radius) continue;
+                    GridCoord c{x + dx, y + dy};
+                    layer.tiles[c].tileAssetId = tileId;
+                    TileChunkBuilder::MarkDirty(dirty, c);
+                }
+            }
+        }
+    }
+}
+
+}
+
+void bench_tile_chunk_rebuild() {
+    TileMap map;
+    TileLayer layer;
+    auto fillMs = atlas::bench::Measure(1, [&] {
+        for (int32_t y = 0; y < kMapSize; ++y) {
+            for (int32_t x = 0; x < kMapSize; ++x) layer.tiles[{x, y}].tileAssetId = 1;
+        }
+    }, 0);
+    atlas::bench::Report("tile layer fill (4096x4096)", fillMs, double(kMapSize) * kMapSize, "tile");
+
+    // Initial mesh for every chunk
+    std::map<ChunkCoord, TileChunk> chunks;
+    std::set<ChunkCoord> dirty;
+    for (int32_t cy = 0; cy < kMapSize / TileChunkBuilder::kChunkSize; ++cy) {
+        for (int32_t cx = 0; cx < kMapSize / TileChunkBuilder::kChunkSize; ++cx) dirty.insert({cx, cy});
+    }
+    size_t chunkCount = dirty.size();
+    auto fullMs = atlas::bench::Measure(1, [&] { TileChunkBuilder::RebuildDirty(map, layer, dirty, chunks); }, 0);
+    atlas::bench::Report("tile full rebuild", fullMs, double(chunkCount), "chunk");
+
+    // Brush strokes, then rebuild only what they touched
+    size_t strokeDirty = 0;
+    auto strokeMs = atlas::bench::Measure(5, [&] {
+        Strokes(layer, dirty, 2);
+        strokeDirty = dirty.size();
+        TileChunkBuilder::RebuildDirty(map, layer, dirty, chunks);
+    });
+    char name[64];
+    std::snprintf(name, sizeof(name), "tile strokes + rebuild (%zu dirty)", strokeDirty);
+    atlas::bench::Report(name, strokeMs, double(strokeDirty), "chunk");
+
+    // One chunk the old way, for scale: every dirty chunk paid this
+    size_t sink = 0;
+    auto scanMs = atlas::bench::Measure(1, [&] { sink += ScanBuild(layer, {10, 10}); }, 0);
+    atlas::bench::Report("tile full-layer scan (1 chunk)", scanMs, 1.0, "chunk");
+    if (sink == 0) std::printf("  (empty chunk)\n");
+}
@@ -0,0 +1,51 @@
+#include "BenchHarness.h"
+#include "../engine/ui/UILayoutSolver.h"
+#include "../engine/ui/UIManager.h"
+#include "../engine/ui/UIRenderer.h"
+#include <cstdio>
+#include <string>
+
+using namespace atlas::ui;
+
+void bench_ui_layout_and_render() {
+    const uint32_t entries = 2000;
+    UILayoutSolver solver;
+    for (uint32_t i = 0; i < entries; ++i) {
+        UIConstraint c;
+        c.minWidth = 20;
+        c.preferredWidth = 40 + static_cast<int32_t>(i % 50);
+        c.maxWidth = 200;
+        c.weight = 1.0f + static_cast<float>(i % 3);
+        solver.AddEntry(i + 1, c);
+    }
+    auto layoutMs = atlas::bench::Measure(5, [&] {
+        solver.Solve({0, 0, 1920, 1080}, LayoutDirection::Horizontal);
+        solver.Solve({0, 0, 1920, 1080}, LayoutDirection::Vertical);
+    });
+    atlas::bench::Report("ui layout solve (2k entries, 2 axes)", layoutMs, 2.0 * entries, "entry");
+
+    // An editor-like screen: 20 panels of 24 labelled buttons each
+    UIManager manager;
+    manager.Init(GUIContext::Editor);
+    UIScreen& screen = manager.GetScreen();
+    uint32_t widgets = 0;
+    for (int p = 0; p < 20; ++p) {
+        uint32_t panel = screen.AddWidget(UIWidgetType::Panel, "Panel" + std::to_string(p),
+                                          (p % 5) * 380.0f, (p / 5) * 260.0f, 370.0f, 250.0f);
+        widgets++;
+        for (int b = 0; b < 24; ++b) {
+            uint32_t button = screen.AddWidget(UIWidgetType::Button, "Button " + std::to_string(b),
+                                               (p % 5) * 380.0f + (b % 4) * 90.0f,
+                                               (p / 5) * 260.0f + 20.0f + (b / 4) * 36.0f, 84.0f, 30.0f);
+            screen.SetParent(button, panel);
+            widgets++;
+        }
+    }
+    NullUIRenderer renderer;
+    auto renderMs = atlas::bench::Measure(5, [&] {
+        renderer.BeginFrame();
+        manager.Render(&renderer);
+        renderer.EndFrame();
+    });
+    atlas::bench::Report("ui render editor screen (500 widgets)", renderMs, widgets, "widget");
+}
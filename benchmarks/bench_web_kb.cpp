@@ -0,0 +1,78 @@
+#include "BenchHarness.h"
+#include "../engine/ai/WebAggregationKB.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <string>
+
+using namespace atlas::ai;
+
+namespace {
+
+// Pseudo-words with a skewed frequency: low indices are common
+std::string Word(uint32_t& seed, uint32_t vocabulary) {
+    seed = seed * 1664525u + 1013904223u;
+    uint32_t r = (seed >> 8) % vocabulary;
+    uint32_t index = (r * r) / vocabulary;
+    static const char* syllables[] = {"ka", "to", "ri", "en", "mo", "sa", "lu", "ne", "vi", "do"};
+    std::string word;
+    do {
+        word += syllables[index % 10];
+        index /= 10;
+    } while (index > 0);
+    return word;
+}
+
+void Fill(WebAggregationKB& kb, size_t count) {
+    uint32_t seed = 42;
+    for (size_t i = 0; i < count; ++i) {
+        KBEntry e;
+        for (int w = 0; w < 5; ++w) e.title += Word(seed, 20000) + " ";
+        for (int w = 0; w < 40; ++w) e.content += Word(seed, 20000) + " ";
+        e.category = "cat" + std::to_string(i % 20);
+        kb.AddEntry(e);
+    }
+}
+
+// The previous Search: lowercase every entry, substring match
+size_t LinearScan(const WebAggregationKB& kb, size_t count, const std::string& query) {
+    size_t matches = 0;
+    for (uint64_t id = 1; id <= count; ++id) {
+        const KBEntry* e = kb.GetEntry(id);
+        std::string title = e->title, content = e->content;
+        for (auto& c : title) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        for (auto& c : content) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (title.find(query) != std::string::npos || content.find(query) != std::string::npos) ++matches;
+    }
+    return matches;
+}
+
+}
+
+void bench_web_kb_query_latency() {
+    // A rare word, a very common one, two-word conjunctions and a prefix
+    const char* queries[] = {"samoenrito", "en", "ri kato", "samo", "vidoka lu"};
+    const int queryCount = sizeof(queries) / sizeof(queries[0]);
+
+    for (size_t count : {size_t(10000), size_t(100000)}) {
+        WebAggregationKB kb;
+        auto buildMs = atlas::bench::Measure(1, [&] { Fill(kb, count); }, 0);
+        std::string thousands = std::to_string(count / 1000) + "k";
+        atlas::bench::Report("kb index build (" + thousands + " entries)", buildMs,
+                             static_cast<double>(count), "entry");
+
+        size_t sink = 0, matches = 0;
+        for (const char* q : queries) matches += kb.Search(q, 10).totalMatches;
+        auto queryMs = atlas::bench::Measure(5, [&] {
+            for (const char* q : queries) sink += kb.Search(q, 10).totalMatches;
+        });
+        atlas::bench::Report("kb bm25 query (" + thousands + ", avg " + std::to_string(matches / queryCount) + " hits)",
+                             queryMs.PerOp(queryCount), 1.0, "query");
+
+        auto scanMs = atlas::bench::Measure(1, [&] {
+            for (const char* q : queries) sink += LinearScan(kb, count, q);
+        }, 0);
+        atlas::bench::Report("kb linear scan (" + thousands + " entries)", scanMs.PerOp(queryCount), 1.0, "query");
+        if (sink == 0) std::printf("  (no matches)\n");
+    }
+}
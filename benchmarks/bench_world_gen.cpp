@@ -0,0 +1,66 @@
+#include "BenchHarness.h"
+#include "../engine/world/NoiseGenerator.h"
+#include "../engine/world/WorldNodes.h"
+#include <cstdio>
+#include <memory>
+
+using namespace atlas::world;
+
+void bench_noise_fields() {
+    const int size = 256;
+    double sink = 0.0;
+    auto perlinMs = atlas::bench::Measure(5, [&] {
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) sink += NoiseGenerator::Perlin2D(x * 0.05f, y * 0.05f, 7);
+        }
+    });
+    atlas::bench::Report("perlin 2d (256x256)", perlinMs, double(size) * size, "sample");
+
+    auto fbmMs = atlas::bench::Measure(5, [&] {
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) sink += NoiseGenerator::FBM2D(x * 0.01f, y * 0.01f, 6, 2.0f, 0.5f, 7);
+        }
+    });
+    atlas::bench::Report("fbm 2d, 6 octaves (256x256)", fbmMs, double(size) * size, "sample");
+    if (sink == 0.0) std::printf("  (flat noise)\n");
+}
+
+void bench_world_graph_chunks() {
+    // Seed -> noise (elevation, moisture) -> erosion -> biome
+    WorldGraph graph;
+    NodeID seed = graph.AddNode(std::make_unique<SeedNode>());
+    auto lowFreq = std::make_unique<ConstantNode>();
+    lowFreq->value = 0.01f;
+    NodeID lowFreqId = graph.AddNode(std::move(lowFreq));
+    auto highFreq = std::make_unique<ConstantNode>();
+    highFreq->value = 0.05f;
+    NodeID highFreqId = graph.AddNode(std::move(highFreq));
+    NodeID elevation = graph.AddNode(std::make_unique<NoiseNode>());
+    NodeID moisture = graph.AddNode(std::make_unique<NoiseNode>());
+    auto erosionNode = std::make_unique<ErosionNode>();
+    erosionNode->iterations = 20;
+    NodeID erosion = graph.AddNode(std::move(erosionNode));
+    NodeID biome = graph.AddNode(std::make_unique<BiomeNode>());
+    graph.AddEdge({seed, 0, elevation, 0});
+    graph.AddEdge({lowFreqId, 0, elevation, 1});
+    graph.AddEdge({seed, 0, moisture, 0});
+    graph.AddEdge({highFreqId, 0, moisture, 1});
+    graph.AddEdge({elevation, 0, erosion, 0});
+    graph.AddEdge({seed, 0, erosion, 1});
+    graph.AddEdge({erosion, 0, biome, 0});
+    graph.AddEdge({moisture, 0, biome, 1});
+    if (!graph.Compile()) {
+        std::printf("  (world graph failed to compile)\n");
+        return;
+    }
+
+    const int chunks = 16;
+    auto ms = atlas::bench::Measure(3, [&] {
+        for (int c = 0; c < chunks; ++c) {
+            WorldGenContext ctx{12345, 0, c % 4, 0, c / 4};
+            graph.Execute(ctx);
+        }
+    });
+    atlas::bench::Report("world graph chunk (noise, erosion, biome)", ms.PerOp(chunks), 1.0, "chunk");
+    if (!graph.GetOutput(biome, 0)) std::printf("  (no biome output)\n");
+}
@@ -0,0 +1,193 @@
+#include "BenchHarness.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Procedural material
+void bench_material_full_vs_tiled();
+
+// Audio
+void bench_audio_mixer_256_voices();
+
+// Animation
+void bench_det_animation_crowd();
+
+// Flow graphs
+void bench_flow_interpreted_vs_native();
+
+// ECS and simulation
+void bench_ecs_iterate_and_serialize();
+void bench_state_hasher_ladder();
+
+// Graph VM
+void bench_graph_optimizer_levels();
+void bench_graph_vm_dispatch();
+
+// Assets
+void bench_asset_archive_startup();
+void bench_asset_hot_reload_idle();
+void bench_server_asset_validation();
+
+// Knowledge base
+void bench_web_kb_query_latency();
+
+// Culling
+void bench_culling_render_lists();
+
+// Networking
+void bench_replication_delta_collection();
+
+// Physics
+void bench_physics_step();
+
+// UI
+void bench_ui_layout_and_render();
+
+// Profiler
+void bench_profiler_scope_overhead();
+
+// World
+void bench_galaxy_region_streaming();
+void bench_tile_chunk_rebuild();
+void bench_noise_fields();
+void bench_world_graph_chunks();
+
+static void Usage() {
+    std::cout << "usage: AtlasBench [filter] [--json out.json] [--baseline base.json]\n"
+                 "                  [--threshold percent]\n"
+                 "  filter      only run sections whose name contains it\n"
+                 "  --json      write every result (median, p90, allocations) as JSON\n"
+                 "  --baseline  compare medians against a previous --json file and\n"
+                 "              exit with status 2 if any got slower than the threshold\n"
+                 "  --threshold allowed slowdown in percent (default 10)\n";
+}
+
+int main(int argc, char** argv) {
+    const char* filter = nullptr;
+    std::string jsonPath, baselinePath;
+    double threshold = 0.10;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            baselinePath = argv[++i];
+        } else if (arg == "--threshold" && hasValue) {
+            threshold = std::atof(argv[++i]) / 100.0;
+        } else if (arg.rfind("--", 0) == 0 || filter) {
+            Usage();
+            return 1;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    std::vector<atlas::bench::BenchResult> baseline;
+    if (!baselinePath.empty() && !atlas::bench::LoadResultsJson(baselinePath, baseline)) {
+        std::cerr << "Cannot read baseline " << baselinePath << std::endl;
+        return 1;
+    }
+
+    auto section = [filter](const char* name) {
+        if (filter && !std::strstr(name, filter)) return false;
+        std::cout << "\n--- " << name << " ---" << std::endl;
+        atlas::bench::BeginSection(name);
+        return true;
+    };
+
+    std::cout << "=== Atlas Benchmarks ===" << std::endl;
+
+    if (section("Procedural Material")) {
+        bench_material_full_vs_tiled();
+    }
+
+    if (section("Audio")) {
+        bench_audio_mixer_256_voices();
+    }
+
+    if (section("Animation")) {
+        bench_det_animation_crowd();
+    }
+
+    if (section("Flow Graph")) {
+        bench_flow_interpreted_vs_native();
+    }
+
+    if (section("ECS")) {
+        bench_ecs_iterate_and_serialize();
+    }
+
+    if (section("Simulation")) {
+        bench_state_hasher_ladder();
+    }
+
+    if (section("Graph VM")) {
+        bench_graph_optimizer_levels();
+        bench_graph_vm_dispatch();
+    }
+
+    if (section("Assets")) {
+        bench_asset_archive_startup();
+        bench_asset_hot_reload_idle();
+        bench_server_asset_validation();
+    }
+
+    if (section("Knowledge Base")) {
+        bench_web_kb_query_latency();
+    }
+
+    if (section("Culling")) {
+        bench_culling_render_lists();
+    }
+
+    if (section("Networking")) {
+        bench_replication_delta_collection();
+    }
+
+    if (section("Physics")) {
+        bench_physics_step();
+    }
+
+    if (section("UI")) {
+        bench_ui_layout_and_render();
+    }
+
+    if (section("Profiler")) {
+        bench_profiler_scope_overhead();
+    }
+
+    if (section("World")) {
+        bench_galaxy_region_streaming();
+        bench_tile_chunk_rebuild();
+        bench_noise_fields();
+        bench_world_graph_chunks();
+    }
+
+    if (!jsonPath.empty()) {
+        if (!atlas::bench::WriteResultsJson(jsonPath)) {
+            std::cerr << "Cannot write " << jsonPath << std::endl;
+            return 1;
+        }
+        std::cout << "\nWrote " << atlas::bench::Results().size() << " results to " << jsonPath << std::endl;
+    }
+
+    if (!baselinePath.empty()) {
+        auto comparisons = atlas::bench::Compare(baseline, atlas::bench::Results(), threshold);
+        size_t regressions = 0;
+        std::cout << "\n--- Comparison with " << baselinePath << " ---" << std::endl;
+        for (const auto& c : comparisons) {
+            std::printf("  %-60s %10.3f -> %10.3f ms  %+7.1f%%%s\n", c.key.c_str(), c.baselineMs,
+                        c.currentMs, c.change * 100.0, c.regression ? "  REGRESSION" : "");
+            if (c.regression) regressions++;
+        }
+        std::printf("%zu compared, %zu regressed by more than %.0f%%\n",
+                    comparisons.size(), regressions, threshold * 100.0);
+        if (regressions > 0) return 2;
+    }
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "JobTracePanel.h"
+#include <algorithm>
 #include <cstdio>
 
 namespace atlas::editor {
@@ -17,6 +18,17 @@ void JobTracePanel::Draw() {
 
     int32_t y = 28;
 
+    // Thread lanes from the profiler, along the bottom
+    char laneBuf[96];
+    int32_t laneY = 400 - 18 * static_cast<int32_t>(std::min<size_t>(m_lanes.size(), 8));
+    for (size_t i = 0; i < m_lanes.size() && i < 8; ++i) {
+        const auto& lane = m_lanes[i];
+        std::snprintf(laneBuf, sizeof(laneBuf), "Thread %-3u %6u scopes  %8.3f ms busy",
+                      lane.threadId, lane.scopeCount, lane.busyMs);
+        m_drawList.DrawText({4, laneY, 590, 16}, laneBuf, {160, 200, 240, 255});
+        laneY += 18;
+    }
+
     if (!m_tracer) {
         m_drawList.DrawText({4, y, 590, 16}, "No tracer attached", {160, 160, 160, 255});
         return;
@@ -67,10 +79,30 @@ void JobTracePanel::SetReferenceTracer(const sim::JobTracer* reference) {
     m_reference = reference;
 }
 
+void JobTracePanel::SetProfiler(const profile::Profiler* profiler) {
+    m_profiler = profiler;
+}
+
 void JobTracePanel::Refresh() {
     m_summaries.clear();
     m_firstMismatch = -1;
 
+    m_lanes.clear();
+    if (m_profiler) {
+        for (const auto& e : m_profiler->LastFrame().events) {
+            auto it = std::find_if(m_lanes.begin(), m_lanes.end(),
+                                   [&](const ThreadLane& l) { return l.threadId == e.threadId; });
+            if (it == m_lanes.end()) {
+                m_lanes.push_back({e.threadId, 0, 0.0});
+                it = m_lanes.end() - 1;
+            }
+            it->scopeCount++;
+            if (e.depth == 0) it->busyMs += profile::TicksToMicroseconds(e.end - e.begin) / 1000.0;
+        }
+        std::sort(m_lanes.begin(), m_lanes.end(),
+                  [](const ThreadLane& a, const ThreadLane& b) { return a.threadId < b.threadId; });
+    }
+
     if (!m_tracer) return;
 
     const auto& history = m_tracer->History();
@@ -122,6 +154,10 @@ std::string JobTracePanel::Summary() const {
     return std::string(buf);
 }
 
+const std::vector<ThreadLane>& JobTracePanel::ThreadLanes() const {
+    return m_lanes;
+}
+
 std::vector<sim::JobTraceEntry> JobTracePanel::EntriesAtTick(uint64_t tick) const {
     if (!m_tracer) return {};
     const auto* trace = m_tracer->TraceAtTick(tick);
@@ -1,6 +1,7 @@
 #pragma once
 #include "../ui/EditorPanel.h"
 #include "../../engine/sim/JobTracer.h"
+#include "../../engine/core/Profiler.h"
 #include "../../engine/ui/UIDrawList.h"
 #include <string>
 #include <vector>
@@ -15,6 +16,13 @@ struct JobTraceSummary {
     bool orderMatches = true;  ///< True if order matches reference trace
 };
 
+/// Per-thread activity in the latest profiler frame.
+struct ThreadLane {
+    uint32_t threadId = 0;
+    uint32_t scopeCount = 0;
+    double busyMs = 0.0;       ///< Time inside top-level scopes
+};
+
 /// Editor panel for visualizing job execution traces.
 /// Shows which systems ran in what order each tick and detects
 /// non-deterministic execution ordering.
@@ -25,12 +33,15 @@ public:
 
     void SetTracer(const sim::JobTracer* tracer);
     void SetReferenceTracer(const sim::JobTracer* reference);
+    /// Show per-thread activity from the CPU profiler's latest frame.
+    void SetProfiler(const profile::Profiler* profiler);
     void Refresh();
 
     const std::vector<JobTraceSummary>& Summaries() const;
     bool HasOrderMismatch() const;
     int64_t FirstMismatchTick() const;
     std::string Summary() const;
+    const std::vector<ThreadLane>& ThreadLanes() const;
 
     /// Get detailed entries for a specific tick.
     std::vector<sim::JobTraceEntry> EntriesAtTick(uint64_t tick) const;
@@ -40,6 +51,8 @@ public:
 private:
     const sim::JobTracer* m_tracer = nullptr;
     const sim::JobTracer* m_reference = nullptr;
+    const profile::Profiler* m_profiler = nullptr;
+    std::vector<ThreadLane> m_lanes;
     std::vector<JobTraceSummary> m_summaries;
     int64_t m_firstMismatch = -1;
     atlas::ui::UIDrawList m_drawList;
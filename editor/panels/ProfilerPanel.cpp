@@ -1,10 +1,20 @@
 #include "ProfilerPanel.h"
 #include <algorithm>
+#include <cstring>
 #include <numeric>
+#include <string_view>
 
 namespace atlas::editor {
 
 void ProfilerPanel::Draw() {
+    if (m_profiler) {
+        const auto& frame = m_profiler->LastFrame();
+        if (frame.end != m_lastProfileFrameEnd) {
+            m_lastProfileFrameEnd = frame.end;
+            RecordProfileFrame(frame);
+        }
+    }
+
     m_drawList.Clear();
 
     // Background
@@ -37,9 +47,12 @@ void ProfilerPanel::Draw() {
     // System metrics
     int32_t metricY = 160;
     for (const auto& metric : m_currentMetrics) {
+        if (metricY > 380) break;
         std::string line = metric.systemName + ": "
             + std::to_string(metric.durationMs).substr(0, 6) + " ms";
-        m_drawList.DrawText({4, metricY, 400, 16}, line, {200, 200, 200, 255});
+        if (metric.callCount > 1) line += " (x" + std::to_string(metric.callCount) + ")";
+        int32_t indent = static_cast<int32_t>(std::min<uint32_t>(metric.depth, 8) * 12);
+        m_drawList.DrawText({4 + indent, metricY, 400, 16}, line, {200, 200, 200, 255});
         metricY += 18;
     }
 }
@@ -58,6 +71,47 @@ void ProfilerPanel::RecordSystemMetric(const SystemMetric& metric) {
     m_currentMetrics.push_back(metric);
 }
 
+void ProfilerPanel::RecordProfileFrame(const profile::ProfileFrame& frame) {
+    if (m_paused) return;
+
+    FrameTiming timing;
+    timing.frameNumber = frame.frameNumber;
+    timing.frameDurationMs = frame.DurationMs();
+
+    // Merge scopes by (name, depth), in order of first appearance
+    std::vector<SystemMetric> metrics;
+    for (const auto& e : frame.events) {
+        if (!e.name) continue;
+        double ms = profile::TicksToMicroseconds(e.end - e.begin) / 1000.0;
+        if (e.depth == 0) {
+            if (std::strcmp(e.name, "Tick") == 0) timing.tickDurationMs += ms;
+            else if (std::strcmp(e.name, "Render") == 0) timing.renderDurationMs += ms;
+        }
+
+        auto it = std::find_if(metrics.begin(), metrics.end(), [&](const SystemMetric& m) {
+            return m.depth == e.depth && std::string_view(m.systemName) == e.name;
+        });
+        if (it == metrics.end()) {
+            SystemMetric metric;
+            metric.systemName = e.name;
+            metric.depth = e.depth;
+            metrics.push_back(std::move(metric));
+            it = metrics.end() - 1;
+        }
+        it->durationMs += ms;
+        it->callCount++;
+    }
+    timing.idleMs = std::max(0.0, timing.frameDurationMs - timing.tickDurationMs - timing.renderDurationMs);
+
+    RecordFrame(timing);
+    m_currentMetrics = std::move(metrics);
+}
+
+void ProfilerPanel::SetProfiler(const profile::Profiler* profiler) {
+    m_profiler = profiler;
+    m_lastProfileFrameEnd = profiler ? profiler->LastFrame().end : 0;
+}
+
 const std::vector<FrameTiming>& ProfilerPanel::History() const {
     return m_history;
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include "../ui/EditorPanel.h"
 #include "../../engine/ui/UIDrawList.h"
+#include "../../engine/core/Profiler.h"
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -19,6 +20,8 @@ struct SystemMetric {
     std::string systemName;
     double durationMs = 0.0;
     uint32_t entityCount = 0;
+    uint32_t depth = 0;        ///< Scope nesting depth, for profiler-fed metrics
+    uint32_t callCount = 0;    ///< Scopes merged into this metric
 };
 
 class ProfilerPanel : public EditorPanel {
@@ -32,6 +35,14 @@ public:
     // Record a system metric for the current frame
     void RecordSystemMetric(const SystemMetric& metric);
 
+    // Record a frame drained from the CPU profiler. Scopes are merged
+    // by name and depth into metrics; top-level "Tick" and "Render"
+    // scopes fill the tick and render timings.
+    void RecordProfileFrame(const profile::ProfileFrame& frame);
+
+    // Pull each new profiler frame automatically on Draw
+    void SetProfiler(const profile::Profiler* profiler);
+
     // Query
     const std::vector<FrameTiming>& History() const;
     const std::vector<SystemMetric>& CurrentMetrics() const;
@@ -53,6 +64,8 @@ private:
     std::vector<SystemMetric> m_currentMetrics;
     size_t m_maxHistory = 300;
     bool m_paused = false;
+    const profile::Profiler* m_profiler = nullptr;
+    uint64_t m_lastProfileFrameEnd = 0;
     atlas::ui::UIDrawList m_drawList;
 };
 
@@ -50,6 +50,7 @@ void ReplayTimelinePanel::Draw() {
 void ReplayTimelinePanel::LoadReplay(const std::vector<atlas::sim::ReplayFrame>& frames,
                                      uint32_t tickRate) {
     m_frames = frames;
+    m_source = nullptr;
     m_tickRate = tickRate;
     m_currentTick = 0;
     m_markers.clear();
@@ -57,12 +58,21 @@ void ReplayTimelinePanel::LoadReplay(const std::vector<atlas::sim::ReplayFrame>&
     m_comparisonResult = ComparisonResult{};
 }
 
+void ReplayTimelinePanel::LoadReplay(const atlas::sim::ReplayRecorder& replay) {
+    LoadReplay(std::vector<atlas::sim::ReplayFrame>{}, replay.Header().tickRate);
+    m_source = &replay;
+}
+
+const std::vector<atlas::sim::ReplayFrame>& ReplayTimelinePanel::AllFrames() const {
+    return m_source ? m_source->Frames() : m_frames;
+}
+
 void ReplayTimelinePanel::SetCurrentTick(uint32_t tick) {
-    if (m_frames.empty()) {
+    if (TotalTicks() == 0) {
         m_currentTick = 0;
         return;
     }
-    m_currentTick = std::min(tick, m_frames.back().tick);
+    m_currentTick = std::min(tick, TotalTicks() - 1);
 }
 
 uint32_t ReplayTimelinePanel::GetCurrentTick() const {
@@ -70,6 +80,7 @@ uint32_t ReplayTimelinePanel::GetCurrentTick() const {
 }
 
 uint32_t ReplayTimelinePanel::TotalTicks() const {
+    if (m_source) return m_source->FrameCount() > 0 ? m_source->DurationTicks() + 1 : 0;
     if (m_frames.empty()) return 0;
     return m_frames.back().tick + 1;
 }
@@ -79,6 +90,7 @@ uint32_t ReplayTimelinePanel::TickRate() const {
 }
 
 const atlas::sim::ReplayFrame* ReplayTimelinePanel::CurrentFrame() const {
+    if (m_source) return m_source->FrameAtTick(m_currentTick);
     if (m_frames.empty()) return nullptr;
     atlas::sim::ReplayFrame key;
     key.tick = m_currentTick;
@@ -122,36 +134,37 @@ std::vector<TimelineMarker> ReplayTimelinePanel::MarkersInRange(uint32_t start,
 
 ComparisonResult ReplayTimelinePanel::CompareWith(
     const std::vector<atlas::sim::ReplayFrame>& other) const {
+    const auto& frames = AllFrames();
     ComparisonResult result;
 
-    if (m_frames.empty() && other.empty()) {
+    if (frames.empty() && other.empty()) {
         m_comparisonResult = result;
         m_hasComparison = true;
         return result;
     }
 
     result.firstTick = 0;
-    size_t minLen = std::min(m_frames.size(), other.size());
-    size_t maxLen = std::max(m_frames.size(), other.size());
+    size_t minLen = std::min(frames.size(), other.size());
+    size_t maxLen = std::max(frames.size(), other.size());
     result.lastTick = static_cast<int64_t>(maxLen > 0 ? maxLen - 1 : 0);
 
     size_t matchCount = 0;
     result.divergeTick = -1;
 
     for (size_t i = 0; i < minLen; ++i) {
-        if (m_frames[i].stateHash == other[i].stateHash &&
-            m_frames[i].inputData == other[i].inputData) {
+        if (frames[i].stateHash == other[i].stateHash &&
+            frames[i].inputData == other[i].inputData) {
             ++matchCount;
         } else if (result.divergeTick < 0) {
-            result.divergeTick = static_cast<int64_t>(m_frames[i].tick);
+            result.divergeTick = static_cast<int64_t>(frames[i].tick);
         }
     }
 
     // Frames beyond the shorter replay count as divergent
     if (minLen < maxLen && result.divergeTick < 0) {
         // Use the tick from the frame at the boundary, or fall back to index
-        if (minLen < m_frames.size()) {
-            result.divergeTick = static_cast<int64_t>(m_frames[minLen].tick);
+        if (minLen < frames.size()) {
+            result.divergeTick = static_cast<int64_t>(frames[minLen].tick);
         } else if (minLen < other.size()) {
             result.divergeTick = static_cast<int64_t>(other[minLen].tick);
         } else {
@@ -181,6 +194,10 @@ int64_t ReplayTimelinePanel::DivergenceTick() const {
 
 void ReplayTimelinePanel::InjectInput(uint32_t tick,
                                       const std::vector<uint8_t>& inputData) {
+    if (m_source) {
+        m_frames = m_source->Frames();
+        m_source = nullptr;
+    }
     for (auto& f : m_frames) {
         if (f.tick == tick) {
             f.inputData = inputData;
@@ -201,7 +218,7 @@ void ReplayTimelinePanel::InjectInput(uint32_t tick,
 bool ReplayTimelinePanel::HasInjectedInputs() const {
     // Any frame with non-empty inputData that was modified counts;
     // for simplicity we track whether any frame has data at all.
-    for (const auto& f : m_frames) {
+    for (const auto& f : AllFrames()) {
         if (!f.inputData.empty()) return true;
     }
     return false;
@@ -211,7 +228,7 @@ bool ReplayTimelinePanel::HasInjectedInputs() const {
 
 std::vector<atlas::sim::ReplayFrame> ReplayTimelinePanel::BranchAt(uint32_t tick) {
     std::vector<atlas::sim::ReplayFrame> branch;
-    for (const auto& f : m_frames) {
+    for (const auto& f : AllFrames()) {
         if (f.tick <= tick) {
             branch.push_back(f);
         }
@@ -246,7 +263,7 @@ static std::string BytesToHex(const std::vector<uint8_t>& data, size_t maxBytes)
 std::vector<InputFrameEntry> ReplayTimelinePanel::GetInputFrames(
     uint32_t startTick, uint32_t endTick) const {
     std::vector<InputFrameEntry> entries;
-    for (const auto& f : m_frames) {
+    auto add = [&](const atlas::sim::ReplayFrame& f) {
         if (f.tick >= startTick && f.tick <= endTick) {
             InputFrameEntry e;
             e.tick = f.tick;
@@ -256,13 +273,28 @@ std::vector<InputFrameEntry> ReplayTimelinePanel::GetInputFrames(
             e.hexPreview = BytesToHex(f.inputData, 16);
             entries.push_back(e);
         }
+    };
+    if (m_source) {
+        // Blocks before startTick are not decoded
+        m_source->ForEachFrame(startTick, add);
+        return entries;
     }
+    for (const auto& f : m_frames) add(f);
     return entries;
 }
 
 InputFrameEntry ReplayTimelinePanel::GetInputFrameAt(uint32_t tick) const {
     InputFrameEntry e;
     e.tick = tick;
+    if (m_source) {
+        if (const auto* f = m_source->FrameAtTick(tick)) {
+            e.dataSize = f->inputData.size();
+            e.stateHash = f->stateHash;
+            e.isSavePoint = f->isSavePoint;
+            e.hexPreview = BytesToHex(f->inputData, 16);
+        }
+        return e;
+    }
     for (const auto& f : m_frames) {
         if (f.tick == tick) {
             e.dataSize = f.inputData.size();
@@ -281,7 +313,7 @@ std::vector<TimelineEvent> ReplayTimelinePanel::BuildEventTimeline() const {
     std::vector<TimelineEvent> events;
 
     // Add input events from frames
-    for (const auto& f : m_frames) {
+    for (const auto& f : AllFrames()) {
         if (!f.inputData.empty()) {
             TimelineEvent ev;
             ev.tick = f.tick;
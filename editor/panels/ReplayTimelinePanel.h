@@ -59,6 +59,10 @@ public:
 
     // Load / query
     void LoadReplay(const std::vector<atlas::sim::ReplayFrame>& frames, uint32_t tickRate);
+    /// Browse a loaded replay in place: scrubbing decodes only the block
+    /// holding the current tick. The recorder must outlive the panel's
+    /// use of it; injecting input switches to a private copy.
+    void LoadReplay(const atlas::sim::ReplayRecorder& replay);
     void SetCurrentTick(uint32_t tick);
     uint32_t GetCurrentTick() const;
     uint32_t TotalTicks() const;
@@ -102,7 +106,10 @@ public:
     const atlas::ui::UIDrawList& GetDrawList() const { return m_drawList; }
 
 private:
+    const std::vector<atlas::sim::ReplayFrame>& AllFrames() const;
+
     std::vector<atlas::sim::ReplayFrame> m_frames;
+    const atlas::sim::ReplayRecorder* m_source = nullptr;
     std::vector<TimelineMarker> m_markers;
     uint32_t m_currentTick = 0;
     uint32_t m_tickRate = 0;
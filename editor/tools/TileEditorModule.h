@@ -1,8 +1,12 @@
 #pragma once
 #include "IEditorToolModule.h"
+#include <array>
+#include <bit>
 #include <cstdint>
 #include <functional>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 #include <unordered_map>
@@ -51,13 +55,168 @@ struct std::hash<atlas::editor::GridCoord> {
 
 namespace atlas::editor {
 
+/// Grid cells per side of a storage chunk. TileChunkBuilder meshes
+/// the same chunks, so a rebuild reads exactly one bucket.
+constexpr int32_t kTileChunkSize = 8;
+
+/// The tiles of one chunk, dense and row-major (index = ly * size + lx).
+struct TileChunkCells {
+    static constexpr int32_t kCellCount = kTileChunkSize * kTileChunkSize;
+    static_assert(kCellCount <= 64, "occupancy is one 64-bit mask");
+
+    std::array<TileInstance, kCellCount> cells{};
+    uint64_t occupied = 0;  ///< Bit per cell
+
+    bool Has(int32_t index) const { return (occupied >> index) & 1u; }
+    size_t Count() const { return static_cast<size_t>(std::popcount(occupied)); }
+};
+
+/// Sparse tile storage bucketed by chunk. Keeps the map interface
+/// (operator[], find, at, count, erase) layers have always exposed;
+/// iteration yields {coord, tile} pairs by value, in no fixed order.
+class TileChunkGrid {
+public:
+    template <bool Const>
+    class Iterator {
+    public:
+        using Tile = std::conditional_t<Const, const TileInstance, TileInstance>;
+        using ChunkIt = std::conditional_t<Const,
+            std::unordered_map<GridCoord, TileChunkCells>::const_iterator,
+            std::unordered_map<GridCoord, TileChunkCells>::iterator>;
+
+        struct Entry {
+            GridCoord first;
+            Tile& second;
+        };
+        struct Arrow {
+            Entry entry;
+            const Entry* operator->() const { return &entry; }
+        };
+
+        Iterator() = default;
+        Iterator(ChunkIt it, ChunkIt end, int32_t index) : m_it(it), m_end(end), m_index(index) {
+            if (m_it != m_end && !m_it->second.Has(m_index)) Advance();
+        }
+
+        Entry operator*() const {
+            const GridCoord& chunk = m_it->first;
+            GridCoord coord{chunk.x * kTileChunkSize + m_index % kTileChunkSize,
+                            chunk.y * kTileChunkSize + m_index / kTileChunkSize};
+            return Entry{coord, m_it->second.cells[m_index]};
+        }
+        Arrow operator->() const { return Arrow{**this}; }
+        Iterator& operator++() { Advance(); return *this; }
+        bool operator==(const Iterator& o) const {
+            return m_it == o.m_it && (m_it == m_end || m_index == o.m_index);
+        }
+        bool operator!=(const Iterator& o) const { return !(*this == o); }
+
+    private:
+        void Advance() {
+            // Chunks are never empty, so the next chunk always has a tile
+            uint64_t rest = m_index + 1 < TileChunkCells::kCellCount
+                ? m_it->second.occupied >> (m_index + 1) << (m_index + 1) : 0;
+            if (rest == 0) {
+                if (++m_it == m_end) return;
+                rest = m_it->second.occupied;
+            }
+            m_index = std::countr_zero(rest);
+        }
+
+        ChunkIt m_it{};
+        ChunkIt m_end{};
+        int32_t m_index = 0;
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    /// Chunk containing a grid coordinate (floored, so negatives work).
+    static GridCoord ChunkOf(const GridCoord& c) {
+        auto floorDiv = [](int32_t a) { return a >= 0 ? a / kTileChunkSize : (a - kTileChunkSize + 1) / kTileChunkSize; };
+        return {floorDiv(c.x), floorDiv(c.y)};
+    }
+    /// Row-major index of a grid coordinate inside its chunk.
+    static int32_t CellIndex(const GridCoord& c) {
+        GridCoord chunk = ChunkOf(c);
+        return (c.y - chunk.y * kTileChunkSize) * kTileChunkSize + (c.x - chunk.x * kTileChunkSize);
+    }
+
+    TileInstance& operator[](const GridCoord& c) {
+        TileChunkCells& chunk = m_chunks[ChunkOf(c)];
+        int32_t index = CellIndex(c);
+        if (!chunk.Has(index)) {
+            chunk.occupied |= uint64_t{1} << index;
+            chunk.cells[index] = TileInstance{};
+            m_size++;
+        }
+        return chunk.cells[index];
+    }
+
+    iterator find(const GridCoord& c) {
+        auto it = m_chunks.find(ChunkOf(c));
+        int32_t index = CellIndex(c);
+        if (it == m_chunks.end() || !it->second.Has(index)) return end();
+        return iterator(it, m_chunks.end(), index);
+    }
+    const_iterator find(const GridCoord& c) const {
+        auto it = m_chunks.find(ChunkOf(c));
+        int32_t index = CellIndex(c);
+        if (it == m_chunks.end() || !it->second.Has(index)) return end();
+        return const_iterator(it, m_chunks.end(), index);
+    }
+
+    TileInstance& at(const GridCoord& c) {
+        auto it = find(c);
+        if (it == end()) throw std::out_of_range("TileChunkGrid::at");
+        return it->second;
+    }
+    const TileInstance& at(const GridCoord& c) const {
+        auto it = find(c);
+        if (it == end()) throw std::out_of_range("TileChunkGrid::at");
+        return it->second;
+    }
+
+    size_t count(const GridCoord& c) const { return find(c) != end() ? 1 : 0; }
+
+    size_t erase(const GridCoord& c) {
+        auto it = m_chunks.find(ChunkOf(c));
+        int32_t index = CellIndex(c);
+        if (it == m_chunks.end() || !it->second.Has(index)) return 0;
+        it->second.occupied &= ~(uint64_t{1} << index);
+        it->second.cells[index] = TileInstance{};
+        if (it->second.occupied == 0) m_chunks.erase(it);
+        m_size--;
+        return 1;
+    }
+
+    void clear() { m_chunks.clear(); m_size = 0; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    iterator begin() { return iterator(m_chunks.begin(), m_chunks.end(), 0); }
+    iterator end() { return iterator(m_chunks.end(), m_chunks.end(), 0); }
+    const_iterator begin() const { return const_iterator(m_chunks.begin(), m_chunks.end(), 0); }
+    const_iterator end() const { return const_iterator(m_chunks.end(), m_chunks.end(), 0); }
+
+    /// Tiles of chunk (cx, cy), or nullptr when it holds none.
+    const TileChunkCells* FindChunk(int32_t cx, int32_t cy) const {
+        auto it = m_chunks.find(GridCoord{cx, cy});
+        return it != m_chunks.end() ? &it->second : nullptr;
+    }
+    size_t ChunkCount() const { return m_chunks.size(); }
+
+private:
+    std::unordered_map<GridCoord, TileChunkCells> m_chunks;
+    size_t m_size = 0;
+};
+
 /// A single layer in a tile map.
 struct TileLayer {
     std::string name;
     int32_t zIndex = 0;
     bool visible = true;
     bool locked = false;
-    std::unordered_map<GridCoord, TileInstance> tiles;
+    TileChunkGrid tiles;
 };
 
 /// The tile map being edited — the root data asset.
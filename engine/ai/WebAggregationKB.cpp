@@ -1,7 +1,7 @@
 #include "WebAggregationKB.h"
 #include <algorithm>
+#include <cmath>
 #include <sstream>
-#include <unordered_set>
 #include <cctype>
 
 namespace atlas::ai {
@@ -103,10 +103,97 @@ static void SkipNestedStructure(const std::string& json, size_t& pos) {
     }
 }
 
-static std::string ToLower(const std::string& s) {
-    std::string result = s;
-    for (auto& c : result) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-    return result;
+// --- Index helpers ---
+
+namespace {
+
+constexpr double kBm25K1 = 1.2;
+constexpr double kBm25B = 0.75;
+constexpr uint32_t kTitleWeight = 2;
+constexpr double kPrefixWeight = 0.5;
+
+template <typename T, typename KeyFn>
+void InsertSorted(std::vector<T>& list, const T& value, KeyFn key) {
+    auto it = std::lower_bound(list.begin(), list.end(), key(value),
+        [&](const T& a, uint64_t k) { return key(a) < k; });
+    if (it != list.end() && key(*it) == key(value)) return;
+    list.insert(it, value);
+}
+
+template <typename T, typename KeyFn>
+void EraseSorted(std::vector<T>& list, uint64_t id, KeyFn key) {
+    auto it = std::lower_bound(list.begin(), list.end(), id,
+        [&](const T& a, uint64_t k) { return key(a) < k; });
+    if (it != list.end() && key(*it) == id) list.erase(it);
+}
+
+uint64_t IdOf(uint64_t id) { return id; }
+
+void EraseFromList(std::map<std::string, std::vector<uint64_t>>& index,
+                   const std::string& key, uint64_t id) {
+    auto it = index.find(key);
+    if (it == index.end()) return;
+    EraseSorted(it->second, id, IdOf);
+    if (it->second.empty()) index.erase(it);
+}
+
+}
+
+std::vector<std::string> WebAggregationKB::Tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    for (char c : text) {
+        auto u = static_cast<unsigned char>(c);
+        if (std::isalnum(u) || u >= 0x80) {
+            current += static_cast<char>(std::tolower(u));
+        } else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) tokens.push_back(std::move(current));
+    return tokens;
+}
+
+uint32_t WebAggregationKB::CountTerms(const KBEntry& entry,
+                                      std::map<std::string, uint32_t>& frequencies) {
+    uint32_t length = 0;
+    for (auto& token : Tokenize(entry.title)) {
+        frequencies[std::move(token)] += kTitleWeight;
+        length += kTitleWeight;
+    }
+    for (auto& token : Tokenize(entry.content)) {
+        frequencies[std::move(token)] += 1;
+        length += 1;
+    }
+    return length;
+}
+
+void WebAggregationKB::IndexEntry(const KBEntry& entry) {
+    std::map<std::string, uint32_t> frequencies;
+    uint32_t length = CountTerms(entry, frequencies);
+    for (const auto& [term, frequency] : frequencies) {
+        InsertSorted(m_postings[term], Posting{entry.id, frequency, length},
+                     [](const Posting& p) { return p.id; });
+    }
+    m_totalLength += length;
+
+    if (!entry.category.empty()) InsertSorted(m_categoryIndex[entry.category], entry.id, IdOf);
+    for (const auto& tag : entry.tags) InsertSorted(m_tagIndex[tag], entry.id, IdOf);
+}
+
+void WebAggregationKB::UnindexEntry(const KBEntry& entry) {
+    std::map<std::string, uint32_t> frequencies;
+    m_totalLength -= CountTerms(entry, frequencies);
+    for (const auto& kv : frequencies) {
+        auto it = m_postings.find(kv.first);
+        if (it == m_postings.end()) continue;
+        EraseSorted(it->second, entry.id, [](const Posting& p) { return p.id; });
+        if (it->second.empty()) m_postings.erase(it);
+    }
+
+    if (!entry.category.empty()) EraseFromList(m_categoryIndex, entry.category, entry.id);
+    for (const auto& tag : entry.tags) EraseFromList(m_tagIndex, tag, entry.id);
 }
 
 // --- Entry management ---
@@ -115,12 +202,16 @@ uint64_t WebAggregationKB::AddEntry(const KBEntry& entry) {
     uint64_t id = m_nextID++;
     KBEntry stored = entry;
     stored.id = id;
-    m_entries[id] = stored;
+    IndexEntry(stored);
+    m_entries[id] = std::move(stored);
     return id;
 }
 
 void WebAggregationKB::RemoveEntry(uint64_t id) {
-    m_entries.erase(id);
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) return;
+    UnindexEntry(it->second);
+    m_entries.erase(it);
 }
 
 const KBEntry* WebAggregationKB::GetEntry(uint64_t id) const {
@@ -138,27 +229,134 @@ size_t WebAggregationKB::EntryCount() const {
 KBSearchResult WebAggregationKB::Search(const std::string& query, size_t maxResults) const {
     KBSearchResult result;
     result.query = query;
-    std::string lowerQuery = ToLower(query);
-
-    for (const auto& kv : m_entries) {
-        const auto& entry = kv.second;
-        std::string lowerTitle = ToLower(entry.title);
-        std::string lowerContent = ToLower(entry.content);
-        if (lowerTitle.find(lowerQuery) != std::string::npos ||
-            lowerContent.find(lowerQuery) != std::string::npos) {
-            result.entries.push_back(entry);
+
+    struct Expansion {
+        const std::vector<Posting>* postings;
+        double weight;              // idf, halved for prefix matches
+    };
+    struct Term {
+        std::vector<Expansion> expansions;
+        size_t postingCount = 0;
+    };
+    struct Match {
+        uint64_t id;
+        double score;
+    };
+
+    std::vector<std::string> tokens = Tokenize(query);
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+
+    const double n = static_cast<double>(m_entries.size());
+    const double avgLength = m_entries.empty() ? 1.0
+        : std::max(1.0, static_cast<double>(m_totalLength) / n);
+
+    std::vector<Term> terms;
+    for (const auto& token : tokens) {
+        Term term;
+        for (auto it = m_postings.lower_bound(token);
+             it != m_postings.end() && it->first.compare(0, token.size(), token) == 0; ++it) {
+            double df = static_cast<double>(it->second.size());
+            double idf = std::log(1.0 + (n - df + 0.5) / (df + 0.5));
+            double weight = it->first.size() == token.size() ? 1.0 : kPrefixWeight;
+            term.expansions.push_back({&it->second, weight * idf});
+            term.postingCount += it->second.size();
         }
+        terms.push_back(std::move(term));
     }
+    // Rarest first, so the candidate set shrinks as early as possible
+    std::sort(terms.begin(), terms.end(),
+              [](const Term& a, const Term& b) { return a.postingCount < b.postingCount; });
+
+    auto contribution = [&](const Posting& posting, double weight) {
+        double tf = posting.frequency;
+        double length = posting.length;
+        double norm = kBm25K1 * (1.0 - kBm25B + kBm25B * length / avgLength);
+        return weight * tf * (kBm25K1 + 1.0) / (tf + norm);
+    };
+
+    // Matches stay sorted by id; each term intersects them with its postings
+    std::vector<Match> matches;
+    if (terms.empty()) {
+        // An empty query matches everything, as a substring search did
+        matches.reserve(m_entries.size());
+        for (const auto& kv : m_entries) matches.push_back({kv.first, 0.0});
+        std::sort(matches.begin(), matches.end(),
+                  [](const Match& a, const Match& b) { return a.id < b.id; });
+    }
+    for (size_t t = 0; t < terms.size(); ++t) {
+        const Term& term = terms[t];
+        if (t == 0) {
+            for (const auto& e : term.expansions) {
+                for (const auto& posting : *e.postings) {
+                    matches.push_back({posting.id, contribution(posting, e.weight)});
+                }
+            }
+            std::sort(matches.begin(), matches.end(),
+                      [](const Match& a, const Match& b) { return a.id < b.id; });
+            // Several expansions of one token may hit the same entry
+            size_t out = 0;
+            for (size_t i = 0; i < matches.size(); ++i) {
+                if (out > 0 && matches[out - 1].id == matches[i].id) matches[out - 1].score += matches[i].score;
+                else matches[out++] = matches[i];
+            }
+            matches.resize(out);
+            continue;
+        }
 
-    result.totalMatches = result.entries.size();
-
-    std::sort(result.entries.begin(), result.entries.end(),
-        [](const KBEntry& a, const KBEntry& b) {
-            return a.relevanceScore > b.relevanceScore;
-        });
+        std::vector<double> added(matches.size(), 0.0);
+        std::vector<uint8_t> hit(matches.size(), 0);
+        for (const auto& e : term.expansions) {
+            const auto& postings = *e.postings;
+            if (matches.size() * 8 < postings.size()) {
+                for (size_t i = 0; i < matches.size(); ++i) {
+                    auto it = std::lower_bound(postings.begin(), postings.end(), matches[i].id,
+                        [](const Posting& p, uint64_t id) { return p.id < id; });
+                    if (it != postings.end() && it->id == matches[i].id) {
+                        added[i] += contribution(*it, e.weight);
+                        hit[i] = 1;
+                    }
+                }
+            } else {
+                size_t i = 0;
+                for (const auto& posting : postings) {
+                    while (i < matches.size() && matches[i].id < posting.id) ++i;
+                    if (i == matches.size()) break;
+                    if (matches[i].id == posting.id) {
+                        added[i] += contribution(posting, e.weight);
+                        hit[i] = 1;
+                    }
+                }
+            }
+        }
+        size_t out = 0;
+        for (size_t i = 0; i < matches.size(); ++i) {
+            if (!hit[i]) continue;
+            matches[out] = {matches[i].id, matches[i].score + added[i]};
+            ++out;
+        }
+        matches.resize(out);
+        if (matches.empty()) break;
+    }
 
-    if (result.entries.size() > maxResults) {
-        result.entries.resize(maxResults);
+    result.totalMatches = matches.size();
+
+    auto better = [this](const Match& a, const Match& b) {
+        if (a.score != b.score) return a.score > b.score;
+        double ra = m_entries.at(a.id).relevanceScore;
+        double rb = m_entries.at(b.id).relevanceScore;
+        if (ra != rb) return ra > rb;
+        return a.id < b.id;
+    };
+    size_t count = std::min(maxResults, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + static_cast<std::ptrdiff_t>(count),
+                      matches.end(), better);
+
+    result.entries.reserve(count);
+    result.scores.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.entries.push_back(m_entries.at(matches[i].id));
+        result.scores.push_back(matches[i].score);
     }
     return result;
 }
@@ -166,10 +364,9 @@ KBSearchResult WebAggregationKB::Search(const std::string& query, size_t maxResu
 KBSearchResult WebAggregationKB::SearchByCategory(const std::string& category) const {
     KBSearchResult result;
     result.query = category;
-    for (const auto& kv : m_entries) {
-        if (kv.second.category == category) {
-            result.entries.push_back(kv.second);
-        }
+    auto it = m_categoryIndex.find(category);
+    if (it != m_categoryIndex.end()) {
+        for (uint64_t id : it->second) result.entries.push_back(m_entries.at(id));
     }
     result.totalMatches = result.entries.size();
     return result;
@@ -178,13 +375,9 @@ KBSearchResult WebAggregationKB::SearchByCategory(const std::string& category) c
 KBSearchResult WebAggregationKB::SearchByTag(const std::string& tag) const {
     KBSearchResult result;
     result.query = tag;
-    for (const auto& kv : m_entries) {
-        for (const auto& t : kv.second.tags) {
-            if (t == tag) {
-                result.entries.push_back(kv.second);
-                break;
-            }
-        }
+    auto it = m_tagIndex.find(tag);
+    if (it != m_tagIndex.end()) {
+        for (uint64_t id : it->second) result.entries.push_back(m_entries.at(id));
     }
     result.totalMatches = result.entries.size();
     return result;
@@ -193,53 +386,59 @@ KBSearchResult WebAggregationKB::SearchByTag(const std::string& tag) const {
 // --- Categories and Tags ---
 
 std::vector<std::string> WebAggregationKB::ListCategories() const {
-    std::unordered_set<std::string> cats;
-    for (const auto& kv : m_entries) {
-        if (!kv.second.category.empty()) {
-            cats.insert(kv.second.category);
-        }
-    }
-    return std::vector<std::string>(cats.begin(), cats.end());
+    std::vector<std::string> cats;
+    cats.reserve(m_categoryIndex.size());
+    for (const auto& kv : m_categoryIndex) cats.push_back(kv.first);
+    return cats;
 }
 
 size_t WebAggregationKB::CategoryCount() const {
-    return ListCategories().size();
+    return m_categoryIndex.size();
 }
 
 std::vector<std::string> WebAggregationKB::ListTags() const {
-    std::unordered_set<std::string> tagSet;
-    for (const auto& kv : m_entries) {
-        for (const auto& t : kv.second.tags) {
-            tagSet.insert(t);
-        }
-    }
-    return std::vector<std::string>(tagSet.begin(), tagSet.end());
+    std::vector<std::string> tags;
+    tags.reserve(m_tagIndex.size());
+    for (const auto& kv : m_tagIndex) tags.push_back(kv.first);
+    return tags;
+}
+
+size_t WebAggregationKB::TermCount() const {
+    return m_postings.size();
 }
 
 // --- Export/Import JSON ---
 
 std::string WebAggregationKB::ExportJSON() const {
+    std::vector<const KBEntry*> sorted;
+    sorted.reserve(m_entries.size());
+    for (const auto& kv : m_entries) sorted.push_back(&kv.second);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const KBEntry* a, const KBEntry* b) { return a->id < b->id; });
+
     std::ostringstream ss;
-    ss << "{\"entries\":[";
+    ss << "{\"nextId\":" << m_nextID << ",\"entries\":[";
     bool first = true;
-    for (const auto& kv : m_entries) {
+    for (const KBEntry* entry : sorted) {
         if (!first) ss << ",";
         first = false;
-        const auto& e = kv.second;
+        const auto& e = *entry;
         ss << "{";
         ss << "\"id\":" << e.id;
-        ss << ",\"source\":\"" << EscapeString(e.source) << "\"";
-        ss << ",\"title\":\"" << EscapeString(e.title) << "\"";
-        ss << ",\"content\":\"" << EscapeString(e.content) << "\"";
-        ss << ",\"category\":\"" << EscapeString(e.category) << "\"";
-        ss << ",\"timestamp\":" << e.timestamp;
-        ss << ",\"relevanceScore\":" << e.relevanceScore;
-        ss << ",\"tags\":[";
-        for (size_t i = 0; i < e.tags.size(); ++i) {
-            if (i > 0) ss << ",";
-            ss << "\"" << EscapeString(e.tags[i]) << "\"";
+        if (!e.source.empty()) ss << ",\"source\":\"" << EscapeString(e.source) << "\"";
+        if (!e.title.empty()) ss << ",\"title\":\"" << EscapeString(e.title) << "\"";
+        if (!e.content.empty()) ss << ",\"content\":\"" << EscapeString(e.content) << "\"";
+        if (!e.category.empty()) ss << ",\"category\":\"" << EscapeString(e.category) << "\"";
+        if (e.timestamp != 0) ss << ",\"timestamp\":" << e.timestamp;
+        if (e.relevanceScore != 0.0) ss << ",\"relevanceScore\":" << e.relevanceScore;
+        if (!e.tags.empty()) {
+            ss << ",\"tags\":[";
+            for (size_t i = 0; i < e.tags.size(); ++i) {
+                if (i > 0) ss << ",";
+                ss << "\"" << EscapeString(e.tags[i]) << "\"";
+            }
+            ss << "]";
         }
-        ss << "]";
         ss << "}";
     }
     ss << "]}";
@@ -304,14 +503,22 @@ bool WebAggregationKB::ImportJSON(const std::string& json) {
                             } catch (...) {}
                         }
                     }
-                    m_entries[entry.id] = entry;
+                    auto existing = m_entries.find(entry.id);
+                    if (existing != m_entries.end()) UnindexEntry(existing->second);
+                    IndexEntry(entry);
                     if (entry.id >= m_nextID) m_nextID = entry.id + 1;
+                    m_entries[entry.id] = std::move(entry);
                 }
             }
         } else if (pos < json.size() && (json[pos] == '[' || json[pos] == '{')) {
             SkipNestedStructure(json, pos);
         } else {
-            ParseValue(json, pos);
+            std::string val = ParseValue(json, pos);
+            if (key == "nextId") {
+                try {
+                    m_nextID = std::max(m_nextID, static_cast<uint64_t>(std::stoull(val)));
+                } catch (...) {}
+            }
         }
     }
     return true;
@@ -320,6 +527,10 @@ bool WebAggregationKB::ImportJSON(const std::string& json) {
 void WebAggregationKB::Clear() {
     m_entries.clear();
     m_nextID = 1;
+    m_postings.clear();
+    m_totalLength = 0;
+    m_categoryIndex.clear();
+    m_tagIndex.clear();
 }
 
 } // namespace atlas::ai
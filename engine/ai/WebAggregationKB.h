@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <map>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -21,10 +22,21 @@ struct KBSearchResult {
     std::vector<KBEntry> entries;
     std::string query;
     size_t totalMatches = 0;
+    std::vector<double> scores;     // ranking score per entry (Search only)
 };
 
+// Entries are indexed as they are added: an inverted index from each
+// lowercase alphanumeric token of title and content to the entries
+// holding it, plus posting lists per category and tag. Search ranks
+// with BM25 (title tokens count double). A query token also matches
+// longer terms it is a prefix of, at half weight, and every query token
+// must match. relevanceScore only breaks ties.
 class WebAggregationKB {
 public:
+    /// Split text into lowercase alphanumeric tokens (bytes >= 0x80 are
+    /// kept as word characters, so UTF-8 words stay whole).
+    static std::vector<std::string> Tokenize(const std::string& text);
+
     uint64_t AddEntry(const KBEntry& entry);
     void RemoveEntry(uint64_t id);
     const KBEntry* GetEntry(uint64_t id) const;
@@ -39,14 +51,34 @@ public:
 
     std::vector<std::string> ListTags() const;
 
+    /// Distinct indexed terms.
+    size_t TermCount() const;
+
+    /// Entries in id order; empty fields are omitted. The index is not
+    /// stored: ImportJSON rebuilds it while reading.
     std::string ExportJSON() const;
     bool ImportJSON(const std::string& json);
 
     void Clear();
 
 private:
+    struct Posting {
+        uint64_t id = 0;
+        uint32_t frequency = 0;     // title occurrences weighted
+        uint32_t length = 0;        // of the whole entry, for BM25
+    };
+
+    void IndexEntry(const KBEntry& entry);
+    void UnindexEntry(const KBEntry& entry);
+    static uint32_t CountTerms(const KBEntry& entry, std::map<std::string, uint32_t>& frequencies);
+
     std::unordered_map<uint64_t, KBEntry> m_entries;
     uint64_t m_nextID = 1;
+
+    std::map<std::string, std::vector<Posting>> m_postings;     // sorted by id
+    uint64_t m_totalLength = 0;
+    std::map<std::string, std::vector<uint64_t>> m_categoryIndex;
+    std::map<std::string, std::vector<uint64_t>> m_tagIndex;
 };
 
 } // namespace atlas::ai
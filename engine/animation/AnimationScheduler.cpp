@@ -0,0 +1,293 @@
+#include "AnimationScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace atlas::animation {
+
+AnimEvaluateFn MakeAnimEvaluator(AnimationGraph& graph, AnimNodeID node, AnimPortID port,
+                                 const AnimContext& ctx) {
+    return [&graph, node, port, ctx](uint32_t tick, float dt, std::vector<float>& pose) {
+        AnimContext c = ctx;
+        c.tick = tick;
+        c.deltaTime = dt;
+        if (!graph.Execute(c)) return false;
+        const AnimValue* out = graph.GetOutput(node, port);
+        if (!out) return false;
+        pose.assign(out->data.begin(), out->data.end());
+        return true;
+    };
+}
+
+AnimEvaluateFn MakeAnimEvaluator(DeterministicAnimationGraph& graph, BoneNodeID node,
+                                 BonePortID port, const BoneContext& ctx) {
+    return [&graph, node, port, ctx](uint32_t tick, float dt, std::vector<float>& pose) {
+        BoneContext c = ctx;
+        c.tick = tick;
+        c.deltaTime = dt;
+        if (!graph.Execute(c)) return false;
+        const BoneValue* out = graph.GetOutput(node, port);
+        if (!out) return false;
+        pose.assign(out->data.begin(), out->data.end());
+        return true;
+    };
+}
+
+namespace {
+
+uint32_t Interval(AnimUpdateRate rate) {
+    return static_cast<uint32_t>(rate);
+}
+
+AnimUpdateRate Demote(AnimUpdateRate rate) {
+    switch (rate) {
+        case AnimUpdateRate::EveryTick: return AnimUpdateRate::Every2nd;
+        case AnimUpdateRate::Every2nd: return AnimUpdateRate::Every4th;
+        default: return rate;
+    }
+}
+
+}
+
+AnimationScheduler::AnimationScheduler(const AnimLODSettings& settings)
+    : m_settings(settings) {}
+
+AnimInstanceID AnimationScheduler::AddInstance(AnimInstanceDesc desc) {
+    AnimInstanceID id;
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    } else {
+        m_instances.emplace_back();
+        id = static_cast<AnimInstanceID>(m_instances.size());
+    }
+    Instance& inst = m_instances[id - 1];
+    inst = Instance{};
+    inst.evaluate = std::move(desc.evaluate);
+    inst.x = desc.x;
+    inst.y = desc.y;
+    inst.z = desc.z;
+    inst.visible = desc.visible;
+    inst.costMs = desc.estimatedCostMs;
+    inst.alive = true;
+    inst.rate = AnimUpdateRate::Frozen;
+    AssignPhase(inst, AnimUpdateRate::EveryTick);
+    return id;
+}
+
+void AnimationScheduler::RemoveInstance(AnimInstanceID id) {
+    if (!HasInstance(id)) return;
+    Instance& inst = m_instances[id - 1];
+    ReleasePhase(inst);
+    inst = Instance{};
+    m_freeIds.push_back(id);
+}
+
+bool AnimationScheduler::HasInstance(AnimInstanceID id) const {
+    return id > 0 && id <= m_instances.size() && m_instances[id - 1].alive;
+}
+
+size_t AnimationScheduler::InstanceCount() const {
+    return m_instances.size() - m_freeIds.size();
+}
+
+void AnimationScheduler::SetCameraPosition(float x, float y, float z) {
+    m_camera[0] = x;
+    m_camera[1] = y;
+    m_camera[2] = z;
+}
+
+void AnimationScheduler::SetInstancePosition(AnimInstanceID id, float x, float y, float z) {
+    if (!HasInstance(id)) return;
+    Instance& inst = m_instances[id - 1];
+    inst.x = x;
+    inst.y = y;
+    inst.z = z;
+}
+
+void AnimationScheduler::SetInstanceVisible(AnimInstanceID id, bool visible) {
+    if (HasInstance(id)) m_instances[id - 1].visible = visible;
+}
+
+const std::vector<float>* AnimationScheduler::GetPose(AnimInstanceID id) const {
+    return HasInstance(id) ? &m_instances[id - 1].pose : nullptr;
+}
+
+AnimUpdateRate AnimationScheduler::GetRate(AnimInstanceID id) const {
+    return HasInstance(id) ? m_instances[id - 1].rate : AnimUpdateRate::Frozen;
+}
+
+AnimUpdateRate AnimationScheduler::RateForDistance(const Instance& inst) const {
+    AnimUpdateRate rate;
+    if (inst.distance <= m_settings.fullRateDistance) rate = AnimUpdateRate::EveryTick;
+    else if (inst.distance <= m_settings.halfRateDistance) rate = AnimUpdateRate::Every2nd;
+    else if (inst.distance <= m_settings.quarterRateDistance) rate = AnimUpdateRate::Every4th;
+    else return AnimUpdateRate::Frozen;
+
+    if (!inst.visible && m_settings.throttleInvisible) rate = AnimUpdateRate::Every4th;
+    return rate;
+}
+
+void AnimationScheduler::AssignPhase(Instance& inst, AnimUpdateRate rate) {
+    ReleasePhase(inst);
+    inst.rate = rate;
+    inst.phase = 0;
+    uint32_t k = Interval(rate);
+    if (k == 0) return;
+
+    // Pick the phase whose ticks carry the fewest evaluations
+    uint32_t bestLoad = ~0u;
+    for (uint32_t p = 0; p < k; ++p) {
+        uint32_t load = 0;
+        for (uint32_t slot = p; slot < 4; slot += k) load += m_slotLoad[slot];
+        if (load < bestLoad) {
+            bestLoad = load;
+            inst.phase = p;
+        }
+    }
+    for (uint32_t slot = inst.phase; slot < 4; slot += k) m_slotLoad[slot]++;
+}
+
+void AnimationScheduler::ReleasePhase(const Instance& inst) {
+    uint32_t k = Interval(inst.rate);
+    if (k == 0) return;
+    for (uint32_t slot = inst.phase; slot < 4; slot += k) m_slotLoad[slot]--;
+}
+
+void AnimationScheduler::ApplyBudget() {
+    if (m_settings.budgetMs <= 0.0f) return;
+    float predicted = m_stats.predictedMs;
+    if (predicted <= m_settings.budgetMs) return;
+
+    // Farthest first, one rate step per pass, until the prediction fits
+    m_order.clear();
+    for (uint32_t i = 0; i < m_instances.size(); ++i) {
+        const Instance& inst = m_instances[i];
+        if (inst.alive && inst.desired != AnimUpdateRate::Frozen &&
+            inst.desired != AnimUpdateRate::Every4th) {
+            m_order.push_back(i);
+        }
+    }
+    std::sort(m_order.begin(), m_order.end(), [this](uint32_t a, uint32_t b) {
+        if (m_instances[a].distance != m_instances[b].distance)
+            return m_instances[a].distance > m_instances[b].distance;
+        return a < b;
+    });
+
+    bool changed = true;
+    while (predicted > m_settings.budgetMs && changed) {
+        changed = false;
+        for (uint32_t i : m_order) {
+            Instance& inst = m_instances[i];
+            AnimUpdateRate lower = Demote(inst.desired);
+            if (lower == inst.desired) continue;
+            predicted -= inst.costMs / Interval(inst.desired) - inst.costMs / Interval(lower);
+            inst.desired = lower;
+            m_stats.demoted++;
+            changed = true;
+            if (predicted <= m_settings.budgetMs) break;
+        }
+    }
+    m_stats.predictedMs = predicted;
+}
+
+bool AnimationScheduler::IsDue(const Instance& inst) const {
+    uint32_t k = Interval(inst.rate);
+    if (k == 0 || !inst.evaluate) return false;
+    if (m_tick % k != inst.phase) return false;
+    // After a switch to a faster rate, wait until the interval catches up
+    return !inst.evaluated || m_tick + k - 1 > inst.nextTick;
+}
+
+void AnimationScheduler::Evaluate(Instance& inst) {
+    uint32_t k = Interval(inst.rate);
+    uint32_t target = m_tick + k - 1;
+    uint32_t elapsed = inst.evaluated ? target - inst.nextTick : k;
+
+    auto start = std::chrono::steady_clock::now();
+    // The pose shown last tick becomes the start of the new interval
+    inst.prev.swap(inst.pose);
+    bool ok = inst.evaluate(target, static_cast<float>(elapsed) * m_settings.tickDelta, inst.next);
+    if (m_settings.measureCost) {
+        float ms = std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        inst.costMs += (ms - inst.costMs) * 0.2f;
+    }
+    if (!ok) {
+        inst.pose.swap(inst.prev);
+        return;
+    }
+
+    if (!inst.evaluated || inst.prev.size() != inst.next.size()) {
+        inst.prev = inst.next;
+        inst.prevTick = target;
+    } else {
+        inst.prevTick = m_tick - 1;
+    }
+    inst.nextTick = target;
+    inst.evaluated = true;
+}
+
+void AnimationScheduler::Interpolate(Instance& inst) const {
+    if (!inst.evaluated) return;
+    if (m_tick >= inst.nextTick || inst.prevTick >= inst.nextTick) {
+        inst.pose.assign(inst.next.begin(), inst.next.end());
+        return;
+    }
+    float alpha = m_tick <= inst.prevTick ? 0.0f :
+        static_cast<float>(m_tick - inst.prevTick) / static_cast<float>(inst.nextTick - inst.prevTick);
+    inst.pose.resize(inst.next.size());
+    for (size_t i = 0; i < inst.next.size(); ++i) {
+        inst.pose[i] = inst.prev[i] + (inst.next[i] - inst.prev[i]) * alpha;
+    }
+}
+
+void AnimationScheduler::Update() {
+    m_stats = AnimSchedulerStats{};
+
+    // Rates from distance and visibility, then the budget
+    for (Instance& inst : m_instances) {
+        if (!inst.alive) continue;
+        float dx = inst.x - m_camera[0];
+        float dy = inst.y - m_camera[1];
+        float dz = inst.z - m_camera[2];
+        inst.distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        inst.desired = RateForDistance(inst);
+        if (inst.desired != AnimUpdateRate::Frozen) {
+            m_stats.predictedMs += inst.costMs / Interval(inst.desired);
+        }
+    }
+    ApplyBudget();
+    // Phases only move when the final rate changes, so a steady scene
+    // keeps its stagger from tick to tick
+    for (Instance& inst : m_instances) {
+        if (inst.alive && inst.desired != inst.rate) AssignPhase(inst, inst.desired);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (Instance& inst : m_instances) {
+        if (!inst.alive) continue;
+        m_stats.instances++;
+        switch (inst.rate) {
+            case AnimUpdateRate::EveryTick: m_stats.perRate[0]++; break;
+            case AnimUpdateRate::Every2nd: m_stats.perRate[1]++; break;
+            case AnimUpdateRate::Every4th: m_stats.perRate[2]++; break;
+            case AnimUpdateRate::Frozen: m_stats.frozen++; break;
+        }
+        if (IsDue(inst)) {
+            Evaluate(inst);
+            m_stats.evaluated++;
+        } else {
+            m_stats.skipped++;
+        }
+        Interpolate(inst);
+    }
+    m_stats.evaluateMs = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    m_totalEvaluated += m_stats.evaluated;
+    m_totalSkipped += m_stats.skipped;
+    m_tick++;
+}
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include "AnimationGraph.h"
+#include "DeterministicAnimationGraph.h"
+#include <functional>
+
+namespace atlas::animation {
+
+// ============================================================
+// Animation LOD / update-rate scheduler
+// ============================================================
+//
+// Each registered instance is assigned an update rate from its
+// camera distance and visibility, then demoted further (farthest
+// first) while the predicted evaluation cost exceeds the per-frame
+// budget. Instances that are not evaluated on a tick show a pose
+// interpolated between their last two evaluations.
+//
+// An instance running every k ticks is evaluated once per k ticks
+// with k ticks of delta time, producing the pose for the last tick
+// of its interval; the ticks in between blend linearly from the
+// previous pose towards it. Evaluation phases are chosen so that the
+// instances of each rate spread evenly over consecutive ticks.
+
+enum class AnimUpdateRate : uint8_t {
+    EveryTick = 1,
+    Every2nd = 2,
+    Every4th = 4,
+    Frozen = 0
+};
+
+/// Evaluates one instance and writes its pose. `tick` is the tick the
+/// pose is for and `dt` the animation time elapsed since the previous
+/// evaluation of this instance.
+using AnimEvaluateFn = std::function<bool(uint32_t tick, float dt, std::vector<float>& pose)>;
+
+/// Evaluator for an AnimationGraph output; ctx.tick and ctx.deltaTime
+/// are filled in per evaluation. The graph must outlive the instance.
+AnimEvaluateFn MakeAnimEvaluator(AnimationGraph& graph, AnimNodeID node, AnimPortID port,
+                                 const AnimContext& ctx);
+/// Same for a DeterministicAnimationGraph output.
+AnimEvaluateFn MakeAnimEvaluator(DeterministicAnimationGraph& graph, BoneNodeID node,
+                                 BonePortID port, const BoneContext& ctx);
+
+struct AnimLODSettings {
+    float tickDelta = 1.0f / 60.0f;
+    // Distance thresholds; beyond quarterRateDistance instances freeze
+    float fullRateDistance = 20.0f;
+    float halfRateDistance = 50.0f;
+    float quarterRateDistance = 120.0f;
+    // Instances outside the view update at most every 4th tick
+    bool throttleInvisible = true;
+    // Predicted evaluation cost allowed per tick; 0 disables the budget
+    float budgetMs = 2.0f;
+    // Measure evaluation cost; otherwise the per-instance estimate is used
+    bool measureCost = true;
+};
+
+struct AnimInstanceDesc {
+    AnimEvaluateFn evaluate;
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    bool visible = true;
+    float estimatedCostMs = 0.02f;   // seed for the cost average
+};
+
+using AnimInstanceID = uint32_t;
+
+struct AnimSchedulerStats {
+    uint32_t instances = 0;
+    uint32_t evaluated = 0;      // evaluated this tick
+    uint32_t skipped = 0;        // interpolated or held this tick
+    uint32_t frozen = 0;
+    uint32_t demoted = 0;        // rate lowered by the budget
+    uint32_t perRate[3] = {};    // instances at EveryTick, Every2nd, Every4th
+    float predictedMs = 0.0f;    // average cost per tick at the chosen rates
+    float evaluateMs = 0.0f;     // measured this tick
+};
+
+class AnimationScheduler {
+public:
+    explicit AnimationScheduler(const AnimLODSettings& settings = {});
+
+    AnimInstanceID AddInstance(AnimInstanceDesc desc);
+    void RemoveInstance(AnimInstanceID id);
+    bool HasInstance(AnimInstanceID id) const;
+    size_t InstanceCount() const;
+
+    void SetCameraPosition(float x, float y, float z);
+    void SetInstancePosition(AnimInstanceID id, float x, float y, float z);
+    void SetInstanceVisible(AnimInstanceID id, bool visible);
+
+    /// Advance one tick: pick rates, evaluate the instances that are due
+    /// and interpolate the rest.
+    void Update();
+
+    /// Pose shown this tick; empty before the first evaluation.
+    const std::vector<float>* GetPose(AnimInstanceID id) const;
+    AnimUpdateRate GetRate(AnimInstanceID id) const;
+
+    const AnimSchedulerStats& GetStats() const { return m_stats; }
+    uint64_t TotalEvaluated() const { return m_totalEvaluated; }
+    uint64_t TotalSkipped() const { return m_totalSkipped; }
+    uint32_t CurrentTick() const { return m_tick; }
+
+    AnimLODSettings& Settings() { return m_settings; }
+    const AnimLODSettings& Settings() const { return m_settings; }
+
+private:
+    struct Instance {
+        AnimEvaluateFn evaluate;
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        bool visible = true;
+        bool alive = false;
+        AnimUpdateRate rate = AnimUpdateRate::EveryTick;
+        AnimUpdateRate desired = AnimUpdateRate::EveryTick;   // chosen this tick
+        uint32_t phase = 0;
+        float costMs = 0.0f;
+        float distance = 0.0f;
+        // Poses for ticks prevTick and nextTick; `pose` is shown
+        bool evaluated = false;
+        uint32_t prevTick = 0;
+        uint32_t nextTick = 0;
+        std::vector<float> prev;
+        std::vector<float> next;
+        std::vector<float> pose;
+    };
+
+    AnimUpdateRate RateForDistance(const Instance& inst) const;
+    void ApplyBudget();
+    void AssignPhase(Instance& inst, AnimUpdateRate rate);
+    void ReleasePhase(const Instance& inst);
+    bool IsDue(const Instance& inst) const;
+    void Evaluate(Instance& inst);
+    void Interpolate(Instance& inst) const;
+
+    AnimLODSettings m_settings;
+    std::vector<Instance> m_instances;
+    std::vector<AnimInstanceID> m_freeIds;
+    std::vector<uint32_t> m_order;     // scratch for budget demotion
+    uint32_t m_slotLoad[4] = {};       // instances evaluated on tick % 4 == slot
+    float m_camera[3] = {0.0f, 0.0f, 0.0f};
+    uint32_t m_tick = 0;
+    AnimSchedulerStats m_stats;
+    uint64_t m_totalEvaluated = 0;
+    uint64_t m_totalSkipped = 0;
+};
+
+}
@@ -1,9 +1,230 @@
 #include "DeterministicAnimationGraph.h"
+#include "../core/JobSystem.h"
 #include <algorithm>
+#include <cstring>
 #include <queue>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ATLAS_ANIM_SSE2 1
+#endif
+
 namespace atlas::animation {
 
+// --- CrowdPose ---
+
+void CrowdPose::Resize(uint32_t instances, uint32_t bones) {
+    instanceCount = instances;
+    boneCount = bones;
+    size_t count = static_cast<size_t>(instances) * bones;
+    for (uint32_t c = 0; c < kBoneChannels; ++c) {
+        lanes[c].assign(count, c == 6 ? 1.0f : 0.0f);
+    }
+}
+
+BoneTransform CrowdPose::GetBone(uint32_t instance, uint32_t bone) const {
+    size_t i = static_cast<size_t>(bone) * instanceCount + instance;
+    BoneTransform t;
+    t.posX = lanes[0][i]; t.posY = lanes[1][i]; t.posZ = lanes[2][i];
+    t.rotX = lanes[3][i]; t.rotY = lanes[4][i]; t.rotZ = lanes[5][i]; t.rotW = lanes[6][i];
+    return t;
+}
+
+void CrowdPose::SetBone(uint32_t instance, uint32_t bone, const BoneTransform& t) {
+    size_t i = static_cast<size_t>(bone) * instanceCount + instance;
+    lanes[0][i] = t.posX; lanes[1][i] = t.posY; lanes[2][i] = t.posZ;
+    lanes[3][i] = t.rotX; lanes[4][i] = t.rotY; lanes[5][i] = t.rotZ; lanes[6][i] = t.rotW;
+}
+
+void CrowdPose::GatherInstance(uint32_t instance, std::vector<float>& aos) const {
+    aos.resize(static_cast<size_t>(boneCount) * kBoneChannels);
+    for (uint32_t b = 0; b < boneCount; ++b) {
+        size_t i = static_cast<size_t>(b) * instanceCount + instance;
+        for (uint32_t c = 0; c < kBoneChannels; ++c) {
+            aos[b * kBoneChannels + c] = lanes[c][i];
+        }
+    }
+}
+
+void CrowdPose::ScatterInstance(uint32_t instance, const std::vector<float>& aos) {
+    // Poses of the wrong size are truncated or zero-padded to boneCount bones
+    for (uint32_t b = 0; b < boneCount; ++b) {
+        size_t i = static_cast<size_t>(b) * instanceCount + instance;
+        for (uint32_t c = 0; c < kBoneChannels; ++c) {
+            size_t src = static_cast<size_t>(b) * kBoneChannels + c;
+            lanes[c][i] = src < aos.size() ? aos[src] : 0.0f;
+        }
+    }
+}
+
+// --- Crowd kernels ---
+//
+// Each kernel performs the same float operations in the same order as
+// the matching per-skeleton Evaluate, only four instances at a time, so
+// results are bit-identical (the engine builds with -ffp-contract=off
+// and SSE arithmetic is IEEE-exact like the scalar path).
+
+namespace {
+
+void FillRestRange(CrowdPose& out, uint32_t begin, uint32_t end) {
+    for (uint32_t b = 0; b < out.boneCount; ++b) {
+        for (uint32_t c = 0; c < kBoneChannels; ++c) {
+            float* dst = out.Lane(c, b);
+            std::fill(dst + begin, dst + end, c == 6 ? 1.0f : 0.0f);
+        }
+    }
+}
+
+void CopyRange(const CrowdPose& in, CrowdPose& out, uint32_t begin, uint32_t end) {
+    for (uint32_t b = 0; b < out.boneCount; ++b) {
+        for (uint32_t c = 0; c < kBoneChannels; ++c) {
+            std::memcpy(out.Lane(c, b) + begin, in.Lane(c, b) + begin,
+                        (end - begin) * sizeof(float));
+        }
+    }
+}
+
+/// The input pose, or the rest pose when unconnected (FK, IK, BoneMask).
+void CopyOrRestRange(const CrowdPose* in, CrowdPose& out, uint32_t begin, uint32_t end) {
+    if (in) CopyRange(*in, out, begin, end);
+    else FillRestRange(out, begin, end);
+}
+
+/// dst[i] += v over [begin, end).
+void AddScalarRange(float* dst, float v, uint32_t begin, uint32_t end) {
+    uint32_t i = begin;
+#ifdef ATLAS_ANIM_SSE2
+    __m128 vv = _mm_set1_ps(v);
+    for (; i + 4 <= end; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), vv));
+    }
+#endif
+    for (; i < end; ++i) dst[i] += v;
+}
+
+/// out = a * ka + b * kb, with null lanes reading as 0.
+void WeightedSumRange(const float* a, float ka, const float* b, float kb,
+                      float* out, uint32_t begin, uint32_t end) {
+    uint32_t i = begin;
+#ifdef ATLAS_ANIM_SSE2
+    __m128 vka = _mm_set1_ps(ka);
+    __m128 vkb = _mm_set1_ps(kb);
+    for (; i + 4 <= end; i += 4) {
+        __m128 va = a ? _mm_loadu_ps(a + i) : _mm_setzero_ps();
+        __m128 vb = b ? _mm_loadu_ps(b + i) : _mm_setzero_ps();
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(va, vka), _mm_mul_ps(vb, vkb)));
+    }
+#endif
+    for (; i < end; ++i) {
+        float va = a ? a[i] : 0.0f;
+        float vb = b ? b[i] : 0.0f;
+        out[i] = va * ka + vb * kb;
+    }
+}
+
+/// out = base + additive * strength, with null lanes reading as 0.
+void AddScaledRange(const float* base, const float* additive, float strength,
+                    float* out, uint32_t begin, uint32_t end) {
+    uint32_t i = begin;
+#ifdef ATLAS_ANIM_SSE2
+    __m128 vs = _mm_set1_ps(strength);
+    for (; i + 4 <= end; i += 4) {
+        __m128 vb = base ? _mm_loadu_ps(base + i) : _mm_setzero_ps();
+        __m128 va = additive ? _mm_loadu_ps(additive + i) : _mm_setzero_ps();
+        _mm_storeu_ps(out + i, _mm_add_ps(vb, _mm_mul_ps(va, vs)));
+    }
+#endif
+    for (; i < end; ++i) {
+        float vb = base ? base[i] : 0.0f;
+        float va = additive ? additive[i] : 0.0f;
+        out[i] = vb + va * strength;
+    }
+}
+
+/// One CCD step of IKNode for bone idx of every instance in the range.
+void IKStepRange(CrowdPose& pose, uint32_t idx, float targetX, float targetY, float targetZ,
+                 uint32_t begin, uint32_t end) {
+    uint32_t endIdx = pose.boneCount - 1;
+    uint32_t affectedCount = endIdx - idx + 1;
+    float* px = pose.Lane(0, 0);
+    float* py = pose.Lane(1, 0);
+    float* pz = pose.Lane(2, 0);
+    size_t stride = pose.instanceCount;
+    size_t e = endIdx * stride;
+    size_t o = idx * stride;
+
+    uint32_t i = begin;
+#ifdef ATLAS_ANIM_SSE2
+    const __m128 eps = _mm_set1_ps(1e-6f);
+    const __m128 tx = _mm_set1_ps(targetX);
+    const __m128 ty = _mm_set1_ps(targetY);
+    const __m128 tz = _mm_set1_ps(targetZ);
+    for (; i + 4 <= end; i += 4) {
+        __m128 ex = _mm_loadu_ps(px + e + i);
+        __m128 ey = _mm_loadu_ps(py + e + i);
+        __m128 ez = _mm_loadu_ps(pz + e + i);
+        __m128 bx = _mm_loadu_ps(px + o + i);
+        __m128 by = _mm_loadu_ps(py + o + i);
+        __m128 bz = _mm_loadu_ps(pz + o + i);
+
+        __m128 toEndX = _mm_sub_ps(ex, bx);
+        __m128 toEndY = _mm_sub_ps(ey, by);
+        __m128 toEndZ = _mm_sub_ps(ez, bz);
+        __m128 toEndLen = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(toEndX, toEndX),
+                                                            _mm_mul_ps(toEndY, toEndY)),
+                                                 _mm_mul_ps(toEndZ, toEndZ)));
+        __m128 toTgtX = _mm_sub_ps(tx, bx);
+        __m128 toTgtY = _mm_sub_ps(ty, by);
+        __m128 toTgtZ = _mm_sub_ps(tz, bz);
+        __m128 toTgtLen = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(toTgtX, toTgtX),
+                                                            _mm_mul_ps(toTgtY, toTgtY)),
+                                                 _mm_mul_ps(toTgtZ, toTgtZ)));
+        __m128 active = _mm_and_ps(_mm_cmpgt_ps(toEndLen, eps), _mm_cmpgt_ps(toTgtLen, eps));
+        if (_mm_movemask_ps(active) == 0) continue;
+
+        __m128 ratio = _mm_div_ps(toEndLen, toTgtLen);
+        __m128 dx = _mm_sub_ps(_mm_add_ps(bx, _mm_mul_ps(toTgtX, ratio)), ex);
+        __m128 dy = _mm_sub_ps(_mm_add_ps(by, _mm_mul_ps(toTgtY, ratio)), ey);
+        __m128 dz = _mm_sub_ps(_mm_add_ps(bz, _mm_mul_ps(toTgtZ, ratio)), ez);
+
+        for (uint32_t j = idx; j <= endIdx; ++j) {
+            __m128 t = _mm_set1_ps(static_cast<float>(j - idx + 1) / static_cast<float>(affectedCount));
+            float* lanes[3] = {px + j * stride + i, py + j * stride + i, pz + j * stride + i};
+            __m128 deltas[3] = {dx, dy, dz};
+            for (int c = 0; c < 3; ++c) {
+                // Lanes that fail the length test keep their exact bits
+                __m128 old = _mm_loadu_ps(lanes[c]);
+                __m128 moved = _mm_add_ps(old, _mm_mul_ps(deltas[c], t));
+                _mm_storeu_ps(lanes[c], _mm_or_ps(_mm_and_ps(active, moved),
+                                                  _mm_andnot_ps(active, old)));
+            }
+        }
+    }
+#endif
+    for (; i < end; ++i) {
+        float ex = px[e + i], ey = py[e + i], ez = pz[e + i];
+        float bx = px[o + i], by = py[o + i], bz = pz[o + i];
+        float toEndX = ex - bx, toEndY = ey - by, toEndZ = ez - bz;
+        float toEndLen = std::sqrt(toEndX * toEndX + toEndY * toEndY + toEndZ * toEndZ);
+        float toTgtX = targetX - bx, toTgtY = targetY - by, toTgtZ = targetZ - bz;
+        float toTgtLen = std::sqrt(toTgtX * toTgtX + toTgtY * toTgtY + toTgtZ * toTgtZ);
+        if (!(toEndLen > 1e-6f && toTgtLen > 1e-6f)) continue;
+
+        float ratio = toEndLen / toTgtLen;
+        float dx = (bx + toTgtX * ratio) - ex;
+        float dy = (by + toTgtY * ratio) - ey;
+        float dz = (bz + toTgtZ * ratio) - ez;
+        for (uint32_t j = idx; j <= endIdx; ++j) {
+            float t = static_cast<float>(j - idx + 1) / static_cast<float>(affectedCount);
+            px[j * stride + i] += dx * t;
+            py[j * stride + i] += dy * t;
+            pz[j * stride + i] += dz * t;
+        }
+    }
+}
+
+} // namespace
+
 BoneNodeID DeterministicAnimationGraph::AddNode(std::unique_ptr<BoneNode> node) {
     BoneNodeID id = m_nextID++;
     m_nodes[id] = std::move(node);
@@ -94,6 +315,7 @@ bool DeterministicAnimationGraph::ValidateEdgeTypes() const {
 
 bool DeterministicAnimationGraph::Compile() {
     m_compiled = false;
+    m_crowdPrepared = false;
     m_executionOrder.clear();
 
     if (HasCycle()) return false;
@@ -165,6 +387,124 @@ bool DeterministicAnimationGraph::Execute(const BoneContext& ctx) {
     return true;
 }
 
+bool DeterministicAnimationGraph::PrepareCrowd(uint32_t instanceCount, uint32_t boneCount) {
+    if (m_crowdPrepared) {
+        if (m_crowdInstances != instanceCount || m_crowdBones != boneCount) {
+            for (auto& port : m_crowdPorts) port.Resize(instanceCount, boneCount);
+            m_crowdInstances = instanceCount;
+            m_crowdBones = boneCount;
+        }
+        return true;
+    }
+
+    m_crowdSteps.clear();
+    m_crowdInputs.clear();
+    m_crowdOutputs.clear();
+    m_crowdPortIndex.clear();
+
+    constexpr uint32_t kNoPort = ~0u;
+    std::vector<uint32_t> outputPorts;
+    std::vector<uint32_t> inputPorts;
+    uint32_t portCount = 0;
+
+    for (BoneNodeID id : m_executionOrder) {
+        auto it = m_nodes.find(id);
+        if (it == m_nodes.end()) return false;
+        const BoneNode* node = it->second.get();
+
+        CrowdStep step;
+        step.node = node;
+        step.firstOutput = static_cast<uint32_t>(outputPorts.size());
+        auto outputDefs = node->Outputs();
+        step.outputCount = static_cast<uint32_t>(outputDefs.size());
+        for (BonePortID p = 0; p < outputDefs.size(); ++p) {
+            if (outputDefs[p].type != BonePinType::BoneTransform) {
+                outputPorts.push_back(kNoPort);
+                continue;
+            }
+            m_crowdPortIndex[(static_cast<uint64_t>(id) << 32) | p] = portCount;
+            outputPorts.push_back(portCount++);
+        }
+
+        step.firstInput = static_cast<uint32_t>(inputPorts.size());
+        step.inputCount = static_cast<uint32_t>(node->Inputs().size());
+        inputPorts.resize(inputPorts.size() + step.inputCount, kNoPort);
+        // Later edges into the same pin win, as in Execute
+        for (auto& e : m_edges) {
+            if (e.toNode != id || e.toPort >= step.inputCount) continue;
+            auto src = m_crowdPortIndex.find((static_cast<uint64_t>(e.fromNode) << 32) | e.fromPort);
+            if (src == m_crowdPortIndex.end()) return false;   // non-pose edge
+            inputPorts[step.firstInput + e.toPort] = src->second;
+        }
+        m_crowdSteps.push_back(step);
+    }
+
+    m_crowdPorts.resize(portCount);
+    for (auto& port : m_crowdPorts) port.Resize(instanceCount, boneCount);
+    for (uint32_t p : outputPorts) {
+        m_crowdOutputs.push_back(p == kNoPort ? nullptr : &m_crowdPorts[p]);
+    }
+    for (uint32_t p : inputPorts) {
+        m_crowdInputs.push_back(p == kNoPort ? nullptr : &m_crowdPorts[p]);
+    }
+
+    m_crowdInstances = instanceCount;
+    m_crowdBones = boneCount;
+    m_crowdPrepared = true;
+    return true;
+}
+
+void DeterministicAnimationGraph::RunCrowdRange(const BoneContext& ctx,
+                                                uint32_t begin, uint32_t end) const {
+    std::vector<BoneValue> inputs;
+    std::vector<BoneValue> outputs;
+    for (const CrowdStep& step : m_crowdSteps) {
+        const CrowdPose* const* in = m_crowdInputs.data() + step.firstInput;
+        CrowdPose* const* out = m_crowdOutputs.data() + step.firstOutput;
+        if (step.node->EvaluateCrowd(ctx, in, step.inputCount, out, step.outputCount, begin, end)) {
+            continue;
+        }
+
+        // No crowd kernel: evaluate one skeleton at a time
+        for (uint32_t i = begin; i < end; ++i) {
+            inputs.assign(step.inputCount, BoneValue{BonePinType::BoneTransform, {}});
+            for (uint32_t k = 0; k < step.inputCount; ++k) {
+                if (in[k]) in[k]->GatherInstance(i, inputs[k].data);
+            }
+            outputs.assign(step.outputCount, BoneValue{BonePinType::BoneTransform, {}});
+            step.node->Evaluate(ctx, inputs, outputs);
+            for (uint32_t k = 0; k < step.outputCount; ++k) {
+                if (out[k]) out[k]->ScatterInstance(i, outputs[k].data);
+            }
+        }
+    }
+}
+
+bool DeterministicAnimationGraph::ExecuteCrowd(const BoneContext& ctx, uint32_t instanceCount,
+                                               const CrowdEvalOptions& options) {
+    if (!m_compiled) return false;
+    if (!PrepareCrowd(instanceCount, ctx.boneCount)) return false;
+    if (instanceCount == 0) return true;
+
+    // Whole SIMD groups per chunk keep the scalar tails at the crowd's end
+    uint32_t chunk = std::max(4u, (options.chunkSize + 3u) & ~3u);
+    if (options.parallel && instanceCount > chunk) {
+        JobSystem::Shared().ParallelFor(instanceCount, [&](size_t begin, size_t end) {
+            RunCrowdRange(ctx, static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+        }, chunk);
+    } else {
+        RunCrowdRange(ctx, 0, instanceCount);
+    }
+    return true;
+}
+
+const CrowdPose* DeterministicAnimationGraph::GetCrowdOutput(BoneNodeID node, BonePortID port) const {
+    if (!m_crowdPrepared) return nullptr;
+    auto it = m_crowdPortIndex.find((static_cast<uint64_t>(node) << 32) | port);
+    if (it == m_crowdPortIndex.end()) return nullptr;
+    return &m_crowdPorts[it->second];
+}
+
 const BoneValue* DeterministicAnimationGraph::GetOutput(BoneNodeID node, BonePortID port) const {
     uint64_t key = (static_cast<uint64_t>(node) << 32) | port;
     auto it = m_outputs.find(key);
@@ -354,4 +694,128 @@ void AdditiveBlendNode::Evaluate(const BoneContext& ctx,
     outputs[0] = std::move(pose);
 }
 
+// --- Crowd Node Implementations ---
+
+bool RestPoseNode::EvaluateCrowd(const BoneContext& /*ctx*/,
+                                 const CrowdPose* const* /*inputs*/, size_t /*inputCount*/,
+                                 CrowdPose* const* outputs, size_t /*outputCount*/,
+                                 uint32_t begin, uint32_t end) const {
+    FillRestRange(*outputs[0], begin, end);
+    return true;
+}
+
+void PoseInputNode::Evaluate(const BoneContext& ctx,
+                             const std::vector<BoneValue>& /*inputs*/,
+                             std::vector<BoneValue>& outputs) const {
+    BoneValue out;
+    out.type = BonePinType::BoneTransform;
+    if (pose.size() == static_cast<size_t>(ctx.boneCount) * kBoneChannels) {
+        out.data = pose;
+    } else {
+        out.data.resize(ctx.boneCount * 7, 0.0f);
+        for (uint32_t i = 0; i < ctx.boneCount; ++i)
+            out.data[i * 7 + 6] = 1.0f;
+    }
+    outputs[0] = std::move(out);
+}
+
+bool PoseInputNode::EvaluateCrowd(const BoneContext& /*ctx*/,
+                                  const CrowdPose* const* /*inputs*/, size_t /*inputCount*/,
+                                  CrowdPose* const* outputs, size_t /*outputCount*/,
+                                  uint32_t begin, uint32_t end) const {
+    CrowdPose& out = *outputs[0];
+    if (crowd && crowd->instanceCount == out.instanceCount && crowd->boneCount == out.boneCount) {
+        CopyRange(*crowd, out, begin, end);
+    } else if (pose.size() == static_cast<size_t>(out.boneCount) * kBoneChannels) {
+        for (uint32_t b = 0; b < out.boneCount; ++b) {
+            for (uint32_t c = 0; c < kBoneChannels; ++c) {
+                float* dst = out.Lane(c, b);
+                std::fill(dst + begin, dst + end, pose[b * kBoneChannels + c]);
+            }
+        }
+    } else {
+        FillRestRange(out, begin, end);
+    }
+    return true;
+}
+
+bool FKNode::EvaluateCrowd(const BoneContext& /*ctx*/,
+                           const CrowdPose* const* inputs, size_t inputCount,
+                           CrowdPose* const* outputs, size_t /*outputCount*/,
+                           uint32_t begin, uint32_t end) const {
+    CrowdPose& out = *outputs[0];
+    CopyOrRestRange(inputCount > 0 ? inputs[0] : nullptr, out, begin, end);
+    for (uint32_t b = 0; b < out.boneCount; ++b) {
+        AddScalarRange(out.Lane(4, b), rotationAngle, begin, end);   // rotY
+    }
+    return true;
+}
+
+bool IKNode::EvaluateCrowd(const BoneContext& /*ctx*/,
+                           const CrowdPose* const* inputs, size_t inputCount,
+                           CrowdPose* const* outputs, size_t /*outputCount*/,
+                           uint32_t begin, uint32_t end) const {
+    CrowdPose& out = *outputs[0];
+    CopyOrRestRange(inputCount > 0 ? inputs[0] : nullptr, out, begin, end);
+    if (out.boneCount == 0) return true;
+    for (int iter = 0; iter < iterations; ++iter) {
+        for (uint32_t b = out.boneCount; b > 0; --b) {
+            IKStepRange(out, b - 1, targetX, targetY, targetZ, begin, end);
+        }
+    }
+    return true;
+}
+
+bool BlendTreeNode::EvaluateCrowd(const BoneContext& /*ctx*/,
+                                  const CrowdPose* const* inputs, size_t inputCount,
+                                  CrowdPose* const* outputs, size_t /*outputCount*/,
+                                  uint32_t begin, uint32_t end) const {
+    CrowdPose& out = *outputs[0];
+    const CrowdPose* a = inputCount > 0 ? inputs[0] : nullptr;
+    const CrowdPose* b = inputCount > 1 ? inputs[1] : nullptr;
+    float w = weight;
+    for (uint32_t bone = 0; bone < out.boneCount; ++bone) {
+        for (uint32_t c = 0; c < kBoneChannels; ++c) {
+            WeightedSumRange(a ? a->Lane(c, bone) : nullptr, 1.0f - w,
+                             b ? b->Lane(c, bone) : nullptr, w,
+                             out.Lane(c, bone), begin, end);
+        }
+    }
+    return true;
+}
+
+bool BoneMaskNode::EvaluateCrowd(const BoneContext& /*ctx*/,
+                                 const CrowdPose* const* inputs, size_t inputCount,
+                                 CrowdPose* const* outputs, size_t /*outputCount*/,
+                                 uint32_t begin, uint32_t end) const {
+    CrowdPose& out = *outputs[0];
+    CopyOrRestRange(inputCount > 0 ? inputs[0] : nullptr, out, begin, end);
+    for (uint32_t b = 0; b < out.boneCount; ++b) {
+        bool active = (b < mask.size()) ? mask[b] : false;
+        if (active) continue;
+        for (uint32_t c = 0; c < kBoneChannels; ++c) {
+            float* dst = out.Lane(c, b);
+            std::fill(dst + begin, dst + end, 0.0f);
+        }
+    }
+    return true;
+}
+
+bool AdditiveBlendNode::EvaluateCrowd(const BoneContext& /*ctx*/,
+                                      const CrowdPose* const* inputs, size_t inputCount,
+                                      CrowdPose* const* outputs, size_t /*outputCount*/,
+                                      uint32_t begin, uint32_t end) const {
+    CrowdPose& out = *outputs[0];
+    const CrowdPose* base = inputCount > 0 ? inputs[0] : nullptr;
+    const CrowdPose* additive = inputCount > 1 ? inputs[1] : nullptr;
+    for (uint32_t bone = 0; bone < out.boneCount; ++bone) {
+        for (uint32_t c = 0; c < kBoneChannels; ++c) {
+            AddScaledRange(base ? base->Lane(c, bone) : nullptr,
+                           additive ? additive->Lane(c, bone) : nullptr, strength,
+                           out.Lane(c, bone), begin, end);
+        }
+    }
+    return true;
+}
+
 } // namespace atlas::animation
@@ -48,6 +48,44 @@ struct BoneContext {
     uint64_t seed = 0;
 };
 
+// ============================================================
+// Crowd poses
+// ============================================================
+//
+// A CrowdPose holds one BoneTransform pose for each of instanceCount
+// skeletons in structure-of-arrays form. Channel c (posX, posY, posZ,
+// rotX, rotY, rotZ, rotW) of bone b of instance i lives at
+// lanes[c][b * instanceCount + i], so crowd kernels stream one channel
+// of one bone across consecutive skeletons and vectorize over them.
+
+constexpr uint32_t kBoneChannels = 7;
+
+struct CrowdPose {
+    uint32_t instanceCount = 0;
+    uint32_t boneCount = 0;
+    std::vector<float> lanes[kBoneChannels];
+
+    void Resize(uint32_t instances, uint32_t bones);
+    float* Lane(uint32_t channel, uint32_t bone) {
+        return lanes[channel].data() + static_cast<size_t>(bone) * instanceCount;
+    }
+    const float* Lane(uint32_t channel, uint32_t bone) const {
+        return lanes[channel].data() + static_cast<size_t>(bone) * instanceCount;
+    }
+
+    BoneTransform GetBone(uint32_t instance, uint32_t bone) const;
+    void SetBone(uint32_t instance, uint32_t bone, const BoneTransform& t);
+    /// Copy one instance to/from the interleaved 7-floats-per-bone layout
+    /// used by BoneValue.
+    void GatherInstance(uint32_t instance, std::vector<float>& aos) const;
+    void ScatterInstance(uint32_t instance, const std::vector<float>& aos);
+};
+
+struct CrowdEvalOptions {
+    uint32_t chunkSize = 64;   // instances per job
+    bool parallel = true;
+};
+
 class BoneNode {
 public:
     virtual ~BoneNode() = default;
@@ -58,6 +96,18 @@ public:
     virtual void Evaluate(const BoneContext& ctx,
                           const std::vector<BoneValue>& inputs,
                           std::vector<BoneValue>& outputs) const = 0;
+
+    /// Evaluate instances [begin, end) of a crowd. Unconnected inputs are
+    /// null; outputs are sized for the whole crowd and only the range may
+    /// be written. Must produce exactly what Evaluate produces for each
+    /// instance. Returns false when the node has no crowd kernel, in which
+    /// case the graph runs Evaluate once per instance instead.
+    virtual bool EvaluateCrowd(const BoneContext& /*ctx*/,
+                               const CrowdPose* const* /*inputs*/, size_t /*inputCount*/,
+                               CrowdPose* const* /*outputs*/, size_t /*outputCount*/,
+                               uint32_t /*begin*/, uint32_t /*end*/) const {
+        return false;
+    }
 };
 
 class DeterministicAnimationGraph {
@@ -70,11 +120,31 @@ public:
     bool Compile();
     bool Execute(const BoneContext& ctx);
 
+    /// Evaluate the compiled graph for instanceCount skeletons of
+    /// ctx.boneCount bones at once, chunked over the shared JobSystem.
+    /// Every instance matches a per-skeleton Execute bit for bit. Only
+    /// graphs whose edges all carry BoneTransform poses are supported.
+    bool ExecuteCrowd(const BoneContext& ctx, uint32_t instanceCount,
+                      const CrowdEvalOptions& options = {});
+
     const BoneValue* GetOutput(BoneNodeID node, BonePortID port) const;
+    /// Result of the last ExecuteCrowd, or null.
+    const CrowdPose* GetCrowdOutput(BoneNodeID node, BonePortID port) const;
     size_t NodeCount() const;
     bool IsCompiled() const;
 
 private:
+    struct CrowdStep {
+        const BoneNode* node = nullptr;
+        uint32_t firstInput = 0;
+        uint32_t inputCount = 0;
+        uint32_t firstOutput = 0;
+        uint32_t outputCount = 0;
+    };
+
+    bool PrepareCrowd(uint32_t instanceCount, uint32_t boneCount);
+    void RunCrowdRange(const BoneContext& ctx, uint32_t begin, uint32_t end) const;
+
     BoneNodeID m_nextID = 1;
     std::unordered_map<BoneNodeID, std::unique_ptr<BoneNode>> m_nodes;
     std::vector<BoneEdge> m_edges;
@@ -82,6 +152,16 @@ private:
     bool m_compiled = false;
     std::unordered_map<uint64_t, BoneValue> m_outputs;
 
+    // Crowd plan, rebuilt when the graph or crowd dimensions change
+    bool m_crowdPrepared = false;
+    uint32_t m_crowdInstances = 0;
+    uint32_t m_crowdBones = 0;
+    std::vector<CrowdStep> m_crowdSteps;
+    std::vector<CrowdPose> m_crowdPorts;
+    std::vector<CrowdPose*> m_crowdOutputs;        // per step output; null for non-pose pins
+    std::vector<const CrowdPose*> m_crowdInputs;   // per step input; null when unconnected
+    std::unordered_map<uint64_t, uint32_t> m_crowdPortIndex;
+
     bool HasCycle() const;
     bool ValidateEdgeTypes() const;
 };
@@ -97,6 +177,29 @@ public:
         return {{"Pose", BonePinType::BoneTransform}};
     }
     void Evaluate(const BoneContext& ctx, const std::vector<BoneValue>& inputs, std::vector<BoneValue>& outputs) const override;
+    bool EvaluateCrowd(const BoneContext& ctx, const CrowdPose* const* inputs, size_t inputCount,
+                       CrowdPose* const* outputs, size_t outputCount,
+                       uint32_t begin, uint32_t end) const override;
+};
+
+/// Source pose supplied by the caller. Execute outputs `pose` (the rest
+/// pose when it does not hold ctx.boneCount bones); ExecuteCrowd reads
+/// each instance from `crowd` when it matches the crowd dimensions and
+/// otherwise broadcasts what Execute would output.
+class PoseInputNode : public BoneNode {
+public:
+    std::vector<float> pose;
+    const CrowdPose* crowd = nullptr;
+    const char* GetName() const override { return "PoseInput"; }
+    const char* GetCategory() const override { return "Source"; }
+    std::vector<BonePort> Inputs() const override { return {}; }
+    std::vector<BonePort> Outputs() const override {
+        return {{"Pose", BonePinType::BoneTransform}};
+    }
+    void Evaluate(const BoneContext& ctx, const std::vector<BoneValue>& inputs, std::vector<BoneValue>& outputs) const override;
+    bool EvaluateCrowd(const BoneContext& ctx, const CrowdPose* const* inputs, size_t inputCount,
+                       CrowdPose* const* outputs, size_t outputCount,
+                       uint32_t begin, uint32_t end) const override;
 };
 
 class FKNode : public BoneNode {
@@ -111,6 +214,9 @@ public:
         return {{"Pose", BonePinType::BoneTransform}};
     }
     void Evaluate(const BoneContext& ctx, const std::vector<BoneValue>& inputs, std::vector<BoneValue>& outputs) const override;
+    bool EvaluateCrowd(const BoneContext& ctx, const CrowdPose* const* inputs, size_t inputCount,
+                       CrowdPose* const* outputs, size_t outputCount,
+                       uint32_t begin, uint32_t end) const override;
 };
 
 class IKNode : public BoneNode {
@@ -126,6 +232,9 @@ public:
         return {{"Pose", BonePinType::BoneTransform}};
     }
     void Evaluate(const BoneContext& ctx, const std::vector<BoneValue>& inputs, std::vector<BoneValue>& outputs) const override;
+    bool EvaluateCrowd(const BoneContext& ctx, const CrowdPose* const* inputs, size_t inputCount,
+                       CrowdPose* const* outputs, size_t outputCount,
+                       uint32_t begin, uint32_t end) const override;
 };
 
 class BlendTreeNode : public BoneNode {
@@ -140,6 +249,9 @@ public:
         return {{"Pose", BonePinType::BoneTransform}};
     }
     void Evaluate(const BoneContext& ctx, const std::vector<BoneValue>& inputs, std::vector<BoneValue>& outputs) const override;
+    bool EvaluateCrowd(const BoneContext& ctx, const CrowdPose* const* inputs, size_t inputCount,
+                       CrowdPose* const* outputs, size_t outputCount,
+                       uint32_t begin, uint32_t end) const override;
 };
 
 class BoneMaskNode : public BoneNode {
@@ -154,6 +266,9 @@ public:
         return {{"Pose", BonePinType::BoneTransform}};
     }
     void Evaluate(const BoneContext& ctx, const std::vector<BoneValue>& inputs, std::vector<BoneValue>& outputs) const override;
+    bool EvaluateCrowd(const BoneContext& ctx, const CrowdPose* const* inputs, size_t inputCount,
+                       CrowdPose* const* outputs, size_t outputCount,
+                       uint32_t begin, uint32_t end) const override;
 };
 
 class AdditiveBlendNode : public BoneNode {
@@ -168,6 +283,9 @@ public:
         return {{"Pose", BonePinType::BoneTransform}};
     }
     void Evaluate(const BoneContext& ctx, const std::vector<BoneValue>& inputs, std::vector<BoneValue>& outputs) const override;
+    bool EvaluateCrowd(const BoneContext& ctx, const CrowdPose* const* inputs, size_t inputCount,
+                       CrowdPose* const* outputs, size_t outputCount,
+                       uint32_t begin, uint32_t end) const override;
 };
 
 } // namespace atlas::animation
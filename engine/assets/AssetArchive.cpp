@@ -0,0 +1,443 @@
+#include "AssetArchive.h"
+#include "../sim/StateHasher.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace atlas::asset {
+
+namespace {
+
+uint64_t HashId(std::string_view id) {
+    uint64_t h = 14695981039346656037ULL;
+    for (char c : id) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+uint64_t HashContent(const uint8_t* data, size_t size) {
+    return sim::StateHasher::HashCombine(0, data, size);
+}
+
+uint64_t Mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint32_t Slot(uint64_t idHash, uint32_t displacement, uint32_t entryCount) {
+    return static_cast<uint32_t>(Mix(idHash + displacement * 0x9E3779B97F4A7C15ULL) % entryCount);
+}
+
+uint32_t BucketCount(uint32_t entryCount) {
+    return std::max<uint32_t>(1, (entryCount + 3) / 4);
+}
+
+uint64_t AlignUp(uint64_t v) {
+    return (v + ARCHIVE_ALIGNMENT - 1) & ~static_cast<uint64_t>(ARCHIVE_ALIGNMENT - 1);
+}
+
+uint32_t Load32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+void PutLength(std::vector<uint8_t>& out, size_t extra) {
+    while (extra >= 255) {
+        out.push_back(255);
+        extra -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(extra));
+}
+
+bool GetLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+    uint8_t b;
+    do {
+        if (ip >= end) return false;
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+}
+
+// --- LZ block codec ---
+//
+// A sequence is a token (literal length << 4 | match length - 4), the
+// literals, a 16-bit match offset and the match. A nibble of 15 is
+// continued in following bytes (255 = keep adding). The block ends with
+// a sequence that has literals only.
+
+std::vector<uint8_t> LzCompress(const uint8_t* src, size_t size) {
+    constexpr int kHashBits = 14;
+    constexpr size_t kMinMatch = 4;
+    constexpr size_t kMaxOffset = 65535;
+    std::vector<uint8_t> out;
+    if (size < 16) return out;
+    out.reserve(size);
+
+    std::vector<uint32_t> table(size_t{1} << kHashBits, UINT32_MAX);
+    auto emit = [&out](const uint8_t* lit, size_t litLen, size_t offset, size_t matchLen) {
+        size_t m = matchLen ? matchLen - kMinMatch : 0;
+        out.push_back(static_cast<uint8_t>((std::min<size_t>(litLen, 15) << 4) | std::min<size_t>(m, 15)));
+        if (litLen >= 15) PutLength(out, litLen - 15);
+        out.insert(out.end(), lit, lit + litLen);
+        if (matchLen == 0) return;
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+        if (m >= 15) PutLength(out, m - 15);
+    };
+
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + kMinMatch <= size) {
+        uint32_t seq = Load32(src + i);
+        uint32_t h = (seq * 2654435761u) >> (32 - kHashBits);
+        uint32_t candidate = table[h];
+        table[h] = static_cast<uint32_t>(i);
+        if (candidate != UINT32_MAX && i - candidate <= kMaxOffset && Load32(src + candidate) == seq) {
+            size_t len = kMinMatch;
+            while (i + len < size && src[candidate + len] == src[i + len]) len++;
+            emit(src + anchor, i - anchor, i - candidate, len);
+            i += len;
+            anchor = i;
+            if (out.size() >= size) return {};
+            continue;
+        }
+        i++;
+    }
+    emit(src + anchor, size - anchor, 0, 0);
+    if (out.size() >= size) return {};
+    return out;
+}
+
+bool LzDecompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* ip = src;
+    const uint8_t* end = src + srcSize;
+    size_t op = 0;
+    while (ip < end) {
+        uint8_t token = *ip++;
+        size_t litLen = token >> 4;
+        if (litLen == 15 && !GetLength(ip, end, litLen)) return false;
+        if (litLen > static_cast<size_t>(end - ip) || litLen > dstSize - op) return false;
+        std::memcpy(dst + op, ip, litLen);
+        ip += litLen;
+        op += litLen;
+        if (ip == end) break;   // final sequence
+
+        if (end - ip < 2) return false;
+        size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        size_t matchLen = token & 15;
+        if (matchLen == 15 && !GetLength(ip, end, matchLen)) return false;
+        matchLen += 4;
+        if (offset == 0 || offset > op || matchLen > dstSize - op) return false;
+        // Byte by byte: the match may overlap the bytes it produces
+        for (size_t k = 0; k < matchLen; ++k, ++op) dst[op] = dst[op - offset];
+    }
+    return op == dstSize;
+}
+
+// --- AssetArchiveWriter ---
+
+bool AssetArchiveWriter::Add(const std::string& id, std::vector<uint8_t> data, bool compress) {
+    if (id.empty() || id.size() > UINT16_MAX || !m_ids.insert(id).second) return false;
+    m_entries.push_back({id, std::move(data), compress});
+    return true;
+}
+
+bool AssetArchiveWriter::AddFile(const std::string& id, const std::string& path, bool compress) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return Add(id, std::move(data), compress);
+}
+
+bool AssetArchiveWriter::Write(const std::string& path) const {
+    uint32_t n = static_cast<uint32_t>(m_entries.size());
+    ArchiveHeader header;
+    header.entryCount = n;
+    header.bucketCount = BucketCount(n);
+
+    // Perfect hash: place the fullest buckets first, trying displacements
+    // until every id of the bucket lands in a free slot
+    std::vector<uint64_t> hashes(n);
+    std::vector<std::vector<uint32_t>> buckets(header.bucketCount);
+    for (uint32_t i = 0; i < n; ++i) {
+        hashes[i] = HashId(m_entries[i].id);
+        buckets[hashes[i] % header.bucketCount].push_back(i);
+    }
+    std::vector<uint32_t> bucketOrder(header.bucketCount);
+    for (uint32_t b = 0; b < header.bucketCount; ++b) bucketOrder[b] = b;
+    std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&buckets](uint32_t a, uint32_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    std::vector<uint32_t> displacement(header.bucketCount, 0);
+    std::vector<int64_t> slotOwner(n, -1);
+    std::vector<uint32_t> slots;
+    for (uint32_t b : bucketOrder) {
+        const auto& members = buckets[b];
+        if (members.empty()) continue;
+        bool placed = false;
+        for (uint32_t d = 0; d < 1u << 24 && !placed; ++d) {
+            slots.clear();
+            placed = true;
+            for (uint32_t m : members) {
+                uint32_t s = Slot(hashes[m], d, n);
+                if (slotOwner[s] >= 0 || std::find(slots.begin(), slots.end(), s) != slots.end()) {
+                    placed = false;
+                    break;
+                }
+                slots.push_back(s);
+            }
+            if (placed) {
+                displacement[b] = d;
+                for (size_t k = 0; k < members.size(); ++k) slotOwner[slots[k]] = members[k];
+            }
+        }
+        if (!placed) return false;   // only on 64-bit id hash collisions
+    }
+
+    // Names and entry payloads in slot order
+    std::vector<ArchiveEntry> toc(n);
+    std::string names;
+    std::vector<std::vector<uint8_t>> compressed(n);
+    for (uint32_t s = 0; s < n; ++s) {
+        const Pending& p = m_entries[static_cast<size_t>(slotOwner[s])];
+        ArchiveEntry& e = toc[s];
+        e.idHash = HashId(p.id);
+        e.size = p.data.size();
+        e.contentHash = HashContent(p.data.data(), p.data.size());
+        e.nameOffset = static_cast<uint32_t>(names.size());
+        e.nameLength = static_cast<uint16_t>(p.id.size());
+        names += p.id;
+        if (p.compress) compressed[s] = LzCompress(p.data.data(), p.data.size());
+        e.compression = compressed[s].empty() ? ArchiveCompression::None : ArchiveCompression::LZ;
+        e.storedSize = compressed[s].empty() ? p.data.size() : compressed[s].size();
+    }
+
+    header.tocOffset = AlignUp(sizeof(ArchiveHeader));
+    header.bucketOffset = header.tocOffset + sizeof(ArchiveEntry) * n;
+    header.namesOffset = header.bucketOffset + sizeof(uint32_t) * header.bucketCount;
+    header.namesSize = names.size();
+    header.dataOffset = AlignUp(header.namesOffset + header.namesSize);
+    uint64_t offset = header.dataOffset;
+    for (ArchiveEntry& e : toc) {
+        e.offset = offset;
+        offset = AlignUp(offset + e.storedSize);
+    }
+    uint64_t h = HashContent(reinterpret_cast<const uint8_t*>(toc.data()), toc.size() * sizeof(ArchiveEntry));
+    h = sim::StateHasher::HashCombine(h, reinterpret_cast<const uint8_t*>(displacement.data()),
+                                      displacement.size() * sizeof(uint32_t));
+    header.indexHash = sim::StateHasher::HashCombine(h, reinterpret_cast<const uint8_t*>(names.data()),
+                                                     names.size());
+
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        static const char zeros[ARCHIVE_ALIGNMENT] = {};
+        auto pad = [&out](uint64_t to) {
+            uint64_t at = static_cast<uint64_t>(out.tellp());
+            if (to > at) out.write(zeros, static_cast<std::streamsize>(to - at));
+        };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        pad(header.tocOffset);
+        out.write(reinterpret_cast<const char*>(toc.data()),
+                  static_cast<std::streamsize>(toc.size() * sizeof(ArchiveEntry)));
+        out.write(reinterpret_cast<const char*>(displacement.data()),
+                  static_cast<std::streamsize>(displacement.size() * sizeof(uint32_t)));
+        out.write(names.data(), static_cast<std::streamsize>(names.size()));
+        for (uint32_t s = 0; s < n; ++s) {
+            pad(toc[s].offset);
+            const std::vector<uint8_t>& bytes = compressed[s].empty()
+                ? m_entries[static_cast<size_t>(slotOwner[s])].data : compressed[s];
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+}
+
+// --- AssetArchive ---
+
+AssetArchive::~AssetArchive() {
+    Close();
+}
+
+AssetArchive::AssetArchive(AssetArchive&& other) noexcept {
+    *this = std::move(other);
+}
+
+AssetArchive& AssetArchive::operator=(AssetArchive&& other) noexcept {
+    if (this == &other) return *this;
+    Close();
+    // A moved vector keeps its storage, so every pointer stays valid
+    m_path = std::move(other.m_path);
+    m_buffer = std::move(other.m_buffer);
+    m_data = other.m_data;
+    m_size = other.m_size;
+    m_mapped = other.m_mapped;
+    m_header = other.m_header;
+    m_toc = other.m_toc;
+    m_buckets = other.m_buckets;
+    m_names = other.m_names;
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_mapped = false;
+    other.m_header = nullptr;
+    other.m_toc = nullptr;
+    other.m_buckets = nullptr;
+    other.m_names = nullptr;
+    return *this;
+}
+
+bool AssetArchive::Open(const std::string& path) {
+    Close();
+#if !defined(_WIN32)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(ArchiveHeader))) {
+        void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            m_data = static_cast<const uint8_t*>(p);
+            m_size = static_cast<size_t>(st.st_size);
+            m_mapped = true;
+        }
+    }
+    ::close(fd);
+#endif
+    if (!m_data) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open()) return false;
+        m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+    m_path = path;
+    if (!Validate()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void AssetArchive::Close() {
+#if !defined(_WIN32)
+    if (m_mapped && m_data) ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_path.clear();
+    m_header = nullptr;
+    m_toc = nullptr;
+    m_buckets = nullptr;
+    m_names = nullptr;
+}
+
+bool AssetArchive::Validate() {
+    if (m_size < sizeof(ArchiveHeader)) return false;
+    m_header = reinterpret_cast<const ArchiveHeader*>(m_data);
+    const ArchiveHeader& h = *m_header;
+    if (h.magic != ARCHIVE_MAGIC || h.version != ARCHIVE_VERSION) return false;
+    if (h.bucketCount != BucketCount(h.entryCount)) return false;
+    if (h.tocOffset % alignof(ArchiveEntry) != 0 || h.tocOffset > m_size ||
+        static_cast<uint64_t>(h.entryCount) * sizeof(ArchiveEntry) > m_size - h.tocOffset ||
+        h.bucketOffset != h.tocOffset + static_cast<uint64_t>(h.entryCount) * sizeof(ArchiveEntry) ||
+        h.namesOffset != h.bucketOffset + static_cast<uint64_t>(h.bucketCount) * sizeof(uint32_t) ||
+        h.namesOffset > m_size || h.namesSize > m_size - h.namesOffset) {
+        return false;
+    }
+    m_toc = reinterpret_cast<const ArchiveEntry*>(m_data + h.tocOffset);
+    m_buckets = reinterpret_cast<const uint32_t*>(m_data + h.bucketOffset);
+    m_names = reinterpret_cast<const char*>(m_data + h.namesOffset);
+
+    uint64_t index = HashContent(m_data + h.tocOffset, h.namesOffset + h.namesSize - h.tocOffset);
+    // The three sections are contiguous, so hashing them in one pass
+    // matches the writer's chained hash
+    if (index != h.indexHash) return false;
+
+    for (uint32_t i = 0; i < h.entryCount; ++i) {
+        const ArchiveEntry& e = m_toc[i];
+        if (e.offset > m_size || e.storedSize > m_size - e.offset) return false;
+        if (static_cast<uint64_t>(e.nameOffset) + e.nameLength > h.namesSize) return false;
+        if (e.compression == ArchiveCompression::None && e.storedSize != e.size) return false;
+        if (e.compression != ArchiveCompression::None && e.compression != ArchiveCompression::LZ) return false;
+    }
+    return true;
+}
+
+size_t AssetArchive::Count() const {
+    return m_header ? m_header->entryCount : 0;
+}
+
+const ArchiveEntry* AssetArchive::Find(std::string_view id) const {
+    if (!m_header || m_header->entryCount == 0) return nullptr;
+    uint64_t h = HashId(id);
+    uint32_t slot = Slot(h, m_buckets[h % m_header->bucketCount], m_header->entryCount);
+    const ArchiveEntry& e = m_toc[slot];
+    if (e.idHash != h || EntryId(e) != id) return nullptr;
+    return &e;
+}
+
+std::string_view AssetArchive::EntryId(const ArchiveEntry& entry) const {
+    return std::string_view(m_names + entry.nameOffset, entry.nameLength);
+}
+
+std::vector<std::string> AssetArchive::Ids() const {
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < Count(); ++i) ids.emplace_back(EntryId(m_toc[i]));
+    return ids;
+}
+
+std::span<const uint8_t> AssetArchive::View(std::string_view id) const {
+    const ArchiveEntry* e = Find(id);
+    if (!e || e->compression != ArchiveCompression::None) return {};
+    return {m_data + e->offset, static_cast<size_t>(e->size)};
+}
+
+bool AssetArchive::Read(std::string_view id, std::vector<uint8_t>& out) const {
+    const ArchiveEntry* e = Find(id);
+    if (!e) return false;
+    const uint8_t* stored = m_data + e->offset;
+    if (e->compression == ArchiveCompression::None) {
+        out.assign(stored, stored + e->size);
+        return true;
+    }
+    out.resize(static_cast<size_t>(e->size));
+    return LzDecompress(stored, static_cast<size_t>(e->storedSize), out.data(), out.size());
+}
+
+bool AssetArchive::Verify(std::string_view id) const {
+    const ArchiveEntry* e = Find(id);
+    if (!e) return false;
+    if (e->compression == ArchiveCompression::None) {
+        return HashContent(m_data + e->offset, static_cast<size_t>(e->size)) == e->contentHash;
+    }
+    std::vector<uint8_t> data;
+    return Read(id, data) && HashContent(data.data(), data.size()) == e->contentHash;
+}
+
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace atlas::asset {
+
+// ============================================================
+// Packed asset archive (.atlaspak)
+// ============================================================
+//
+// One file holding every cooked asset of a package:
+//
+//   ArchiveHeader (64 bytes)
+//   ArchiveEntry[entryCount]     table of contents, in hash-slot order
+//   uint32_t[bucketCount]        perfect-hash displacements
+//   names                        asset ids, not terminated
+//   entry data                   each entry 16-byte aligned
+//
+// Lookup hashes the id once: the bucket's displacement selects the
+// TOC slot directly, and the stored id confirms the hit. The reader
+// maps the file, so uncompressed entries are returned as spans into
+// the mapping without a copy. Every entry carries the hash of its
+// uncompressed bytes (the same hash AssetValidator uses).
+
+constexpr uint32_t ARCHIVE_MAGIC = 0x4B505441; // "ATPK"
+constexpr uint16_t ARCHIVE_VERSION = 1;
+constexpr uint32_t ARCHIVE_ALIGNMENT = 16;
+
+enum class ArchiveCompression : uint8_t {
+    None = 0,
+    LZ = 1          // byte-oriented LZ77 block, see LzCompress
+};
+
+struct ArchiveHeader {
+    uint32_t magic = ARCHIVE_MAGIC;
+    uint16_t version = ARCHIVE_VERSION;
+    uint16_t flags = 0;
+    uint32_t entryCount = 0;
+    uint32_t bucketCount = 0;
+    uint64_t tocOffset = 0;
+    uint64_t bucketOffset = 0;
+    uint64_t namesOffset = 0;
+    uint64_t namesSize = 0;
+    uint64_t dataOffset = 0;
+    uint64_t indexHash = 0;     // TOC, displacements and names
+};
+static_assert(sizeof(ArchiveHeader) == 64, "archive header layout");
+
+struct ArchiveEntry {
+    uint64_t idHash = 0;
+    uint64_t offset = 0;        // from the start of the file
+    uint64_t storedSize = 0;
+    uint64_t size = 0;          // uncompressed
+    uint64_t contentHash = 0;   // of the uncompressed bytes
+    uint32_t nameOffset = 0;
+    uint16_t nameLength = 0;
+    ArchiveCompression compression = ArchiveCompression::None;
+    uint8_t reserved = 0;
+};
+static_assert(sizeof(ArchiveEntry) == 48, "archive TOC entry layout");
+
+/// Compress src as one LZ block. Returns an empty vector when the block
+/// would not be smaller than the input.
+std::vector<uint8_t> LzCompress(const uint8_t* src, size_t size);
+/// Decode a block produced by LzCompress into exactly dstSize bytes.
+bool LzDecompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+class AssetArchiveWriter {
+public:
+    /// Queue an entry. Fails on an empty or duplicate id.
+    bool Add(const std::string& id, std::vector<uint8_t> data, bool compress = false);
+    bool AddFile(const std::string& id, const std::string& path, bool compress = false);
+    size_t Count() const { return m_entries.size(); }
+
+    /// Write the archive (through a temp file renamed into place).
+    bool Write(const std::string& path) const;
+
+private:
+    struct Pending {
+        std::string id;
+        std::vector<uint8_t> data;
+        bool compress = false;
+    };
+    std::vector<Pending> m_entries;
+    std::unordered_set<std::string> m_ids;
+};
+
+class AssetArchive {
+public:
+    AssetArchive() = default;
+    ~AssetArchive();
+    AssetArchive(AssetArchive&& other) noexcept;
+    AssetArchive& operator=(AssetArchive&& other) noexcept;
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    /// Map path and validate its header, index and entry bounds.
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_data != nullptr; }
+    const std::string& Path() const { return m_path; }
+
+    size_t Count() const;
+    const ArchiveEntry* Find(std::string_view id) const;
+    bool Contains(std::string_view id) const { return Find(id) != nullptr; }
+    std::string_view EntryId(const ArchiveEntry& entry) const;
+    std::vector<std::string> Ids() const;
+
+    /// Bytes of an uncompressed entry, pointing into the mapping; empty
+    /// when the entry is missing or compressed. Valid until Close.
+    std::span<const uint8_t> View(std::string_view id) const;
+    /// Copy (and decompress) an entry.
+    bool Read(std::string_view id, std::vector<uint8_t>& out) const;
+    /// Recompute the content hash of an entry.
+    bool Verify(std::string_view id) const;
+
+private:
+    bool Validate();
+
+    std::string m_path;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_mapped = false;
+    std::vector<uint8_t> m_buffer;     // when the file could not be mapped
+    const ArchiveHeader* m_header = nullptr;
+    const ArchiveEntry* m_toc = nullptr;
+    const uint32_t* m_buckets = nullptr;
+    const char* m_names = nullptr;
+};
+
+}
@@ -0,0 +1,164 @@
+#include "AssetHash.h"
+#include "AssetFormat.h"
+#include "../sim/StateHasher.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace atlas::asset {
+
+namespace {
+
+constexpr uint64_t P1 = 11400714785074694791ULL;
+constexpr uint64_t P2 = 14029467366897019727ULL;
+constexpr uint64_t P3 = 1609587929392839161ULL;
+constexpr uint64_t P4 = 9650029242287828579ULL;
+constexpr uint64_t P5 = 2870177450012600261ULL;
+
+uint64_t Rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+uint64_t Read64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t Read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint64_t Round(uint64_t acc, uint64_t input) {
+    acc += input * P2;
+    acc = Rotl(acc, 31);
+    return acc * P1;
+}
+
+uint64_t MergeRound(uint64_t acc, uint64_t lane) {
+    acc ^= Round(0, lane);
+    return acc * P1 + P4;
+}
+
+}
+
+const char* AssetHashAlgorithmName(AssetHashAlgorithm algorithm) {
+    switch (algorithm) {
+        case AssetHashAlgorithm::Fnv1a: return "fnv1a";
+        case AssetHashAlgorithm::XXH64: return "xxh64";
+    }
+    return "unknown";
+}
+
+// --- AssetHashStream ---
+
+AssetHashStream::AssetHashStream(AssetHashAlgorithm algorithm)
+    : m_algorithm(algorithm) {
+    m_lanes[0] = P1 + P2;
+    m_lanes[1] = P2;
+    m_lanes[2] = 0;
+    m_lanes[3] = 0 - P1;
+}
+
+void AssetHashStream::Consume32(const uint8_t* p) {
+    m_lanes[0] = Round(m_lanes[0], Read64(p));
+    m_lanes[1] = Round(m_lanes[1], Read64(p + 8));
+    m_lanes[2] = Round(m_lanes[2], Read64(p + 16));
+    m_lanes[3] = Round(m_lanes[3], Read64(p + 24));
+}
+
+void AssetHashStream::Update(const uint8_t* data, size_t size) {
+    if (m_algorithm == AssetHashAlgorithm::Fnv1a) {
+        m_fnv = sim::StateHasher::HashCombine(m_fnv, data, size);
+        return;
+    }
+
+    m_total += size;
+    if (m_tailSize > 0) {
+        size_t take = std::min(size, sizeof(m_tail) - m_tailSize);
+        std::memcpy(m_tail + m_tailSize, data, take);
+        m_tailSize += take;
+        data += take;
+        size -= take;
+        if (m_tailSize < sizeof(m_tail)) return;
+        Consume32(m_tail);
+        m_tailSize = 0;
+    }
+    for (; size >= 32; data += 32, size -= 32) Consume32(data);
+    if (size > 0) {
+        std::memcpy(m_tail, data, size);
+        m_tailSize = size;
+    }
+}
+
+uint64_t AssetHashStream::Finish() const {
+    if (m_algorithm == AssetHashAlgorithm::Fnv1a) return m_fnv;
+
+    uint64_t h;
+    if (m_total >= 32) {
+        h = Rotl(m_lanes[0], 1) + Rotl(m_lanes[1], 7) + Rotl(m_lanes[2], 12) + Rotl(m_lanes[3], 18);
+        for (uint64_t lane : m_lanes) h = MergeRound(h, lane);
+    } else {
+        h = P5;
+    }
+    h += m_total;
+
+    const uint8_t* p = m_tail;
+    const uint8_t* end = m_tail + m_tailSize;
+    for (; end - p >= 8; p += 8) {
+        h ^= Round(0, Read64(p));
+        h = Rotl(h, 27) * P1 + P4;
+    }
+    if (end - p >= 4) {
+        h ^= static_cast<uint64_t>(Read32(p)) * P1;
+        h = Rotl(h, 23) * P2 + P3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= *p * P5;
+        h = Rotl(h, 11) * P1;
+    }
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+
+uint64_t HashAssetBytes(const uint8_t* data, size_t size, AssetHashAlgorithm algorithm) {
+    AssetHashStream stream(algorithm);
+    stream.Update(data, size);
+    return stream.Finish();
+}
+
+bool HashAssetFile(const std::string& filePath, AssetHashAlgorithm algorithm,
+                   uint64_t& outHash, uint64_t* outPayloadSize) {
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    AssetHeader hdr;
+    in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr));
+    if (!in.good()) return false;
+
+    AssetHashStream stream(algorithm);
+    std::vector<uint8_t> chunk(std::min<size_t>(hdr.size, ASSET_HASH_CHUNK_SIZE));
+    uint64_t remaining = hdr.size;
+    while (remaining > 0) {
+        size_t n = static_cast<size_t>(std::min<uint64_t>(remaining, chunk.size()));
+        in.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(n));
+        if (!in.good()) return false;
+        stream.Update(chunk.data(), n);
+        remaining -= n;
+    }
+
+    outHash = stream.Finish();
+    if (outPayloadSize) *outPayloadSize = hdr.size;
+    return true;
+}
+
+}  // namespace atlas::asset
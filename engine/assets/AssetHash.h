@@ -0,0 +1,54 @@
+#pragma once
+// ============================================================
+// Atlas Asset Hashing — streaming payload hashes
+// ============================================================
+//
+// Hashes the payload of an .atlasb file (everything after the
+// AssetHeader) in fixed-size chunks, so memory use does not grow
+// with the asset. Fnv1a is the format every existing header and
+// manifest records (StateHasher::HashCombine seeded with 0); XXH64
+// consumes 32 bytes per step and is the choice for new manifests.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace atlas::asset {
+
+enum class AssetHashAlgorithm : uint8_t {
+    Fnv1a = 0,
+    XXH64 = 1
+};
+
+constexpr size_t ASSET_HASH_CHUNK_SIZE = 256 * 1024;
+
+const char* AssetHashAlgorithmName(AssetHashAlgorithm algorithm);
+
+/// Incremental hash; feeding the bytes in any split gives the same value.
+class AssetHashStream {
+public:
+    explicit AssetHashStream(AssetHashAlgorithm algorithm = AssetHashAlgorithm::Fnv1a);
+
+    void Update(const uint8_t* data, size_t size);
+    uint64_t Finish() const;
+
+private:
+    void Consume32(const uint8_t* p);
+
+    AssetHashAlgorithm m_algorithm;
+    uint64_t m_fnv = 0;
+    uint64_t m_lanes[4] = {};
+    uint64_t m_total = 0;
+    uint8_t m_tail[32] = {};
+    size_t m_tailSize = 0;
+};
+
+uint64_t HashAssetBytes(const uint8_t* data, size_t size,
+                        AssetHashAlgorithm algorithm = AssetHashAlgorithm::Fnv1a);
+
+/// Hash the payload of an .atlasb file. Fails when the file cannot be
+/// opened or holds fewer payload bytes than its header declares.
+bool HashAssetFile(const std::string& filePath, AssetHashAlgorithm algorithm,
+                   uint64_t& outHash, uint64_t* outPayloadSize = nullptr);
+
+}  // namespace atlas::asset
@@ -1,11 +1,21 @@
 #include "AssetRegistry.h"
+#include "AssetArchive.h"
+#include "FileWatcher.h"
 #include <deque>
 
 namespace atlas::asset {
 
+AssetRegistry::AssetRegistry() = default;
+AssetRegistry::~AssetRegistry() = default;
+
 void AssetRegistry::Scan(const std::string& root) {
     if (!std::filesystem::exists(root)) return;
 
+    if (std::find(m_roots.begin(), m_roots.end(), root) == m_roots.end()) {
+        m_roots.push_back(root);
+        if (m_watcher) m_watcher->Watch(root);
+    }
+
     for (const auto& p : std::filesystem::recursive_directory_iterator(root)) {
         if (p.path().extension() == ".atlas" || p.path().extension() == ".atlasb") {
             AssetEntry entry;
@@ -15,10 +25,24 @@ void AssetRegistry::Scan(const std::string& root) {
 
             m_assets[entry.id] = entry;
             m_timestamps[entry.path] = std::filesystem::last_write_time(p);
+            m_pathToId[entry.path] = entry.id;
         }
     }
 }
 
+size_t AssetRegistry::ScanArchive(const AssetArchive& archive) {
+    size_t added = 0;
+    for (auto& id : archive.Ids()) {
+        AssetEntry entry;
+        entry.path = archive.Path() + "#" + id;
+        entry.id = std::move(id);
+        entry.version = 1;
+        m_assets[entry.id] = std::move(entry);
+        added++;
+    }
+    return added;
+}
+
 const AssetEntry* AssetRegistry::Get(const std::string& id) const {
     auto it = m_assets.find(id);
     return it != m_assets.end() ? &it->second : nullptr;
@@ -37,17 +61,115 @@ void AssetRegistry::SetReloadCallback(ReloadCallback cb) {
     m_onReload = std::move(cb);
 }
 
-void AssetRegistry::PollHotReload() {
-    for (auto& [id, asset] : m_assets) {
-        if (!std::filesystem::exists(asset.path)) continue;
+void AssetRegistry::SetBatchReloadCallback(BatchReloadCallback cb) {
+    m_onBatchReload = std::move(cb);
+}
+
+bool AssetRegistry::EnableFileWatcher(std::chrono::milliseconds debounce) {
+    if (FileWatcher::AvailableBackend() == FileWatchBackend::None) return false;
+    auto watcher = std::make_unique<FileWatcher>();
+    watcher->SetDebounce(debounce);
+    for (const auto& root : m_roots) {
+        if (!watcher->Watch(root)) return false;
+    }
+    m_watcher = std::move(watcher);
+    return true;
+}
 
-        auto now = std::filesystem::last_write_time(asset.path);
-        if (now != m_timestamps[asset.path]) {
-            m_timestamps[asset.path] = now;
-            asset.version++;
-            if (m_onReload) m_onReload(asset);
+void AssetRegistry::DisableFileWatcher() {
+    m_watcher.reset();
+}
+
+size_t AssetRegistry::PollHotReload() {
+    std::vector<std::string> changed;
+    // A notified path counts as changed even when its timestamp did not
+    // move (writes within one filesystem clock tick).
+    auto touch = [&](const std::string& id, const std::string& path, bool notified) {
+        std::error_code ec;
+        auto now = std::filesystem::last_write_time(path, ec);
+        if (ec) return;
+        auto& stamp = m_timestamps[path];
+        if (notified || now != stamp) {
+            stamp = now;
+            changed.push_back(id);
+        }
+    };
+
+    bool fullScan = true;
+    if (m_watcher) {
+        std::vector<std::string> paths = m_watcher->Poll();
+        // Lost events mean any asset may have changed: stat them all once
+        fullScan = m_watcher->TakeOverflow();
+        if (!fullScan) {
+            for (const auto& path : paths) {
+                auto id = m_pathToId.find(path);
+                if (id == m_pathToId.end()) continue;
+                auto asset = m_assets.find(id->second);
+                if (asset != m_assets.end() && asset->second.path == path) touch(asset->first, path, true);
+            }
         }
     }
+    if (fullScan) {
+        for (const auto& [id, asset] : m_assets) {
+            if (m_timestamps.count(asset.path)) touch(id, asset.path, false);
+        }
+    }
+    return ReloadChanged(changed);
+}
+
+size_t AssetRegistry::ReloadChanged(const std::vector<std::string>& changedIds) {
+    if (changedIds.empty()) return 0;
+
+    // Everything downstream of a changed asset reloads with it
+    std::set<std::string> affected(changedIds.begin(), changedIds.end());
+    std::deque<std::string> queue(changedIds.begin(), changedIds.end());
+    while (!queue.empty()) {
+        std::string current = std::move(queue.front());
+        queue.pop_front();
+        for (auto& dependent : GetDependents(current)) {
+            if (m_assets.count(dependent) && affected.insert(dependent).second) {
+                queue.push_back(std::move(dependent));
+            }
+        }
+    }
+
+    // Dependencies first (Kahn's algorithm restricted to the batch); a
+    // cycle's members follow in id order.
+    std::unordered_map<std::string, int> inDegree;
+    for (const auto& id : affected) inDegree[id] = 0;
+    for (const auto& dep : m_dependencies) {
+        if (affected.count(dep.assetId) && affected.count(dep.dependsOn) && dep.assetId != dep.dependsOn) {
+            inDegree[dep.assetId]++;
+        }
+    }
+    std::set<std::string> ready;
+    for (const auto& [id, deg] : inDegree) {
+        if (deg == 0) ready.insert(id);
+    }
+    std::vector<std::string> order;
+    while (!ready.empty()) {
+        std::string current = *ready.begin();
+        ready.erase(ready.begin());
+        order.push_back(current);
+        for (const auto& dep : m_dependencies) {
+            if (dep.dependsOn != current || dep.assetId == current || !affected.count(dep.assetId)) continue;
+            if (--inDegree[dep.assetId] == 0) ready.insert(dep.assetId);
+        }
+    }
+    for (const auto& id : affected) {
+        if (inDegree[id] > 0) order.push_back(id);
+    }
+
+    std::vector<const AssetEntry*> batch;
+    batch.reserve(order.size());
+    for (const auto& id : order) {
+        AssetEntry& asset = m_assets[id];
+        asset.version++;
+        if (m_onReload) m_onReload(asset);
+        batch.push_back(&asset);
+    }
+    if (m_onBatchReload) m_onBatchReload(batch);
+    return batch.size();
 }
 
 size_t AssetRegistry::Count() const {
@@ -2,14 +2,19 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <chrono>
 #include <filesystem>
 #include <functional>
 #include <algorithm>
+#include <memory>
 #include <set>
 #include <stack>
 
 namespace atlas::asset {
 
+class AssetArchive;
+class FileWatcher;
+
 struct AssetEntry {
     std::string id;
     std::string path;
@@ -24,13 +29,35 @@ struct AssetDependency {
 class AssetRegistry {
 public:
     using ReloadCallback = std::function<void(const AssetEntry&)>;
+    using BatchReloadCallback = std::function<void(const std::vector<const AssetEntry*>&)>;
+
+    AssetRegistry();
+    ~AssetRegistry();
 
     void Scan(const std::string& root);
+    /// Register every entry of an open archive without touching the
+    /// filesystem. Entry paths are "<archive path>#<id>"; packed assets
+    /// do not hot reload.
+    size_t ScanArchive(const AssetArchive& archive);
     const AssetEntry* Get(const std::string& id) const;
     std::vector<AssetEntry> GetAll() const;
 
     void SetReloadCallback(ReloadCallback cb);
-    void PollHotReload();
+    /// Called once per poll with every reloaded asset, in reload order.
+    void SetBatchReloadCallback(BatchReloadCallback cb);
+
+    /// Switch hot reload from per-asset timestamp polling to change
+    /// notifications on every scanned root (and roots scanned later).
+    /// Returns false, leaving polling in place, when the platform has no
+    /// notification backend.
+    bool EnableFileWatcher(std::chrono::milliseconds debounce = std::chrono::milliseconds(50));
+    void DisableFileWatcher();
+    bool IsFileWatcherEnabled() const { return m_watcher != nullptr; }
+
+    /// Reload changed assets, then everything that transitively depends
+    /// on them (dependencies before dependents). With the file watcher
+    /// only the reported paths are stat-ed. Returns the reload count.
+    size_t PollHotReload();
 
     size_t Count() const;
 
@@ -45,8 +72,14 @@ public:
 private:
     std::unordered_map<std::string, AssetEntry> m_assets;
     std::unordered_map<std::string, std::filesystem::file_time_type> m_timestamps;
+    std::unordered_map<std::string, std::string> m_pathToId;
+    std::vector<std::string> m_roots;
     ReloadCallback m_onReload;
+    BatchReloadCallback m_onBatchReload;
+    std::unique_ptr<FileWatcher> m_watcher;
     std::vector<AssetDependency> m_dependencies;
+
+    size_t ReloadChanged(const std::vector<std::string>& changedIds);
 };
 
 }
@@ -1,5 +1,5 @@
 #include "AssetValidator.h"
-#include "../sim/StateHasher.h"
+#include "AssetHash.h"
 #include <filesystem>
 #include <fstream>
 #include <unordered_set>
@@ -11,20 +11,10 @@ namespace atlas::asset {
 // ---------------------------------------------------------------------------
 
 uint64_t AssetValidator::ComputeFileHash(const std::string& filePath) {
-    std::ifstream in(filePath, std::ios::binary);
-    if (!in.is_open()) return 0;
-
-    // Skip the header to hash only the data portion
-    AssetHeader hdr;
-    in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr));
-    if (!in.good()) return 0;
-
-    std::vector<uint8_t> data(hdr.size);
-    in.read(reinterpret_cast<char*>(data.data()),
-            static_cast<std::streamsize>(hdr.size));
-    if (!in.good()) return 0;
-
-    return sim::StateHasher::HashCombine(0, data.data(), data.size());
+    // Hash only the data portion, streamed in fixed-size chunks
+    uint64_t hash = 0;
+    if (!HashAssetFile(filePath, AssetHashAlgorithm::Fnv1a, hash)) return 0;
+    return hash;
 }
 
 // ---------------------------------------------------------------------------
@@ -0,0 +1,144 @@
+#include "FileWatcher.h"
+#include <algorithm>
+#include <filesystem>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace atlas::asset {
+
+#if defined(__linux__)
+namespace {
+constexpr uint32_t kWatchMask = IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_CREATE |
+                                IN_MOVED_TO | IN_ONLYDIR;
+}
+#endif
+
+FileWatcher::~FileWatcher() {
+    Close();
+}
+
+FileWatchBackend FileWatcher::AvailableBackend() {
+#if defined(__linux__)
+    return FileWatchBackend::Inotify;
+#else
+    return FileWatchBackend::None;
+#endif
+}
+
+bool FileWatcher::Watch(const std::string& root) {
+#if defined(__linux__)
+    std::error_code ec;
+    if (!std::filesystem::is_directory(root, ec)) return false;
+    if (m_fd < 0) {
+        m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_fd < 0) return false;
+    }
+    size_t before = m_dirs.size();
+    AddTree(root);
+    return m_dirs.size() > before;
+#else
+    (void)root;
+    return false;
+#endif
+}
+
+void FileWatcher::Close() {
+#if defined(__linux__)
+    if (m_fd >= 0) close(m_fd);
+#endif
+    m_fd = -1;
+    m_dirs.clear();
+    m_pending.clear();
+    m_overflow = false;
+}
+
+void FileWatcher::AddTree(const std::string& root) {
+    AddDirectory(root);
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_directory(ec)) AddDirectory(it->path().string());
+    }
+}
+
+void FileWatcher::AddDirectory(const std::string& dir) {
+#if defined(__linux__)
+    int wd = inotify_add_watch(m_fd, dir.c_str(), kWatchMask);
+    if (wd >= 0) m_dirs[wd] = dir;
+#else
+    (void)dir;
+#endif
+}
+
+void FileWatcher::Drain(Clock::time_point now) {
+#if defined(__linux__)
+    if (m_fd < 0) return;
+    alignas(inotify_event) char buffer[16 * 1024];
+    for (;;) {
+        ssize_t n = read(m_fd, buffer, sizeof(buffer));
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return;   // EAGAIN: queue empty
+        }
+        for (char* p = buffer; p < buffer + n;) {
+            const auto* ev = reinterpret_cast<const inotify_event*>(p);
+            p += sizeof(inotify_event) + ev->len;
+
+            if (ev->mask & IN_Q_OVERFLOW) {
+                m_overflow = true;
+                continue;
+            }
+            if (ev->mask & IN_IGNORED) {
+                m_dirs.erase(ev->wd);
+                continue;
+            }
+            auto dir = m_dirs.find(ev->wd);
+            if (dir == m_dirs.end() || ev->len == 0) continue;
+
+            std::string path = (std::filesystem::path(dir->second) / ev->name).string();
+            if (ev->mask & IN_ISDIR) {
+                // A new directory may already hold files written before its
+                // watch existed; report those too.
+                if (ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    AddTree(path);
+                    std::error_code ec;
+                    for (std::filesystem::recursive_directory_iterator it(path, ec), end;
+                         !ec && it != end; it.increment(ec)) {
+                        if (it->is_regular_file(ec)) m_pending[it->path().string()] = now;
+                    }
+                }
+                continue;
+            }
+            m_pending[path] = now;
+        }
+    }
+#else
+    (void)now;
+#endif
+}
+
+std::vector<std::string> FileWatcher::Poll(Clock::time_point now) {
+    Drain(now);
+    std::vector<std::string> settled;
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (now - it->second >= m_debounce) {
+            settled.push_back(it->first);
+            it = m_pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::sort(settled.begin(), settled.end());
+    return settled;
+}
+
+bool FileWatcher::TakeOverflow() {
+    bool overflow = m_overflow;
+    m_overflow = false;
+    return overflow;
+}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas::asset {
+
+// ============================================================
+// File change notification
+// ============================================================
+//
+// Watches directory trees through the OS change queue (inotify on
+// Linux) instead of stat-ing every file. Poll() drains the queue
+// without blocking; a path is reported once no event has touched it
+// for the debounce window, so an editor writing a file in several
+// chunks (or saving through a temp file and rename) produces a single
+// change. When the backend is unavailable Watch() fails and callers
+// keep polling timestamps themselves.
+
+enum class FileWatchBackend : uint8_t {
+    None,
+    Inotify
+};
+
+class FileWatcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    FileWatcher() = default;
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /// Best backend on this platform; None means Watch() always fails.
+    static FileWatchBackend AvailableBackend();
+
+    /// Watch root and every directory below it (new subdirectories are
+    /// picked up as they appear).
+    bool Watch(const std::string& root);
+    void Close();
+    bool IsWatching() const { return m_fd >= 0; }
+    size_t WatchedDirectoryCount() const { return m_dirs.size(); }
+
+    void SetDebounce(std::chrono::milliseconds debounce) { m_debounce = debounce; }
+    std::chrono::milliseconds Debounce() const { return m_debounce; }
+
+    /// Paths that settled since the last call, sorted and unique.
+    std::vector<std::string> Poll() { return Poll(Clock::now()); }
+    std::vector<std::string> Poll(Clock::time_point now);
+
+    /// Changes still inside their debounce window.
+    size_t PendingCount() const { return m_pending.size(); }
+
+    /// True once the kernel queue overflowed and events were lost; the
+    /// caller should fall back to a full rescan. Reading clears it.
+    bool TakeOverflow();
+
+private:
+    void AddTree(const std::string& root);
+    void AddDirectory(const std::string& dir);
+    void Drain(Clock::time_point now);
+
+    int m_fd = -1;
+    std::unordered_map<int, std::string> m_dirs;   // watch descriptor -> directory
+    std::unordered_map<std::string, Clock::time_point> m_pending;
+    std::chrono::milliseconds m_debounce{50};
+    bool m_overflow = false;
+};
+
+}
@@ -1,15 +1,46 @@
 #include "ServerAssetValidator.h"
+#include "../core/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
 
 namespace atlas::asset {
 
+namespace {
+
+constexpr const char* kHashCacheHeader = "ATLASHASHCACHE 1";
+
+std::vector<std::string> SplitTabs(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t pos = 0;
+    while (true) {
+        size_t tab = line.find('\t', pos);
+        fields.push_back(line.substr(pos, tab == std::string::npos ? std::string::npos : tab - pos));
+        if (tab == std::string::npos) break;
+        pos = tab + 1;
+    }
+    return fields;
+}
+
+std::string NotInManifest(const std::string& assetId) {
+    return "Asset '" + assetId + "' not in server manifest";
+}
+
+}
+
 void ServerAssetValidator::RegisterAsset(const std::string& assetId,
                                           uint64_t expectedHash,
-                                          uint16_t expectedVersion) {
+                                          uint16_t expectedVersion,
+                                          AssetHashAlgorithm algorithm) {
     ManifestEntry entry;
     entry.assetId = assetId;
     entry.expectedHash = expectedHash;
     entry.expectedVersion = expectedVersion;
+    entry.algorithm = algorithm;
     m_manifest[assetId] = entry;
 }
 
@@ -24,27 +55,58 @@ bool ServerAssetValidator::HasAsset(const std::string& assetId) const {
 ServerValidationResult ServerAssetValidator::ValidateAsset(
     const std::string& assetId, const std::string& filePath) {
 
-    ServerValidationResult result;
-    result.assetId = assetId;
-
     auto it = m_manifest.find(assetId);
     if (it == m_manifest.end()) {
+        ServerValidationResult result;
+        result.assetId = assetId;
         result.accepted = false;
-        result.reason = "Asset '" + assetId + "' not in server manifest";
+        result.reason = NotInManifest(assetId);
         return result;
     }
 
-    if (!std::filesystem::exists(filePath)) {
+    Probe probe;
+    ServerValidationResult result = Check(it->second, filePath, probe);
+    Absorb(filePath, probe);
+    return result;
+}
+
+ServerValidationResult ServerAssetValidator::Check(const ManifestEntry& entry,
+                                                   const std::string& filePath,
+                                                   Probe& probe) const {
+    ServerValidationResult result;
+    result.assetId = entry.assetId;
+
+    std::error_code ec;
+    uint64_t size = std::filesystem::file_size(filePath, ec);
+    if (ec) {
         result.accepted = false;
         result.reason = "File not found: " + filePath;
         return result;
     }
+    auto mtime = std::filesystem::last_write_time(filePath, ec);
+    int64_t stamp = ec ? 0 : static_cast<int64_t>(mtime.time_since_epoch().count());
 
-    uint64_t actualHash = AssetValidator::ComputeFileHash(filePath);
-    if (actualHash != it->second.expectedHash) {
+    uint64_t actualHash = 0;
+    auto cached = m_hashCache.find(filePath);
+    if (!ec && cached != m_hashCache.end() && cached->second.size == size &&
+        cached->second.mtime == stamp && cached->second.algorithm == entry.algorithm) {
+        actualHash = cached->second.hash;
+        probe.cacheHit = true;
+    } else if (HashAssetFile(filePath, entry.algorithm, actualHash, &probe.bytes)) {
+        if (!ec) {
+            probe.hashed = true;
+            probe.cached = {size, stamp, entry.algorithm, actualHash};
+        }
+    } else {
+        result.accepted = false;
+        result.reason = "Unreadable asset payload: " + filePath;
+        return result;
+    }
+
+    if (actualHash != entry.expectedHash) {
         result.accepted = false;
-        result.reason = "Hash mismatch for '" + assetId +
-            "': expected " + std::to_string(it->second.expectedHash) +
+        result.reason = "Hash mismatch for '" + entry.assetId +
+            "': expected " + std::to_string(entry.expectedHash) +
             ", got " + std::to_string(actualHash);
         return result;
     }
@@ -53,6 +115,12 @@ ServerValidationResult ServerAssetValidator::ValidateAsset(
     return result;
 }
 
+void ServerAssetValidator::Absorb(const std::string& filePath, const Probe& probe) {
+    if (!probe.hashed || m_cachePath.empty()) return;
+    m_hashCache[filePath] = probe.cached;
+    m_cacheDirty = true;
+}
+
 ServerValidationResult ServerAssetValidator::ValidateHash(
     const std::string& assetId, uint64_t actualHash) {
 
@@ -62,7 +130,7 @@ ServerValidationResult ServerAssetValidator::ValidateHash(
     auto it = m_manifest.find(assetId);
     if (it == m_manifest.end()) {
         result.accepted = false;
-        result.reason = "Asset '" + assetId + "' not in server manifest";
+        result.reason = NotInManifest(assetId);
         return result;
     }
 
@@ -80,16 +148,128 @@ uint32_t ServerAssetValidator::ValidateAll(
     const std::string& directory,
     std::vector<ServerValidationResult>& results) {
 
-    uint32_t failCount = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<const ManifestEntry*> entries;
+    entries.reserve(m_manifest.size());
+    for (const auto& [_, entry] : m_manifest) entries.push_back(&entry);
+    std::sort(entries.begin(), entries.end(),
+              [](const ManifestEntry* a, const ManifestEntry* b) { return a->assetId < b->assetId; });
+
+    std::vector<std::string> paths(entries.size());
+    std::vector<ServerValidationResult> checked(entries.size());
+    std::vector<Probe> probes(entries.size());
+    std::vector<uint8_t> done(entries.size(), 0);
+    std::atomic<bool> stop{false};
+
+    auto validateRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (m_strict && stop.load(std::memory_order_relaxed)) return;
+            paths[i] = directory + "/" + entries[i]->assetId + ".atlasb";
+            checked[i] = Check(*entries[i], paths[i], probes[i]);
+            done[i] = 1;
+            if (!checked[i].accepted) stop.store(true, std::memory_order_relaxed);
+        }
+    };
+    if (m_parallel && entries.size() > 1) {
+        JobSystem::Shared().ParallelFor(entries.size(), validateRange, 4);
+    } else {
+        validateRange(0, entries.size());
+    }
 
-    for (const auto& [assetId, entry] : m_manifest) {
-        std::string filePath = directory + "/" + assetId + ".atlasb";
-        auto result = ValidateAsset(assetId, filePath);
-        if (!result.accepted) ++failCount;
-        results.push_back(std::move(result));
+    ServerValidationStats stats;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (!done[i]) {
+            stats.skipped++;
+            continue;
+        }
+        stats.validated++;
+        if (!checked[i].accepted) stats.failed++;
+        if (probes[i].cacheHit) stats.cacheHits++;
+        stats.bytesHashed += probes[i].bytes;
+        Absorb(paths[i], probes[i]);
+        results.push_back(std::move(checked[i]));
     }
+    if (m_cacheDirty && SaveHashCache()) m_cacheDirty = false;
+
+    stats.wallMs = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    m_lastStats = stats;
+    return stats.failed;
+}
+
+void ServerAssetValidator::SetStrict(bool strict) {
+    m_strict = strict;
+}
+
+bool ServerAssetValidator::Strict() const {
+    return m_strict;
+}
+
+void ServerAssetValidator::SetParallel(bool parallel) {
+    m_parallel = parallel;
+}
+
+bool ServerAssetValidator::Parallel() const {
+    return m_parallel;
+}
+
+void ServerAssetValidator::SetHashCachePath(const std::string& path) {
+    m_cachePath = path;
+    m_hashCache.clear();
+    m_cacheDirty = false;
+    if (path.empty()) return;
+
+    std::ifstream in(path);
+    std::string line;
+    if (!std::getline(in, line) || line != kHashCacheHeader) return;
+    // path \t size \t mtime \t algorithm \t hash
+    while (std::getline(in, line)) {
+        auto fields = SplitTabs(line);
+        if (fields.size() != 5 || fields[0].empty()) continue;
+        CachedHash cached;
+        cached.size = std::strtoull(fields[1].c_str(), nullptr, 10);
+        cached.mtime = std::strtoll(fields[2].c_str(), nullptr, 10);
+        cached.algorithm = static_cast<AssetHashAlgorithm>(std::strtoul(fields[3].c_str(), nullptr, 10));
+        cached.hash = std::strtoull(fields[4].c_str(), nullptr, 16);
+        m_hashCache[fields[0]] = cached;
+    }
+}
+
+const std::string& ServerAssetValidator::HashCachePath() const {
+    return m_cachePath;
+}
+
+bool ServerAssetValidator::SaveHashCache() const {
+    if (m_cachePath.empty()) return false;
+    std::vector<const std::pair<const std::string, CachedHash>*> records;
+    for (const auto& kv : m_hashCache) records.push_back(&kv);
+    std::sort(records.begin(), records.end(),
+              [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    std::string tmp = m_cachePath + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out.is_open()) return false;
+        out << kHashCacheHeader << "\n";
+        for (const auto* r : records) {
+            char hash[17];
+            std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(r->second.hash));
+            out << r->first << '\t' << r->second.size << '\t' << r->second.mtime << '\t'
+                << static_cast<unsigned>(r->second.algorithm) << '\t' << hash << "\n";
+        }
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, m_cachePath, ec);
+    return !ec;
+}
+
+size_t ServerAssetValidator::HashCacheSize() const {
+    return m_hashCache.size();
+}
 
-    return failCount;
+const ServerValidationStats& ServerAssetValidator::LastStats() const {
+    return m_lastStats;
 }
 
 std::vector<ManifestEntry> ServerAssetValidator::Manifest() const {
@@ -8,9 +8,16 @@
 // asset whose hash does not match the expected value recorded
 // in the asset manifest.
 //
+// ValidateAll hashes payloads in streaming chunks across the shared
+// job pool. An optional hash cache, keyed by (path, size, mtime),
+// lets warm restarts skip files that have not changed since the last
+// run. The cache trusts file metadata: leave it off where an attacker
+// could rewrite a file and restore its size and timestamp.
+//
 // See: docs/ATLAS_LOCKDOWN_CHECKLIST.md (Server-safe asset validation)
 
 #include "AssetValidator.h"
+#include "AssetHash.h"
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -22,6 +29,7 @@ struct ManifestEntry {
     std::string assetId;
     uint64_t expectedHash = 0;
     uint16_t expectedVersion = 0;
+    AssetHashAlgorithm algorithm = AssetHashAlgorithm::Fnv1a;
 };
 
 /// Result of server-side asset validation.
@@ -31,12 +39,23 @@ struct ServerValidationResult {
     std::string reason;
 };
 
+/// Counters for the last ValidateAll run.
+struct ServerValidationStats {
+    uint32_t validated = 0;
+    uint32_t failed = 0;
+    uint32_t skipped = 0;         // not checked after a strict-mode failure
+    uint32_t cacheHits = 0;
+    uint64_t bytesHashed = 0;
+    float wallMs = 0.0f;
+};
+
 /// Server-side asset gate that validates assets against a known manifest.
 class ServerAssetValidator {
 public:
     /// Register an expected asset in the manifest.
     void RegisterAsset(const std::string& assetId, uint64_t expectedHash,
-                       uint16_t expectedVersion = 1);
+                       uint16_t expectedVersion = 1,
+                       AssetHashAlgorithm algorithm = AssetHashAlgorithm::Fnv1a);
 
     /// Returns the number of entries in the manifest.
     size_t ManifestSize() const;
@@ -52,16 +71,57 @@ public:
     ServerValidationResult ValidateHash(const std::string& assetId,
                                          uint64_t actualHash);
 
-    /// Validate all registered assets from a directory.
-    /// Returns the number of assets that failed validation.
+    /// Validate all registered assets from a directory, in asset id
+    /// order. Returns the number of assets that failed validation.
     uint32_t ValidateAll(const std::string& directory,
                          std::vector<ServerValidationResult>& results);
 
+    /// Strict mode stops ValidateAll at the first failure; assets not
+    /// yet checked are left out of the results. Off by default.
+    void SetStrict(bool strict);
+    bool Strict() const;
+
+    /// Hash files on the shared job pool (default on).
+    void SetParallel(bool parallel);
+    bool Parallel() const;
+
+    /// Load the hash cache from path (a missing file starts empty);
+    /// ValidateAll writes it back. An empty path disables the cache.
+    void SetHashCachePath(const std::string& path);
+    const std::string& HashCachePath() const;
+    bool SaveHashCache() const;
+    size_t HashCacheSize() const;
+
+    const ServerValidationStats& LastStats() const;
+
     /// Returns the manifest entries.
     std::vector<ManifestEntry> Manifest() const;
 
 private:
+    struct CachedHash {
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        AssetHashAlgorithm algorithm = AssetHashAlgorithm::Fnv1a;
+        uint64_t hash = 0;
+    };
+    struct Probe {
+        bool hashed = false;      // cached holds a fresh hash to store
+        bool cacheHit = false;
+        uint64_t bytes = 0;
+        CachedHash cached;
+    };
+
+    ServerValidationResult Check(const ManifestEntry& entry, const std::string& filePath,
+                                 Probe& probe) const;
+    void Absorb(const std::string& filePath, const Probe& probe);
+
     std::unordered_map<std::string, ManifestEntry> m_manifest;
+    bool m_strict = false;
+    bool m_parallel = true;
+    std::string m_cachePath;
+    std::unordered_map<std::string, CachedHash> m_hashCache;
+    bool m_cacheDirty = false;
+    ServerValidationStats m_lastStats;
 };
 
 }  // namespace atlas::asset
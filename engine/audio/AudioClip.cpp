@@ -0,0 +1,78 @@
+#include "AudioClip.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace atlas::audio {
+
+namespace {
+
+uint32_t ReadU32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+uint16_t ReadU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+} // namespace
+
+std::shared_ptr<AudioClip> LoadWavFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return nullptr;
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < 12 || std::memcmp(data.data(), "RIFF", 4) != 0 ||
+        std::memcmp(data.data() + 8, "WAVE", 4) != 0) {
+        return nullptr;
+    }
+
+    uint16_t format = 0, channels = 0, bits = 0;
+    uint32_t rate = 0;
+    const uint8_t* pcm = nullptr;
+    size_t pcmBytes = 0;
+
+    size_t offset = 12;
+    while (offset + 8 <= data.size()) {
+        const uint8_t* chunk = data.data() + offset;
+        uint32_t size = ReadU32(chunk + 4);
+        size_t body = offset + 8;
+        if (body + size > data.size()) size = static_cast<uint32_t>(data.size() - body);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            format = ReadU16(chunk + 8);
+            channels = ReadU16(chunk + 10);
+            rate = ReadU32(chunk + 12);
+            bits = ReadU16(chunk + 22);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            pcm = chunk + 8;
+            pcmBytes = size;
+        }
+        offset = body + size + (size & 1);
+    }
+
+    bool isPcm = format == 1 && (bits == 8 || bits == 16);
+    bool isFloat = format == 3 && bits == 32;
+    if (!pcm || rate == 0 || (channels != 1 && channels != 2) || (!isPcm && !isFloat)) {
+        return nullptr;
+    }
+
+    auto clip = std::make_shared<AudioClip>();
+    clip->sampleRate = rate;
+    clip->channels = channels;
+    size_t bytesPerSample = bits / 8;
+    size_t count = pcmBytes / bytesPerSample;
+    count -= count % channels;
+    clip->samples.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* s = pcm + i * bytesPerSample;
+        if (isFloat) {
+            std::memcpy(&clip->samples[i], s, sizeof(float));
+        } else if (bits == 16) {
+            clip->samples[i] = static_cast<int16_t>(ReadU16(s)) / 32768.0f;
+        } else {
+            clip->samples[i] = (static_cast<int>(s[0]) - 128) / 128.0f;
+        }
+    }
+    return clip;
+}
+
+}
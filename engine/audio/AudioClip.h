@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace atlas::audio {
+
+// Decoded PCM owned by the AudioEngine and read by the mixer thread.
+// Immutable once handed to the engine.
+struct AudioClip {
+    uint32_t sampleRate = 48000;
+    uint32_t channels = 1;          // 1 (mono) or 2 (interleaved stereo)
+    std::vector<float> samples;     // [-1, 1]
+
+    size_t FrameCount() const { return channels ? samples.size() / channels : 0; }
+    float DurationSeconds() const {
+        return sampleRate ? static_cast<float>(FrameCount()) / sampleRate : 0.0f;
+    }
+};
+
+/// Decode a RIFF/WAVE file with 8/16-bit PCM or 32-bit float samples and
+/// one or two channels. Returns null when the file is missing or unsupported.
+std::shared_ptr<AudioClip> LoadWavFile(const std::string& path);
+
+}
@@ -0,0 +1,97 @@
+#include "AudioDevice.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace atlas::audio {
+
+bool NullAudioDevice::Open(const AudioFormat& format) {
+    m_format = format;
+    m_frames = 0;
+    m_peak[0] = m_peak[1] = 0.0f;
+    m_energy[0] = m_energy[1] = 0.0;
+    return true;
+}
+
+void NullAudioDevice::Write(const float* interleaved, uint32_t frames) {
+    float peak[2] = {0.0f, 0.0f};
+    for (uint32_t f = 0; f < frames; ++f) {
+        for (uint32_t c = 0; c < 2; ++c) {
+            float s = interleaved[f * 2 + c];
+            peak[c] = std::max(peak[c], std::fabs(s));
+            m_energy[c] += static_cast<double>(s) * s;
+        }
+    }
+    m_peak[0] = peak[0];
+    m_peak[1] = peak[1];
+    m_frames += frames;
+}
+
+namespace {
+
+void WriteU32(std::ofstream& f, uint32_t v) {
+    char b[4] = {char(v), char(v >> 8), char(v >> 16), char(v >> 24)};
+    f.write(b, 4);
+}
+
+void WriteU16(std::ofstream& f, uint16_t v) {
+    char b[2] = {char(v), char(v >> 8)};
+    f.write(b, 2);
+}
+
+} // namespace
+
+WavFileAudioDevice::WavFileAudioDevice(std::string path) : m_path(std::move(path)) {}
+
+WavFileAudioDevice::~WavFileAudioDevice() {
+    Close();
+}
+
+bool WavFileAudioDevice::Open(const AudioFormat& format) {
+    Close();
+    m_format = format;
+    m_frames = 0;
+    m_file.open(m_path, std::ios::binary | std::ios::trunc);
+    if (!m_file) return false;
+
+    uint16_t channels = static_cast<uint16_t>(format.channels);
+    m_file.write("RIFF", 4);
+    WriteU32(m_file, 36);               // patched on Close
+    m_file.write("WAVEfmt ", 8);
+    WriteU32(m_file, 16);
+    WriteU16(m_file, 1);                // PCM
+    WriteU16(m_file, channels);
+    WriteU32(m_file, format.sampleRate);
+    WriteU32(m_file, format.sampleRate * channels * 2);
+    WriteU16(m_file, static_cast<uint16_t>(channels * 2));
+    WriteU16(m_file, 16);
+    m_file.write("data", 4);
+    WriteU32(m_file, 0);                // patched on Close
+    return static_cast<bool>(m_file);
+}
+
+void WavFileAudioDevice::Write(const float* interleaved, uint32_t frames) {
+    if (!m_file.is_open()) return;
+    size_t count = static_cast<size_t>(frames) * m_format.channels;
+    std::vector<char> bytes(count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        float s = std::clamp(interleaved[i], -1.0f, 1.0f);
+        int16_t v = static_cast<int16_t>(std::lround(s * 32767.0f));
+        bytes[i * 2] = static_cast<char>(v & 0xFF);
+        bytes[i * 2 + 1] = static_cast<char>((v >> 8) & 0xFF);
+    }
+    m_file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    m_frames += frames;
+}
+
+void WavFileAudioDevice::Close() {
+    if (!m_file.is_open()) return;
+    uint32_t dataBytes = static_cast<uint32_t>(m_frames * m_format.channels * 2);
+    m_file.seekp(4);
+    WriteU32(m_file, 36 + dataBytes);
+    m_file.seekp(40);
+    WriteU32(m_file, dataBytes);
+    m_file.close();
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace atlas::audio {
+
+struct AudioFormat {
+    uint32_t sampleRate = 48000;
+    uint32_t channels = 2;        // the mixer always produces interleaved stereo
+    uint32_t blockFrames = 256;
+};
+
+// Sink for mixed blocks. Hardware backends block in Write() until the
+// device has room; software sinks return immediately and the mixer
+// thread paces itself to real time instead.
+class AudioOutputDevice {
+public:
+    virtual ~AudioOutputDevice() = default;
+
+    virtual bool Open(const AudioFormat& format) = 0;
+    virtual void Write(const float* interleaved, uint32_t frames) = 0;
+    virtual void Close() {}
+    virtual bool BlocksOnWrite() const { return false; }
+};
+
+// Discards audio but keeps enough statistics to assert on in tests.
+class NullAudioDevice : public AudioOutputDevice {
+public:
+    bool Open(const AudioFormat& format) override;
+    void Write(const float* interleaved, uint32_t frames) override;
+
+    uint64_t FramesWritten() const { return m_frames; }
+    /// Peak absolute value per channel over the most recent block.
+    float LastPeak(uint32_t channel) const { return channel < 2 ? m_peak[channel] : 0.0f; }
+    /// Sum of squares per channel over everything written.
+    double Energy(uint32_t channel) const { return channel < 2 ? m_energy[channel] : 0.0; }
+
+private:
+    AudioFormat m_format;
+    uint64_t m_frames = 0;
+    float m_peak[2] = {0.0f, 0.0f};
+    double m_energy[2] = {0.0, 0.0};
+};
+
+// Writes 16-bit PCM WAV; the header sizes are patched on Close().
+class WavFileAudioDevice : public AudioOutputDevice {
+public:
+    explicit WavFileAudioDevice(std::string path);
+    ~WavFileAudioDevice() override;
+
+    bool Open(const AudioFormat& format) override;
+    void Write(const float* interleaved, uint32_t frames) override;
+    void Close() override;
+
+    uint64_t FramesWritten() const { return m_frames; }
+
+private:
+    std::string m_path;
+    std::ofstream m_file;
+    AudioFormat m_format;
+    uint64_t m_frames = 0;
+};
+
+}
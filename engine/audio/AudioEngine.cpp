@@ -1,33 +1,125 @@
 #include "AudioEngine.h"
 #include <algorithm>
+#include <cmath>
+#include <thread>
 
 namespace atlas::audio {
 
+AudioEngine::~AudioEngine() {
+    Shutdown();
+}
+
 void AudioEngine::Init() {
+    Init(AudioEngineConfig{});
+}
+
+bool AudioEngine::Init(const AudioEngineConfig& config, std::unique_ptr<AudioOutputDevice> device) {
+    Shutdown();
+
     m_sounds.clear();
+    m_playback.clear();
     m_nextId = 1;
     m_masterVolume = 1.0f;
+    m_config = config;
+
+    m_device = device ? std::move(device) : std::make_unique<NullAudioDevice>();
+    m_mixer = std::make_unique<AudioMixer>(m_config.mixer);
+    const MixerSettings& settings = m_mixer->Settings();
+
+    AudioFormat format;
+    format.sampleRate = settings.sampleRate;
+    format.blockFrames = settings.blockFrames;
+    if (!m_device->Open(format)) {
+        m_mixer.reset();
+        m_device.reset();
+        return false;
+    }
+
+    m_freeVoices.clear();
+    for (uint32_t v = settings.maxVoices; v-- > 0;) {
+        m_freeVoices.push_back(static_cast<uint16_t>(v));
+    }
+    m_block.assign(static_cast<size_t>(settings.blockFrames) * 2, 0.0f);
+    m_pendingFrames = 0.0;
+    m_commandsPushed = 0;
+    m_listenerPos[0] = m_listenerPos[1] = m_listenerPos[2] = 0.0f;
+    m_listenerRight[0] = 1.0f;
+    m_listenerRight[1] = m_listenerRight[2] = 0.0f;
+
+    if (m_config.mixerThread) m_mixer->Start(m_device.get());
     m_initialized = true;
+    return true;
 }
 
 void AudioEngine::Shutdown() {
     for (auto& [id, source] : m_sounds) {
         source.state = SoundState::Stopped;
     }
+    if (m_mixer) m_mixer->Stop();
+    if (m_device) m_device->Close();
+    m_mixer.reset();
+    m_device.reset();
+    m_retired.clear();
+    m_playback.clear();
+    m_freeVoices.clear();
     m_sounds.clear();
     m_initialized = false;
 }
 
+void AudioEngine::Send(const MixerCommand& command) {
+    if (!m_mixer) return;
+    while (!m_mixer->Push(command)) {
+        // Without a mixer thread this thread is also the consumer
+        if (m_mixer->IsRunning()) std::this_thread::yield();
+        else m_mixer->ApplyCommands();
+    }
+    m_commandsPushed++;
+}
+
+void AudioEngine::SendListener() {
+    MixerCommand cmd;
+    cmd.type = MixerCommandType::SetListener;
+    std::copy(m_listenerPos, m_listenerPos + 3, cmd.values);
+    std::copy(m_listenerRight, m_listenerRight + 3, cmd.values + 3);
+    Send(cmd);
+}
+
+void AudioEngine::ReleaseVoice(Playback& playback) {
+    if (playback.voice < 0) return;
+    MixerCommand cmd;
+    cmd.type = MixerCommandType::Stop;
+    cmd.voice = static_cast<uint16_t>(playback.voice);
+    Send(cmd);
+    m_freeVoices.push_back(static_cast<uint16_t>(playback.voice));
+    playback.voice = -1;
+}
+
+void AudioEngine::RetireClip(std::shared_ptr<const AudioClip> clip) {
+    if (!clip) return;
+    m_retired.emplace_back(m_commandsPushed, std::move(clip));
+}
+
 SoundID AudioEngine::LoadSound(const std::string& name) {
+    return LoadSound(name, LoadWavFile(name));
+}
+
+SoundID AudioEngine::LoadSound(const std::string& name, std::shared_ptr<const AudioClip> clip) {
     SoundID id = m_nextId++;
     SoundSource source;
     source.id = id;
     source.name = name;
     m_sounds[id] = source;
+    m_playback[id].clip = std::move(clip);
     return id;
 }
 
 void AudioEngine::UnloadSound(SoundID id) {
+    auto it = m_playback.find(id);
+    if (it != m_playback.end()) {
+        ReleaseVoice(it->second);
+        RetireClip(std::move(it->second.clip));
+        m_playback.erase(it);
+    }
     m_sounds.erase(id);
 }
 
@@ -41,15 +133,50 @@ size_t AudioEngine::SoundCount() const {
 
 void AudioEngine::Play(SoundID id) {
     auto it = m_sounds.find(id);
-    if (it != m_sounds.end()) {
-        it->second.state = SoundState::Playing;
+    if (it == m_sounds.end()) return;
+    SoundSource& source = it->second;
+    Playback& playback = m_playback[id];
+
+    if (source.state == SoundState::Paused && playback.voice >= 0) {
+        MixerCommand cmd;
+        cmd.type = MixerCommandType::Resume;
+        cmd.voice = static_cast<uint16_t>(playback.voice);
+        Send(cmd);
+    } else if (source.state == SoundState::Stopped && playback.clip && m_mixer &&
+               !m_freeVoices.empty()) {
+        playback.voice = m_freeVoices.back();
+        m_freeVoices.pop_back();
+        playback.generation++;
+
+        MixerCommand cmd;
+        cmd.type = MixerCommandType::Play;
+        cmd.voice = static_cast<uint16_t>(playback.voice);
+        cmd.sound = id;
+        cmd.generation = playback.generation;
+        cmd.clip = playback.clip.get();
+        cmd.values[0] = source.volume;
+        cmd.values[1] = source.pitch;
+        cmd.values[2] = source.posX;
+        cmd.values[3] = source.posY;
+        cmd.values[4] = source.posZ;
+        cmd.looping = source.looping;
+        cmd.spatial = playback.spatial;
+        Send(cmd);
     }
+    source.state = SoundState::Playing;
 }
 
 void AudioEngine::Pause(SoundID id) {
     auto it = m_sounds.find(id);
     if (it != m_sounds.end() && it->second.state == SoundState::Playing) {
         it->second.state = SoundState::Paused;
+        auto pb = m_playback.find(id);
+        if (pb != m_playback.end() && pb->second.voice >= 0) {
+            MixerCommand cmd;
+            cmd.type = MixerCommandType::Pause;
+            cmd.voice = static_cast<uint16_t>(pb->second.voice);
+            Send(cmd);
+        }
     }
 }
 
@@ -57,6 +184,8 @@ void AudioEngine::Stop(SoundID id) {
     auto it = m_sounds.find(id);
     if (it != m_sounds.end()) {
         it->second.state = SoundState::Stopped;
+        auto pb = m_playback.find(id);
+        if (pb != m_playback.end()) ReleaseVoice(pb->second);
     }
 }
 
@@ -72,6 +201,14 @@ void AudioEngine::SetVolume(SoundID id, float volume) {
     auto it = m_sounds.find(id);
     if (it != m_sounds.end()) {
         it->second.volume = std::clamp(volume, 0.0f, 1.0f);
+        auto pb = m_playback.find(id);
+        if (pb != m_playback.end() && pb->second.voice >= 0) {
+            MixerCommand cmd;
+            cmd.type = MixerCommandType::SetVolume;
+            cmd.voice = static_cast<uint16_t>(pb->second.voice);
+            cmd.values[0] = it->second.volume;
+            Send(cmd);
+        }
     }
 }
 
@@ -87,6 +224,14 @@ void AudioEngine::SetPitch(SoundID id, float pitch) {
     auto it = m_sounds.find(id);
     if (it != m_sounds.end()) {
         it->second.pitch = std::max(0.1f, pitch);
+        auto pb = m_playback.find(id);
+        if (pb != m_playback.end() && pb->second.voice >= 0) {
+            MixerCommand cmd;
+            cmd.type = MixerCommandType::SetPitch;
+            cmd.voice = static_cast<uint16_t>(pb->second.voice);
+            cmd.values[0] = it->second.pitch;
+            Send(cmd);
+        }
     }
 }
 
@@ -102,6 +247,14 @@ void AudioEngine::SetLooping(SoundID id, bool looping) {
     auto it = m_sounds.find(id);
     if (it != m_sounds.end()) {
         it->second.looping = looping;
+        auto pb = m_playback.find(id);
+        if (pb != m_playback.end() && pb->second.voice >= 0) {
+            MixerCommand cmd;
+            cmd.type = MixerCommandType::SetLooping;
+            cmd.voice = static_cast<uint16_t>(pb->second.voice);
+            cmd.looping = looping;
+            Send(cmd);
+        }
     }
 }
 
@@ -119,11 +272,47 @@ void AudioEngine::SetPosition(SoundID id, float x, float y, float z) {
         it->second.posX = x;
         it->second.posY = y;
         it->second.posZ = z;
+        Playback& playback = m_playback[id];
+        playback.spatial = true;
+        if (playback.voice >= 0) {
+            MixerCommand cmd;
+            cmd.type = MixerCommandType::SetPosition;
+            cmd.voice = static_cast<uint16_t>(playback.voice);
+            cmd.values[0] = x;
+            cmd.values[1] = y;
+            cmd.values[2] = z;
+            Send(cmd);
+        }
     }
 }
 
+void AudioEngine::SetListenerPosition(float x, float y, float z) {
+    m_listenerPos[0] = x;
+    m_listenerPos[1] = y;
+    m_listenerPos[2] = z;
+    SendListener();
+}
+
+void AudioEngine::SetListenerOrientation(float forwardX, float forwardY, float forwardZ,
+                                         float upX, float upY, float upZ) {
+    // right = forward x up
+    float rx = forwardY * upZ - forwardZ * upY;
+    float ry = forwardZ * upX - forwardX * upZ;
+    float rz = forwardX * upY - forwardY * upX;
+    float len = std::sqrt(rx * rx + ry * ry + rz * rz);
+    if (len <= 0.0f) return;
+    m_listenerRight[0] = rx / len;
+    m_listenerRight[1] = ry / len;
+    m_listenerRight[2] = rz / len;
+    SendListener();
+}
+
 void AudioEngine::SetMasterVolume(float volume) {
     m_masterVolume = std::clamp(volume, 0.0f, 1.0f);
+    MixerCommand cmd;
+    cmd.type = MixerCommandType::SetMasterVolume;
+    cmd.values[0] = m_masterVolume;
+    Send(cmd);
 }
 
 float AudioEngine::GetMasterVolume() const {
@@ -131,9 +320,45 @@ float AudioEngine::GetMasterVolume() const {
 }
 
 void AudioEngine::Update(float dt) {
-    (void)dt;
-    // In a full implementation, this would mix audio buffers,
-    // handle 3D spatialization, and manage playback timing
+    if (!m_mixer) return;
+
+    if (!m_mixer->IsRunning() && dt > 0.0f) {
+        const MixerSettings& settings = m_mixer->Settings();
+        m_pendingFrames += static_cast<double>(dt) * settings.sampleRate;
+        // Tolerate float dt rounding so dt = blockFrames / rate is one block
+        while (m_pendingFrames + 1e-3 >= settings.blockFrames) {
+            m_mixer->RenderBlock(m_block.data());
+            m_device->Write(m_block.data(), settings.blockFrames);
+            m_pendingFrames -= settings.blockFrames;
+        }
+    }
+
+    // Voices that ran off the end of a non-looping clip
+    MixerEvent event;
+    while (m_mixer->PopEvent(event)) {
+        auto pb = m_playback.find(event.sound);
+        if (pb == m_playback.end() || pb->second.generation != event.generation ||
+            pb->second.voice < 0) {
+            continue;
+        }
+        m_freeVoices.push_back(static_cast<uint16_t>(pb->second.voice));
+        pb->second.voice = -1;
+        auto it = m_sounds.find(event.sound);
+        if (it != m_sounds.end()) it->second.state = SoundState::Stopped;
+    }
+
+    uint64_t applied = m_mixer->CommandsApplied();
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+                                   [applied](const auto& r) { return r.first <= applied; }),
+                    m_retired.end());
+}
+
+size_t AudioEngine::ActiveVoiceCount() const {
+    return m_mixer ? m_mixer->Settings().maxVoices - m_freeVoices.size() : 0;
+}
+
+MixerStats AudioEngine::GetMixerStats() const {
+    return m_mixer ? m_mixer->GetStats() : MixerStats{};
 }
 
 }
@@ -1,7 +1,12 @@
 #pragma once
+#include "AudioClip.h"
+#include "AudioDevice.h"
+#include "AudioMixer.h"
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace atlas::audio {
@@ -24,12 +29,35 @@ struct SoundSource {
     float posX = 0.0f, posY = 0.0f, posZ = 0.0f;
 };
 
+struct AudioEngineConfig {
+    MixerSettings mixer;
+    /// true: mix on a dedicated thread paced by the output device.
+    /// false: Update(dt) renders the blocks due for dt (headless runs).
+    bool mixerThread = false;
+};
+
+// Game-thread front end. Source state lives here; everything audible is
+// forwarded to the AudioMixer as commands, and finished voices come
+// back as events drained in Update().
 class AudioEngine {
 public:
+    AudioEngine() = default;
+    ~AudioEngine();
+
+    AudioEngine(const AudioEngine&) = delete;
+    AudioEngine& operator=(const AudioEngine&) = delete;
+
+    /// Default config, pumped mixer into a NullAudioDevice.
     void Init();
+    /// device == nullptr uses a NullAudioDevice. Returns false if the
+    /// device fails to open.
+    bool Init(const AudioEngineConfig& config, std::unique_ptr<AudioOutputDevice> device = nullptr);
     void Shutdown();
 
+    /// Decodes `name` as a WAV file when it exists; otherwise the sound
+    /// has state but no samples and plays silently.
     SoundID LoadSound(const std::string& name);
+    SoundID LoadSound(const std::string& name, std::shared_ptr<const AudioClip> clip);
     void UnloadSound(SoundID id);
     bool HasSound(SoundID id) const;
     size_t SoundCount() const;
@@ -48,18 +76,55 @@ public:
     void SetLooping(SoundID id, bool looping);
     bool IsLooping(SoundID id) const;
 
+    /// Makes the sound positional: attenuated by distance and panned
+    /// relative to the listener.
     void SetPosition(SoundID id, float x, float y, float z);
 
+    void SetListenerPosition(float x, float y, float z);
+    void SetListenerOrientation(float forwardX, float forwardY, float forwardZ,
+                                float upX, float upY, float upZ);
+
     void SetMasterVolume(float volume);
     float GetMasterVolume() const;
 
     void Update(float dt);
 
+    /// Mixer voices currently bound to playing or paused sounds.
+    size_t ActiveVoiceCount() const;
+    MixerStats GetMixerStats() const;
+    AudioOutputDevice* GetDevice() const { return m_device.get(); }
+
 private:
+    struct Playback {
+        std::shared_ptr<const AudioClip> clip;
+        int32_t voice = -1;
+        uint32_t generation = 0;
+        bool spatial = false;
+    };
+
+    void Send(const MixerCommand& command);
+    void SendListener();
+    void ReleaseVoice(Playback& playback);
+    void RetireClip(std::shared_ptr<const AudioClip> clip);
+
     std::unordered_map<SoundID, SoundSource> m_sounds;
+    std::unordered_map<SoundID, Playback> m_playback;
     SoundID m_nextId = 1;
     float m_masterVolume = 1.0f;
     bool m_initialized = false;
+
+    AudioEngineConfig m_config;
+    std::unique_ptr<AudioOutputDevice> m_device;
+    std::unique_ptr<AudioMixer> m_mixer;
+    std::vector<uint16_t> m_freeVoices;
+    std::vector<float> m_block;
+    double m_pendingFrames = 0.0;
+    uint64_t m_commandsPushed = 0;
+    // Clips unloaded while possibly still referenced by the mixer, with
+    // the command count that must be applied before they can be freed
+    std::vector<std::pair<uint64_t, std::shared_ptr<const AudioClip>>> m_retired;
+    float m_listenerPos[3] = {0.0f, 0.0f, 0.0f};
+    float m_listenerRight[3] = {1.0f, 0.0f, 0.0f};
 };
 
 }
@@ -0,0 +1,328 @@
+#include "AudioMixer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ATLAS_AUDIO_SSE2 1
+#endif
+
+namespace atlas::audio {
+
+namespace {
+constexpr uint64_t kFixedOne = uint64_t(1) << 32;
+constexpr float kHalfPi = 1.57079632679f;
+}
+
+void MixMonoToStereo(const float* src, float* out, uint32_t frames,
+                     const float from[2], const float to[2]) {
+    if (frames == 0) return;
+    float dl = (to[0] - from[0]) / frames;
+    float dr = (to[1] - from[1]) / frames;
+    uint32_t i = 0;
+#ifdef ATLAS_AUDIO_SSE2
+    // Two stereo frames per register: (L0, R0, L1, R1)
+    __m128 g0 = _mm_setr_ps(from[0], from[1], from[0] + dl, from[1] + dr);
+    __m128 g1 = _mm_add_ps(g0, _mm_setr_ps(2 * dl, 2 * dr, 2 * dl, 2 * dr));
+    __m128 step = _mm_setr_ps(4 * dl, 4 * dr, 4 * dl, 4 * dr);
+    for (; i + 4 <= frames; i += 4) {
+        __m128 s = _mm_loadu_ps(src + i);
+        __m128 lo = _mm_unpacklo_ps(s, s);   // s0 s0 s1 s1
+        __m128 hi = _mm_unpackhi_ps(s, s);   // s2 s2 s3 s3
+        float* o = out + i * 2;
+        _mm_storeu_ps(o, _mm_add_ps(_mm_loadu_ps(o), _mm_mul_ps(lo, g0)));
+        _mm_storeu_ps(o + 4, _mm_add_ps(_mm_loadu_ps(o + 4), _mm_mul_ps(hi, g1)));
+        g0 = _mm_add_ps(g0, step);
+        g1 = _mm_add_ps(g1, step);
+    }
+#endif
+    for (; i < frames; ++i) {
+        out[i * 2] += src[i] * (from[0] + dl * i);
+        out[i * 2 + 1] += src[i] * (from[1] + dr * i);
+    }
+}
+
+void MixStereoToStereo(const float* src, float* out, uint32_t frames,
+                       const float from[2], const float to[2]) {
+    if (frames == 0) return;
+    float dl = (to[0] - from[0]) / frames;
+    float dr = (to[1] - from[1]) / frames;
+    uint32_t i = 0;
+#ifdef ATLAS_AUDIO_SSE2
+    __m128 g = _mm_setr_ps(from[0], from[1], from[0] + dl, from[1] + dr);
+    __m128 step = _mm_setr_ps(2 * dl, 2 * dr, 2 * dl, 2 * dr);
+    for (; i + 2 <= frames; i += 2) {
+        float* o = out + i * 2;
+        __m128 s = _mm_loadu_ps(src + i * 2);
+        _mm_storeu_ps(o, _mm_add_ps(_mm_loadu_ps(o), _mm_mul_ps(s, g)));
+        g = _mm_add_ps(g, step);
+    }
+#endif
+    for (; i < frames; ++i) {
+        out[i * 2] += src[i * 2] * (from[0] + dl * i);
+        out[i * 2 + 1] += src[i * 2 + 1] * (from[1] + dr * i);
+    }
+}
+
+AudioMixer::AudioMixer(const MixerSettings& settings)
+    : m_settings(settings),
+      m_commands(settings.commandCapacity),
+      m_events(std::max<uint32_t>(settings.maxVoices * 2, 64)) {
+    if (m_settings.blockFrames == 0) m_settings.blockFrames = 256;
+    if (m_settings.sampleRate == 0) m_settings.sampleRate = 48000;
+    m_voices.resize(m_settings.maxVoices);
+    m_scratch.resize(static_cast<size_t>(m_settings.blockFrames) * 2);
+}
+
+AudioMixer::~AudioMixer() {
+    Stop();
+}
+
+bool AudioMixer::Push(const MixerCommand& command) {
+    return m_commands.TryPush(command);
+}
+
+bool AudioMixer::PopEvent(MixerEvent& event) {
+    return m_events.TryPop(event);
+}
+
+void AudioMixer::UpdateStep(Voice& voice) const {
+    double rate = voice.clip ? voice.clip->sampleRate : m_settings.sampleRate;
+    double step = voice.pitch * rate / m_settings.sampleRate;
+    voice.step = static_cast<uint64_t>(std::llround(step * static_cast<double>(kFixedOne)));
+    if (voice.step == 0) voice.step = 1;
+}
+
+void AudioMixer::TargetGains(const Voice& voice, float gain[2]) const {
+    if (!voice.spatial) {
+        gain[0] = gain[1] = voice.volume;
+        return;
+    }
+    float dx = voice.pos[0] - m_listenerPos[0];
+    float dy = voice.pos[1] - m_listenerPos[1];
+    float dz = voice.pos[2] - m_listenerPos[2];
+    float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    float ref = m_settings.referenceDistance;
+    float clamped = std::clamp(dist, ref, std::max(ref, m_settings.maxDistance));
+    float attenuation = ref / (ref + m_settings.rolloff * (clamped - ref));
+
+    // Constant-power pan from the source direction along the listener's right axis
+    float pan = 0.0f;
+    if (dist > 1e-4f) {
+        pan = (dx * m_listenerRight[0] + dy * m_listenerRight[1] + dz * m_listenerRight[2]) / dist;
+        pan = std::clamp(pan, -1.0f, 1.0f);
+    }
+    float angle = (pan + 1.0f) * 0.5f * kHalfPi;
+    float g = voice.volume * attenuation;
+    gain[0] = g * std::cos(angle);
+    gain[1] = g * std::sin(angle);
+}
+
+void AudioMixer::Apply(const MixerCommand& command) {
+    if (command.type == MixerCommandType::SetListener) {
+        std::copy(command.values, command.values + 3, m_listenerPos);
+        std::copy(command.values + 3, command.values + 6, m_listenerRight);
+        return;
+    }
+    if (command.type == MixerCommandType::SetMasterVolume) {
+        m_masterVolume = command.values[0];
+        return;
+    }
+    if (command.voice >= m_voices.size()) return;
+
+    Voice& voice = m_voices[command.voice];
+    switch (command.type) {
+        case MixerCommandType::Play:
+            voice = Voice();
+            voice.clip = command.clip;
+            voice.sound = command.sound;
+            voice.generation = command.generation;
+            voice.volume = command.values[0];
+            voice.pitch = command.values[1];
+            std::copy(command.values + 2, command.values + 5, voice.pos);
+            voice.looping = command.looping;
+            voice.spatial = command.spatial;
+            voice.active = command.clip != nullptr;
+            UpdateStep(voice);
+            // Start at the target gain; ramps only smooth later changes
+            TargetGains(voice, voice.gain);
+            break;
+        case MixerCommandType::Stop:
+            voice.active = false;
+            voice.finishPending = false;
+            break;
+        case MixerCommandType::Pause:
+            voice.paused = true;
+            break;
+        case MixerCommandType::Resume:
+            voice.paused = false;
+            break;
+        case MixerCommandType::SetVolume:
+            voice.volume = command.values[0];
+            break;
+        case MixerCommandType::SetPitch:
+            voice.pitch = command.values[0];
+            UpdateStep(voice);
+            break;
+        case MixerCommandType::SetLooping:
+            voice.looping = command.looping;
+            break;
+        case MixerCommandType::SetPosition:
+            std::copy(command.values, command.values + 3, voice.pos);
+            voice.spatial = true;
+            break;
+        default:
+            break;
+    }
+}
+
+void AudioMixer::ApplyCommands() {
+    MixerCommand command;
+    uint64_t applied = 0;
+    while (m_commands.TryPop(command)) {
+        Apply(command);
+        ++applied;
+    }
+    if (applied) m_commandsApplied.fetch_add(applied, std::memory_order_acq_rel);
+}
+
+uint32_t AudioMixer::Resample(Voice& voice, float* dst, uint32_t frames) const {
+    const AudioClip& clip = *voice.clip;
+    const uint32_t channels = clip.channels;
+    const uint64_t frameCount = clip.FrameCount();
+    const float* src = clip.samples.data();
+    if (frameCount == 0 || (channels != 1 && channels != 2)) {
+        voice.active = false;
+        return 0;
+    }
+    const uint64_t end = frameCount << 32;
+
+    uint32_t n = 0;
+    if (voice.step == kFixedOne && (voice.position & 0xFFFFFFFFu) == 0) {
+        // Unity rate: straight copy, wrapping at loop points
+        while (n < frames) {
+            if (voice.position >= end) {
+                if (!voice.looping) break;
+                voice.position -= end;
+            }
+            uint64_t index = voice.position >> 32;
+            uint64_t run = std::min<uint64_t>(frames - n, frameCount - index);
+            std::memcpy(dst + static_cast<size_t>(n) * channels, src + index * channels,
+                        run * channels * sizeof(float));
+            n += static_cast<uint32_t>(run);
+            voice.position += run << 32;
+        }
+    } else {
+        // Linear interpolation between neighbouring frames
+        while (n < frames) {
+            if (voice.position >= end) {
+                if (!voice.looping) break;
+                voice.position %= end;
+            }
+            uint64_t index = voice.position >> 32;
+            float frac = static_cast<float>(voice.position & 0xFFFFFFFFu) * (1.0f / 4294967296.0f);
+            uint64_t next = index + 1;
+            if (next >= frameCount) next = voice.looping ? 0 : index;
+            for (uint32_t c = 0; c < channels; ++c) {
+                float a = src[index * channels + c];
+                float b = src[next * channels + c];
+                dst[static_cast<size_t>(n) * channels + c] = a + (b - a) * frac;
+            }
+            ++n;
+            voice.position += voice.step;
+        }
+    }
+
+    if (voice.position >= end && !voice.looping) voice.active = false;
+    return n;
+}
+
+void AudioMixer::RenderBlock(float* out) {
+    auto start = std::chrono::steady_clock::now();
+    ApplyCommands();
+
+    const uint32_t frames = m_settings.blockFrames;
+    std::fill(out, out + static_cast<size_t>(frames) * 2, 0.0f);
+
+    uint32_t active = 0;
+    for (Voice& voice : m_voices) {
+        if (voice.finishPending && m_events.TryPush({voice.sound, voice.generation})) {
+            voice.finishPending = false;
+        }
+        if (!voice.active || voice.paused) continue;
+        ++active;
+
+        float target[2];
+        TargetGains(voice, target);
+        uint32_t n = Resample(voice, m_scratch.data(), frames);
+        if (voice.clip->channels == 2) {
+            MixStereoToStereo(m_scratch.data(), out, n, voice.gain, target);
+        } else {
+            MixMonoToStereo(m_scratch.data(), out, n, voice.gain, target);
+        }
+        voice.gain[0] = target[0];
+        voice.gain[1] = target[1];
+
+        if (!voice.active) {
+            voice.finishPending = !m_events.TryPush({voice.sound, voice.generation});
+        }
+    }
+
+    if (m_masterVolume != 1.0f) {
+        for (size_t i = 0; i < static_cast<size_t>(frames) * 2; ++i) out[i] *= m_masterVolume;
+    }
+
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    m_statBlocks.fetch_add(1, std::memory_order_relaxed);
+    m_statVoiceBlocks.fetch_add(active, std::memory_order_relaxed);
+    m_statNanos.fetch_add(static_cast<uint64_t>(nanos), std::memory_order_relaxed);
+    m_statActive.store(active, std::memory_order_relaxed);
+}
+
+bool AudioMixer::Start(AudioOutputDevice* device) {
+    if (!device || m_running.load()) return false;
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread([this, device] { ThreadMain(device); });
+    return true;
+}
+
+void AudioMixer::Stop() {
+    m_running.store(false, std::memory_order_release);
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void AudioMixer::ThreadMain(AudioOutputDevice* device) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<float> block(static_cast<size_t>(m_settings.blockFrames) * 2);
+    const auto blockTime = std::chrono::nanoseconds(
+        static_cast<int64_t>(1e9 * m_settings.blockFrames / m_settings.sampleRate));
+
+    auto deadline = Clock::now();
+    while (m_running.load(std::memory_order_acquire)) {
+        RenderBlock(block.data());
+        device->Write(block.data(), m_settings.blockFrames);
+        if (!device->BlocksOnWrite()) {
+            // Software sinks accept data instantly; keep to real time and
+            // do not try to catch up after a stall.
+            deadline += blockTime;
+            auto now = Clock::now();
+            if (deadline < now) deadline = now;
+            std::this_thread::sleep_until(deadline);
+        }
+    }
+}
+
+MixerStats AudioMixer::GetStats() const {
+    MixerStats stats;
+    stats.blocks = m_statBlocks.load(std::memory_order_relaxed);
+    stats.voiceBlocks = m_statVoiceBlocks.load(std::memory_order_relaxed);
+    stats.mixNanos = m_statNanos.load(std::memory_order_relaxed);
+    stats.activeVoices = m_statActive.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}
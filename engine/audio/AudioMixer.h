@@ -0,0 +1,163 @@
+#pragma once
+#include "AudioClip.h"
+#include "AudioDevice.h"
+#include "../core/SpscQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace atlas::audio {
+
+// ============================================================
+// Software mixer
+// ============================================================
+//
+// The game thread describes what should play through MixerCommands
+// pushed into a lock-free SPSC ring; the mixer side drains the ring
+// at the start of every block and renders fixed-size interleaved
+// stereo blocks. Voices that reach the end of a non-looping clip are
+// reported back through a second SPSC ring.
+//
+// Nothing on the mixing path allocates, locks or touches the
+// AudioEngine's maps, so RenderBlock() can run on a dedicated mixer
+// thread (Start) or be pumped from the game thread on headless runs.
+
+enum class MixerCommandType : uint8_t {
+    Play,
+    Stop,
+    Pause,
+    Resume,
+    SetVolume,
+    SetPitch,
+    SetLooping,
+    SetPosition,
+    SetListener,
+    SetMasterVolume
+};
+
+struct MixerCommand {
+    MixerCommandType type = MixerCommandType::Stop;
+    uint16_t voice = 0;
+    uint32_t sound = 0;
+    uint32_t generation = 0;
+    const AudioClip* clip = nullptr;   // Play only; kept alive by the engine
+    float values[6] = {};              // volume/pitch/position/listener payload
+    bool looping = false;              // Play, SetLooping
+    bool spatial = false;              // Play
+};
+
+struct MixerEvent {
+    uint32_t sound = 0;
+    uint32_t generation = 0;           // echoes the Play that finished
+};
+
+struct MixerSettings {
+    uint32_t sampleRate = 48000;
+    uint32_t blockFrames = 256;
+    uint32_t maxVoices = 256;
+    uint32_t commandCapacity = 4096;
+    // Inverse-distance rolloff, clamped to [referenceDistance, maxDistance]
+    float referenceDistance = 1.0f;
+    float maxDistance = 100.0f;
+    float rolloff = 1.0f;
+};
+
+struct MixerStats {
+    uint64_t blocks = 0;
+    uint64_t voiceBlocks = 0;     // sum of active voices over all blocks
+    uint64_t mixNanos = 0;        // time spent inside RenderBlock
+    uint32_t activeVoices = 0;    // during the last block
+
+    double MicrosPerBlock() const { return blocks ? mixNanos / 1000.0 / blocks : 0.0; }
+    double NanosPerVoiceBlock() const {
+        return voiceBlocks ? static_cast<double>(mixNanos) / voiceBlocks : 0.0;
+    }
+};
+
+class AudioMixer {
+public:
+    explicit AudioMixer(const MixerSettings& settings = {});
+    ~AudioMixer();
+
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    // ---- Producer side (game thread) ----
+    bool Push(const MixerCommand& command);
+    bool PopEvent(MixerEvent& event);
+    /// Commands applied by the mixer so far; a clip retired after command
+    /// N was pushed is unreferenced once this reaches N.
+    uint64_t CommandsApplied() const { return m_commandsApplied.load(std::memory_order_acquire); }
+
+    // ---- Mixer side ----
+    /// Drain the command ring without rendering. Only valid on the
+    /// consumer side, i.e. when no mixer thread is running.
+    void ApplyCommands();
+    /// Apply pending commands and mix one block of blockFrames stereo
+    /// frames into out (2 * blockFrames floats, overwritten).
+    void RenderBlock(float* out);
+
+    /// Run RenderBlock on a dedicated thread, writing into device. The
+    /// device must already be open and outlive Stop().
+    bool Start(AudioOutputDevice* device);
+    void Stop();
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    MixerStats GetStats() const;
+    const MixerSettings& Settings() const { return m_settings; }
+
+private:
+    struct Voice {
+        const AudioClip* clip = nullptr;
+        uint32_t sound = 0;
+        uint32_t generation = 0;
+        uint64_t position = 0;     // 32.32 fixed-point frame position
+        uint64_t step = 0;         // 32.32 frames advanced per output frame
+        float volume = 1.0f;
+        float pitch = 1.0f;
+        float pos[3] = {0.0f, 0.0f, 0.0f};
+        float gain[2] = {0.0f, 0.0f};   // gains reached at the end of the last block
+        bool active = false;
+        bool paused = false;
+        bool looping = false;
+        bool spatial = false;
+        bool finishPending = false;     // finished, event not yet delivered
+    };
+
+    void Apply(const MixerCommand& command);
+    void UpdateStep(Voice& voice) const;
+    void TargetGains(const Voice& voice, float gain[2]) const;
+    uint32_t Resample(Voice& voice, float* dst, uint32_t frames) const;
+    void ThreadMain(AudioOutputDevice* device);
+
+    MixerSettings m_settings;
+    std::vector<Voice> m_voices;
+    std::vector<float> m_scratch;     // resampled voice block (up to stereo)
+    float m_masterVolume = 1.0f;
+    float m_listenerPos[3] = {0.0f, 0.0f, 0.0f};
+    float m_listenerRight[3] = {1.0f, 0.0f, 0.0f};
+
+    SpscQueue<MixerCommand> m_commands;
+    SpscQueue<MixerEvent> m_events;
+    std::atomic<uint64_t> m_commandsApplied{0};
+
+    std::atomic<uint64_t> m_statBlocks{0};
+    std::atomic<uint64_t> m_statVoiceBlocks{0};
+    std::atomic<uint64_t> m_statNanos{0};
+    std::atomic<uint32_t> m_statActive{0};
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+};
+
+/// out[2i] += src[i] * gainL, out[2i+1] += src[i] * gainR, with gains
+/// ramping linearly from `from` to `to` across the block (SSE2 when
+/// available).
+void MixMonoToStereo(const float* src, float* out, uint32_t frames,
+                     const float from[2], const float to[2]);
+/// Same for an interleaved stereo source.
+void MixStereoToStereo(const float* src, float* out, uint32_t frames,
+                       const float from[2], const float to[2]);
+
+}
@@ -0,0 +1,379 @@
+#include "Culling.h"
+#include "../core/JobSystem.h"
+#include "../core/Profiler.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ATLAS_CULL_SSE2 1
+#endif
+
+namespace atlas::camera {
+
+namespace {
+
+constexpr float kFarDepth = std::numeric_limits<float>::max();
+constexpr size_t kBlock = 256;
+
+float Dot(const Vec3& a, const Vec3& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+Vec3 Cross(const Vec3& a, const Vec3& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+CullPlane MakePlane(const Vec3& normal, const Vec3& point) {
+    Vec3 n = normal.Normalized();
+    return {n.x, n.y, n.z, -Dot(n, point)};
+}
+
+}
+
+// --- CullView / Frustum ---
+
+CullView CullView::FromCamera(const Camera& camera, float aspect) {
+    CullView view;
+    view.eye = camera.GetPosition();
+
+    Vec3 forward = camera.GetForward();
+    if (camera.GetMode() == CameraMode::Orbital || camera.GetMode() == CameraMode::Strategy) {
+        Vec3 toTarget = camera.GetTarget() - view.eye;
+        if (toTarget.Length() > 1e-6f) forward = toTarget.Normalized();
+    }
+    view.forward = forward;
+
+    Vec3 right = Cross({0.0f, 1.0f, 0.0f}, forward);
+    view.right = right.Length() > 1e-6f ? right.Normalized() : camera.GetRight();
+    view.up = Cross(forward, view.right).Normalized();
+
+    view.tanHalfY = std::tan(camera.GetFOV() * 3.14159265f / 360.0f);
+    view.tanHalfX = view.tanHalfY * (aspect > 0.0f ? aspect : 1.0f);
+    view.nearPlane = camera.GetNearPlane();
+    view.farPlane = camera.GetFarPlane();
+    return view;
+}
+
+Frustum Frustum::FromView(const CullView& view) {
+    Frustum f;
+    const Vec3& fw = view.forward;
+    f.planes[0] = MakePlane(fw, view.eye + fw * view.nearPlane);
+    f.planes[1] = MakePlane(fw * -1.0f, view.eye + fw * view.farPlane);
+    f.planes[2] = MakePlane(view.right + fw * view.tanHalfX, view.eye);
+    f.planes[3] = MakePlane(view.right * -1.0f + fw * view.tanHalfX, view.eye);
+    f.planes[4] = MakePlane(view.up + fw * view.tanHalfY, view.eye);
+    f.planes[5] = MakePlane(view.up * -1.0f + fw * view.tanHalfY, view.eye);
+    return f;
+}
+
+bool Frustum::TestAABB(const Vec3& min, const Vec3& max) const {
+    // Centre and extent doubled, as in CullingStage::Cull
+    Vec3 c2 = min + max;
+    Vec3 e2 = max - min;
+    for (const auto& p : planes) {
+        float dist = p.nx * c2.x + p.ny * c2.y + p.nz * c2.z +
+                     std::abs(p.nx) * e2.x + std::abs(p.ny) * e2.y + std::abs(p.nz) * e2.z + 2.0f * p.d;
+        if (dist < 0.0f) return false;
+    }
+    return true;
+}
+
+// --- AABBList ---
+
+uint32_t AABBList::Add(const Vec3& min, const Vec3& max) {
+    minX.push_back(min.x); minY.push_back(min.y); minZ.push_back(min.z);
+    maxX.push_back(max.x); maxY.push_back(max.y); maxZ.push_back(max.z);
+    return static_cast<uint32_t>(minX.size() - 1);
+}
+
+void AABBList::Clear() {
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+}
+
+void AABBList::Reserve(size_t count) {
+    minX.reserve(count); minY.reserve(count); minZ.reserve(count);
+    maxX.reserve(count); maxY.reserve(count); maxZ.reserve(count);
+}
+
+// --- OcclusionBuffer ---
+
+OcclusionBuffer::OcclusionBuffer(int width, int height)
+    : m_width(std::max(width, 1))
+    , m_height(std::max(height, 1))
+{
+    int w = m_width, h = m_height;
+    for (;;) {
+        Level level;
+        level.width = w;
+        level.height = h;
+        level.depth.assign(static_cast<size_t>(w) * h, kFarDepth);
+        m_levels.push_back(std::move(level));
+        if (w == 1 && h == 1) break;
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+}
+
+void OcclusionBuffer::Begin(const CullView& view) {
+    m_view = view;
+    for (auto& level : m_levels) std::fill(level.depth.begin(), level.depth.end(), kFarDepth);
+    m_triangles = 0;
+    m_dirty = false;
+}
+
+float OcclusionBuffer::Depth(int x, int y, int level) const {
+    const Level& l = m_levels[level];
+    return l.depth[static_cast<size_t>(y) * l.width + x];
+}
+
+bool OcclusionBuffer::Project(float x, float y, float z, float& sx, float& sy, float& depth) const {
+    Vec3 v = Vec3{x, y, z} - m_view.eye;
+    depth = Dot(v, m_view.forward);
+    if (depth < m_view.nearPlane) return false;
+    sx = (Dot(v, m_view.right) / (depth * m_view.tanHalfX) * 0.5f + 0.5f) * m_width;
+    sy = (0.5f - Dot(v, m_view.up) / (depth * m_view.tanHalfY) * 0.5f) * m_height;
+    return true;
+}
+
+void OcclusionBuffer::AddOccluder(const float* positions, size_t vertexCount,
+                                  const uint32_t* indices, size_t indexCount) {
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount) continue;
+        RasterizeTriangle(positions + indices[i] * 3, positions + indices[i + 1] * 3, positions + indices[i + 2] * 3);
+    }
+}
+
+void OcclusionBuffer::AddOccluderBox(const Vec3& min, const Vec3& max) {
+    const float corners[8 * 3] = {
+        min.x, min.y, min.z,  max.x, min.y, min.z,  min.x, max.y, min.z,  max.x, max.y, min.z,
+        min.x, min.y, max.z,  max.x, min.y, max.z,  min.x, max.y, max.z,  max.x, max.y, max.z,
+    };
+    static const uint32_t kBoxIndices[36] = {
+        0, 1, 3,  0, 3, 2,   4, 6, 7,  4, 7, 5,   0, 2, 6,  0, 6, 4,
+        1, 5, 7,  1, 7, 3,   0, 4, 5,  0, 5, 1,   2, 3, 7,  2, 7, 6,
+    };
+    AddOccluder(corners, 8, kBoxIndices, 36);
+}
+
+void OcclusionBuffer::RasterizeTriangle(const float* a, const float* b, const float* c) {
+    // Triangles crossing the near plane are skipped: leaving out an
+    // occluder only makes culling less aggressive
+    float ax, ay, az, bx, by, bz, cx, cy, cz;
+    if (!Project(a[0], a[1], a[2], ax, ay, az) || !Project(b[0], b[1], b[2], bx, by, bz) ||
+        !Project(c[0], c[1], c[2], cx, cy, cz)) {
+        return;
+    }
+    m_triangles++;
+
+    float area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+    if (std::abs(area) < 1e-6f) return;
+    if (area < 0.0f) {
+        std::swap(bx, cx);
+        std::swap(by, cy);
+    }
+    float depth = std::max(az, std::max(bz, cz));
+
+    // Edge functions E = A*x + B*y + C, non-negative inside; pixels are
+    // sampled at their centres so triangles sharing an edge leave no gap
+    const float ex[3][2] = {{ax, ay}, {bx, by}, {cx, cy}};
+    float A[3], B[3], C[3];
+    for (int e = 0; e < 3; ++e) {
+        const float* p = ex[e];
+        const float* q = ex[(e + 1) % 3];
+        A[e] = p[1] - q[1];
+        B[e] = q[0] - p[0];
+        C[e] = p[0] * q[1] - p[1] * q[0];
+    }
+
+    int x0 = std::max(0, static_cast<int>(std::floor(std::min(ax, std::min(bx, cx)))));
+    int x1 = std::min(m_width - 1, static_cast<int>(std::floor(std::max(ax, std::max(bx, cx)))));
+    int y0 = std::max(0, static_cast<int>(std::floor(std::min(ay, std::min(by, cy)))));
+    int y1 = std::min(m_height - 1, static_cast<int>(std::floor(std::max(ay, std::max(by, cy)))));
+
+    std::vector<float>& buffer = m_levels[0].depth;
+    for (int y = y0; y <= y1; ++y) {
+        float py = static_cast<float>(y) + 0.5f;
+        float* row = buffer.data() + static_cast<size_t>(y) * m_width;
+        for (int x = x0; x <= x1; ++x) {
+            float px = static_cast<float>(x) + 0.5f;
+            if (A[0] * px + B[0] * py + C[0] >= 0.0f && A[1] * px + B[1] * py + C[1] >= 0.0f &&
+                A[2] * px + B[2] * py + C[2] >= 0.0f) {
+                row[x] = std::min(row[x], depth);
+            }
+        }
+    }
+    m_dirty = true;
+}
+
+void OcclusionBuffer::BuildHiZ() {
+    for (size_t l = 1; l < m_levels.size(); ++l) {
+        const Level& src = m_levels[l - 1];
+        Level& dst = m_levels[l];
+        for (int y = 0; y < dst.height; ++y) {
+            int sy0 = y * 2, sy1 = std::min(y * 2 + 1, src.height - 1);
+            for (int x = 0; x < dst.width; ++x) {
+                int sx0 = x * 2, sx1 = std::min(x * 2 + 1, src.width - 1);
+                const float* r0 = src.depth.data() + static_cast<size_t>(sy0) * src.width;
+                const float* r1 = src.depth.data() + static_cast<size_t>(sy1) * src.width;
+                dst.depth[static_cast<size_t>(y) * dst.width + x] =
+                    std::max(std::max(r0[sx0], r0[sx1]), std::max(r1[sx0], r1[sx1]));
+            }
+        }
+    }
+    m_dirty = false;
+}
+
+bool OcclusionBuffer::IsVisible(const Vec3& min, const Vec3& max) const {
+    float minSx = kFarDepth, minSy = kFarDepth, maxSx = -kFarDepth, maxSy = -kFarDepth;
+    float nearest = kFarDepth;
+    for (int i = 0; i < 8; ++i) {
+        float sx, sy, depth;
+        if (!Project(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z, sx, sy, depth)) {
+            return true;   // reaches the near plane
+        }
+        minSx = std::min(minSx, sx); maxSx = std::max(maxSx, sx);
+        minSy = std::min(minSy, sy); maxSy = std::max(maxSy, sy);
+        nearest = std::min(nearest, depth);
+    }
+    // Off screen: that is the frustum test's call
+    if (maxSx < 0.0f || maxSy < 0.0f || minSx >= m_width || minSy >= m_height) return true;
+
+    int x0 = std::max(0, static_cast<int>(std::floor(minSx)));
+    int x1 = std::min(m_width - 1, static_cast<int>(std::floor(maxSx)));
+    int y0 = std::max(0, static_cast<int>(std::floor(minSy)));
+    int y1 = std::min(m_height - 1, static_cast<int>(std::floor(maxSy)));
+
+    // Coarsest level where the rectangle spans at most 2 x 2 texels;
+    // only the full-resolution level is current before BuildHiZ
+    int level = 0;
+    if (!m_dirty) {
+        while (level + 1 < LevelCount() &&
+               ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+            level++;
+        }
+    }
+    const Level& l = m_levels[level];
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            if (l.depth[static_cast<size_t>(y) * l.width + x] >= nearest) return true;
+        }
+    }
+    return false;
+}
+
+// --- CullingStage ---
+
+CullingStage::CullingStage() {
+    SetView(m_view);
+}
+
+void CullingStage::SetView(const Camera& camera, float aspect) {
+    SetView(CullView::FromCamera(camera, aspect));
+}
+
+void CullingStage::SetView(const CullView& view) {
+    m_view = view;
+    m_frustum = Frustum::FromView(view);
+    m_occlusion.Begin(view);
+}
+
+void CullingStage::Cull(const AABBList& bounds, std::vector<uint32_t>& visible, size_t grain) {
+    ATLAS_PROFILE_SCOPE("Culling.Cull");
+    visible.clear();
+    m_stats = {};
+    size_t count = bounds.Size();
+    m_stats.tested = count;
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    bool occlusion = m_occlusionEnabled && m_occlusion.OccluderTriangles() > 0;
+    if (occlusion && !m_occlusion.HiZReady()) m_occlusion.BuildHiZ();
+
+    struct RangeResult {
+        std::vector<uint32_t> visible;
+        size_t frustumCulled = 0;
+        size_t occlusionCulled = 0;
+    };
+    std::vector<RangeResult> ranges((count + grain - 1) / grain);
+
+    auto cullRange = [&](size_t begin, size_t end, RangeResult& out) {
+        uint8_t pass[kBlock];
+        for (size_t block = begin; block < end; block += kBlock) {
+            size_t n = std::min(kBlock, end - block);
+            const float* x0 = bounds.minX.data() + block;
+            const float* y0 = bounds.minY.data() + block;
+            const float* z0 = bounds.minZ.data() + block;
+            const float* x1 = bounds.maxX.data() + block;
+            const float* y1 = bounds.maxY.data() + block;
+            const float* z1 = bounds.maxZ.data() + block;
+
+            size_t simdEnd = 0;
+#ifdef ATLAS_CULL_SSE2
+            // Four boxes per register against all six planes. Same
+            // operation order as the scalar loop, so results match it
+            simdEnd = n & ~size_t(3);
+            const __m128 zero = _mm_setzero_ps();
+            for (size_t i = 0; i < simdEnd; i += 4) {
+                __m128 lx = _mm_loadu_ps(x0 + i), hx = _mm_loadu_ps(x1 + i);
+                __m128 ly = _mm_loadu_ps(y0 + i), hy = _mm_loadu_ps(y1 + i);
+                __m128 lz = _mm_loadu_ps(z0 + i), hz = _mm_loadu_ps(z1 + i);
+                __m128 cx = _mm_add_ps(lx, hx), cy = _mm_add_ps(ly, hy), cz = _mm_add_ps(lz, hz);
+                __m128 ex = _mm_sub_ps(hx, lx), ey = _mm_sub_ps(hy, ly), ez = _mm_sub_ps(hz, lz);
+                int mask = 0xF;
+                for (const auto& p : m_frustum.planes) {
+                    __m128 dist = _mm_mul_ps(_mm_set1_ps(p.nx), cx);
+                    dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(p.ny), cy));
+                    dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(p.nz), cz));
+                    dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(std::abs(p.nx)), ex));
+                    dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(std::abs(p.ny)), ey));
+                    dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(std::abs(p.nz)), ez));
+                    dist = _mm_add_ps(dist, _mm_set1_ps(2.0f * p.d));
+                    mask &= _mm_movemask_ps(_mm_cmpge_ps(dist, zero));
+                }
+                pass[i] = static_cast<uint8_t>(mask & 1);
+                pass[i + 1] = static_cast<uint8_t>((mask >> 1) & 1);
+                pass[i + 2] = static_cast<uint8_t>((mask >> 2) & 1);
+                pass[i + 3] = static_cast<uint8_t>((mask >> 3) & 1);
+            }
+#endif
+            // Scalar fallback and tail: plane-major so the inner loop is
+            // branch-free over floats
+            for (size_t i = simdEnd; i < n; ++i) pass[i] = 1;
+            for (const auto& p : m_frustum.planes) {
+                float ax = std::abs(p.nx), ay = std::abs(p.ny), az = std::abs(p.nz), d2 = 2.0f * p.d;
+                for (size_t i = simdEnd; i < n; ++i) {
+                    float dist = p.nx * (x0[i] + x1[i]) + p.ny * (y0[i] + y1[i]) + p.nz * (z0[i] + z1[i]) +
+                                 ax * (x1[i] - x0[i]) + ay * (y1[i] - y0[i]) + az * (z1[i] - z0[i]) + d2;
+                    pass[i] &= static_cast<uint8_t>(dist >= 0.0f);
+                }
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+                if (!pass[i]) {
+                    out.frustumCulled++;
+                } else if (occlusion && !m_occlusion.IsVisible({x0[i], y0[i], z0[i]}, {x1[i], y1[i], z1[i]})) {
+                    out.occlusionCulled++;
+                } else {
+                    out.visible.push_back(static_cast<uint32_t>(block + i));
+                }
+            }
+        }
+    };
+
+    atlas::JobSystem::Shared().ParallelFor(count, [&](size_t begin, size_t end) {
+        for (size_t start = begin; start < end; start += grain) {
+            cullRange(start, std::min(start + grain, end), ranges[start / grain]);
+        }
+    }, grain);
+
+    for (const auto& range : ranges) {
+        visible.insert(visible.end(), range.visible.begin(), range.visible.end());
+        m_stats.frustumCulled += range.frustumCulled;
+        m_stats.occlusionCulled += range.occlusionCulled;
+    }
+    m_stats.visible = visible.size();
+}
+
+}
@@ -0,0 +1,147 @@
+#pragma once
+// ============================================================
+// Atlas Visibility Culling — frustum and software occlusion
+// ============================================================
+//
+// CPU culling for render lists (loaded world chunks, entities).
+// Bounds live in SoA arrays. The frustum test runs four boxes per
+// SSE2 register against all six planes, with a scalar loop for other
+// targets and for the last few boxes of a block.
+// Ranges of boxes are spread over the shared JobSystem and the
+// survivors of each range are appended in order, giving a compact,
+// ascending index list.
+//
+// Occlusion is optional. Occluder meshes are rasterised at low
+// resolution into a linear view-depth buffer, each triangle at its
+// farthest depth, so the buffer never puts an occluder nearer than it
+// is; triangles crossing the near plane are left out. A max-depth
+// pyramid (hierarchical Z) is built over it and each frustum survivor
+// is tested at the level where its screen rectangle spans at most
+// 2 x 2 texels.
+
+#include "Camera.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace atlas::camera {
+
+// Camera basis and projection, as the culling stage sees it
+struct CullView {
+    Vec3 eye;
+    Vec3 forward = {0, 0, 1};
+    Vec3 right = {1, 0, 0};
+    Vec3 up = {0, 1, 0};
+    float tanHalfX = 1.0f;
+    float tanHalfY = 1.0f;
+    float nearPlane = 0.1f;
+    float farPlane = 1000.0f;
+
+    // Orbital and Strategy cameras look at their target; FreeLook and
+    // FPS look along their yaw/pitch forward vector
+    static CullView FromCamera(const Camera& camera, float aspect);
+};
+
+// Inside when nx*x + ny*y + nz*z + d >= 0
+struct CullPlane {
+    float nx = 0.0f, ny = 0.0f, nz = 0.0f, d = 0.0f;
+};
+
+struct Frustum {
+    CullPlane planes[6];   // near, far, left, right, bottom, top
+
+    static Frustum FromView(const CullView& view);
+    bool TestAABB(const Vec3& min, const Vec3& max) const;
+};
+
+// Axis-aligned boxes in SoA layout
+class AABBList {
+public:
+    uint32_t Add(const Vec3& min, const Vec3& max);
+    void Clear();
+    void Reserve(size_t count);
+    size_t Size() const { return minX.size(); }
+
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+};
+
+class OcclusionBuffer {
+public:
+    explicit OcclusionBuffer(int width = 256, int height = 128);
+
+    // Clear the buffer for a new view
+    void Begin(const CullView& view);
+
+    // Rasterise a world-space triangle mesh (xyz positions)
+    void AddOccluder(const float* positions, size_t vertexCount,
+                     const uint32_t* indices, size_t indexCount);
+    void AddOccluderBox(const Vec3& min, const Vec3& max);
+
+    // Rebuild the depth pyramid after adding occluders; until then
+    // IsVisible reads the full-resolution level only
+    void BuildHiZ();
+
+    // False only when the box is certainly hidden by occluders
+    bool IsVisible(const Vec3& min, const Vec3& max) const;
+
+    int Width() const { return m_width; }
+    int Height() const { return m_height; }
+    int LevelCount() const { return static_cast<int>(m_levels.size()); }
+    float Depth(int x, int y, int level = 0) const;
+    uint64_t OccluderTriangles() const { return m_triangles; }
+    bool HiZReady() const { return !m_dirty; }
+
+private:
+    struct Level {
+        int width = 0, height = 0;
+        std::vector<float> depth;
+    };
+
+    bool Project(float x, float y, float z, float& sx, float& sy, float& depth) const;
+    void RasterizeTriangle(const float* a, const float* b, const float* c);
+
+    int m_width;
+    int m_height;
+    CullView m_view;
+    std::vector<Level> m_levels;   // 0 = full resolution
+    uint64_t m_triangles = 0;
+    bool m_dirty = false;
+};
+
+struct CullStats {
+    size_t tested = 0;
+    size_t frustumCulled = 0;
+    size_t occlusionCulled = 0;
+    size_t visible = 0;
+};
+
+class CullingStage {
+public:
+    CullingStage();
+
+    void SetView(const Camera& camera, float aspect);
+    void SetView(const CullView& view);
+    const CullView& View() const { return m_view; }
+    const Frustum& GetFrustum() const { return m_frustum; }
+
+    // Occluders are added after SetView, which clears them
+    OcclusionBuffer& Occlusion() { return m_occlusion; }
+    void SetOcclusionEnabled(bool enabled) { m_occlusionEnabled = enabled; }
+    bool OcclusionEnabled() const { return m_occlusionEnabled; }
+
+    // Indices of the visible boxes, ascending. Ranges of `grain` boxes
+    // run as parallel jobs.
+    void Cull(const AABBList& bounds, std::vector<uint32_t>& visible, size_t grain = 1024);
+
+    const CullStats& Stats() const { return m_stats; }
+
+private:
+    CullView m_view;
+    Frustum m_frustum;
+    OcclusionBuffer m_occlusion;
+    bool m_occlusionEnabled = true;
+    CullStats m_stats;
+};
+
+}
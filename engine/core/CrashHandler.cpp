@@ -1,4 +1,5 @@
 #include "CrashHandler.h"
+#include "Logger.h"
 #include <fstream>
 #include <sstream>
 
@@ -82,6 +83,9 @@ void CrashHandler::SetCrashCallback(CrashCallback cb) {
 }
 
 void CrashHandler::ReportCrash(const std::string& reason, const std::string& outputPath) {
+    // Lines still queued by the async logger are what led up to the crash
+    Logger::Flush();
+
     CrashReport report = GenerateReport(reason);
 
     if (!outputPath.empty()) {
@@ -14,6 +14,7 @@
 //
 // See: docs/ATLAS_CORE_CONTRACT.md
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -1,5 +1,6 @@
 #include "Engine.h"
 #include "Logger.h"
+#include "Profiler.h"
 #include "../render/VulkanRenderer.h"
 #include "../sim/StateHasher.h"
 #include "../sim/ReplayRecorder.h"
@@ -29,6 +30,13 @@ Engine::~Engine() {
 
 void Engine::InitCore() {
     Logger::Init();
+    if (m_config.asyncLogging) {
+        Logger::EnableAsync();
+    }
+    if (m_config.profiling) {
+        profile::Profiler::SetEnabled(true);
+        profile::Profiler::Get().SetThreadName("Main");
+    }
     Logger::Info("Engine core initialized");
     m_running = true;
     RegisterSystem("Core");
@@ -335,8 +343,12 @@ void Engine::RunEditor() {
     uint64_t tickCount = 0;
     while (m_running) {
         ProcessWindowEvents();
-        m_net.Poll();
+        {
+            ATLAS_PROFILE_SCOPE("Net.Poll");
+            m_net.Poll();
+        }
         m_scheduler.Tick([this](float dt) {
+            ATLAS_PROFILE_SCOPE("Tick");
             m_timeModel.AdvanceTick();
             const auto& timeCtx = m_timeModel.Context();
             m_world.Update(timeCtx.sim.fixedDeltaTime);
@@ -353,6 +365,7 @@ void Engine::RunEditor() {
         });
 
         if (m_renderer && m_window && m_window->IsOpen()) {
+            ATLAS_PROFILE_SCOPE("Render");
             // -------------------------------------------------------
             // PASS 1: Render scene into the viewport framebuffer
             // -------------------------------------------------------
@@ -386,6 +399,9 @@ void Engine::RunEditor() {
         }
 
         tickCount++;
+        if (profile::Profiler::Enabled()) {
+            profile::Profiler::Get().EndFrame(tickCount);
+        }
         if (m_config.maxTicks > 0 && tickCount >= m_config.maxTicks) {
             m_running = false;
         }
@@ -397,8 +413,12 @@ void Engine::RunClient() {
     uint64_t tickCount = 0;
     while (m_running) {
         ProcessWindowEvents();
-        m_net.Poll();
+        {
+            ATLAS_PROFILE_SCOPE("Net.Poll");
+            m_net.Poll();
+        }
         m_scheduler.Tick([this](float dt) {
+            ATLAS_PROFILE_SCOPE("Tick");
             m_timeModel.AdvanceTick();
             const auto& timeCtx = m_timeModel.Context();
             m_world.Update(timeCtx.sim.fixedDeltaTime);
@@ -415,6 +435,7 @@ void Engine::RunClient() {
         });
 
         if (m_renderer && m_window && m_window->IsOpen()) {
+            ATLAS_PROFILE_SCOPE("Render");
             m_renderer->BeginFrame();
             m_uiManager.Render(m_renderer.get());
             ui::UIContext overlayCtx{};
@@ -431,6 +452,9 @@ void Engine::RunClient() {
         }
 
         tickCount++;
+        if (profile::Profiler::Enabled()) {
+            profile::Profiler::Get().EndFrame(tickCount);
+        }
 
         PerformAutosaveIfNeeded(tickCount);
 
@@ -444,8 +468,12 @@ void Engine::RunServer() {
     Logger::Info("Running Atlas Server");
     uint64_t tickCount = 0;
     while (m_running) {
-        m_net.Poll();
+        {
+            ATLAS_PROFILE_SCOPE("Net.Poll");
+            m_net.Poll();
+        }
         m_scheduler.Tick([this](float dt) {
+            ATLAS_PROFILE_SCOPE("Tick");
             m_timeModel.AdvanceTick();
             const auto& timeCtx = m_timeModel.Context();
             m_world.Update(timeCtx.sim.fixedDeltaTime);
@@ -459,6 +487,9 @@ void Engine::RunServer() {
         m_net.Flush();
 
         tickCount++;
+        if (profile::Profiler::Enabled()) {
+            profile::Profiler::Get().EndFrame(tickCount);
+        }
 
         PerformAutosaveIfNeeded(tickCount);
 
@@ -541,14 +572,15 @@ bool Engine::ReplayFromSave(const std::string& savePath, const std::string& repl
     m_scheduler.SetTickRate(m_config.tickRate);
     m_scheduler.SetFramePacing(false);
 
+    // Frames before/at the save point are skipped without decoding
+    // the blocks that hold them
+    if (saveTick >= UINT32_MAX) return false;
     uint64_t appliedFrames = 0;
-    for (const auto& frame : replay.Frames()) {
-        if (frame.tick <= saveTick) continue;  // Skip frames before/at save point
-
+    replay.ForEachFrame(static_cast<uint32_t>(saveTick) + 1, [&](const sim::ReplayFrame&) {
         m_timeModel.AdvanceTick();
         m_world.Update(m_timeModel.Context().sim.fixedDeltaTime);
         ++appliedFrames;
-    }
+    });
 
     return appliedFrames > 0;
 }
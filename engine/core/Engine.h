@@ -51,6 +51,8 @@ struct EngineConfig {
     bool headless = false;
     uint32_t autosaveInterval = 0;            // 0 = disabled, >0 = autosave every N ticks
     std::string autosavePath = "autosave.asav";
+    bool asyncLogging = false;                // log through Logger's background writer
+    bool profiling = false;                   // record ATLAS_PROFILE_SCOPE timings each frame
 };
 
 class Engine {
@@ -0,0 +1,128 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace atlas {
+
+JobSystem::JobSystem(uint32_t workerCount) {
+    if (workerCount == 0) {
+        uint32_t hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 1;
+    }
+    m_workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_workers) {
+        if (t.joinable()) t.join();
+    }
+}
+
+void JobSystem::Submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(job));
+    }
+    m_wake.notify_one();
+}
+
+void JobSystem::WaitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_queue.empty() && m_active == 0; });
+}
+
+void JobSystem::WorkerLoop() {
+    profile::Profiler::Get().SetThreadName("JobWorker");
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) return;  // stopping and drained
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_active++;
+        }
+        {
+            ATLAS_PROFILE_SCOPE("JobSystem.Job");
+            job();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_active--;
+            if (m_queue.empty() && m_active == 0) m_idle.notify_all();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, const RangeFn& fn, size_t grain) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+    size_t rangeCount = (count + grain - 1) / grain;
+    if (rangeCount == 1 || m_workers.empty()) {
+        ATLAS_PROFILE_SCOPE("JobSystem.Range");
+        fn(0, count);
+        return;
+    }
+
+    // Shared state outlives this call: helpers that start after every
+    // range was claimed find nothing to do and exit without touching fn.
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<State>();
+
+    auto drain = [state, &fn, count, grain, rangeCount]() {
+        for (;;) {
+            size_t r = state->next.fetch_add(1, std::memory_order_relaxed);
+            if (r >= rangeCount) return;
+            size_t begin = r * grain;
+            {
+                ATLAS_PROFILE_SCOPE("JobSystem.Range");
+                fn(begin, std::min(count, begin + grain));
+            }
+            if (state->done.fetch_add(1, std::memory_order_acq_rel) + 1 == rangeCount) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min<size_t>(m_workers.size(), rangeCount - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        // Helpers only reach fn through drain() while ranges remain, and
+        // the caller does not return until all ranges are done, so the
+        // captured reference stays valid whenever it is used.
+        Submit([state, drain] { drain(); });
+    }
+    drain();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&] {
+        return state->done.load(std::memory_order_acquire) == rangeCount;
+    });
+}
+
+uint32_t JobSystem::WorkerCount() const {
+    return static_cast<uint32_t>(m_workers.size());
+}
+
+JobSystem& JobSystem::Shared() {
+    static JobSystem s_shared;
+    return s_shared;
+}
+
+}
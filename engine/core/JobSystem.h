@@ -0,0 +1,68 @@
+#pragma once
+// ============================================================
+// Atlas Job System
+// ============================================================
+//
+// Small fixed-size worker pool used by offline and presentation
+// workloads (LOD baking, texture generation, culling, cooking).
+// Simulation code must not schedule work here: tick systems
+// stay single-threaded and ordered for determinism.
+//
+// ParallelFor splits [0, count) into grain-sized ranges that
+// are claimed through an atomic cursor. The calling thread
+// claims ranges too, so nested ParallelFor calls from inside a
+// job always make progress even when every worker is busy.
+//
+// See: docs/ATLAS_SIMULATION_PHILOSOPHY.md
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace atlas {
+
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+    using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+    /// workerCount == 0 picks hardware_concurrency() - 1 (at least 1).
+    explicit JobSystem(uint32_t workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /// Queue a fire-and-forget job.
+    void Submit(Job job);
+
+    /// Block until the queue is empty and no job is running.
+    void WaitIdle();
+
+    /// Run fn over [0, count) in ranges of at most `grain` items and
+    /// return once every range has completed.
+    void ParallelFor(size_t count, const RangeFn& fn, size_t grain = 1);
+
+    uint32_t WorkerCount() const;
+
+    /// Process-wide pool, created on first use.
+    static JobSystem& Shared();
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<Job> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    uint32_t m_active = 0;
+    bool m_stopping = false;
+};
+
+}
@@ -2,8 +2,12 @@
 #include <iostream>
 #include <filesystem>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <ctime>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace atlas {
 
@@ -11,18 +15,217 @@ std::ofstream Logger::s_logFile;
 std::mutex Logger::s_mutex;
 Logger::SinkCallback Logger::s_sink;
 
-static std::string Timestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    std::tm tm{};
+static std::atomic<uint8_t> s_level{static_cast<uint8_t>(LogLevel::Info)};
+
+// Lines carry whole seconds, so each thread formats the timestamp once
+// per second and reuses it for every other line in that second.
+static const char* Timestamp() {
+    thread_local std::time_t cachedSecond = -1;
+    thread_local char cached[32] = {};
+
+    std::time_t time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    if (time != cachedSecond) {
+        std::tm tm{};
 #if defined(_WIN32)
-    localtime_s(&tm, &time);
+        localtime_s(&tm, &time);
 #else
-    localtime_r(&time, &tm);
+        localtime_r(&time, &tm);
 #endif
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+        std::strftime(cached, sizeof(cached), "%Y-%m-%d %H:%M:%S", &tm);
+        cachedSecond = time;
+    }
+    return cached;
+}
+
+static const char* Prefix(LogLevel level) {
+    switch (level) {
+        case LogLevel::Warn: return "[WARN] ";
+        case LogLevel::Error: return "[ERROR] ";
+        default: return "[INFO] ";
+    }
+}
+
+// --- Async backend ---
+//
+// Bounded MPSC ring (Vyukov-style sequence numbers): producers claim a
+// slot with a CAS on the tail and publish it by bumping the slot's
+// sequence; the single writer thread consumes in order. Producers never
+// take a lock; they only signal the writer when it is asleep.
+
+namespace {
+
+struct LogRecord {
+    std::atomic<uint64_t> sequence{0};
+    LogLevel level = LogLevel::Info;
+    std::string line;
+};
+
+struct AsyncLog {
+    std::unique_ptr<LogRecord[]> ring;
+    uint64_t mask = 0;
+    LogAsyncOptions options;
+
+    alignas(64) std::atomic<uint64_t> tail{0};       // next slot to claim
+    alignas(64) uint64_t head = 0;                   // writer only
+    std::atomic<uint64_t> written{0};                // records consumed
+    std::atomic<uint64_t> dropped{0};
+
+    std::atomic<bool> active{false};
+    std::atomic<int> inFlight{0};                    // producers inside Push
+    std::atomic<bool> writerAsleep{false};
+    std::atomic<bool> stop{false};
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::thread writer;
+
+    bool TryPush(LogLevel level, std::string& line) {
+        uint64_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            LogRecord& slot = ring[pos & mask];
+            uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<int64_t>(seq - pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.level = level;
+                    slot.line = std::move(line);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // full
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // True when the record at `head` is published (writer only)
+    bool Ready() const {
+        return ring[head & mask].sequence.load(std::memory_order_acquire) == head + 1;
+    }
+
+    void WakeWriter() {
+        // Pairs with the fence in WriterLoop: either the writer's re-check
+        // sees the record just published or we see it going to sleep
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writerAsleep.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wake.notify_one();
+        }
+    }
+
+    void Push(LogLevel level, std::string line) {
+        while (!TryPush(level, line)) {
+            if (options.overflow == LogOverflow::Drop) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            WakeWriter();
+            std::this_thread::yield();
+        }
+        WakeWriter();
+    }
+
+    // Called once `active` is false: late producers now write
+    // synchronously, so wait out the ones mid-push and drain the rest
+    void Stop() {
+        while (inFlight.load() != 0) std::this_thread::yield();
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stop.store(true, std::memory_order_release);
+            wake.notify_one();
+        }
+        writer.join();
+    }
+
+    ~AsyncLog() {
+        if (active.exchange(false)) Stop();
+    }
+
+    // Pop up to `max` published records, in order
+    size_t Take(std::vector<std::pair<LogLevel, std::string>>& out, size_t max) {
+        size_t taken = 0;
+        while (taken < max) {
+            LogRecord& slot = ring[head & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != head + 1) break;
+            out.emplace_back(slot.level, std::move(slot.line));
+            slot.line.clear();
+            slot.sequence.store(head + mask + 1, std::memory_order_release);
+            head++;
+            taken++;
+        }
+        return taken;
+    }
+};
+
+AsyncLog s_async;
+
+// Set on the writer thread. A sink that logs runs there, and with a full
+// ring under LogOverflow::Block it would wait for room only the writer
+// can make, so its lines are written synchronously instead.
+thread_local bool t_isWriter = false;
+
+}
+
+static void WriterLoop(std::ofstream& file, std::mutex& fileMutex, Logger::SinkCallback& sink) {
+    t_isWriter = true;
+    std::vector<std::pair<LogLevel, std::string>> batch;
+    std::string out, err, all;
+    for (;;) {
+        batch.clear();
+        size_t taken = s_async.Take(batch, 4096);
+
+        if (taken == 0) {
+            if (s_async.stop.load(std::memory_order_acquire) &&
+                s_async.written.load() == s_async.tail.load()) {
+                break;
+            }
+            std::unique_lock<std::mutex> lock(s_async.wakeMutex);
+            s_async.drained.notify_all();
+            // Producers that see writerAsleep notify under wakeMutex, which
+            // we hold until wait releases it; a record published before
+            // they could see the flag is caught by the re-check instead
+            s_async.writerAsleep.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            s_async.wake.wait(lock, [] {
+                return s_async.stop.load(std::memory_order_acquire) || s_async.Ready();
+            });
+            s_async.writerAsleep.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        out.clear(); err.clear(); all.clear();
+        for (const auto& [level, line] : batch) {
+            std::string& console = level == LogLevel::Error ? err : out;
+            console += line;
+            console += '\n';
+            all += line;
+            all += '\n';
+        }
+
+        Logger::SinkCallback sinkCopy;
+        {
+            std::lock_guard<std::mutex> lock(fileMutex);
+            if (s_async.options.console) {
+                if (!out.empty()) std::cout.write(out.data(), static_cast<std::streamsize>(out.size())).flush();
+                if (!err.empty()) std::cerr.write(err.data(), static_cast<std::streamsize>(err.size())).flush();
+            }
+            if (file.is_open()) {
+                file.write(all.data(), static_cast<std::streamsize>(all.size()));
+                file.flush();
+            }
+            sinkCopy = sink;
+        }
+        if (sinkCopy) {
+            for (const auto& [level, line] : batch) sinkCopy(line);
+        }
+
+        s_async.written.fetch_add(taken, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(s_async.wakeMutex);
+        s_async.drained.notify_all();
+    }
 }
 
 void Logger::Init() {
@@ -39,6 +242,7 @@ void Logger::Init() {
 }
 
 void Logger::Shutdown() {
+    DisableAsync();
     std::lock_guard<std::mutex> lock(s_mutex);
     if (s_logFile.is_open()) {
         s_logFile.flush();
@@ -47,18 +251,37 @@ void Logger::Shutdown() {
 }
 
 void Logger::Info(const std::string& msg) {
-    std::string line = "[INFO] " + Timestamp() + " " + msg;
-    Write(line, std::cout);
+    Log(LogLevel::Info, msg);
 }
 
 void Logger::Warn(const std::string& msg) {
-    std::string line = "[WARN] " + Timestamp() + " " + msg;
-    Write(line, std::cout);
+    Log(LogLevel::Warn, msg);
 }
 
 void Logger::Error(const std::string& msg) {
-    std::string line = "[ERROR] " + Timestamp() + " " + msg;
-    Write(line, std::cerr);
+    Log(LogLevel::Error, msg);
+}
+
+void Logger::Log(LogLevel level, const std::string& msg) {
+    if (!LogLevelCompiledIn(level) || !Enabled(level)) return;
+
+    const char* prefix = Prefix(level);
+    const char* timestamp = Timestamp();
+    std::string line;
+    line.reserve(32 + msg.size());
+    line.append(prefix).append(timestamp).append(" ").append(msg);
+
+    // inFlight keeps DisableAsync from draining while a push is underway
+    // (sequentially consistent: the two sides form a store-load pair)
+    s_async.inFlight.fetch_add(1);
+    if (s_async.active.load() && !t_isWriter) {
+        s_async.Push(level, std::move(line));
+        s_async.inFlight.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+    s_async.inFlight.fetch_sub(1, std::memory_order_release);
+
+    Write(line, level == LogLevel::Error ? std::cerr : std::cout);
 }
 
 void Logger::SetSink(SinkCallback sink) {
@@ -66,6 +289,66 @@ void Logger::SetSink(SinkCallback sink) {
     s_sink = std::move(sink);
 }
 
+void Logger::SetLevel(LogLevel level) {
+    s_level.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+LogLevel Logger::GetLevel() {
+    return static_cast<LogLevel>(s_level.load(std::memory_order_relaxed));
+}
+
+bool Logger::Enabled(LogLevel level) {
+    return static_cast<uint8_t>(level) >= s_level.load(std::memory_order_relaxed);
+}
+
+void Logger::EnableAsync(const LogAsyncOptions& options) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (s_async.active.load()) return;
+
+    uint64_t capacity = 2;
+    while (capacity < options.capacity) capacity <<= 1;
+    s_async.ring.reset(new LogRecord[capacity]);
+    for (uint64_t i = 0; i < capacity; ++i) s_async.ring[i].sequence.store(i, std::memory_order_relaxed);
+    s_async.mask = capacity - 1;
+    s_async.options = options;
+    s_async.tail.store(0);
+    s_async.head = 0;
+    s_async.written.store(0);
+    s_async.dropped.store(0);
+    s_async.stop.store(false);
+    s_async.writer = std::thread(WriterLoop, std::ref(s_logFile), std::ref(s_mutex), std::ref(s_sink));
+    s_async.active.store(true, std::memory_order_release);
+}
+
+void Logger::DisableAsync() {
+    if (!s_async.active.exchange(false)) return;
+    s_async.Stop();
+}
+
+bool Logger::IsAsync() {
+    return s_async.active.load(std::memory_order_acquire);
+}
+
+void Logger::Flush() {
+    if (s_async.active.load(std::memory_order_acquire) && s_async.writer.get_id() != std::this_thread::get_id()) {
+        uint64_t target = s_async.tail.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(s_async.wakeMutex);
+        s_async.wake.notify_one();
+        s_async.drained.wait(lock, [target] {
+            return s_async.written.load(std::memory_order_acquire) >= target ||
+                   !s_async.active.load(std::memory_order_acquire);
+        });
+    }
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (s_logFile.is_open()) s_logFile.flush();
+    std::cout.flush();
+    std::cerr.flush();
+}
+
+uint64_t Logger::DroppedCount() {
+    return s_async.dropped.load(std::memory_order_relaxed);
+}
+
 void Logger::Write(const std::string& line, std::ostream& console) {
     SinkCallback sinkCopy;
     {
@@ -4,9 +4,53 @@
 #include <functional>
 #include <mutex>
 #include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+// Levels below this are compiled out of the ATLAS_LOG_* macros
+// (0 = Info, 1 = Warn, 2 = Error).
+#ifndef ATLAS_LOG_MIN_LEVEL
+#define ATLAS_LOG_MIN_LEVEL 0
+#endif
 
 namespace atlas {
 
+enum class LogLevel : uint8_t {
+    Info = 0,
+    Warn = 1,
+    Error = 2
+};
+
+/// False for levels compiled out by ATLAS_LOG_MIN_LEVEL. The comparison
+/// only exists when the minimum is above Info, the lowest level.
+constexpr bool LogLevelCompiledIn(LogLevel level) {
+#if ATLAS_LOG_MIN_LEVEL > 0
+    return static_cast<int>(level) >= ATLAS_LOG_MIN_LEVEL;
+#else
+    (void)level;
+    return true;
+#endif
+}
+
+/// What a producer does when the async ring is full.
+enum class LogOverflow : uint8_t {
+    Block,   // wait for the writer thread to make room
+    Drop     // discard the record and count it
+};
+
+struct LogAsyncOptions {
+    size_t capacity = 8192;               // records, rounded up to a power of two
+    LogOverflow overflow = LogOverflow::Block;
+    bool console = true;                  // also echo to stdout/stderr
+};
+
+/// By default every line is written and flushed on the calling thread
+/// under a global mutex. EnableAsync switches to a low-latency mode:
+/// callers format the line and push it into a lock-free bounded ring,
+/// and a writer thread batches records to the file and console with
+/// one flush per batch. Sinks are then called on the writer thread;
+/// anything a sink logs is written synchronously, bypassing the ring.
+/// Flush, Shutdown and CrashHandler::ReportCrash drain the ring.
 class Logger {
 public:
     /// Callback type for log sinks.  Receives the fully-formatted log line.
@@ -17,10 +61,28 @@ public:
     static void Info(const std::string& msg);
     static void Warn(const std::string& msg);
     static void Error(const std::string& msg);
+    static void Log(LogLevel level, const std::string& msg);
 
     /// Register a callback that receives every log line.
     static void SetSink(SinkCallback sink);
 
+    /// Runtime level filter; lines below it are discarded unformatted.
+    static void SetLevel(LogLevel level);
+    static LogLevel GetLevel();
+    static bool Enabled(LogLevel level);
+
+    /// Start the writer thread. No-op when already async.
+    static void EnableAsync(const LogAsyncOptions& options = {});
+    /// Drain the ring, stop the writer and return to synchronous writes.
+    static void DisableAsync();
+    static bool IsAsync();
+
+    /// Block until every line logged so far has been written and flushed.
+    static void Flush();
+
+    /// Records discarded by LogOverflow::Drop since EnableAsync.
+    static uint64_t DroppedCount();
+
 private:
     static void Write(const std::string& line, std::ostream& console);
 
@@ -30,3 +92,16 @@ private:
 };
 
 }
+
+// Skip formatting the message entirely when the level is filtered out,
+// at compile time (ATLAS_LOG_MIN_LEVEL) or at runtime (SetLevel).
+#define ATLAS_LOG_AT(level, msg)                                                   \
+    do {                                                                           \
+        if constexpr (::atlas::LogLevelCompiledIn(level)) {                        \
+            if (::atlas::Logger::Enabled(level)) ::atlas::Logger::Log(level, msg); \
+        }                                                                          \
+    } while (0)
+
+#define ATLAS_LOG_INFO(msg) ATLAS_LOG_AT(::atlas::LogLevel::Info, msg)
+#define ATLAS_LOG_WARN(msg) ATLAS_LOG_AT(::atlas::LogLevel::Warn, msg)
+#define ATLAS_LOG_ERROR(msg) ATLAS_LOG_AT(::atlas::LogLevel::Error, msg)
@@ -0,0 +1,241 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+namespace atlas::profile {
+
+std::atomic<bool> Profiler::s_enabled{false};
+
+namespace {
+
+#if ATLAS_PROFILE_USE_RDTSC
+// Reference pair for calibrating the TSC against steady_clock
+struct ClockBase {
+    std::chrono::steady_clock::time_point wall = std::chrono::steady_clock::now();
+    uint64_t ticks = Now();
+};
+ClockBase s_clockBase;
+
+double TicksPerMicrosecond() {
+    static const double ratio = [] {
+        using namespace std::chrono;
+        auto wall = steady_clock::now();
+        while (wall - s_clockBase.wall < milliseconds(10)) {
+            std::this_thread::yield();
+            wall = steady_clock::now();
+        }
+        uint64_t ticks = Now();
+        double us = duration<double, std::micro>(wall - s_clockBase.wall).count();
+        return static_cast<double>(ticks - s_clockBase.ticks) / us;
+    }();
+    return ratio;
+}
+#endif
+
+// Releases the thread's ring for reuse when the thread exits
+struct RingRelease {
+    ThreadRing* ring = nullptr;
+    std::mutex* mutex = nullptr;
+    ~RingRelease() {
+        if (!ring) return;
+        std::lock_guard<std::mutex> lock(*mutex);
+        ring->inUse = false;
+        ring->depth = 0;
+    }
+};
+
+void AppendEscaped(std::string& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(*c));
+                    out += buf;
+                } else {
+                    out += *c;
+                }
+        }
+    }
+}
+
+}
+
+double TicksToMicroseconds(uint64_t ticks) {
+#if ATLAS_PROFILE_USE_RDTSC
+    return static_cast<double>(ticks) / TicksPerMicrosecond();
+#else
+    return static_cast<double>(ticks) / 1000.0;
+#endif
+}
+
+double ProfileFrame::DurationMs() const {
+    return end > begin ? TicksToMicroseconds(end - begin) / 1000.0 : 0.0;
+}
+
+Profiler::Profiler() : m_frameBegin(Now()) {}
+
+// Never destroyed: worker threads may release their rings during
+// static destruction
+Profiler& Profiler::Get() {
+    static Profiler* instance = new Profiler();
+    return *instance;
+}
+
+void Profiler::SetEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// Name given before the thread recorded anything; applied when its
+// ring is acquired, so naming a thread costs no ring
+thread_local std::string t_pendingThreadName;
+
+ThreadRing* Profiler::AcquireRing() {
+    thread_local RingRelease release;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ThreadRing* ring = nullptr;
+    for (auto& candidate : m_rings) {
+        if (!candidate->inUse) {
+            ring = candidate.get();
+            break;
+        }
+    }
+    if (!ring) {
+        m_rings.push_back(std::make_unique<ThreadRing>());
+        ring = m_rings.back().get();
+    }
+    // A reused ring gets a new id: events and names of the thread that
+    // owned it before stay apart in exported traces
+    ring->threadId = static_cast<uint32_t>(m_threadNames.size());
+    m_threadNames.push_back(t_pendingThreadName);
+    ring->inUse = true;
+    ring->depth = 0;
+
+    release.ring = ring;
+    release.mutex = &m_mutex;
+    return ring;
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+    t_pendingThreadName = name;
+    if (ThreadRing* ring = ThreadRingSlot()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threadNames[ring->threadId] = name;
+    }
+}
+
+const char* Profiler::Intern(std::string_view name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_names.emplace(name).first->c_str();
+}
+
+void Profiler::Drain(std::vector<ProfileEvent>& out) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& ring : m_rings) {
+        uint64_t t = ring->tail.load(std::memory_order_relaxed);
+        uint64_t h = ring->head.load(std::memory_order_acquire);
+        for (; t < h; ++t) out.push_back(ring->events[t & (ThreadRing::kCapacity - 1)]);
+        ring->tail.store(h, std::memory_order_release);
+    }
+}
+
+const ProfileFrame& Profiler::EndFrame(uint64_t frameNumber) {
+    m_lastFrame.frameNumber = frameNumber;
+    m_lastFrame.begin = m_frameBegin;
+    m_lastFrame.end = Now();
+    m_frameBegin = m_lastFrame.end;
+
+    m_lastFrame.events.clear();
+    Drain(m_lastFrame.events);
+    std::stable_sort(m_lastFrame.events.begin(), m_lastFrame.events.end(),
+                     [](const ProfileEvent& a, const ProfileEvent& b) {
+                         if (a.begin != b.begin) return a.begin < b.begin;
+                         return a.depth < b.depth;
+                     });
+
+    if (m_capturing) {
+        m_captured.insert(m_captured.end(), m_lastFrame.events.begin(), m_lastFrame.events.end());
+    }
+    return m_lastFrame;
+}
+
+void Profiler::StartCapture() {
+    m_captured.clear();
+    m_capturing = true;
+}
+
+void Profiler::StopCapture() {
+    m_capturing = false;
+}
+
+std::string Profiler::ChromeTraceJson(const std::vector<ProfileEvent>& events) const {
+    uint64_t origin = UINT64_MAX;
+    for (const auto& e : events) origin = std::min(origin, e.begin);
+    if (events.empty()) origin = 0;
+
+    std::string out;
+    out.reserve(64 + events.size() * 96);
+    out += "{\"traceEvents\":[";
+    bool first = true;
+    char buf[160];
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (uint32_t id = 0; id < m_threadNames.size(); ++id) {
+            if (m_threadNames[id].empty()) continue;
+            if (!first) out += ',';
+            first = false;
+            std::snprintf(buf, sizeof(buf),
+                          "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                          id);
+            out += buf;
+            AppendEscaped(out, m_threadNames[id].c_str());
+            out += "\"}}";
+        }
+    }
+
+    for (const auto& e : events) {
+        if (!first) out += ',';
+        first = false;
+        out += "\n{\"name\":\"";
+        AppendEscaped(out, e.name ? e.name : "");
+        std::snprintf(buf, sizeof(buf),
+                      "\",\"cat\":\"atlas\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                      TicksToMicroseconds(e.begin - origin),
+                      TicksToMicroseconds(e.end - e.begin),
+                      e.threadId);
+        out += buf;
+    }
+    out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    std::string json = ChromeTraceJson(m_captured);
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+    return static_cast<bool>(file);
+}
+
+uint64_t Profiler::DroppedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t total = 0;
+    for (const auto& ring : m_rings) total += ring->dropped.load(std::memory_order_relaxed);
+    return total;
+}
+
+size_t Profiler::ThreadCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_rings.size();
+}
+
+}  // namespace atlas::profile
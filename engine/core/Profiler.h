@@ -0,0 +1,240 @@
+#pragma once
+// ============================================================
+// Atlas CPU Profiler — hierarchical scope timing
+// ============================================================
+//
+// ATLAS_PROFILE_SCOPE("name") times the enclosing block. Names are
+// static strings and the pointer is the scope's ID, so recording a
+// scope copies no text and allocates nothing. Each thread writes
+// finished scopes into its own fixed ring (single producer, no
+// locks); EndFrame drains every ring into a ProfileFrame, which the
+// editor's profiler panels read and which can be captured and
+// written out as Chrome trace_event JSON (chrome://tracing,
+// Perfetto).
+//
+// Timestamps are raw rdtsc ticks on x86-64 and CLOCK_MONOTONIC
+// nanoseconds elsewhere; TicksToMicroseconds converts either.
+// Build with ATLAS_PROFILE_ENABLED=0 and the scope macros expand to
+// nothing. Recording is off at runtime until SetEnabled(true).
+//
+// Timing never feeds back into simulation state, so scopes may be
+// placed in tick code without affecting determinism.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#ifndef ATLAS_PROFILE_ENABLED
+#define ATLAS_PROFILE_ENABLED 1
+#endif
+
+#if !defined(ATLAS_PROFILE_USE_RDTSC)
+#if defined(__x86_64__) || defined(_M_X64)
+#define ATLAS_PROFILE_USE_RDTSC 1
+#else
+#define ATLAS_PROFILE_USE_RDTSC 0
+#endif
+#endif
+
+#if ATLAS_PROFILE_USE_RDTSC
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#elif defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#else
+#include <chrono>
+#endif
+
+namespace atlas::profile {
+
+/// One finished scope.
+struct ProfileEvent {
+    const char* name = nullptr;   ///< Static string; the pointer is the ID
+    uint64_t begin = 0;           ///< Ticks, see TicksToMicroseconds
+    uint64_t end = 0;
+    uint32_t threadId = 0;        ///< Profiler thread index, unique per thread, in order of first use
+    uint16_t depth = 0;           ///< Nesting depth on its thread, 0 = outermost
+};
+
+/// Everything recorded between two EndFrame calls, sorted by begin.
+struct ProfileFrame {
+    uint64_t frameNumber = 0;
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    std::vector<ProfileEvent> events;
+
+    double DurationMs() const;
+};
+
+inline uint64_t Now() {
+#if ATLAS_PROFILE_USE_RDTSC
+    return __rdtsc();
+#elif defined(__unix__) || defined(__APPLE__)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/// Convert a tick interval to microseconds. With rdtsc the first call
+/// calibrates against steady_clock (up to 10 ms, once per process).
+double TicksToMicroseconds(uint64_t ticks);
+
+/// Per-thread event ring. Only the owning thread pushes; EndFrame
+/// drains under the profiler's registry lock.
+struct ThreadRing {
+    static constexpr size_t kCapacity = 1u << 14;
+
+    std::unique_ptr<ProfileEvent[]> events{new ProfileEvent[kCapacity]};
+    alignas(64) std::atomic<uint64_t> head{0};   // events pushed (owner)
+    alignas(64) std::atomic<uint64_t> tail{0};   // events drained (reader)
+    std::atomic<uint64_t> dropped{0};
+    uint32_t threadId = 0;                        // of the current owner
+    uint16_t depth = 0;                           // owner only
+    bool inUse = true;                            // guarded by the registry lock
+
+    void Push(const char* name, uint64_t begin, uint64_t end, uint16_t eventDepth) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= kCapacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ProfileEvent& e = events[h & (kCapacity - 1)];
+        e.name = name;
+        e.begin = begin;
+        e.end = end;
+        e.threadId = threadId;
+        e.depth = eventDepth;
+        head.store(h + 1, std::memory_order_release);
+    }
+};
+
+class Profiler {
+public:
+    static Profiler& Get();
+
+    /// Runtime switch. Scopes opened while disabled record nothing.
+    static void SetEnabled(bool enabled);
+    static bool Enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /// The calling thread's ring, registered on first use.
+    static ThreadRing* CurrentThreadRing() {
+        ThreadRing*& ring = ThreadRingSlot();
+        if (!ring) ring = Get().AcquireRing();
+        return ring;
+    }
+
+    /// Label the calling thread in exported traces.
+    void SetThreadName(const std::string& name);
+
+    /// Stable storage for a runtime name (e.g. a system name), so it
+    /// can be used as a scope ID. Takes a lock; cache the result.
+    const char* Intern(std::string_view name);
+
+    /// Open a scope that does not follow a lexical block (begin/end
+    /// callbacks) and return its depth. Close it with LeaveScope on
+    /// the same thread, nested properly with any other scopes.
+    static uint16_t EnterScope() { return CurrentThreadRing()->depth++; }
+    static void LeaveScope(const char* name, uint64_t begin, uint16_t depth) {
+        ThreadRing* ring = CurrentThreadRing();
+        uint64_t end = Now();
+        ring->depth--;
+        ring->Push(name, begin, end, depth);
+    }
+
+    /// Drain every thread's ring into a new frame and return it. Call
+    /// from one thread (the main loop); the result stays valid until
+    /// the next EndFrame.
+    const ProfileFrame& EndFrame(uint64_t frameNumber);
+    const ProfileFrame& LastFrame() const { return m_lastFrame; }
+
+    /// While capturing, every drained event is also kept for export.
+    void StartCapture();
+    void StopCapture();
+    bool Capturing() const { return m_capturing; }
+    const std::vector<ProfileEvent>& Captured() const { return m_captured; }
+
+    /// Chrome trace_event JSON ("X" complete events plus thread names).
+    std::string ChromeTraceJson(const std::vector<ProfileEvent>& events) const;
+    bool WriteChromeTrace(const std::string& path) const;
+
+    /// Events lost to full rings since startup.
+    uint64_t DroppedCount() const;
+    size_t ThreadCount() const;
+
+private:
+    Profiler();
+
+    static ThreadRing*& ThreadRingSlot() {
+        static thread_local ThreadRing* ring = nullptr;
+        return ring;
+    }
+
+    ThreadRing* AcquireRing();
+    void Drain(std::vector<ProfileEvent>& out);
+
+    static std::atomic<bool> s_enabled;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadRing>> m_rings;
+    std::vector<std::string> m_threadNames;   // by threadId; outlive the thread's ring
+    std::unordered_set<std::string> m_names;
+    ProfileFrame m_lastFrame;
+    uint64_t m_frameBegin = 0;
+    std::vector<ProfileEvent> m_captured;
+    bool m_capturing = false;
+};
+
+/// Times its lifetime. `name` must outlive the profiler: a string
+/// literal or a pointer returned by Profiler::Intern.
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : m_name(name) {
+        if (Profiler::Enabled()) {
+            m_ring = Profiler::CurrentThreadRing();
+            m_depth = m_ring->depth++;
+            m_begin = Now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (m_ring) {
+            uint64_t end = Now();
+            m_ring->depth--;
+            m_ring->Push(m_name, m_begin, end, m_depth);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    ThreadRing* m_ring = nullptr;
+    uint64_t m_begin = 0;
+    uint16_t m_depth = 0;
+};
+
+}  // namespace atlas::profile
+
+#define ATLAS_PROFILE_CONCAT_INNER(a, b) a##b
+#define ATLAS_PROFILE_CONCAT(a, b) ATLAS_PROFILE_CONCAT_INNER(a, b)
+
+#if ATLAS_PROFILE_ENABLED
+#define ATLAS_PROFILE_SCOPE(name) \
+    ::atlas::profile::ProfileScope ATLAS_PROFILE_CONCAT(atlasProfileScope_, __LINE__)(name)
+#else
+#define ATLAS_PROFILE_SCOPE(name) do {} while (0)
+#endif
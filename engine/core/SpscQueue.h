@@ -0,0 +1,75 @@
+#pragma once
+// ============================================================
+// Atlas SPSC Queue
+// ============================================================
+//
+// Bounded lock-free ring for exactly one producer thread and one
+// consumer thread. Neither side allocates or blocks after
+// construction, so it is safe to use from real-time threads
+// (audio mixer, background writers).
+//
+// Capacity is rounded up to a power of two. Head and tail live
+// on separate cache lines and each side caches the other's index
+// to avoid touching the shared line on every call.
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace atlas {
+
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        m_slots.resize(cap);
+        m_mask = cap - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Producer side. Returns false when the ring is full.
+    bool TryPush(const T& item) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask) return false;
+        }
+        m_slots[tail & m_mask] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side. Returns false when the ring is empty.
+    bool TryPop(T& out) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) return false;
+        }
+        out = m_slots[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Approximate when called while the other side is active.
+    size_t Size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+    bool Empty() const { return Size() == 0; }
+    size_t Capacity() const { return m_mask + 1; }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+
+    alignas(64) std::atomic<size_t> m_head{0};   // next slot to pop
+    size_t m_cachedTail = 0;                     // consumer's view of m_tail
+    alignas(64) std::atomic<size_t> m_tail{0};   // next slot to push
+    size_t m_cachedHead = 0;                     // producer's view of m_head
+};
+
+}
@@ -99,7 +99,96 @@ public:
         return out.str();
     }
 
-private:
+    /// Generate a self-contained translation unit for the native backend.
+    /// It exports the C entry points FlowGraphNativeBuilder compiles and
+    /// LoadNativeFlowGraph binds (see FlowGraphNative.h): every
+    /// node writes its single output into a float slot, in topological
+    /// order, with the same semantics as the interpreter's nodes. Returns
+    /// an empty string when the graph uses a node type with no native form.
+    static std::string GenerateNative(const FlowGraphIR& ir, uint64_t irHash, uint32_t abiVersion) {
+        std::vector<uint32_t> sorted = TopologicalSort(ir);
+        std::unordered_map<uint32_t, const FlowNodeIR*> nodeMap;
+        for (const auto& n : ir.nodes) {
+            nodeMap[n.id] = &n;
+        }
+        std::unordered_map<uint32_t, uint32_t> slotOf;
+        for (uint32_t nodeId : sorted) {
+            auto it = nodeMap.find(nodeId);
+            if (it == nodeMap.end()) continue;
+            const std::string& type = it->second->type;
+            if (type != "State" && type != "Condition" && type != "Timer" && type != "Transition") {
+                return "";
+            }
+            uint32_t slot = static_cast<uint32_t>(slotOf.size());
+            slotOf[nodeId] = slot;
+        }
+
+        std::ostringstream out;
+        // This file is compiled and loaded, so nothing from the IR is
+        // copied into it verbatim
+        out << "// Generated by AtlasForge FlowGraphCodegen (native)\n";
+        out << "// Graph: " << SanitizeName(ir.name) << " (" << SanitizeName(ir.graphType) << ")\n";
+        out << "#include <cstdint>\n\n";
+        out << "#if defined(_WIN32)\n";
+        out << "#define ATLAS_FLOW_EXPORT extern \"C\" __declspec(dllexport)\n";
+        out << "#else\n";
+        out << "#define ATLAS_FLOW_EXPORT extern \"C\" __attribute__((visibility(\"default\")))\n";
+        out << "#endif\n\n";
+        out << "struct FlowNativeContext {\n";
+        out << "    float elapsedTime;\n";
+        out << "    uint32_t inputReceived;\n";
+        out << "    uint32_t tick;\n";
+        out << "};\n\n";
+
+        out << "static const uint32_t kSlotNodes[] = {";
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            if (!slotOf.count(sorted[i])) continue;
+            out << (slotOf[sorted[i]] ? ", " : "") << sorted[i];
+        }
+        out << (slotOf.empty() ? "0};\n\n" : "};\n\n");
+
+        out << "ATLAS_FLOW_EXPORT uint32_t AtlasFlowAbiVersion() { return " << abiVersion << "u; }\n";
+        out << "ATLAS_FLOW_EXPORT uint64_t AtlasFlowIRHash() { return " << irHash << "ULL; }\n";
+        out << "ATLAS_FLOW_EXPORT uint32_t AtlasFlowSlotCount() { return " << slotOf.size() << "u; }\n";
+        out << "ATLAS_FLOW_EXPORT const uint32_t* AtlasFlowSlotNodes() { return kSlotNodes; }\n\n";
+
+        out << "ATLAS_FLOW_EXPORT void AtlasFlowExecute(const FlowNativeContext* ctx, float* slots) {\n";
+        out << "    (void)ctx;\n";
+        for (uint32_t nodeId : sorted) {
+            auto it = slotOf.find(nodeId);
+            if (it == slotOf.end()) continue;
+            const FlowNodeIR& node = *nodeMap[nodeId];
+
+            // Last edge into a port wins, as in GameFlowGraph::Execute
+            std::string in[2];
+            for (const auto& e : ir.edges) {
+                if (e.toNode != nodeId || e.toPort > 1 || e.fromPort != 0) continue;
+                auto src = slotOf.find(e.fromNode);
+                if (src == slotOf.end()) continue;
+                in[e.toPort] = "slots[" + std::to_string(src->second) + "]";
+            }
+            std::string dst = "slots[" + std::to_string(it->second) + "]";
+
+            out << "    // Node " << node.id << ": " << node.type << "\n";
+            if (node.type == "State") {
+                out << "    " << dst << " = " << (in[0].empty() ? "1.0f" : in[0]) << ";\n";
+            } else if (node.type == "Condition") {
+                out << "    " << dst << " = (" << (in[0].empty() ? "0.0f" : in[0]) << " >= "
+                    << (in[1].empty() ? "0.5f" : in[1]) << ") ? 1.0f : 0.0f;\n";
+            } else if (node.type == "Timer") {
+                out << "    " << dst << " = (" << (in[0].empty() ? "false" : in[0] + " > 0.5f")
+                    << " && ctx->elapsedTime >= " << (in[1].empty() ? "1.0f" : in[1])
+                    << ") ? 1.0f : 0.0f;\n";
+            } else {
+                out << "    " << dst << " = (" << (in[0].empty() ? "false" : in[0] + " > 0.5f")
+                    << " && " << (in[1].empty() ? "false" : in[1] + " > 0.5f")
+                    << ") ? 1.0f : 0.0f;\n";
+            }
+        }
+        out << "}\n";
+        return out.str();
+    }
+
     // --- Sanitize a name to a valid C++ identifier ---
     static std::string SanitizeName(const std::string& name) {
         std::string result;
@@ -114,6 +203,7 @@ private:
         return result;
     }
 
+private:
     // --- Look up a property by key ---
     static std::string GetProperty(const FlowNodeIR& node, const std::string& key) {
         for (const auto& kv : node.properties) {
@@ -0,0 +1,407 @@
+#include "FlowGraphNative.h"
+#include "FlowGraphCodegen.h"
+#include "GameFlowNodes.h"
+#include "../core/Logger.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+#ifndef ATLAS_CXX_COMPILER
+#define ATLAS_CXX_COMPILER "c++"
+#endif
+
+namespace atlas::flow {
+
+// --- IR hash ---
+
+namespace {
+
+struct Fnv1a {
+    uint64_t value = 14695981039346656037ULL;
+
+    void Bytes(const void* data, size_t size) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            value ^= p[i];
+            value *= 1099511628211ULL;
+        }
+    }
+    void U32(uint32_t v) { Bytes(&v, sizeof(v)); }
+    void String(const std::string& s) {
+        U32(static_cast<uint32_t>(s.size()));
+        Bytes(s.data(), s.size());
+    }
+};
+
+std::string GetProperty(const FlowNodeIR& node, const std::string& key) {
+    for (const auto& kv : node.properties) {
+        if (kv.first == key) return kv.second;
+    }
+    return "";
+}
+
+#ifdef _WIN32
+// Quote one argument so CommandLineToArgvW gives it back unchanged
+void AppendArgument(std::string& cmdLine, const std::string& arg) {
+    if (!cmdLine.empty()) cmdLine += ' ';
+    if (!arg.empty() && arg.find_first_of(" \t\n\v\"") == std::string::npos) {
+        cmdLine += arg;
+        return;
+    }
+    cmdLine += '"';
+    size_t backslashes = 0;
+    for (char c : arg) {
+        if (c == '\\') {
+            ++backslashes;
+            continue;
+        }
+        cmdLine.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+        backslashes = 0;
+        cmdLine += c;
+    }
+    cmdLine.append(backslashes * 2, '\\');
+    cmdLine += '"';
+}
+#endif
+
+// Run args[0] (searched on PATH) without a shell, with stdout and
+// stderr going to logPath. Returns the exit code, -1 if it could not
+// be started or did not exit normally.
+int RunProcess(const std::vector<std::string>& args, const std::string& logPath) {
+#ifdef _WIN32
+    std::string cmdLine;
+    for (const auto& arg : args) AppendArgument(cmdLine, arg);
+
+    SECURITY_ATTRIBUTES inherit{sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
+    HANDLE log = CreateFileA(logPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, &inherit,
+                             CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (log == INVALID_HANDLE_VALUE) return -1;
+    STARTUPINFOA startup{};
+    startup.cb = sizeof(startup);
+    startup.dwFlags = STARTF_USESTDHANDLES;
+    startup.hStdOutput = log;
+    startup.hStdError = log;
+    PROCESS_INFORMATION process{};
+    BOOL started = CreateProcessA(nullptr, cmdLine.data(), nullptr, nullptr, TRUE, CREATE_NO_WINDOW,
+                                  nullptr, nullptr, &startup, &process);
+    CloseHandle(log);
+    if (!started) return -1;
+    WaitForSingleObject(process.hProcess, INFINITE);
+    DWORD code = 1;
+    GetExitCodeProcess(process.hProcess, &code);
+    CloseHandle(process.hThread);
+    CloseHandle(process.hProcess);
+    return static_cast<int>(code);
+#else
+    std::vector<char*> argv;
+    for (const auto& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, 1, logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    posix_spawn_file_actions_adddup2(&actions, 1, 2);
+    pid_t pid = 0;
+    int rc = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (rc != 0) return -1;
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return -1;
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+}
+
+uint64_t HashFlowGraphIR(const FlowGraphIR& ir) {
+    Fnv1a h;
+    h.U32(ir.version);
+    h.String(ir.name);
+    h.U32(static_cast<uint32_t>(ir.nodes.size()));
+    for (const auto& n : ir.nodes) {
+        h.U32(n.id);
+        h.String(n.type);
+        h.U32(static_cast<uint32_t>(n.properties.size()));
+        for (const auto& kv : n.properties) {
+            h.String(kv.first);
+            h.String(kv.second);
+        }
+    }
+    h.U32(static_cast<uint32_t>(ir.edges.size()));
+    for (const auto& e : ir.edges) {
+        h.U32(e.fromNode);
+        h.U32(e.fromPort);
+        h.U32(e.toNode);
+        h.U32(e.toPort);
+    }
+    return h.value;
+}
+
+// --- Interpreter graph ---
+
+bool BuildFlowGraph(const FlowGraphIR& ir, GameFlowGraph& graph,
+                    std::unordered_map<uint32_t, FlowNodeID>& nodeMap) {
+    nodeMap.clear();
+    for (const auto& n : ir.nodes) {
+        std::unique_ptr<FlowNode> node;
+        if (n.type == "State") {
+            auto state = std::make_unique<StateNode>();
+            std::string name = GetProperty(n, "stateName");
+            if (!name.empty()) state->stateName = name;
+            node = std::move(state);
+        } else if (n.type == "Condition") {
+            node = std::make_unique<ConditionNode>();
+        } else if (n.type == "Timer") {
+            node = std::make_unique<TimerNode>();
+        } else if (n.type == "Transition") {
+            node = std::make_unique<TransitionNode>();
+        } else {
+            return false;
+        }
+        if (nodeMap.count(n.id)) return false;
+        nodeMap[n.id] = graph.AddNode(std::move(node));
+    }
+    for (const auto& e : ir.edges) {
+        auto from = nodeMap.find(e.fromNode);
+        auto to = nodeMap.find(e.toNode);
+        if (from == nodeMap.end() || to == nodeMap.end()) return false;
+        graph.AddEdge({from->second, e.fromPort, to->second, e.toPort});
+    }
+    return graph.Compile();
+}
+
+// --- FlowGraphNativeBuilder ---
+
+std::string FlowGraphNativeBuilder::LibraryPath(const std::string& outputDir,
+                                                const std::string& stem) {
+#if defined(_WIN32)
+    const char* ext = ".dll";
+#elif defined(__APPLE__)
+    const char* ext = ".dylib";
+#else
+    const char* ext = ".so";
+#endif
+    std::string file = stem + ".flow" + ext;
+    return (std::filesystem::path(outputDir) / file).string();
+}
+
+std::string FlowGraphNativeBuilder::HashPath(const std::string& libraryPath) {
+    return libraryPath + ".irhash";
+}
+
+bool FlowGraphNativeBuilder::IsUpToDate(const std::string& libraryPath, uint64_t irHash) {
+    std::error_code ec;
+    if (!std::filesystem::exists(libraryPath, ec)) return false;
+    std::ifstream in(HashPath(libraryPath));
+    uint32_t abi = 0;
+    uint64_t hash = 0;
+    if (!(in >> abi >> std::hex >> hash)) return false;
+    return abi == kFlowNativeAbiVersion && hash == irHash;
+}
+
+FlowNativeBuildResult FlowGraphNativeBuilder::Build(const FlowGraphIR& ir,
+                                                    const std::string& outputDir,
+                                                    const FlowNativeBuildOptions& options) {
+    return Build(ir, outputDir, FlowGraphCodegen::SanitizeName(ir.name), options);
+}
+
+FlowNativeBuildResult FlowGraphNativeBuilder::Build(const FlowGraphIR& ir,
+                                                    const std::string& outputDir,
+                                                    const std::string& stem,
+                                                    const FlowNativeBuildOptions& options) {
+    FlowNativeBuildResult result;
+    result.irHash = HashFlowGraphIR(ir);
+    result.libraryPath = LibraryPath(outputDir, stem);
+    result.sourcePath = (std::filesystem::path(outputDir) / (stem + ".flow.cpp")).string();
+
+    // Only graphs the interpreter accepts get a native twin
+    GameFlowGraph graph;
+    std::unordered_map<uint32_t, FlowNodeID> nodeMap;
+    if (!BuildFlowGraph(ir, graph, nodeMap)) {
+        result.log = "flow graph does not compile";
+        return result;
+    }
+    std::string source = FlowGraphCodegen::GenerateNative(ir, result.irHash, kFlowNativeAbiVersion);
+    if (source.empty()) {
+        result.log = "flow graph has no native form";
+        return result;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(outputDir, ec);
+    {
+        std::ofstream out(result.sourcePath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            result.log = "cannot write " + result.sourcePath;
+            return result;
+        }
+        out << source;
+    }
+
+    std::string compiler = options.compiler;
+    if (compiler.empty()) {
+        const char* env = std::getenv("CXX");
+        compiler = (env && *env) ? env : ATLAS_CXX_COMPILER;
+    }
+    std::string logPath = result.libraryPath + ".log";
+    std::string tmpPath = result.libraryPath + ".tmp";
+    // No shell: paths and flags reach the compiler as separate arguments
+    std::vector<std::string> args = {compiler};
+    args.insert(args.end(), options.flags.begin(), options.flags.end());
+    args.insert(args.end(), {"-shared", "-fPIC", "-fvisibility=hidden", "-o", tmpPath, result.sourcePath});
+    int status = RunProcess(args, logPath);
+
+    std::ifstream log(logPath);
+    result.log.assign(std::istreambuf_iterator<char>(log), std::istreambuf_iterator<char>());
+    log.close();
+    std::filesystem::remove(logPath, ec);
+
+    if (status != 0 || !std::filesystem::exists(tmpPath)) {
+        std::filesystem::remove(tmpPath, ec);
+        if (result.log.empty()) {
+            result.log = status < 0 ? "cannot run compiler " + compiler
+                                    : "compiler " + compiler + " exited with " + std::to_string(status);
+        }
+        return result;
+    }
+    // A fresh inode, so a process still mapping the old library is unaffected.
+    // The sidecar goes first so a library never sits next to a stale one.
+    std::string hashPath = HashPath(result.libraryPath);
+    std::filesystem::remove(hashPath, ec);
+    std::filesystem::rename(tmpPath, result.libraryPath, ec);
+    if (ec) {
+        result.log = "cannot write " + result.libraryPath;
+        return result;
+    }
+    std::ofstream sidecar(hashPath, std::ios::trunc);
+    sidecar << kFlowNativeAbiVersion << ' ' << std::hex << result.irHash << '\n';
+    sidecar.close();
+    result.success = static_cast<bool>(sidecar);
+    if (!result.success) result.log = "cannot write " + hashPath;
+    return result;
+}
+
+// --- Loading ---
+
+module::ModuleLoadResult LoadNativeFlowGraph(const std::string& path, uint64_t expectedIRHash,
+                                             NativeFlowGraph& out) {
+    out = NativeFlowGraph{};
+
+    module::SharedLibrary library;
+    if (!library.Open(path)) {
+        return module::ModuleLoadResult::NotFound;
+    }
+
+    using AbiFn = uint32_t (*)();
+    using HashFn = uint64_t (*)();
+    using SlotCountFn = uint32_t (*)();
+    using SlotNodesFn = const uint32_t* (*)();
+    auto abi = reinterpret_cast<AbiFn>(library.Symbol("AtlasFlowAbiVersion"));
+    auto hash = reinterpret_cast<HashFn>(library.Symbol("AtlasFlowIRHash"));
+    auto slotCount = reinterpret_cast<SlotCountFn>(library.Symbol("AtlasFlowSlotCount"));
+    auto slotNodes = reinterpret_cast<SlotNodesFn>(library.Symbol("AtlasFlowSlotNodes"));
+    auto execute = reinterpret_cast<FlowNativeExecuteFn>(library.Symbol("AtlasFlowExecute"));
+    if (!abi || !hash || !slotCount || !slotNodes || !execute) {
+        atlas::Logger::Error("LoadNativeFlowGraph: entry points not found in " + path);
+        return module::ModuleLoadResult::SymbolMissing;
+    }
+    if (abi() != kFlowNativeAbiVersion) {
+        return module::ModuleLoadResult::AbiMismatch;
+    }
+    if (hash() != expectedIRHash) {
+        return module::ModuleLoadResult::HashMismatch;
+    }
+
+    out.library = std::move(library);
+    out.irHash = expectedIRHash;
+    out.slotCount = slotCount();
+    out.slotNodes = slotNodes();
+    out.execute = execute;
+    return module::ModuleLoadResult::Success;
+}
+
+// --- FlowGraphRuntime ---
+
+bool FlowGraphRuntime::Load(const FlowGraphIR& ir, const std::string& libraryPath) {
+    m_loaded = false;
+    m_native = NativeFlowGraph{};
+    m_nativeStatus = module::ModuleLoadResult::NotFound;
+    m_slots.clear();
+    m_slotIndex.clear();
+    m_graph.reset();
+    m_nodeMap.clear();
+    m_texts.clear();
+
+    for (const auto& n : ir.nodes) {
+        if (n.type != "State") continue;
+        std::string name = GetProperty(n, "stateName");
+        m_texts[n.id] = name.empty() ? StateNode().stateName : name;
+    }
+
+    if (!libraryPath.empty()) {
+        m_nativeStatus = LoadNativeFlowGraph(libraryPath, HashFlowGraphIR(ir), m_native);
+    }
+    if (m_native.IsLoaded()) {
+        m_slots.assign(m_native.slotCount, 0.0f);
+        for (uint32_t i = 0; i < m_native.slotCount; ++i) {
+            m_slotIndex[m_native.slotNodes[i]] = i;
+        }
+        m_loaded = true;
+        return true;
+    }
+
+    m_graph = std::make_unique<GameFlowGraph>();
+    if (!BuildFlowGraph(ir, *m_graph, m_nodeMap)) {
+        m_graph.reset();
+        return false;
+    }
+    m_loaded = true;
+    return true;
+}
+
+bool FlowGraphRuntime::Execute(const FlowContext& ctx) {
+    if (!m_loaded) return false;
+    if (m_native.IsLoaded()) {
+        FlowNativeContext native;
+        native.elapsedTime = ctx.elapsedTime;
+        native.inputReceived = ctx.inputReceived ? 1u : 0u;
+        native.tick = ctx.tick;
+        m_native.execute(&native, m_slots.data());
+        return true;
+    }
+    return m_graph->Execute(ctx);
+}
+
+float FlowGraphRuntime::GetValue(uint32_t irNode) const {
+    if (m_native.IsLoaded()) {
+        auto it = m_slotIndex.find(irNode);
+        return it != m_slotIndex.end() ? m_slots[it->second] : 0.0f;
+    }
+    if (!m_graph) return 0.0f;
+    auto it = m_nodeMap.find(irNode);
+    if (it == m_nodeMap.end()) return 0.0f;
+    const FlowValue* value = m_graph->GetOutput(it->second, 0);
+    return (value && !value->data.empty()) ? value->data[0] : 0.0f;
+}
+
+const std::string& FlowGraphRuntime::GetText(uint32_t irNode) const {
+    static const std::string empty;
+    auto it = m_texts.find(irNode);
+    return it != m_texts.end() ? it->second : empty;
+}
+
+} // namespace atlas::flow
@@ -0,0 +1,130 @@
+#pragma once
+#include "FlowGraphIR.h"
+#include "GameFlowGraph.h"
+#include "../module/ModuleLoader.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas::flow {
+
+// ============================================================
+// Native flow graph backend
+// ============================================================
+//
+// At cook time FlowGraphNativeBuilder turns a FlowGraphIR into C++
+// (FlowGraphCodegen::GenerateNative) and compiles it into a shared
+// library with the system compiler. At runtime FlowGraphRuntime loads
+// it with LoadNativeFlowGraph; the library reports the hash of
+// the IR it was generated from, and a missing, stale or incompatible
+// binary makes the runtime fall back to interpreting the IR through
+// GameFlowGraph.
+
+/// Bumped whenever the exported entry points or FlowNativeContext change.
+constexpr uint32_t kFlowNativeAbiVersion = 1;
+
+/// Layout shared with generated code.
+struct FlowNativeContext {
+    float elapsedTime = 0.0f;
+    uint32_t inputReceived = 0;
+    uint32_t tick = 0;
+};
+
+/// Writes every node's output value into slots (AtlasFlowSlotCount floats).
+using FlowNativeExecuteFn = void (*)(const FlowNativeContext* ctx, float* slots);
+
+/// Entry points of a loaded native flow graph.
+struct NativeFlowGraph {
+    module::SharedLibrary library;
+    uint64_t irHash = 0;
+    uint32_t slotCount = 0;
+    const uint32_t* slotNodes = nullptr;   // IR node id per slot
+    FlowNativeExecuteFn execute = nullptr;
+
+    bool IsLoaded() const { return execute != nullptr; }
+};
+
+/// Open a library built by FlowGraphNativeBuilder and bind its entry
+/// points. It must report kFlowNativeAbiVersion and expectedIRHash.
+module::ModuleLoadResult LoadNativeFlowGraph(const std::string& path, uint64_t expectedIRHash,
+                                             NativeFlowGraph& out);
+
+/// Hash of everything that affects execution: name, node ids, types and
+/// properties, and edges. Editor positions and categories are excluded.
+uint64_t HashFlowGraphIR(const FlowGraphIR& ir);
+
+/// Instantiate the interpreter graph for ir. nodeMap receives the
+/// GameFlowGraph id of every IR node. Fails on unknown node types or
+/// when the graph does not compile.
+bool BuildFlowGraph(const FlowGraphIR& ir, GameFlowGraph& graph,
+                    std::unordered_map<uint32_t, FlowNodeID>& nodeMap);
+
+struct FlowNativeBuildOptions {
+    std::string compiler;                  // empty: $CXX, then the engine's compiler
+    std::vector<std::string> flags = {"-O2", "-std=c++17"};   // one argument each
+};
+
+struct FlowNativeBuildResult {
+    bool success = false;
+    uint64_t irHash = 0;
+    std::string sourcePath;
+    std::string libraryPath;
+    std::string log;                       // compiler output or failure reason
+};
+
+class FlowGraphNativeBuilder {
+public:
+    /// <outputDir>/<stem>.flow.<so|dylib|dll>. The cooker uses the asset
+    /// id as the stem, so every asset gets its own library.
+    static std::string LibraryPath(const std::string& outputDir, const std::string& stem);
+
+    /// Sidecar next to a built library recording the IR hash and ABI
+    /// version it was built from.
+    static std::string HashPath(const std::string& libraryPath);
+
+    /// True when libraryPath exists and its sidecar matches irHash and
+    /// kFlowNativeAbiVersion. Reads the sidecar only; nothing is loaded.
+    static bool IsUpToDate(const std::string& libraryPath, uint64_t irHash);
+
+    /// Generate and compile ir into LibraryPath(outputDir, stem). The
+    /// source, log and temporary files are named after the stem too.
+    static FlowNativeBuildResult Build(const FlowGraphIR& ir, const std::string& outputDir,
+                                       const std::string& stem,
+                                       const FlowNativeBuildOptions& options = {});
+    /// Build with the sanitized graph name as the stem.
+    static FlowNativeBuildResult Build(const FlowGraphIR& ir, const std::string& outputDir,
+                                       const FlowNativeBuildOptions& options = {});
+};
+
+/// Executes one flow graph natively when a matching library is available
+/// and through the interpreter otherwise. Values are read by IR node id.
+class FlowGraphRuntime {
+public:
+    /// Prepare ir for execution. libraryPath may be empty or point at a
+    /// missing/stale library, in which case the interpreter is used.
+    bool Load(const FlowGraphIR& ir, const std::string& libraryPath = "");
+    bool Execute(const FlowContext& ctx);
+
+    bool IsNative() const { return m_native.IsLoaded(); }
+    /// Why the native library was not used (Success when it is).
+    module::ModuleLoadResult NativeStatus() const { return m_nativeStatus; }
+
+    /// Output value of an IR node after Execute (0 when unknown).
+    float GetValue(uint32_t irNode) const;
+    /// State name of a State node; empty for other nodes.
+    const std::string& GetText(uint32_t irNode) const;
+
+private:
+    bool m_loaded = false;
+    NativeFlowGraph m_native;
+    module::ModuleLoadResult m_nativeStatus = module::ModuleLoadResult::NotFound;
+    std::vector<float> m_slots;
+    std::unordered_map<uint32_t, uint32_t> m_slotIndex;
+
+    std::unique_ptr<GameFlowGraph> m_graph;
+    std::unordered_map<uint32_t, FlowNodeID> m_nodeMap;
+    std::unordered_map<uint32_t, std::string> m_texts;
+};
+
+} // namespace atlas::flow
@@ -10,7 +10,7 @@ Bytecode GraphCompiler::Compile(const graph::Graph& graph) {
     }
 
     m_bc.instructions.push_back({OpCode::END, 0, 0, 0});
-    return m_bc;
+    return BytecodeOptimizer::Optimize(m_bc, m_level, &m_stats);
 }
 
 void GraphCompiler::EmitNode(const graph::Node& node) {
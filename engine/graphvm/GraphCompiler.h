@@ -1,17 +1,26 @@
 #pragma once
 #include "GraphIR.h"
 #include "GraphVM.h"
+#include "GraphOptimizer.h"
 
 namespace atlas::vm {
 
 class GraphCompiler {
 public:
+    /// Emit bytecode for graph and run the optimizer at the current level.
     Bytecode Compile(const graph::Graph& graph);
 
+    void SetOptLevel(OptLevel level) { m_level = level; }
+    OptLevel GetOptLevel() const { return m_level; }
+    /// Optimizer statistics of the last Compile.
+    const OptimizerStats& GetStats() const { return m_stats; }
+
 private:
     void EmitNode(const graph::Node& node);
 
     Bytecode m_bc;
+    OptLevel m_level = OptLevel::O2;
+    OptimizerStats m_stats;
 };
 
 }
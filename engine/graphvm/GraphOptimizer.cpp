@@ -0,0 +1,698 @@
+#include "GraphOptimizer.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace atlas::vm {
+
+namespace {
+
+constexpr size_t kNone = std::numeric_limits<size_t>::max();
+constexpr size_t kMaxExpression = 32;     // longest expression CSE looks at
+constexpr uint32_t kMaxIterations = 32;
+constexpr uint32_t kMaxVerifyInputs = 1024;
+
+struct StackEffect {
+    int pops;
+    int pushes;
+};
+
+StackEffect Effect(OpCode op) {
+    switch (op) {
+        case OpCode::LOAD_CONST:
+        case OpCode::LOAD_VAR:
+            return {0, 1};
+        case OpCode::STORE_VAR:
+        case OpCode::JUMP_IF_FALSE:
+        case OpCode::POP:
+            return {1, 0};
+        case OpCode::ADD:
+        case OpCode::SUB:
+        case OpCode::MUL:
+        case OpCode::DIV:
+        case OpCode::CMP_EQ:
+        case OpCode::CMP_LT:
+        case OpCode::CMP_GT:
+            return {2, 1};
+        case OpCode::DUP:
+            return {1, 2};
+        case OpCode::ADD_IMM:
+        case OpCode::SUB_IMM:
+        case OpCode::MUL_IMM:
+        case OpCode::DIV_IMM:
+        case OpCode::CMP_EQ_IMM:
+        case OpCode::CMP_LT_IMM:
+        case OpCode::CMP_GT_IMM:
+            return {1, 1};
+        default:
+            return {0, 0};
+    }
+}
+
+bool IsBinary(OpCode op) {
+    return Effect(op).pops == 2;
+}
+
+bool IsImmediate(OpCode op) {
+    return op >= OpCode::ADD_IMM && op <= OpCode::CMP_GT_IMM;
+}
+
+bool UsesConstant(OpCode op) {
+    return op == OpCode::LOAD_CONST || IsImmediate(op);
+}
+
+bool IsJump(OpCode op) {
+    return op == OpCode::JUMP || op == OpCode::JUMP_IF_FALSE;
+}
+
+bool IsVar(OpCode op) {
+    return op == OpCode::LOAD_VAR || op == OpCode::STORE_VAR;
+}
+
+/// No side effects and no control flow: safe to drop or reuse.
+bool IsPure(OpCode op) {
+    return op == OpCode::LOAD_CONST || op == OpCode::LOAD_VAR || op == OpCode::DUP ||
+           IsBinary(op) || IsImmediate(op);
+}
+
+OpCode ImmediateOf(OpCode op) {
+    switch (op) {
+        case OpCode::ADD: return OpCode::ADD_IMM;
+        case OpCode::SUB: return OpCode::SUB_IMM;
+        case OpCode::MUL: return OpCode::MUL_IMM;
+        case OpCode::DIV: return OpCode::DIV_IMM;
+        case OpCode::CMP_EQ: return OpCode::CMP_EQ_IMM;
+        case OpCode::CMP_LT: return OpCode::CMP_LT_IMM;
+        default: return OpCode::CMP_GT_IMM;
+    }
+}
+
+OpCode BinaryOf(OpCode op) {
+    switch (op) {
+        case OpCode::ADD_IMM: return OpCode::ADD;
+        case OpCode::SUB_IMM: return OpCode::SUB;
+        case OpCode::MUL_IMM: return OpCode::MUL;
+        case OpCode::DIV_IMM: return OpCode::DIV;
+        case OpCode::CMP_EQ_IMM: return OpCode::CMP_EQ;
+        case OpCode::CMP_LT_IMM: return OpCode::CMP_LT;
+        default: return OpCode::CMP_GT;
+    }
+}
+
+/// x op c == x
+bool IsIdentity(OpCode op, Value c) {
+    return ((op == OpCode::ADD_IMM || op == OpCode::SUB_IMM) && c == 0) ||
+           ((op == OpCode::MUL_IMM || op == OpCode::DIV_IMM) && c == 1);
+}
+
+bool CanFold(OpCode op, Value a, Value b) {
+    return !(op == OpCode::DIV && a == std::numeric_limits<Value>::min() && b == -1);
+}
+
+/// Same result as GraphVM, with wrap-around instead of signed overflow.
+Value Fold(OpCode op, Value a, Value b) {
+    uint64_t ua = static_cast<uint64_t>(a);
+    uint64_t ub = static_cast<uint64_t>(b);
+    switch (op) {
+        case OpCode::ADD: return static_cast<Value>(ua + ub);
+        case OpCode::SUB: return static_cast<Value>(ua - ub);
+        case OpCode::MUL: return static_cast<Value>(ua * ub);
+        case OpCode::DIV: return b != 0 ? a / b : 0;
+        case OpCode::CMP_EQ: return a == b ? 1 : 0;
+        case OpCode::CMP_LT: return a < b ? 1 : 0;
+        default: return a > b ? 1 : 0;
+    }
+}
+
+bool SameInstruction(const Instruction& x, const Instruction& y) {
+    return x.opcode == y.opcode && x.a == y.a && x.b == y.b && x.c == y.c;
+}
+
+/// Working copy of a program. Passes rewrite in place and mark removed
+/// instructions; Compact() drops them and remaps jump targets.
+struct Program {
+    std::vector<Instruction> code;
+    std::vector<Value> constants;
+    std::vector<uint8_t> removed;
+    std::vector<uint8_t> leader;     // a jump lands here
+    OptimizerStats& stats;
+
+    size_t Size() const { return code.size(); }
+    Value Const(size_t i) const { return constants[code[i].a]; }
+
+    uint32_t AddConstant(Value v) {
+        constants.push_back(v);
+        return static_cast<uint32_t>(constants.size() - 1);
+    }
+
+    void Begin() {
+        removed.assign(code.size(), 0);
+        leader.assign(code.size(), 0);
+        for (const Instruction& inst : code) {
+            if (IsJump(inst.opcode) && inst.a < code.size()) leader[inst.a] = 1;
+        }
+    }
+
+    /// [begin, end) is live and control can only enter it at begin.
+    bool Straight(size_t begin, size_t end) const {
+        if (end > code.size()) return false;
+        for (size_t i = begin; i < end; ++i) {
+            if (removed[i] || (i > begin && leader[i])) return false;
+        }
+        return true;
+    }
+
+    bool Same(size_t a, size_t b, size_t len) const {
+        for (size_t k = 0; k < len; ++k) {
+            if (!SameInstruction(code[a + k], code[b + k])) return false;
+        }
+        return true;
+    }
+
+    void Remove(size_t i) { removed[i] = 1; }
+
+    /// Jumps into a removed instruction continue at the next live one, so
+    /// only no-op sequences may be removed where a jump lands.
+    bool Compact() {
+        size_t n = code.size();
+        std::vector<uint32_t> remap(n + 1);
+        uint32_t kept = 0;
+        for (size_t i = 0; i < n; ++i) {
+            remap[i] = kept;
+            if (!removed[i]) kept++;
+        }
+        remap[n] = kept;
+        if (kept == n) return false;
+
+        std::vector<Instruction> out;
+        out.reserve(kept);
+        for (size_t i = 0; i < n; ++i) {
+            if (removed[i]) continue;
+            Instruction inst = code[i];
+            if (IsJump(inst.opcode)) inst.a = remap[std::min<size_t>(inst.a, n)];
+            out.push_back(inst);
+        }
+        code.swap(out);
+        return true;
+    }
+};
+
+// --- Constant and branch folding ---
+
+bool FoldConstants(Program& p) {
+    p.Begin();
+    bool changed = false;
+    for (size_t i = 0; i < p.Size(); ++i) {
+        if (p.removed[i] || p.code[i].opcode != OpCode::LOAD_CONST) continue;
+
+        // LOAD_CONST a, LOAD_CONST b, op  ->  LOAD_CONST (a op b)
+        if (p.Straight(i, i + 3) && p.code[i + 1].opcode == OpCode::LOAD_CONST &&
+            IsBinary(p.code[i + 2].opcode)) {
+            OpCode op = p.code[i + 2].opcode;
+            Value a = p.Const(i), b = p.Const(i + 1);
+            if (CanFold(op, a, b)) {
+                p.code[i] = {OpCode::LOAD_CONST, p.AddConstant(Fold(op, a, b)), 0, 0};
+                p.Remove(i + 1);
+                p.Remove(i + 2);
+                p.stats.constantsFolded++;
+                changed = true;
+                continue;
+            }
+        }
+        if (!p.Straight(i, i + 2)) continue;
+        OpCode next = p.code[i + 1].opcode;
+
+        // LOAD_CONST a, op_IMM b  ->  LOAD_CONST (a op b)
+        if (IsImmediate(next)) {
+            OpCode op = BinaryOf(next);
+            Value a = p.Const(i), b = p.Const(i + 1);
+            if (CanFold(op, a, b)) {
+                p.code[i] = {OpCode::LOAD_CONST, p.AddConstant(Fold(op, a, b)), 0, 0};
+                p.Remove(i + 1);
+                p.stats.constantsFolded++;
+                changed = true;
+            }
+        } else if (next == OpCode::JUMP_IF_FALSE) {
+            // Known condition: always jump or always fall through
+            if (p.Const(i) == 0) {
+                p.code[i] = {OpCode::JUMP, p.code[i + 1].a, 0, 0};
+            } else {
+                p.Remove(i);
+            }
+            p.Remove(i + 1);
+            p.stats.branchesFolded++;
+            changed = true;
+        }
+    }
+    return p.Compact() || changed;
+}
+
+// --- Jump threading ---
+
+bool ThreadJumps(Program& p) {
+    p.Begin();
+    bool changed = false;
+    size_t n = p.Size();
+    for (size_t i = 0; i < n; ++i) {
+        Instruction& inst = p.code[i];
+        if (!IsJump(inst.opcode)) continue;
+
+        // Jump straight to the end of a chain of unconditional jumps
+        uint32_t target = inst.a;
+        for (size_t hops = 0; target < n && p.code[target].opcode == OpCode::JUMP &&
+                              p.code[target].a != target && hops < n; ++hops) {
+            target = p.code[target].a;
+        }
+        if (target != inst.a) {
+            inst.a = target;
+            p.stats.jumpsThreaded++;
+            changed = true;
+        }
+
+        if (inst.opcode == OpCode::JUMP) {
+            if (target >= n || p.code[target].opcode == OpCode::END) {
+                inst = {OpCode::END, 0, 0, 0};
+                p.stats.jumpsThreaded++;
+                changed = true;
+            } else if (target == i + 1) {
+                p.Remove(i);
+                p.stats.deadRemoved++;
+            }
+        } else if (target == i + 1) {
+            // Both edges go to the same place; only the pop remains
+            inst = {OpCode::POP, 0, 0, 0};
+            p.stats.jumpsThreaded++;
+            changed = true;
+        }
+    }
+    return p.Compact() || changed;
+}
+
+// --- Unreachable code ---
+
+bool RemoveUnreachable(Program& p) {
+    p.Begin();
+    size_t n = p.Size();
+    std::vector<uint8_t> reached(n, 0);
+    std::vector<size_t> work;
+    if (n > 0) work.push_back(0);
+    while (!work.empty()) {
+        size_t i = work.back();
+        work.pop_back();
+        if (i >= n || reached[i]) continue;
+        reached[i] = 1;
+        const Instruction& inst = p.code[i];
+        switch (inst.opcode) {
+            case OpCode::END:
+                break;
+            case OpCode::JUMP:
+                work.push_back(inst.a);
+                break;
+            case OpCode::JUMP_IF_FALSE:
+                work.push_back(inst.a);
+                work.push_back(i + 1);
+                break;
+            default:
+                work.push_back(i + 1);
+                break;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (!reached[i] || p.code[i].opcode == OpCode::NOP) {
+            p.Remove(i);
+            p.stats.deadRemoved++;
+        }
+    }
+    return p.Compact();
+}
+
+// --- Common subexpressions ---
+
+/// Ends (exclusive) of the self-contained pure expressions starting at i.
+void ExpressionEnds(const Program& p, size_t i, std::vector<size_t>& ends) {
+    ends.clear();
+    int depth = 0;
+    for (size_t j = i; j < p.Size() && j - i < kMaxExpression; ++j) {
+        if (p.removed[j] || (j > i && p.leader[j])) break;
+        OpCode op = p.code[j].opcode;
+        if (!IsPure(op)) break;
+        StackEffect e = Effect(op);
+        if (depth < e.pops) break;
+        depth += e.pushes - e.pops;
+        if (depth == 1) ends.push_back(j + 1);
+    }
+}
+
+/// Start of the self-contained pure expression that ends just before
+/// end, or kNone.
+size_t ExpressionStart(const Program& p, size_t end) {
+    int needed = 1;
+    for (size_t k = end; k-- > 0 && end - k <= kMaxExpression;) {
+        if (p.removed[k]) return kNone;
+        OpCode op = p.code[k].opcode;
+        if (!IsPure(op)) return kNone;
+        StackEffect e = Effect(op);
+        needed -= e.pushes;
+        if (needed < 0) return kNone;
+        needed += e.pops;
+        if (needed == 0) return k;
+        if (p.leader[k]) return kNone;
+    }
+    return kNone;
+}
+
+bool EliminateCommonSubexpressions(Program& p) {
+    p.Begin();
+    bool changed = false;
+    size_t n = p.Size();
+    std::vector<size_t> ends;
+
+    // E, E  ->  E, DUP
+    for (size_t i = 0; i < n; ++i) {
+        if (p.removed[i]) continue;
+        ExpressionEnds(p, i, ends);
+        for (auto it = ends.rbegin(); it != ends.rend(); ++it) {
+            size_t e = *it;
+            size_t len = e - i;
+            if (!p.Straight(i, e + len) || !p.Same(i, e, len)) continue;
+            p.code[e] = {OpCode::DUP, 0, 0, 0};
+            for (size_t k = e + 1; k < e + len; ++k) p.Remove(k);
+            p.stats.subexpressionsReused++;
+            changed = true;
+            break;
+        }
+    }
+
+    // E, STORE_VAR x, ..., E  ->  E, STORE_VAR x, ..., LOAD_VAR x
+    // while neither x nor anything E reads is stored in between
+    std::unordered_set<uint32_t> reads;
+    for (size_t s = 0; s < n; ++s) {
+        if (p.removed[s] || p.leader[s] || p.code[s].opcode != OpCode::STORE_VAR) continue;
+        size_t start = ExpressionStart(p, s);
+        if (start == kNone || s - start < 2) continue;
+        size_t len = s - start;
+        uint32_t x = p.code[s].a;
+
+        reads.clear();
+        for (size_t k = start; k < s; ++k) {
+            if (p.code[k].opcode == OpCode::LOAD_VAR) reads.insert(p.code[k].a);
+        }
+        if (reads.count(x)) continue;
+
+        for (size_t k = s + 1; k < n;) {
+            if (p.removed[k]) {
+                ++k;
+                continue;
+            }
+            if (p.leader[k]) break;
+            const Instruction& inst = p.code[k];
+            if (IsJump(inst.opcode) || inst.opcode == OpCode::END) break;
+            if (inst.opcode == OpCode::STORE_VAR && (inst.a == x || reads.count(inst.a))) break;
+            if (p.Straight(k, k + len) && p.Same(start, k, len)) {
+                p.code[k] = {OpCode::LOAD_VAR, x, 0, 0};
+                for (size_t r = k + 1; r < k + len; ++r) p.Remove(r);
+                p.stats.subexpressionsReused++;
+                changed = true;
+                k += len;
+                continue;
+            }
+            ++k;
+        }
+    }
+    return p.Compact() || changed;
+}
+
+// --- Dead stores and dead values ---
+
+bool RemoveDeadCode(Program& p) {
+    p.Begin();
+    bool changed = false;
+    size_t n = p.Size();
+    for (size_t i = 0; i < n; ++i) {
+        if (p.removed[i]) continue;
+        Instruction& inst = p.code[i];
+
+        if (inst.opcode == OpCode::STORE_VAR) {
+            // Overwritten later in the block before anything reads it
+            for (size_t j = i + 1; j < n; ++j) {
+                if (p.removed[j]) continue;
+                if (p.leader[j]) break;
+                const Instruction& next = p.code[j];
+                if (IsJump(next.opcode) || next.opcode == OpCode::END) break;
+                if (next.opcode == OpCode::LOAD_VAR && next.a == inst.a) break;
+                if (next.opcode == OpCode::STORE_VAR && next.a == inst.a) {
+                    inst = {OpCode::POP, 0, 0, 0};
+                    p.stats.deadRemoved++;
+                    changed = true;
+                    break;
+                }
+            }
+            continue;
+        }
+
+        if (!p.Straight(i, i + 2)) continue;
+        const Instruction& next = p.code[i + 1];
+        if (next.opcode == OpCode::POP && IsPure(inst.opcode)) {
+            // A pure value that is popped unused: keep only its pops
+            StackEffect e = Effect(inst.opcode);
+            if (inst.opcode == OpCode::DUP || e.pops == 0) {
+                p.Remove(i);
+                p.Remove(i + 1);
+            } else if (e.pops == 1) {
+                p.Remove(i);
+            } else {
+                inst = {OpCode::POP, 0, 0, 0};
+            }
+            p.stats.deadRemoved++;
+            changed = true;
+        } else if (inst.opcode == OpCode::LOAD_VAR && next.opcode == OpCode::STORE_VAR &&
+                   next.a == inst.a) {
+            p.Remove(i);
+            p.Remove(i + 1);
+            p.stats.deadRemoved += 2;
+            changed = true;
+        }
+    }
+    return p.Compact() || changed;
+}
+
+// --- Peephole ---
+
+bool Peephole(Program& p) {
+    p.Begin();
+    bool changed = false;
+    for (size_t i = 0; i < p.Size(); ++i) {
+        if (p.removed[i]) continue;
+        Instruction& inst = p.code[i];
+
+        if (IsImmediate(inst.opcode) && IsIdentity(inst.opcode, p.Const(i))) {
+            p.Remove(i);
+            p.stats.deadRemoved++;
+            continue;
+        }
+        if (!p.Straight(i, i + 2)) continue;
+        Instruction& next = p.code[i + 1];
+
+        if (inst.opcode == OpCode::LOAD_CONST && IsBinary(next.opcode)) {
+            // LOAD_CONST c, op  ->  op_IMM c
+            inst = {ImmediateOf(next.opcode), inst.a, 0, 0};
+            p.Remove(i + 1);
+            p.stats.fused++;
+            changed = true;
+        } else if (inst.opcode == OpCode::STORE_VAR && next.opcode == OpCode::LOAD_VAR &&
+                   next.a == inst.a) {
+            // STORE_VAR x, LOAD_VAR x  ->  DUP, STORE_VAR x
+            next = inst;
+            inst = {OpCode::DUP, 0, 0, 0};
+            p.stats.subexpressionsReused++;
+            changed = true;
+        }
+    }
+    return p.Compact() || changed;
+}
+
+/// Drop unused constants and merge duplicates, in order of first use.
+void RebuildConstants(Program& p) {
+    std::vector<Value> pool;
+    std::unordered_map<Value, uint32_t> index;
+    for (Instruction& inst : p.code) {
+        if (!UsesConstant(inst.opcode)) continue;
+        Value v = p.constants[inst.a];
+        auto it = index.find(v);
+        if (it == index.end()) {
+            it = index.emplace(v, static_cast<uint32_t>(pool.size())).first;
+            pool.push_back(v);
+        }
+        inst.a = it->second;
+    }
+    p.constants.swap(pool);
+}
+
+}
+
+// --- BytecodeOptimizer ---
+
+Bytecode BytecodeOptimizer::Optimize(const Bytecode& bc, OptLevel level, OptimizerStats* stats) {
+    OptimizerStats local;
+    OptimizerStats& s = stats ? *stats : local;
+    s = OptimizerStats{};
+    s.instructionsBefore = static_cast<uint32_t>(bc.instructions.size());
+    s.instructionsAfter = s.instructionsBefore;
+
+    if (level == OptLevel::O0) return bc;
+    // Folding reads the pool; leave malformed programs alone
+    for (const Instruction& inst : bc.instructions) {
+        if (UsesConstant(inst.opcode) && inst.a >= bc.constants.size()) return bc;
+    }
+
+    Program p{bc.instructions, bc.constants, {}, {}, s};
+    for (uint32_t iter = 0; iter < kMaxIterations; ++iter) {
+        bool changed = false;
+        changed |= FoldConstants(p);
+        changed |= ThreadJumps(p);
+        changed |= RemoveUnreachable(p);
+        if (level >= OptLevel::O2) {
+            changed |= EliminateCommonSubexpressions(p);
+            changed |= RemoveDeadCode(p);
+            changed |= Peephole(p);
+        }
+        s.iterations++;
+        if (!changed) break;
+    }
+    RebuildConstants(p);
+
+    Bytecode out;
+    out.instructions = std::move(p.code);
+    out.constants = std::move(p.constants);
+    s.instructionsAfter = static_cast<uint32_t>(out.instructions.size());
+    return out;
+}
+
+// --- Stack safety ---
+
+bool CheckStackSafety(const Bytecode& bc, std::string* reason) {
+    size_t n = bc.instructions.size();
+    std::vector<int64_t> depth(n, -1);
+    std::vector<std::pair<size_t, int64_t>> work;
+    if (n > 0) work.push_back({0, 0});
+
+    auto fail = [reason](size_t i, const char* what) {
+        if (reason) {
+            std::ostringstream ss;
+            ss << "instruction " << i << ": " << what;
+            *reason = ss.str();
+        }
+        return false;
+    };
+
+    while (!work.empty()) {
+        auto [i, d] = work.back();
+        work.pop_back();
+        if (i >= n) continue;
+        if (depth[i] >= 0) {
+            if (depth[i] != d) return fail(i, "inconsistent stack depth");
+            continue;
+        }
+        depth[i] = d;
+
+        const Instruction& inst = bc.instructions[i];
+        if (UsesConstant(inst.opcode) && inst.a >= bc.constants.size()) {
+            return fail(i, "constant index out of range");
+        }
+        StackEffect e = Effect(inst.opcode);
+        if (d < e.pops) return fail(i, "stack underflow");
+        int64_t next = d - e.pops + e.pushes;
+
+        switch (inst.opcode) {
+            case OpCode::END:
+                break;
+            case OpCode::JUMP:
+                work.push_back({inst.a, next});
+                break;
+            case OpCode::JUMP_IF_FALSE:
+                work.push_back({inst.a, next});
+                work.push_back({i + 1, next});
+                break;
+            default:
+                work.push_back({i + 1, next});
+                break;
+        }
+    }
+    if (reason) reason->clear();
+    return true;
+}
+
+// --- Randomized equivalence check ---
+
+VerifyResult VerifyEquivalence(const Bytecode& original, const Bytecode& optimized,
+                               const VerifyOptions& options) {
+    VerifyResult result;
+    std::string reason;
+    if (!CheckStackSafety(original, &reason)) {
+        result.mismatch = "original is not stack-safe: " + reason;
+        return result;
+    }
+    if (!CheckStackSafety(optimized, &reason)) {
+        result.mismatch = "optimized is not stack-safe: " + reason;
+        return result;
+    }
+
+    uint32_t locals = 0;
+    for (const Bytecode* bc : {&original, &optimized}) {
+        for (const Instruction& inst : bc->instructions) {
+            if (IsVar(inst.opcode) && inst.a < kMaxVerifyInputs) locals = std::max(locals, inst.a + 1);
+        }
+    }
+
+    std::mt19937_64 rng(options.seed);
+    std::uniform_int_distribution<Value> dist(-options.inputRange, options.inputRange);
+    GraphVM a, b;
+    VMContext ctx;
+    ctx.maxSteps = options.maxSteps;
+    ctx.inputs.resize(locals);
+
+    for (uint32_t t = 0; t < options.trials; ++t) {
+        // The first trials pin the values folding is most likely to get wrong
+        for (Value& v : ctx.inputs) {
+            v = t == 0 ? 0 : t == 1 ? 1 : t == 2 ? -1 : dist(rng);
+        }
+        a.Execute(original, ctx);
+        if (a.StepLimitHit()) {
+            result.inconclusive++;
+            continue;
+        }
+        b.Execute(optimized, ctx);
+        result.trials++;
+
+        std::ostringstream ss;
+        ss << "trial " << t << ": ";
+        if (b.StepLimitHit()) {
+            ss << "optimized program did not finish";
+            result.mismatch = ss.str();
+            return result;
+        }
+        if (a.GetStack() != b.GetStack()) {
+            ss << "stack differs (" << a.GetStack().size() << " vs " << b.GetStack().size() << " values)";
+            result.mismatch = ss.str();
+            return result;
+        }
+        // Locals read before any store exist as 0 in one run and not the other
+        for (const GraphVM* vm : {&a, &b}) {
+            for (const auto& [idx, value] : vm->GetLocals()) {
+                if (a.GetLocal(idx) != b.GetLocal(idx)) {
+                    ss << "local " << idx << " is " << a.GetLocal(idx) << " vs " << b.GetLocal(idx);
+                    result.mismatch = ss.str();
+                    return result;
+                }
+            }
+        }
+    }
+    result.equivalent = true;
+    return result;
+}
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "GraphVM.h"
+#include <string>
+
+namespace atlas::vm {
+
+// ============================================================
+// Bytecode optimizer
+// ============================================================
+//
+// Rewrites a program into a shorter one with the same observable
+// result (final stack and locals). Every rewrite is a local pattern
+// over a straight-line window that no jump lands inside, so jump
+// targets only need remapping when instructions are removed. The
+// passes repeat until none of them changes the program.
+//
+// Programs are assumed stack-safe (see CheckStackSafety); a program
+// that underflows may fail at a different instruction once optimized.
+
+enum class OptLevel : uint8_t {
+    O0 = 0,   // as emitted
+    O1,       // constant and branch folding, jump threading, unreachable code
+    O2        // O1 + common subexpressions, dead stores, immediate opcodes
+};
+
+struct OptimizerStats {
+    uint32_t instructionsBefore = 0;
+    uint32_t instructionsAfter = 0;
+    uint32_t constantsFolded = 0;
+    uint32_t branchesFolded = 0;
+    uint32_t jumpsThreaded = 0;
+    uint32_t deadRemoved = 0;            // unreachable, no-op and dead-store instructions
+    uint32_t subexpressionsReused = 0;
+    uint32_t fused = 0;                  // immediate opcodes formed
+    uint32_t iterations = 0;
+};
+
+class BytecodeOptimizer {
+public:
+    static Bytecode Optimize(const Bytecode& bc, OptLevel level, OptimizerStats* stats = nullptr);
+};
+
+/// Static check that every reachable instruction sees the same stack
+/// depth on every path, never pops an empty stack and only references
+/// existing constants. Jumps past the end leave the program.
+bool CheckStackSafety(const Bytecode& bc, std::string* reason = nullptr);
+
+struct VerifyOptions {
+    uint32_t trials = 256;
+    uint64_t seed = 1;
+    Value inputRange = 1000;       // inputs drawn from [-inputRange, inputRange]
+    uint64_t maxSteps = 100000;    // per run; runs of the original past this are inconclusive
+};
+
+struct VerifyResult {
+    bool equivalent = false;
+    uint32_t trials = 0;
+    uint32_t inconclusive = 0;
+    std::string mismatch;          // first difference, empty when equivalent
+};
+
+/// Runs both programs on the same randomized locals (ctx.inputs) and
+/// compares the final stacks and locals.
+VerifyResult VerifyEquivalence(const Bytecode& original, const Bytecode& optimized,
+                               const VerifyOptions& options = {});
+
+}
@@ -21,10 +21,20 @@ bool GraphVM::PopBool() {
 void GraphVM::Execute(const Bytecode& bc, VMContext& ctx) {
     m_stack.clear();
     m_locals.clear();
+    m_steps = 0;
+    m_stepLimitHit = false;
+    for (uint32_t i = 0; i < ctx.inputs.size(); ++i) {
+        m_locals[i] = ctx.inputs[i];
+    }
 
     uint32_t ip = 0;
 
     while (ip < bc.instructions.size()) {
+        if (ctx.maxSteps != 0 && m_steps >= ctx.maxSteps) {
+            m_stepLimitHit = true;
+            return;
+        }
+        ++m_steps;
         const Instruction& inst = bc.instructions[ip];
 
         switch (inst.opcode) {
@@ -109,6 +119,46 @@ void GraphVM::Execute(const Bytecode& bc, VMContext& ctx) {
 
             case OpCode::END:
                 return;
+
+            case OpCode::DUP:
+                assert(!m_stack.empty());
+                Push(m_stack.back());
+                break;
+
+            case OpCode::POP:
+                Pop();
+                break;
+
+            case OpCode::ADD_IMM:
+                Push(Pop() + bc.constants[inst.a]);
+                break;
+
+            case OpCode::SUB_IMM:
+                Push(Pop() - bc.constants[inst.a]);
+                break;
+
+            case OpCode::MUL_IMM:
+                Push(Pop() * bc.constants[inst.a]);
+                break;
+
+            case OpCode::DIV_IMM: {
+                auto a = Pop();
+                auto b = bc.constants[inst.a];
+                Push(b != 0 ? a / b : 0);
+                break;
+            }
+
+            case OpCode::CMP_EQ_IMM:
+                Push(Pop() == bc.constants[inst.a] ? 1 : 0);
+                break;
+
+            case OpCode::CMP_LT_IMM:
+                Push(Pop() < bc.constants[inst.a] ? 1 : 0);
+                break;
+
+            case OpCode::CMP_GT_IMM:
+                Push(Pop() > bc.constants[inst.a] ? 1 : 0);
+                break;
         }
 
         ++ip;
@@ -27,7 +27,18 @@ enum class OpCode : uint8_t {
     JUMP_IF_FALSE,
 
     EMIT_EVENT,
-    END
+    END,
+
+    // Emitted by the optimizer; appended so stored bytecode keeps its encoding
+    DUP,
+    POP,
+    ADD_IMM,        // a: constant index
+    SUB_IMM,
+    MUL_IMM,
+    DIV_IMM,
+    CMP_EQ_IMM,
+    CMP_LT_IMM,
+    CMP_GT_IMM
 };
 
 struct Instruction {
@@ -45,6 +56,8 @@ struct Bytecode {
 struct VMContext {
     EntityID entity = 0;
     uint64_t tick = 0;
+    std::vector<Value> inputs;   // initial values of locals 0..n-1
+    uint64_t maxSteps = 0;       // instruction limit; 0 = unlimited
 };
 
 class GraphVM {
@@ -53,10 +66,18 @@ public:
 
     Value GetLocal(uint32_t idx) const;
     const std::vector<Value>& GetStack() const { return m_stack; }
+    const std::unordered_map<uint32_t, Value>& GetLocals() const { return m_locals; }
+
+    /// Instructions executed by the last Execute.
+    uint64_t StepCount() const { return m_steps; }
+    /// True when the last Execute stopped at ctx.maxSteps.
+    bool StepLimitHit() const { return m_stepLimitHit; }
 
 private:
     std::vector<Value> m_stack;
     std::unordered_map<uint32_t, Value> m_locals;
+    uint64_t m_steps = 0;
+    bool m_stepLimitHit = false;
 
     bool PopBool();
     Value Pop();
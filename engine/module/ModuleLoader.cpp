@@ -10,6 +10,59 @@
 
 namespace atlas::module {
 
+// --- SharedLibrary ---
+
+SharedLibrary::~SharedLibrary() {
+    Close();
+}
+
+SharedLibrary::SharedLibrary(SharedLibrary&& other) noexcept
+    : m_handle(other.m_handle) {
+    other.m_handle = nullptr;
+}
+
+SharedLibrary& SharedLibrary::operator=(SharedLibrary&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_handle = other.m_handle;
+        other.m_handle = nullptr;
+    }
+    return *this;
+}
+
+bool SharedLibrary::Open(const std::string& path, std::string* error) {
+    Close();
+#ifdef _WIN32
+    m_handle = static_cast<void*>(LoadLibraryA(path.c_str()));
+    if (!m_handle && error) *error = "failed to load " + path;
+#else
+    m_handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!m_handle && error) *error = dlerror();
+#endif
+    return m_handle != nullptr;
+}
+
+void SharedLibrary::Close() {
+    if (!m_handle) return;
+#ifdef _WIN32
+    FreeLibrary(static_cast<HMODULE>(m_handle));
+#else
+    dlclose(m_handle);
+#endif
+    m_handle = nullptr;
+}
+
+void* SharedLibrary::Symbol(const char* name) const {
+    if (!m_handle) return nullptr;
+#ifdef _WIN32
+    return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(m_handle), name));
+#else
+    return dlsym(m_handle, name);
+#endif
+}
+
+// --- ModuleLoader ---
+
 ModuleLoader::ModuleLoader() = default;
 
 ModuleLoader::~ModuleLoader() {
@@ -21,34 +74,17 @@ ModuleLoadResult ModuleLoader::Load(const std::string& path) {
         return ModuleLoadResult::AlreadyLoaded;
     }
 
-#ifdef _WIN32
-    HMODULE lib = LoadLibraryA(path.c_str());
-    if (!lib) {
-        atlas::Logger::Error("ModuleLoader: failed to load " + path);
+    std::string error;
+    if (!m_library.Open(path, &error)) {
+        atlas::Logger::Error("ModuleLoader: " + error);
         return ModuleLoadResult::NotFound;
     }
-    auto fn = reinterpret_cast<CreateGameModuleFn>(
-        GetProcAddress(lib, "CreateGameModule"));
+    auto fn = reinterpret_cast<CreateGameModuleFn>(m_library.Symbol("CreateGameModule"));
     if (!fn) {
-        FreeLibrary(lib);
+        m_library.Close();
         atlas::Logger::Error("ModuleLoader: CreateGameModule symbol not found in " + path);
         return ModuleLoadResult::SymbolMissing;
     }
-    m_handle = static_cast<void*>(lib);
-#else
-    void* lib = dlopen(path.c_str(), RTLD_NOW);
-    if (!lib) {
-        atlas::Logger::Error(std::string("ModuleLoader: ") + dlerror());
-        return ModuleLoadResult::NotFound;
-    }
-    auto fn = reinterpret_cast<CreateGameModuleFn>(dlsym(lib, "CreateGameModule"));
-    if (!fn) {
-        dlclose(lib);
-        atlas::Logger::Error("ModuleLoader: CreateGameModule symbol not found in " + path);
-        return ModuleLoadResult::SymbolMissing;
-    }
-    m_handle = lib;
-#endif
 
     m_module.reset(fn());
     return ModuleLoadResult::Success;
@@ -56,15 +92,7 @@ ModuleLoadResult ModuleLoader::Load(const std::string& path) {
 
 void ModuleLoader::Unload() {
     m_module.reset();
-
-    if (m_handle) {
-#ifdef _WIN32
-        FreeLibrary(static_cast<HMODULE>(m_handle));
-#else
-        dlclose(m_handle);
-#endif
-        m_handle = nullptr;
-    }
+    m_library.Close();
 }
 
 void ModuleLoader::SetStaticModule(std::unique_ptr<IGameModule> mod) {
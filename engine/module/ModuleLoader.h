@@ -10,6 +10,28 @@ enum class ModuleLoadResult {
     NotFound,
     SymbolMissing,
     AlreadyLoaded,
+    AbiMismatch,    // built against another native ABI version
+    HashMismatch,   // reports a different content hash (stale binary)
+};
+
+/// Owns a dlopen / LoadLibrary handle and closes it on destruction.
+class SharedLibrary {
+public:
+    SharedLibrary() = default;
+    ~SharedLibrary();
+
+    SharedLibrary(SharedLibrary&& other) noexcept;
+    SharedLibrary& operator=(SharedLibrary&& other) noexcept;
+    SharedLibrary(const SharedLibrary&) = delete;
+    SharedLibrary& operator=(const SharedLibrary&) = delete;
+
+    bool Open(const std::string& path, std::string* error = nullptr);
+    void Close();
+    void* Symbol(const char* name) const;
+    bool IsOpen() const { return m_handle != nullptr; }
+
+private:
+    void* m_handle = nullptr;
 };
 
 class ModuleLoader {
@@ -32,7 +54,7 @@ public:
 
 private:
     std::unique_ptr<IGameModule> m_module;
-    void* m_handle = nullptr;
+    SharedLibrary m_library;
 };
 
 } // namespace atlas::module
@@ -6,6 +6,24 @@
 
 namespace atlas::net {
 
+std::vector<uint8_t> EncodeInputFrame(const InputFrame& frame) {
+    std::vector<uint8_t> out(INPUT_FRAME_WIRE_SIZE);
+    std::memcpy(out.data(), &frame.tick, 4);
+    std::memcpy(out.data() + 4, &frame.playerID, 4);
+    std::memcpy(out.data() + 8, &frame.moveX, 4);
+    std::memcpy(out.data() + 12, &frame.moveY, 4);
+    return out;
+}
+
+bool DecodeInputFrame(const uint8_t* data, size_t size, InputFrame& out) {
+    if (size < INPUT_FRAME_WIRE_SIZE) return false;
+    std::memcpy(&out.tick, data, 4);
+    std::memcpy(&out.playerID, data + 4, 4);
+    std::memcpy(&out.moveX, data + 8, 4);
+    std::memcpy(&out.moveY, data + 12, 4);
+    return true;
+}
+
 void NetContext::Init(NetMode mode) {
     m_mode = mode;
     m_peers.clear();
@@ -130,6 +148,17 @@ bool NetContext::Receive(Packet& outPkt) {
     return true;
 }
 
+bool NetContext::PopOutgoing(QueuedPacket& out) {
+    if (m_outgoing.empty()) return false;
+    out = std::move(m_outgoing.front());
+    m_outgoing.pop();
+    return true;
+}
+
+void NetContext::Deliver(const Packet& pkt) {
+    m_incoming.push(pkt);
+}
+
 void NetContext::SetWorld(ecs::World* world) {
     m_world = world;
 }
@@ -14,6 +14,10 @@ namespace atlas::net {
 /// Increment when the Packet struct layout changes.
 constexpr uint32_t NET_PACKET_SCHEMA_VERSION = 1;
 
+/// Packet types used by the engine itself.
+constexpr uint16_t INPUT_FRAME_PACKET_TYPE = 0x0001;        ///< One encoded InputFrame
+constexpr uint16_t REPLICATION_DELTA_PACKET_TYPE = 0x0002;  ///< ReplicationManager delta
+
 enum class NetMode {
     Standalone,
     Client,
@@ -43,6 +47,12 @@ struct InputFrame {
     float moveY = 0.0f;
 };
 
+/// Size of an encoded InputFrame: tick, playerID, moveX, moveY.
+constexpr size_t INPUT_FRAME_WIRE_SIZE = 16;
+
+std::vector<uint8_t> EncodeInputFrame(const InputFrame& frame);
+bool DecodeInputFrame(const uint8_t* data, size_t size, InputFrame& out);
+
 struct WorldSnapshot {
     uint32_t tick = 0;
     std::vector<uint8_t> ecsState;
@@ -74,6 +84,12 @@ public:
     // Receive incoming packets (from local queue after Poll)
     bool Receive(Packet& outPkt);
 
+    // In-process transport between contexts: take a packet queued by
+    // Send/Broadcast before Poll loops it back, and queue a packet as
+    // if it had arrived from a peer
+    bool PopOutgoing(QueuedPacket& out);
+    void Deliver(const Packet& pkt);
+
     // ECS world binding (required for snapshot/rollback)
     void SetWorld(ecs::World* world);
 
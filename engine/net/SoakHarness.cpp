@@ -0,0 +1,279 @@
+#include "SoakHarness.h"
+#include "Replication.h"
+#include "../ecs/ECS.h"
+#include "../sim/ReplayRecorder.h"
+#include "../sim/TickScheduler.h"
+#include "../sim/WorldState.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+namespace atlas::net {
+
+namespace {
+
+struct SoakPosition {
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+constexpr uint32_t kPositionTag = 1;
+constexpr float kMoveSpeed = 4.0f;   // units per second at full input
+
+struct SimClient {
+    uint32_t peerID = 0;
+    size_t scriptOffset = 0;
+    NetContext net;
+    ecs::World world;
+    ReplicationManager replication;
+};
+
+// Nearest-rank percentile of sorted samples
+double Percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    if (rank > 0) rank--;
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+// Without a script every client walks a square, one side per second
+InputFrame PatternStep(uint32_t tick, uint32_t tickRate) {
+    static const float kDirs[4][2] = {{1.0f, 0.0f}, {0.0f, 1.0f}, {-1.0f, 0.0f}, {0.0f, -1.0f}};
+    const float* dir = kDirs[(tick / std::max(tickRate, 1u)) % 4];
+    InputFrame f;
+    f.moveX = dir[0];
+    f.moveY = dir[1];
+    return f;
+}
+
+}
+
+std::string SoakReport::Summary() const {
+    char buf[512];
+    std::snprintf(buf, sizeof(buf),
+                  "%u clients, %u ticks: tick p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms "
+                  "(budget %.2f ms, %u over)%s; %.1f B down, %.1f B up per client per tick; "
+                  "snapshots %zu, %zu bytes",
+                  clients, ticks, tickP50Ms, tickP90Ms, tickP99Ms, tickMaxMs,
+                  budgetMs, ticksOverBudget, MissedBudget() ? " MISSED" : "",
+                  bytesDownPerClientTick, bytesUpPerClientTick, snapshotCount, snapshotBytes);
+    return buf;
+}
+
+SoakHarness::SoakHarness(const SoakConfig& config) : m_config(config) {
+}
+
+size_t SoakHarness::LoadInputScript(const sim::ReplayRecorder& replay) {
+    m_script.clear();
+    replay.ForEachFrame(0, [this](const sim::ReplayFrame& frame) {
+        // A frame may carry several encoded inputs; one that carries
+        // none is an idle tick
+        size_t records = frame.inputData.size() / INPUT_FRAME_WIRE_SIZE;
+        if (records == 0) {
+            m_script.push_back(InputFrame{frame.tick, 0, 0.0f, 0.0f});
+            return;
+        }
+        for (size_t i = 0; i < records; ++i) {
+            InputFrame f;
+            DecodeInputFrame(frame.inputData.data() + i * INPUT_FRAME_WIRE_SIZE,
+                             INPUT_FRAME_WIRE_SIZE, f);
+            m_script.push_back(f);
+        }
+    });
+    return m_script.size();
+}
+
+bool SoakHarness::LoadInputScript(const std::string& replayPath) {
+    sim::ReplayRecorder replay;
+    if (!replay.LoadReplay(replayPath)) return false;
+    LoadInputScript(replay);
+    return true;
+}
+
+SoakReport SoakHarness::Run() {
+    SoakReport report;
+    report.clients = m_config.clients;
+    report.ticks = m_config.ticks;
+    report.budgetMs = m_config.tickBudgetMs > 0.0
+        ? m_config.tickBudgetMs
+        : 1000.0 / static_cast<double>(std::max(m_config.tickRate, 1u));
+
+    // --- Server ---
+    NetContext serverNet;
+    serverNet.Init(NetMode::Server);
+    ecs::World serverWorld;
+    serverWorld.RegisterComponent<SoakPosition>(kPositionTag);
+    ReplicationManager serverReplication;
+    serverReplication.SetWorld(&serverWorld);
+    ReplicationRule positionRule;
+    positionRule.typeTag = kPositionTag;
+    positionRule.componentName = "Position";
+    serverReplication.AddRule(positionRule);
+    sim::WorldState worldState;
+    worldState.SetMaxSnapshots(m_config.maxSnapshots);
+    sim::TickScheduler scheduler;
+    scheduler.SetTickRate(m_config.tickRate);
+    scheduler.SetFramePacing(false);
+
+    for (uint32_t i = 0; i < m_config.worldEntities; ++i) {
+        ecs::EntityID e = serverWorld.CreateEntity();
+        serverWorld.AddComponent<SoakPosition>(e, {static_cast<float>(i % 256), static_cast<float>(i / 256)});
+        serverReplication.MarkDirty(kPositionTag, e);
+    }
+
+    // --- Clients ---
+    // Indexed by peer ID, which the server hands out from 1
+    std::vector<ecs::EntityID> players(m_config.clients + 1, 0);
+    std::vector<std::unique_ptr<SimClient>> clients;
+    clients.reserve(m_config.clients);
+    for (uint32_t i = 0; i < m_config.clients; ++i) {
+        auto client = std::make_unique<SimClient>();
+        client->peerID = serverNet.AddPeer();
+        client->scriptOffset = m_script.empty() ? i * 13u : (i * 7919u) % m_script.size();
+        client->net.Init(NetMode::Client);
+        client->world.RegisterComponent<SoakPosition>(kPositionTag);
+        client->replication.SetWorld(&client->world);
+
+        ecs::EntityID player = serverWorld.CreateEntity();
+        serverWorld.AddComponent<SoakPosition>(player, {});
+        serverReplication.MarkDirty(kPositionTag, player);
+        players[client->peerID] = player;
+        clients.push_back(std::move(client));
+    }
+
+    std::vector<double> samples;
+    samples.reserve(m_config.ticks);
+    uint64_t bytesUp = 0;
+    uint64_t bytesDown = 0;
+
+    for (uint32_t tick = 0; tick < m_config.ticks; ++tick) {
+        // Clients send this tick's input
+        for (auto& client : clients) {
+            InputFrame input = m_script.empty()
+                ? PatternStep(tick + static_cast<uint32_t>(client->scriptOffset), m_config.tickRate)
+                : m_script[(tick + client->scriptOffset) % m_script.size()];
+            input.tick = tick;
+            input.playerID = client->peerID;
+
+            Packet pkt;
+            pkt.type = INPUT_FRAME_PACKET_TYPE;
+            pkt.tick = tick;
+            pkt.payload = EncodeInputFrame(input);
+            pkt.size = static_cast<uint16_t>(pkt.payload.size());
+            client->net.Send(0, pkt);
+
+            QueuedPacket out;
+            while (client->net.PopOutgoing(out)) {
+                bytesUp += out.packet.payload.size();
+                serverNet.Deliver(out.packet);
+            }
+        }
+
+        // Server tick: the part measured against the budget
+        auto start = std::chrono::steady_clock::now();
+        serverNet.Poll();
+        scheduler.Tick([&](float dt) {
+            Packet in;
+            for (;;) {
+                uint32_t invalidBefore = serverNet.InvalidChecksumCount();
+                if (!serverNet.Receive(in)) {
+                    if (serverNet.InvalidChecksumCount() == invalidBefore) break;
+                    report.inputsDropped++;
+                    continue;
+                }
+                InputFrame input;
+                if (in.type != INPUT_FRAME_PACKET_TYPE ||
+                    !DecodeInputFrame(in.payload.data(), in.payload.size(), input) ||
+                    input.playerID == 0 || input.playerID >= players.size()) {
+                    report.inputsDropped++;
+                    continue;
+                }
+                ecs::EntityID player = players[input.playerID];
+                if (auto* pos = serverWorld.GetComponent<SoakPosition>(player)) {
+                    pos->x += input.moveX * kMoveSpeed * dt;
+                    pos->y += input.moveY * kMoveSpeed * dt;
+                    if (input.moveX != 0.0f || input.moveY != 0.0f) {
+                        serverReplication.MarkDirty(kPositionTag, player);
+                    }
+                }
+                report.inputsApplied++;
+            }
+
+            serverWorld.Update(dt);
+
+            auto ecsData = serverWorld.Serialize();
+            worldState.PushSnapshot(worldState.TakeSnapshot(tick, ecsData));
+
+            Packet delta;
+            delta.type = REPLICATION_DELTA_PACKET_TYPE;
+            delta.tick = tick;
+            delta.payload = serverReplication.CollectDelta(tick);
+            delta.size = static_cast<uint16_t>(std::min<size_t>(delta.payload.size(), UINT16_MAX));
+            serverNet.Broadcast(delta);
+        });
+        serverNet.Flush();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+        // Deliver replication and let every client apply it
+        QueuedPacket out;
+        while (serverNet.PopOutgoing(out)) {
+            for (auto& client : clients) {
+                if (out.destPeerID != 0 && out.destPeerID != client->peerID) continue;
+                bytesDown += out.packet.payload.size();
+                client->net.Deliver(out.packet);
+            }
+        }
+        for (auto& client : clients) {
+            Packet in;
+            while (client->net.Receive(in)) {
+                if (in.type == REPLICATION_DELTA_PACKET_TYPE) client->replication.ApplyDelta(in.payload);
+            }
+        }
+    }
+
+    for (double ms : samples) {
+        if (ms > report.budgetMs) report.ticksOverBudget++;
+    }
+    std::sort(samples.begin(), samples.end());
+    report.tickP50Ms = Percentile(samples, 0.50);
+    report.tickP90Ms = Percentile(samples, 0.90);
+    report.tickP99Ms = Percentile(samples, 0.99);
+    report.tickMaxMs = samples.empty() ? 0.0 : samples.back();
+
+    double clientTicks = static_cast<double>(m_config.clients) * static_cast<double>(m_config.ticks);
+    if (clientTicks > 0.0) {
+        report.bytesDownPerClientTick = static_cast<double>(bytesDown) / clientTicks;
+        report.bytesUpPerClientTick = static_cast<double>(bytesUp) / clientTicks;
+    }
+    report.snapshotBytes = worldState.SnapshotMemoryBytes();
+    report.snapshotCount = worldState.SnapshotCount();
+    return report;
+}
+
+SoakRamp SoakHarness::Ramp(const SoakConfig& config, uint32_t maxClients) {
+    return Ramp(config, maxClients, {});
+}
+
+SoakRamp SoakHarness::Ramp(const SoakConfig& config, uint32_t maxClients,
+                           const std::vector<InputFrame>& script) {
+    SoakRamp ramp;
+    maxClients = std::max(maxClients, 1u);
+    for (uint32_t clients = 1;; clients = std::min(clients * 2, maxClients)) {
+        SoakConfig cfg = config;
+        cfg.clients = clients;
+        SoakHarness harness(cfg);
+        harness.m_script = script;
+        ramp.runs.push_back(harness.Run());
+        if (ramp.runs.back().MissedBudget()) {
+            ramp.firstMissedClients = clients;
+            break;
+        }
+        if (clients == maxClients) break;
+    }
+    return ramp;
+}
+
+}
@@ -0,0 +1,103 @@
+#pragma once
+// ============================================================
+// Atlas Soak Harness — Headless Server Load Testing
+// ============================================================
+//
+// Runs an authoritative server and N simulated clients in one
+// process. Clients send one InputFrame per tick; the server applies
+// them, runs the world, snapshots it for rollback the way
+// Engine::RunServer does, and broadcasts a replication delta that
+// every client applies to its own world. All traffic goes through
+// NetContext loopback queues, so the numbers cover serialization and
+// simulation, not socket I/O.
+//
+// Usage:
+//   SoakConfig cfg;
+//   cfg.clients = 64;
+//   cfg.ticks = 600;
+//   SoakReport report = SoakHarness(cfg).Run();
+//
+//   // Client count at which the tick budget is first missed:
+//   auto ramp = SoakHarness::Ramp(cfg, 1024);
+//
+// Client input comes from a recorded replay when one is loaded
+// (frames whose inputData holds encoded InputFrames), otherwise from
+// a fixed deterministic pattern.
+
+#include "NetContext.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace atlas::sim { class ReplayRecorder; }
+
+namespace atlas::net {
+
+struct SoakConfig {
+    uint32_t clients = 16;
+    uint32_t ticks = 300;
+    uint32_t tickRate = 30;
+    double tickBudgetMs = 0.0;           ///< 0 = one tick period at tickRate
+    uint32_t worldEntities = 0;          ///< Static entities besides the players
+    size_t maxSnapshots = 60;            ///< Rollback window, as WorldState
+};
+
+struct SoakReport {
+    uint32_t clients = 0;
+    uint32_t ticks = 0;
+    double budgetMs = 0.0;
+
+    // Server tick time: input, simulation, snapshot and replication
+    double tickP50Ms = 0.0;
+    double tickP90Ms = 0.0;
+    double tickP99Ms = 0.0;
+    double tickMaxMs = 0.0;
+    uint32_t ticksOverBudget = 0;
+
+    double bytesDownPerClientTick = 0.0; ///< Replication received per client
+    double bytesUpPerClientTick = 0.0;   ///< Input sent per client
+    size_t snapshotBytes = 0;            ///< Retained rollback snapshots
+    size_t snapshotCount = 0;
+
+    uint32_t inputsApplied = 0;
+    uint32_t inputsDropped = 0;          ///< Failed checksum or decode
+
+    /// The tick budget counts as missed when p99 exceeds it.
+    bool MissedBudget() const { return tickP99Ms > budgetMs; }
+
+    std::string Summary() const;
+};
+
+struct SoakRamp {
+    std::vector<SoakReport> runs;        ///< In increasing client count
+    uint32_t firstMissedClients = 0;     ///< 0 = budget held up to the max
+};
+
+class SoakHarness {
+public:
+    explicit SoakHarness(const SoakConfig& config);
+
+    /// Use the inputs recorded in a replay as every client's script.
+    /// Each client plays it from a different offset. Returns the
+    /// number of script steps taken from the replay.
+    size_t LoadInputScript(const sim::ReplayRecorder& replay);
+    bool LoadInputScript(const std::string& replayPath);
+
+    SoakReport Run();
+
+    /// Run with 1, 2, 4, ... clients up to `maxClients`, stopping at
+    /// the first count that misses the tick budget.
+    static SoakRamp Ramp(const SoakConfig& config, uint32_t maxClients);
+    static SoakRamp Ramp(const SoakConfig& config, uint32_t maxClients,
+                         const std::vector<InputFrame>& script);
+
+    const SoakConfig& Config() const { return m_config; }
+    const std::vector<InputFrame>& InputScript() const { return m_script; }
+
+private:
+    SoakConfig m_config;
+    std::vector<InputFrame> m_script;
+};
+
+}
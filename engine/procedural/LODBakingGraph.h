@@ -21,7 +21,7 @@ struct LODChain {
 
 enum class LODNodeType : uint8_t {
     MeshInput,     // takes a mesh as input
-    Decimate,      // reduce triangle count (simple vertex removal)
+    Decimate,      // reduce triangle count (quadric-error edge collapse)
     MergeVertices, // merge nearby vertices (welding)
     BakeNormals,   // recompute normals
     Output         // final LOD chain output
@@ -1,34 +1,83 @@
 #include "LODBakingNodes.h"
+#include "../core/JobSystem.h"
+#include <algorithm>
 #include <cmath>
-#include <unordered_map>
+#include <cstddef>
 
 namespace atlas::procedural {
 
-MeshData DecimateMesh(const MeshData& input, float keepFactor) {
-    MeshData result;
-    if (!input.IsValid() || input.TriangleCount() == 0) return input;
+// ---- Spatial hash welding ----
 
-    if (keepFactor <= 0.0f) {
-        // Keep vertices and normals but remove all triangles
-        result.vertices = input.vertices;
-        result.normals = input.normals;
-        return result;
+namespace {
+
+// Open-addressing map from cell hash to the newest vertex in that cell.
+// Two cells that hash alike simply share a list; the distance test
+// still decides every weld.
+class CellTable {
+public:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    explicit CellTable(size_t expected) {
+        size_t cap = 16;
+        while (cap < expected * 2) cap <<= 1;
+        m_mask = cap - 1;
+        m_keys.resize(cap);
+        m_heads.assign(cap, kNone);
     }
-    if (keepFactor >= 1.0f) return input;
 
-    size_t totalTris = input.TriangleCount();
-    size_t keepCount = static_cast<size_t>(std::floor(keepFactor * static_cast<float>(totalTris)));
-    if (keepCount == 0) keepCount = 1;
+    uint32_t Find(uint64_t key) const {
+        for (size_t i = Mix(key) & m_mask;; i = (i + 1) & m_mask) {
+            if (m_heads[i] == kNone) return kNone;
+            if (m_keys[i] == key) return m_heads[i];
+        }
+    }
 
-    result.vertices = input.vertices;
-    result.normals = input.normals;
-    // Keep the first keepCount triangles (remove from the end)
-    result.indices.assign(input.indices.begin(),
-                          input.indices.begin() + static_cast<ptrdiff_t>(keepCount * 3));
+    // Stores head for key and returns the previous head (or kNone)
+    uint32_t Exchange(uint64_t key, uint32_t head) {
+        for (size_t i = Mix(key) & m_mask;; i = (i + 1) & m_mask) {
+            if (m_heads[i] == kNone) {
+                m_keys[i] = key;
+                m_heads[i] = head;
+                return kNone;
+            }
+            if (m_keys[i] == key) {
+                uint32_t prev = m_heads[i];
+                m_heads[i] = head;
+                return prev;
+            }
+        }
+    }
 
-    return result;
+private:
+    static size_t Mix(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDull;
+        key ^= key >> 33;
+        return static_cast<size_t>(key);
+    }
+
+    size_t m_mask = 0;
+    std::vector<uint64_t> m_keys;
+    std::vector<uint32_t> m_heads;
+};
+
+int64_t CellCoord(double scaled) {
+    double c = std::floor(scaled);
+    // Clamp so far-away or non-finite coordinates still land in a cell
+    if (!(c > -1e15)) c = -1e15;
+    if (c > 1e15) c = 1e15;
+    return static_cast<int64_t>(c);
+}
+
+uint64_t CellKey(int64_t x, int64_t y, int64_t z) {
+    uint64_t h = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull;
+    h ^= static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+    h ^= static_cast<uint64_t>(z) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+    return h;
 }
 
+}  // namespace
+
 MeshData MergeNearbyVertices(const MeshData& input, float threshold) {
     MeshData result;
     if (!input.IsValid() || input.VertexCount() == 0) return input;
@@ -36,31 +85,51 @@ MeshData MergeNearbyVertices(const MeshData& input, float threshold) {
     float thresh2 = threshold * threshold;
     size_t vertCount = input.VertexCount();
 
+    // Cells are twice the threshold wide, so every earlier vertex within
+    // threshold lies in the 2x2x2 block of cells on the near side of this
+    // vertex. A zero threshold only welds identical positions, which
+    // always share a cell.
+    double invCell = threshold > 0.0f ? 0.5 / static_cast<double>(threshold) : 1.0;
+
+    CellTable cells(vertCount);
+    std::vector<uint32_t> cellNext(vertCount, CellTable::kNone);
+
     // Map from old vertex index to new vertex index
     std::vector<uint32_t> remap(vertCount);
     std::vector<float> newVerts;
     std::vector<float> newNormals;
+    newVerts.reserve(input.vertices.size());
+    newNormals.reserve(input.normals.size());
     uint32_t newCount = 0;
 
     for (size_t i = 0; i < vertCount; ++i) {
         float vx = input.vertices[i * 3];
         float vy = input.vertices[i * 3 + 1];
         float vz = input.vertices[i * 3 + 2];
+        double sx = vx * invCell, sy = vy * invCell, sz = vz * invCell;
+        int64_t cx = CellCoord(sx), cy = CellCoord(sy), cz = CellCoord(sz);
+        int64_t ox = (sx - static_cast<double>(cx)) < 0.5 ? -1 : 1;
+        int64_t oy = (sy - static_cast<double>(cy)) < 0.5 ? -1 : 1;
+        int64_t oz = (sz - static_cast<double>(cz)) < 0.5 ? -1 : 1;
 
-        // Check if this vertex is within threshold of an earlier vertex
-        bool merged = false;
-        for (size_t j = 0; j < i; ++j) {
-            float dx = vx - input.vertices[j * 3];
-            float dy = vy - input.vertices[j * 3 + 1];
-            float dz = vz - input.vertices[j * 3 + 2];
-            if (dx * dx + dy * dy + dz * dz <= thresh2) {
-                remap[i] = remap[j];
-                merged = true;
-                break;
+        // Weld to the lowest-indexed earlier vertex within threshold
+        uint32_t match = CellTable::kNone;
+        for (int n = 0; n < 8; ++n) {
+            uint64_t key = CellKey(cx + ((n & 1) ? ox : 0),
+                                   cy + ((n & 2) ? oy : 0),
+                                   cz + ((n & 4) ? oz : 0));
+            for (uint32_t j = cells.Find(key); j != CellTable::kNone; j = cellNext[j]) {
+                if (j >= match) continue;
+                float ex = vx - input.vertices[j * 3];
+                float ey = vy - input.vertices[j * 3 + 1];
+                float ez = vz - input.vertices[j * 3 + 2];
+                if (ex * ex + ey * ey + ez * ez <= thresh2) match = j;
             }
         }
 
-        if (!merged) {
+        if (match != CellTable::kNone) {
+            remap[i] = remap[match];
+        } else {
             remap[i] = newCount;
             newVerts.push_back(vx);
             newVerts.push_back(vy);
@@ -70,12 +139,15 @@ MeshData MergeNearbyVertices(const MeshData& input, float threshold) {
             newNormals.push_back(input.normals[i * 3 + 2]);
             newCount++;
         }
+
+        cellNext[i] = cells.Exchange(CellKey(cx, cy, cz), static_cast<uint32_t>(i));
     }
 
     result.vertices = std::move(newVerts);
     result.normals = std::move(newNormals);
 
     // Remap indices, skip degenerate triangles
+    result.indices.reserve(input.indices.size());
     for (size_t i = 0; i + 2 < input.indices.size(); i += 3) {
         uint32_t a = remap[input.indices[i]];
         uint32_t b = remap[input.indices[i + 1]];
@@ -90,6 +162,470 @@ MeshData MergeNearbyVertices(const MeshData& input, float threshold) {
     return result;
 }
 
+// ---- Quadric error metric simplification ----
+
+namespace {
+
+// Symmetric 4x4 plane quadric, upper triangle only
+struct Quadric {
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+
+    static Quadric FromPlane(double a, double b, double c, double d, double w) {
+        Quadric q;
+        q.a2 = w * a * a; q.ab = w * a * b; q.ac = w * a * c; q.ad = w * a * d;
+        q.b2 = w * b * b; q.bc = w * b * c; q.bd = w * b * d;
+        q.c2 = w * c * c; q.cd = w * c * d;
+        q.d2 = w * d * d;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& o) {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+        return *this;
+    }
+
+    double Error(double x, double y, double z) const {
+        return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+             + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+             + c2 * z * z + 2 * cd * z
+             + d2;
+    }
+
+    // Minimizer of the quadric; false when the system is singular
+    bool Optimal(double& x, double& y, double& z) const {
+        double det = a2 * (b2 * c2 - bc * bc)
+                   - ab * (ab * c2 - bc * ac)
+                   + ac * (ab * bc - b2 * ac);
+        if (std::fabs(det) < 1e-12) return false;
+        double inv = 1.0 / det;
+        x = -inv * (ad * (b2 * c2 - bc * bc) - ab * (bd * c2 - bc * cd) + ac * (bd * bc - b2 * cd));
+        y = -inv * (a2 * (bd * c2 - cd * bc) - ad * (ab * c2 - bc * ac) + ac * (ab * cd - bd * ac));
+        z = -inv * (a2 * (b2 * cd - bc * bd) - ab * (ab * cd - bd * ac) + ad * (ab * bc - b2 * ac));
+        return true;
+    }
+};
+
+// Heap entries stay at 16 bytes; the target position is recomputed on pop.
+// Vertex versions only grow, so the sum of both endpoint versions changes
+// whenever either endpoint was touched after the entry was queued.
+struct Collapse {
+    float cost;
+    uint32_t v0, v1;        // v0 is removed, v1 survives
+    uint32_t stamp;         // version[v0] + version[v1] when queued
+};
+
+// Total order keeps the collapse sequence deterministic
+inline bool CollapseLess(const Collapse& a, const Collapse& b) {
+    if (a.cost != b.cost) return a.cost < b.cost;
+    if (a.v0 != b.v0) return a.v0 < b.v0;
+    return a.v1 < b.v1;
+}
+
+// 4-ary min-heap: the four children of a node share one cache line
+class CollapseQueue {
+public:
+    bool Empty() const { return m_items.empty(); }
+
+    void Assign(std::vector<Collapse>&& items) {
+        m_items = std::move(items);
+        if (m_items.size() < 2) return;
+        for (size_t i = (m_items.size() - 2) / 4 + 1; i-- > 0;) SiftDown(i);
+    }
+
+    void Push(const Collapse& c) {
+        m_items.push_back(c);
+        size_t i = m_items.size() - 1;
+        while (i > 0) {
+            size_t parent = (i - 1) / 4;
+            if (!CollapseLess(c, m_items[parent])) break;
+            m_items[i] = m_items[parent];
+            i = parent;
+        }
+        m_items[i] = c;
+    }
+
+    Collapse Pop() {
+        Collapse top = m_items.front();
+        m_items.front() = m_items.back();
+        m_items.pop_back();
+        if (!m_items.empty()) SiftDown(0);
+        return top;
+    }
+
+private:
+    void SiftDown(size_t i) {
+        Collapse c = m_items[i];
+        size_t n = m_items.size();
+        for (;;) {
+            size_t first = i * 4 + 1;
+            if (first >= n) break;
+            size_t best = first;
+            size_t last = std::min(first + 4, n);
+            for (size_t k = first + 1; k < last; ++k) {
+                if (CollapseLess(m_items[k], m_items[best])) best = k;
+            }
+            if (!CollapseLess(m_items[best], c)) break;
+            m_items[i] = m_items[best];
+            i = best;
+        }
+        m_items[i] = c;
+    }
+
+    std::vector<Collapse> m_items;
+};
+
+// Penalty weight for planes that pin open boundary edges in place
+constexpr double kBoundaryWeight = 1000.0;
+
+class QuadricSimplifier {
+public:
+    explicit QuadricSimplifier(const MeshData& mesh) : m_normals(mesh.normals) {
+        size_t vc = mesh.VertexCount();
+        m_pos.resize(vc * 3);
+        for (size_t i = 0; i < vc * 3; ++i) m_pos[i] = mesh.vertices[i];
+        m_tris = mesh.indices;
+        m_triDead.assign(m_tris.size() / 3, 0);
+        m_liveTris = m_tris.size() / 3;
+        m_vertRemoved.assign(vc, 0);
+        m_version.assign(vc, 0);
+        m_quadrics.assign(vc, Quadric{});
+        m_vertTris.resize(vc);
+        for (uint32_t t = 0; t < m_triDead.size(); ++t) {
+            for (int k = 0; k < 3; ++k) m_vertTris[m_tris[t * 3 + k]].push_back(t);
+        }
+    }
+
+    void Run(size_t target) {
+        if (m_liveTris <= target) return;
+        BuildQuadrics();
+        while (m_liveTris > target && !m_heap.Empty()) {
+            Collapse c = m_heap.Pop();
+            if (m_vertRemoved[c.v0] || m_vertRemoved[c.v1]) continue;
+            if (m_version[c.v0] + m_version[c.v1] != c.stamp) continue;
+            if (!LinkConditionHolds(c.v0, c.v1)) continue;
+            double x, y, z;
+            Evaluate(c, x, y, z);
+            if (Flips(c.v0, c.v1, x, y, z) || Flips(c.v1, c.v0, x, y, z)) continue;
+            Apply(c.v0, c.v1, x, y, z);
+        }
+    }
+
+    MeshData Output() const {
+        MeshData out;
+        size_t vc = m_vertRemoved.size();
+        static constexpr uint32_t kUnused = 0xFFFFFFFFu;
+        std::vector<uint32_t> remap(vc, kUnused);
+        for (uint32_t t = 0; t < m_triDead.size(); ++t) {
+            if (m_triDead[t]) continue;
+            for (int k = 0; k < 3; ++k) remap[m_tris[t * 3 + k]] = 0;
+        }
+        uint32_t next = 0;
+        for (size_t v = 0; v < vc; ++v) {
+            if (remap[v] == kUnused) continue;
+            remap[v] = next++;
+            for (int k = 0; k < 3; ++k) {
+                out.vertices.push_back(static_cast<float>(m_pos[v * 3 + k]));
+                out.normals.push_back(m_normals[v * 3 + k]);
+            }
+        }
+        out.indices.reserve(m_liveTris * 3);
+        for (uint32_t t = 0; t < m_triDead.size(); ++t) {
+            if (m_triDead[t]) continue;
+            for (int k = 0; k < 3; ++k) out.indices.push_back(remap[m_tris[t * 3 + k]]);
+        }
+        return out;
+    }
+
+private:
+    std::vector<double> m_pos;
+    std::vector<float> m_normals;
+    std::vector<uint32_t> m_tris;
+    std::vector<uint8_t> m_triDead;
+    size_t m_liveTris = 0;
+    std::vector<uint8_t> m_vertRemoved;
+    std::vector<uint32_t> m_version;
+    std::vector<Quadric> m_quadrics;
+    std::vector<std::vector<uint32_t>> m_vertTris;
+    CollapseQueue m_heap;
+
+    void FaceNormal(uint32_t t, double& nx, double& ny, double& nz) const {
+        const double* a = &m_pos[m_tris[t * 3] * 3];
+        const double* b = &m_pos[m_tris[t * 3 + 1] * 3];
+        const double* c = &m_pos[m_tris[t * 3 + 2] * 3];
+        double ux = b[0] - a[0], uy = b[1] - a[1], uz = b[2] - a[2];
+        double vx = c[0] - a[0], vy = c[1] - a[1], vz = c[2] - a[2];
+        nx = uy * vz - uz * vy;
+        ny = uz * vx - ux * vz;
+        nz = ux * vy - uy * vx;
+    }
+
+    void BuildQuadrics() {
+        size_t triCount = m_triDead.size();
+
+        // Area-weighted face planes
+        for (uint32_t t = 0; t < triCount; ++t) {
+            double nx, ny, nz;
+            FaceNormal(t, nx, ny, nz);
+            double len = std::sqrt(nx * nx + ny * ny + nz * nz);
+            if (len <= 0.0) continue;
+            nx /= len; ny /= len; nz /= len;
+            const double* a = &m_pos[m_tris[t * 3] * 3];
+            double d = -(nx * a[0] + ny * a[1] + nz * a[2]);
+            Quadric q = Quadric::FromPlane(nx, ny, nz, d, len * 0.5);
+            for (int k = 0; k < 3; ++k) m_quadrics[m_tris[t * 3 + k]] += q;
+        }
+
+        // Sorted (edge, triangle) pairs give unique edges and boundary flags
+        // without a hash map over every edge.
+        std::vector<std::pair<uint64_t, uint32_t>> edges;
+        edges.reserve(triCount * 3);
+        for (uint32_t t = 0; t < triCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                uint32_t a = m_tris[t * 3 + k];
+                uint32_t b = m_tris[t * 3 + (k + 1) % 3];
+                uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+                edges.push_back({key, t});
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        std::vector<Collapse> initial;
+        initial.reserve(edges.size() / 2 + 1);
+        for (size_t i = 0; i < edges.size();) {
+            size_t j = i;
+            while (j < edges.size() && edges[j].first == edges[i].first) ++j;
+            uint32_t a = static_cast<uint32_t>(edges[i].first >> 32);
+            uint32_t b = static_cast<uint32_t>(edges[i].first & 0xFFFFFFFFu);
+            if (j - i == 1) AddBoundaryPlane(a, b, edges[i].second);
+            initial.push_back({0.0f, a, b, 0});
+            i = j;
+        }
+
+        // Costs need the finished quadrics, so they are evaluated last
+        double x, y, z;
+        for (auto& c : initial) Evaluate(c, x, y, z);
+        m_heap.Assign(std::move(initial));
+    }
+
+    void AddBoundaryPlane(uint32_t a, uint32_t b, uint32_t t) {
+        double fx, fy, fz;
+        FaceNormal(t, fx, fy, fz);
+        const double* pa = &m_pos[a * 3];
+        const double* pb = &m_pos[b * 3];
+        double ex = pb[0] - pa[0], ey = pb[1] - pa[1], ez = pb[2] - pa[2];
+        // Plane containing the edge, perpendicular to the face
+        double nx = ey * fz - ez * fy;
+        double ny = ez * fx - ex * fz;
+        double nz = ex * fy - ey * fx;
+        double len = std::sqrt(nx * nx + ny * ny + nz * nz);
+        if (len <= 0.0) return;
+        nx /= len; ny /= len; nz /= len;
+        double d = -(nx * pa[0] + ny * pa[1] + nz * pa[2]);
+        double edgeLen2 = ex * ex + ey * ey + ez * ez;
+        Quadric q = Quadric::FromPlane(nx, ny, nz, d, kBoundaryWeight * edgeLen2);
+        m_quadrics[a] += q;
+        m_quadrics[b] += q;
+    }
+
+    // Fills in cost and versions; (x, y, z) receives the collapse target
+    void Evaluate(Collapse& c, double& x, double& y, double& z) const {
+        Quadric q = m_quadrics[c.v0];
+        q += m_quadrics[c.v1];
+        c.stamp = m_version[c.v0] + m_version[c.v1];
+        double cost;
+        if (q.Optimal(x, y, z)) {
+            cost = q.Error(x, y, z);
+        } else {
+            // Singular system: best of the endpoints and the midpoint
+            const double* p0 = &m_pos[c.v0 * 3];
+            const double* p1 = &m_pos[c.v1 * 3];
+            double cand[3][3] = {
+                {p0[0], p0[1], p0[2]},
+                {p1[0], p1[1], p1[2]},
+                {(p0[0] + p1[0]) * 0.5, (p0[1] + p1[1]) * 0.5, (p0[2] + p1[2]) * 0.5}
+            };
+            cost = -1.0;
+            for (auto& p : cand) {
+                double e = q.Error(p[0], p[1], p[2]);
+                if (cost < 0.0 || e < cost) {
+                    cost = e;
+                    x = p[0]; y = p[1]; z = p[2];
+                }
+            }
+        }
+        c.cost = cost > 0.0 ? static_cast<float>(cost) : 0.0f;  // clamp rounding noise
+    }
+
+    void Neighbors(uint32_t v, std::vector<uint32_t>& out) const {
+        out.clear();
+        for (uint32_t t : m_vertTris[v]) {
+            if (m_triDead[t]) continue;
+            for (int k = 0; k < 3; ++k) {
+                uint32_t n = m_tris[t * 3 + k];
+                if (n != v) out.push_back(n);
+            }
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    bool SharesTriangle(uint32_t t, uint32_t v0, uint32_t v1) const {
+        bool has0 = false, has1 = false;
+        for (int k = 0; k < 3; ++k) {
+            has0 |= m_tris[t * 3 + k] == v0;
+            has1 |= m_tris[t * 3 + k] == v1;
+        }
+        return has0 && has1;
+    }
+
+    // Collapsing keeps the mesh manifold only when the endpoints share no
+    // neighbors other than the apexes of the triangles on the edge.
+    bool LinkConditionHolds(uint32_t v0, uint32_t v1) {
+        size_t shared = 0;
+        for (uint32_t t : m_vertTris[v0]) {
+            if (!m_triDead[t] && SharesTriangle(t, v0, v1)) shared++;
+        }
+        if (shared == 0 || shared > 2) return false;
+        Neighbors(v0, m_scratchA);
+        Neighbors(v1, m_scratchB);
+        size_t common = 0;
+        size_t i = 0, j = 0;
+        while (i < m_scratchA.size() && j < m_scratchB.size()) {
+            if (m_scratchA[i] < m_scratchB[j]) ++i;
+            else if (m_scratchB[j] < m_scratchA[i]) ++j;
+            else { ++common; ++i; ++j; }
+        }
+        if (common != shared) return false;
+
+        // The endpoints must not also bound a triangle fan over the same
+        // opposite edge, or the collapse folds two faces onto each other
+        // (e.g. squashing a tetrahedron into a double-sided triangle).
+        OppositeEdges(v0, v1, m_edgesA);
+        OppositeEdges(v1, v0, m_edgesB);
+        for (uint64_t e : m_edgesA) {
+            if (std::binary_search(m_edgesB.begin(), m_edgesB.end(), e)) return false;
+        }
+        return true;
+    }
+
+    void OppositeEdges(uint32_t v, uint32_t other, std::vector<uint64_t>& out) const {
+        out.clear();
+        for (uint32_t t : m_vertTris[v]) {
+            if (m_triDead[t] || SharesTriangle(t, v, other)) continue;
+            uint32_t e[2];
+            int n = 0;
+            for (int k = 0; k < 3; ++k) {
+                if (m_tris[t * 3 + k] != v) e[n++] = m_tris[t * 3 + k];
+            }
+            out.push_back((static_cast<uint64_t>(std::min(e[0], e[1])) << 32) | std::max(e[0], e[1]));
+        }
+        std::sort(out.begin(), out.end());
+    }
+
+    // True if moving v to (x, y, z) turns any surviving triangle of v over
+    bool Flips(uint32_t v, uint32_t other, double x, double y, double z) const {
+        for (uint32_t t : m_vertTris[v]) {
+            if (m_triDead[t] || SharesTriangle(t, v, other)) continue;
+            double ox, oy, oz;
+            FaceNormal(t, ox, oy, oz);
+            if (ox == 0.0 && oy == 0.0 && oz == 0.0) continue;
+
+            double p[3][3];
+            for (int k = 0; k < 3; ++k) {
+                uint32_t idx = m_tris[t * 3 + k];
+                if (idx == v) { p[k][0] = x; p[k][1] = y; p[k][2] = z; }
+                else { p[k][0] = m_pos[idx * 3]; p[k][1] = m_pos[idx * 3 + 1]; p[k][2] = m_pos[idx * 3 + 2]; }
+            }
+            double ux = p[1][0] - p[0][0], uy = p[1][1] - p[0][1], uz = p[1][2] - p[0][2];
+            double wx = p[2][0] - p[0][0], wy = p[2][1] - p[0][1], wz = p[2][2] - p[0][2];
+            double nx = uy * wz - uz * wy;
+            double ny = uz * wx - ux * wz;
+            double nz = ux * wy - uy * wx;
+            if (nx * ox + ny * oy + nz * oz <= 0.0) return true;
+        }
+        return false;
+    }
+
+    void Apply(uint32_t v0, uint32_t v1, double x, double y, double z) {
+        m_pos[v1 * 3] = x;
+        m_pos[v1 * 3 + 1] = y;
+        m_pos[v1 * 3 + 2] = z;
+        m_quadrics[v1] += m_quadrics[v0];
+        m_vertRemoved[v0] = 1;
+
+        auto& surviving = m_vertTris[v1];
+        for (uint32_t t : m_vertTris[v0]) {
+            if (m_triDead[t]) continue;
+            if (SharesTriangle(t, v0, v1)) {
+                m_triDead[t] = 1;
+                m_liveTris--;
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) {
+                if (m_tris[t * 3 + k] == v0) m_tris[t * 3 + k] = v1;
+            }
+            surviving.push_back(t);
+        }
+        std::vector<uint32_t>().swap(m_vertTris[v0]);
+        surviving.erase(std::remove_if(surviving.begin(), surviving.end(),
+                            [this](uint32_t t) { return m_triDead[t] != 0; }),
+                        surviving.end());
+
+        // Every queued edge touching v1 is now stale; requeue them
+        m_version[v1]++;
+        Neighbors(v1, m_scratchA);
+        double nx, ny, nz;
+        for (uint32_t n : m_scratchA) {
+            Collapse next{0.0f, std::min(v1, n), std::max(v1, n), 0};
+            Evaluate(next, nx, ny, nz);
+            m_heap.Push(next);
+        }
+    }
+
+    std::vector<uint32_t> m_scratchA;
+    std::vector<uint32_t> m_scratchB;
+    std::vector<uint64_t> m_edgesA;
+    std::vector<uint64_t> m_edgesB;
+};
+
+}  // namespace
+
+MeshData SimplifyMesh(const MeshData& input, size_t targetTriangles) {
+    if (!input.IsValid() || input.TriangleCount() <= targetTriangles) return input;
+
+    MeshData welded = MergeNearbyVertices(input, 0.0f);
+    if (welded.TriangleCount() <= targetTriangles) return welded;
+
+    QuadricSimplifier simplifier(welded);
+    simplifier.Run(targetTriangles);
+    return simplifier.Output();
+}
+
+MeshData DecimateMesh(const MeshData& input, float keepFactor) {
+    MeshData result;
+    if (!input.IsValid() || input.TriangleCount() == 0) return input;
+
+    if (keepFactor <= 0.0f) {
+        // Keep vertices and normals but remove all triangles
+        result.vertices = input.vertices;
+        result.normals = input.normals;
+        return result;
+    }
+    if (keepFactor >= 1.0f) return input;
+
+    size_t totalTris = input.TriangleCount();
+    size_t keepCount = static_cast<size_t>(std::floor(keepFactor * static_cast<float>(totalTris)));
+    if (keepCount == 0) keepCount = 1;
+
+    return SimplifyMesh(input, keepCount);
+}
+
 MeshData RecomputeNormals(const MeshData& input) {
     MeshData result;
     if (!input.IsValid()) return input;
@@ -143,16 +679,20 @@ LODChain GenerateLODChain(const MeshData& baseMesh, uint32_t levelCount) {
     LODChain chain;
     if (levelCount == 0) return chain;
 
+    chain.levels.resize(levelCount);
     for (uint32_t i = 0; i < levelCount; ++i) {
-        LODLevel level;
-        level.level = i;
+        chain.levels[i].level = i;
         // Each level halves the factor: 1.0, 0.5, 0.25, 0.125, ...
-        float factor = 1.0f / static_cast<float>(1u << i);
-        level.reductionFactor = factor;
-        level.mesh = DecimateMesh(baseMesh, factor);
-        chain.levels.push_back(std::move(level));
+        chain.levels[i].reductionFactor = std::ldexp(1.0f, -static_cast<int>(i));
     }
 
+    // Levels only read baseMesh, so each one bakes on its own worker
+    JobSystem::Shared().ParallelFor(levelCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            chain.levels[i].mesh = DecimateMesh(baseMesh, chain.levels[i].reductionFactor);
+        }
+    });
+
     return chain;
 }
 
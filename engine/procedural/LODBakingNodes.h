@@ -3,9 +3,16 @@
 
 namespace atlas::procedural {
 
+/// Quadric-error decimation to floor(keepFactor * triangles) (at least 1).
 MeshData DecimateMesh(const MeshData& input, float keepFactor);
+/// Edge-collapse simplification (Garland-Heckbert quadrics) until the mesh
+/// has at most targetTriangles triangles or no legal collapse remains.
+/// Coincident vertices are welded first so seams do not block collapses.
+MeshData SimplifyMesh(const MeshData& input, size_t targetTriangles);
+/// Weld vertices within threshold of an earlier vertex (spatial hash, O(n)).
 MeshData MergeNearbyVertices(const MeshData& input, float threshold);
 MeshData RecomputeNormals(const MeshData& input);
+/// Levels are decimated independently from baseMesh, in parallel.
 LODChain GenerateLODChain(const MeshData& baseMesh, uint32_t levelCount);
 
 }
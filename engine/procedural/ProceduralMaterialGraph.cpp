@@ -1,6 +1,10 @@
 #include "ProceduralMaterialGraph.h"
 #include "ProceduralMaterialNodes.h"
+#include "../core/JobSystem.h"
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
 #include <queue>
 #include <cstdlib>
 #include <stdexcept>
@@ -205,6 +209,7 @@ bool ProceduralMaterialGraph::Execute() {
     if (!m_compiled) return false;
 
     m_outputs.clear();
+    m_hasEncodedOutput = false;
 
     for (uint32_t id : m_executionOrder) {
         auto it = m_nodes.find(id);
@@ -215,6 +220,333 @@ bool ProceduralMaterialGraph::Execute() {
     return true;
 }
 
+namespace {
+
+// One node of a tiled evaluation plan. Properties are parsed once up
+// front so tile jobs never touch strings or maps.
+struct TilePlanNode {
+    MaterialNodeType type = MaterialNodeType::Output;
+    int input0 = -1;
+    int input1 = -1;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t margin = 0;        // pixels needed around each tile by consumers
+    float params[8] = {};
+    uint32_t checkerSize = 8;
+    std::unique_ptr<NoiseStreamJumper> noise;
+};
+
+constexpr size_t kFloatsPerPixel = 4 + 3 + 1 + 1;
+
+void EncodeChannel(float v, MaterialPixelFormat format, bool isNormal, uint8_t* dst) {
+    if (format == MaterialPixelFormat::Float16) {
+        uint16_t h = FloatToHalf(v);
+        std::memcpy(dst, &h, sizeof(h));
+        return;
+    }
+    if (isNormal) v = v * 0.5f + 0.5f;
+    if (v < 0.0f) v = 0.0f;
+    if (v > 1.0f) v = 1.0f;
+    *dst = static_cast<uint8_t>(std::lround(v * 255.0f));
+}
+
+float DecodeChannel(const std::vector<uint8_t>& plane, size_t index,
+                    MaterialPixelFormat format, bool isNormal) {
+    if (format == MaterialPixelFormat::Float16) {
+        uint16_t h;
+        std::memcpy(&h, plane.data() + index * 2, sizeof(h));
+        return HalfToFloat(h);
+    }
+    float v = plane[index] / 255.0f;
+    return isNormal ? v * 2.0f - 1.0f : v;
+}
+
+void EncodeRegion(const ConstMaterialTile& src, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1,
+                  EncodedMaterialData& dst) {
+    size_t bpc = dst.BytesPerChannel();
+    for (uint32_t y = y0; y < y1; ++y) {
+        size_t si = src.Index(x0, y);
+        size_t di = static_cast<size_t>(y) * dst.width + x0;
+        for (uint32_t x = x0; x < x1; ++x, ++si, ++di) {
+            for (size_t c = 0; c < 4; ++c)
+                EncodeChannel(src.albedo[si * 4 + c], dst.format, false, &dst.albedo[(di * 4 + c) * bpc]);
+            for (size_t c = 0; c < 3; ++c)
+                EncodeChannel(src.normal[si * 3 + c], dst.format, true, &dst.normal[(di * 3 + c) * bpc]);
+            EncodeChannel(src.roughness[si], dst.format, false, &dst.roughness[di * bpc]);
+            EncodeChannel(src.metallic[si], dst.format, false, &dst.metallic[di * bpc]);
+        }
+    }
+}
+
+void CopyRegion(const ConstMaterialTile& src, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1,
+                MaterialData& dst) {
+    size_t n = x1 - x0;
+    for (uint32_t y = y0; y < y1; ++y) {
+        size_t si = src.Index(x0, y);
+        size_t di = static_cast<size_t>(y) * dst.width + x0;
+        std::memcpy(&dst.albedo[di * 4], &src.albedo[si * 4], n * 4 * sizeof(float));
+        std::memcpy(&dst.normal[di * 3], &src.normal[si * 3], n * 3 * sizeof(float));
+        std::memcpy(&dst.roughness[di], &src.roughness[si], n * sizeof(float));
+        std::memcpy(&dst.metallic[di], &src.metallic[si], n * sizeof(float));
+    }
+}
+
+} // namespace
+
+float EncodedMaterialData::Albedo(size_t index) const { return DecodeChannel(albedo, index, format, false); }
+float EncodedMaterialData::Normal(size_t index) const { return DecodeChannel(normal, index, format, true); }
+float EncodedMaterialData::Roughness(size_t index) const { return DecodeChannel(roughness, index, format, false); }
+float EncodedMaterialData::Metallic(size_t index) const { return DecodeChannel(metallic, index, format, false); }
+
+bool ProceduralMaterialGraph::ExecuteTiled(const TiledEvalOptions& options) {
+    if (!m_compiled) return false;
+    m_hasEncodedOutput = false;
+
+    auto fallback = [&]() {
+        if (!Execute()) return false;
+        const MaterialData* out = GetOutput();
+        if (options.format != MaterialPixelFormat::Float32 && out && out->IsValid()) {
+            const MaterialData& data = *out;
+            ConstMaterialTile view;
+            view.width = data.width;
+            view.height = data.height;
+            view.albedo = data.albedo.data();
+            view.normal = data.normal.data();
+            view.roughness = data.roughness.data();
+            view.metallic = data.metallic.data();
+            m_encodedOutput = EncodedMaterialData();
+            m_encodedOutput.format = options.format;
+            m_encodedOutput.width = data.width;
+            m_encodedOutput.height = data.height;
+            size_t bpc = m_encodedOutput.BytesPerChannel();
+            size_t pc = data.PixelCount();
+            m_encodedOutput.albedo.resize(pc * 4 * bpc);
+            m_encodedOutput.normal.resize(pc * 3 * bpc);
+            m_encodedOutput.roughness.resize(pc * bpc);
+            m_encodedOutput.metallic.resize(pc * bpc);
+            EncodeRegion(view, 0, 0, data.width, data.height, m_encodedOutput);
+            m_hasEncodedOutput = true;
+        }
+        return true;
+    };
+
+    uint32_t outputID = 0;
+    int outputCount = 0;
+    for (auto& [id, node] : m_nodes) {
+        if (node.type == MaterialNodeType::Output) {
+            outputID = id;
+            outputCount++;
+        }
+    }
+    if (outputCount != 1) return fallback();
+
+    // Resolve inputs the way ExecuteNode does: the last edge per port that
+    // reads an existing node's port 0 wins (only port 0 is ever produced).
+    auto resolveInputs = [&](uint32_t id, uint32_t& in0, uint32_t& in1) {
+        in0 = in1 = 0;
+        for (auto& e : m_edges) {
+            if (e.toNode != id || e.fromPort != 0 || !m_nodes.count(e.fromNode)) continue;
+            if (e.toPort == 0) in0 = e.fromNode;
+            else if (e.toPort == 1) in1 = e.fromNode;
+        }
+    };
+
+    // Only nodes the Output actually reads are evaluated
+    std::unordered_map<uint32_t, bool> needed;
+    needed[outputID] = true;
+    for (auto it = m_executionOrder.rbegin(); it != m_executionOrder.rend(); ++it) {
+        if (!needed.count(*it)) continue;
+        const MaterialNode& node = m_nodes.at(*it);
+        uint32_t in0, in1;
+        resolveInputs(*it, in0, in1);
+        bool usesInput0 = node.type == MaterialNodeType::Blend ||
+                          node.type == MaterialNodeType::NormalMap ||
+                          node.type == MaterialNodeType::Output;
+        if (usesInput0 && in0) needed[in0] = true;
+        if (node.type == MaterialNodeType::Blend && in1) needed[in1] = true;
+    }
+
+    std::vector<TilePlanNode> plan;
+    std::unordered_map<uint32_t, int> planIndex;
+    for (uint32_t id : m_executionOrder) {
+        if (!needed.count(id)) continue;
+        const MaterialNode& node = m_nodes.at(id);
+        TilePlanNode p;
+        p.type = node.type;
+        uint32_t in0, in1;
+        resolveInputs(id, in0, in1);
+        if (in0 && planIndex.count(in0)) p.input0 = planIndex[in0];
+        if (in1 && planIndex.count(in1)) p.input1 = planIndex[in1];
+
+        auto dims = [&]() {
+            p.width = static_cast<uint32_t>(SafeStoi(node.GetProperty("width"), 64));
+            p.height = static_cast<uint32_t>(SafeStoi(node.GetProperty("height"), 64));
+        };
+        switch (node.type) {
+            case MaterialNodeType::SolidColor:
+                dims();
+                p.params[0] = SafeStof(node.GetProperty("r"), 1.0f);
+                p.params[1] = SafeStof(node.GetProperty("g"), 1.0f);
+                p.params[2] = SafeStof(node.GetProperty("b"), 1.0f);
+                p.params[3] = SafeStof(node.GetProperty("a"), 1.0f);
+                break;
+            case MaterialNodeType::Noise:
+                dims();
+                p.params[0] = SafeStof(node.GetProperty("scale"), 1.0f);
+                p.noise = std::make_unique<NoiseStreamJumper>(
+                    SafeStoull(node.GetProperty("seed"), 0), p.width);
+                break;
+            case MaterialNodeType::Checker:
+                dims();
+                p.checkerSize = static_cast<uint32_t>(SafeStoi(node.GetProperty("tileSize"), 8));
+                p.params[0] = SafeStof(node.GetProperty("r1"), 1.0f);
+                p.params[1] = SafeStof(node.GetProperty("g1"), 1.0f);
+                p.params[2] = SafeStof(node.GetProperty("b1"), 1.0f);
+                p.params[3] = SafeStof(node.GetProperty("r2"), 0.0f);
+                p.params[4] = SafeStof(node.GetProperty("g2"), 0.0f);
+                p.params[5] = SafeStof(node.GetProperty("b2"), 0.0f);
+                break;
+            case MaterialNodeType::Blend:
+                p.params[0] = SafeStof(node.GetProperty("factor"), 0.5f);
+                if (p.input0 >= 0 && p.input1 >= 0 &&
+                    plan[p.input0].width == plan[p.input1].width &&
+                    plan[p.input0].height == plan[p.input1].height) {
+                    p.width = plan[p.input0].width;
+                    p.height = plan[p.input0].height;
+                }
+                break;
+            case MaterialNodeType::NormalMap:
+                p.params[0] = SafeStof(node.GetProperty("strength"), 1.0f);
+                [[fallthrough]];
+            case MaterialNodeType::Output:
+                if (p.input0 >= 0) {
+                    p.width = plan[p.input0].width;
+                    p.height = plan[p.input0].height;
+                }
+                break;
+        }
+        if (p.width == 0 || p.height == 0) p.width = p.height = 0;
+        planIndex[id] = static_cast<int>(plan.size());
+        plan.push_back(std::move(p));
+    }
+
+    // Anything that would come out empty or mismatched takes the
+    // whole-image path so results match Execute() exactly.
+    const TilePlanNode& outNode = plan.back();
+    if (outNode.width == 0 || outNode.input0 < 0) return fallback();
+    const uint32_t width = outNode.width;
+    const uint32_t height = outNode.height;
+
+    // NormalMap reads a one-pixel ring, so its inputs grow per tile
+    for (size_t i = plan.size(); i-- > 0;) {
+        uint32_t need = plan[i].margin + (plan[i].type == MaterialNodeType::NormalMap ? 1 : 0);
+        if (plan[i].input0 >= 0) plan[plan[i].input0].margin = std::max(plan[plan[i].input0].margin, need);
+        if (plan[i].input1 >= 0) plan[plan[i].input1].margin = std::max(plan[plan[i].input1].margin, need);
+    }
+
+    m_outputs.clear();
+    MaterialData* floatOut = nullptr;
+    if (options.format == MaterialPixelFormat::Float32) {
+        MaterialData& out = m_outputs[(static_cast<uint64_t>(outputID) << 16) | 0];
+        out.width = width;
+        out.height = height;
+        out.albedo.resize(out.PixelCount() * 4);
+        out.normal.resize(out.PixelCount() * 3);
+        out.roughness.resize(out.PixelCount());
+        out.metallic.resize(out.PixelCount());
+        floatOut = &out;
+    } else {
+        m_encodedOutput = EncodedMaterialData();
+        m_encodedOutput.format = options.format;
+        m_encodedOutput.width = width;
+        m_encodedOutput.height = height;
+        size_t bpc = m_encodedOutput.BytesPerChannel();
+        size_t pc = m_encodedOutput.PixelCount();
+        m_encodedOutput.albedo.resize(pc * 4 * bpc);
+        m_encodedOutput.normal.resize(pc * 3 * bpc);
+        m_encodedOutput.roughness.resize(pc * bpc);
+        m_encodedOutput.metallic.resize(pc * bpc);
+        m_hasEncodedOutput = true;
+    }
+
+    const uint32_t ts = options.tileSize > 0 ? options.tileSize : 64;
+    const uint32_t tilesX = (width + ts - 1) / ts;
+    const uint32_t tilesY = (height + ts - 1) / ts;
+    const size_t tileCount = static_cast<size_t>(tilesX) * tilesY;
+
+    std::vector<size_t> scratchOffset(plan.size() + 1, 0);
+    for (size_t i = 0; i < plan.size(); ++i) {
+        size_t side = ts + 2 * static_cast<size_t>(plan[i].margin);
+        size_t floats = plan[i].type == MaterialNodeType::Output ? 0 : side * side * kFloatsPerPixel;
+        scratchOffset[i + 1] = scratchOffset[i] + floats;
+    }
+
+    auto runTiles = [&](size_t begin, size_t end) {
+        std::vector<float> scratch(scratchOffset.back());
+        std::vector<MaterialTile> tiles(plan.size());
+
+        for (size_t t = begin; t < end; ++t) {
+            uint32_t cx0 = static_cast<uint32_t>(t % tilesX) * ts;
+            uint32_t cy0 = static_cast<uint32_t>(t / tilesX) * ts;
+            uint32_t cx1 = std::min(width, cx0 + ts);
+            uint32_t cy1 = std::min(height, cy0 + ts);
+
+            for (size_t i = 0; i < plan.size(); ++i) {
+                const TilePlanNode& p = plan[i];
+                MaterialTile& tile = tiles[i];
+                if (p.type == MaterialNodeType::Output) {
+                    tile = tiles[p.input0];
+                    continue;
+                }
+                tile.x0 = cx0 > p.margin ? cx0 - p.margin : 0;
+                tile.y0 = cy0 > p.margin ? cy0 - p.margin : 0;
+                tile.width = std::min(width, cx1 + p.margin) - tile.x0;
+                tile.height = std::min(height, cy1 + p.margin) - tile.y0;
+                size_t pixels = static_cast<size_t>(tile.width) * tile.height;
+                float* base = scratch.data() + scratchOffset[i];
+                tile.albedo = base;
+                tile.normal = tile.albedo + pixels * 4;
+                tile.roughness = tile.normal + pixels * 3;
+                tile.metallic = tile.roughness + pixels;
+
+                switch (p.type) {
+                    case MaterialNodeType::SolidColor:
+                        FillSolidColorTile(tile, p.params[0], p.params[1], p.params[2], p.params[3]);
+                        break;
+                    case MaterialNodeType::Noise:
+                        FillNoiseTile(tile, *p.noise, width, p.params[0]);
+                        break;
+                    case MaterialNodeType::Checker:
+                        FillCheckerboardTile(tile, p.checkerSize, p.params[0], p.params[1], p.params[2],
+                                             p.params[3], p.params[4], p.params[5]);
+                        break;
+                    case MaterialNodeType::Blend:
+                        BlendTiles(tiles[p.input0], tiles[p.input1], p.params[0], tile);
+                        break;
+                    case MaterialNodeType::NormalMap:
+                        NormalMapTile(tiles[p.input0], width, height, p.params[0], tile);
+                        break;
+                    case MaterialNodeType::Output:
+                        break;
+                }
+            }
+
+            const MaterialTile& result = tiles.back();
+            if (floatOut) CopyRegion(result, cx0, cy0, cx1, cy1, *floatOut);
+            else EncodeRegion(result, cx0, cy0, cx1, cy1, m_encodedOutput);
+        }
+    };
+
+    if (options.parallel) {
+        JobSystem& jobs = JobSystem::Shared();
+        size_t grain = std::max<size_t>(1, tileCount / ((jobs.WorkerCount() + 1) * 4));
+        jobs.ParallelFor(tileCount, runTiles, grain);
+    } else {
+        runTiles(0, tileCount);
+    }
+    return true;
+}
+
 const MaterialData* ProceduralMaterialGraph::GetOutput() const {
     // Find the Output node and return its result
     for (auto& [id, node] : m_nodes) {
@@ -227,6 +559,10 @@ const MaterialData* ProceduralMaterialGraph::GetOutput() const {
     return nullptr;
 }
 
+const EncodedMaterialData* ProceduralMaterialGraph::GetEncodedOutput() const {
+    return m_hasEncodedOutput ? &m_encodedOutput : nullptr;
+}
+
 size_t ProceduralMaterialGraph::NodeCount() const {
     return m_nodes.size();
 }
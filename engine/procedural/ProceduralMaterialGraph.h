@@ -26,6 +26,75 @@ struct MaterialData {
     }
 };
 
+// Window [x0, x0 + width) x [y0, y0 + height) of a texture, with its own
+// row-major planes (row stride = width). Tiled evaluation keeps one of
+// these per node so intermediates stay small enough for L2.
+struct MaterialTile {
+    uint32_t x0 = 0, y0 = 0;
+    uint32_t width = 0, height = 0;
+    float* albedo = nullptr;     // RGBA
+    float* normal = nullptr;     // XYZ
+    float* roughness = nullptr;
+    float* metallic = nullptr;
+
+    size_t Index(uint32_t x, uint32_t y) const {
+        return static_cast<size_t>(y - y0) * width + (x - x0);
+    }
+};
+
+// Read-only window for kernel inputs, so views over const material data
+// never need a writable pointer. Any MaterialTile converts to one.
+struct ConstMaterialTile {
+    uint32_t x0 = 0, y0 = 0;
+    uint32_t width = 0, height = 0;
+    const float* albedo = nullptr;
+    const float* normal = nullptr;
+    const float* roughness = nullptr;
+    const float* metallic = nullptr;
+
+    ConstMaterialTile() = default;
+    ConstMaterialTile(const MaterialTile& tile)
+        : x0(tile.x0), y0(tile.y0), width(tile.width), height(tile.height),
+          albedo(tile.albedo), normal(tile.normal), roughness(tile.roughness), metallic(tile.metallic) {}
+
+    size_t Index(uint32_t x, uint32_t y) const {
+        return static_cast<size_t>(y - y0) * width + (x - x0);
+    }
+};
+
+enum class MaterialPixelFormat : uint8_t {
+    Float32,
+    Float16,   // IEEE half, round to nearest even
+    UNorm8     // [0,1] channels; normals remapped from [-1,1]
+};
+
+// Final planes in a compact storage format. Each plane holds raw channel
+// bytes (2 per channel for Float16, 1 for UNorm8).
+struct EncodedMaterialData {
+    MaterialPixelFormat format = MaterialPixelFormat::Float16;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> albedo;     // RGBA per pixel
+    std::vector<uint8_t> normal;     // XYZ per pixel
+    std::vector<uint8_t> roughness;
+    std::vector<uint8_t> metallic;
+
+    size_t PixelCount() const { return static_cast<size_t>(width) * height; }
+    size_t BytesPerChannel() const { return format == MaterialPixelFormat::UNorm8 ? 1 : 2; }
+    size_t MemoryBytes() const { return albedo.size() + normal.size() + roughness.size() + metallic.size(); }
+    /// Decode one channel value (index counts channels, not bytes).
+    float Albedo(size_t index) const;
+    float Normal(size_t index) const;
+    float Roughness(size_t index) const;
+    float Metallic(size_t index) const;
+};
+
+struct TiledEvalOptions {
+    uint32_t tileSize = 64;
+    MaterialPixelFormat format = MaterialPixelFormat::Float32;
+    bool parallel = true;
+};
+
 enum class MaterialNodeType : uint8_t {
     SolidColor,      // uniform color output
     Noise,           // procedural noise pattern
@@ -65,7 +134,16 @@ public:
     bool Compile();
     bool Execute();
 
+    /// Evaluate the Output node's upstream chain tile by tile, spreading
+    /// tiles across the shared JobSystem. Float32 results are readable
+    /// through GetOutput(); Float16/UNorm8 through GetEncodedOutput().
+    /// Graphs with several outputs, or inputs that are missing or differ
+    /// in size, fall back to Execute() and encode its result. Intermediate
+    /// node results are not kept.
+    bool ExecuteTiled(const TiledEvalOptions& options = {});
+
     const MaterialData* GetOutput() const;
+    const EncodedMaterialData* GetEncodedOutput() const;
     size_t NodeCount() const;
     bool IsCompiled() const;
 
@@ -78,6 +156,8 @@ private:
 
     // Per-node intermediate material results keyed by (nodeID << 16 | port)
     std::unordered_map<uint64_t, MaterialData> m_outputs;
+    EncodedMaterialData m_encodedOutput;
+    bool m_hasEncodedOutput = false;
 
     bool HasCycle() const;
     void ExecuteNode(const MaterialNode& node);
@@ -1,189 +1,212 @@
 #include "ProceduralMaterialNodes.h"
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstring>
 
 namespace atlas::procedural {
 
-MaterialData GenerateSolidColor(uint32_t width, uint32_t height,
-                                float r, float g, float b, float a) {
+namespace {
+
+MaterialTile ViewOf(MaterialData& mat) {
+    MaterialTile tile;
+    tile.width = mat.width;
+    tile.height = mat.height;
+    tile.albedo = mat.albedo.data();
+    tile.normal = mat.normal.data();
+    tile.roughness = mat.roughness.data();
+    tile.metallic = mat.metallic.data();
+    return tile;
+}
+
+// Inputs of the whole-image entry points are const; kernels only read them
+ConstMaterialTile ViewOf(const MaterialData& mat) {
+    ConstMaterialTile tile;
+    tile.width = mat.width;
+    tile.height = mat.height;
+    tile.albedo = mat.albedo.data();
+    tile.normal = mat.normal.data();
+    tile.roughness = mat.roughness.data();
+    tile.metallic = mat.metallic.data();
+    return tile;
+}
+
+MaterialData Allocate(uint32_t width, uint32_t height) {
     MaterialData mat;
     mat.width = width;
     mat.height = height;
     size_t pc = mat.PixelCount();
-
     mat.albedo.resize(pc * 4);
     mat.normal.resize(pc * 3);
     mat.roughness.resize(pc);
     mat.metallic.resize(pc);
-
-    for (size_t i = 0; i < pc; ++i) {
-        mat.albedo[i * 4 + 0] = r;
-        mat.albedo[i * 4 + 1] = g;
-        mat.albedo[i * 4 + 2] = b;
-        mat.albedo[i * 4 + 3] = a;
-
-        // Flat normal pointing up (0, 0, 1) in tangent space
-        mat.normal[i * 3 + 0] = 0.0f;
-        mat.normal[i * 3 + 1] = 0.0f;
-        mat.normal[i * 3 + 2] = 1.0f;
-
-        mat.roughness[i] = 0.5f;
-        mat.metallic[i] = 0.0f;
-    }
-
     return mat;
 }
 
-MaterialData GenerateCheckerboard(uint32_t width, uint32_t height, uint32_t tileSize,
-                                  float r1, float g1, float b1,
-                                  float r2, float g2, float b2) {
-    MaterialData mat;
-    mat.width = width;
-    mat.height = height;
-    size_t pc = mat.PixelCount();
+inline void WriteFlatPixel(MaterialTile& tile, size_t i, float r, float g, float b, float a,
+                           float roughness) {
+    tile.albedo[i * 4 + 0] = r;
+    tile.albedo[i * 4 + 1] = g;
+    tile.albedo[i * 4 + 2] = b;
+    tile.albedo[i * 4 + 3] = a;
 
-    mat.albedo.resize(pc * 4);
-    mat.normal.resize(pc * 3);
-    mat.roughness.resize(pc);
-    mat.metallic.resize(pc);
+    // Flat normal pointing up (0, 0, 1) in tangent space
+    tile.normal[i * 3 + 0] = 0.0f;
+    tile.normal[i * 3 + 1] = 0.0f;
+    tile.normal[i * 3 + 2] = 1.0f;
 
-    uint32_t ts = tileSize > 0 ? tileSize : 1;
+    tile.roughness[i] = roughness;
+    tile.metallic[i] = 0.0f;
+}
 
-    for (uint32_t y = 0; y < height; ++y) {
-        for (uint32_t x = 0; x < width; ++x) {
-            size_t i = static_cast<size_t>(y) * width + x;
-            bool even = ((x / ts) + (y / ts)) % 2 == 0;
+// Xorshift64 deterministic RNG — same pattern as ProceduralMeshNodes.cpp
+inline uint64_t NoiseSeedState(uint64_t seed) {
+    uint64_t state = seed ^ 0x5DEECE66DULL;
+    return state == 0 ? 1 : state;
+}
 
-            mat.albedo[i * 4 + 0] = even ? r1 : r2;
-            mat.albedo[i * 4 + 1] = even ? g1 : g2;
-            mat.albedo[i * 4 + 2] = even ? b1 : b2;
-            mat.albedo[i * 4 + 3] = 1.0f;
+inline uint64_t XorshiftStep(uint64_t state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
 
-            mat.normal[i * 3 + 0] = 0.0f;
-            mat.normal[i * 3 + 1] = 0.0f;
-            mat.normal[i * 3 + 2] = 1.0f;
+inline float NoiseValue(uint64_t state, float scale) {
+    float v = static_cast<float>(state & 0xFFFFu) / 65535.0f * scale;
+    if (v > 1.0f) v = 1.0f;
+    if (v < 0.0f) v = 0.0f;
+    return v;
+}
 
-            mat.roughness[i] = 0.5f;
-            mat.metallic[i] = 0.0f;
-        }
+// Apply a GF(2) matrix stored as the images of each state bit.
+inline uint64_t MatVec(const uint64_t columns[64], uint64_t v) {
+    uint64_t r = 0;
+    while (v) {
+        int bit = std::countr_zero(v);
+        r ^= columns[bit];
+        v &= v - 1;
     }
-
-    return mat;
+    return r;
 }
 
-MaterialData GenerateNoiseTexture(uint32_t width, uint32_t height, uint64_t seed, float scale) {
-    MaterialData mat;
-    mat.width = width;
-    mat.height = height;
-    size_t pc = mat.PixelCount();
+} // namespace
 
-    mat.albedo.resize(pc * 4);
-    mat.normal.resize(pc * 3);
-    mat.roughness.resize(pc);
-    mat.metallic.resize(pc);
+NoiseStreamJumper::NoiseStreamJumper(uint64_t seed, uint32_t imageWidth)
+    : m_start(NoiseSeedState(seed)) {
+    for (int j = 0; j < 64; ++j) {
+        m_powers[0][j] = XorshiftStep(uint64_t(1) << j);
+    }
+    for (int k = 1; k < 64; ++k) {
+        for (int j = 0; j < 64; ++j) {
+            m_powers[k][j] = MatVec(m_powers[k - 1], m_powers[k - 1][j]);
+        }
+    }
+    for (int j = 0; j < 64; ++j) {
+        uint64_t v = uint64_t(1) << j;
+        for (int k = 0; k < 32; ++k) {
+            if (imageWidth & (1u << k)) v = MatVec(m_powers[k], v);
+        }
+        m_row[j] = v;
+    }
+}
 
-    // Xorshift64 deterministic RNG — same pattern as ProceduralMeshNodes.cpp
-    uint64_t state = seed ^ 0x5DEECE66DULL;
-    if (state == 0) state = 1;
+uint64_t NoiseStreamJumper::StateAt(uint64_t pixelIndex) const {
+    uint64_t state = m_start;
+    for (int k = 0; pixelIndex != 0; ++k, pixelIndex >>= 1) {
+        if (pixelIndex & 1) state = MatVec(m_powers[k], state);
+    }
+    return state;
+}
 
-    auto xorshift = [&]() -> float {
-        state ^= state << 13;
-        state ^= state >> 7;
-        state ^= state << 17;
-        return static_cast<float>(state & 0xFFFFu) / 65535.0f;
-    };
+uint64_t NoiseStreamJumper::NextRow(uint64_t state) const {
+    return MatVec(m_row, state);
+}
 
+void FillSolidColorTile(MaterialTile& tile, float r, float g, float b, float a) {
+    size_t pc = static_cast<size_t>(tile.width) * tile.height;
     for (size_t i = 0; i < pc; ++i) {
-        float v = xorshift() * scale;
-        if (v > 1.0f) v = 1.0f;
-        if (v < 0.0f) v = 0.0f;
-
-        mat.albedo[i * 4 + 0] = v;
-        mat.albedo[i * 4 + 1] = v;
-        mat.albedo[i * 4 + 2] = v;
-        mat.albedo[i * 4 + 3] = 1.0f;
-
-        mat.normal[i * 3 + 0] = 0.0f;
-        mat.normal[i * 3 + 1] = 0.0f;
-        mat.normal[i * 3 + 2] = 1.0f;
-
-        mat.roughness[i] = v;
-        mat.metallic[i] = 0.0f;
+        WriteFlatPixel(tile, i, r, g, b, a, 0.5f);
     }
+}
 
-    return mat;
+void FillCheckerboardTile(MaterialTile& tile, uint32_t tileSize,
+                          float r1, float g1, float b1,
+                          float r2, float g2, float b2) {
+    uint32_t ts = tileSize > 0 ? tileSize : 1;
+    for (uint32_t y = tile.y0; y < tile.y0 + tile.height; ++y) {
+        for (uint32_t x = tile.x0; x < tile.x0 + tile.width; ++x) {
+            bool even = ((x / ts) + (y / ts)) % 2 == 0;
+            WriteFlatPixel(tile, tile.Index(x, y),
+                           even ? r1 : r2, even ? g1 : g2, even ? b1 : b2, 1.0f, 0.5f);
+        }
+    }
 }
 
-MaterialData BlendMaterials(const MaterialData& a, const MaterialData& b, float factor) {
-    MaterialData mat;
-    if (a.width != b.width || a.height != b.height) return mat;
-    if (!a.IsValid() || !b.IsValid()) return mat;
+void FillNoiseTile(MaterialTile& tile, const NoiseStreamJumper& stream,
+                   uint32_t imageWidth, float scale) {
+    if (tile.width == 0 || tile.height == 0) return;
+    uint64_t rowState = stream.StateAt(static_cast<uint64_t>(tile.y0) * imageWidth + tile.x0);
+    for (uint32_t y = tile.y0; y < tile.y0 + tile.height; ++y) {
+        uint64_t state = rowState;
+        size_t i = tile.Index(tile.x0, y);
+        for (uint32_t x = 0; x < tile.width; ++x, ++i) {
+            state = XorshiftStep(state);
+            float v = NoiseValue(state, scale);
+            WriteFlatPixel(tile, i, v, v, v, 1.0f, v);
+        }
+        rowState = stream.NextRow(rowState);
+    }
+}
 
-    mat.width = a.width;
-    mat.height = a.height;
-    size_t pc = mat.PixelCount();
+void BlendTiles(const ConstMaterialTile& a, const ConstMaterialTile& b, float factor, MaterialTile& out) {
     float t = factor;
     if (t < 0.0f) t = 0.0f;
     if (t > 1.0f) t = 1.0f;
     float inv = 1.0f - t;
 
-    mat.albedo.resize(pc * 4);
-    mat.normal.resize(pc * 3);
-    mat.roughness.resize(pc);
-    mat.metallic.resize(pc);
-
-    for (size_t i = 0; i < pc * 4; ++i) {
-        mat.albedo[i] = a.albedo[i] * inv + b.albedo[i] * t;
-    }
+    for (uint32_t y = out.y0; y < out.y0 + out.height; ++y) {
+        size_t ia = a.Index(out.x0, y);
+        size_t ib = b.Index(out.x0, y);
+        size_t io = out.Index(out.x0, y);
+        for (uint32_t x = 0; x < out.width; ++x, ++ia, ++ib, ++io) {
+            for (size_t c = 0; c < 4; ++c) {
+                out.albedo[io * 4 + c] = a.albedo[ia * 4 + c] * inv + b.albedo[ib * 4 + c] * t;
+            }
 
-    for (size_t i = 0; i < pc * 3; ++i) {
-        mat.normal[i] = a.normal[i] * inv + b.normal[i] * t;
-    }
+            float nx = a.normal[ia * 3 + 0] * inv + b.normal[ib * 3 + 0] * t;
+            float ny = a.normal[ia * 3 + 1] * inv + b.normal[ib * 3 + 1] * t;
+            float nz = a.normal[ia * 3 + 2] * inv + b.normal[ib * 3 + 2] * t;
+            // Renormalize blended normals
+            float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+            if (len > 0.0f) {
+                nx = nx / len;
+                ny = ny / len;
+                nz = nz / len;
+            }
+            out.normal[io * 3 + 0] = nx;
+            out.normal[io * 3 + 1] = ny;
+            out.normal[io * 3 + 2] = nz;
 
-    // Renormalize blended normals
-    for (size_t i = 0; i < pc; ++i) {
-        size_t ni = i * 3;
-        float nx = mat.normal[ni], ny = mat.normal[ni + 1], nz = mat.normal[ni + 2];
-        float len = std::sqrt(nx * nx + ny * ny + nz * nz);
-        if (len > 0.0f) {
-            mat.normal[ni] = nx / len;
-            mat.normal[ni + 1] = ny / len;
-            mat.normal[ni + 2] = nz / len;
+            out.roughness[io] = a.roughness[ia] * inv + b.roughness[ib] * t;
+            out.metallic[io] = a.metallic[ia] * inv + b.metallic[ib] * t;
         }
     }
-
-    for (size_t i = 0; i < pc; ++i) {
-        mat.roughness[i] = a.roughness[i] * inv + b.roughness[i] * t;
-        mat.metallic[i] = a.metallic[i] * inv + b.metallic[i] * t;
-    }
-
-    return mat;
 }
 
-MaterialData ComputeNormalMap(const MaterialData& src, float strength) {
-    MaterialData mat;
-    if (!src.IsValid()) return mat;
-
-    mat.width = src.width;
-    mat.height = src.height;
-    size_t pc = mat.PixelCount();
-
-    // Copy albedo, roughness, metallic from source
-    mat.albedo = src.albedo;
-    mat.roughness = src.roughness;
-    mat.metallic = src.metallic;
-    mat.normal.resize(pc * 3);
-
+void NormalMapTile(const ConstMaterialTile& src, uint32_t imageWidth, uint32_t imageHeight,
+                   float strength, MaterialTile& out) {
     // Use roughness channel as heightmap, compute Sobel-like normals
     auto getHeight = [&](int x, int y) -> float {
         if (x < 0) x = 0;
         if (y < 0) y = 0;
-        if (x >= static_cast<int>(src.width)) x = static_cast<int>(src.width) - 1;
-        if (y >= static_cast<int>(src.height)) y = static_cast<int>(src.height) - 1;
-        return src.roughness[static_cast<size_t>(y) * src.width + x];
+        if (x >= static_cast<int>(imageWidth)) x = static_cast<int>(imageWidth) - 1;
+        if (y >= static_cast<int>(imageHeight)) y = static_cast<int>(imageHeight) - 1;
+        return src.roughness[src.Index(static_cast<uint32_t>(x), static_cast<uint32_t>(y))];
     };
 
-    for (uint32_t y = 0; y < src.height; ++y) {
-        for (uint32_t x = 0; x < src.width; ++x) {
+    for (uint32_t y = out.y0; y < out.y0 + out.height; ++y) {
+        for (uint32_t x = out.x0; x < out.x0 + out.width; ++x) {
             int ix = static_cast<int>(x);
             int iy = static_cast<int>(y);
 
@@ -204,16 +227,125 @@ MaterialData ComputeNormalMap(const MaterialData& src, float strength) {
                 nz /= len;
             }
 
-            size_t i = static_cast<size_t>(y) * src.width + x;
-            mat.normal[i * 3 + 0] = nx;
-            mat.normal[i * 3 + 1] = ny;
-            mat.normal[i * 3 + 2] = nz;
+            size_t i = out.Index(x, y);
+            size_t si = src.Index(x, y);
+            out.normal[i * 3 + 0] = nx;
+            out.normal[i * 3 + 1] = ny;
+            out.normal[i * 3 + 2] = nz;
+
+            // Copy albedo, roughness, metallic from source
+            for (size_t c = 0; c < 4; ++c) out.albedo[i * 4 + c] = src.albedo[si * 4 + c];
+            out.roughness[i] = src.roughness[si];
+            out.metallic[i] = src.metallic[si];
         }
     }
+}
+
+MaterialData GenerateSolidColor(uint32_t width, uint32_t height,
+                                float r, float g, float b, float a) {
+    MaterialData mat = Allocate(width, height);
+    MaterialTile view = ViewOf(mat);
+    FillSolidColorTile(view, r, g, b, a);
+    return mat;
+}
+
+MaterialData GenerateCheckerboard(uint32_t width, uint32_t height, uint32_t tileSize,
+                                  float r1, float g1, float b1,
+                                  float r2, float g2, float b2) {
+    MaterialData mat = Allocate(width, height);
+    MaterialTile view = ViewOf(mat);
+    FillCheckerboardTile(view, tileSize, r1, g1, b1, r2, g2, b2);
+    return mat;
+}
+
+MaterialData GenerateNoiseTexture(uint32_t width, uint32_t height, uint64_t seed, float scale) {
+    MaterialData mat = Allocate(width, height);
+    MaterialTile view = ViewOf(mat);
+
+    // One sequential pass; tiles reach the same states via NoiseStreamJumper
+    uint64_t state = NoiseSeedState(seed);
+    size_t pc = mat.PixelCount();
+    for (size_t i = 0; i < pc; ++i) {
+        state = XorshiftStep(state);
+        float v = NoiseValue(state, scale);
+        WriteFlatPixel(view, i, v, v, v, 1.0f, v);
+    }
+
+    return mat;
+}
+
+MaterialData BlendMaterials(const MaterialData& a, const MaterialData& b, float factor) {
+    MaterialData mat;
+    if (a.width != b.width || a.height != b.height) return mat;
+    if (!a.IsValid() || !b.IsValid()) return mat;
+
+    mat = Allocate(a.width, a.height);
+    MaterialTile view = ViewOf(mat);
+    BlendTiles(ViewOf(a), ViewOf(b), factor, view);
+    return mat;
+}
 
+MaterialData ComputeNormalMap(const MaterialData& src, float strength) {
+    MaterialData mat;
+    if (!src.IsValid()) return mat;
+
+    mat = Allocate(src.width, src.height);
+    MaterialTile view = ViewOf(mat);
+    NormalMapTile(ViewOf(src), src.width, src.height, strength, view);
     return mat;
 }
 
+float HalfToFloat(uint16_t h) {
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+    uint32_t exp = (h >> 10) & 0x1Fu;
+    uint32_t mant = h & 0x3FFu;
+    uint32_t bits;
+    if (exp == 0) {
+        // Zero or subnormal: mant * 2^-24
+        float v = std::ldexp(static_cast<float>(mant), -24);
+        return sign ? -v : v;
+    } else if (exp == 31) {
+        bits = sign | 0x7F800000u | (mant << 13);
+    } else {
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    }
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+uint16_t FloatToHalf(float f) {
+    uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    uint32_t sign = (x >> 16) & 0x8000u;
+    uint32_t absx = x & 0x7FFFFFFFu;
+
+    if (absx >= 0x7F800000u) {
+        // Inf stays Inf, NaN stays a (quiet) NaN
+        return static_cast<uint16_t>(sign | 0x7C00u | (absx > 0x7F800000u ? 0x200u : 0u));
+    }
+    if (absx >= 0x477FF000u) {
+        // Rounds past 65504
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (absx < 0x38800000u) {
+        // Below the smallest normal half: produce a subnormal
+        if (absx < 0x33000000u) return static_cast<uint16_t>(sign);
+        uint32_t mant = (absx & 0x7FFFFFu) | 0x800000u;
+        uint32_t shift = 126 - (absx >> 23);
+        uint32_t h = mant >> shift;
+        uint32_t rem = mant & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rem > halfway || (rem == halfway && (h & 1))) h++;
+        return static_cast<uint16_t>(sign | h);
+    }
+
+    uint32_t h = (absx - 0x38000000u) >> 13;
+    uint32_t rem = absx & 0x1FFFu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1))) h++;
+    return static_cast<uint16_t>(sign | h);
+}
+
 MaterialData GenerateProceduralTexture(uint32_t width, uint32_t height, uint64_t seed,
                                        float baseFrequency, int octaves, float warpStrength) {
     MaterialData mat;
@@ -16,4 +16,42 @@ MaterialData ComputeNormalMap(const MaterialData& src, float strength);
 MaterialData GenerateProceduralTexture(uint32_t width, uint32_t height, uint64_t seed,
                                        float baseFrequency, int octaves, float warpStrength);
 
+// ---- Tile kernels ----
+// Each kernel fills a MaterialTile window of an imageWidth x imageHeight
+// texture and produces exactly the values the whole-image function above
+// writes for those pixels, so tiled and full evaluation match bit for bit.
+
+/// Noise textures are one xorshift64 stream in row-major pixel order. The
+/// generator is linear over GF(2), so its state at any pixel is a 64x64 bit
+/// matrix power applied to the seed state; tiles jump straight to their
+/// first pixel instead of replaying the stream.
+class NoiseStreamJumper {
+public:
+    NoiseStreamJumper(uint64_t seed, uint32_t imageWidth);
+    /// State before pixel `pixelIndex` is generated.
+    uint64_t StateAt(uint64_t pixelIndex) const;
+    /// Advance a state by one image row.
+    uint64_t NextRow(uint64_t state) const;
+
+private:
+    uint64_t m_start = 1;
+    uint64_t m_powers[64][64];   // columns of M^(2^k)
+    uint64_t m_row[64];          // columns of M^imageWidth
+};
+
+void FillSolidColorTile(MaterialTile& tile, float r, float g, float b, float a);
+void FillCheckerboardTile(MaterialTile& tile, uint32_t tileSize,
+                          float r1, float g1, float b1,
+                          float r2, float g2, float b2);
+void FillNoiseTile(MaterialTile& tile, const NoiseStreamJumper& stream,
+                   uint32_t imageWidth, float scale);
+/// a and b must cover out's window.
+void BlendTiles(const ConstMaterialTile& a, const ConstMaterialTile& b, float factor, MaterialTile& out);
+/// src must cover out's window grown by one pixel (clamped to the image).
+void NormalMapTile(const ConstMaterialTile& src, uint32_t imageWidth, uint32_t imageHeight,
+                   float strength, MaterialTile& out);
+
+float HalfToFloat(uint16_t h);
+uint16_t FloatToHalf(float f);
+
 }
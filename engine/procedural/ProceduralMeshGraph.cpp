@@ -236,6 +236,19 @@ const MeshData* ProceduralMeshGraph::GetOutput() const {
     return nullptr;
 }
 
+world::PackedMesh ProceduralMeshGraph::GetPackedOutput(const world::MeshPackOptions& options) const {
+    const MeshData* mesh = GetOutput();
+    if (!mesh || !mesh->IsValid()) return world::PackedMesh();
+
+    world::MeshSourceView view;
+    view.positions = mesh->vertices.data();
+    view.normals = mesh->normals.data();
+    view.vertexCount = mesh->VertexCount();
+    view.indices = mesh->indices.data();
+    view.indexCount = mesh->indices.size();
+    return world::PackMesh(view, options);
+}
+
 size_t ProceduralMeshGraph::NodeCount() const {
     return m_nodes.size();
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include "../world/PackedMesh.h"
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -61,6 +62,8 @@ public:
     bool Execute();
 
     const MeshData* GetOutput() const;
+    /// Quantized, cache-optimized copy of the output (empty if none).
+    world::PackedMesh GetPackedOutput(const world::MeshPackOptions& options = {}) const;
     size_t NodeCount() const;
     bool IsCompiled() const;
 
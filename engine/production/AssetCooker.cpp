@@ -1,6 +1,15 @@
 #include "AssetCooker.h"
+#include "../assets/AssetRegistry.h"
+#include "../core/JobSystem.h"
+#include "../flow/FlowGraphNative.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <sstream>
 
 namespace atlas::production {
 
@@ -20,111 +29,448 @@ bool AssetCooker::StripEditorData() const {
     return m_stripEditorData;
 }
 
+void AssetCooker::SetBuildNativeFlowGraphs(bool build) {
+    m_buildNativeFlowGraphs = build;
+}
+
+bool AssetCooker::BuildNativeFlowGraphs() const {
+    return m_buildNativeFlowGraphs;
+}
+
 CookResult AssetCooker::CookAsset(const std::string& sourceId, const std::string& sourcePath) {
     CookEntry entry;
     entry.sourceId = sourceId;
     entry.sourcePath = sourcePath;
+    CookResult result = CookInto(entry, nullptr);
+    m_cookLog.push_back(std::move(entry));
+    return result;
+}
 
+CookResult AssetCooker::CookInto(CookEntry& entry, const std::vector<uint8_t>* source) const {
     // Check source exists
-    if (!std::filesystem::exists(sourcePath)) {
+    if (!source && !std::filesystem::exists(entry.sourcePath)) {
         entry.result = CookResult::SourceNotFound;
         entry.outputPath = "";
-        m_cookLog.push_back(std::move(entry));
-        return CookResult::SourceNotFound;
+        return entry.result;
     }
 
     // Determine output path
     std::filesystem::path outDir(m_outputDir);
-    std::filesystem::path srcFile(sourcePath);
-    std::string outFilename = sourceId + ".atlasb";
+    std::string outFilename = entry.sourceId + ".atlasb";
     std::filesystem::path outPath = outDir / outFilename;
     entry.outputPath = outPath.string();
 
     // Create output directory if needed
-    std::filesystem::create_directories(outDir);
+    std::error_code ec;
+    std::filesystem::create_directories(outDir, ec);
 
     // Read source file
-    std::ifstream inFile(sourcePath, std::ios::binary);
-    if (!inFile.is_open()) {
-        entry.result = CookResult::CompileError;
-        m_cookLog.push_back(std::move(entry));
-        return CookResult::CompileError;
+    std::vector<uint8_t> sourceData;
+    if (!source) {
+        std::ifstream inFile(entry.sourcePath, std::ios::binary);
+        if (!inFile.is_open()) {
+            entry.result = CookResult::CompileError;
+            return entry.result;
+        }
+        sourceData.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+        source = &sourceData;
     }
 
-    std::vector<uint8_t> sourceData(
-        (std::istreambuf_iterator<char>(inFile)),
-        std::istreambuf_iterator<char>()
-    );
-    inFile.close();
-
     // Write cooked asset (binary format with header)
     std::ofstream outFile(outPath.string(), std::ios::binary);
     if (!outFile.is_open()) {
         entry.result = CookResult::WriteError;
-        m_cookLog.push_back(std::move(entry));
-        return CookResult::WriteError;
+        return entry.result;
     }
 
     // Write simple header: magic(4) + version(4) + flags(4) + dataSize(4)
     uint32_t magic = 0x434F4F4B; // "COOK"
     uint32_t version = 1;
     uint32_t flags = m_stripEditorData ? 1 : 0;
-    uint32_t dataSize = static_cast<uint32_t>(sourceData.size());
+    uint32_t dataSize = static_cast<uint32_t>(source->size());
 
     outFile.write(reinterpret_cast<const char*>(&magic), 4);
     outFile.write(reinterpret_cast<const char*>(&version), 4);
     outFile.write(reinterpret_cast<const char*>(&flags), 4);
     outFile.write(reinterpret_cast<const char*>(&dataSize), 4);
-    outFile.write(reinterpret_cast<const char*>(sourceData.data()), sourceData.size());
+    outFile.write(reinterpret_cast<const char*>(source->data()), source->size());
     outFile.close();
+    if (!outFile) {
+        entry.result = CookResult::WriteError;
+        return entry.result;
+    }
 
     entry.result = CookResult::Success;
+    return entry.result;
+}
+
+CookResult AssetCooker::CookFlowGraph(const std::string& sourceId, const std::string& sourcePath) {
+    CookEntry entry;
+    entry.sourceId = sourceId;
+    entry.sourcePath = sourcePath;
+    CookResult result = CookFlowGraphInto(entry, nullptr);
     m_cookLog.push_back(std::move(entry));
-    return CookResult::Success;
+    return result;
+}
+
+CookResult AssetCooker::CookFlowGraphInto(CookEntry& entry, const std::vector<uint8_t>* source) const {
+    CookResult result = CookInto(entry, source);
+    if (result != CookResult::Success || !m_buildNativeFlowGraphs) return result;
+
+    std::string json;
+    if (source) {
+        json.assign(source->begin(), source->end());
+    } else {
+        std::ifstream inFile(entry.sourcePath);
+        std::stringstream ss;
+        ss << inFile.rdbuf();
+        json = ss.str();
+    }
+    flow::FlowGraphIR ir = flow::FlowGraphIR::FromJSON(json);
+
+    // Named after the asset, like the cooked output: two graphs may share a name
+    std::string libraryPath = flow::FlowGraphNativeBuilder::LibraryPath(m_outputDir, entry.sourceId);
+    if (!flow::FlowGraphNativeBuilder::IsUpToDate(libraryPath, flow::HashFlowGraphIR(ir))) {
+        flow::FlowNativeBuildResult build =
+            flow::FlowGraphNativeBuilder::Build(ir, m_outputDir, entry.sourceId);
+        if (!build.success) return result;
+    }
+    entry.nativePath = libraryPath;
+    return result;
+}
+
+// --- Incremental cook ---
+
+namespace {
+
+struct Fnv1a {
+    uint64_t value = 14695981039346656037ULL;
+
+    void Bytes(const void* data, size_t size) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            value ^= p[i];
+            value *= 1099511628211ULL;
+        }
+    }
+    void U64(uint64_t v) { Bytes(&v, sizeof(v)); }
+};
+
+struct CacheRecord {
+    uint64_t key = 0;
+    std::string outputPath;
+    std::string nativePath;
+};
+
+using CookCache = std::unordered_map<std::string, CacheRecord>;
+
+constexpr const char* kCacheHeader = "ATLASCOOKCACHE 1";
+
+CookCache LoadCache(const std::string& path) {
+    CookCache cache;
+    std::ifstream in(path);
+    std::string line;
+    if (!std::getline(in, line) || line != kCacheHeader) return cache;
+    // id \t key \t output \t native
+    while (std::getline(in, line)) {
+        std::vector<std::string> fields;
+        size_t pos = 0;
+        while (true) {
+            size_t tab = line.find('\t', pos);
+            fields.push_back(line.substr(pos, tab == std::string::npos ? std::string::npos : tab - pos));
+            if (tab == std::string::npos) break;
+            pos = tab + 1;
+        }
+        if (fields.size() != 4 || fields[0].empty()) continue;
+        CacheRecord record;
+        record.key = std::strtoull(fields[1].c_str(), nullptr, 16);
+        record.outputPath = fields[2];
+        record.nativePath = fields[3];
+        cache[fields[0]] = std::move(record);
+    }
+    return cache;
+}
+
+bool SaveCache(const std::string& path, const CookCache& cache) {
+    std::vector<const std::pair<const std::string, CacheRecord>*> records;
+    for (const auto& kv : cache) records.push_back(&kv);
+    std::sort(records.begin(), records.end(),
+              [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out.is_open()) return false;
+        out << kCacheHeader << "\n";
+        for (const auto* r : records) {
+            char key[17];
+            std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(r->second.key));
+            out << r->first << '\t' << key << '\t' << r->second.outputPath << '\t'
+                << r->second.nativePath << "\n";
+        }
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+}
+
+const char* ResultName(CookResult result) {
+    switch (result) {
+        case CookResult::Success: return "Success";
+        case CookResult::SourceNotFound: return "SourceNotFound";
+        case CookResult::CompileError: return "CompileError";
+        case CookResult::WriteError: return "WriteError";
+        case CookResult::DependencyFailed: return "DependencyFailed";
+        case CookResult::DuplicateSource: return "DuplicateSource";
+    }
+    return "Unknown";
+}
+
+}
+
+uint32_t AssetCooker::OptionsKey() const {
+    return (m_stripEditorData ? 1u : 0u) | (m_buildNativeFlowGraphs ? 2u : 0u);
+}
+
+std::string AssetCooker::CachePath() const {
+    return (std::filesystem::path(m_outputDir) / ".cookcache").string();
 }
 
 CookStats AssetCooker::CookAll(const std::string& sourceDir) {
+    auto runStart = std::chrono::steady_clock::now();
     CookStats stats;
+    m_lastRunStart = m_cookLog.size();
+    m_lastStats = stats;
 
     if (!std::filesystem::exists(sourceDir)) {
         return stats;
     }
 
     // Count total assets first
-    std::vector<std::filesystem::directory_entry> assetFiles;
+    std::vector<std::filesystem::path> assetFiles;
     for (const auto& p : std::filesystem::recursive_directory_iterator(sourceDir)) {
-        if (p.path().extension() == ".atlas" || p.path().extension() == ".atlasb") {
-            assetFiles.push_back(p);
+        if (p.path().extension() == ".atlas" || p.path().extension() == ".atlasb" ||
+            p.path().extension() == ".flowir") {
+            assetFiles.push_back(p.path());
         }
     }
+    std::sort(assetFiles.begin(), assetFiles.end());
 
     stats.totalAssets = static_cast<uint32_t>(assetFiles.size());
 
-    for (uint32_t i = 0; i < assetFiles.size(); ++i) {
-        const auto& p = assetFiles[i];
-        std::string id = p.path().stem().string();
+    struct Job {
+        CookEntry entry;
+        bool flowGraph = false;
+        bool cyclic = false;
+        bool duplicate = false;       // shares its id, and so its outputs, with another job
+        uint32_t level = 0;
+        std::vector<size_t> deps;     // jobs this one depends on, by source id
+    };
+    std::vector<Job> jobs(assetFiles.size());
+    std::unordered_map<std::string, size_t> byId;
+    for (size_t i = 0; i < assetFiles.size(); ++i) {
+        jobs[i].entry.sourceId = assetFiles[i].stem().string();
+        jobs[i].entry.sourcePath = assetFiles[i].string();
+        jobs[i].flowGraph = assetFiles[i].extension() == ".flowir";
+        auto [it, added] = byId.emplace(jobs[i].entry.sourceId, i);
+        if (!added) {
+            jobs[it->second].duplicate = true;
+            jobs[i].duplicate = true;
+        }
+    }
+
+    // Dependency levels: every asset cooks after all of its dependencies.
+    // Dependencies outside sourceDir are ignored.
+    uint32_t levels = jobs.empty() ? 0 : 1;
+    if (m_dependencies) {
+        std::vector<uint8_t> ordered(jobs.size(), 0);
+        for (const auto& id : m_dependencies->ResolveBuildOrder()) {
+            auto it = byId.find(id);
+            if (it == byId.end()) continue;
+            Job& job = jobs[it->second];
+            ordered[it->second] = 1;
+            for (const auto& depId : m_dependencies->GetDependencies(id)) {
+                auto dep = byId.find(depId);
+                if (dep == byId.end()) continue;
+                job.deps.push_back(dep->second);
+                job.level = std::max(job.level, jobs[dep->second].level + 1);
+            }
+            levels = std::max(levels, job.level + 1);
+        }
+        // Assets on or behind a cycle never appear in the build order
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            if (ordered[i]) continue;
+            for (const auto& depId : m_dependencies->GetDependencies(jobs[i].entry.sourceId)) {
+                if (byId.count(depId)) jobs[i].cyclic = true;
+            }
+        }
+        for (Job& job : jobs) {
+            std::sort(job.deps.begin(), job.deps.end(), [&jobs](size_t a, size_t b) {
+                return jobs[a].entry.sourceId < jobs[b].entry.sourceId;
+            });
+        }
+    }
+
+    CookCache cache;
+    if (m_incremental) cache = LoadCache(CachePath());
+
+    std::mutex progressMutex;
+    uint32_t completed = 0;
+    auto cookOne = [&](Job& job) {
+        auto start = std::chrono::steady_clock::now();
+        CookEntry& entry = job.entry;
+        bool depsOk = !job.cyclic;
+        for (size_t d : job.deps) {
+            if (jobs[d].entry.result != CookResult::Success) depsOk = false;
+        }
+
+        std::vector<uint8_t> source;
+        bool readOk = false;
+        if (job.duplicate) {
+            entry.result = CookResult::DuplicateSource;
+        } else if (!depsOk) {
+            entry.result = CookResult::DependencyFailed;
+        } else {
+            std::ifstream in(entry.sourcePath, std::ios::binary);
+            if (!in.is_open()) {
+                entry.result = std::filesystem::exists(entry.sourcePath)
+                    ? CookResult::CompileError : CookResult::SourceNotFound;
+            } else {
+                source.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+                readOk = true;
+            }
+        }
+
+        if (readOk) {
+            Fnv1a h;
+            h.Bytes(source.data(), source.size());
+            h.U64(kCookerVersion);
+            h.U64(OptionsKey());
+            h.U64(job.flowGraph ? 0x100u + flow::kFlowNativeAbiVersion : 0u);
+            for (size_t d : job.deps) h.U64(jobs[d].entry.cacheKey);
+            entry.cacheKey = h.value;
+
+            auto cached = cache.find(entry.sourceId);
+            std::error_code ec;
+            if (m_incremental && cached != cache.end() && cached->second.key == entry.cacheKey &&
+                std::filesystem::exists(cached->second.outputPath, ec) &&
+                (cached->second.nativePath.empty() ||
+                 std::filesystem::exists(cached->second.nativePath, ec))) {
+                entry.outputPath = cached->second.outputPath;
+                entry.nativePath = cached->second.nativePath;
+                entry.result = CookResult::Success;
+                entry.skipped = true;
+            } else if (job.flowGraph) {
+                CookFlowGraphInto(entry, &source);
+            } else {
+                CookInto(entry, &source);
+            }
+        }
+        entry.cookMs = std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
 
         if (m_progressCb) {
-            m_progressCb(id, i + 1, stats.totalAssets);
+            std::lock_guard<std::mutex> lock(progressMutex);
+            m_progressCb(entry.sourceId, ++completed, stats.totalAssets);
         }
+    };
 
-        CookResult result = CookAsset(id, p.path().string());
-        switch (result) {
+    // One dependency level at a time; assets within a level are independent
+    std::vector<size_t> batch;
+    for (uint32_t level = 0; level < levels; ++level) {
+        batch.clear();
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            if (jobs[i].level == level) batch.push_back(i);
+        }
+        if (m_parallel && batch.size() > 1) {
+            JobSystem::Shared().ParallelFor(batch.size(), [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k) cookOne(jobs[batch[k]]);
+            });
+        } else {
+            for (size_t i : batch) cookOne(jobs[i]);
+        }
+    }
+
+    for (Job& job : jobs) {
+        const CookEntry& entry = job.entry;
+        switch (entry.result) {
             case CookResult::Success:
-                stats.cookedAssets++;
+                if (entry.skipped) stats.skippedAssets++;
+                else stats.cookedAssets++;
+                cache[entry.sourceId] = {entry.cacheKey, entry.outputPath, entry.nativePath};
                 break;
             case CookResult::SourceNotFound:
                 stats.skippedAssets++;
+                cache.erase(entry.sourceId);
                 break;
             default:
                 stats.failedAssets++;
+                cache.erase(entry.sourceId);
                 break;
         }
+        m_cookLog.push_back(std::move(job.entry));
     }
+    if (m_incremental && !jobs.empty()) SaveCache(CachePath(), cache);
 
+    stats.wallMs = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - runStart).count();
+    m_lastStats = stats;
     return stats;
 }
 
+void AssetCooker::SetDependencies(const asset::AssetRegistry* registry) {
+    m_dependencies = registry;
+}
+
+void AssetCooker::SetIncremental(bool incremental) {
+    m_incremental = incremental;
+}
+
+bool AssetCooker::Incremental() const {
+    return m_incremental;
+}
+
+void AssetCooker::SetParallel(bool parallel) {
+    m_parallel = parallel;
+}
+
+bool AssetCooker::Parallel() const {
+    return m_parallel;
+}
+
+const CookStats& AssetCooker::LastStats() const {
+    return m_lastStats;
+}
+
+std::string AssetCooker::LastCookReport() const {
+    std::vector<const CookEntry*> entries;
+    for (size_t i = m_lastRunStart; i < m_cookLog.size(); ++i) entries.push_back(&m_cookLog[i]);
+    // Failures first, then the slowest assets
+    std::stable_sort(entries.begin(), entries.end(), [](const CookEntry* a, const CookEntry* b) {
+        bool fa = a->result != CookResult::Success;
+        bool fb = b->result != CookResult::Success;
+        if (fa != fb) return fa;
+        return a->cookMs > b->cookMs;
+    });
+
+    std::ostringstream ss;
+    char line[256];
+    std::snprintf(line, sizeof(line), "Cooked %u, skipped %u, failed %u of %u assets in %.1f ms\n",
+                  m_lastStats.cookedAssets, m_lastStats.skippedAssets, m_lastStats.failedAssets,
+                  m_lastStats.totalAssets, m_lastStats.wallMs);
+    ss << line;
+    for (const CookEntry* e : entries) {
+        const char* status = e->result != CookResult::Success ? "failed" :
+                             e->skipped ? "skipped" : "cooked";
+        std::snprintf(line, sizeof(line), "  %-8s %9.2f ms  ", status, e->cookMs);
+        ss << line << e->sourceId;
+        if (e->result != CookResult::Success) ss << " (" << ResultName(e->result) << ")";
+        ss << "\n";
+    }
+    return ss.str();
+}
+
 void AssetCooker::SetProgressCallback(ProgressCallback cb) {
     m_progressCb = std::move(cb);
 }
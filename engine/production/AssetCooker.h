@@ -5,20 +5,32 @@
 #include <unordered_map>
 #include <functional>
 
+namespace atlas::asset { class AssetRegistry; }
+
 namespace atlas::production {
 
+// Bumped whenever the cooked format or the cook of any asset type changes;
+// part of every cook cache key.
+constexpr uint32_t kCookerVersion = 2;
+
 enum class CookResult {
     Success,
     SourceNotFound,
     CompileError,
-    WriteError
+    WriteError,
+    DependencyFailed,     // a dependency failed or is part of a cycle
+    DuplicateSource       // another source in the same CookAll has this id
 };
 
 struct CookEntry {
     std::string sourceId;
     std::string sourcePath;
     std::string outputPath;
+    std::string nativePath;   // compiled flow graph library, if one was built
     CookResult result = CookResult::Success;
+    bool skipped = false;     // output was up to date
+    uint64_t cacheKey = 0;    // source, cooker version, options and dependency keys
+    float cookMs = 0.0f;      // wall time spent on this asset
 };
 
 struct CookStats {
@@ -26,6 +38,7 @@ struct CookStats {
     uint32_t cookedAssets = 0;
     uint32_t failedAssets = 0;
     uint32_t skippedAssets = 0;
+    float wallMs = 0.0f;
 };
 
 class AssetCooker {
@@ -38,13 +51,42 @@ public:
     void SetStripEditorData(bool strip);
     bool StripEditorData() const;
 
+    // Compile flow graphs (.flowir) to native libraries next to the cooked IR
+    // with the system compiler (default off)
+    void SetBuildNativeFlowGraphs(bool build);
+    bool BuildNativeFlowGraphs() const;
+
     // Cook a single asset from source path to output
     CookResult CookAsset(const std::string& sourceId, const std::string& sourcePath);
 
-    // Cook all assets from a directory
+    // Cook a flow graph IR file. With native building on, also builds its
+    // native library unless the library's hash sidecar shows it is up to
+    // date. Native build failures are not cook errors: the runtime falls
+    // back to the interpreter.
+    CookResult CookFlowGraph(const std::string& sourceId, const std::string& sourcePath);
+
+    // Cook all assets from a directory. Assets are cooked in dependency
+    // order (see SetDependencies), each dependency level in parallel on
+    // the shared JobSystem. With incremental cooking, assets whose cache
+    // key matches the cook cache and whose output exists are skipped.
+    // An asset's id is its file stem; sources sharing one (e.g. in
+    // different subdirectories) all fail with DuplicateSource.
     CookStats CookAll(const std::string& sourceDir);
 
-    // Set a progress callback
+    // Asset ids in the registry's dependency graph; an asset is recooked
+    // when any of its dependencies is. The registry must outlive CookAll.
+    void SetDependencies(const asset::AssetRegistry* registry);
+
+    // Skip unchanged assets using <outputDir>/.cookcache (default on)
+    void SetIncremental(bool incremental);
+    bool Incremental() const;
+
+    // Cook independent assets on worker threads (default on)
+    void SetParallel(bool parallel);
+    bool Parallel() const;
+
+    // Set a progress callback. During CookAll it may be called from
+    // worker threads, one call at a time.
     void SetProgressCallback(ProgressCallback cb);
 
     // Get the cook log
@@ -53,11 +95,28 @@ public:
     // Clear cook log
     void ClearLog();
 
+    // Statistics and a per-asset timing table for the last CookAll
+    const CookStats& LastStats() const;
+    std::string LastCookReport() const;
+
+    // Path of the persistent cook cache
+    std::string CachePath() const;
+
 private:
+    CookResult CookInto(CookEntry& entry, const std::vector<uint8_t>* source) const;
+    CookResult CookFlowGraphInto(CookEntry& entry, const std::vector<uint8_t>* source) const;
+    uint32_t OptionsKey() const;
+
     std::string m_outputDir = "./build/cooked";
     bool m_stripEditorData = true;
+    bool m_buildNativeFlowGraphs = false;
+    bool m_incremental = true;
+    bool m_parallel = true;
+    const asset::AssetRegistry* m_dependencies = nullptr;
     std::vector<CookEntry> m_cookLog;
     ProgressCallback m_progressCb;
+    CookStats m_lastStats;
+    size_t m_lastRunStart = 0;      // first CookLog entry of the last CookAll
 };
 
 }
@@ -1,4 +1,6 @@
 #include "GamePackager.h"
+#include "../assets/AssetArchive.h"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
@@ -129,16 +131,38 @@ bool GamePackager::BundleOutput(const PackageConfig& config, PackageReport& repo
     std::string dataDir = config.outputDir + "/data";
     std::filesystem::create_directories(dataDir);
 
-    // Move cooked assets to data directory
+    // Move cooked assets to data directory: packed into one archive, or
+    // loose. Files the runtime must open by path (native flow graph
+    // libraries) stay loose either way; the cook cache stays behind.
     std::string cookDir = config.outputDir + "/cooked";
+    asset::AssetArchiveWriter archive;
     if (std::filesystem::exists(cookDir)) {
+        std::vector<std::filesystem::path> files;
         for (const auto& entry : std::filesystem::directory_iterator(cookDir)) {
-            if (entry.is_regular_file()) {
-                std::filesystem::path dest = std::filesystem::path(dataDir) / entry.path().filename();
-                std::filesystem::copy_file(entry.path(), dest,
-                    std::filesystem::copy_options::overwrite_existing);
+            if (entry.is_regular_file() && entry.path().filename() != ".cookcache") {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        for (const auto& file : files) {
+            if (config.packArchive && file.extension() == ".atlasb") {
+                if (!archive.AddFile(file.stem().string(), file.string(), config.compressArchive)) {
+                    report.errorMessage = "Failed to pack " + file.string();
+                    return false;
+                }
+                continue;
             }
+            std::filesystem::path dest = std::filesystem::path(dataDir) / file.filename();
+            std::filesystem::copy_file(file, dest, std::filesystem::copy_options::overwrite_existing);
+        }
+    }
+    if (config.packArchive) {
+        std::string archivePath = dataDir + "/assets.atlaspak";
+        if (!archive.Write(archivePath)) {
+            report.errorMessage = "Failed to write " + archivePath;
+            return false;
         }
+        report.outputFiles.push_back(archivePath);
     }
 
     return true;
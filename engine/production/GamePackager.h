@@ -31,6 +31,8 @@ struct PackageConfig {
     bool includeMods = false;
     bool stripEditorData = true;
     bool singleExecutable = false;
+    bool packArchive = true;        // cooked assets go into data/assets.atlaspak
+    bool compressArchive = false;   // LZ-compress archive entries that shrink
 };
 
 struct PackageReport {
@@ -1,4 +1,5 @@
 #include "AtlasShaderIR.h"
+#include <cstddef>
 #include <cstring>
 
 namespace atlas::render {
@@ -1,10 +1,11 @@
 #include "JobTracer.h"
-#include <chrono>
+#include "../core/Profiler.h"
 #include <functional>
 
 namespace atlas::sim {
 
 void JobTracer::BeginTick(uint64_t tick) {
+    CloseProfileScope();
     m_current = TickTrace{};
     m_current.tick = tick;
     m_currentOrder = 0;
@@ -15,11 +16,17 @@ void JobTracer::BeginTick(uint64_t tick) {
 void JobTracer::RecordSystemStart(const std::string& systemName) {
     if (!m_inTick) return;
     m_inSystem = true;
+    CloseProfileScope();
 
-    auto now = std::chrono::steady_clock::now();
-    m_systemStartTime = static_cast<double>(
-        std::chrono::duration_cast<std::chrono::microseconds>(
-            now.time_since_epoch()).count());
+    m_systemStartTicks = profile::Now();
+    m_systemStartTime = profile::TicksToMicroseconds(m_systemStartTicks);
+
+    // Mirror the system into the CPU profiler so it shows up in
+    // captured traces alongside nested scopes
+    if (profile::Profiler::Enabled()) {
+        m_systemProfileName = profile::Profiler::Get().Intern(systemName);
+        m_systemProfileDepth = profile::Profiler::EnterScope();
+    }
 
     JobTraceEntry entry;
     entry.systemName = systemName;
@@ -33,12 +40,9 @@ void JobTracer::RecordSystemEnd() {
     if (!m_inTick || !m_inSystem || m_current.entries.empty()) return;
     m_inSystem = false;
 
-    auto now = std::chrono::steady_clock::now();
-    double endTime = static_cast<double>(
-        std::chrono::duration_cast<std::chrono::microseconds>(
-            now.time_since_epoch()).count());
-
-    m_current.entries.back().durationUs = endTime - m_systemStartTime;
+    CloseProfileScope();
+    m_current.entries.back().durationUs =
+        profile::TicksToMicroseconds(profile::Now() - m_systemStartTicks);
     m_currentOrder++;
 }
 
@@ -114,7 +118,14 @@ size_t JobTracer::MaxHistory() const {
     return m_maxHistory;
 }
 
+void JobTracer::CloseProfileScope() {
+    if (!m_systemProfileName) return;
+    profile::Profiler::LeaveScope(m_systemProfileName, m_systemStartTicks, m_systemProfileDepth);
+    m_systemProfileName = nullptr;
+}
+
 void JobTracer::Clear() {
+    CloseProfileScope();
     m_history.clear();
     m_current = TickTrace{};
     m_currentOrder = 0;
@@ -24,6 +24,8 @@ struct TickTrace {
 /// Records system execution order and timing each tick.
 /// Used for determinism verification: if two runs produce different
 /// orderHash values for the same tick, execution is non-deterministic.
+/// While the CPU profiler is enabled each system is also recorded as
+/// a profile event (see core/Profiler.h).
 class JobTracer {
 public:
     /// Start recording a new tick.
@@ -59,6 +61,8 @@ public:
     void Clear();
 
 private:
+    void CloseProfileScope();
+
     std::vector<TickTrace> m_history;
     TickTrace m_current;
     uint32_t m_currentOrder = 0;
@@ -66,6 +70,9 @@ private:
     bool m_inSystem = false;
     size_t m_maxHistory = 120;
     double m_systemStartTime = 0.0;
+    uint64_t m_systemStartTicks = 0;
+    const char* m_systemProfileName = nullptr;   ///< Set while a profiler scope is open
+    uint16_t m_systemProfileDepth = 0;
 };
 
 }  // namespace atlas::sim
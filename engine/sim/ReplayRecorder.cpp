@@ -1,19 +1,354 @@
 #include "ReplayRecorder.h"
+#include "StateHasher.h"
+#include "../assets/AssetArchive.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace atlas::sim {
 
+namespace {
+
+constexpr uint64_t kStreamStart = sizeof(ReplayHeader) + sizeof(ReplayStreamInfo);
+
+uint64_t HashBlock(const uint8_t* data, size_t size) {
+    return StateHasher::HashCombine(0, data, size);
+}
+
+// Frame layout inside a block: tick, input size, input, state hash.
+// Save points live in the file's save-point list instead, so they can
+// be marked after their block was written.
+void AppendFrame(std::vector<uint8_t>& out, const ReplayFrame& frame) {
+    uint32_t dataSize = static_cast<uint32_t>(frame.inputData.size());
+    size_t pos = out.size();
+    out.resize(pos + 8 + dataSize + 8);
+    std::memcpy(out.data() + pos, &frame.tick, 4);
+    std::memcpy(out.data() + pos + 4, &dataSize, 4);
+    if (dataSize > 0) std::memcpy(out.data() + pos + 8, frame.inputData.data(), dataSize);
+    std::memcpy(out.data() + pos + 8 + dataSize, &frame.stateHash, 8);
+}
+
+void InsertSavePoint(std::vector<uint32_t>& savePoints, uint32_t tick) {
+    auto it = std::lower_bound(savePoints.begin(), savePoints.end(), tick);
+    if (it == savePoints.end() || *it != tick) savePoints.insert(it, tick);
+}
+
+void MarkFrames(std::vector<ReplayFrame>& frames, uint32_t tick) {
+    for (auto& frame : frames) {
+        if (frame.tick == tick) frame.isSavePoint = true;
+    }
+}
+
+template <typename T>
+void WritePod(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}
+
+// --- v4 writer ---
+
+struct ReplayRecorder::Stream {
+    std::string path;
+    std::ofstream file;
+    ReplayStreamInfo info;
+    bool hasBase = false;
+    uint32_t pendingWindow = 0;     // window of the block being filled
+    uint64_t offset = kStreamStart;
+    uint32_t framesWritten = 0;
+    std::vector<ReplayIndexEntry> index;
+    std::vector<uint8_t> raw;
+
+    bool Open(const std::string& p, const ReplayHeader& header, uint32_t blockTicks) {
+        path = p;
+        info.blockTicks = blockTicks > 0 ? blockTicks : REPLAY_DEFAULT_BLOCK_TICKS;
+        file.open(p, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        ReplayHeader h = header;
+        h.version = REPLAY_FORMAT_VERSION;
+        h.frameCount = 0;
+        WritePod(file, h);
+        WritePod(file, info);
+        return file.good();
+    }
+
+    // Frames of one window, in recording order
+    bool WriteBlock(const std::vector<ReplayFrame>& frames) {
+        if (frames.empty()) return true;
+        uint32_t window = frames.front().tick / info.blockTicks;
+        if (!hasBase) {
+            hasBase = true;
+            info.baseTick = window * info.blockTicks;
+        }
+        uint32_t baseWindow = info.baseTick / info.blockTicks;
+        size_t slot = window >= baseWindow ? window - baseWindow : 0;
+        // A block whose ticks went backwards goes after the last one
+        slot = std::max(slot, index.size());
+        index.resize(slot, ReplayIndexEntry{0, framesWritten, 0});
+
+        raw.clear();
+        for (const auto& frame : frames) AppendFrame(raw, frame);
+        std::vector<uint8_t> packed = asset::LzCompress(raw.data(), raw.size());
+
+        ReplayBlockHeader block;
+        block.firstTick = frames.front().tick;
+        block.frameCount = static_cast<uint32_t>(frames.size());
+        block.rawSize = static_cast<uint32_t>(raw.size());
+        block.compression = packed.empty() ? ReplayCompression::None : ReplayCompression::LZ;
+        block.storedSize = static_cast<uint32_t>(packed.empty() ? raw.size() : packed.size());
+        block.contentHash = HashBlock(raw.data(), raw.size());
+        WritePod(file, block);
+        const std::vector<uint8_t>& stored = packed.empty() ? raw : packed;
+        file.write(reinterpret_cast<const char*>(stored.data()), static_cast<std::streamsize>(stored.size()));
+
+        index.push_back({offset, framesWritten, block.frameCount});
+        offset += sizeof(block) + block.storedSize;
+        framesWritten += block.frameCount;
+        return file.good();
+    }
+
+    bool Finish(ReplayHeader header, uint32_t lastTick, const std::vector<uint32_t>& savePoints) {
+        // The index is read in place from the mapping, so align it
+        static const char zeros[alignof(ReplayIndexEntry)] = {};
+        uint64_t pad = (alignof(ReplayIndexEntry) - offset % alignof(ReplayIndexEntry)) % alignof(ReplayIndexEntry);
+        file.write(zeros, static_cast<std::streamsize>(pad));
+
+        ReplayFooter footer;
+        footer.indexOffset = offset + pad;
+        footer.blockCount = static_cast<uint32_t>(index.size());
+        footer.savePointCount = static_cast<uint32_t>(savePoints.size());
+        footer.lastTick = lastTick;
+        file.write(reinterpret_cast<const char*>(index.data()),
+                   static_cast<std::streamsize>(index.size() * sizeof(ReplayIndexEntry)));
+        file.write(reinterpret_cast<const char*>(savePoints.data()),
+                   static_cast<std::streamsize>(savePoints.size() * sizeof(uint32_t)));
+        WritePod(file, footer);
+
+        header.version = REPLAY_FORMAT_VERSION;
+        header.frameCount = framesWritten;
+        file.seekp(0);
+        WritePod(file, header);
+        WritePod(file, info);
+        bool ok = file.good();
+        file.close();
+        return ok && !file.fail();
+    }
+};
+
+// --- v4 reader ---
+
+struct ReplayRecorder::File {
+    std::string path;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::vector<uint8_t> buffer;       // when the file could not be mapped
+
+    ReplayStreamInfo info;
+    const ReplayIndexEntry* index = nullptr;
+    uint32_t blockCount = 0;
+    uint32_t lastTick = 0;
+    std::vector<ReplayIndexEntry> recoveredIndex;
+
+    // Last block FrameAtTick decoded
+    int64_t cachedBlock = -1;
+    std::vector<ReplayFrame> cache;
+    std::vector<uint8_t> scratch;
+    bool materialized = false;         // Frames() has decoded everything
+
+    ~File() {
+#if !defined(_WIN32)
+        if (mapped && data) ::munmap(const_cast<uint8_t*>(data), size);
+#endif
+    }
+
+    bool Map(const std::string& p) {
+#if !defined(_WIN32)
+        int fd = ::open(p.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* m = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                data = static_cast<const uint8_t*>(m);
+                size = static_cast<size_t>(st.st_size);
+                mapped = true;
+            }
+        }
+        ::close(fd);
+#endif
+        if (!data) {
+            std::ifstream in(p, std::ios::binary);
+            if (!in.is_open()) return false;
+            buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            data = buffer.data();
+            size = buffer.size();
+        }
+        path = p;
+        return true;
+    }
+
+    bool Parse(ReplayHeader& header, std::vector<uint32_t>& savePoints) {
+        if (size < kStreamStart) return false;
+        std::memcpy(&header, data, sizeof(header));
+        std::memcpy(&info, data + sizeof(header), sizeof(info));
+        if (header.magic != REPLAY_MAGIC || header.version != REPLAY_FORMAT_VERSION ||
+            info.blockTicks == 0) {
+            return false;
+        }
+
+        ReplayFooter footer;
+        if (size >= kStreamStart + sizeof(footer)) {
+            std::memcpy(&footer, data + size - sizeof(footer), sizeof(footer));
+            uint64_t tableEnd = size - sizeof(footer);
+            uint64_t tableSize = static_cast<uint64_t>(footer.blockCount) * sizeof(ReplayIndexEntry) +
+                                 static_cast<uint64_t>(footer.savePointCount) * sizeof(uint32_t);
+            if (footer.magic == ReplayFooter{}.magic &&
+                footer.indexOffset >= kStreamStart && footer.indexOffset <= tableEnd &&
+                footer.indexOffset % alignof(ReplayIndexEntry) == 0 &&
+                tableSize == tableEnd - footer.indexOffset) {
+                index = reinterpret_cast<const ReplayIndexEntry*>(data + footer.indexOffset);
+                blockCount = footer.blockCount;
+                lastTick = footer.lastTick;
+                savePoints.resize(footer.savePointCount);
+                if (!savePoints.empty()) {
+                    std::memcpy(savePoints.data(),
+                                data + footer.indexOffset + footer.blockCount * sizeof(ReplayIndexEntry),
+                                savePoints.size() * sizeof(uint32_t));
+                }
+                return true;
+            }
+        }
+        return Recover(header);
+    }
+
+    // Recording stopped without writing the index: rebuild it from
+    // the block headers, dropping a block that was cut short
+    bool Recover(ReplayHeader& header) {
+        uint64_t pos = kStreamStart;
+        uint32_t frames = 0;
+        bool hasBase = false;
+        while (pos + sizeof(ReplayBlockHeader) <= size) {
+            ReplayBlockHeader block;
+            std::memcpy(&block, data + pos, sizeof(block));
+            if (block.magic != ReplayBlockHeader{}.magic ||
+                block.storedSize > size - pos - sizeof(block)) {
+                break;
+            }
+            uint32_t window = block.firstTick / info.blockTicks;
+            if (!hasBase) {
+                hasBase = true;
+                info.baseTick = window * info.blockTicks;
+            }
+            uint32_t baseWindow = info.baseTick / info.blockTicks;
+            size_t slot = window >= baseWindow ? window - baseWindow : 0;
+            slot = std::max(slot, recoveredIndex.size());
+            recoveredIndex.resize(slot, ReplayIndexEntry{0, frames, 0});
+            recoveredIndex.push_back({pos, frames, block.frameCount});
+            frames += block.frameCount;
+            pos += sizeof(block) + block.storedSize;
+        }
+        index = recoveredIndex.data();
+        blockCount = static_cast<uint32_t>(recoveredIndex.size());
+        header.frameCount = frames;
+        if (blockCount > 0) {
+            std::vector<ReplayFrame> last;
+            if (!Decode(blockCount - 1, {}, last)) return false;
+            for (const auto& frame : last) lastTick = std::max(lastTick, frame.tick);
+        }
+        return true;
+    }
+
+    int64_t BlockOf(uint32_t tick) const {
+        if (tick < info.baseTick) return -1;
+        uint64_t block = (tick - info.baseTick) / info.blockTicks;
+        return block < blockCount ? static_cast<int64_t>(block) : -1;
+    }
+
+    bool Decode(uint32_t block, const std::vector<uint32_t>& savePoints, std::vector<ReplayFrame>& out) {
+        out.clear();
+        const ReplayIndexEntry& entry = index[block];
+        if (entry.frameCount == 0) return true;
+        if (entry.offset > size || size - entry.offset < sizeof(ReplayBlockHeader)) return false;
+
+        ReplayBlockHeader header;
+        std::memcpy(&header, data + entry.offset, sizeof(header));
+        if (header.magic != ReplayBlockHeader{}.magic || header.frameCount != entry.frameCount ||
+            header.storedSize > size - entry.offset - sizeof(header)) {
+            return false;
+        }
+        const uint8_t* stored = data + entry.offset + sizeof(header);
+        const uint8_t* raw = stored;
+        if (header.compression == ReplayCompression::LZ) {
+            scratch.resize(header.rawSize);
+            if (!asset::LzDecompress(stored, header.storedSize, scratch.data(), scratch.size())) return false;
+            raw = scratch.data();
+        } else if (header.compression != ReplayCompression::None || header.storedSize != header.rawSize) {
+            return false;
+        }
+        if (HashBlock(raw, header.rawSize) != header.contentHash) return false;
+
+        size_t pos = 0;
+        out.reserve(header.frameCount);
+        for (uint32_t i = 0; i < header.frameCount; ++i) {
+            if (header.rawSize - pos < 8) return false;
+            ReplayFrame frame;
+            uint32_t dataSize = 0;
+            std::memcpy(&frame.tick, raw + pos, 4);
+            std::memcpy(&dataSize, raw + pos + 4, 4);
+            pos += 8;
+            if (dataSize > header.rawSize - pos || header.rawSize - pos - dataSize < 8) return false;
+            frame.inputData.assign(raw + pos, raw + pos + dataSize);
+            pos += dataSize;
+            std::memcpy(&frame.stateHash, raw + pos, 8);
+            pos += 8;
+            frame.isSavePoint = std::binary_search(savePoints.begin(), savePoints.end(), frame.tick);
+            out.push_back(std::move(frame));
+        }
+        return pos == header.rawSize;
+    }
+};
+
+// --- ReplayRecorder ---
+
+ReplayRecorder::ReplayRecorder() = default;
+ReplayRecorder::ReplayRecorder(ReplayRecorder&&) noexcept = default;
+ReplayRecorder& ReplayRecorder::operator=(ReplayRecorder&&) noexcept = default;
+
+ReplayRecorder::~ReplayRecorder() {
+    // Leave a file being recorded complete
+    if (m_stream) FinishStream();
+}
+
 void ReplayRecorder::StartRecording(uint32_t tickRate, uint32_t seed) {
-    m_frames.clear();
-    m_header = ReplayHeader{};
+    Clear();
+    m_header.tickRate = tickRate;
+    m_header.seed = seed;
+    m_state = ReplayState::Recording;
+}
+
+bool ReplayRecorder::StartRecordingToFile(const std::string& path, uint32_t tickRate, uint32_t seed,
+                                          uint32_t blockTicks) {
+    Clear();
     m_header.tickRate = tickRate;
     m_header.seed = seed;
+    auto stream = std::make_unique<Stream>();
+    if (!stream->Open(path, m_header, blockTicks)) return false;
+    m_stream = std::move(stream);
     m_state = ReplayState::Recording;
+    return true;
 }
 
 void ReplayRecorder::StartFromSave(uint32_t saveTick, uint32_t tickRate, uint32_t seed) {
-    m_frames.clear();
-    m_header = ReplayHeader{};
+    Clear();
     m_header.tickRate = tickRate;
     m_header.seed = seed;
     m_state = ReplayState::Recording;
@@ -35,15 +370,62 @@ void ReplayRecorder::RecordFrame(uint32_t tick, const std::vector<uint8_t>& inpu
     frame.tick = tick;
     frame.inputData = inputData;
     frame.stateHash = stateHash;
+
+    if (m_stream) {
+        // Write the pending block once a tick lands in a later window
+        uint32_t window = tick / m_stream->info.blockTicks;
+        if (!m_frames.empty() && window > m_stream->pendingWindow) FlushPendingBlock();
+        if (m_frames.empty()) m_stream->pendingWindow = window;
+        m_lastTick = m_header.frameCount == 0 ? tick : std::max(m_lastTick, tick);
+        m_frames.push_back(std::move(frame));
+        m_header.frameCount++;
+        return;
+    }
+
     m_frames.push_back(std::move(frame));
     m_header.frameCount = static_cast<uint32_t>(m_frames.size());
 }
 
 void ReplayRecorder::StopRecording() {
+    if (m_stream) {
+        std::string path = m_stream->path;
+        FinishStream();
+        OpenFile(path);
+    }
     m_state = ReplayState::Idle;
 }
 
+void ReplayRecorder::FlushPendingBlock() {
+    if (!m_stream || m_frames.empty()) return;
+    m_stream->WriteBlock(m_frames);
+    m_frames.clear();
+}
+
+void ReplayRecorder::FinishStream() {
+    FlushPendingBlock();
+    m_stream->Finish(m_header, m_lastTick, m_savePoints);
+    m_stream.reset();
+}
+
 void ReplayRecorder::MarkSavePoint(uint32_t tick) {
+    if (m_stream) {
+        bool pending = std::any_of(m_frames.begin(), m_frames.end(),
+                                   [tick](const ReplayFrame& f) { return f.tick == tick; });
+        bool written = m_stream->hasBase && tick >= m_stream->info.baseTick && tick <= m_lastTick;
+        if (!pending && !written) return;
+        InsertSavePoint(m_savePoints, tick);
+        MarkFrames(m_frames, tick);
+        return;
+    }
+
+    if (m_file) {
+        if (!FrameAtTick(tick)) return;
+        InsertSavePoint(m_savePoints, tick);
+        MarkFrames(m_file->cache, tick);
+        MarkFrames(m_frames, tick);
+        return;
+    }
+
     for (auto& frame : m_frames) {
         if (frame.tick == tick) {
             frame.isSavePoint = true;
@@ -53,6 +435,8 @@ void ReplayRecorder::MarkSavePoint(uint32_t tick) {
 }
 
 std::vector<uint32_t> ReplayRecorder::SavePoints() const {
+    if (m_stream || m_file) return m_savePoints;
+
     std::vector<uint32_t> result;
     for (const auto& frame : m_frames) {
         if (frame.isSavePoint) {
@@ -62,14 +446,37 @@ std::vector<uint32_t> ReplayRecorder::SavePoints() const {
     return result;
 }
 
+bool ReplayRecorder::OpenFile(const std::string& path) {
+    auto file = std::make_unique<File>();
+    ReplayHeader header;
+    std::vector<uint32_t> savePoints;
+    if (!file->Map(path) || !file->Parse(header, savePoints)) return false;
+    m_header = header;
+    m_savePoints = std::move(savePoints);
+    m_lastTick = file->lastTick;
+    m_frames.clear();
+    m_file = std::move(file);
+    return true;
+}
+
 bool ReplayRecorder::LoadReplay(const std::string& path) {
+    Clear();
     std::ifstream file(path, std::ios::binary);
     if (!file.is_open()) return false;
 
     ReplayHeader header;
     file.read(reinterpret_cast<char*>(&header), sizeof(header));
-    if (header.magic != 0x52504C59) return false;
+    if (!file || header.magic != REPLAY_MAGIC) return false;
+    if (header.version > REPLAY_FORMAT_VERSION) return false;
+
+    if (header.version == REPLAY_FORMAT_VERSION) {
+        file.close();
+        if (!OpenFile(path)) return false;
+        m_state = ReplayState::Playing;
+        return true;
+    }
 
+    // v1-v3: every frame inline
     m_header = header;
     m_frames.clear();
     m_frames.reserve(header.frameCount);
@@ -98,13 +505,54 @@ bool ReplayRecorder::LoadReplay(const std::string& path) {
     return true;
 }
 
-bool ReplayRecorder::SaveReplay(const std::string& path) const {
+bool ReplayRecorder::SaveReplay(const std::string& path, uint32_t formatVersion) const {
+    // A file still being recorded is complete only after StopRecording
+    if (m_stream) return false;
+
+    if (formatVersion == REPLAY_FORMAT_VERSION) {
+        // Through a temp file: the replay may be playing from `path`
+        std::string tmp = path + ".tmp";
+        Stream out;
+        if (!out.Open(tmp, m_header, BlockTicks())) return false;
+
+        bool ok = true;
+        bool any = false;
+        uint32_t lastTick = 0;
+        std::vector<ReplayFrame> block;
+        ForEachFrame(0, [&](const ReplayFrame& frame) {
+            uint32_t window = frame.tick / out.info.blockTicks;
+            if (!block.empty() && window > out.pendingWindow) {
+                ok = out.WriteBlock(block) && ok;
+                block.clear();
+            }
+            if (block.empty()) out.pendingWindow = window;
+            block.push_back(frame);
+            lastTick = any ? std::max(lastTick, frame.tick) : frame.tick;
+            any = true;
+        });
+        if (!block.empty()) ok = out.WriteBlock(block) && ok;
+        ok = out.Finish(m_header, lastTick, SavePoints()) && ok;
+
+        std::error_code ec;
+        if (ok) std::filesystem::rename(tmp, path, ec);
+        if (!ok || ec) {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    if (formatVersion != 3) return false;
+
     std::ofstream file(path, std::ios::binary);
     if (!file.is_open()) return false;
 
-    file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    ReplayHeader header = m_header;
+    header.version = 3;
+    header.frameCount = static_cast<uint32_t>(FrameCount());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
 
-    for (const auto& frame : m_frames) {
+    ForEachFrame(0, [&file](const ReplayFrame& frame) {
         file.write(reinterpret_cast<const char*>(&frame.tick), sizeof(frame.tick));
         uint32_t dataSize = static_cast<uint32_t>(frame.inputData.size());
         file.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
@@ -114,18 +562,60 @@ bool ReplayRecorder::SaveReplay(const std::string& path) const {
         file.write(reinterpret_cast<const char*>(&frame.stateHash), sizeof(frame.stateHash));
         uint8_t sp = frame.isSavePoint ? 1 : 0;
         file.write(reinterpret_cast<const char*>(&sp), sizeof(sp));
-    }
+    });
 
-    return true;
+    return file.good();
 }
 
 const ReplayFrame* ReplayRecorder::FrameAtTick(uint32_t tick) const {
+    if (m_file) {
+        int64_t block = m_file->BlockOf(tick);
+        if (block < 0) return nullptr;
+        if (m_file->cachedBlock != block) {
+            m_file->cachedBlock = -1;
+            if (!m_file->Decode(static_cast<uint32_t>(block), m_savePoints, m_file->cache)) return nullptr;
+            m_file->cachedBlock = block;
+        }
+        auto& cache = m_file->cache;
+        if (cache.empty()) return nullptr;
+        // One frame per tick is the common case
+        uint32_t slot = tick - std::min(tick, cache.front().tick);
+        if (slot < cache.size() && cache[slot].tick == tick) return &cache[slot];
+        for (const auto& frame : cache) {
+            if (frame.tick == tick) return &frame;
+        }
+        return nullptr;
+    }
+
     for (const auto& frame : m_frames) {
         if (frame.tick == tick) return &frame;
     }
     return nullptr;
 }
 
+void ReplayRecorder::ForEachFrame(uint32_t fromTick,
+                                  const std::function<void(const ReplayFrame&)>& fn) const {
+    if (m_file) {
+        if (m_file->blockCount == 0) return;
+        uint32_t first = 0;
+        if (fromTick > m_file->info.baseTick) {
+            first = (fromTick - m_file->info.baseTick) / m_file->info.blockTicks;
+        }
+        std::vector<ReplayFrame> block;
+        for (uint32_t b = first; b < m_file->blockCount; ++b) {
+            if (!m_file->Decode(b, m_savePoints, block)) return;
+            for (const auto& frame : block) {
+                if (frame.tick >= fromTick) fn(frame);
+            }
+        }
+        return;
+    }
+
+    for (const auto& frame : m_frames) {
+        if (frame.tick >= fromTick) fn(frame);
+    }
+}
+
 ReplayState ReplayRecorder::State() const {
     return m_state;
 }
@@ -135,22 +625,47 @@ const ReplayHeader& ReplayRecorder::Header() const {
 }
 
 const std::vector<ReplayFrame>& ReplayRecorder::Frames() const {
+    if (m_file && !m_file->materialized) {
+        m_frames.clear();
+        m_frames.reserve(m_header.frameCount);
+        ForEachFrame(0, [this](const ReplayFrame& frame) { m_frames.push_back(frame); });
+        m_file->materialized = true;
+    }
     return m_frames;
 }
 
 size_t ReplayRecorder::FrameCount() const {
+    if (m_stream || m_file) return m_header.frameCount;
     return m_frames.size();
 }
 
 uint32_t ReplayRecorder::DurationTicks() const {
+    if (m_stream || m_file) return m_header.frameCount > 0 ? m_lastTick : 0;
     if (m_frames.empty()) return 0;
     return m_frames.back().tick;
 }
 
+const std::string& ReplayRecorder::FilePath() const {
+    static const std::string kNone;
+    if (m_stream) return m_stream->path;
+    if (m_file) return m_file->path;
+    return kNone;
+}
+
+uint32_t ReplayRecorder::BlockTicks() const {
+    if (m_stream) return m_stream->info.blockTicks;
+    if (m_file) return m_file->info.blockTicks;
+    return REPLAY_DEFAULT_BLOCK_TICKS;
+}
+
 void ReplayRecorder::Clear() {
+    if (m_stream) FinishStream();
+    m_file.reset();
     m_state = ReplayState::Idle;
     m_header = ReplayHeader{};
     m_frames.clear();
+    m_savePoints.clear();
+    m_lastTick = 0;
 }
 
 }
@@ -2,9 +2,40 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <functional>
+#include <memory>
 
 namespace atlas::sim {
 
+// ============================================================
+// Replay files (.rply)
+// ============================================================
+//
+// v4 (written by default) stores frames in blocks, one per window of
+// `blockTicks` ticks, so a replay can be recorded straight to disk
+// and read back a block at a time:
+//
+//   ReplayHeader (20 bytes)      frameCount patched when recording stops
+//   ReplayStreamInfo (16 bytes)
+//   blocks                       ReplayBlockHeader + frame data, LZ
+//                                compressed when that is smaller
+//   ReplayIndexEntry[blockCount] one per window from baseTick, empty
+//                                windows included
+//   uint32_t[savePointCount]     save-point ticks, ascending
+//   ReplayFooter (24 bytes)
+//
+// The window holding a tick is (tick - baseTick) / blockTicks, so a
+// seek reads one index entry and decodes one block. The reader maps
+// the file; a file whose recording never stopped (no footer) is
+// recovered by scanning its blocks, without save points.
+//
+// v1-v3 files hold every frame inline after the header and still
+// load; SaveReplay can write v3 for older tools.
+
+constexpr uint32_t REPLAY_MAGIC = 0x52504C59;          // "RPLY"
+constexpr uint32_t REPLAY_FORMAT_VERSION = 4;
+constexpr uint32_t REPLAY_DEFAULT_BLOCK_TICKS = 256;
+
 struct ReplayFrame {
     uint32_t tick = 0;
     std::vector<uint8_t> inputData;
@@ -13,12 +44,53 @@ struct ReplayFrame {
 };
 
 struct ReplayHeader {
-    uint32_t magic = 0x52504C59;  // "RPLY"
-    uint32_t version = 3;         // v3: added isSavePoint per frame
+    uint32_t magic = REPLAY_MAGIC;
+    uint32_t version = REPLAY_FORMAT_VERSION;  // v3: isSavePoint per frame, v4: blocks + index
     uint32_t tickRate = 30;
     uint32_t frameCount = 0;
     uint32_t seed = 0;
 };
+static_assert(sizeof(ReplayHeader) == 20, "replay header layout");
+
+enum class ReplayCompression : uint8_t {
+    None = 0,
+    LZ = 1          // asset::LzCompress block
+};
+
+struct ReplayStreamInfo {
+    uint32_t blockTicks = REPLAY_DEFAULT_BLOCK_TICKS;
+    uint32_t baseTick = 0;      // first tick of window 0
+    uint32_t reserved[2] = {};
+};
+static_assert(sizeof(ReplayStreamInfo) == 16, "replay stream info layout");
+
+struct ReplayBlockHeader {
+    uint32_t magic = 0x4B4C4252;    // "RBLK"
+    uint32_t firstTick = 0;
+    uint32_t frameCount = 0;
+    uint32_t rawSize = 0;
+    uint32_t storedSize = 0;
+    ReplayCompression compression = ReplayCompression::None;
+    uint8_t reserved[3] = {};
+    uint64_t contentHash = 0;       // of the raw frame data
+};
+static_assert(sizeof(ReplayBlockHeader) == 32, "replay block header layout");
+
+struct ReplayIndexEntry {
+    uint64_t offset = 0;            // of the ReplayBlockHeader; 0 = empty window
+    uint32_t firstFrame = 0;        // frames in earlier blocks
+    uint32_t frameCount = 0;
+};
+static_assert(sizeof(ReplayIndexEntry) == 16, "replay index entry layout");
+
+struct ReplayFooter {
+    uint64_t indexOffset = 0;
+    uint32_t blockCount = 0;
+    uint32_t savePointCount = 0;
+    uint32_t lastTick = 0;
+    uint32_t magic = 0x58444952;    // "RIDX"
+};
+static_assert(sizeof(ReplayFooter) == 24, "replay footer layout");
 
 enum class ReplayState {
     Idle,
@@ -28,17 +100,36 @@ enum class ReplayState {
 
 class ReplayRecorder {
 public:
+    ReplayRecorder();
+    ~ReplayRecorder();
+    ReplayRecorder(ReplayRecorder&&) noexcept;
+    ReplayRecorder& operator=(ReplayRecorder&&) noexcept;
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
     // Recording
     void StartRecording(uint32_t tickRate, uint32_t seed = 0);
+    /// Record straight to a v4 file: only the block being filled stays
+    /// in memory. Ticks are expected to increase. StopRecording writes
+    /// the index and reopens the file for reading.
+    bool StartRecordingToFile(const std::string& path, uint32_t tickRate, uint32_t seed = 0,
+                              uint32_t blockTicks = REPLAY_DEFAULT_BLOCK_TICKS);
     void StartFromSave(uint32_t saveTick, uint32_t tickRate, uint32_t seed);
     void RecordFrame(uint32_t tick, const std::vector<uint8_t>& inputData);
     void RecordFrame(uint32_t tick, const std::vector<uint8_t>& inputData, uint64_t stateHash);
     void StopRecording();
 
     // Playback
+    /// v4 files are mapped and decoded a block at a time; older
+    /// versions are read into memory.
     bool LoadReplay(const std::string& path);
-    bool SaveReplay(const std::string& path) const;
+    bool SaveReplay(const std::string& path, uint32_t formatVersion = REPLAY_FORMAT_VERSION) const;
+    /// The frame at `tick`. For a v4 file the pointer refers to the
+    /// decoded block and stays valid until a tick in another block is
+    /// requested.
     const ReplayFrame* FrameAtTick(uint32_t tick) const;
+    /// Visit frames in order from `fromTick`, decoding one block at a time.
+    void ForEachFrame(uint32_t fromTick, const std::function<void(const ReplayFrame&)>& fn) const;
 
     // Save-point markers
     void MarkSavePoint(uint32_t tick);
@@ -47,17 +138,36 @@ public:
     // Query
     ReplayState State() const;
     const ReplayHeader& Header() const;
+    /// Every frame. A v4 file is decoded in full on first call; while
+    /// recording to a file only the unwritten block is held.
     const std::vector<ReplayFrame>& Frames() const;
     size_t FrameCount() const;
     uint32_t DurationTicks() const;
+    /// Path of the v4 file being recorded or played, empty otherwise.
+    const std::string& FilePath() const;
+    /// Block size in ticks of the v4 file being recorded or played.
+    uint32_t BlockTicks() const;
 
     // Reset
     void Clear();
 
 private:
+    struct Stream;
+    struct File;
+
+    bool OpenFile(const std::string& path);
+    void FlushPendingBlock();
+    void FinishStream();
+
     ReplayState m_state = ReplayState::Idle;
     ReplayHeader m_header;
-    std::vector<ReplayFrame> m_frames;
+    // In-memory replay; the block being filled while recording to a
+    // file; or a full decode of a v4 file once Frames() is called
+    mutable std::vector<ReplayFrame> m_frames;
+    std::vector<uint32_t> m_savePoints;   // ascending, v4 file or stream only
+    uint32_t m_lastTick = 0;
+    std::unique_ptr<Stream> m_stream;
+    std::unique_ptr<File> m_file;
 };
 
 }
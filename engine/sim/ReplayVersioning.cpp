@@ -126,6 +126,7 @@ void ReplayVersionRegistry::RegisterDefaults() {
     RegisterVersion({1, "Initial replay format (input frames only)", true});
     RegisterVersion({2, "Added state hash per frame", true});
     RegisterVersion({3, "Added save-point markers per frame", false});
+    RegisterVersion({4, "Block-compressed frames with seek index", false});
 
     // v1 → v2: Add zero hash field to each frame.
     RegisterMigration({1, 2, "Add stateHash field (zero-initialized)",
@@ -148,6 +149,13 @@ void ReplayVersionRegistry::RegisterDefaults() {
             }
             return true;
         }});
+
+    // v3 → v4: Frames are regrouped into blocks by the container; the
+    // fields of each frame are unchanged.
+    RegisterMigration({3, 4, "Group frames into indexed blocks",
+        [](std::vector<uint8_t>&, std::vector<std::vector<uint8_t>>&) -> bool {
+            return true;
+        }});
 }
 
 void ReplayVersionRegistry::Clear() {
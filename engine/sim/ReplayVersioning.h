@@ -101,7 +101,7 @@ public:
     void Clear();
 
 private:
-    uint32_t m_currentVersion = 3;
+    uint32_t m_currentVersion = 4;
     uint32_t m_minimumVersion = 1;
     std::vector<ReplayVersionInfo> m_versions;
     std::vector<ReplayMigrationStep> m_migrations;
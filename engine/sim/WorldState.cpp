@@ -76,6 +76,14 @@ size_t WorldState::SnapshotCount() const {
     return m_snapshots.size();
 }
 
+size_t WorldState::SnapshotMemoryBytes() const {
+    size_t total = 0;
+    for (const auto& snap : m_snapshots) {
+        total += snap.ecsData.capacity() + snap.auxiliaryData.capacity();
+    }
+    return total;
+}
+
 void WorldState::SetMaxSnapshots(size_t max) {
     m_maxSnapshots = max > 0 ? max : 1;
 }
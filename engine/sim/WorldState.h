@@ -85,6 +85,9 @@ public:
     /// Number of stored snapshots.
     size_t SnapshotCount() const;
 
+    /// Bytes held by stored snapshot data (ECS and auxiliary buffers).
+    size_t SnapshotMemoryBytes() const;
+
     /// Set maximum number of snapshots to retain (for memory control).
     void SetMaxSnapshots(size_t max);
     size_t MaxSnapshots() const;
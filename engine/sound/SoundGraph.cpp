@@ -4,6 +4,19 @@
 
 namespace atlas::sound {
 
+void SoundNode::Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                        SoundValue* outputs, size_t outputCount) {
+    std::vector<SoundValue> in(inputCount);
+    for (size_t i = 0; i < inputCount; ++i) {
+        if (inputs[i]) in[i] = *inputs[i];
+    }
+    std::vector<SoundValue> out(outputCount);
+    Evaluate(ctx, in, out);
+    for (size_t p = 0; p < outputCount && p < out.size(); ++p) {
+        outputs[p].data = std::move(out[p].data);
+    }
+}
+
 SoundNodeID SoundGraph::AddNode(std::unique_ptr<SoundNode> node) {
     SoundNodeID id = m_nextID++;
     m_nodes[id] = std::move(node);
@@ -13,6 +26,7 @@ SoundNodeID SoundGraph::AddNode(std::unique_ptr<SoundNode> node) {
 
 void SoundGraph::RemoveNode(SoundNodeID id) {
     m_nodes.erase(id);
+    m_prepared = false;   // steps may point at the removed node
     m_edges.erase(
         std::remove_if(m_edges.begin(), m_edges.end(),
             [id](const SoundEdge& e) {
@@ -94,6 +108,7 @@ bool SoundGraph::ValidateEdgeTypes() const {
 
 bool SoundGraph::Compile() {
     m_compiled = false;
+    m_prepared = false;
     m_executionOrder.clear();
 
     if (HasCycle()) return false;
@@ -129,49 +144,103 @@ bool SoundGraph::Compile() {
     return m_compiled;
 }
 
-bool SoundGraph::Execute(const SoundContext& ctx) {
-    if (!m_compiled) return false;
-
-    m_outputs.clear();
+bool SoundGraph::Compile(const SoundContext& ctx) {
+    if (!Compile()) return false;
+    Prepare(ctx);
+    return true;
+}
 
-    for (SoundNodeID id : m_executionOrder) {
-        auto it = m_nodes.find(id);
-        if (it == m_nodes.end()) return false;
+void SoundGraph::Prepare(const SoundContext& ctx) {
+    m_steps.clear();
+    m_ports.clear();
+    m_inputs.clear();
+    m_portIndex.clear();
+    m_capacity = std::max<uint32_t>(ctx.bufferSize, 1);
+    m_sampleRate = ctx.sampleRate;
+    m_blockSize = ctx.bufferSize;
 
-        SoundNode* node = it->second.get();
-        auto inputDefs = node->Inputs();
+    // Output buffers first: input slots point into m_ports, which must
+    // not reallocate afterwards
+    m_steps.resize(m_executionOrder.size());
+    for (size_t s = 0; s < m_executionOrder.size(); ++s) {
+        SoundNodeID id = m_executionOrder[s];
+        Step& step = m_steps[s];
+        step.node = m_nodes.at(id).get();
+        auto outputDefs = step.node->Outputs();
+        step.firstOutput = static_cast<uint32_t>(m_ports.size());
+        step.outputCount = static_cast<uint32_t>(outputDefs.size());
+        for (SoundPortID p = 0; p < outputDefs.size(); ++p) {
+            SoundValue value;
+            value.type = outputDefs[p].type;
+            value.data.reserve(m_capacity);
+            value.data.resize(IsBlockPin(value.type) ? ctx.bufferSize : 1, 0.0f);
+            m_portIndex[(static_cast<uint64_t>(id) << 32) | p] = m_ports.size();
+            m_ports.push_back(std::move(value));
+        }
+    }
 
-        std::vector<SoundValue> inputs(inputDefs.size());
+    for (size_t s = 0; s < m_executionOrder.size(); ++s) {
+        SoundNodeID id = m_executionOrder[s];
+        Step& step = m_steps[s];
+        size_t inputCount = step.node->Inputs().size();
+        step.firstInput = static_cast<uint32_t>(m_inputs.size());
+        step.inputCount = static_cast<uint32_t>(inputCount);
+        m_inputs.resize(m_inputs.size() + inputCount, nullptr);
         for (auto& e : m_edges) {
-            if (e.toNode == id && e.toPort < inputs.size()) {
-                uint64_t key = (static_cast<uint64_t>(e.fromNode) << 32) | e.fromPort;
-                auto outIt = m_outputs.find(key);
-                if (outIt != m_outputs.end()) {
-                    inputs[e.toPort] = outIt->second;
-                }
-            }
+            if (e.toNode != id || e.toPort >= inputCount) continue;
+            auto it = m_portIndex.find((static_cast<uint64_t>(e.fromNode) << 32) | e.fromPort);
+            if (it != m_portIndex.end()) m_inputs[step.firstInput + e.toPort] = &m_ports[it->second];
         }
+        step.node->Prepare(ctx);
+    }
 
-        auto outputDefs = node->Outputs();
-        std::vector<SoundValue> outputs(outputDefs.size());
-        node->Evaluate(ctx, inputs, outputs);
+    m_prepared = true;
+}
 
-        for (SoundPortID p = 0; p < outputs.size(); ++p) {
-            uint64_t key = (static_cast<uint64_t>(id) << 32) | p;
-            m_outputs[key] = std::move(outputs[p]);
-        }
+void SoundGraph::ResizeBlocks(uint32_t frames) {
+    // Within capacity, so no reallocation
+    for (auto& port : m_ports) {
+        if (IsBlockPin(port.type)) port.data.resize(frames, 0.0f);
+    }
+    m_blockSize = frames;
+}
+
+bool SoundGraph::Execute(const SoundContext& ctx) {
+    if (!m_compiled) return false;
+
+    if (!m_prepared || ctx.sampleRate != m_sampleRate || ctx.bufferSize > m_capacity) {
+        Prepare(ctx);
+    } else if (ctx.bufferSize != m_blockSize) {
+        ResizeBlocks(ctx.bufferSize);
+    }
+
+    for (const Step& step : m_steps) {
+        step.node->Process(ctx, m_inputs.data() + step.firstInput, step.inputCount,
+                           m_ports.data() + step.firstOutput, step.outputCount);
     }
 
     return true;
 }
 
+void SoundGraph::Reset() {
+    for (auto& [id, node] : m_nodes) {
+        node->Reset();
+    }
+}
+
 const SoundValue* SoundGraph::GetOutput(SoundNodeID node, SoundPortID port) const {
+    if (!m_prepared) return nullptr;
     uint64_t key = (static_cast<uint64_t>(node) << 32) | port;
-    auto it = m_outputs.find(key);
-    if (it != m_outputs.end()) return &it->second;
+    auto it = m_portIndex.find(key);
+    if (it != m_portIndex.end()) return &m_ports[it->second];
     return nullptr;
 }
 
+SoundNode* SoundGraph::GetNode(SoundNodeID id) const {
+    auto it = m_nodes.find(id);
+    return it != m_nodes.end() ? it->second.get() : nullptr;
+}
+
 size_t SoundGraph::NodeCount() const {
     return m_nodes.size();
 }
@@ -180,4 +249,8 @@ bool SoundGraph::IsCompiled() const {
     return m_compiled;
 }
 
+bool SoundGraph::IsPrepared() const {
+    return m_prepared;
+}
+
 }
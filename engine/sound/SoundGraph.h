@@ -48,7 +48,22 @@ public:
     virtual const char* GetCategory() const = 0;
     virtual std::vector<SoundPort> Inputs() const = 0;
     virtual std::vector<SoundPort> Outputs() const = 0;
+    /// One-shot evaluation with fresh state. May allocate.
     virtual void Evaluate(const SoundContext& ctx, const std::vector<SoundValue>& inputs, std::vector<SoundValue>& outputs) const = 0;
+
+    // ---- Block (real-time) interface ----
+    // SoundGraph calls Prepare() when buffers are (re)allocated, then
+    // Process() once per block. Process() receives preallocated output
+    // buffers already sized for the block and must not allocate, lock or
+    // resize them; unconnected inputs are null. State such as oscillator
+    // phase persists between calls until Reset().
+
+    virtual void Prepare(const SoundContext& ctx) { (void)ctx; }
+    virtual void Reset() {}
+    /// Default forwards to Evaluate(), which allocates: nodes meant for
+    /// the audio thread override this.
+    virtual void Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                         SoundValue* outputs, size_t outputCount);
 };
 
 class SoundGraph {
@@ -58,19 +73,54 @@ public:
     void AddEdge(const SoundEdge& edge);
     void RemoveEdge(const SoundEdge& edge);
     bool Compile();
+    /// Compile and preallocate every port buffer for ctx.bufferSize so
+    /// Execute() with the same (or a smaller) block never allocates.
+    bool Compile(const SoundContext& ctx);
+    /// Render one block. Real-time safe once buffers are prepared for
+    /// ctx; a larger block or new sample rate re-prepares (allocates).
     bool Execute(const SoundContext& ctx);
+    /// Clear persistent node state (phase, envelope position).
+    void Reset();
     const SoundValue* GetOutput(SoundNodeID node, SoundPortID port) const;
+    SoundNode* GetNode(SoundNodeID id) const;
     size_t NodeCount() const;
     bool IsCompiled() const;
+    bool IsPrepared() const;
 private:
+    // One node's slice of the flattened port tables
+    struct Step {
+        SoundNode* node = nullptr;
+        uint32_t firstInput = 0;
+        uint32_t inputCount = 0;
+        uint32_t firstOutput = 0;
+        uint32_t outputCount = 0;
+    };
+
     SoundNodeID m_nextID = 1;
     std::unordered_map<SoundNodeID, std::unique_ptr<SoundNode>> m_nodes;
     std::vector<SoundEdge> m_edges;
     std::vector<SoundNodeID> m_executionOrder;
     bool m_compiled = false;
-    std::unordered_map<uint64_t, SoundValue> m_outputs;
+
+    bool m_prepared = false;
+    uint32_t m_capacity = 0;           // frames each block buffer can hold
+    uint32_t m_blockSize = 0;          // frames the buffers are sized to now
+    uint32_t m_sampleRate = 0;
+    std::vector<Step> m_steps;
+    std::vector<SoundValue> m_ports;                 // every node output
+    std::vector<const SoundValue*> m_inputs;         // per step input slots
+    std::unordered_map<uint64_t, size_t> m_portIndex;
+
     bool HasCycle() const;
     bool ValidateEdgeTypes() const;
+    void Prepare(const SoundContext& ctx);
+    void ResizeBlocks(uint32_t frames);
 };
 
+/// True for pin types carrying one value per sample; the rest are
+/// single-value control pins.
+inline bool IsBlockPin(SoundPinType type) {
+    return type == SoundPinType::AudioBuffer || type == SoundPinType::Envelope;
+}
+
 }
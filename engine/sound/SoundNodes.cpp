@@ -8,6 +8,37 @@
 
 namespace atlas::sound {
 
+namespace {
+
+// Scalar from a control pin, or def when unconnected/empty
+float ControlValue(const SoundValue* value, float def) {
+    return (value && !value->data.empty()) ? value->data[0] : def;
+}
+
+double RenderSine(float* out, uint32_t frames, double phase, double phaseInc) {
+    for (uint32_t i = 0; i < frames; ++i) {
+        out[i] = static_cast<float>(std::sin(phase));
+        phase += phaseInc;
+    }
+    return phase;
+}
+
+void RenderGain(const float* in, size_t inSize, float gain, float* out, uint32_t frames) {
+    for (uint32_t i = 0; i < frames; ++i) {
+        out[i] = i < inSize ? in[i] * gain : 0.0f;
+    }
+}
+
+void RenderMix(const float* a, size_t aSize, const float* b, size_t bSize, float* out, uint32_t frames) {
+    for (uint32_t i = 0; i < frames; ++i) {
+        float va = i < aSize ? a[i] : 0.0f;
+        float vb = i < bSize ? b[i] : 0.0f;
+        out[i] = (va + vb) * 0.5f;
+    }
+}
+
+} // namespace
+
 // --- OscillatorNode ---
 
 std::vector<SoundPort> OscillatorNode::Inputs() const {
@@ -29,11 +60,18 @@ void OscillatorNode::Evaluate(const SoundContext& ctx, const std::vector<SoundVa
     outputs[0].data.resize(ctx.bufferSize);
 
     double phaseInc = 2.0 * M_PI * static_cast<double>(freq) / static_cast<double>(ctx.sampleRate);
-    double phase = 0.0;
-    for (uint32_t i = 0; i < ctx.bufferSize; ++i) {
-        outputs[0].data[i] = static_cast<float>(std::sin(phase));
-        phase += phaseInc;
-    }
+    RenderSine(outputs[0].data.data(), ctx.bufferSize, 0.0, phaseInc);
+}
+
+void OscillatorNode::Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                             SoundValue* outputs, size_t outputCount) {
+    if (outputCount < 1) return;
+    float freq = ControlValue(inputCount > 0 ? inputs[0] : nullptr, 440.0f);
+    double phaseInc = 2.0 * M_PI * static_cast<double>(freq) / static_cast<double>(ctx.sampleRate);
+    auto& out = outputs[0].data;
+    m_phase = RenderSine(out.data(), static_cast<uint32_t>(out.size()), m_phase, phaseInc);
+    // Keep the phase small so precision does not degrade over long streams
+    m_phase = std::fmod(m_phase, 2.0 * M_PI);
 }
 
 // --- GainNode ---
@@ -60,12 +98,22 @@ void GainNode::Evaluate(const SoundContext& ctx, const std::vector<SoundValue>&
     outputs[0].data.resize(ctx.bufferSize, 0.0f);
 
     if (!inputs.empty() && !inputs[0].data.empty()) {
-        for (uint32_t i = 0; i < ctx.bufferSize && i < inputs[0].data.size(); ++i) {
-            outputs[0].data[i] = inputs[0].data[i] * gain;
-        }
+        RenderGain(inputs[0].data.data(), inputs[0].data.size(), gain,
+                   outputs[0].data.data(), ctx.bufferSize);
     }
 }
 
+void GainNode::Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                       SoundValue* outputs, size_t outputCount) {
+    (void)ctx;
+    if (outputCount < 1) return;
+    const SoundValue* audio = inputCount > 0 ? inputs[0] : nullptr;
+    float gain = ControlValue(inputCount > 1 ? inputs[1] : nullptr, 1.0f);
+    auto& out = outputs[0].data;
+    RenderGain(audio ? audio->data.data() : nullptr, audio ? audio->data.size() : 0, gain,
+               out.data(), static_cast<uint32_t>(out.size()));
+}
+
 // --- MixNode ---
 
 std::vector<SoundPort> MixNode::Inputs() const {
@@ -84,13 +132,23 @@ void MixNode::Evaluate(const SoundContext& ctx, const std::vector<SoundValue>& i
     outputs[0].type = SoundPinType::AudioBuffer;
     outputs[0].data.resize(ctx.bufferSize, 0.0f);
 
-    for (uint32_t i = 0; i < ctx.bufferSize; ++i) {
-        float a = 0.0f;
-        float b = 0.0f;
-        if (!inputs.empty() && i < inputs[0].data.size()) a = inputs[0].data[i];
-        if (inputs.size() > 1 && i < inputs[1].data.size()) b = inputs[1].data[i];
-        outputs[0].data[i] = (a + b) * 0.5f;
-    }
+    const SoundValue* a = !inputs.empty() ? &inputs[0] : nullptr;
+    const SoundValue* b = inputs.size() > 1 ? &inputs[1] : nullptr;
+    RenderMix(a ? a->data.data() : nullptr, a ? a->data.size() : 0,
+              b ? b->data.data() : nullptr, b ? b->data.size() : 0,
+              outputs[0].data.data(), ctx.bufferSize);
+}
+
+void MixNode::Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                      SoundValue* outputs, size_t outputCount) {
+    (void)ctx;
+    if (outputCount < 1) return;
+    const SoundValue* a = inputCount > 0 ? inputs[0] : nullptr;
+    const SoundValue* b = inputCount > 1 ? inputs[1] : nullptr;
+    auto& out = outputs[0].data;
+    RenderMix(a ? a->data.data() : nullptr, a ? a->data.size() : 0,
+              b ? b->data.data() : nullptr, b ? b->data.size() : 0,
+              out.data(), static_cast<uint32_t>(out.size()));
 }
 
 // --- EnvelopeNode ---
@@ -100,7 +158,8 @@ std::vector<SoundPort> EnvelopeNode::Inputs() const {
         {"Attack", SoundPinType::Float},
         {"Decay", SoundPinType::Float},
         {"Sustain", SoundPinType::Float},
-        {"Release", SoundPinType::Float}
+        {"Release", SoundPinType::Float},
+        {"Gate", SoundPinType::Trigger}
     };
 }
 
@@ -140,4 +199,87 @@ void EnvelopeNode::Evaluate(const SoundContext& ctx, const std::vector<SoundValu
     }
 }
 
+void EnvelopeNode::Reset() {
+    m_gateOn = false;
+    m_position = 0;
+    m_releasePosition = 0;
+    m_level = 0.0f;
+    m_releaseLevel = 0.0f;
+}
+
+void EnvelopeNode::Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                           SoundValue* outputs, size_t outputCount) {
+    if (outputCount < 1) return;
+    auto input = [&](size_t i) { return i < inputCount ? inputs[i] : nullptr; };
+    float attack  = ControlValue(input(0), 0.01f);
+    float decay   = ControlValue(input(1), 0.1f);
+    float sustain = ControlValue(input(2), 0.7f);
+    float release = ControlValue(input(3), 0.2f);
+    bool gate = ControlValue(input(4), 1.0f) > 0.5f;
+
+    float sr = static_cast<float>(ctx.sampleRate);
+    uint64_t attackSamples  = static_cast<uint64_t>(attack * sr);
+    uint64_t decaySamples   = static_cast<uint64_t>(decay * sr);
+    uint64_t releaseSamples = static_cast<uint64_t>(release * sr);
+
+    if (gate && !m_gateOn) {
+        m_gateOn = true;
+        m_position = 0;
+    } else if (!gate && m_gateOn) {
+        m_gateOn = false;
+        m_releasePosition = 0;
+        m_releaseLevel = m_level;
+    }
+
+    auto& out = outputs[0].data;
+    for (size_t i = 0; i < out.size(); ++i) {
+        float val;
+        if (m_gateOn) {
+            uint64_t pos = m_position++;
+            if (pos < attackSamples) {
+                val = static_cast<float>(pos) / static_cast<float>(attackSamples);
+            } else if (pos < attackSamples + decaySamples) {
+                float t = static_cast<float>(pos - attackSamples) / static_cast<float>(decaySamples);
+                val = 1.0f - t * (1.0f - sustain);
+            } else {
+                val = sustain;
+            }
+        } else if (m_releasePosition < releaseSamples) {
+            float t = static_cast<float>(m_releasePosition++) / static_cast<float>(releaseSamples);
+            val = m_releaseLevel * (1.0f - t);
+        } else {
+            val = 0.0f;
+        }
+        m_level = std::max(0.0f, std::min(1.0f, val));
+        out[i] = m_level;
+    }
+}
+
+// --- ParameterNode ---
+
+std::vector<SoundPort> ParameterNode::Inputs() const {
+    return {};
+}
+
+std::vector<SoundPort> ParameterNode::Outputs() const {
+    return {{"Value", m_type}};
+}
+
+void ParameterNode::Evaluate(const SoundContext& ctx, const std::vector<SoundValue>& inputs, std::vector<SoundValue>& outputs) const {
+    (void)ctx;
+    (void)inputs;
+    outputs.resize(1);
+    outputs[0].type = m_type;
+    outputs[0].data.assign(1, Get());
+}
+
+void ParameterNode::Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                            SoundValue* outputs, size_t outputCount) {
+    (void)ctx;
+    (void)inputs;
+    (void)inputCount;
+    if (outputCount < 1 || outputs[0].data.empty()) return;
+    outputs[0].data[0] = Get();
+}
+
 }
@@ -1,9 +1,11 @@
 #pragma once
 #include "SoundGraph.h"
+#include <atomic>
 
 namespace atlas::sound {
 
-// Generates sine wave audio buffer from frequency
+// Generates sine wave audio buffer from frequency. Phase carries over
+// between blocks so streamed output is continuous.
 class OscillatorNode : public SoundNode {
 public:
     const char* GetName() const override { return "Oscillator"; }
@@ -11,6 +13,12 @@ public:
     std::vector<SoundPort> Inputs() const override;
     std::vector<SoundPort> Outputs() const override;
     void Evaluate(const SoundContext& ctx, const std::vector<SoundValue>& inputs, std::vector<SoundValue>& outputs) const override;
+    void Reset() override { m_phase = 0.0; }
+    void Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                 SoundValue* outputs, size_t outputCount) override;
+
+private:
+    double m_phase = 0.0;
 };
 
 // Multiplies audio buffer by a gain float
@@ -21,6 +29,8 @@ public:
     std::vector<SoundPort> Inputs() const override;
     std::vector<SoundPort> Outputs() const override;
     void Evaluate(const SoundContext& ctx, const std::vector<SoundValue>& inputs, std::vector<SoundValue>& outputs) const override;
+    void Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                 SoundValue* outputs, size_t outputCount) override;
 };
 
 // Mixes two audio buffers together
@@ -31,9 +41,14 @@ public:
     std::vector<SoundPort> Inputs() const override;
     std::vector<SoundPort> Outputs() const override;
     void Evaluate(const SoundContext& ctx, const std::vector<SoundValue>& inputs, std::vector<SoundValue>& outputs) const override;
+    void Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                 SoundValue* outputs, size_t outputCount) override;
 };
 
-// Generates ADSR envelope from 4 float parameters
+// Generates ADSR envelope from 4 float parameters. Evaluate() shapes a
+// single buffer (release at its end); streamed blocks hold sustain while
+// the optional Gate trigger is high (or unconnected) and release after
+// it drops.
 class EnvelopeNode : public SoundNode {
 public:
     const char* GetName() const override { return "Envelope"; }
@@ -41,6 +56,39 @@ public:
     std::vector<SoundPort> Inputs() const override;
     std::vector<SoundPort> Outputs() const override;
     void Evaluate(const SoundContext& ctx, const std::vector<SoundValue>& inputs, std::vector<SoundValue>& outputs) const override;
+    void Reset() override;
+    void Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                 SoundValue* outputs, size_t outputCount) override;
+
+private:
+    bool m_gateOn = false;
+    uint64_t m_position = 0;        // samples since the gate opened
+    uint64_t m_releasePosition = 0; // samples since the gate closed
+    float m_level = 0.0f;
+    float m_releaseLevel = 0.0f;
+};
+
+// Control value written from any thread (game thread, UI) and read by the
+// audio thread once per block through an atomic.
+class ParameterNode : public SoundNode {
+public:
+    explicit ParameterNode(float initial = 0.0f, SoundPinType type = SoundPinType::Float)
+        : m_value(initial), m_type(type) {}
+
+    const char* GetName() const override { return "Parameter"; }
+    const char* GetCategory() const override { return "Input"; }
+    std::vector<SoundPort> Inputs() const override;
+    std::vector<SoundPort> Outputs() const override;
+    void Evaluate(const SoundContext& ctx, const std::vector<SoundValue>& inputs, std::vector<SoundValue>& outputs) const override;
+    void Process(const SoundContext& ctx, const SoundValue* const* inputs, size_t inputCount,
+                 SoundValue* outputs, size_t outputCount) override;
+
+    void Set(float value) { m_value.store(value, std::memory_order_relaxed); }
+    float Get() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<float> m_value;
+    SoundPinType m_type;
 };
 
 }
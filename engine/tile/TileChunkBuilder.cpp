@@ -1,6 +1,7 @@
 #include "TileChunkBuilder.h"
-#include <map>
-#include <cmath>
+#include "../core/JobSystem.h"
+#include <utility>
+#include <vector>
 
 namespace atlas::tile {
 
@@ -16,45 +17,77 @@ void TileChunkBuilder::Build(
     outChunk.chunkSize = kChunkSize;
     outChunk.dirty    = false;
 
+    const auto* cells = layer.tiles.FindChunk(chunkOrigin.cx, chunkOrigin.cy);
+    if (!cells) return;
+
     const float cellSize = static_cast<float>(map.gridCellSize);
+    const size_t count = cells->Count();
+    outChunk.vertices.resize(count * 4);
+    outChunk.indices.resize(count * 6);
+
+    TileVertex* vert = outChunk.vertices.data();
+    uint32_t* idx = outChunk.indices.data();
+    uint32_t base = 0;
+
+    // Row-major walk of the chunk's dense cells is already a fixed order.
+    for (int32_t ly = 0; ly < kChunkSize; ++ly) {
+        for (int32_t lx = 0; lx < kChunkSize; ++lx) {
+            int32_t cell = ly * kChunkSize + lx;
+            if (!cells->Has(cell)) continue;
+            const auto& tile = cells->cells[cell];
+
+            float wx = (chunkOrigin.cx * kChunkSize + lx) * cellSize;
+            float wy = (chunkOrigin.cy * kChunkSize + ly) * cellSize;
 
-    // Collect tiles inside the chunk using a sorted container so the
-    // output is deterministic regardless of unordered_map iteration order.
-    std::map<std::pair<int32_t,int32_t>, atlas::editor::TileInstance> sorted;
-    for (auto& [coord, tile] : layer.tiles) {
-        if (IsInsideChunk(coord, chunkOrigin)) {
-            sorted[{coord.x, coord.y}] = tile;
+            // UV defaults — a real atlas lookup would replace these.
+            float u0 = 0.0f, v0 = 0.0f;
+            float u1 = 1.0f, v1 = 1.0f;
+
+            // Handle flip flags
+            if (tile.flippedX) { std::swap(u0, u1); }
+            if (tile.flippedY) { std::swap(v0, v1); }
+
+            // Emit 4 vertices per tile
+            *vert++ = {wx,            wy,            u0, v0};
+            *vert++ = {wx + cellSize, wy,            u1, v0};
+            *vert++ = {wx + cellSize, wy + cellSize, u1, v1};
+            *vert++ = {wx,            wy + cellSize, u0, v1};
+
+            // Emit 6 indices per tile (two triangles)
+            *idx++ = base + 0;
+            *idx++ = base + 1;
+            *idx++ = base + 2;
+            *idx++ = base + 0;
+            *idx++ = base + 2;
+            *idx++ = base + 3;
+            base += 4;
         }
     }
+}
+
+void TileChunkBuilder::RebuildDirty(
+    const atlas::editor::TileMap& map,
+    const atlas::editor::TileLayer& layer,
+    std::set<ChunkCoord>& dirtySet,
+    std::map<ChunkCoord, TileChunk>& chunks)
+{
+    // Map insertion is serial; the builds only touch their own chunk.
+    std::vector<std::pair<ChunkCoord, TileChunk*>> jobs;
+    jobs.reserve(dirtySet.size());
+    for (const auto& coord : dirtySet) {
+        jobs.emplace_back(coord, &chunks[coord]);
+    }
+
+    JobSystem::Shared().ParallelFor(jobs.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Build(map, layer, jobs[i].first, *jobs[i].second);
+        }
+    }, 16);
 
-    for (auto& [key, tile] : sorted) {
-        float wx = key.first  * cellSize;
-        float wy = key.second * cellSize;
-
-        // UV defaults — a real atlas lookup would replace these.
-        float u0 = 0.0f, v0 = 0.0f;
-        float u1 = 1.0f, v1 = 1.0f;
-
-        // Handle flip flags
-        if (tile.flippedX) { std::swap(u0, u1); }
-        if (tile.flippedY) { std::swap(v0, v1); }
-
-        uint32_t base = static_cast<uint32_t>(outChunk.vertices.size());
-
-        // Emit 4 vertices per tile
-        outChunk.vertices.push_back({wx,            wy,            u0, v0});
-        outChunk.vertices.push_back({wx + cellSize, wy,            u1, v0});
-        outChunk.vertices.push_back({wx + cellSize, wy + cellSize, u1, v1});
-        outChunk.vertices.push_back({wx,            wy + cellSize, u0, v1});
-
-        // Emit 6 indices per tile (two triangles)
-        outChunk.indices.push_back(base + 0);
-        outChunk.indices.push_back(base + 1);
-        outChunk.indices.push_back(base + 2);
-        outChunk.indices.push_back(base + 0);
-        outChunk.indices.push_back(base + 2);
-        outChunk.indices.push_back(base + 3);
+    for (const auto& [coord, chunk] : jobs) {
+        if (chunk->VertexCount() == 0) chunks.erase(coord);
     }
+    dirtySet.clear();
 }
 
 ChunkCoord TileChunkBuilder::WorldToChunk(const atlas::editor::GridCoord& coord) {
@@ -2,6 +2,7 @@
 #include "TileRenderer.h"
 #include "../../editor/tools/TileEditorModule.h"
 #include <cstdint>
+#include <map>
 #include <set>
 
 namespace atlas::tile {
@@ -21,23 +22,32 @@ struct ChunkCoord {
 /// Builds GPU-ready tile chunk meshes from a TileMap + TileLayer.
 ///
 /// Determinism guarantees:
-///  * Fixed iteration order (sorted coordinates).
+///  * Fixed iteration order (row-major within the chunk).
 ///  * No floating-point randomness.
 ///  * Atlas UVs baked once per tile asset.
 ///  * Identical inputs on any platform produce identical output.
 class TileChunkBuilder {
 public:
     /// Number of grid cells per chunk side.
-    static constexpr int32_t kChunkSize = 8;
+    static constexpr int32_t kChunkSize = atlas::editor::kTileChunkSize;
 
     /// Build mesh data for all tiles in @p layer that fall within the
-    /// chunk starting at @p chunkOrigin.
+    /// chunk starting at @p chunkOrigin. Reads only that chunk's bucket
+    /// and writes into @p outChunk's existing buffers.
     static void Build(
         const atlas::editor::TileMap& map,
         const atlas::editor::TileLayer& layer,
         const ChunkCoord& chunkOrigin,
         TileChunk& outChunk);
 
+    /// Rebuild every chunk in @p dirtySet into @p chunks in parallel,
+    /// then clear the set. Chunks left without tiles are removed.
+    static void RebuildDirty(
+        const atlas::editor::TileMap& map,
+        const atlas::editor::TileLayer& layer,
+        std::set<ChunkCoord>& dirtySet,
+        std::map<ChunkCoord, TileChunk>& chunks);
+
     /// Convert a world grid coordinate to the chunk it belongs to.
     static ChunkCoord WorldToChunk(const atlas::editor::GridCoord& coord);
 
@@ -0,0 +1,361 @@
+#include "ChunkIO.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+
+namespace atlas::world {
+
+namespace {
+
+constexpr char kRegionMagic[8] = {'A', 'T', 'L', 'A', 'S', 'R', 'G', 'N'};
+constexpr uint32_t kRegionVersion = 1;
+constexpr size_t kHeaderSize = 16;
+constexpr size_t kSlotSize = 16;
+// Dead bytes a region may hold before it is compacted (and only once
+// they also outweigh the live data)
+constexpr uint64_t kCompactMinDead = 64 * 1024;
+
+template <typename Slot>
+void WriteRegionHeader(std::ostream& out, const std::vector<Slot>& table) {
+    uint32_t version = kRegionVersion, slots = static_cast<uint32_t>(table.size());
+    out.write(kRegionMagic, sizeof(kRegionMagic));
+    out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    out.write(reinterpret_cast<const char*>(&slots), sizeof(slots));
+    out.write(reinterpret_cast<const char*>(table.data()), table.size() * kSlotSize);
+}
+
+int FloorDiv(int a, int b) {
+    return (a >= 0) ? (a / b) : ((a - b + 1) / b);
+}
+
+double Distance(const WorldPos& a, const WorldPos& b) {
+    double dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+}
+
+// --- ChunkRegionStore ---
+
+ChunkRegionStore::ChunkRegionStore(std::string directory)
+    : m_directory(std::move(directory)) {}
+
+int ChunkRegionStore::SlotIndex(const ChunkCoord& chunk) {
+    int lx = chunk.x - FloorDiv(chunk.x, kRegionSide) * kRegionSide;
+    int lz = chunk.z - FloorDiv(chunk.z, kRegionSide) * kRegionSide;
+    return lz * kRegionSide + lx;
+}
+
+std::string ChunkRegionStore::RegionPath(const ChunkCoord& chunk) const {
+    return m_directory + "/region_" + std::to_string(chunk.lod) + "_" + std::to_string(chunk.y) + "_" +
+           std::to_string(FloorDiv(chunk.x, kRegionSide)) + "_" +
+           std::to_string(FloorDiv(chunk.z, kRegionSide)) + ".bin";
+}
+
+bool ChunkRegionStore::Write(const ChunkCoord& chunk, const std::vector<uint8_t>& data) {
+    return WriteBatch({PendingWrite{chunk, data}}) == 0;
+}
+
+size_t ChunkRegionStore::WriteBatch(const std::vector<PendingWrite>& writes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_directoryReady) {
+        std::error_code ec;
+        std::filesystem::create_directories(m_directory, ec);
+        if (ec) return writes.size();
+        m_directoryReady = true;
+    }
+
+    std::map<std::string, std::vector<const PendingWrite*>> byRegion;
+    for (const auto& w : writes) byRegion[RegionPath(w.coord)].push_back(&w);
+
+    size_t failed = 0;
+    for (const auto& [path, group] : byRegion) {
+        std::vector<Slot> table(kSlotCount);
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        if (file.is_open()) {
+            char magic[8];
+            uint32_t version = 0, slots = 0;
+            file.read(magic, sizeof(magic));
+            file.read(reinterpret_cast<char*>(&version), sizeof(version));
+            file.read(reinterpret_cast<char*>(&slots), sizeof(slots));
+            file.read(reinterpret_cast<char*>(table.data()), kSlotCount * kSlotSize);
+            if (!file.good() || std::memcmp(magic, kRegionMagic, sizeof(magic)) != 0 ||
+                version != kRegionVersion || slots != kSlotCount) {
+                failed += group.size();
+                continue;
+            }
+        } else {
+            // New region: header and an empty table
+            std::ofstream create(path, std::ios::binary | std::ios::trunc);
+            WriteRegionHeader(create, table);
+            create.close();
+            file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+            if (!file.is_open()) {
+                failed += group.size();
+                continue;
+            }
+        }
+
+        // Never write over a slot's current copy: each chunk goes past the
+        // end of the file and its slot is repointed only once the data is
+        // written, so a failed write keeps the previous copy readable.
+        file.seekp(0, std::ios::end);
+        auto end = static_cast<uint64_t>(file.tellp());
+        std::vector<Slot> updated = table;
+        size_t groupFailed = 0;
+        for (const PendingWrite* w : group) {
+            auto size = static_cast<uint32_t>(w->data.size());
+            file.seekp(static_cast<std::streamoff>(end));
+            file.write(reinterpret_cast<const char*>(w->data.data()), size);
+            if (!file.good()) {
+                groupFailed++;
+                file.clear();
+                continue;
+            }
+            updated[SlotIndex(w->coord)] = Slot{end, size, size};
+            end += size;
+        }
+
+        // Data reaches the file before the table that points at it
+        file.flush();
+        if (!file.good()) {
+            failed += group.size();
+            continue;
+        }
+        file.seekp(kHeaderSize);
+        file.write(reinterpret_cast<const char*>(updated.data()), kSlotCount * kSlotSize);
+        file.flush();
+        if (!file.good()) {
+            failed += group.size();
+            continue;
+        }
+        failed += groupFailed;
+        file.close();
+
+        uint64_t live = 0;
+        for (const Slot& slot : updated) live += slot.size;
+        uint64_t dead = end - (kHeaderSize + kSlotCount * kSlotSize) - live;
+        if (dead > kCompactMinDead && dead > live) CompactRegion(path, updated);
+    }
+    return std::min(failed, writes.size());
+}
+
+bool ChunkRegionStore::CompactRegion(const std::string& path, std::vector<Slot>& table) {
+    std::ifstream in(path, std::ios::binary);
+    std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!in.is_open() || !out.is_open()) return false;
+
+    std::vector<Slot> compacted(kSlotCount);
+    uint64_t offset = kHeaderSize + kSlotCount * kSlotSize;
+    WriteRegionHeader(out, compacted);
+    std::vector<char> buffer;
+    for (int i = 0; i < kSlotCount; ++i) {
+        const Slot& slot = table[i];
+        if (slot.size == 0) continue;
+        buffer.resize(slot.size);
+        in.seekg(static_cast<std::streamoff>(slot.offset));
+        in.read(buffer.data(), slot.size);
+        out.write(buffer.data(), slot.size);
+        compacted[i] = Slot{offset, slot.size, slot.size};
+        offset += slot.size;
+    }
+    out.seekp(kHeaderSize);
+    out.write(reinterpret_cast<const char*>(compacted.data()), kSlotCount * kSlotSize);
+    out.close();
+    in.close();
+
+    // The original stays in place unless the copy is complete
+    std::error_code ec;
+    if (!in || !out) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    table = std::move(compacted);
+    return true;
+}
+
+bool ChunkRegionStore::Read(const ChunkCoord& chunk, std::vector<uint8_t>& out) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::ifstream file(RegionPath(chunk), std::ios::binary);
+    if (!file.is_open()) return false;
+
+    char magic[8];
+    file.read(magic, sizeof(magic));
+    if (!file.good() || std::memcmp(magic, kRegionMagic, sizeof(magic)) != 0) return false;
+
+    Slot slot;
+    file.seekg(static_cast<std::streamoff>(kHeaderSize + SlotIndex(chunk) * kSlotSize));
+    file.read(reinterpret_cast<char*>(&slot), sizeof(slot));
+    if (!file.good() || slot.size == 0) return false;
+
+    out.resize(slot.size);
+    file.seekg(static_cast<std::streamoff>(slot.offset));
+    file.read(reinterpret_cast<char*>(out.data()), slot.size);
+    return file.good();
+}
+
+// --- ChunkIOQueue ---
+
+ChunkIOQueue::ChunkIOQueue(const std::string& cacheDir)
+    : m_store(cacheDir)
+    , m_worker([this] { WorkerLoop(); }) {}
+
+ChunkIOQueue::~ChunkIOQueue() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_paused = false;
+    }
+    m_wake.notify_all();
+    m_worker.join();
+}
+
+bool ChunkIOQueue::Farther(const ReadRequest& a, const ReadRequest& b) {
+    if (a.distance != b.distance) return a.distance > b.distance;
+    return a.key > b.key;
+}
+
+bool ChunkIOQueue::Idle() const {
+    return m_reads.empty() && m_writes.empty() && !m_busy;
+}
+
+void ChunkIOQueue::QueueRead(uint64_t key, const ChunkCoord& chunk, const WorldPos& position) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& r : m_reads) {
+            if (r.key == key) return;
+        }
+        m_reads.push_back({key, chunk, position, Distance(position, m_viewer)});
+        std::push_heap(m_reads.begin(), m_reads.end(), Farther);
+    }
+    m_wake.notify_one();
+}
+
+void ChunkIOQueue::QueueWrite(uint64_t key, const ChunkCoord& chunk, std::vector<uint8_t> data) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_writes[key] = ChunkRegionStore::PendingWrite{chunk, std::move(data)};
+    }
+    m_wake.notify_one();
+}
+
+bool ChunkIOQueue::CancelRead(uint64_t key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_reads.begin(), m_reads.end(), [key](const ReadRequest& r) { return r.key == key; });
+    if (it == m_reads.end()) return false;
+    m_reads.erase(it);
+    std::make_heap(m_reads.begin(), m_reads.end(), Farther);
+    return true;
+}
+
+void ChunkIOQueue::SetViewer(const WorldPos& viewer) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_viewer = viewer;
+    for (auto& r : m_reads) r.distance = Distance(r.position, viewer);
+    std::make_heap(m_reads.begin(), m_reads.end(), Farther);
+}
+
+std::vector<ChunkIOResult> ChunkIOQueue::TakeCompleted() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<ChunkIOResult> out;
+    out.swap(m_completed);
+    return out;
+}
+
+bool ChunkIOQueue::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_paused = false;
+    m_wake.notify_one();
+    m_idle.wait(lock, [this] { return Idle(); });
+    bool ok = !m_writeFailed;
+    m_writeFailed = false;
+    return ok;
+}
+
+void ChunkIOQueue::SetPaused(bool paused) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_paused = paused;
+    }
+    m_wake.notify_one();
+}
+
+size_t ChunkIOQueue::PendingReads() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_reads.size();
+}
+
+size_t ChunkIOQueue::PendingWrites() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_writes.size();
+}
+
+uint64_t ChunkIOQueue::CompletedReads() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_completedReads;
+}
+
+uint64_t ChunkIOQueue::CompletedWrites() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_completedWrites;
+}
+
+void ChunkIOQueue::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this] {
+            return m_stop || (!m_paused && (!m_reads.empty() || !m_writes.empty()));
+        });
+        // Shutdown finishes writes; reads nobody will apply are dropped
+        if (m_stop && m_writes.empty()) break;
+
+        // Every queued write goes before the next read, so a chunk read
+        // back after being unloaded always sees its latest data
+        std::vector<ChunkRegionStore::PendingWrite> writes;
+        writes.reserve(m_writes.size());
+        for (auto& [key, w] : m_writes) writes.push_back(std::move(w));
+        m_writes.clear();
+
+        std::optional<ReadRequest> read;
+        if (!m_stop && !m_reads.empty()) {
+            std::pop_heap(m_reads.begin(), m_reads.end(), Farther);
+            read = m_reads.back();
+            m_reads.pop_back();
+        }
+        m_busy = true;
+        lock.unlock();
+
+        size_t failed = writes.empty() ? 0 : m_store.WriteBatch(writes);
+        ChunkIOResult result;
+        if (read) {
+            result.key = read->key;
+            result.coord = read->coord;
+            result.ok = m_store.Read(read->coord, result.data);
+        }
+
+        lock.lock();
+        m_busy = false;
+        m_completedWrites += writes.size() - failed;
+        if (failed > 0) m_writeFailed = true;
+        if (read) {
+            m_completed.push_back(std::move(result));
+            m_completedReads++;
+        }
+        if (Idle()) m_idle.notify_all();
+    }
+    m_idle.notify_all();
+}
+
+}
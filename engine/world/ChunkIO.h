@@ -0,0 +1,145 @@
+#pragma once
+// ============================================================
+// Atlas Chunk I/O — region files and a background I/O queue
+// ============================================================
+//
+// Cached chunks live in region files: one file per 16 x 16 block
+// of chunks (x/z) at a given y and LOD. Each file starts with a
+// fixed offset table, one slot per chunk. Chunk data is always
+// appended and a slot is only repointed once its new copy is fully
+// written, so a failed save leaves the previous copy readable. When
+// superseded copies outweigh the live data the region is rewritten
+// to a temporary file and renamed over the original.
+//
+// ChunkIOQueue owns a single worker thread. Writes are coalesced
+// per chunk and flushed one region file at a time; reads are
+// served nearest-to-viewer first. The game thread only queues
+// requests and collects completed reads — it never touches disk.
+
+#include "WorldLayout.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas::world {
+
+class ChunkRegionStore {
+public:
+    static constexpr int kRegionSide = 16;
+    static constexpr int kSlotCount = kRegionSide * kRegionSide;
+
+    explicit ChunkRegionStore(std::string directory);
+
+    struct PendingWrite {
+        ChunkCoord coord;
+        std::vector<uint8_t> data;
+    };
+
+    bool Write(const ChunkCoord& chunk, const std::vector<uint8_t>& data);
+    /// Write many chunks, opening each region file once.
+    /// Returns the number of chunks that failed.
+    size_t WriteBatch(const std::vector<PendingWrite>& writes);
+    bool Read(const ChunkCoord& chunk, std::vector<uint8_t>& out);
+
+    std::string RegionPath(const ChunkCoord& chunk) const;
+    const std::string& Directory() const { return m_directory; }
+
+private:
+    struct Slot {
+        uint64_t offset = 0;
+        uint32_t size = 0;
+        uint32_t capacity = 0;
+    };
+
+    static int SlotIndex(const ChunkCoord& chunk);
+    /// Rewrite @p path with only the data @p table points at.
+    static bool CompactRegion(const std::string& path, std::vector<Slot>& table);
+
+    std::string m_directory;
+    std::mutex m_mutex;           // serialises file access (worker + explicit sync calls)
+    bool m_directoryReady = false;
+};
+
+struct ChunkIOResult {
+    uint64_t key = 0;
+    ChunkCoord coord;
+    bool ok = false;
+    std::vector<uint8_t> data;
+};
+
+class ChunkIOQueue {
+public:
+    explicit ChunkIOQueue(const std::string& cacheDir);
+    /// Finishes queued writes; pending reads are dropped.
+    ~ChunkIOQueue();
+
+    ChunkIOQueue(const ChunkIOQueue&) = delete;
+    ChunkIOQueue& operator=(const ChunkIOQueue&) = delete;
+
+    /// Queue a read; @p position is the chunk's world position, used to
+    /// order reads by distance to the viewer.
+    void QueueRead(uint64_t key, const ChunkCoord& chunk, const WorldPos& position);
+    /// Queue a write. A newer write of the same chunk replaces an older
+    /// one that has not reached disk yet.
+    void QueueWrite(uint64_t key, const ChunkCoord& chunk, std::vector<uint8_t> data);
+    /// Drop a read that has not started yet.
+    bool CancelRead(uint64_t key);
+
+    /// Reorder pending reads around a new viewer position.
+    void SetViewer(const WorldPos& viewer);
+
+    /// Completed reads, in completion order. Never blocks on disk.
+    std::vector<ChunkIOResult> TakeCompleted();
+
+    /// Block until every queued request has finished (resumes a paused
+    /// queue). Returns false when a write failed since the last Flush.
+    bool Flush();
+
+    /// A paused worker leaves requests queued; for tests and loading screens.
+    void SetPaused(bool paused);
+
+    size_t PendingReads() const;
+    size_t PendingWrites() const;
+    uint64_t CompletedReads() const;
+    uint64_t CompletedWrites() const;
+
+    ChunkRegionStore& Store() { return m_store; }
+
+private:
+    struct ReadRequest {
+        uint64_t key;
+        ChunkCoord coord;
+        WorldPos position;
+        double distance;
+    };
+
+    void WorkerLoop();
+    bool Idle() const;
+    static bool Farther(const ReadRequest& a, const ReadRequest& b);
+
+    ChunkRegionStore m_store;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+
+    std::vector<ReadRequest> m_reads;                              // heap, nearest on top
+    std::unordered_map<uint64_t, ChunkRegionStore::PendingWrite> m_writes;
+    std::vector<ChunkIOResult> m_completed;
+    WorldPos m_viewer;
+
+    bool m_paused = false;
+    bool m_stop = false;
+    bool m_busy = false;
+    bool m_writeFailed = false;
+    uint64_t m_completedReads = 0;
+    uint64_t m_completedWrites = 0;
+
+    std::thread m_worker;
+};
+
+}
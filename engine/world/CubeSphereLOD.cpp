@@ -0,0 +1,163 @@
+#include "CubeSphereLOD.h"
+#include "HeightfieldMesher.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace atlas::world {
+
+CubeSphereLODSelector::CubeSphereLODSelector(const CubeSphereLayout& layout, const PlanetLODParams& params)
+    : m_layout(layout)
+    , m_params(params)
+{
+    m_params.maxNodes = std::max<size_t>(m_params.maxNodes, 6);
+    m_params.chunkResolution = std::max(m_params.chunkResolution, 1);
+}
+
+int CubeSphereLODSelector::MaxLod() const {
+    int maxLod = m_layout.MaxLOD();
+    if (m_params.maxLod >= 0) maxLod = std::min(maxLod, m_params.maxLod);
+    return maxLod;
+}
+
+double CubeSphereLODSelector::ScreenError(const ChunkCoord& chunk, const WorldPos& viewer) const {
+    // Geometric error is one heightfield quad of this LOD, projected at
+    // the distance to the node's bounds (a sphere of one chunk size)
+    double size = m_layout.ChunkWorldSize(chunk.lod);
+    double geometricError = size / m_params.chunkResolution;
+
+    WorldPos c = m_layout.ChunkToWorld(chunk);
+    double dx = c.x - viewer.x, dy = c.y - viewer.y, dz = c.z - viewer.z;
+    double dist = std::sqrt(dx * dx + dy * dy + dz * dz) - size;
+    dist = std::max(dist, geometricError * 1e-3);
+
+    double projection = m_params.screenHeight / (2.0 * std::tan(m_params.fovY * 0.5));
+    return geometricError * projection / dist;
+}
+
+// The leaf covering a node's area, if it is that node or an ancestor;
+// false when the area is split finer than the node
+bool CubeSphereLODSelector::FindLeaf(const ChunkCoord& chunk, ChunkCoord& leaf) const {
+    for (int up = 0; up <= chunk.lod; ++up) {
+        ChunkCoord ancestor{chunk.x >> up, chunk.y >> up, chunk.z, chunk.lod - up};
+        if (m_leaves.count(Key(ancestor))) {
+            leaf = ancestor;
+            return true;
+        }
+    }
+    return false;
+}
+
+void CubeSphereLODSelector::SplitLeaf(const ChunkCoord& node) {
+    m_leaves.erase(Key(node));
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 2; ++i) {
+            ChunkCoord child{node.x * 2 + i, node.y * 2 + j, node.z, node.lod + 1};
+            m_leaves[Key(child)] = child;
+        }
+    }
+}
+
+void CubeSphereLODSelector::MergeLeaf(const ChunkCoord& node) {
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 2; ++i) {
+            m_leaves.erase(Key(ChunkCoord{node.x * 2 + i, node.y * 2 + j, node.z, node.lod + 1}));
+        }
+    }
+    m_leaves[Key(node)] = node;
+}
+
+// Split a leaf, first splitting any coarser edge neighbour so the tree
+// stays restricted. Every split made is appended to @p log.
+void CubeSphereLODSelector::Split(const ChunkCoord& node, std::vector<ChunkCoord>& log) {
+    std::vector<ChunkCoord> neighbors;
+    m_layout.GetNeighbors(node, neighbors);
+    for (const auto& n : neighbors) {
+        ChunkCoord leaf;
+        while (FindLeaf(n, leaf) && leaf.lod < node.lod) {
+            Split(leaf, log);
+        }
+    }
+    SplitLeaf(node);
+    log.push_back(node);
+}
+
+const std::vector<PlanetLODNode>& CubeSphereLODSelector::Select(const WorldPos& viewer) {
+    m_leaves.clear();
+    m_splits = 0;
+    m_forcedSplits = 0;
+    m_budgetReached = false;
+
+    using Candidate = std::pair<double, ChunkCoord>;
+    auto lessError = [](const Candidate& a, const Candidate& b) { return a.first < b.first; };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(lessError)> queue(lessError);
+
+    int maxLod = MaxLod();
+    auto consider = [&](const ChunkCoord& chunk) {
+        if (chunk.lod < maxLod) queue.push({ScreenError(chunk, viewer), chunk});
+    };
+    for (int face = POS_X; face <= NEG_Z; ++face) {
+        ChunkCoord root{0, 0, face, 0};
+        m_leaves[Key(root)] = root;
+        consider(root);
+    }
+
+    std::vector<ChunkCoord> log;
+    while (!queue.empty()) {
+        auto [error, node] = queue.top();
+        if (error <= m_params.maxScreenError) break;
+        queue.pop();
+        if (!m_leaves.count(Key(node))) continue;   // split while balancing
+
+        log.clear();
+        Split(node, log);
+        if (m_leaves.size() > m_params.maxNodes) {
+            // Over budget, balancing included: undo and stop refining
+            for (auto it = log.rbegin(); it != log.rend(); ++it) MergeLeaf(*it);
+            m_budgetReached = true;
+            break;
+        }
+        m_splits += log.size();
+        m_forcedSplits += log.size() - 1;
+        for (const auto& split : log) {
+            for (int j = 0; j < 2; ++j) {
+                for (int i = 0; i < 2; ++i) {
+                    consider({split.x * 2 + i, split.y * 2 + j, split.z, split.lod + 1});
+                }
+            }
+        }
+    }
+
+    // Leaves with their neighbours' LOD; with the tree restricted a
+    // neighbour is at most one level coarser or finer
+    m_nodes.clear();
+    m_nodes.reserve(m_leaves.size());
+    std::vector<ChunkCoord> neighbors;
+    for (const auto& [key, chunk] : m_leaves) {
+        PlanetLODNode node;
+        node.chunk = chunk;
+        m_layout.GetNeighbors(chunk, neighbors);
+        for (int e = 0; e < 4; ++e) {
+            ChunkCoord leaf;
+            node.neighborLod[e] = FindLeaf(neighbors[e], leaf) ? leaf.lod : chunk.lod + 1;
+            if (node.neighborLod[e] < chunk.lod) node.stitchMask |= static_cast<uint8_t>(1 << e);
+        }
+        m_nodes.push_back(node);
+    }
+    std::sort(m_nodes.begin(), m_nodes.end(), [this](const PlanetLODNode& a, const PlanetLODNode& b) {
+        return Key(a.chunk) < Key(b.chunk);
+    });
+    return m_nodes;
+}
+
+std::vector<ChunkCoord> CubeSphereLODSelector::Chunks() const {
+    std::vector<ChunkCoord> chunks;
+    chunks.reserve(m_nodes.size());
+    for (const auto& node : m_nodes) chunks.push_back(node.chunk);
+    return chunks;
+}
+
+static_assert(kStitchNegX == 1 && kStitchPosX == 2 && kStitchNegZ == 4 && kStitchPosZ == 8,
+              "stitch bits follow the GetNeighbors edge order");
+
+}
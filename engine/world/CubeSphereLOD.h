@@ -0,0 +1,79 @@
+#pragma once
+// ============================================================
+// Atlas Cube-Sphere LOD — per-face quadtree terrain selection
+// ============================================================
+//
+// Each cube face is a quadtree whose nodes are CubeSphereLayout
+// chunks: the node (x, y, face, lod) has children (2x + i, 2y + j,
+// face, lod + 1). Nodes are split, worst screen-space error first,
+// until every leaf is under the pixel threshold, the layout's finest
+// LOD is reached or the node budget is spent. The selected leaves
+// cover the planet exactly once and form the chunk set to stream.
+//
+// The tree is kept restricted: leaves sharing an edge differ by at
+// most one LOD, splitting coarser neighbours first when needed. Each
+// leaf reports its neighbours' LOD and a stitch mask for
+// HeightfieldMesher, so edges against a coarser leaf are meshed
+// crack-free.
+
+#include "CubeSphereLayout.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace atlas::world {
+
+struct PlanetLODParams {
+    double fovY = 1.0471975512;     // vertical field of view, radians
+    double screenHeight = 1080.0;   // pixels
+    double maxScreenError = 2.0;    // pixels
+    int chunkResolution = 32;       // heightfield quads per chunk side
+    int maxLod = -1;                // -1 = the layout's MaxLOD()
+    size_t maxNodes = 1024;         // leaf budget, independent of radius
+};
+
+struct PlanetLODNode {
+    ChunkCoord chunk;
+    int neighborLod[4] = {0, 0, 0, 0};   // -x, +x, -y, +y
+    uint8_t stitchMask = 0;              // kStitch* bits of coarser edges
+};
+
+class CubeSphereLODSelector {
+public:
+    explicit CubeSphereLODSelector(const CubeSphereLayout& layout, const PlanetLODParams& params = {});
+
+    // Rebuild the selection for a viewer; leaves are ordered by chunk ID
+    const std::vector<PlanetLODNode>& Select(const WorldPos& viewer);
+
+    const std::vector<PlanetLODNode>& Nodes() const { return m_nodes; }
+    std::vector<ChunkCoord> Chunks() const;
+
+    // Projected error of a node, in pixels
+    double ScreenError(const ChunkCoord& chunk, const WorldPos& viewer) const;
+
+    const PlanetLODParams& Params() const { return m_params; }
+    int MaxLod() const;
+
+    // Stats of the last Select
+    size_t SplitCount() const { return m_splits; }
+    size_t ForcedSplitCount() const { return m_forcedSplits; }
+    bool BudgetReached() const { return m_budgetReached; }
+
+private:
+    uint64_t Key(const ChunkCoord& chunk) const { return m_layout.MakeChunkID(chunk).value; }
+    bool FindLeaf(const ChunkCoord& chunk, ChunkCoord& leaf) const;
+    void Split(const ChunkCoord& node, std::vector<ChunkCoord>& log);
+    void SplitLeaf(const ChunkCoord& node);
+    void MergeLeaf(const ChunkCoord& node);
+
+    const CubeSphereLayout& m_layout;
+    PlanetLODParams m_params;
+    std::unordered_map<uint64_t, ChunkCoord> m_leaves;
+    std::vector<PlanetLODNode> m_nodes;
+    size_t m_splits = 0;
+    size_t m_forcedSplits = 0;
+    bool m_budgetReached = false;
+};
+
+}
@@ -82,6 +82,12 @@ void CubeSphereLayout::GetNeighbors(const ChunkCoord& chunk, std::vector<ChunkCo
         int ny = chunk.y + dy[i];
         if (nx >= 0 && nx < gridSize && ny >= 0 && ny < gridSize) {
             out.push_back({nx, ny, chunk.z, chunk.lod});
+        } else {
+            // Across a face edge: project the would-be cell centre onto
+            // the sphere and find the chunk of the adjacent face there
+            double u = (static_cast<double>(nx) + 0.5) / gridSize * 2.0 - 1.0;
+            double v = (static_cast<double>(ny) + 0.5) / gridSize * 2.0 - 1.0;
+            out.push_back(WorldToChunk(CubeToSphere(static_cast<CubeFace>(chunk.z), u, v, radius), chunk.lod));
         }
     }
 }
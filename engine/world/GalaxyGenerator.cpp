@@ -1,12 +1,24 @@
 #include "GalaxyGenerator.h"
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 namespace atlas::world {
 
 static constexpr float kPi = 3.14159265358979323846f;
 static constexpr float kTwoPi = 2.0f * kPi;
 
+// Average systems per leaf cell when cellLevels is automatic
+static constexpr int kTargetSystemsPerCell = 32;
+static constexpr int kMaxCellLevels = 12;
+// Levels whose node masses are precomputed; deeper nodes sample on demand
+static constexpr int kMaxMassLevels = 6;
+static constexpr int kSubcells = 4;   // per axis, for placement inside a cell
+
+static uint64_t NodeKey(int level, uint32_t x, uint32_t z) {
+    return (static_cast<uint64_t>(level) << 58) | (static_cast<uint64_t>(x) << 29) | z;
+}
+
 uint32_t GalaxyGenerator::HashSeed(uint32_t seed, uint32_t index) {
     uint32_t h = seed ^ (index * 2654435761u);
     h ^= h >> 16;
@@ -19,76 +31,397 @@ float GalaxyGenerator::RandomFloat(uint32_t hash) {
     return static_cast<float>(hash & 0xFFFFFF) / static_cast<float>(0xFFFFFF);
 }
 
-std::vector<StarSystem> GalaxyGenerator::Generate(const GalaxyParams& params) {
-    std::vector<StarSystem> systems;
-    systems.reserve(static_cast<size_t>(params.systemCount));
+GalaxyGenerator::GalaxyGenerator(const GalaxyParams& params, size_t cacheCells)
+    : m_params(params), m_cacheCapacity(std::max<size_t>(cacheCells, 1))
+{
+    m_levels = params.cellLevels;
+    if (m_levels <= 0) {
+        m_levels = 0;
+        uint64_t cells = 1;
+        while (m_levels < kMaxCellLevels &&
+               static_cast<uint64_t>(std::max(params.systemCount, 0)) > cells * kTargetSystemsPerCell) {
+            m_levels++;
+            cells *= 4;
+        }
+    }
+    m_levels = std::min(m_levels, kMaxCellLevels);
+    m_cellSize = 2.0 * params.galaxyRadius / static_cast<double>(1u << m_levels);
 
-    for (int i = 0; i < params.systemCount; ++i) {
-        uint32_t h0 = HashSeed(params.seed, static_cast<uint32_t>(i) * 7 + 0);
-        uint32_t h1 = HashSeed(params.seed, static_cast<uint32_t>(i) * 7 + 1);
-        uint32_t h2 = HashSeed(params.seed, static_cast<uint32_t>(i) * 7 + 2);
-        uint32_t h3 = HashSeed(params.seed, static_cast<uint32_t>(i) * 7 + 3);
-        uint32_t h4 = HashSeed(params.seed, static_cast<uint32_t>(i) * 7 + 4);
-        uint32_t h5 = HashSeed(params.seed, static_cast<uint32_t>(i) * 7 + 5);
+    // Mass pyramid: sampled at the deepest precomputed level, summed upward
+    m_massLevels = std::min(m_levels, kMaxMassLevels);
+    m_massPyramid.resize(static_cast<size_t>(m_massLevels) + 1);
+    uint32_t side = 1u << m_massLevels;
+    double size = 2.0 * params.galaxyRadius / side;
+    auto& leaves = m_massPyramid[m_massLevels];
+    leaves.resize(static_cast<size_t>(side) * side);
+    for (uint32_t z = 0; z < side; ++z) {
+        for (uint32_t x = 0; x < side; ++x) {
+            leaves[z * side + x] = RectMass(NodeOrigin(x, m_massLevels), NodeOrigin(z, m_massLevels), size);
+        }
+    }
+    for (int level = m_massLevels - 1; level >= 0; --level) {
+        uint32_t s = 1u << level;
+        const auto& below = m_massPyramid[level + 1];
+        auto& masses = m_massPyramid[level];
+        masses.resize(static_cast<size_t>(s) * s);
+        for (uint32_t z = 0; z < s; ++z) {
+            for (uint32_t x = 0; x < s; ++x) {
+                size_t b = static_cast<size_t>(2 * z) * (2 * s) + 2 * x;
+                masses[z * s + x] = below[b] + below[b + 1] + below[b + 2 * s] + below[b + 2 * s + 1];
+            }
+        }
+    }
+}
 
-        // Choose arm and compute angle
-        int arm = static_cast<int>(h0 % static_cast<uint32_t>(params.armCount));
-        float armAngle = static_cast<float>(arm) / static_cast<float>(params.armCount) * kTwoPi;
+// Systems per unit area implied by the spiral model: distance d = u^2 * R
+// (u uniform), angle uniform in the core or within +/- armSpread of an arm.
+double GalaxyGenerator::Density(double x, double z) const {
+    double radius = m_params.galaxyRadius;
+    double d = std::sqrt(x * x + z * z);
+    if (d >= radius) return 0.0;
+    d = std::max(d, radius * 1e-9);
 
-        // Random distance from center (biased toward center)
-        float r = RandomFloat(h1);
-        r = r * r; // square for center bias
-        float dist = r * params.galaxyRadius;
+    double radial = 1.0 / (2.0 * std::sqrt(d * radius));
+    double angular;
+    if (d < m_params.coreRadius * radius) {
+        angular = 1.0 / kTwoPi;
+    } else {
+        int arms = std::max(m_params.armCount, 1);
+        double spread = std::max(static_cast<double>(m_params.armSpread), 1e-4);
+        double theta = std::atan2(z, x);
+        double rotation = d / radius * m_params.armRotation;
+        int hits = 0;
+        for (int arm = 0; arm < arms; ++arm) {
+            double delta = theta - (static_cast<double>(arm) / arms * kTwoPi + rotation);
+            delta = std::remainder(delta, static_cast<double>(kTwoPi));
+            if (std::abs(delta) <= spread) hits++;
+        }
+        angular = static_cast<double>(hits) / (arms * 2.0 * spread);
+    }
+    return radial * angular / d;
+}
 
-        // Spiral angle increases with distance
-        float spiralAngle = armAngle + dist / params.galaxyRadius * params.armRotation;
+double GalaxyGenerator::RectMass(double x0, double z0, double size) const {
+    // The density peaks at the centre; sample finer next to it
+    double nearX = std::max({x0, -(x0 + size), 0.0});
+    double nearZ = std::max({z0, -(z0 + size), 0.0});
+    int samples = (nearX * nearX + nearZ * nearZ < size * size) ? 16 : 4;
+    double step = size / samples;
+    double mass = 0.0;
+    for (int j = 0; j < samples; ++j) {
+        for (int i = 0; i < samples; ++i) {
+            mass += Density(x0 + (i + 0.5) * step, z0 + (j + 0.5) * step);
+        }
+    }
+    return mass * step * step;
+}
 
-        // Add spread/jitter
-        float spread = (RandomFloat(h2) - 0.5f) * 2.0f * params.armSpread;
+void GalaxyGenerator::SubcellMasses(int level, uint32_t x, uint32_t z, double masses[16]) const {
+    double size = 2.0 * m_params.galaxyRadius / static_cast<double>(1u << level) / kSubcells;
+    double x0 = NodeOrigin(x, level);
+    double z0 = NodeOrigin(z, level);
+    for (int j = 0; j < kSubcells; ++j) {
+        for (int i = 0; i < kSubcells; ++i) {
+            masses[j * kSubcells + i] = Density(x0 + (i + 0.5) * size, z0 + (j + 0.5) * size) * size * size;
+        }
+    }
+}
 
-        // Core density boost: systems near center ignore arm structure
-        bool isCore = dist < params.coreRadius * params.galaxyRadius;
-        float angle = isCore
-            ? RandomFloat(h3) * kTwoPi
-            : spiralAngle + spread;
+void GalaxyGenerator::ChildMasses(int level, uint32_t x, uint32_t z, double masses[4]) const {
+    int child = level + 1;
+    for (int c = 0; c < 4; ++c) {
+        uint32_t cx = 2 * x + (c & 1);
+        uint32_t cz = 2 * z + (c >> 1);
+        if (child <= m_massLevels) {
+            masses[c] = m_massPyramid[child][static_cast<size_t>(cz) * (1u << child) + cx];
+        } else {
+            double size = 2.0 * m_params.galaxyRadius / static_cast<double>(1u << child);
+            masses[c] = RectMass(NodeOrigin(cx, child), NodeOrigin(cz, child), size);
+        }
+    }
+}
+
+double GalaxyGenerator::NodeOrigin(uint32_t index, int level) const {
+    double size = 2.0 * m_params.galaxyRadius / static_cast<double>(1u << level);
+    return -static_cast<double>(m_params.galaxyRadius) + index * size;
+}
+
+uint32_t GalaxyGenerator::CellIndex(double coord) const {
+    double cell = std::floor((coord + m_params.galaxyRadius) / m_cellSize);
+    double last = static_cast<double>(CellsPerSide() - 1);
+    return static_cast<uint32_t>(std::clamp(cell, 0.0, last));
+}
+
+GalaxyGenerator::Node GalaxyGenerator::GetNode(int level, uint32_t x, uint32_t z) {
+    if (level == 0) {
+        return Node{static_cast<uint32_t>(std::max(m_params.systemCount, 0)), 0};
+    }
+    uint64_t key = NodeKey(level, x, z);
+    auto it = m_nodes.find(key);
+    if (it != m_nodes.end()) return it->second;
 
-        double x = static_cast<double>(dist * std::cos(angle));
-        double y = static_cast<double>((RandomFloat(h4) - 0.5f) * params.galaxyRadius * 0.05f); // thin disk
-        double z = static_cast<double>(dist * std::sin(angle));
+    // Split the parent's systems among its four children: whole shares
+    // by mass, the remainder one at a time weighted by the fractions
+    uint32_t px = x >> 1, pz = z >> 1;
+    Node parent = GetNode(level - 1, px, pz);
+    double masses[4];
+    ChildMasses(level - 1, px, pz, masses);
+    double total = masses[0] + masses[1] + masses[2] + masses[3];
+    if (total <= 0.0) {
+        std::fill(masses, masses + 4, 1.0);
+        total = 4.0;
+    }
+
+    uint32_t counts[4];
+    double fractions[4];
+    int64_t assigned = 0;
+    for (int c = 0; c < 4; ++c) {
+        double share = parent.count * (masses[c] / total);
+        counts[c] = static_cast<uint32_t>(std::floor(share));
+        fractions[c] = share - counts[c];
+        assigned += counts[c];
+    }
+    while (assigned > static_cast<int64_t>(parent.count)) {
+        int c = static_cast<int>(std::max_element(counts, counts + 4) - counts);
+        counts[c]--;
+        assigned--;
+    }
+    uint64_t parentKey = NodeKey(level - 1, px, pz);
+    uint32_t keyHash = HashSeed(HashSeed(m_params.seed ^ 0x5bd1e995u, static_cast<uint32_t>(parentKey)),
+                                static_cast<uint32_t>(parentKey >> 32));
+    for (uint32_t unit = 0; assigned < static_cast<int64_t>(parent.count); ++unit, ++assigned) {
+        double weight = fractions[0] + fractions[1] + fractions[2] + fractions[3];
+        int pick = static_cast<int>(std::max_element(masses, masses + 4) - masses);
+        if (weight > 0.0) {
+            double r = RandomFloat(HashSeed(keyHash, unit)) * weight;
+            for (int c = 0; c < 4; ++c) {
+                if (fractions[c] <= 0.0) continue;
+                pick = c;
+                if (r < fractions[c]) break;
+                r -= fractions[c];
+            }
+        }
+        counts[pick]++;
+        fractions[pick] = 0.0;
+    }
+
+    Node result;
+    uint64_t firstId = parent.firstId;
+    for (int c = 0; c < 4; ++c) {
+        uint32_t cx = 2 * px + (c & 1);
+        uint32_t cz = 2 * pz + (c >> 1);
+        Node child{counts[c], firstId};
+        m_nodes[NodeKey(level, cx, cz)] = child;
+        if (cx == x && cz == z) result = child;
+        firstId += counts[c];
+    }
+    return result;
+}
+
+std::vector<StarSystem> GalaxyGenerator::BuildCell(uint32_t cx, uint32_t cz, const Node& node) const {
+    std::vector<StarSystem> systems;
+    systems.reserve(node.count);
+
+    double masses[kSubcells * kSubcells];
+    SubcellMasses(m_levels, cx, cz, masses);
+    double total = 0.0;
+    for (double m : masses) total += m;
+
+    double x0 = NodeOrigin(cx, m_levels);
+    double z0 = NodeOrigin(cz, m_levels);
+    double subSize = m_cellSize / kSubcells;
+
+    for (uint32_t j = 0; j < node.count; ++j) {
+        uint64_t id = node.firstId + j;
+        uint32_t i = static_cast<uint32_t>(id);
+        uint32_t h0 = HashSeed(m_params.seed, i * 7 + 0);
+        uint32_t h1 = HashSeed(m_params.seed, i * 7 + 1);
+        uint32_t h2 = HashSeed(m_params.seed, i * 7 + 2);
+        uint32_t h3 = HashSeed(m_params.seed, i * 7 + 3);
+        uint32_t h4 = HashSeed(m_params.seed, i * 7 + 4);
+        uint32_t h5 = HashSeed(m_params.seed, i * 7 + 5);
+
+        // Pick a subcell by density, then a uniform point inside it
+        double x, z;
+        if (total > 0.0) {
+            double r = RandomFloat(h0) * total;
+            int sub = 0;
+            for (int s = 0; s < kSubcells * kSubcells; ++s) {
+                if (masses[s] <= 0.0) continue;
+                sub = s;
+                if (r < masses[s]) break;
+                r -= masses[s];
+            }
+            x = x0 + ((sub % kSubcells) + RandomFloat(h1)) * subSize;
+            z = z0 + ((sub / kSubcells) + RandomFloat(h2)) * subSize;
+        } else {
+            x = x0 + RandomFloat(h1) * m_cellSize;
+            z = z0 + RandomFloat(h2) * m_cellSize;
+        }
+
+        // Subcells straddling the rim can overhang the disk
+        double dist = std::sqrt(x * x + z * z);
+        if (dist > m_params.galaxyRadius) {
+            x *= m_params.galaxyRadius / dist;
+            z *= m_params.galaxyRadius / dist;
+        }
 
         StarSystem sys;
-        sys.id = static_cast<uint64_t>(i);
+        sys.id = id;
         sys.x = x;
-        sys.y = y;
+        sys.y = static_cast<double>((RandomFloat(h4) - 0.5f) * m_params.galaxyRadius * 0.05f); // thin disk
         sys.z = z;
         sys.luminosity = RandomFloat(h5);
         sys.starClass = static_cast<uint8_t>(h3 % 7);
         sys.planetCount = static_cast<int>(h4 % 12);
-
         systems.push_back(sys);
     }
-
     return systems;
 }
 
-std::vector<StarSystem> GalaxyGenerator::GenerateInRegion(
-    const GalaxyParams& params,
-    double minX, double minY, double maxX, double maxY,
-    int maxSystems)
-{
-    // Generate full galaxy and filter to region
-    // In production, this would use spatial hashing for efficiency
-    auto all = Generate(params);
+const std::vector<StarSystem>& GalaxyGenerator::Cell(uint32_t cx, uint32_t cz) {
+    uint64_t key = static_cast<uint64_t>(cz) * CellsPerSide() + cx;
+    auto it = m_cells.find(key);
+    if (it != m_cells.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+        return it->second.systems;
+    }
+
+    while (m_cells.size() >= m_cacheCapacity) {
+        m_cells.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+    m_lru.push_front(key);
+    auto& cell = m_cells[key];
+    cell.lru = m_lru.begin();
+    cell.systems = BuildCell(cx, cz, GetNode(m_levels, cx, cz));
+    m_cellsGenerated++;
+    return cell.systems;
+}
+
+uint32_t GalaxyGenerator::CellSystemCount(uint32_t cx, uint32_t cz) {
+    return GetNode(m_levels, cx, cz).count;
+}
+
+void GalaxyGenerator::SetCacheCapacity(size_t cells) {
+    m_cacheCapacity = std::max<size_t>(cells, 1);
+    while (m_cells.size() > m_cacheCapacity) {
+        m_cells.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+void GalaxyGenerator::CollectLeaves(int level, uint32_t x, uint32_t z,
+                                    uint32_t minCx, uint32_t minCz, uint32_t maxCx, uint32_t maxCz,
+                                    std::vector<std::pair<uint32_t, uint32_t>>& leaves) {
+    int shift = m_levels - level;
+    if (((x + 1) << shift) <= minCx || (x << shift) > maxCx) return;
+    if (((z + 1) << shift) <= minCz || (z << shift) > maxCz) return;
+    if (GetNode(level, x, z).count == 0) return;
+    if (level == m_levels) {
+        leaves.emplace_back(x, z);
+        return;
+    }
+    // Children in id order
+    for (int c = 0; c < 4; ++c) {
+        CollectLeaves(level + 1, 2 * x + (c & 1), 2 * z + (c >> 1), minCx, minCz, maxCx, maxCz, leaves);
+    }
+}
 
+std::vector<StarSystem> GalaxyGenerator::Region(double minX, double minZ, double maxX, double maxZ,
+                                                int maxSystems) {
     std::vector<StarSystem> result;
-    for (const auto& sys : all) {
-        if (sys.x >= minX && sys.x <= maxX && sys.z >= minY && sys.z <= maxY) {
-            result.push_back(sys);
-            if (static_cast<int>(result.size()) >= maxSystems) break;
+    double radius = m_params.galaxyRadius;
+    if (minX > maxX || minZ > maxZ || maxSystems <= 0) return result;
+    if (maxX < -radius || minX > radius || maxZ < -radius || minZ > radius) return result;
+
+    std::vector<std::pair<uint32_t, uint32_t>> leaves;
+    CollectLeaves(0, 0, 0, CellIndex(minX), CellIndex(minZ), CellIndex(maxX), CellIndex(maxZ), leaves);
+
+    for (const auto& [cx, cz] : leaves) {
+        for (const auto& sys : Cell(cx, cz)) {
+            if (sys.x >= minX && sys.x <= maxX && sys.z >= minZ && sys.z <= maxZ) {
+                result.push_back(sys);
+                if (static_cast<int>(result.size()) >= maxSystems) return result;
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<StarSystem> GalaxyGenerator::Nearest(double x, double y, double z, size_t k) {
+    std::vector<std::pair<double, StarSystem>> best;   // max-heap on distance
+    k = std::min(k, static_cast<size_t>(std::max(m_params.systemCount, 0)));
+    if (k == 0) return {};
+
+    auto farther = [](const std::pair<double, StarSystem>& a, const std::pair<double, StarSystem>& b) {
+        return a.first != b.first ? a.first < b.first : a.second.id < b.second.id;
+    };
+
+    int64_t side = CellsPerSide();
+    int64_t cx = CellIndex(x);
+    int64_t cz = CellIndex(z);
+
+    // Rings of cells around the query cell, until the next ring is
+    // farther than the k-th best so far
+    for (int64_t ring = 0; ring < side; ++ring) {
+        for (int64_t gz = cz - ring; gz <= cz + ring; ++gz) {
+            if (gz < 0 || gz >= side) continue;
+            bool edgeRow = (gz == cz - ring || gz == cz + ring);
+            int64_t step = edgeRow ? 1 : 2 * ring;
+            for (int64_t gx = cx - ring; gx <= cx + ring; gx += std::max<int64_t>(step, 1)) {
+                if (gx < 0 || gx >= side) continue;
+                auto ux = static_cast<uint32_t>(gx), uz = static_cast<uint32_t>(gz);
+                if (CellSystemCount(ux, uz) == 0) continue;
+                for (const auto& sys : Cell(ux, uz)) {
+                    double dx = sys.x - x, dy = sys.y - y, dz = sys.z - z;
+                    std::pair<double, StarSystem> entry{dx * dx + dy * dy + dz * dz, sys};
+                    if (best.size() < k) {
+                        best.push_back(entry);
+                        std::push_heap(best.begin(), best.end(), farther);
+                    } else if (farther(entry, best.front())) {
+                        std::pop_heap(best.begin(), best.end(), farther);
+                        best.back() = entry;
+                        std::push_heap(best.begin(), best.end(), farther);
+                    }
+                }
+            }
+        }
+
+        if (best.size() == k) {
+            // Distance from the query to the next ring; sides at the galaxy edge never bound
+            double inf = std::numeric_limits<double>::infinity();
+            double left = cx - ring > 0 ? x - NodeOrigin(static_cast<uint32_t>(cx - ring), m_levels) : inf;
+            double right = cx + ring + 1 < side ? NodeOrigin(static_cast<uint32_t>(cx + ring + 1), m_levels) - x : inf;
+            double bottom = cz - ring > 0 ? z - NodeOrigin(static_cast<uint32_t>(cz - ring), m_levels) : inf;
+            double top = cz + ring + 1 < side ? NodeOrigin(static_cast<uint32_t>(cz + ring + 1), m_levels) - z : inf;
+            double reach = std::max(0.0, std::min({left, right, bottom, top}));
+            if (reach * reach >= best.front().first) break;
         }
     }
 
+    std::sort_heap(best.begin(), best.end(), farther);
+    std::vector<StarSystem> result;
+    result.reserve(best.size());
+    for (const auto& entry : best) result.push_back(entry.second);
     return result;
 }
 
+std::vector<StarSystem> GalaxyGenerator::Generate(const GalaxyParams& params) {
+    // Every cell once, in id order; nothing is worth caching
+    GalaxyGenerator generator(params, 1);
+    double inf = std::numeric_limits<double>::infinity();
+    return generator.Region(-inf, -inf, inf, inf);
+}
+
+std::vector<StarSystem> GalaxyGenerator::GenerateInRegion(
+    const GalaxyParams& params,
+    double minX, double minY, double maxX, double maxY,
+    int maxSystems)
+{
+    // Only the cells overlapping the region are generated
+    GalaxyGenerator generator(params, 1);
+    return generator.Region(minX, minY, maxX, maxY, maxSystems);
+}
+
 }
@@ -1,7 +1,10 @@
 #pragma once
 #include <vector>
 #include <cstdint>
-#include <string>
+#include <climits>
+#include <cstddef>
+#include <list>
+#include <unordered_map>
 
 namespace atlas::world {
 
@@ -21,10 +24,51 @@ struct GalaxyParams {
     float coreRadius = 0.15f;       // fraction of galaxy radius for dense core
     float galaxyRadius = 50000.0f;  // light-years
     int systemCount = 10000;        // total star systems to generate
+    int cellLevels = 0;             // quadtree depth of generation cells, 0 = automatic
 };
 
+// ============================================================
+// Cell-based galaxy generation
+// ============================================================
+//
+// The galaxy square [-R, R] x [-R, R] (x/z plane) is a quadtree. The
+// root holds systemCount systems; each node splits its count among its
+// four children in proportion to the spiral density over them, with
+// the remainder rounded by a hash of (seed, node). Leaves (cells) place
+// their systems by the same density, and every system's attributes
+// derive from (seed, id). Ids are contiguous per cell in quadtree
+// order, so any cell is generated from (seed, cell) alone: a region
+// costs only the cells it overlaps, and the full galaxy is exactly the
+// union of its cells.
+
 class GalaxyGenerator {
 public:
+    explicit GalaxyGenerator(const GalaxyParams& params, size_t cacheCells = 1024);
+
+    const GalaxyParams& Params() const { return m_params; }
+    int CellLevels() const { return m_levels; }
+    uint32_t CellsPerSide() const { return 1u << m_levels; }
+    double CellSize() const { return m_cellSize; }
+
+    /// Systems in leaf cell (cx, cz), in id order. Generated on first use
+    /// and kept in an LRU cache; the reference is valid until the next
+    /// call that generates a cell.
+    const std::vector<StarSystem>& Cell(uint32_t cx, uint32_t cz);
+    /// Number of systems in a cell, without generating it.
+    uint32_t CellSystemCount(uint32_t cx, uint32_t cz);
+
+    /// Systems with x in [minX, maxX] and z in [minZ, maxZ], in id order,
+    /// truncated to maxSystems.
+    std::vector<StarSystem> Region(double minX, double minZ, double maxX, double maxZ,
+                                   int maxSystems = INT_MAX);
+
+    /// The k systems closest to (x, y, z), nearest first.
+    std::vector<StarSystem> Nearest(double x, double y, double z, size_t k);
+
+    void SetCacheCapacity(size_t cells);
+    size_t CachedCellCount() const { return m_cells.size(); }
+    uint64_t CellsGenerated() const { return m_cellsGenerated; }
+
     // Generate a full galaxy from parameters
     static std::vector<StarSystem> Generate(const GalaxyParams& params);
 
@@ -36,9 +80,41 @@ public:
     );
 
 private:
+    struct Node {
+        uint32_t count = 0;
+        uint64_t firstId = 0;
+    };
+    struct CachedCell {
+        std::vector<StarSystem> systems;
+        std::list<uint64_t>::iterator lru;
+    };
+
     // Deterministic pseudo-random from seed
     static uint32_t HashSeed(uint32_t seed, uint32_t index);
     static float RandomFloat(uint32_t hash);
+
+    double Density(double x, double z) const;
+    double RectMass(double x0, double z0, double size) const;
+    void SubcellMasses(int level, uint32_t x, uint32_t z, double masses[16]) const;
+    void ChildMasses(int level, uint32_t x, uint32_t z, double masses[4]) const;
+    double NodeOrigin(uint32_t index, int level) const;
+    Node GetNode(int level, uint32_t x, uint32_t z);
+    std::vector<StarSystem> BuildCell(uint32_t cx, uint32_t cz, const Node& node) const;
+    void CollectLeaves(int level, uint32_t x, uint32_t z,
+                       uint32_t minCx, uint32_t minCz, uint32_t maxCx, uint32_t maxCz,
+                       std::vector<std::pair<uint32_t, uint32_t>>& leaves);
+    uint32_t CellIndex(double coord) const;
+
+    GalaxyParams m_params;
+    int m_levels = 0;
+    int m_massLevels = 0;
+    double m_cellSize = 0.0;
+    std::vector<std::vector<double>> m_massPyramid;   // [level][z * side + x]
+    std::unordered_map<uint64_t, Node> m_nodes;
+    std::unordered_map<uint64_t, CachedCell> m_cells;
+    std::list<uint64_t> m_lru;                        // front = most recent
+    size_t m_cacheCapacity = 1024;
+    uint64_t m_cellsGenerated = 0;
 };
 
 }
@@ -3,7 +3,7 @@
 
 namespace atlas::world {
 
-MeshData HeightfieldMesher::BuildMesh(const Heightfield& hf, int lod) {
+MeshData HeightfieldMesher::BuildMesh(const Heightfield& hf, int lod, uint8_t stitchMask) {
     MeshData mesh;
 
     if (hf.size < 2 || hf.data.empty()) return mesh;
@@ -40,6 +40,21 @@ MeshData HeightfieldMesher::BuildMesh(const Heightfield& hf, int lod) {
         }
     }
 
+    // Stitch edges: the coarser neighbour only has the even vertices, so
+    // each odd one is pulled onto the line between its even neighbours
+    auto stitch = [&](int x0, int z0, int dx, int dz) {
+        for (int i = 1; i < gridSize; i += 2) {
+            size_t prev = (static_cast<size_t>(z0 + (i - 1) * dz) * vertsPerSide + x0 + (i - 1) * dx) * 3;
+            size_t cur  = (static_cast<size_t>(z0 + i * dz) * vertsPerSide + x0 + i * dx) * 3;
+            size_t next = (static_cast<size_t>(z0 + (i + 1) * dz) * vertsPerSide + x0 + (i + 1) * dx) * 3;
+            mesh.vertices[cur + 1] = 0.5f * (mesh.vertices[prev + 1] + mesh.vertices[next + 1]);
+        }
+    };
+    if (stitchMask & kStitchNegX) stitch(0, 0, 0, 1);
+    if (stitchMask & kStitchPosX) stitch(gridSize, 0, 0, 1);
+    if (stitchMask & kStitchNegZ) stitch(0, 0, 1, 0);
+    if (stitchMask & kStitchPosZ) stitch(0, gridSize, 1, 0);
+
     // Generate indices (two triangles per quad)
     mesh.indices.reserve(static_cast<size_t>(gridSize) * gridSize * 6);
 
@@ -103,4 +118,20 @@ void HeightfieldMesher::ComputeNormals(MeshData& mesh) {
     }
 }
 
+PackedMesh HeightfieldMesher::BuildPackedMesh(const Heightfield& hf, int lod,
+                                              const MeshPackOptions& options) {
+    return Pack(BuildMesh(hf, lod), options);
+}
+
+PackedMesh HeightfieldMesher::Pack(const MeshData& mesh, const MeshPackOptions& options) {
+    MeshSourceView view;
+    view.positions = mesh.vertices.data();
+    view.normals = mesh.normals.size() == mesh.vertices.size() ? mesh.normals.data() : nullptr;
+    view.vertexCount = mesh.vertices.size() / 3;
+    if (mesh.uvs.size() / 2 == view.vertexCount && view.vertexCount > 0) view.uvs = mesh.uvs.data();
+    view.indices = mesh.indices.data();
+    view.indexCount = mesh.indices.size();
+    return PackMesh(view, options);
+}
+
 }
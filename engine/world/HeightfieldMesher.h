@@ -1,5 +1,7 @@
 #pragma once
+#include "PackedMesh.h"
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
 namespace atlas::world {
@@ -15,6 +17,15 @@ struct Heightfield {
     }
 };
 
+// Edges of a chunk whose neighbour is one LOD coarser. Odd vertices on
+// a stitched edge are moved onto the coarse edge so the two meshes meet
+// without cracks. Bit order matches CubeSphereLayout::GetNeighbors
+// (-x, +x, -y, +y); chunk y runs along heightfield z.
+constexpr uint8_t kStitchNegX = 1 << 0;
+constexpr uint8_t kStitchPosX = 1 << 1;
+constexpr uint8_t kStitchNegZ = 1 << 2;
+constexpr uint8_t kStitchPosZ = 1 << 3;
+
 struct MeshData {
     std::vector<float> vertices;
     std::vector<float> normals;
@@ -25,10 +36,17 @@ struct MeshData {
 class HeightfieldMesher {
 public:
     // Build a grid mesh from a heightfield with LOD support (step = 1 << lod)
-    static MeshData BuildMesh(const Heightfield& hf, int lod = 0);
+    static MeshData BuildMesh(const Heightfield& hf, int lod = 0, uint8_t stitchMask = 0);
 
     // Compute per-vertex normals from triangle data
     static void ComputeNormals(MeshData& mesh);
+
+    // Build the grid mesh and emit it as a cache-optimized PackedMesh
+    static PackedMesh BuildPackedMesh(const Heightfield& hf, int lod = 0,
+                                      const MeshPackOptions& options = {});
+
+    // Quantize and interleave an existing mesh
+    static PackedMesh Pack(const MeshData& mesh, const MeshPackOptions& options = {});
 };
 
 }
@@ -0,0 +1,356 @@
+#include "PackedMesh.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace atlas::world {
+
+// ---- Quantization helpers ----
+
+static uint16_t QuantizeUnorm16(float v, float lo, float hi) {
+    float extent = hi - lo;
+    if (!(extent > 0.0f)) return 0;
+    float t = (v - lo) / extent;
+    t = std::min(1.0f, std::max(0.0f, t));
+    return static_cast<uint16_t>(std::lround(t * 65535.0f));
+}
+
+static float DequantizeUnorm16(uint16_t q, float lo, float hi) {
+    return lo + (hi - lo) * (static_cast<float>(q) / 65535.0f);
+}
+
+static int8_t QuantizeSnorm8(float v) {
+    v = std::min(1.0f, std::max(-1.0f, v));
+    return static_cast<int8_t>(std::lround(v * 127.0f));
+}
+
+static float SignNotZero(float v) { return v >= 0.0f ? 1.0f : -1.0f; }
+
+void EncodeOctahedral(float nx, float ny, float nz, int8_t& ox, int8_t& oy) {
+    float l1 = std::fabs(nx) + std::fabs(ny) + std::fabs(nz);
+    if (l1 <= 0.0f) {
+        ox = 0;
+        oy = 0;
+        return;
+    }
+    float x = nx / l1;
+    float y = ny / l1;
+    if (nz < 0.0f) {
+        // Fold the lower hemisphere over the diagonals
+        float fx = (1.0f - std::fabs(y)) * SignNotZero(x);
+        float fy = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = fx;
+        y = fy;
+    }
+    ox = QuantizeSnorm8(x);
+    oy = QuantizeSnorm8(y);
+}
+
+void DecodeOctahedral(int8_t ox, int8_t oy, float& nx, float& ny, float& nz) {
+    float x = static_cast<float>(ox) / 127.0f;
+    float y = static_cast<float>(oy) / 127.0f;
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+    if (z < 0.0f) {
+        float fx = (1.0f - std::fabs(y)) * SignNotZero(x);
+        float fy = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = fx;
+        y = fy;
+    }
+    float len = std::sqrt(x * x + y * y + z * z);
+    if (len > 0.0f) {
+        nx = x / len;
+        ny = y / len;
+        nz = z / len;
+    } else {
+        nx = 0.0f;
+        ny = 0.0f;
+        nz = 1.0f;
+    }
+}
+
+// ---- PackedMesh ----
+
+void PackedMesh::DecodePosition(size_t v, float out[3]) const {
+    uint16_t q[3];
+    std::memcpy(q, &vertexData[v * stride], sizeof(q));
+    for (int k = 0; k < 3; ++k) out[k] = DequantizeUnorm16(q[k], boundsMin[k], boundsMax[k]);
+}
+
+void PackedMesh::DecodeNormal(size_t v, float out[3]) const {
+    const uint8_t* p = &vertexData[v * stride + kPositionBytes];
+    DecodeOctahedral(static_cast<int8_t>(p[0]), static_cast<int8_t>(p[1]), out[0], out[1], out[2]);
+}
+
+void PackedMesh::DecodeUV(size_t v, float out[2]) const {
+    if (!hasUVs) {
+        out[0] = 0.0f;
+        out[1] = 0.0f;
+        return;
+    }
+    uint16_t q[2];
+    std::memcpy(q, &vertexData[v * stride + kPositionBytes + kNormalBytes], sizeof(q));
+    for (int k = 0; k < 2; ++k) out[k] = DequantizeUnorm16(q[k], uvMin[k], uvMax[k]);
+}
+
+size_t PackedMesh::MemoryBytes() const {
+    return vertexData.size() + indices16.size() * sizeof(uint16_t) + indices32.size() * sizeof(uint32_t);
+}
+
+// ---- Forsyth vertex cache optimization ----
+
+namespace {
+
+constexpr uint32_t kMaxCacheSize = 64;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+
+float VertexScore(int cachePos, uint32_t remainingTris, uint32_t cacheSize) {
+    if (remainingTris == 0) return -1.0f;  // no triangle needs this vertex
+
+    float score = 0.0f;
+    if (cachePos >= 0) {
+        if (cachePos < 3) {
+            // Used by the last triangle; a fixed score stops the order
+            // from strongly preferring one of its edges
+            score = kLastTriScore;
+        } else {
+            float scaler = 1.0f / static_cast<float>(cacheSize - 3);
+            score = std::pow(1.0f - static_cast<float>(cachePos - 3) * scaler, kCacheDecayPower);
+        }
+    }
+    // Boost vertices with few triangles left so they are finished off
+    score += kValenceBoostScale * std::pow(static_cast<float>(remainingTris), -kValenceBoostPower);
+    return score;
+}
+
+}  // namespace
+
+std::vector<uint32_t> OptimizeVertexCache(const uint32_t* indices, size_t indexCount,
+                                          size_t vertexCount, uint32_t cacheSize) {
+    size_t triCount = indexCount / 3;
+    std::vector<uint32_t> out;
+    out.reserve(triCount * 3);
+    if (triCount == 0) return out;
+    cacheSize = std::max<uint32_t>(4, std::min(cacheSize, kMaxCacheSize));
+
+    // Per-vertex triangle lists (CSR); the first `remaining` entries of each
+    // list are the triangles not yet emitted.
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (size_t i = 0; i < triCount * 3; ++i) remaining[indices[i]]++;
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + remaining[v];
+    std::vector<uint32_t> vertTris(offsets[vertexCount]);
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triCount; ++t) {
+            for (int k = 0; k < 3; ++k) vertTris[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<int> cachePos(vertexCount, -1);
+    std::vector<float> vertScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) vertScore[v] = VertexScore(-1, remaining[v], cacheSize);
+
+    std::vector<float> triScore(triCount, 0.0f);
+    std::vector<uint8_t> emitted(triCount, 0);
+    for (size_t t = 0; t < triCount; ++t) {
+        for (int k = 0; k < 3; ++k) triScore[t] += vertScore[indices[t * 3 + k]];
+    }
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(cacheSize + 3);
+    nextCache.reserve(cacheSize + 3);
+
+    size_t best = 0;
+    for (size_t t = 1; t < triCount; ++t) {
+        if (triScore[t] > triScore[best]) best = t;
+    }
+
+    size_t scanCursor = 0;
+    for (size_t emittedCount = 0; emittedCount < triCount; ++emittedCount) {
+        if (best == triCount) {
+            // Nothing useful in the cache: continue with the next unused
+            // triangle in input order
+            while (emitted[scanCursor]) ++scanCursor;
+            best = scanCursor;
+        }
+
+        size_t t = best;
+        emitted[t] = 1;
+        const uint32_t* tri = &indices[t * 3];
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = tri[k];
+            out.push_back(v);
+            // Swap the triangle out of the active part of v's list
+            uint32_t* list = &vertTris[offsets[v]];
+            for (uint32_t i = 0; i < remaining[v]; ++i) {
+                if (list[i] == t) {
+                    std::swap(list[i], list[remaining[v] - 1]);
+                    remaining[v]--;
+                    break;
+                }
+            }
+        }
+
+        // LRU: this triangle's vertices move to the front
+        nextCache.assign(tri, tri + 3);
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) nextCache.push_back(v);
+        }
+
+        // Rescore every vertex whose cache slot or valence changed and push
+        // the difference into its remaining triangles
+        for (size_t i = 0; i < nextCache.size(); ++i) {
+            uint32_t v = nextCache[i];
+            int pos = i < cacheSize ? static_cast<int>(i) : -1;
+            cachePos[v] = pos;
+            float score = VertexScore(pos, remaining[v], cacheSize);
+            float delta = score - vertScore[v];
+            vertScore[v] = score;
+            const uint32_t* list = &vertTris[offsets[v]];
+            for (uint32_t j = 0; j < remaining[v]; ++j) triScore[list[j]] += delta;
+        }
+
+        if (nextCache.size() > cacheSize) nextCache.resize(cacheSize);
+        std::swap(cache, nextCache);
+
+        // Next triangle: best candidate touching a cached vertex
+        best = triCount;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            const uint32_t* list = &vertTris[offsets[v]];
+            for (uint32_t j = 0; j < remaining[v]; ++j) {
+                uint32_t c = list[j];
+                if (triScore[c] > bestScore || (triScore[c] == bestScore && c < best)) {
+                    bestScore = triScore[c];
+                    best = c;
+                }
+            }
+        }
+    }
+
+    return out;
+}
+
+float ComputeACMR(const uint32_t* indices, size_t indexCount, uint32_t cacheSize) {
+    size_t triCount = indexCount / 3;
+    if (triCount == 0 || cacheSize == 0) return 0.0f;
+
+    std::vector<uint32_t> fifo(cacheSize, 0xFFFFFFFFu);
+    size_t head = 0;
+    size_t misses = 0;
+    for (size_t i = 0; i < triCount * 3; ++i) {
+        uint32_t v = indices[i];
+        if (std::find(fifo.begin(), fifo.end(), v) != fifo.end()) continue;
+        fifo[head] = v;
+        head = (head + 1) % cacheSize;
+        misses++;
+    }
+    return static_cast<float>(misses) / static_cast<float>(triCount);
+}
+
+// ---- Packing ----
+
+PackedMesh PackMesh(const MeshSourceView& source, const MeshPackOptions& options) {
+    PackedMesh mesh;
+    size_t vc = source.vertexCount;
+    mesh.hasUVs = source.uvs != nullptr;
+    mesh.stride = PackedMesh::kPositionBytes + PackedMesh::kNormalBytes +
+                  (mesh.hasUVs ? PackedMesh::kUVBytes : 0);
+
+    // Bounds
+    if (vc > 0) {
+        for (int k = 0; k < 3; ++k) {
+            mesh.boundsMin[k] = mesh.boundsMax[k] = source.positions[k];
+        }
+        for (size_t v = 0; v < vc; ++v) {
+            const float* p = source.positions + v * source.positionStride;
+            for (int k = 0; k < 3; ++k) {
+                mesh.boundsMin[k] = std::min(mesh.boundsMin[k], p[k]);
+                mesh.boundsMax[k] = std::max(mesh.boundsMax[k], p[k]);
+            }
+        }
+        if (mesh.hasUVs) {
+            for (int k = 0; k < 2; ++k) mesh.uvMin[k] = mesh.uvMax[k] = source.uvs[k];
+            for (size_t v = 0; v < vc; ++v) {
+                const float* uv = source.uvs + v * source.uvStride;
+                for (int k = 0; k < 2; ++k) {
+                    mesh.uvMin[k] = std::min(mesh.uvMin[k], uv[k]);
+                    mesh.uvMax[k] = std::max(mesh.uvMax[k], uv[k]);
+                }
+            }
+        }
+    }
+
+    // Triangle order
+    std::vector<uint32_t> order;
+    if (options.optimizeVertexCache) {
+        order = OptimizeVertexCache(source.indices, source.indexCount, vc, options.cacheSize);
+    } else {
+        order.assign(source.indices, source.indices + (source.indexCount / 3) * 3);
+    }
+
+    // Vertex order: first use in the index stream, unreferenced vertices last
+    static constexpr uint32_t kUnassigned = 0xFFFFFFFFu;
+    std::vector<uint32_t> remap(vc, kUnassigned);
+    std::vector<uint32_t> sourceOf;
+    sourceOf.reserve(vc);
+    if (options.optimizeVertexFetch) {
+        for (uint32_t& idx : order) {
+            if (remap[idx] == kUnassigned) {
+                remap[idx] = static_cast<uint32_t>(sourceOf.size());
+                sourceOf.push_back(idx);
+            }
+            idx = remap[idx];
+        }
+        for (size_t v = 0; v < vc; ++v) {
+            if (remap[v] == kUnassigned) {
+                remap[v] = static_cast<uint32_t>(sourceOf.size());
+                sourceOf.push_back(static_cast<uint32_t>(v));
+            }
+        }
+    } else {
+        for (size_t v = 0; v < vc; ++v) sourceOf.push_back(static_cast<uint32_t>(v));
+    }
+
+    // Interleaved vertex stream
+    mesh.vertexData.resize(vc * mesh.stride);
+    for (size_t dst = 0; dst < vc; ++dst) {
+        size_t src = sourceOf[dst];
+        uint8_t* out = &mesh.vertexData[dst * mesh.stride];
+
+        const float* p = source.positions + src * source.positionStride;
+        uint16_t q[3];
+        for (int k = 0; k < 3; ++k) q[k] = QuantizeUnorm16(p[k], mesh.boundsMin[k], mesh.boundsMax[k]);
+        std::memcpy(out, q, sizeof(q));
+
+        int8_t o[2] = {0, 0};
+        if (source.normals) {
+            const float* n = source.normals + src * source.normalStride;
+            EncodeOctahedral(n[0], n[1], n[2], o[0], o[1]);
+        }
+        std::memcpy(out + PackedMesh::kPositionBytes, o, sizeof(o));
+
+        if (mesh.hasUVs) {
+            const float* uv = source.uvs + src * source.uvStride;
+            uint16_t quv[2];
+            for (int k = 0; k < 2; ++k) quv[k] = QuantizeUnorm16(uv[k], mesh.uvMin[k], mesh.uvMax[k]);
+            std::memcpy(out + PackedMesh::kPositionBytes + PackedMesh::kNormalBytes, quv, sizeof(quv));
+        }
+    }
+
+    // Index stream
+    if (vc <= 0x10000) {
+        mesh.indices16.reserve(order.size());
+        for (uint32_t idx : order) mesh.indices16.push_back(static_cast<uint16_t>(idx));
+    } else {
+        mesh.indices32 = std::move(order);
+    }
+
+    return mesh;
+}
+
+}
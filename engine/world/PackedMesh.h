@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace atlas::world {
+
+// Interleaved, quantized mesh shared by the terrain, heightfield and
+// procedural mesh generators.
+//
+// Vertex layout (stride 8, or 12 with UVs):
+//   uint16 x, y, z   position, unorm16 relative to [boundsMin, boundsMax]
+//   int8   ox, oy    normal, octahedral snorm8
+//   uint16 u, v      optional, unorm16 relative to [uvMin, uvMax]
+//
+// Indices are stored as uint16 whenever every vertex fits, else uint32.
+struct PackedMesh {
+    static constexpr uint32_t kPositionBytes = 6;
+    static constexpr uint32_t kNormalBytes = 2;
+    static constexpr uint32_t kUVBytes = 4;
+
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+    float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+    float uvMin[2] = {0.0f, 0.0f};
+    float uvMax[2] = {0.0f, 0.0f};
+
+    uint32_t stride = kPositionBytes + kNormalBytes;
+    bool hasUVs = false;
+    std::vector<uint8_t> vertexData;
+    std::vector<uint16_t> indices16;
+    std::vector<uint32_t> indices32;
+
+    size_t VertexCount() const { return stride ? vertexData.size() / stride : 0; }
+    size_t IndexCount() const { return indices32.empty() ? indices16.size() : indices32.size(); }
+    size_t TriangleCount() const { return IndexCount() / 3; }
+    bool Uses16BitIndices() const { return indices32.empty(); }
+    uint32_t Index(size_t i) const { return indices32.empty() ? indices16[i] : indices32[i]; }
+
+    void DecodePosition(size_t v, float out[3]) const;
+    void DecodeNormal(size_t v, float out[3]) const;
+    void DecodeUV(size_t v, float out[2]) const;
+
+    /// Bytes held by vertex and index storage.
+    size_t MemoryBytes() const;
+};
+
+// Strided read-only view over unpacked source attributes. Strides are in
+// floats and each pointer must address one float array, so SoA arrays
+// (stride 3) and interleaved float buffers can be packed without an
+// intermediate copy; structs of named floats cannot. uvs may be null.
+struct MeshSourceView {
+    const float* positions = nullptr;
+    size_t positionStride = 3;
+    const float* normals = nullptr;
+    size_t normalStride = 3;
+    const float* uvs = nullptr;
+    size_t uvStride = 2;
+    size_t vertexCount = 0;
+    const uint32_t* indices = nullptr;
+    size_t indexCount = 0;
+};
+
+struct MeshPackOptions {
+    bool optimizeVertexCache = true;   // Forsyth triangle reorder
+    bool optimizeVertexFetch = true;   // renumber vertices by first use
+    uint32_t cacheSize = 32;           // simulated post-transform cache
+};
+
+PackedMesh PackMesh(const MeshSourceView& source, const MeshPackOptions& options = {});
+
+/// Reorder triangles for post-transform vertex cache reuse (Forsyth's
+/// linear-speed algorithm). Returns a new index buffer of the same size.
+std::vector<uint32_t> OptimizeVertexCache(const uint32_t* indices, size_t indexCount,
+                                          size_t vertexCount, uint32_t cacheSize = 32);
+
+/// Average cache miss ratio (misses per triangle) for a FIFO cache of
+/// cacheSize entries. 3.0 is the worst case; ~0.5 is ideal for grids.
+float ComputeACMR(const uint32_t* indices, size_t indexCount, uint32_t cacheSize = 16);
+
+void EncodeOctahedral(float nx, float ny, float nz, int8_t& ox, int8_t& oy);
+void DecodeOctahedral(int8_t ox, int8_t oy, float& nx, float& ny, float& nz);
+
+}
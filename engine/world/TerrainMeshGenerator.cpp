@@ -108,4 +108,34 @@ TerrainMesh TerrainMeshGenerator::Generate(
     return mesh;
 }
 
+PackedMesh TerrainMeshGenerator::GeneratePacked(
+    const ChunkCoord& chunk,
+    int resolution,
+    float chunkSize,
+    const HeightFunc& heightFn,
+    const MeshPackOptions& options)
+{
+    return Pack(Generate(chunk, resolution, chunkSize, heightFn), options);
+}
+
+PackedMesh TerrainMeshGenerator::Pack(const TerrainMesh& mesh, const MeshPackOptions& options) {
+    // Walking Vertex members with a float stride would index past the
+    // end of each member's own object, so unpack into real float arrays
+    std::vector<float> positions, normals;
+    positions.reserve(mesh.vertices.size() * 3);
+    normals.reserve(mesh.vertices.size() * 3);
+    for (const Vertex& v : mesh.vertices) {
+        positions.insert(positions.end(), {v.x, v.y, v.z});
+        normals.insert(normals.end(), {v.nx, v.ny, v.nz});
+    }
+
+    MeshSourceView view;
+    view.positions = positions.data();
+    view.normals = normals.data();
+    view.vertexCount = mesh.vertices.size();
+    view.indices = mesh.indices.data();
+    view.indexCount = mesh.indices.size();
+    return PackMesh(view, options);
+}
+
 }
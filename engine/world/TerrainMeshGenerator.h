@@ -1,5 +1,6 @@
 #pragma once
 #include "WorldLayout.h"
+#include "PackedMesh.h"
 #include <vector>
 #include <functional>
 
@@ -28,6 +29,18 @@ public:
         const HeightFunc& heightFn = nullptr
     );
 
+    // Generate the chunk mesh and emit it as a cache-optimized PackedMesh
+    static PackedMesh GeneratePacked(
+        const ChunkCoord& chunk,
+        int resolution,
+        float chunkSize,
+        const HeightFunc& heightFn = nullptr,
+        const MeshPackOptions& options = {}
+    );
+
+    // Quantize and interleave an existing terrain mesh
+    static PackedMesh Pack(const TerrainMesh& mesh, const MeshPackOptions& options = {});
+
     // Compute a face normal for a triangle
     static void ComputeNormal(
         float ax, float ay, float az,
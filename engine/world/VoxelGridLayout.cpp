@@ -36,6 +36,14 @@ void VoxelGridLayout::GetNeighbors(const ChunkCoord& chunk, std::vector<ChunkCoo
     }
 }
 
+void VoxelGridLayout::GetStreamingNeighbors(const ChunkCoord& chunk, std::vector<ChunkCoord>& out) const {
+    out.clear();
+    out.push_back({chunk.x - 1, chunk.y, chunk.z, 0});
+    out.push_back({chunk.x + 1, chunk.y, chunk.z, 0});
+    out.push_back({chunk.x, chunk.y, chunk.z - 1, 0});
+    out.push_back({chunk.x, chunk.y, chunk.z + 1, 0});
+}
+
 float VoxelGridLayout::ChunkWorldSize(int /*lod*/) const {
     return static_cast<float>(chunkSize);
 }
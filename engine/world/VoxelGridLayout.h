@@ -11,6 +11,8 @@ public:
     WorldPos ChunkToWorld(const ChunkCoord& chunk) const override;
     ChunkID MakeChunkID(const ChunkCoord& chunk) const override;
     void GetNeighbors(const ChunkCoord& chunk, std::vector<ChunkCoord>& outNeighbors) const override;
+    // Streams the viewer's horizontal layer only
+    void GetStreamingNeighbors(const ChunkCoord& chunk, std::vector<ChunkCoord>& outNeighbors) const override;
 
     int MaxLOD() const override { return 0; }
     bool IsValidLOD(int lod) const override { return lod == 0; }
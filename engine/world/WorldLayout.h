@@ -35,6 +35,15 @@ public:
         std::vector<ChunkCoord>& outNeighbors
     ) const = 0;
 
+    // Neighbours the streamer grows its load ring through. Layouts that
+    // stream a single layer return a subset of GetNeighbors.
+    virtual void GetStreamingNeighbors(
+        const ChunkCoord& chunk,
+        std::vector<ChunkCoord>& outNeighbors
+    ) const {
+        GetNeighbors(chunk, outNeighbors);
+    }
+
     // LOD
     virtual int MaxLOD() const = 0;
     virtual bool IsValidLOD(int lod) const = 0;
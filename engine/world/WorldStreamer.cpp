@@ -1,8 +1,9 @@
 #include "WorldStreamer.h"
-#include <fstream>
+#include "ChunkIO.h"
+#include "../core/Profiler.h"
 #include <cmath>
 #include <algorithm>
-#include <filesystem>
+#include <deque>
 
 namespace atlas::world {
 
@@ -10,59 +11,193 @@ WorldStreamer::WorldStreamer(const WorldLayout& layout, const std::string& cache
     : m_layout(layout)
     , m_cacheDir(cacheDir)
 {
+    if (!m_cacheDir.empty()) {
+        m_io = std::make_unique<ChunkIOQueue>(m_cacheDir);
+    }
 }
 
+WorldStreamer::~WorldStreamer() = default;
+
 uint64_t WorldStreamer::MakeKey(const ChunkCoord& chunk) const {
     return m_layout.MakeChunkID(chunk).value;
 }
 
-std::string WorldStreamer::CacheFilePath(const ChunkCoord& chunk) const {
-    uint64_t key = MakeKey(chunk);
-    return m_cacheDir + "/chunk_" + std::to_string(key) + ".bin";
+double WorldStreamer::DistanceToViewer(const WorldPos& pos) const {
+    double dx = pos.x - m_viewerCenter.x;
+    double dy = pos.y - m_viewerCenter.y;
+    double dz = pos.z - m_viewerCenter.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Every state change goes through here so the loaded set and the
+// counters never need a scan.
+void WorldStreamer::SetState(uint64_t key, ChunkEntry& entry, ChunkState state) {
+    if (entry.state == state) return;
+
+    if (entry.state == ChunkState::Loaded) {
+        auto it = m_loadedPos.find(key);
+        m_loadedByDistance.erase({DistanceToViewer(it->second), key});
+        m_loadedPos.erase(it);
+    } else if (entry.state == ChunkState::Cached) {
+        m_cachedCount--;
+    }
+
+    if (state == ChunkState::Loaded) {
+        WorldPos pos = m_layout.ChunkToWorld(entry.coord);
+        m_loadedPos[key] = pos;
+        m_loadedByDistance.insert({DistanceToViewer(pos), key});
+    } else if (state == ChunkState::Cached) {
+        m_cachedCount++;
+    }
+    entry.state = state;
+}
+
+void WorldStreamer::SetReadPending(uint64_t key, ChunkEntry& entry, bool pending) {
+    entry.readPending = pending;
+    if (pending) {
+        m_pendingReads.insert(key);
+    } else {
+        m_pendingReads.erase(key);
+    }
 }
 
 void WorldStreamer::Update(const WorldPos& viewerPos, int lod, float loadRadius, float unloadRadius) {
-    // Find chunks within load radius and request them
-    ChunkCoord viewerChunk = m_layout.WorldToChunk(viewerPos, lod);
+    ATLAS_PROFILE_SCOPE("WorldStreamer.Update");
+    if (m_io) {
+        ApplyCompletedIO();
+        m_io->SetViewer(viewerPos);
+    }
 
-    float chunkSize = m_layout.ChunkWorldSize(lod);
-    if (chunkSize <= 0.0f) return;
+    if (m_layout.ChunkWorldSize(lod) <= 0.0f) return;
 
-    int range = static_cast<int>(std::ceil(loadRadius / chunkSize));
+    // Nothing to do until the viewer enters another chunk
+    ChunkCoord viewerChunk = m_layout.WorldToChunk(viewerPos, lod);
+    uint64_t viewerKey = MakeKey(viewerChunk);
+    if (m_hasViewer && viewerKey == m_viewerKey && lod == m_viewerLod &&
+        loadRadius == m_loadRadius && unloadRadius == m_unloadRadius) {
+        return;
+    }
+    m_hasViewer = true;
+    m_viewerKey = viewerKey;
+    m_viewerLod = lod;
+    m_loadRadius = loadRadius;
+    m_unloadRadius = unloadRadius;
+    m_viewerCenter = m_layout.ChunkToWorld(viewerChunk);
+    m_ringRebuilds++;
+
+    RebuildRing(viewerChunk);
+
+    // Drop the far end of the loaded set, sorted around the new centre
+    ResortLoaded();
+    while (!m_loadedByDistance.empty() && m_loadedByDistance.rbegin()->first > unloadRadius) {
+        UnloadChunk(m_chunks[m_loadedByDistance.rbegin()->second].coord);
+    }
 
-    // Request load for chunks within loadRadius
-    for (int dz = -range; dz <= range; ++dz) {
-        for (int dx = -range; dx <= range; ++dx) {
-            ChunkCoord candidate = {viewerChunk.x + dx, viewerChunk.y, viewerChunk.z + dz, lod};
-            WorldPos chunkWorld = m_layout.ChunkToWorld(candidate);
+    // Cache reads for chunks that left the unload radius are abandoned
+    std::vector<uint64_t> abandoned;
+    for (uint64_t key : m_pendingReads) {
+        if (DistanceToViewer(m_layout.ChunkToWorld(m_chunks[key].coord)) > unloadRadius) {
+            abandoned.push_back(key);
+        }
+    }
+    for (uint64_t key : abandoned) {
+        UnloadChunk(m_chunks[key].coord);
+    }
+}
 
-            double distX = chunkWorld.x - viewerPos.x;
-            double distZ = chunkWorld.z - viewerPos.z;
-            double dist = std::sqrt(distX * distX + distZ * distZ);
+void WorldStreamer::UpdateSelection(const WorldPos& viewerPos, const std::vector<ChunkCoord>& chunks) {
+    if (m_io) {
+        ApplyCompletedIO();
+        m_io->SetViewer(viewerPos);
+    }
 
-            if (dist <= loadRadius) {
-                RequestLoad(candidate);
-            }
+    // The next Update rebuilds its ring from scratch
+    m_hasViewer = false;
+    m_viewerCenter = viewerPos;
+    m_ringRebuilds++;
+
+    std::unordered_set<uint64_t> selection;
+    std::vector<std::pair<double, ChunkCoord>> entering;
+    selection.reserve(chunks.size());
+    for (const auto& chunk : chunks) {
+        uint64_t key = MakeKey(chunk);
+        if (!selection.insert(key).second) continue;
+        ChunkState state = GetChunkState(chunk);
+        if (state == ChunkState::Unloaded || state == ChunkState::Cached) {
+            entering.push_back({DistanceToViewer(m_layout.ChunkToWorld(chunk)), chunk});
+        }
+    }
+
+    // Everything resident or on its way in that left the selection goes
+    ResortLoaded();
+    std::vector<ChunkCoord> leaving;
+    for (const auto& [dist, key] : m_loadedByDistance) {
+        if (!selection.count(key)) leaving.push_back(m_chunks[key].coord);
+    }
+    for (uint64_t key : m_ring) {
+        auto it = m_chunks.find(key);
+        if (it != m_chunks.end() && it->second.state == ChunkState::Loading && !selection.count(key)) {
+            leaving.push_back(it->second.coord);
         }
     }
+    for (const auto& chunk : leaving) UnloadChunk(chunk);
+
+    std::sort(entering.begin(), entering.end(), [this](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first < b.first : MakeKey(a.second) < MakeKey(b.second);
+    });
+    m_ring = std::move(selection);
+    for (const auto& [dist, chunk] : entering) {
+        RequestLoad(chunk);
+    }
+}
 
-    // Unload chunks beyond unloadRadius
-    std::vector<uint64_t> toUnload;
-    for (auto& [key, entry] : m_chunks) {
-        if (entry.state == ChunkState::Loaded) {
-            WorldPos chunkWorld = m_layout.ChunkToWorld(entry.coord);
-            double distX = chunkWorld.x - viewerPos.x;
-            double distZ = chunkWorld.z - viewerPos.z;
-            double dist = std::sqrt(distX * distX + distZ * distZ);
+void WorldStreamer::ResortLoaded() {
+    m_loadedByDistance.clear();
+    for (const auto& [key, pos] : m_loadedPos) {
+        m_loadedByDistance.insert({DistanceToViewer(pos), key});
+    }
+}
 
-            if (dist > unloadRadius) {
-                toUnload.push_back(key);
+void WorldStreamer::RebuildRing(const ChunkCoord& viewerChunk) {
+    // Grow outward from the viewer's chunk; the ring is a connected
+    // patch, so stopping at the radius visits only its border beyond
+    std::unordered_set<uint64_t> ring;
+    std::unordered_set<uint64_t> outside;
+    std::vector<std::pair<double, ChunkCoord>> entering;
+    std::deque<ChunkCoord> frontier;
+    std::vector<ChunkCoord> neighbors;
+
+    auto visit = [&](const ChunkCoord& chunk, double dist) {
+        uint64_t key = MakeKey(chunk);
+        ring.insert(key);
+        frontier.push_back(chunk);
+        if (!m_ring.count(key)) entering.push_back({dist, chunk});
+    };
+    visit(viewerChunk, 0.0);
+
+    while (!frontier.empty()) {
+        ChunkCoord chunk = frontier.front();
+        frontier.pop_front();
+        m_layout.GetStreamingNeighbors(chunk, neighbors);
+        for (const auto& n : neighbors) {
+            uint64_t key = MakeKey(n);
+            if (ring.count(key) || outside.count(key)) continue;
+            double dist = DistanceToViewer(m_layout.ChunkToWorld(n));
+            if (dist <= m_loadRadius) {
+                visit(n, dist);
+            } else {
+                outside.insert(key);
             }
         }
     }
 
-    for (uint64_t key : toUnload) {
-        UnloadChunk(m_chunks[key].coord);
+    // Only chunks new to the ring are requested, nearest first
+    std::sort(entering.begin(), entering.end(), [this](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first < b.first : MakeKey(a.second) < MakeKey(b.second);
+    });
+    m_ring = std::move(ring);
+    for (const auto& [dist, chunk] : entering) {
+        RequestLoad(chunk);
     }
 }
 
@@ -74,19 +209,19 @@ bool WorldStreamer::RequestLoad(const ChunkCoord& chunk) {
         if (it->second.state == ChunkState::Loaded || it->second.state == ChunkState::Loading) {
             return false; // already loaded or loading
         }
-        if (it->second.state == ChunkState::Cached) {
-            // Try to load from cache
-            if (LoadChunkFromCache(chunk)) {
-                return true;
-            }
+        if (it->second.state == ChunkState::Cached && m_io) {
+            // Queue the cache read; the chunk is Loaded once it is applied
+            SetState(key, it->second, ChunkState::Loading);
+            SetReadPending(key, it->second, true);
+            m_io->QueueRead(key, chunk, m_layout.ChunkToWorld(chunk));
+            return true;
         }
     }
 
     // Create new entry in Loading state
-    ChunkEntry entry;
+    auto& entry = m_chunks[key];
     entry.coord = chunk;
-    entry.state = ChunkState::Loading;
-    m_chunks[key] = entry;
+    SetState(key, entry, ChunkState::Loading);
     return true;
 }
 
@@ -96,11 +231,11 @@ void WorldStreamer::SetChunkData(const ChunkCoord& chunk, const std::vector<uint
     if (it == m_chunks.end()) {
         ChunkEntry entry;
         entry.coord = chunk;
-        m_chunks[key] = entry;
-        it = m_chunks.find(key);
+        it = m_chunks.emplace(key, entry).first;
     }
     it->second.data = data;
-    it->second.state = ChunkState::Loaded;
+    SetReadPending(key, it->second, false);
+    SetState(key, it->second, ChunkState::Loaded);
 }
 
 void WorldStreamer::UnloadChunk(const ChunkCoord& chunk) {
@@ -108,12 +243,21 @@ void WorldStreamer::UnloadChunk(const ChunkCoord& chunk) {
     auto it = m_chunks.find(key);
     if (it == m_chunks.end()) return;
 
-    // Try to cache to disk first
-    if (!m_cacheDir.empty() && !it->second.data.empty()) {
-        SaveChunkToCache(chunk);
-        it->second.state = ChunkState::Cached;
+    if (it->second.readPending) {
+        // Still on disk: abandon the read
+        m_io->CancelRead(key);
+        SetReadPending(key, it->second, false);
+        SetState(key, it->second, ChunkState::Cached);
+        return;
+    }
+
+    // Hand the data to the I/O worker; the chunk reads back from disk
+    if (m_io && !it->second.data.empty()) {
+        m_io->QueueWrite(key, chunk, std::move(it->second.data));
         it->second.data.clear();
+        SetState(key, it->second, ChunkState::Cached);
     } else {
+        SetState(key, it->second, ChunkState::Unloaded);
         m_chunks.erase(it);
     }
 }
@@ -127,69 +271,67 @@ ChunkState WorldStreamer::GetChunkState(const ChunkCoord& chunk) const {
 
 std::vector<ChunkCoord> WorldStreamer::GetLoadedChunks() const {
     std::vector<ChunkCoord> result;
-    for (const auto& [key, entry] : m_chunks) {
-        if (entry.state == ChunkState::Loaded) {
-            result.push_back(entry.coord);
-        }
+    result.reserve(m_loadedByDistance.size());
+    for (const auto& [dist, key] : m_loadedByDistance) {
+        result.push_back(m_chunks.at(key).coord);
     }
     return result;
 }
 
 bool WorldStreamer::SaveChunkToCache(const ChunkCoord& chunk) const {
-    if (m_cacheDir.empty()) return false;
+    if (!m_io) return false;
 
     uint64_t key = MakeKey(chunk);
     auto it = m_chunks.find(key);
     if (it == m_chunks.end() || it->second.data.empty()) return false;
 
-    std::filesystem::create_directories(m_cacheDir);
-
-    std::ofstream file(CacheFilePath(chunk), std::ios::binary);
-    if (!file.is_open()) return false;
-
-    file.write(reinterpret_cast<const char*>(it->second.data.data()),
-               static_cast<std::streamsize>(it->second.data.size()));
-    return file.good();
+    m_io->QueueWrite(key, chunk, it->second.data);
+    return m_io->Flush();
 }
 
 bool WorldStreamer::LoadChunkFromCache(const ChunkCoord& chunk) {
-    if (m_cacheDir.empty()) return false;
-
-    std::string path = CacheFilePath(chunk);
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) return false;
+    if (!m_io) return false;
 
-    auto size = file.tellg();
-    if (size <= 0) return false;
-    file.seekg(0);
-
-    std::vector<uint8_t> data(static_cast<size_t>(size));
-    file.read(reinterpret_cast<char*>(data.data()), size);
+    uint64_t key = MakeKey(chunk);
+    m_io->CancelRead(key);
+    m_io->Flush();
 
-    if (!file.good()) return false;
+    std::vector<uint8_t> data;
+    if (!m_io->Store().Read(chunk, data)) return false;
 
-    uint64_t key = MakeKey(chunk);
     auto& entry = m_chunks[key];
     entry.coord = chunk;
     entry.data = std::move(data);
-    entry.state = ChunkState::Loaded;
+    SetReadPending(key, entry, false);
+    SetState(key, entry, ChunkState::Loaded);
     return true;
 }
 
-size_t WorldStreamer::LoadedCount() const {
-    size_t count = 0;
-    for (const auto& [key, entry] : m_chunks) {
-        if (entry.state == ChunkState::Loaded) ++count;
+size_t WorldStreamer::ApplyCompletedIO() {
+    if (!m_io) return 0;
+
+    size_t applied = 0;
+    for (auto& result : m_io->TakeCompleted()) {
+        auto it = m_chunks.find(result.key);
+        // Cancelled, unloaded or filled by SetChunkData meanwhile
+        if (it == m_chunks.end() || !it->second.readPending) continue;
+        SetReadPending(result.key, it->second, false);
+        if (result.ok) {
+            it->second.data = std::move(result.data);
+            SetState(result.key, it->second, ChunkState::Loaded);
+            applied++;
+        }
+        // A failed read leaves the chunk Loading, awaiting SetChunkData
     }
-    return count;
+    return applied;
+}
+
+size_t WorldStreamer::LoadedCount() const {
+    return m_loadedByDistance.size();
 }
 
 size_t WorldStreamer::CachedCount() const {
-    size_t count = 0;
-    for (const auto& [key, entry] : m_chunks) {
-        if (entry.state == ChunkState::Cached) ++count;
-    }
-    return count;
+    return m_cachedCount;
 }
 
 }
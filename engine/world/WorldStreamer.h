@@ -1,5 +1,7 @@
 #pragma once
 #include "WorldLayout.h"
+#include <memory>
+#include <set>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -19,15 +21,39 @@ struct ChunkEntry {
     ChunkCoord coord;
     ChunkState state = ChunkState::Unloaded;
     std::vector<uint8_t> data;   // raw chunk data
+    bool readPending = false;    // Loading from the disk cache
 };
 
+class ChunkIOQueue;
+
+// Update is incremental: the load ring is rebuilt only when the viewer
+// enters another chunk (or the LOD/radii change). The new ring is grown
+// from the viewer's chunk through the layout's streaming neighbours, so
+// it follows cube-sphere faces as well as flat grids. Chunks entering
+// the ring are requested nearest first; loaded chunks are kept sorted
+// by distance and those past unloadRadius are dropped from the far end,
+// so a chunk between the two radii stays loaded (hysteresis).
+//
+// UpdateSelection replaces the ring with a caller-chosen chunk set, so
+// resident chunks are bounded by the selection size.
+//
+// With a cache directory, unloads and cache loads go through a
+// background ChunkIOQueue: Update, RequestLoad and UnloadChunk only
+// queue work, and a chunk read from disk becomes Loaded when Update
+// (or ApplyCompletedIO) applies the finished read.
 class WorldStreamer {
 public:
     explicit WorldStreamer(const WorldLayout& layout, const std::string& cacheDir = "");
+    ~WorldStreamer();
 
     // Update streaming based on viewer position
     void Update(const WorldPos& viewerPos, int lod, float loadRadius, float unloadRadius);
 
+    // Stream an explicit chunk set, possibly spanning several LODs (e.g.
+    // a CubeSphereLODSelector selection): chunks entering the set are
+    // requested nearest first, chunks leaving it are unloaded
+    void UpdateSelection(const WorldPos& viewerPos, const std::vector<ChunkCoord>& chunks);
+
     // Request a specific chunk to be loaded
     bool RequestLoad(const ChunkCoord& chunk);
 
@@ -40,24 +66,52 @@ public:
     // Query chunk state
     ChunkState GetChunkState(const ChunkCoord& chunk) const;
 
-    // Get all loaded chunks
+    // Get all loaded chunks, nearest to the viewer's chunk first
     std::vector<ChunkCoord> GetLoadedChunks() const;
 
-    // Disk cache operations
+    // Synchronous disk cache operations; these wait for queued I/O
     bool SaveChunkToCache(const ChunkCoord& chunk) const;
     bool LoadChunkFromCache(const ChunkCoord& chunk);
 
+    // Apply reads the I/O worker has finished; returns chunks now Loaded
+    size_t ApplyCompletedIO();
+
+    // Background I/O queue, null without a cache directory
+    ChunkIOQueue* IOQueue() { return m_io.get(); }
+
     // Stats
     size_t LoadedCount() const;
     size_t CachedCount() const;
+    size_t RingSize() const { return m_ring.size(); }
+    uint64_t RingRebuildCount() const { return m_ringRebuilds; }
 
 private:
     const WorldLayout& m_layout;
     std::string m_cacheDir;
     std::unordered_map<uint64_t, ChunkEntry> m_chunks;
+    std::unique_ptr<ChunkIOQueue> m_io;
+
+    // Viewer state of the last ring rebuild
+    bool m_hasViewer = false;
+    uint64_t m_viewerKey = 0;
+    int m_viewerLod = 0;
+    float m_loadRadius = 0.0f;
+    float m_unloadRadius = 0.0f;
+    WorldPos m_viewerCenter;
+
+    std::unordered_set<uint64_t> m_ring;                        // inside loadRadius, or the selection
+    std::unordered_map<uint64_t, WorldPos> m_loadedPos;         // Loaded chunks
+    std::set<std::pair<double, uint64_t>> m_loadedByDistance;   // nearest first
+    std::unordered_set<uint64_t> m_pendingReads;                // readPending chunks
+    size_t m_cachedCount = 0;
+    uint64_t m_ringRebuilds = 0;
 
     uint64_t MakeKey(const ChunkCoord& chunk) const;
-    std::string CacheFilePath(const ChunkCoord& chunk) const;
+    double DistanceToViewer(const WorldPos& pos) const;
+    void SetState(uint64_t key, ChunkEntry& entry, ChunkState state);
+    void SetReadPending(uint64_t key, ChunkEntry& entry, bool pending);
+    void RebuildRing(const ChunkCoord& viewerChunk);
+    void ResortLoaded();
 };
 
 }
@@ -4,8 +4,11 @@
 #include "module/ModuleLoader.h"
 #include "module/IGameModule.h"
 #include "net/Replication.h"
+#include "net/SoakHarness.h"
 #include "rules/ServerRules.h"
 #include "assets/AssetRegistry.h"
+#include <charconv>
+#include <cstring>
 #include <iostream>
 #include <string>
 
@@ -17,11 +20,64 @@ static void PrintUsage() {
     std::cout << "  --project <path>   Load a .atlas project file" << std::endl;
     std::cout << "  --module <path>    Load a game module (shared library)" << std::endl;
     std::cout << "  --help             Show this help message" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Soak testing (in-process server with simulated clients):" << std::endl;
+    std::cout << "  --soak <clients>        Run N clients and report tick times and traffic" << std::endl;
+    std::cout << "  --soak-ramp <max>       Double the client count until the tick budget is missed" << std::endl;
+    std::cout << "  --soak-ticks <n>        Ticks per run (default 300)" << std::endl;
+    std::cout << "  --soak-entities <n>     Static world entities besides the players" << std::endl;
+    std::cout << "  --soak-replay <path>    Drive client input from a recorded replay" << std::endl;
+}
+
+// Whole-argument decimal parse; rejects signs, trailing text and
+// values above UINT32_MAX
+static bool ParseUInt32(const char* text, uint32_t& out) {
+    const char* end = text + std::strlen(text);
+    uint32_t value = 0;
+    auto [ptr, ec] = std::from_chars(text, end, value);
+    if (ec != std::errc() || ptr == text || ptr != end) return false;
+    out = value;
+    return true;
+}
+
+static int InvalidNumber(const std::string& option, const char* value) {
+    std::cerr << "Invalid value for " << option << ": '" << value
+              << "' (expected a whole number from 0 to 4294967295)" << std::endl;
+    std::cerr << "Run AtlasServer --help for usage." << std::endl;
+    return 1;
+}
+
+static int RunSoak(atlas::net::SoakConfig cfg, uint32_t rampMax, const std::string& replayPath) {
+    atlas::net::SoakHarness harness(cfg);
+    if (!replayPath.empty() && !harness.LoadInputScript(replayPath)) {
+        std::cerr << "Failed to load replay: " << replayPath << std::endl;
+        return 1;
+    }
+
+    if (rampMax == 0) {
+        std::cout << harness.Run().Summary() << std::endl;
+        return 0;
+    }
+
+    auto ramp = atlas::net::SoakHarness::Ramp(cfg, rampMax, harness.InputScript());
+    for (const auto& run : ramp.runs) {
+        std::cout << run.Summary() << std::endl;
+    }
+    if (ramp.firstMissedClients > 0) {
+        std::cout << "Tick budget missed at " << ramp.firstMissedClients << " clients" << std::endl;
+    } else {
+        std::cout << "Tick budget held up to " << rampMax << " clients" << std::endl;
+    }
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
     std::string projectPath;
     std::string modulePath;
+    atlas::net::SoakConfig soak;
+    bool soakRequested = false;
+    uint32_t soakRampMax = 0;
+    std::string soakReplay;
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -29,6 +85,18 @@ int main(int argc, char* argv[]) {
             projectPath = argv[++i];
         } else if (arg == "--module" && i + 1 < argc) {
             modulePath = argv[++i];
+        } else if (arg == "--soak" && i + 1 < argc) {
+            if (!ParseUInt32(argv[++i], soak.clients)) return InvalidNumber(arg, argv[i]);
+            soakRequested = true;
+        } else if (arg == "--soak-ramp" && i + 1 < argc) {
+            if (!ParseUInt32(argv[++i], soakRampMax)) return InvalidNumber(arg, argv[i]);
+            soakRequested = true;
+        } else if (arg == "--soak-ticks" && i + 1 < argc) {
+            if (!ParseUInt32(argv[++i], soak.ticks)) return InvalidNumber(arg, argv[i]);
+        } else if (arg == "--soak-entities" && i + 1 < argc) {
+            if (!ParseUInt32(argv[++i], soak.worldEntities)) return InvalidNumber(arg, argv[i]);
+        } else if (arg == "--soak-replay" && i + 1 < argc) {
+            soakReplay = argv[++i];
         } else if (arg == "--help") {
             PrintUsage();
             return 0;
@@ -37,6 +105,7 @@ int main(int argc, char* argv[]) {
 
     atlas::EngineConfig cfg;
     cfg.mode = atlas::EngineMode::Server;
+    cfg.asyncLogging = true;   // log bursts must not stall the tick thread
 
     // Load project descriptor if specified
     if (!projectPath.empty()) {
@@ -49,6 +118,11 @@ int main(int argc, char* argv[]) {
         cfg.assetRoot = atlas::project::ProjectManager::Get().Descriptor().assets.root;
     }
 
+    if (soakRequested) {
+        soak.tickRate = cfg.tickRate;
+        return RunSoak(soak, soakRampMax, soakReplay);
+    }
+
     atlas::Engine engine(cfg);
     engine.InitCore();
     engine.InitECS();
@@ -27,6 +27,20 @@ void test_component_update();
 void test_asset_binary_roundtrip();
 void test_asset_registry_scan();
 
+// File watcher tests
+void test_file_watcher_reports_writes();
+void test_file_watcher_debounce();
+void test_file_watcher_new_directory();
+void test_registry_watcher_reload();
+void test_registry_reload_dependents();
+
+// Server asset validation tests
+void test_asset_hash_stream();
+void test_asset_hash_file_chunked();
+void test_server_validate_all_parallel();
+void test_server_validate_strict_stops();
+void test_server_validate_hash_cache();
+
 // Marketplace importer tests
 void test_marketplace_registry();
 void test_itch_io_importer();
@@ -52,6 +66,9 @@ void test_cube_sphere_projection();
 void test_cube_sphere_chunk_roundtrip();
 void test_cube_sphere_neighbors();
 void test_cube_sphere_lod();
+void test_cube_sphere_face_edge_neighbors();
+void test_cube_sphere_lod_selection();
+void test_cube_sphere_lod_budget();
 void test_voxel_chunk_roundtrip();
 void test_voxel_neighbors();
 
@@ -76,6 +93,14 @@ void test_streamer_unload_chunk();
 void test_streamer_get_loaded_chunks();
 void test_streamer_disk_cache();
 void test_streamer_duplicate_request();
+void test_chunk_region_store();
+void test_chunk_io_priority();
+void test_streamer_async_cache();
+void test_streamer_frame_time();
+void test_streamer_incremental_ring();
+void test_streamer_hysteresis();
+void test_streamer_cube_sphere_faces();
+void test_streamer_lod_selection();
 
 // Galaxy tests
 void test_galaxy_system_count();
@@ -84,11 +109,21 @@ void test_galaxy_seed_variation();
 void test_galaxy_region_filter();
 void test_galaxy_unique_ids();
 void test_galaxy_star_classes();
+void test_galaxy_region_matches_full();
+void test_galaxy_lazy_cells();
+void test_galaxy_nearest();
 
 // Compiler tests
 void test_compile_constants_and_add();
 void test_compile_and_execute_full();
 void test_compile_multiply();
+void test_optimizer_constant_folding();
+void test_optimizer_branch_folding();
+void test_optimizer_jump_threading();
+void test_optimizer_cse();
+void test_optimizer_peephole_immediate();
+void test_optimizer_levels();
+void test_optimizer_randomized_verifier();
 
 // Engine tests
 void test_engine_init_and_shutdown();
@@ -102,6 +137,11 @@ void test_engine_ui_update_in_loop();
 // Logger tests
 void test_logger_creates_log_directory();
 void test_logger_writes_to_file();
+void test_logger_async_multithreaded();
+void test_logger_async_drop_policy();
+void test_logger_async_sink_logs_into_full_ring();
+void test_logger_level_filter();
+void test_logger_crash_drains_async();
 
 // Console tests
 void test_console_spawn_entity();
@@ -186,6 +226,15 @@ void test_plugin_registry_get_by_type();
 void test_heightfield_at();
 void test_heightfield_mesh_generation();
 void test_heightfield_mesh_lod();
+void test_heightfield_mesh_stitch();
+
+// Packed mesh tests
+void test_packed_mesh_octahedral_roundtrip();
+void test_packed_mesh_heightfield_chunk();
+void test_packed_mesh_terrain_chunk();
+void test_packed_mesh_vertex_cache_order();
+void test_packed_mesh_32bit_indices();
+void test_packed_mesh_procedural_output();
 
 // StrategyGraph tests
 void test_strategygraph_add_nodes();
@@ -276,6 +325,12 @@ void test_camera_orbit();
 void test_camera_movement();
 void test_camera_pitch_clamp();
 
+// Culling tests
+void test_culling_frustum_from_camera();
+void test_culling_soa_matches_scalar();
+void test_culling_occlusion_buffer();
+void test_culling_stage_occlusion();
+
 // Physics tests
 void test_physics_create_body();
 void test_physics_destroy_body();
@@ -291,6 +346,12 @@ void test_audio_play_pause_stop();
 void test_audio_volume();
 void test_audio_master_volume();
 void test_audio_looping();
+void test_audio_spsc_queue();
+void test_audio_mixer_plays_and_finishes();
+void test_audio_mixer_pitch_and_looping();
+void test_audio_mixer_spatial();
+void test_audio_wav_device_roundtrip();
+void test_audio_mixer_thread();
 
 // Gameplay mechanic tests
 void test_mechanic_register();
@@ -374,6 +435,10 @@ void test_material_graph_remove_node();
 void test_procedural_texture_generation();
 void test_procedural_texture_deterministic();
 void test_procedural_texture_non_repeating();
+void test_material_noise_stream_jump();
+void test_material_graph_tiled_matches_full();
+void test_material_graph_tiled_encoded();
+void test_material_graph_tiled_fallback();
 
 // LOD Baking Graph tests
 void test_lod_decimate_mesh();
@@ -386,6 +451,9 @@ void test_lod_graph_compile_empty();
 void test_lod_graph_execute_basic();
 void test_lod_graph_decimate_pipeline();
 void test_lod_graph_lod_chain_output();
+void test_lod_merge_vertices_spatial_hash();
+void test_lod_simplify_flat_grid();
+void test_lod_chain_parallel_deterministic();
 
 // UI Logic Graph tests
 void test_ui_logic_add_nodes();
@@ -408,6 +476,8 @@ void test_soundgraph_compile_single_node();
 void test_soundgraph_compile_chain();
 void test_soundgraph_execute();
 void test_soundgraph_deterministic();
+void test_soundgraph_block_phase_continuity();
+void test_soundgraph_envelope_gate();
 
 // BehaviorGraph tests
 void test_behaviorgraph_add_nodes();
@@ -456,6 +526,15 @@ void test_flow_codegen_edge_wiring();
 void test_flow_codegen_all_node_types();
 void test_flow_codegen_header_comment();
 
+// Flow native backend tests
+void test_flow_native_ir_hash();
+void test_flow_native_interpreter_fallback();
+void test_flow_native_source_escapes_name();
+void test_flow_native_build_and_load();
+void test_flow_native_build_paths_not_shell_expanded();
+void test_flow_native_cook();
+void test_flow_native_parallel_cook_colliding_names();
+
 // Flow Debugger tests
 void test_debugger_initial_state();
 void test_debugger_add_breakpoint();
@@ -608,6 +687,21 @@ void test_cooker_cook_all();
 void test_cooker_strip_editor_data();
 void test_cooker_clear_log();
 void test_cooker_progress_callback();
+void test_cooker_incremental_skip();
+void test_cooker_dependency_order();
+void test_cooker_dependency_failures();
+void test_cooker_duplicate_ids();
+void test_cooker_report();
+
+// Asset Archive tests
+void test_archive_round_trip();
+void test_archive_zero_copy_view();
+void test_archive_compression();
+void test_archive_detects_corruption();
+void test_archive_many_entries();
+void test_archive_move();
+void test_archive_registry_scan();
+void test_archive_packager_output();
 
 // Graph Editor Panel tests
 void test_graph_panel_no_graph();
@@ -944,6 +1038,34 @@ void test_job_tracer_different_order_different_hash();
 void test_job_tracer_compare_order();
 void test_job_tracer_max_history();
 void test_job_tracer_clear();
+
+// CPU profiler tests
+void test_cpu_profiler_nested_scopes();
+void test_cpu_profiler_disabled();
+void test_cpu_profiler_threads();
+void test_cpu_profiler_chrome_trace();
+void test_cpu_profiler_reused_ring_new_thread_id();
+void test_cpu_profiler_feeds_panels();
+
+// Benchmark harness tests
+void test_bench_compare_per_op_regression();
+void test_bench_results_json_keeps_ops();
+
+// Server soak harness tests
+void test_input_frame_encoding();
+void test_net_deliver_between_contexts();
+void test_soak_harness_run();
+void test_soak_harness_replay_script();
+void test_soak_harness_ramp();
+
+// Streaming replay format tests
+void test_replay_stream_round_trip();
+void test_replay_stream_random_access();
+void test_replay_stream_save_points();
+void test_replay_stream_recovers_unfinished_file();
+void test_replay_stream_rejects_corrupt_block();
+void test_replay_stream_loads_v3();
+void test_replay_timeline_seeks_file();
 void test_job_trace_panel_no_tracer();
 void test_job_trace_panel_consistent();
 void test_job_trace_panel_mismatch();
@@ -1202,6 +1324,15 @@ void test_det_anim_blend_tree();
 void test_det_anim_bone_mask();
 void test_det_anim_additive_blend();
 void test_det_anim_deterministic();
+void test_det_anim_crowd_matches_single();
+void test_det_anim_crowd_chunking_invariant();
+
+// Animation scheduler tests
+void test_anim_scheduler_rates_by_distance();
+void test_anim_scheduler_staggered();
+void test_anim_scheduler_interpolates();
+void test_anim_scheduler_budget();
+void test_anim_scheduler_graph_evaluator();
 
 // Collaborative Editor tests
 void test_collab_add_peer();
@@ -1276,6 +1407,9 @@ void test_kb_categories();
 void test_kb_tags();
 void test_kb_export_import();
 void test_kb_clear();
+void test_kb_search_bm25_ranking();
+void test_kb_index_incremental();
+void test_kb_export_import_index();
 
 // Game GUI Asset
 void test_gui_asset_create_widget();
@@ -1686,6 +1820,9 @@ void test_chunk_builder_mark_dirty();
 void test_chunk_builder_tiles_outside_chunk_ignored();
 void test_chunk_builder_deterministic();
 void test_chunk_builder_flip_flags();
+void test_tile_chunk_grid_storage();
+void test_chunk_builder_row_major_order();
+void test_chunk_builder_rebuild_dirty();
 
 // Tile Palette Panel
 void test_tile_palette_name();
@@ -1974,6 +2111,22 @@ int main() {
     test_asset_binary_roundtrip();
     test_asset_registry_scan();
 
+    // File Watcher
+    std::cout << "\n--- File Watcher ---" << std::endl;
+    test_file_watcher_reports_writes();
+    test_file_watcher_debounce();
+    test_file_watcher_new_directory();
+    test_registry_watcher_reload();
+    test_registry_reload_dependents();
+
+    // Server Asset Validation
+    std::cout << "\n--- Server Asset Validation ---" << std::endl;
+    test_asset_hash_stream();
+    test_asset_hash_file_chunked();
+    test_server_validate_all_parallel();
+    test_server_validate_strict_stops();
+    test_server_validate_hash_cache();
+
     // Networking
     std::cout << "\n--- Networking ---" << std::endl;
     test_net_init();
@@ -2020,6 +2173,22 @@ int main() {
     test_cooker_strip_editor_data();
     test_cooker_clear_log();
     test_cooker_progress_callback();
+    test_cooker_incremental_skip();
+    test_cooker_dependency_order();
+    test_cooker_dependency_failures();
+    test_cooker_duplicate_ids();
+    test_cooker_report();
+
+    // Asset Archive
+    std::cout << "\n--- Asset Archive ---" << std::endl;
+    test_archive_round_trip();
+    test_archive_zero_copy_view();
+    test_archive_compression();
+    test_archive_detects_corruption();
+    test_archive_many_entries();
+    test_archive_move();
+    test_archive_registry_scan();
+    test_archive_packager_output();
 
     // Graph Editor Panel
     std::cout << "\n--- Graph Editor Panel ---" << std::endl;
@@ -2045,6 +2214,9 @@ int main() {
     test_cube_sphere_chunk_roundtrip();
     test_cube_sphere_neighbors();
     test_cube_sphere_lod();
+    test_cube_sphere_face_edge_neighbors();
+    test_cube_sphere_lod_selection();
+    test_cube_sphere_lod_budget();
     test_voxel_chunk_roundtrip();
     test_voxel_neighbors();
 
@@ -2153,6 +2325,14 @@ int main() {
     test_streamer_get_loaded_chunks();
     test_streamer_disk_cache();
     test_streamer_duplicate_request();
+    test_chunk_region_store();
+    test_chunk_io_priority();
+    test_streamer_async_cache();
+    test_streamer_frame_time();
+    test_streamer_incremental_ring();
+    test_streamer_hysteresis();
+    test_streamer_cube_sphere_faces();
+    test_streamer_lod_selection();
 
     // Galaxy
     std::cout << "\n--- Galaxy Generator ---" << std::endl;
@@ -2162,12 +2342,22 @@ int main() {
     test_galaxy_region_filter();
     test_galaxy_unique_ids();
     test_galaxy_star_classes();
+    test_galaxy_region_matches_full();
+    test_galaxy_lazy_cells();
+    test_galaxy_nearest();
 
     // Compiler
     std::cout << "\n--- Graph Compiler ---" << std::endl;
     test_compile_constants_and_add();
     test_compile_and_execute_full();
     test_compile_multiply();
+    test_optimizer_constant_folding();
+    test_optimizer_branch_folding();
+    test_optimizer_jump_threading();
+    test_optimizer_cse();
+    test_optimizer_peephole_immediate();
+    test_optimizer_levels();
+    test_optimizer_randomized_verifier();
 
     // Engine
     std::cout << "\n--- Engine ---" << std::endl;
@@ -2183,6 +2373,11 @@ int main() {
     std::cout << "\n--- Logger ---" << std::endl;
     test_logger_creates_log_directory();
     test_logger_writes_to_file();
+    test_logger_async_multithreaded();
+    test_logger_async_drop_policy();
+    test_logger_async_sink_logs_into_full_ring();
+    test_logger_level_filter();
+    test_logger_crash_drains_async();
 
     // Console
     std::cout << "\n--- Console ---" << std::endl;
@@ -2277,6 +2472,16 @@ int main() {
     test_heightfield_at();
     test_heightfield_mesh_generation();
     test_heightfield_mesh_lod();
+    test_heightfield_mesh_stitch();
+
+    // Packed mesh
+    std::cout << "\n--- Packed Mesh ---" << std::endl;
+    test_packed_mesh_octahedral_roundtrip();
+    test_packed_mesh_heightfield_chunk();
+    test_packed_mesh_terrain_chunk();
+    test_packed_mesh_vertex_cache_order();
+    test_packed_mesh_32bit_indices();
+    test_packed_mesh_procedural_output();
 
     // StrategyGraph
     std::cout << "\n--- Strategy Graph ---" << std::endl;
@@ -2378,6 +2583,13 @@ int main() {
     test_camera_movement();
     test_camera_pitch_clamp();
 
+    // Culling
+    std::cout << "\n--- Culling ---" << std::endl;
+    test_culling_frustum_from_camera();
+    test_culling_soa_matches_scalar();
+    test_culling_occlusion_buffer();
+    test_culling_stage_occlusion();
+
     // Physics
     std::cout << "\n--- Physics ---" << std::endl;
     test_physics_create_body();
@@ -2395,6 +2607,12 @@ int main() {
     test_audio_volume();
     test_audio_master_volume();
     test_audio_looping();
+    test_audio_spsc_queue();
+    test_audio_mixer_plays_and_finishes();
+    test_audio_mixer_pitch_and_looping();
+    test_audio_mixer_spatial();
+    test_audio_wav_device_roundtrip();
+    test_audio_mixer_thread();
 
     // Gameplay Mechanics
     std::cout << "\n--- Gameplay Mechanics ---" << std::endl;
@@ -2486,6 +2704,10 @@ int main() {
     test_procedural_texture_generation();
     test_procedural_texture_deterministic();
     test_procedural_texture_non_repeating();
+    test_material_noise_stream_jump();
+    test_material_graph_tiled_matches_full();
+    test_material_graph_tiled_encoded();
+    test_material_graph_tiled_fallback();
 
     // LOD Baking Graph
     std::cout << "\n--- LOD Baking Graph ---" << std::endl;
@@ -2499,6 +2721,9 @@ int main() {
     test_lod_graph_execute_basic();
     test_lod_graph_decimate_pipeline();
     test_lod_graph_lod_chain_output();
+    test_lod_merge_vertices_spatial_hash();
+    test_lod_simplify_flat_grid();
+    test_lod_chain_parallel_deterministic();
 
     // UI Logic Graph
     std::cout << "\n--- UI Logic Graph ---" << std::endl;
@@ -2523,6 +2748,8 @@ int main() {
     test_soundgraph_compile_chain();
     test_soundgraph_execute();
     test_soundgraph_deterministic();
+    test_soundgraph_block_phase_continuity();
+    test_soundgraph_envelope_gate();
 
     // Behavior Graph
     std::cout << "\n--- Behavior Graph ---" << std::endl;
@@ -2576,6 +2803,16 @@ int main() {
     test_flow_codegen_all_node_types();
     test_flow_codegen_header_comment();
 
+    // Flow Native Backend
+    std::cout << "\n--- Flow Native Backend ---" << std::endl;
+    test_flow_native_ir_hash();
+    test_flow_native_interpreter_fallback();
+    test_flow_native_source_escapes_name();
+    test_flow_native_build_and_load();
+    test_flow_native_build_paths_not_shell_expanded();
+    test_flow_native_cook();
+    test_flow_native_parallel_cook_colliding_names();
+
     // Flow Debugger
     std::cout << "\n--- Flow Debugger ---" << std::endl;
     test_debugger_initial_state();
@@ -3067,6 +3304,38 @@ int main() {
     test_job_trace_panel_mismatch();
     test_job_trace_panel_entries_at_tick();
 
+    // CPU Profiler
+    std::cout << "\n--- CPU Profiler ---" << std::endl;
+    test_cpu_profiler_nested_scopes();
+    test_cpu_profiler_disabled();
+    test_cpu_profiler_threads();
+    test_cpu_profiler_chrome_trace();
+    test_cpu_profiler_reused_ring_new_thread_id();
+    test_cpu_profiler_feeds_panels();
+
+    // Benchmark harness
+    std::cout << "\n--- Benchmark Harness ---" << std::endl;
+    test_bench_compare_per_op_regression();
+    test_bench_results_json_keeps_ops();
+
+    // Server soak harness
+    std::cout << "\n--- Server Soak Harness ---" << std::endl;
+    test_input_frame_encoding();
+    test_net_deliver_between_contexts();
+    test_soak_harness_run();
+    test_soak_harness_replay_script();
+    test_soak_harness_ramp();
+
+    // Streaming replay format
+    std::cout << "\n--- Streaming Replay Format ---" << std::endl;
+    test_replay_stream_round_trip();
+    test_replay_stream_random_access();
+    test_replay_stream_save_points();
+    test_replay_stream_recovers_unfinished_file();
+    test_replay_stream_rejects_corrupt_block();
+    test_replay_stream_loads_v3();
+    test_replay_timeline_seeks_file();
+
     // Component Category
     std::cout << "\n--- Component Category ---" << std::endl;
     test_component_category_defaults();
@@ -3280,6 +3549,16 @@ int main() {
     test_det_anim_bone_mask();
     test_det_anim_additive_blend();
     test_det_anim_deterministic();
+    test_det_anim_crowd_matches_single();
+    test_det_anim_crowd_chunking_invariant();
+
+    // Animation Scheduler
+    std::cout << "\n--- Animation Scheduler ---" << std::endl;
+    test_anim_scheduler_rates_by_distance();
+    test_anim_scheduler_staggered();
+    test_anim_scheduler_interpolates();
+    test_anim_scheduler_budget();
+    test_anim_scheduler_graph_evaluator();
 
     // Collaborative Editor
     std::cout << "\n--- Collaborative Editor ---" << std::endl;
@@ -3363,6 +3642,9 @@ int main() {
     test_kb_tags();
     test_kb_export_import();
     test_kb_clear();
+    test_kb_search_bm25_ranking();
+    test_kb_index_incremental();
+    test_kb_export_import_index();
 
     // Game GUI Asset
     std::cout << "\n--- Game GUI Asset ---" << std::endl;
@@ -3799,6 +4081,9 @@ int main() {
     test_chunk_builder_tiles_outside_chunk_ignored();
     test_chunk_builder_deterministic();
     test_chunk_builder_flip_flags();
+    test_tile_chunk_grid_storage();
+    test_chunk_builder_row_major_order();
+    test_chunk_builder_rebuild_dirty();
 
     // Tile Palette Panel
     std::cout << "\n--- Tile Palette Panel ---" << std::endl;
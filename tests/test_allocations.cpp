@@ -0,0 +1,92 @@
+// Allocation-counting tests. They replace the global operator new, so
+// they build as their own executable instead of changing allocation for
+// every suite in AtlasTests.
+
+#include "../engine/sound/SoundGraph.h"
+#include "../engine/sound/SoundNodes.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations made by the current thread while enabled, so
+// job worker threads cannot interfere.
+static thread_local bool t_countAllocations = false;
+static thread_local size_t t_allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    if (t_countAllocations) ++t_allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static atlas::sound::SoundGraph BuildStreamingGraph(atlas::sound::ParameterNode*& freq,
+                                                    atlas::sound::ParameterNode*& gain,
+                                                    atlas::sound::SoundNodeID& outId) {
+    using namespace atlas::sound;
+    SoundGraph graph;
+    auto f = std::make_unique<ParameterNode>(220.0f);
+    auto g = std::make_unique<ParameterNode>(0.5f);
+    freq = f.get();
+    gain = g.get();
+    auto freqId = graph.AddNode(std::move(f));
+    auto gainParamId = graph.AddNode(std::move(g));
+    auto osc1 = graph.AddNode(std::make_unique<OscillatorNode>());
+    auto osc2 = graph.AddNode(std::make_unique<OscillatorNode>());
+    auto mix = graph.AddNode(std::make_unique<MixNode>());
+    auto gainId = graph.AddNode(std::make_unique<GainNode>());
+    graph.AddNode(std::make_unique<EnvelopeNode>());
+    graph.AddEdge({freqId, 0, osc1, 0});
+    graph.AddEdge({osc1, 0, mix, 0});
+    graph.AddEdge({osc2, 0, mix, 1});
+    graph.AddEdge({mix, 0, gainId, 0});
+    graph.AddEdge({gainParamId, 0, gainId, 1});
+    outId = gainId;
+    return graph;
+}
+
+void test_soundgraph_block_no_allocations() {
+    using namespace atlas::sound;
+    ParameterNode* freq = nullptr;
+    ParameterNode* gain = nullptr;
+    SoundNodeID outId = 0;
+    SoundGraph graph = BuildStreamingGraph(freq, gain, outId);
+    SoundContext ctx{48000, 256, 7};
+    assert(graph.Compile(ctx));
+    assert(graph.IsPrepared());
+
+    t_allocationCount = 0;
+    t_countAllocations = true;
+    bool ok = true;
+    for (int block = 0; block < 64; ++block) {
+        if (block == 32) {
+            freq->Set(330.0f);
+            gain->Set(0.25f);
+        }
+        ok = ok && graph.Execute(ctx);
+    }
+    // Smaller blocks fit in the preallocated capacity
+    SoundContext small{48000, 64, 7};
+    ok = ok && graph.Execute(small);
+    t_countAllocations = false;
+
+    assert(ok);
+    assert(t_allocationCount == 0);
+    assert(graph.GetOutput(outId, 0)->data.size() == 64);
+    std::cout << "[PASS] test_soundgraph_block_no_allocations" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Atlas Allocation Tests ===" << std::endl;
+
+    std::cout << "\n--- SoundGraph ---" << std::endl;
+    test_soundgraph_block_no_allocations();
+
+    std::cout << "\n=== All allocation tests passed! ===" << std::endl;
+    return 0;
+}
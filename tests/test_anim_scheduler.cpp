@@ -0,0 +1,165 @@
+#include "../engine/animation/AnimationScheduler.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <memory>
+
+using namespace atlas::animation;
+
+namespace {
+
+// Pose is the tick it was evaluated for, so interpolation is checkable
+AnimEvaluateFn TickEvaluator(uint32_t* calls) {
+    return [calls](uint32_t tick, float, std::vector<float>& pose) {
+        if (calls) (*calls)++;
+        pose.assign(1, static_cast<float>(tick));
+        return true;
+    };
+}
+
+AnimLODSettings FixedCostSettings() {
+    AnimLODSettings settings;
+    settings.budgetMs = 0.0f;
+    settings.measureCost = false;
+    return settings;
+}
+
+}
+
+void test_anim_scheduler_rates_by_distance() {
+    AnimationScheduler scheduler(FixedCostSettings());
+    uint32_t calls[4] = {};
+    const float distances[4] = {5.0f, 30.0f, 80.0f, 200.0f};
+    AnimInstanceID ids[4];
+    for (int i = 0; i < 4; ++i) {
+        AnimInstanceDesc desc;
+        desc.evaluate = TickEvaluator(&calls[i]);
+        desc.x = distances[i];
+        ids[i] = scheduler.AddInstance(desc);
+    }
+    for (int t = 0; t < 8; ++t) scheduler.Update();
+
+    assert(scheduler.GetRate(ids[0]) == AnimUpdateRate::EveryTick);
+    assert(scheduler.GetRate(ids[1]) == AnimUpdateRate::Every2nd);
+    assert(scheduler.GetRate(ids[2]) == AnimUpdateRate::Every4th);
+    assert(scheduler.GetRate(ids[3]) == AnimUpdateRate::Frozen);
+    assert(calls[0] == 8 && calls[1] == 4 && calls[2] == 2 && calls[3] == 0);
+    assert(scheduler.TotalEvaluated() == 14);
+    assert(scheduler.TotalSkipped() == 32 - 14);
+    const AnimSchedulerStats& stats = scheduler.GetStats();
+    assert(stats.instances == 4 && stats.frozen == 1);
+    assert(stats.perRate[0] == 1 && stats.perRate[1] == 1 && stats.perRate[2] == 1);
+
+    // Hidden instances drop to every 4th tick
+    scheduler.SetInstanceVisible(ids[0], false);
+    scheduler.Update();
+    assert(scheduler.GetRate(ids[0]) == AnimUpdateRate::Every4th);
+    std::cout << "[PASS] test_anim_scheduler_rates_by_distance" << std::endl;
+}
+
+void test_anim_scheduler_staggered() {
+    AnimationScheduler scheduler(FixedCostSettings());
+    for (int i = 0; i < 8; ++i) {
+        AnimInstanceDesc desc;
+        desc.evaluate = TickEvaluator(nullptr);
+        desc.x = 100.0f;   // every 4th tick
+        scheduler.AddInstance(desc);
+    }
+    for (int i = 0; i < 4; ++i) {
+        AnimInstanceDesc desc;
+        desc.evaluate = TickEvaluator(nullptr);
+        desc.x = 40.0f;    // every 2nd tick
+        scheduler.AddInstance(desc);
+    }
+    // First tick settles the rates; afterwards 8/4 + 4/2 = 4 per tick
+    scheduler.Update();
+    scheduler.Update();
+    for (int t = 0; t < 12; ++t) {
+        scheduler.Update();
+        assert(scheduler.GetStats().evaluated == 4);
+        assert(scheduler.GetStats().skipped == 8);
+    }
+    std::cout << "[PASS] test_anim_scheduler_staggered" << std::endl;
+}
+
+void test_anim_scheduler_interpolates() {
+    AnimationScheduler scheduler(FixedCostSettings());
+    AnimInstanceDesc desc;
+    desc.evaluate = TickEvaluator(nullptr);
+    desc.x = 100.0f;
+    AnimInstanceID id = scheduler.AddInstance(desc);
+    for (int t = 0; t < 8; ++t) scheduler.Update();
+
+    // A linear signal is reproduced exactly between evaluations
+    for (int t = 0; t < 12; ++t) {
+        uint32_t tick = scheduler.CurrentTick();
+        scheduler.Update();
+        const std::vector<float>* pose = scheduler.GetPose(id);
+        assert(pose && pose->size() == 1);
+        assert((*pose)[0] == static_cast<float>(tick));
+    }
+
+    // Frozen instances hold their last pose
+    scheduler.SetInstancePosition(id, 500.0f, 0.0f, 0.0f);
+    scheduler.Update();
+    float held = (*scheduler.GetPose(id))[0];
+    for (int t = 0; t < 4; ++t) scheduler.Update();
+    assert((*scheduler.GetPose(id))[0] == held);
+    assert(scheduler.GetStats().evaluated == 0);
+    std::cout << "[PASS] test_anim_scheduler_interpolates" << std::endl;
+}
+
+void test_anim_scheduler_budget() {
+    AnimLODSettings settings = FixedCostSettings();
+    settings.budgetMs = 6.0f;
+    AnimationScheduler scheduler(settings);
+    AnimInstanceID ids[10];
+    for (int i = 0; i < 10; ++i) {
+        AnimInstanceDesc desc;
+        desc.evaluate = TickEvaluator(nullptr);
+        desc.x = static_cast<float>(i);
+        desc.estimatedCostMs = 1.0f;
+        ids[i] = scheduler.AddInstance(desc);
+    }
+    scheduler.Update();
+    const AnimSchedulerStats& stats = scheduler.GetStats();
+    assert(stats.demoted > 0);
+    assert(stats.predictedMs <= 6.0f);
+    assert(stats.demoted == 8);
+    // The nearest instances keep full rate, the farthest are demoted
+    assert(scheduler.GetRate(ids[0]) == AnimUpdateRate::EveryTick);
+    assert(scheduler.GetRate(ids[9]) != AnimUpdateRate::EveryTick);
+
+    // Rates and phases are stable from tick to tick
+    AnimUpdateRate before[10];
+    for (int i = 0; i < 10; ++i) before[i] = scheduler.GetRate(ids[i]);
+    uint64_t evaluated = scheduler.TotalEvaluated();
+    for (int t = 0; t < 4; ++t) scheduler.Update();
+    for (int i = 0; i < 10; ++i) assert(scheduler.GetRate(ids[i]) == before[i]);
+    assert(scheduler.TotalEvaluated() - evaluated == 4 * 6);   // 2 full + 8 half rate
+    std::cout << "[PASS] test_anim_scheduler_budget" << std::endl;
+}
+
+void test_anim_scheduler_graph_evaluator() {
+    DeterministicAnimationGraph graph;
+    auto rest = graph.AddNode(std::make_unique<RestPoseNode>());
+    auto fk = graph.AddNode(std::make_unique<FKNode>());
+    graph.AddEdge({rest, 0, fk, 0});
+    assert(graph.Compile());
+    BoneContext ctx;
+    ctx.boneCount = 3;
+
+    AnimationScheduler scheduler(FixedCostSettings());
+    AnimInstanceDesc desc;
+    desc.evaluate = MakeAnimEvaluator(graph, fk, 0, ctx);
+    AnimInstanceID id = scheduler.AddInstance(desc);
+    scheduler.Update();
+    const std::vector<float>* pose = scheduler.GetPose(id);
+    assert(pose && pose->size() == 3 * 7);
+    assert((*pose)[4] == 0.1f);   // FK rotY offset
+
+    scheduler.RemoveInstance(id);
+    assert(!scheduler.HasInstance(id));
+    assert(scheduler.InstanceCount() == 0);
+    std::cout << "[PASS] test_anim_scheduler_graph_evaluator" << std::endl;
+}
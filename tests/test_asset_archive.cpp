@@ -0,0 +1,279 @@
+#include "../engine/assets/AssetArchive.h"
+#include "../engine/assets/AssetRegistry.h"
+#include "../engine/production/GamePackager.h"
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+
+using namespace atlas::asset;
+
+namespace {
+
+std::string ArchiveTmp(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<uint8_t> Bytes(const std::string& s) {
+    return std::vector<uint8_t>(s.begin(), s.end());
+}
+
+std::vector<uint8_t> Noise(size_t size, uint32_t seed) {
+    std::vector<uint8_t> out(size);
+    for (auto& b : out) {
+        seed = seed * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(seed >> 24);
+    }
+    return out;
+}
+
+}
+
+void test_archive_round_trip() {
+    std::string path = ArchiveTmp("atlas_archive_round_trip.atlaspak");
+    AssetArchiveWriter writer;
+    assert(writer.Add("mesh", Bytes("mesh bytes")));
+    assert(writer.Add("texture", Bytes("texture bytes")));
+    assert(writer.Add("empty", {}));
+    assert(!writer.Add("mesh", Bytes("duplicate")));
+    assert(!writer.Add("", Bytes("no id")));
+    assert(writer.Count() == 3);
+    assert(writer.Write(path));
+
+    AssetArchive archive;
+    assert(archive.Open(path));
+    assert(archive.Count() == 3);
+    assert(archive.Contains("mesh"));
+    assert(!archive.Contains("missing"));
+    assert(archive.Find("missing") == nullptr);
+
+    std::vector<uint8_t> out;
+    assert(archive.Read("texture", out));
+    assert(out == Bytes("texture bytes"));
+    assert(archive.Read("empty", out));
+    assert(out.empty());
+    assert(!archive.Read("missing", out));
+
+    auto ids = archive.Ids();
+    std::sort(ids.begin(), ids.end());
+    assert((ids == std::vector<std::string>{"empty", "mesh", "texture"}));
+    for (const auto& id : ids) assert(archive.Verify(id));
+
+    archive.Close();
+    assert(!archive.IsOpen());
+    std::filesystem::remove(path);
+    std::cout << "[PASS] test_archive_round_trip" << std::endl;
+}
+
+void test_archive_zero_copy_view() {
+    std::string path = ArchiveTmp("atlas_archive_view.atlaspak");
+    AssetArchiveWriter writer;
+    writer.Add("a", Bytes("x"));
+    writer.Add("b", Bytes("payload of b"));
+    assert(writer.Write(path));
+
+    AssetArchive archive;
+    assert(archive.Open(path));
+    auto view = archive.View("b");
+    assert(std::string(view.begin(), view.end()) == "payload of b");
+    assert(reinterpret_cast<uintptr_t>(view.data()) % ARCHIVE_ALIGNMENT == 0);
+
+    // Two views of the same entry alias the same bytes: no copy was made
+    assert(archive.View("b").data() == view.data());
+    assert(archive.View("missing").empty());
+
+    std::filesystem::remove(path);
+    std::cout << "[PASS] test_archive_zero_copy_view" << std::endl;
+}
+
+void test_archive_compression() {
+    std::string path = ArchiveTmp("atlas_archive_lz.atlaspak");
+    std::string text;
+    for (int i = 0; i < 200; ++i) text += "tile " + std::to_string(i % 7) + " grass;";
+    auto noise = Noise(4096, 7);
+
+    AssetArchiveWriter writer;
+    writer.Add("text", Bytes(text), true);
+    writer.Add("noise", noise, true);
+    assert(writer.Write(path));
+
+    AssetArchive archive;
+    assert(archive.Open(path));
+    const ArchiveEntry* t = archive.Find("text");
+    assert(t && t->compression == ArchiveCompression::LZ);
+    assert(t->storedSize < t->size);
+    assert(archive.View("text").empty());
+
+    // Entries that do not shrink are stored raw
+    const ArchiveEntry* n = archive.Find("noise");
+    assert(n && n->compression == ArchiveCompression::None);
+
+    std::vector<uint8_t> out;
+    assert(archive.Read("text", out));
+    assert(out == Bytes(text));
+    assert(archive.Read("noise", out));
+    assert(out == noise);
+    assert(archive.Verify("text"));
+
+    auto packed = LzCompress(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    std::vector<uint8_t> shortBuf(text.size() - 1);
+    assert(!LzDecompress(packed.data(), packed.size(), shortBuf.data(), shortBuf.size()));
+
+    std::filesystem::remove(path);
+    std::cout << "[PASS] test_archive_compression" << std::endl;
+}
+
+void test_archive_detects_corruption() {
+    std::string path = ArchiveTmp("atlas_archive_corrupt.atlaspak");
+    AssetArchiveWriter writer;
+    writer.Add("level", Bytes("level geometry"));
+    assert(writer.Write(path));
+
+    uint64_t dataOffset = 0;
+    {
+        AssetArchive archive;
+        assert(archive.Open(path));
+        dataOffset = archive.Find("level")->offset;
+    }
+
+    auto flip = [&](uint64_t offset) {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekg(static_cast<std::streamoff>(offset));
+        char c = 0;
+        f.read(&c, 1);
+        c ^= 0x5A;
+        f.seekp(static_cast<std::streamoff>(offset));
+        f.write(&c, 1);
+    };
+
+    // Damaged entry bytes: the archive opens, the entry fails verification
+    flip(dataOffset);
+    {
+        AssetArchive archive;
+        assert(archive.Open(path));
+        assert(!archive.Verify("level"));
+    }
+    flip(dataOffset);
+
+    // Damaged table of contents: the archive is rejected
+    flip(sizeof(ArchiveHeader) + 8);
+    {
+        AssetArchive archive;
+        assert(!archive.Open(path));
+    }
+
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f << "not an archive";
+    }
+    AssetArchive archive;
+    assert(!archive.Open(path));
+    assert(!archive.Open(ArchiveTmp("atlas_archive_missing.atlaspak")));
+
+    std::filesystem::remove(path);
+    std::cout << "[PASS] test_archive_detects_corruption" << std::endl;
+}
+
+void test_archive_many_entries() {
+    std::string path = ArchiveTmp("atlas_archive_many.atlaspak");
+    AssetArchiveWriter writer;
+    for (int i = 0; i < 1000; ++i) {
+        writer.Add("asset_" + std::to_string(i), Bytes("data " + std::to_string(i)));
+    }
+    assert(writer.Write(path));
+
+    AssetArchive archive;
+    assert(archive.Open(path));
+    assert(archive.Count() == 1000);
+    for (int i = 0; i < 1000; ++i) {
+        std::string id = "asset_" + std::to_string(i);
+        auto view = archive.View(id);
+        assert(std::string(view.begin(), view.end()) == "data " + std::to_string(i));
+        assert(archive.EntryId(*archive.Find(id)) == id);
+    }
+    assert(!archive.Contains("asset_1000"));
+
+    std::filesystem::remove(path);
+    std::cout << "[PASS] test_archive_many_entries" << std::endl;
+}
+
+void test_archive_move() {
+    std::string path = ArchiveTmp("atlas_archive_move.atlaspak");
+    AssetArchiveWriter writer;
+    writer.Add("a", Bytes("alpha"));
+    assert(writer.Write(path));
+
+    AssetArchive first;
+    assert(first.Open(path));
+    auto view = first.View("a");
+
+    AssetArchive second(std::move(first));
+    assert(!first.IsOpen());
+    assert(second.IsOpen());
+    assert(second.View("a").data() == view.data());
+
+    AssetArchive third;
+    third = std::move(second);
+    assert(!second.IsOpen());
+    assert(third.Contains("a"));
+    assert(third.Path() == path);
+
+    std::filesystem::remove(path);
+    std::cout << "[PASS] test_archive_move" << std::endl;
+}
+
+void test_archive_registry_scan() {
+    std::string path = ArchiveTmp("atlas_archive_registry.atlaspak");
+    AssetArchiveWriter writer;
+    writer.Add("ship", Bytes("ship"));
+    writer.Add("station", Bytes("station"));
+    assert(writer.Write(path));
+
+    AssetArchive archive;
+    assert(archive.Open(path));
+    AssetRegistry registry;
+    assert(registry.ScanArchive(archive) == 2);
+    assert(registry.Count() == 2);
+    const AssetEntry* ship = registry.Get("ship");
+    assert(ship && ship->path == path + "#ship");
+
+    std::filesystem::remove(path);
+    std::cout << "[PASS] test_archive_registry_scan" << std::endl;
+}
+
+void test_archive_packager_output() {
+    using namespace atlas::production;
+    const std::string dir = ArchiveTmp("atlas_archive_pkg");
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir + "/src");
+    {
+        std::ofstream out(dir + "/src/mesh.atlas", std::ios::binary);
+        out << "mesh data";
+    }
+    {
+        std::ofstream out(dir + "/src/sound.atlas", std::ios::binary);
+        out << "sound data";
+    }
+
+    GamePackager packager;
+    PackageConfig config;
+    config.sourceDir = dir + "/src";
+    config.outputDir = dir + "/output";
+    auto report = packager.Package(config);
+    assert(report.result == PackageResult::Success);
+
+    std::string archivePath = config.outputDir + "/data/assets.atlaspak";
+    assert(std::filesystem::exists(archivePath));
+    assert(!std::filesystem::exists(config.outputDir + "/data/mesh.atlasb"));
+    assert(!std::filesystem::exists(config.outputDir + "/data/.cookcache"));
+
+    AssetArchive archive;
+    assert(archive.Open(archivePath));
+    assert(archive.Count() == 2);
+    assert(archive.Contains("mesh"));
+    assert(archive.Verify("sound"));
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_archive_packager_output" << std::endl;
+}
@@ -1,4 +1,6 @@
 #include "../engine/production/AssetCooker.h"
+#include "../engine/assets/AssetRegistry.h"
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 #include <filesystem>
@@ -153,3 +155,215 @@ void test_cooker_progress_callback() {
 
     std::cout << "[PASS] test_cooker_progress_callback" << std::endl;
 }
+
+// --- Incremental and dependency-ordered cooking ---
+
+namespace {
+
+std::string MakeCookDir(const char* name, std::initializer_list<std::pair<const char*, const char*>> files) {
+    std::string dir = (std::filesystem::temp_directory_path() / name).string();
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    for (const auto& [file, content] : files) {
+        std::ofstream f(dir + "/" + file);
+        f << content;
+    }
+    return dir;
+}
+
+void WriteFile(const std::string& path, const char* content) {
+    std::ofstream f(path, std::ios::trunc);
+    f << content;
+}
+
+const CookEntry* FindEntry(const AssetCooker& cooker, const std::string& id) {
+    const auto& log = cooker.CookLog();
+    for (auto it = log.rbegin(); it != log.rend(); ++it) {
+        if (it->sourceId == id) return &*it;
+    }
+    return nullptr;
+}
+
+}
+
+void test_cooker_incremental_skip() {
+    std::string src = MakeCookDir("atlas_cooker_incr_src",
+                                  {{"a.atlas", "alpha"}, {"b.atlas", "beta"}, {"c.atlas", "gamma"}});
+    std::string out = (std::filesystem::temp_directory_path() / "atlas_cooker_incr_out").string();
+    std::filesystem::remove_all(out);
+
+    AssetCooker cooker;
+    cooker.SetOutputDir(out);
+    CookStats first = cooker.CookAll(src);
+    assert(first.cookedAssets == 3 && first.skippedAssets == 0);
+    assert(std::filesystem::exists(cooker.CachePath()));
+
+    // Nothing changed: a fresh cooker reads the persistent cache
+    AssetCooker again;
+    again.SetOutputDir(out);
+    CookStats second = again.CookAll(src);
+    assert(second.cookedAssets == 0 && second.skippedAssets == 3);
+    assert(FindEntry(again, "a")->skipped);
+    assert(FindEntry(again, "a")->outputPath == FindEntry(cooker, "a")->outputPath);
+
+    // One source edited, one output deleted
+    WriteFile(src + "/b.atlas", "beta v2");
+    std::filesystem::remove(FindEntry(cooker, "c")->outputPath);
+    CookStats third = again.CookAll(src);
+    assert(third.cookedAssets == 2 && third.skippedAssets == 1);
+    assert(FindEntry(again, "a")->skipped);
+    assert(!FindEntry(again, "b")->skipped);
+
+    // Cook options are part of the key
+    again.SetStripEditorData(false);
+    assert(again.CookAll(src).cookedAssets == 3);
+
+    // Non-incremental cooks always rewrite
+    again.SetIncremental(false);
+    assert(again.CookAll(src).cookedAssets == 3);
+
+    std::filesystem::remove_all(src);
+    std::filesystem::remove_all(out);
+    std::cout << "[PASS] test_cooker_incremental_skip" << std::endl;
+}
+
+void test_cooker_dependency_order() {
+    std::string src = MakeCookDir("atlas_cooker_deps_src",
+                                  {{"mesh.atlas", "m"}, {"material.atlas", "mat"},
+                                   {"texture.atlas", "tex"}, {"sound.atlas", "snd"}});
+    std::string out = (std::filesystem::temp_directory_path() / "atlas_cooker_deps_out").string();
+    std::filesystem::remove_all(out);
+
+    // mesh -> material -> texture
+    atlas::asset::AssetRegistry registry;
+    registry.AddDependency("mesh", "material");
+    registry.AddDependency("material", "texture");
+
+    AssetCooker cooker;
+    cooker.SetOutputDir(out);
+    cooker.SetDependencies(&registry);
+    std::vector<std::string> order;
+    cooker.SetProgressCallback([&](const std::string& id, uint32_t, uint32_t) {
+        order.push_back(id);
+    });
+
+    CookStats stats = cooker.CookAll(src);
+    assert(stats.cookedAssets == 4);
+    assert(order.size() == 4);
+    auto pos = [&order](const char* id) {
+        return std::find(order.begin(), order.end(), id) - order.begin();
+    };
+    assert(pos("texture") < pos("material"));
+    assert(pos("material") < pos("mesh"));
+
+    // A changed dependency recooks everything downstream of it
+    WriteFile(src + "/texture.atlas", "tex v2");
+    stats = cooker.CookAll(src);
+    assert(stats.cookedAssets == 3 && stats.skippedAssets == 1);
+    assert(FindEntry(cooker, "sound")->skipped);
+
+    // A changed leaf recooks only itself
+    WriteFile(src + "/mesh.atlas", "m v2");
+    stats = cooker.CookAll(src);
+    assert(stats.cookedAssets == 1 && stats.skippedAssets == 3);
+    assert(!FindEntry(cooker, "mesh")->skipped);
+
+    std::filesystem::remove_all(src);
+    std::filesystem::remove_all(out);
+    std::cout << "[PASS] test_cooker_dependency_order" << std::endl;
+}
+
+void test_cooker_dependency_failures() {
+    std::string src = MakeCookDir("atlas_cooker_cycle_src",
+                                  {{"x.atlas", "x"}, {"y.atlas", "y"}, {"z.atlas", "z"}, {"w.atlas", "w"}});
+    std::string out = (std::filesystem::temp_directory_path() / "atlas_cooker_cycle_out").string();
+    std::filesystem::remove_all(out);
+
+    // x <-> y cycle, w depends on the cycle, z is independent
+    atlas::asset::AssetRegistry registry;
+    registry.AddDependency("x", "y");
+    registry.AddDependency("y", "x");
+    registry.AddDependency("w", "x");
+
+    AssetCooker cooker;
+    cooker.SetOutputDir(out);
+    cooker.SetDependencies(&registry);
+    CookStats stats = cooker.CookAll(src);
+    assert(stats.cookedAssets == 1);
+    assert(stats.failedAssets == 3);
+    assert(FindEntry(cooker, "x")->result == CookResult::DependencyFailed);
+    assert(FindEntry(cooker, "w")->result == CookResult::DependencyFailed);
+    assert(FindEntry(cooker, "z")->result == CookResult::Success);
+
+    // Failures are never cached
+    registry.ClearDependencies();
+    stats = cooker.CookAll(src);
+    assert(stats.cookedAssets == 3 && stats.skippedAssets == 1);
+
+    std::filesystem::remove_all(src);
+    std::filesystem::remove_all(out);
+    std::cout << "[PASS] test_cooker_dependency_failures" << std::endl;
+}
+
+void test_cooker_duplicate_ids() {
+    std::string src = MakeCookDir("atlas_cooker_dup_src", {{"tree.atlas", "root"}, {"rock.atlas", "r"}});
+    std::filesystem::create_directories(src + "/props");
+    WriteFile(src + "/props/tree.atlas", "nested");
+    std::string out = (std::filesystem::temp_directory_path() / "atlas_cooker_dup_out").string();
+    std::filesystem::remove_all(out);
+
+    // Both sources would write <out>/tree.atlasb; neither is cooked
+    AssetCooker cooker;
+    cooker.SetOutputDir(out);
+    CookStats stats = cooker.CookAll(src);
+    assert(stats.cookedAssets == 1);
+    assert(stats.failedAssets == 2);
+    size_t duplicates = 0;
+    for (const auto& entry : cooker.CookLog()) {
+        if (entry.sourceId != "tree") continue;
+        assert(entry.result == CookResult::DuplicateSource);
+        ++duplicates;
+    }
+    assert(duplicates == 2);
+    assert(!std::filesystem::exists(out + "/tree.atlasb"));
+    assert(cooker.LastCookReport().find("(DuplicateSource)") != std::string::npos);
+
+    // Renaming one resolves it
+    std::filesystem::rename(src + "/props/tree.atlas", src + "/props/tree_b.atlas");
+    stats = cooker.CookAll(src);
+    assert(stats.failedAssets == 0);
+    assert(FindEntry(cooker, "tree")->result == CookResult::Success);
+
+    std::filesystem::remove_all(src);
+    std::filesystem::remove_all(out);
+    std::cout << "[PASS] test_cooker_duplicate_ids" << std::endl;
+}
+
+void test_cooker_report() {
+    std::string src = MakeCookDir("atlas_cooker_report_src", {{"one.atlas", "1"}, {"two.atlas", "2"}});
+    std::string out = (std::filesystem::temp_directory_path() / "atlas_cooker_report_out").string();
+    std::filesystem::remove_all(out);
+
+    AssetCooker cooker;
+    cooker.SetOutputDir(out);
+    cooker.CookAll(src);
+    WriteFile(src + "/two.atlas", "2b");
+    CookStats stats = cooker.CookAll(src);
+
+    assert(cooker.LastStats().cookedAssets == stats.cookedAssets);
+    assert(stats.wallMs >= 0.0f);
+    for (const char* id : {"one", "two"}) assert(FindEntry(cooker, id)->cookMs >= 0.0f);
+
+    std::string report = cooker.LastCookReport();
+    assert(report.find("Cooked 1, skipped 1, failed 0 of 2 assets") == 0);
+    assert(report.find("skipped") != std::string::npos);
+    assert(report.find("one") != std::string::npos);
+    assert(report.find("two") != std::string::npos);
+    // Only the last run is reported
+    size_t lines = std::count(report.begin(), report.end(), '\n');
+    assert(lines == 3);
+
+    std::filesystem::remove_all(src);
+    std::filesystem::remove_all(out);
+    std::cout << "[PASS] test_cooker_report" << std::endl;
+}
@@ -1,7 +1,11 @@
 #include "../engine/audio/AudioEngine.h"
+#include "../engine/core/SpscQueue.h"
 #include <iostream>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <thread>
 
 using namespace atlas::audio;
 
@@ -91,3 +95,192 @@ void test_audio_looping() {
 
     std::cout << "[PASS] test_audio_looping" << std::endl;
 }
+
+static std::shared_ptr<AudioClip> MakeDCClip(float value, size_t frames, uint32_t channels = 1) {
+    auto clip = std::make_shared<AudioClip>();
+    clip->sampleRate = 48000;
+    clip->channels = channels;
+    clip->samples.assign(frames * channels, value);
+    return clip;
+}
+
+void test_audio_spsc_queue() {
+    atlas::SpscQueue<uint32_t> queue(1000);
+    assert(queue.Capacity() == 1024);
+    assert(queue.Empty());
+
+    const uint32_t count = 200000;
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < count; ++i) {
+            while (!queue.TryPush(i)) std::this_thread::yield();
+        }
+    });
+    uint32_t expected = 0, value = 0;
+    while (expected < count) {
+        if (queue.TryPop(value)) {
+            assert(value == expected);
+            ++expected;
+        }
+    }
+    producer.join();
+    assert(!queue.TryPop(value));
+
+    std::cout << "[PASS] test_audio_spsc_queue" << std::endl;
+}
+
+void test_audio_mixer_plays_and_finishes() {
+    AudioEngine audio;
+    audio.Init();
+    auto* device = static_cast<NullAudioDevice*>(audio.GetDevice());
+
+    // 600 frames of DC: two full 256-frame blocks and part of a third
+    SoundID id = audio.LoadSound("dc", MakeDCClip(0.5f, 600));
+    audio.SetVolume(id, 0.8f);
+    audio.Play(id);
+    assert(audio.ActiveVoiceCount() == 1);
+
+    audio.Update(256.0f / 48000.0f);
+    assert(device->FramesWritten() == 256);
+    assert(std::fabs(device->LastPeak(0) - 0.4f) < 1e-5f);
+    assert(std::fabs(device->LastPeak(1) - 0.4f) < 1e-5f);
+    assert(audio.GetState(id) == SoundState::Playing);
+
+    audio.SetMasterVolume(0.5f);
+    audio.Update(2 * 256.0f / 48000.0f);
+    assert(std::fabs(device->LastPeak(0) - 0.2f) < 1e-5f);
+    audio.Update(0.0f);
+    assert(audio.GetState(id) == SoundState::Stopped);
+    assert(audio.ActiveVoiceCount() == 0);
+
+    auto stats = audio.GetMixerStats();
+    assert(stats.blocks == 3);
+    assert(stats.voiceBlocks == 3);
+
+    std::cout << "[PASS] test_audio_mixer_plays_and_finishes" << std::endl;
+}
+
+void test_audio_mixer_pitch_and_looping() {
+    AudioEngine audio;
+    audio.Init();
+    const float block = 256.0f / 48000.0f;
+
+    // Pitch 2 consumes 4800 frames in 2400 output frames (~9.4 blocks)
+    SoundID fast = audio.LoadSound("fast", MakeDCClip(0.25f, 4800));
+    audio.SetPitch(fast, 2.0f);
+    audio.Play(fast);
+    for (int i = 0; i < 9; ++i) audio.Update(block);
+    assert(audio.GetState(fast) == SoundState::Playing);
+    audio.Update(block);
+    audio.Update(block);
+    assert(audio.GetState(fast) == SoundState::Stopped);
+
+    // Looping never finishes; pause keeps the voice but silences it
+    auto* device = static_cast<NullAudioDevice*>(audio.GetDevice());
+    SoundID loop = audio.LoadSound("loop", MakeDCClip(0.3f, 100));
+    audio.SetLooping(loop, true);
+    audio.SetPitch(loop, 1.37f);
+    audio.Play(loop);
+    for (int i = 0; i < 20; ++i) audio.Update(block);
+    assert(audio.GetState(loop) == SoundState::Playing);
+    assert(std::fabs(device->LastPeak(0) - 0.3f) < 1e-4f);
+    audio.Pause(loop);
+    audio.Update(block);
+    assert(device->LastPeak(0) == 0.0f);
+    assert(audio.ActiveVoiceCount() == 1);
+    audio.Play(loop);
+    audio.Update(block);
+    assert(device->LastPeak(0) > 0.29f);
+
+    // Unloading a playing sound frees its voice
+    audio.UnloadSound(loop);
+    audio.Update(block);
+    assert(audio.ActiveVoiceCount() == 0);
+    assert(device->LastPeak(0) == 0.0f);
+
+    std::cout << "[PASS] test_audio_mixer_pitch_and_looping" << std::endl;
+}
+
+void test_audio_mixer_spatial() {
+    AudioEngine audio;
+    audio.Init();
+    auto* device = static_cast<NullAudioDevice*>(audio.GetDevice());
+    const float block = 256.0f / 48000.0f;
+    audio.SetListenerPosition(0.0f, 0.0f, 0.0f);
+    audio.SetListenerOrientation(0.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f);
+
+    SoundID id = audio.LoadSound("src", MakeDCClip(1.0f, 48000));
+    audio.SetPosition(id, 1.0f, 0.0f, 0.0f);   // hard right at reference distance
+    audio.Play(id);
+    audio.Update(block);
+    assert(device->LastPeak(0) < 1e-4f);
+    assert(std::fabs(device->LastPeak(1) - 1.0f) < 1e-4f);
+
+    // Moving away ramps towards 1/4 gain at four times the distance
+    audio.SetPosition(id, -4.0f, 0.0f, 0.0f);
+    audio.Update(block);
+    audio.Update(block);
+    assert(std::fabs(device->LastPeak(0) - 0.25f) < 1e-4f);
+    assert(device->LastPeak(1) < 1e-4f);
+
+    // Straight ahead is centred at constant power
+    audio.SetPosition(id, 0.0f, 0.0f, -2.0f);
+    audio.Update(block);
+    audio.Update(block);
+    assert(std::fabs(device->LastPeak(0) - device->LastPeak(1)) < 1e-4f);
+    assert(std::fabs(device->LastPeak(0) - 0.5f * 0.70710678f) < 1e-4f);
+
+    std::cout << "[PASS] test_audio_mixer_spatial" << std::endl;
+}
+
+void test_audio_wav_device_roundtrip() {
+    const std::string path = "test_audio_mixer_out.wav";
+    {
+        AudioEngine audio;
+        audio.Init(AudioEngineConfig{}, std::make_unique<WavFileAudioDevice>(path));
+        SoundID id = audio.LoadSound("tone", MakeDCClip(0.5f, 1000, 2));
+        audio.Play(id);
+        audio.Update(4 * 256.0f / 48000.0f);
+        audio.Shutdown();
+    }
+
+    auto clip = LoadWavFile(path);
+    assert(clip);
+    assert(clip->channels == 2);
+    assert(clip->sampleRate == 48000);
+    assert(clip->FrameCount() == 1024);
+    assert(std::fabs(clip->samples[0] - 0.5f) < 1e-3f);
+    assert(clip->samples[2 * 1023] == 0.0f);
+
+    // LoadSound decodes files by name
+    AudioEngine audio;
+    audio.Init();
+    SoundID id = audio.LoadSound(path);
+    audio.Play(id);
+    audio.Update(256.0f / 48000.0f);
+    assert(static_cast<NullAudioDevice*>(audio.GetDevice())->LastPeak(0) > 0.49f);
+    std::remove(path.c_str());
+
+    std::cout << "[PASS] test_audio_wav_device_roundtrip" << std::endl;
+}
+
+void test_audio_mixer_thread() {
+    AudioEngineConfig config;
+    config.mixerThread = true;
+    AudioEngine audio;
+    assert(audio.Init(config));
+    auto* device = static_cast<NullAudioDevice*>(audio.GetDevice());
+
+    SoundID id = audio.LoadSound("loop", MakeDCClip(0.5f, 480));
+    audio.SetLooping(id, true);
+    audio.Play(id);
+    for (int i = 0; i < 200 && device->FramesWritten() < 2048; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    assert(device->FramesWritten() >= 2048);
+    audio.Stop(id);
+    audio.UnloadSound(id);
+    audio.Shutdown();
+    assert(audio.GetMixerStats().blocks == 0);
+
+    std::cout << "[PASS] test_audio_mixer_thread" << std::endl;
+}
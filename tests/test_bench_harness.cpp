@@ -0,0 +1,55 @@
+#include "../benchmarks/BenchHarness.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+using namespace atlas::bench;
+
+namespace {
+
+BenchResult MakeResult(const char* name, double medianMs, double ops) {
+    BenchStats stats;
+    stats.reps = 5;
+    stats.medianMs = stats.minMs = stats.p90Ms = stats.maxMs = stats.meanMs = medianMs * ops;
+    BenchResult r;
+    r.section = "Harness";
+    r.name = name;
+    r.unit = "op";
+    r.stats = ops == 1.0 ? stats : stats.PerOp(ops);
+    return r;
+}
+
+}
+
+void test_bench_compare_per_op_regression() {
+    // 1 us per op over 1000 ops is a 1 ms loop: well above the floor
+    std::vector<BenchResult> baseline = {MakeResult("per op", 0.001, 1000.0),
+                                         MakeResult("tiny run", 0.001, 1.0)};
+    std::vector<BenchResult> current = {MakeResult("per op", 0.01, 1000.0),
+                                        MakeResult("tiny run", 0.01, 1.0)};
+    assert(current[0].stats.medianMs < 0.05 && current[0].stats.ops == 1000.0);
+
+    auto comparisons = Compare(baseline, current, 0.10);
+    assert(comparisons.size() == 2);
+    assert(comparisons[0].key == "Harness/per op" && comparisons[0].regression);
+    // A whole run under the floor is still treated as noise
+    assert(comparisons[1].key == "Harness/tiny run" && !comparisons[1].regression);
+
+    std::cout << "[PASS] test_bench_compare_per_op_regression" << std::endl;
+}
+
+void test_bench_results_json_keeps_ops() {
+    std::vector<BenchResult> results = {MakeResult("per op", 0.002, 250.0)};
+    std::string path = "test_bench_harness.json";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << ResultsJson(results);
+    }
+    std::vector<BenchResult> loaded;
+    assert(LoadResultsJson(path, loaded));
+    assert(loaded.size() == 1 && loaded[0].stats.ops == 250.0);
+    std::remove(path.c_str());
+
+    std::cout << "[PASS] test_bench_results_json_keeps_ops" << std::endl;
+}
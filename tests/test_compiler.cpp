@@ -1,7 +1,9 @@
 #include "../engine/graphvm/GraphCompiler.h"
 #include "../engine/graphvm/GraphVM.h"
+#include "../engine/graphvm/GraphOptimizer.h"
 #include <iostream>
 #include <cassert>
+#include <random>
 
 using namespace atlas::graph;
 using namespace atlas::vm;
@@ -78,3 +80,360 @@ void test_compile_multiply() {
     std::cout << "[PASS] test_compile_multiply" << std::endl;
 }
 
+// --- Optimizer ---
+
+static size_t CountOpcode(const Bytecode& bc, OpCode op) {
+    size_t n = 0;
+    for (const auto& inst : bc.instructions) {
+        if (inst.opcode == op) n++;
+    }
+    return n;
+}
+
+static std::vector<Value> RunStack(const Bytecode& bc, std::vector<Value> inputs = {}) {
+    GraphVM vm;
+    VMContext ctx;
+    ctx.inputs = std::move(inputs);
+    vm.Execute(bc, ctx);
+    return vm.GetStack();
+}
+
+void test_optimizer_constant_folding() {
+    Graph g;
+    g.nodes = {
+        {0, NodeType::Constant, 15},
+        {1, NodeType::Constant, 25},
+        {2, NodeType::Add, 0},
+        {3, NodeType::Constant, 3},
+        {4, NodeType::Mul, 0},
+        {5, NodeType::Constant, 7},
+        {6, NodeType::Constant, 0},
+        {7, NodeType::Div, 0},
+        {8, NodeType::Sub, 0},
+    };
+
+    GraphCompiler compiler;
+    compiler.SetOptLevel(OptLevel::O0);
+    Bytecode plain = compiler.Compile(g);
+    compiler.SetOptLevel(OptLevel::O2);
+    Bytecode opt = compiler.Compile(g);
+
+    // (15 + 25) * 3 - 7 / 0  ->  one constant load
+    assert(opt.instructions.size() == 2);
+    assert(opt.instructions[0].opcode == OpCode::LOAD_CONST);
+    assert(opt.constants.size() == 1 && opt.constants[0] == 120);
+    assert(compiler.GetStats().constantsFolded >= 3);
+    assert(compiler.GetStats().instructionsBefore == plain.instructions.size());
+    assert(RunStack(plain) == RunStack(opt));
+    std::cout << "[PASS] test_optimizer_constant_folding" << std::endl;
+}
+
+void test_optimizer_branch_folding() {
+    Bytecode bc;
+    bc.constants = {0, 999, 42};
+    bc.instructions = {
+        {OpCode::LOAD_CONST, 0, 0, 0},      // 0: push 0
+        {OpCode::JUMP_IF_FALSE, 4, 0, 0},   // 1: always taken
+        {OpCode::LOAD_CONST, 1, 0, 0},      // 2: unreachable
+        {OpCode::STORE_VAR, 0, 0, 0},       // 3: unreachable
+        {OpCode::LOAD_CONST, 2, 0, 0},      // 4
+        {OpCode::STORE_VAR, 0, 0, 0},       // 5
+        {OpCode::END, 0, 0, 0}              // 6
+    };
+
+    OptimizerStats stats;
+    Bytecode opt = BytecodeOptimizer::Optimize(bc, OptLevel::O1, &stats);
+    assert(stats.branchesFolded == 1);
+    assert(CountOpcode(opt, OpCode::JUMP_IF_FALSE) == 0);
+    assert(CountOpcode(opt, OpCode::JUMP) == 0);
+    assert(opt.instructions.size() == 3);
+    assert(opt.constants.size() == 1 && opt.constants[0] == 42);
+
+    GraphVM vm;
+    VMContext ctx;
+    vm.Execute(opt, ctx);
+    assert(vm.GetLocal(0) == 42);
+    assert(VerifyEquivalence(bc, opt).equivalent);
+    std::cout << "[PASS] test_optimizer_branch_folding" << std::endl;
+}
+
+void test_optimizer_jump_threading() {
+    Bytecode bc;
+    bc.constants = {2};
+    bc.instructions = {
+        {OpCode::LOAD_VAR, 0, 0, 0},        // 0
+        {OpCode::JUMP_IF_FALSE, 4, 0, 0},   // 1: -> 4 -> 6
+        {OpCode::EMIT_EVENT, 0, 0, 0},      // 2
+        {OpCode::JUMP, 5, 0, 0},            // 3: -> 5 -> 8 (END)
+        {OpCode::JUMP, 6, 0, 0},            // 4
+        {OpCode::JUMP, 8, 0, 0},            // 5
+        {OpCode::LOAD_CONST, 0, 0, 0},      // 6
+        {OpCode::STORE_VAR, 1, 0, 0},       // 7
+        {OpCode::END, 0, 0, 0}              // 8
+    };
+
+    OptimizerStats stats;
+    Bytecode opt = BytecodeOptimizer::Optimize(bc, OptLevel::O1, &stats);
+    assert(stats.jumpsThreaded >= 2);
+    assert(CountOpcode(opt, OpCode::JUMP) == 0);
+    assert(opt.instructions.size() < bc.instructions.size());
+    assert(VerifyEquivalence(bc, opt).equivalent);
+    std::cout << "[PASS] test_optimizer_jump_threading" << std::endl;
+}
+
+void test_optimizer_cse() {
+    // v2 = (v0 + v1) * (v0 + v1); v3 = (v0 + v1) - v2
+    Bytecode bc;
+    bc.instructions = {
+        {OpCode::LOAD_VAR, 0, 0, 0},
+        {OpCode::LOAD_VAR, 1, 0, 0},
+        {OpCode::ADD, 0, 0, 0},
+        {OpCode::LOAD_VAR, 0, 0, 0},
+        {OpCode::LOAD_VAR, 1, 0, 0},
+        {OpCode::ADD, 0, 0, 0},
+        {OpCode::MUL, 0, 0, 0},
+        {OpCode::STORE_VAR, 2, 0, 0},
+        {OpCode::LOAD_VAR, 0, 0, 0},
+        {OpCode::LOAD_VAR, 1, 0, 0},
+        {OpCode::ADD, 0, 0, 0},
+        {OpCode::STORE_VAR, 4, 0, 0},
+        {OpCode::LOAD_VAR, 0, 0, 0},
+        {OpCode::LOAD_VAR, 1, 0, 0},
+        {OpCode::ADD, 0, 0, 0},
+        {OpCode::LOAD_VAR, 2, 0, 0},
+        {OpCode::SUB, 0, 0, 0},
+        {OpCode::STORE_VAR, 3, 0, 0},
+        {OpCode::END, 0, 0, 0}
+    };
+
+    OptimizerStats stats;
+    Bytecode opt = BytecodeOptimizer::Optimize(bc, OptLevel::O2, &stats);
+    assert(stats.subexpressionsReused >= 2);
+    assert(CountOpcode(opt, OpCode::DUP) >= 1);
+    assert(CountOpcode(opt, OpCode::ADD) == 2);
+    assert(opt.instructions.size() < bc.instructions.size());
+
+    GraphVM vm;
+    VMContext ctx;
+    ctx.inputs = {3, 4};
+    vm.Execute(opt, ctx);
+    assert(vm.GetLocal(2) == 49);
+    assert(vm.GetLocal(3) == 7 - 49);
+    assert(VerifyEquivalence(bc, opt).equivalent);
+    std::cout << "[PASS] test_optimizer_cse" << std::endl;
+}
+
+void test_optimizer_peephole_immediate() {
+    // v1 = v0 + 5; v1 = v0 * 1 (first store is dead)
+    Bytecode bc;
+    bc.constants = {5, 1};
+    bc.instructions = {
+        {OpCode::LOAD_VAR, 0, 0, 0},
+        {OpCode::LOAD_CONST, 0, 0, 0},
+        {OpCode::ADD, 0, 0, 0},
+        {OpCode::STORE_VAR, 1, 0, 0},
+        {OpCode::LOAD_VAR, 0, 0, 0},
+        {OpCode::LOAD_CONST, 0, 0, 0},
+        {OpCode::CMP_LT, 0, 0, 0},
+        {OpCode::STORE_VAR, 2, 0, 0},
+        {OpCode::NOP, 0, 0, 0},
+        {OpCode::LOAD_VAR, 0, 0, 0},
+        {OpCode::LOAD_CONST, 1, 0, 0},
+        {OpCode::MUL, 0, 0, 0},
+        {OpCode::STORE_VAR, 1, 0, 0},
+        {OpCode::END, 0, 0, 0}
+    };
+
+    OptimizerStats stats;
+    Bytecode opt = BytecodeOptimizer::Optimize(bc, OptLevel::O2, &stats);
+    assert(CountOpcode(opt, OpCode::CMP_LT_IMM) == 1);
+    assert(CountOpcode(opt, OpCode::LOAD_CONST) == 0);
+    assert(CountOpcode(opt, OpCode::ADD_IMM) == 0);   // dead store removed with its value
+    assert(CountOpcode(opt, OpCode::MUL_IMM) == 0);   // x * 1
+    assert(CountOpcode(opt, OpCode::NOP) == 0);
+    assert(stats.fused >= 1);
+
+    GraphVM vm;
+    VMContext ctx;
+    ctx.inputs = {3};
+    vm.Execute(opt, ctx);
+    assert(vm.GetLocal(1) == 3);
+    assert(vm.GetLocal(2) == 1);
+    assert(VerifyEquivalence(bc, opt).equivalent);
+    std::cout << "[PASS] test_optimizer_peephole_immediate" << std::endl;
+}
+
+void test_optimizer_levels() {
+    Bytecode bc;
+    bc.constants = {2, 3, 10};
+    bc.instructions = {
+        {OpCode::LOAD_CONST, 0, 0, 0},
+        {OpCode::LOAD_CONST, 1, 0, 0},
+        {OpCode::ADD, 0, 0, 0},
+        {OpCode::LOAD_VAR, 0, 0, 0},
+        {OpCode::LOAD_CONST, 2, 0, 0},
+        {OpCode::MUL, 0, 0, 0},
+        {OpCode::ADD, 0, 0, 0},
+        {OpCode::STORE_VAR, 1, 0, 0},
+        {OpCode::END, 0, 0, 0}
+    };
+
+    Bytecode o0 = BytecodeOptimizer::Optimize(bc, OptLevel::O0);
+    Bytecode o1 = BytecodeOptimizer::Optimize(bc, OptLevel::O1);
+    Bytecode o2 = BytecodeOptimizer::Optimize(bc, OptLevel::O2);
+
+    assert(o0.instructions.size() == bc.instructions.size());
+    assert(o1.instructions.size() == bc.instructions.size() - 2);
+    assert(CountOpcode(o1, OpCode::MUL_IMM) == 0);
+    assert(CountOpcode(o2, OpCode::MUL_IMM) == 1);
+    assert(o2.instructions.size() < o1.instructions.size());
+
+    for (const Bytecode* opt : {&o1, &o2}) {
+        GraphVM vm;
+        VMContext ctx;
+        ctx.inputs = {4};
+        vm.Execute(*opt, ctx);
+        assert(vm.GetLocal(1) == 45);
+    }
+    std::cout << "[PASS] test_optimizer_levels" << std::endl;
+}
+
+namespace {
+
+// Random stack-safe programs: statements with net-zero stack effect,
+// forward branches and an optional value left on the stack.
+struct RandomProgram {
+    std::mt19937& rng;
+    Bytecode bc;
+    std::vector<std::vector<Instruction>> exprs;
+
+    uint32_t Pick(uint32_t n) { return std::uniform_int_distribution<uint32_t>(0, n - 1)(rng); }
+
+    void Emit(OpCode op, uint32_t a = 0) { bc.instructions.push_back({op, a, 0, 0}); }
+
+    void Constant() {
+        static const Value values[] = {0, 1, -1, 2, 3, 5, 7, -13, 100};
+        bc.constants.push_back(values[Pick(9)]);
+        Emit(OpCode::LOAD_CONST, static_cast<uint32_t>(bc.constants.size() - 1));
+    }
+
+    void Expression(int depth) {
+        size_t start = bc.instructions.size();
+        if (!exprs.empty() && Pick(4) == 0) {
+            // Repeat an earlier expression so CSE has something to find
+            for (const auto& inst : exprs[Pick(static_cast<uint32_t>(exprs.size()))]) {
+                bc.instructions.push_back(inst);
+            }
+            return;
+        }
+        if (depth == 0 || Pick(3) == 0) {
+            if (Pick(2) == 0) Constant();
+            else Emit(OpCode::LOAD_VAR, Pick(4));
+        } else {
+            static const OpCode ops[] = {OpCode::ADD, OpCode::SUB, OpCode::MUL, OpCode::DIV,
+                                         OpCode::CMP_EQ, OpCode::CMP_LT, OpCode::CMP_GT};
+            Expression(depth - 1);
+            Expression(depth - 1);
+            Emit(ops[Pick(7)]);
+        }
+        if (bc.instructions.size() - start >= 2) {
+            exprs.emplace_back(bc.instructions.begin() + start, bc.instructions.end());
+        }
+    }
+
+    void Statements(int count, int nesting) {
+        for (int s = 0; s < count; ++s) {
+            switch (Pick(nesting > 0 ? 6 : 4)) {
+                case 0:
+                case 1:
+                    Expression(3);
+                    Emit(OpCode::STORE_VAR, Pick(4));
+                    break;
+                case 2:
+                    Emit(Pick(2) ? OpCode::NOP : OpCode::EMIT_EVENT, Pick(3));
+                    break;
+                case 3: {
+                    // Jump to the next instruction
+                    uint32_t next = static_cast<uint32_t>(bc.instructions.size() + 1);
+                    Emit(OpCode::JUMP, next);
+                    break;
+                }
+                default: {
+                    Expression(2);
+                    size_t branch = bc.instructions.size();
+                    Emit(OpCode::JUMP_IF_FALSE);
+                    Statements(1 + static_cast<int>(Pick(3)), nesting - 1);
+                    if (Pick(2) == 0) {
+                        size_t skip = bc.instructions.size();
+                        Emit(OpCode::JUMP);
+                        bc.instructions[branch].a = static_cast<uint32_t>(bc.instructions.size());
+                        Statements(1 + static_cast<int>(Pick(2)), nesting - 1);
+                        bc.instructions[skip].a = static_cast<uint32_t>(bc.instructions.size());
+                    } else {
+                        bc.instructions[branch].a = static_cast<uint32_t>(bc.instructions.size());
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    Bytecode Generate() {
+        Statements(4 + static_cast<int>(Pick(8)), 2);
+        if (Pick(2) == 0) Expression(2);
+        if (Pick(4) != 0) Emit(OpCode::END);
+        return bc;
+    }
+};
+
+}
+
+void test_optimizer_randomized_verifier() {
+    std::mt19937 rng(1234);
+    uint32_t before = 0, after = 0;
+    for (int i = 0; i < 300; ++i) {
+        RandomProgram gen{rng, {}, {}};
+        Bytecode bc = gen.Generate();
+        assert(CheckStackSafety(bc));
+
+        for (OptLevel level : {OptLevel::O1, OptLevel::O2}) {
+            Bytecode opt = BytecodeOptimizer::Optimize(bc, level);
+            VerifyOptions options;
+            options.trials = 32;
+            options.seed = static_cast<uint64_t>(i);
+            VerifyResult result = VerifyEquivalence(bc, opt, options);
+            if (!result.equivalent) {
+                std::cout << "  program " << i << ": " << result.mismatch << std::endl;
+            }
+            assert(result.equivalent);
+            assert(result.trials == 32);
+            if (level == OptLevel::O2) {
+                before += static_cast<uint32_t>(bc.instructions.size());
+                after += static_cast<uint32_t>(opt.instructions.size());
+            }
+        }
+    }
+    assert(after < before);
+
+    // The verifier notices a wrong rewrite
+    Bytecode bc;
+    bc.constants = {5};
+    bc.instructions = {
+        {OpCode::LOAD_VAR, 0, 0, 0},
+        {OpCode::LOAD_CONST, 0, 0, 0},
+        {OpCode::SUB, 0, 0, 0},
+        {OpCode::END, 0, 0, 0}
+    };
+    Bytecode wrong = bc;
+    wrong.instructions[2].opcode = OpCode::ADD;
+    VerifyResult result = VerifyEquivalence(bc, wrong);
+    assert(!result.equivalent);
+    assert(!result.mismatch.empty());
+
+    Bytecode underflow;
+    underflow.instructions = {{OpCode::ADD, 0, 0, 0}};
+    assert(!CheckStackSafety(underflow));
+    assert(!VerifyEquivalence(underflow, underflow).equivalent);
+    std::cout << "[PASS] test_optimizer_randomized_verifier (" << before << " -> " << after
+              << " instructions)" << std::endl;
+}
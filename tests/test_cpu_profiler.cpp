@@ -0,0 +1,255 @@
+#include "../engine/core/Profiler.h"
+#include "../engine/sim/JobTracer.h"
+#include "../editor/panels/ProfilerPanel.h"
+#include "../editor/panels/JobTracePanel.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+
+using namespace atlas::profile;
+
+static const ProfileFrame& FreshFrame(uint64_t frameNumber) {
+    // Drain anything left over from earlier tests
+    Profiler::Get().EndFrame(0);
+    return Profiler::Get().EndFrame(frameNumber);
+}
+
+static size_t CountNamed(const ProfileFrame& frame, const char* name) {
+    size_t n = 0;
+    for (const auto& e : frame.events) {
+        if (e.name && std::strcmp(e.name, name) == 0) n++;
+    }
+    return n;
+}
+
+void test_cpu_profiler_nested_scopes() {
+    Profiler::SetEnabled(true);
+    FreshFrame(0);
+    {
+        ATLAS_PROFILE_SCOPE("Outer");
+        {
+            ATLAS_PROFILE_SCOPE("Middle");
+            ATLAS_PROFILE_SCOPE("Inner");
+        }
+        ATLAS_PROFILE_SCOPE("Sibling");
+    }
+    const auto& frame = Profiler::Get().EndFrame(7);
+    Profiler::SetEnabled(false);
+
+    assert(frame.frameNumber == 7);
+    assert(frame.events.size() == 4);
+    // Sorted by begin: parents before children
+    assert(std::strcmp(frame.events[0].name, "Outer") == 0);
+    assert(std::strcmp(frame.events[1].name, "Middle") == 0);
+    assert(std::strcmp(frame.events[2].name, "Inner") == 0);
+    assert(std::strcmp(frame.events[3].name, "Sibling") == 0);
+    assert(frame.events[0].depth == 0);
+    assert(frame.events[1].depth == 1);
+    assert(frame.events[2].depth == 2);
+    assert(frame.events[3].depth == 1);
+
+    const auto& outer = frame.events[0];
+    for (size_t i = 1; i < frame.events.size(); ++i) {
+        assert(frame.events[i].begin >= outer.begin);
+        assert(frame.events[i].end <= outer.end);
+        assert(frame.events[i].threadId == outer.threadId);
+    }
+    assert(frame.events[2].end <= frame.events[1].end);
+    assert(frame.end >= outer.end);
+
+    std::cout << "[PASS] test_cpu_profiler_nested_scopes" << std::endl;
+}
+
+void test_cpu_profiler_disabled() {
+    Profiler::SetEnabled(false);
+    FreshFrame(0);
+    for (int i = 0; i < 100; ++i) {
+        ATLAS_PROFILE_SCOPE("Disabled");
+    }
+    const auto& frame = Profiler::Get().EndFrame(1);
+    assert(CountNamed(frame, "Disabled") == 0);
+
+    std::cout << "[PASS] test_cpu_profiler_disabled" << std::endl;
+}
+
+void test_cpu_profiler_threads() {
+    Profiler::SetEnabled(true);
+    FreshFrame(0);
+
+    constexpr int kThreads = 4;
+    constexpr int kScopes = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < kScopes; ++i) {
+                ATLAS_PROFILE_SCOPE("Worker.Outer");
+                ATLAS_PROFILE_SCOPE("Worker.Inner");
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    const auto& frame = Profiler::Get().EndFrame(2);
+    Profiler::SetEnabled(false);
+
+    assert(CountNamed(frame, "Worker.Outer") == kThreads * kScopes);
+    assert(CountNamed(frame, "Worker.Inner") == kThreads * kScopes);
+    std::set<uint32_t> ids;
+    for (const auto& e : frame.events) {
+        if (std::strcmp(e.name, "Worker.Inner") == 0) {
+            assert(e.depth == 1);
+            ids.insert(e.threadId);
+        }
+    }
+    // Threads ran concurrently or back to back; either way each had a ring
+    assert(!ids.empty() && ids.size() <= kThreads);
+    for (size_t i = 1; i < frame.events.size(); ++i) {
+        assert(frame.events[i - 1].begin <= frame.events[i].begin);
+    }
+    assert(Profiler::Get().DroppedCount() == 0);
+
+    std::cout << "[PASS] test_cpu_profiler_threads" << std::endl;
+}
+
+void test_cpu_profiler_chrome_trace() {
+    Profiler::SetEnabled(true);
+    FreshFrame(0);
+    Profiler::Get().SetThreadName("Test \"Main\"");
+    Profiler::Get().StartCapture();
+    {
+        ATLAS_PROFILE_SCOPE("Export.Outer");
+        ATLAS_PROFILE_SCOPE("Export.Inner");
+    }
+    Profiler::Get().EndFrame(1);
+    const char* quoted = Profiler::Get().Intern("Say \"hi\"");
+    assert(quoted == Profiler::Get().Intern(std::string("Say \"hi\"")));
+    {
+        ProfileScope scope(quoted);
+    }
+    Profiler::Get().EndFrame(2);
+    Profiler::Get().StopCapture();
+    Profiler::SetEnabled(false);
+
+    assert(Profiler::Get().Captured().size() == 3);
+    std::string json = Profiler::Get().ChromeTraceJson(Profiler::Get().Captured());
+    assert(json.rfind("{\"traceEvents\":[", 0) == 0);
+    assert(json.find("\"name\":\"Export.Outer\",\"cat\":\"atlas\",\"ph\":\"X\",\"ts\":0.000") != std::string::npos);
+    assert(json.find("\"name\":\"Export.Inner\"") != std::string::npos);
+    assert(json.find("\"name\":\"Say \\\"hi\\\"\"") != std::string::npos);
+    assert(json.find("\"ph\":\"M\"") != std::string::npos);
+    assert(json.find("Test \\\"Main\\\"") != std::string::npos);
+    assert(json.find("\"dur\":") != std::string::npos);
+
+    std::string path = "test_cpu_profiler_trace.json";
+    assert(Profiler::Get().WriteChromeTrace(path));
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    assert(ss.str() == json);
+    in.close();
+    std::remove(path.c_str());
+
+    std::cout << "[PASS] test_cpu_profiler_chrome_trace" << std::endl;
+}
+
+void test_cpu_profiler_reused_ring_new_thread_id() {
+    Profiler::SetEnabled(true);
+    FreshFrame(0);
+    Profiler::Get().StartCapture();
+
+    // The second thread starts after the first exits, so it takes over its ring
+    auto run = [](const char* threadName, const char* scopeName) {
+        std::thread([=] {
+            Profiler::Get().SetThreadName(threadName);
+            ProfileScope scope(scopeName);
+        }).join();
+    };
+    size_t rings = Profiler::Get().ThreadCount();
+    run("Reuse First", "Reuse.A");
+    run("Reuse Second", "Reuse.B");
+    assert(Profiler::Get().ThreadCount() <= rings + 1);
+
+    Profiler::Get().EndFrame(1);
+    Profiler::Get().StopCapture();
+    Profiler::SetEnabled(false);
+
+    const auto& captured = Profiler::Get().Captured();
+    assert(captured.size() == 2);
+    assert(captured[0].threadId != captured[1].threadId);
+
+    std::string json = Profiler::Get().ChromeTraceJson(captured);
+    for (const auto& e : captured) {
+        const char* threadName = std::strcmp(e.name, "Reuse.A") == 0 ? "Reuse First" : "Reuse Second";
+        std::string meta = "\"tid\":" + std::to_string(e.threadId) + ",\"args\":{\"name\":\"" + threadName;
+        assert(json.find(meta) != std::string::npos);
+    }
+
+    std::cout << "[PASS] test_cpu_profiler_reused_ring_new_thread_id" << std::endl;
+}
+
+void test_cpu_profiler_feeds_panels() {
+    Profiler::SetEnabled(true);
+    FreshFrame(0);
+
+    atlas::sim::JobTracer tracer;
+    tracer.BeginTick(1);
+    {
+        ATLAS_PROFILE_SCOPE("Tick");
+        tracer.RecordSystemStart("Physics");
+        {
+            ATLAS_PROFILE_SCOPE("Physics.Broadphase");
+        }
+        tracer.RecordSystemEnd();
+        tracer.RecordSystemStart("AI");
+        tracer.RecordSystemEnd();
+    }
+    {
+        ATLAS_PROFILE_SCOPE("Render");
+    }
+    tracer.EndTick();
+    std::thread([] { ATLAS_PROFILE_SCOPE("Background"); }).join();
+
+    const auto& frame = Profiler::Get().EndFrame(42);
+    Profiler::SetEnabled(false);
+    assert(CountNamed(frame, "Physics") == 1);
+    assert(CountNamed(frame, "AI") == 1);
+    assert(tracer.LatestTrace()->entries[0].durationUs >= 0.0);
+
+    atlas::editor::ProfilerPanel panel;
+    panel.SetProfiler(&Profiler::Get());
+    panel.RecordProfileFrame(frame);
+    assert(panel.FrameCount() == 1);
+    assert(panel.History()[0].frameNumber == 42);
+    assert(panel.History()[0].frameDurationMs >= panel.History()[0].tickDurationMs);
+    assert(panel.History()[0].tickDurationMs > 0.0);
+
+    const auto& metrics = panel.CurrentMetrics();
+    assert(metrics.size() == 6);
+    assert(metrics[0].systemName == "Tick" && metrics[0].depth == 0);
+    assert(metrics[1].systemName == "Physics" && metrics[1].depth == 1);
+    assert(metrics[2].systemName == "Physics.Broadphase" && metrics[2].depth == 2);
+    assert(metrics[3].systemName == "AI" && metrics[3].depth == 1);
+    assert(metrics[1].durationMs >= metrics[2].durationMs);
+
+    // Draw pulls only frames it has not seen yet
+    panel.Draw();
+    assert(panel.FrameCount() == 1);
+
+    atlas::editor::JobTracePanel tracePanel;
+    tracePanel.SetTracer(&tracer);
+    tracePanel.SetProfiler(&Profiler::Get());
+    tracePanel.Refresh();
+    const auto& lanes = tracePanel.ThreadLanes();
+    assert(lanes.size() == 2);
+    uint32_t scopes = 0;
+    for (const auto& lane : lanes) scopes += lane.scopeCount;
+    assert(scopes == frame.events.size());
+    tracePanel.Draw();
+
+    std::cout << "[PASS] test_cpu_profiler_feeds_panels" << std::endl;
+}
@@ -0,0 +1,134 @@
+#include "../engine/camera/Culling.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+
+using namespace atlas::camera;
+
+namespace {
+
+// Camera at the origin looking down +z, square aspect, 90 degree FOV
+CullView ForwardView() {
+    Camera cam;
+    cam.SetPosition(0.0f, 0.0f, 0.0f);
+    cam.SetYawPitch(0.0f, 0.0f);
+    cam.SetFOV(90.0f);
+    cam.SetClipPlanes(0.5f, 500.0f);
+    return CullView::FromCamera(cam, 1.0f);
+}
+
+Vec3 Offset(const Vec3& v, float d) {
+    return {v.x + d, v.y + d, v.z + d};
+}
+
+}
+
+void test_culling_frustum_from_camera() {
+    Frustum f = Frustum::FromView(ForwardView());
+    Vec3 c{0.0f, 0.0f, 50.0f};
+    assert(f.TestAABB(Offset(c, -1.0f), Offset(c, 1.0f)));
+    assert(!f.TestAABB({-1.0f, -1.0f, -60.0f}, {1.0f, 1.0f, -40.0f}));   // behind
+    assert(!f.TestAABB({-1.0f, -1.0f, 600.0f}, {1.0f, 1.0f, 620.0f}));   // past far
+    assert(!f.TestAABB({80.0f, -1.0f, 49.0f}, {82.0f, 1.0f, 51.0f}));    // left of the 45 degree edge
+    assert(f.TestAABB({48.0f, -1.0f, 49.0f}, {52.0f, 1.0f, 51.0f}));     // straddles it
+
+    // Orbital cameras look at their target
+    Camera orbit;
+    orbit.SetMode(CameraMode::Orbital);
+    orbit.SetPosition(0.0f, 0.0f, 20.0f);
+    orbit.SetTarget(0.0f, 0.0f, 0.0f);
+    CullView view = CullView::FromCamera(orbit, 16.0f / 9.0f);
+    assert(view.forward.z < -0.99f);
+    assert(view.tanHalfX > view.tanHalfY);
+    Frustum of = Frustum::FromView(view);
+    assert(of.TestAABB({-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}));
+    assert(!of.TestAABB({-1.0f, -1.0f, 30.0f}, {1.0f, 1.0f, 32.0f}));
+    std::cout << "[PASS] test_culling_frustum_from_camera" << std::endl;
+}
+
+void test_culling_soa_matches_scalar() {
+    CullingStage stage;
+    stage.SetView(ForwardView());
+    AABBList boxes;
+    uint32_t seed = 12345;
+    auto next = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / 16777216.0f;
+    };
+    for (int i = 0; i < 5000; ++i) {
+        Vec3 c{next() * 800.0f - 400.0f, next() * 800.0f - 400.0f, next() * 800.0f - 400.0f};
+        Vec3 e{next() * 20.0f, next() * 20.0f, next() * 20.0f};
+        boxes.Add(c - e, c + e);
+    }
+
+    std::vector<uint32_t> visible, serial;
+    stage.Cull(boxes, visible, 37);
+    assert(stage.Stats().tested == 5000);
+    assert(stage.Stats().visible == visible.size());
+    assert(stage.Stats().frustumCulled + visible.size() == 5000);
+    assert(!visible.empty() && visible.size() < 5000);
+
+    size_t next_ = 0;
+    for (uint32_t i = 0; i < 5000; ++i) {
+        bool in = stage.GetFrustum().TestAABB({boxes.minX[i], boxes.minY[i], boxes.minZ[i]},
+                                              {boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]});
+        if (in) assert(next_ < visible.size() && visible[next_++] == i);
+    }
+    assert(next_ == visible.size());
+
+    // Same compact list whatever the job split
+    stage.Cull(boxes, serial, 1 << 20);
+    assert(serial == visible);
+    std::cout << "[PASS] test_culling_soa_matches_scalar" << std::endl;
+}
+
+void test_culling_occlusion_buffer() {
+    CullView view = ForwardView();
+    OcclusionBuffer buffer(64, 64);
+    buffer.Begin(view);
+    // A wall 10 units ahead covering the middle of the view
+    buffer.AddOccluderBox({-6.0f, -6.0f, 10.0f}, {6.0f, 6.0f, 11.0f});
+    assert(buffer.OccluderTriangles() > 0);
+    buffer.BuildHiZ();
+    assert(buffer.LevelCount() == 7);
+    assert(buffer.Depth(32, 32) <= 10.0f + 1e-3f);
+    assert(buffer.Depth(0, 0) > 1e30f);
+
+    assert(!buffer.IsVisible({-1.0f, -1.0f, 30.0f}, {1.0f, 1.0f, 32.0f}));   // behind the wall
+    assert(buffer.IsVisible({-1.0f, -1.0f, 4.0f}, {1.0f, 1.0f, 5.0f}));      // in front
+    assert(buffer.IsVisible({20.0f, -1.0f, 30.0f}, {22.0f, 1.0f, 32.0f}));   // beside, in the open
+    assert(buffer.IsVisible({-1.0f, -1.0f, 9.5f}, {1.0f, 1.0f, 40.0f}));     // pokes out in front
+    assert(!buffer.IsVisible({-1.0f, -1.0f, 10.5f}, {1.0f, 1.0f, 40.0f}));   // starts inside the wall
+    assert(buffer.IsVisible({-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 30.0f}));    // reaches the near plane
+    // Peeking past the edge of the wall
+    assert(buffer.IsVisible({-1.0f, 4.0f, 30.0f}, {1.0f, 40.0f, 32.0f}));
+    std::cout << "[PASS] test_culling_occlusion_buffer" << std::endl;
+}
+
+void test_culling_stage_occlusion() {
+    CullingStage stage;
+    stage.SetView(ForwardView());
+    stage.Occlusion().AddOccluderBox({-6.0f, -6.0f, 10.0f}, {6.0f, 6.0f, 11.0f});
+
+    AABBList boxes;
+    boxes.Add({-1.0f, -1.0f, 30.0f}, {1.0f, 1.0f, 32.0f});    // hidden
+    boxes.Add({-1.0f, -1.0f, 4.0f}, {1.0f, 1.0f, 5.0f});      // visible
+    boxes.Add({-1.0f, -1.0f, -30.0f}, {1.0f, 1.0f, -28.0f});  // behind the camera
+    boxes.Add({30.0f, -1.0f, 40.0f}, {32.0f, 1.0f, 42.0f});   // visible
+
+    std::vector<uint32_t> visible;
+    stage.Cull(boxes, visible);
+    assert((visible == std::vector<uint32_t>{1, 3}));
+    assert(stage.Stats().occlusionCulled == 1 && stage.Stats().frustumCulled == 1);
+
+    stage.SetOcclusionEnabled(false);
+    stage.Cull(boxes, visible);
+    assert((visible == std::vector<uint32_t>{0, 1, 3}));
+
+    // A new view clears the occluders
+    stage.SetOcclusionEnabled(true);
+    stage.SetView(ForwardView());
+    stage.Cull(boxes, visible);
+    assert(visible.size() == 3 && stage.Stats().occlusionCulled == 0);
+    std::cout << "[PASS] test_culling_stage_occlusion" << std::endl;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include "animation/DeterministicAnimationGraph.h"
 
@@ -197,3 +198,156 @@ void test_det_anim_deterministic() {
     }
     std::cout << "[PASS] test_det_anim_deterministic" << std::endl;
 }
+
+namespace {
+
+// Halves every position; has no crowd kernel, so crowd evaluation falls
+// back to per-skeleton Evaluate for it.
+class HalfScaleNode : public BoneNode {
+public:
+    const char* GetName() const override { return "HalfScale"; }
+    const char* GetCategory() const override { return "Test"; }
+    std::vector<BonePort> Inputs() const override {
+        return {{"Pose", BonePinType::BoneTransform}};
+    }
+    std::vector<BonePort> Outputs() const override {
+        return {{"Pose", BonePinType::BoneTransform}};
+    }
+    void Evaluate(const BoneContext&, const std::vector<BoneValue>& inputs,
+                  std::vector<BoneValue>& outputs) const override {
+        BoneValue pose = inputs[0];
+        pose.type = BonePinType::BoneTransform;
+        for (size_t i = 0; i < pose.data.size(); ++i) {
+            if (i % 7 < 3) pose.data[i] *= 0.5f;
+        }
+        outputs[0] = std::move(pose);
+    }
+};
+
+struct CrowdTestGraph {
+    DeterministicAnimationGraph graph;
+    PoseInputNode* input = nullptr;
+    std::vector<BoneNodeID> nodes;
+};
+
+void BuildCrowdTestGraph(CrowdTestGraph& t) {
+    auto& g = t.graph;
+    auto input = std::make_unique<PoseInputNode>();
+    t.input = input.get();
+    auto inputID = g.AddNode(std::move(input));
+    auto restID = g.AddNode(std::make_unique<RestPoseNode>());
+    auto fk = std::make_unique<FKNode>();
+    fk->rotationAngle = 0.3f;
+    auto fkID = g.AddNode(std::move(fk));
+    auto ik = std::make_unique<IKNode>();
+    ik->targetX = 1.5f;
+    ik->targetY = -0.5f;
+    ik->targetZ = 2.0f;
+    ik->iterations = 3;
+    auto ikID = g.AddNode(std::move(ik));
+    auto blend = std::make_unique<BlendTreeNode>();
+    blend->weight = 0.35f;
+    auto blendID = g.AddNode(std::move(blend));
+    auto mask = std::make_unique<BoneMaskNode>();
+    mask->mask = {true, false, true, true, false, true};
+    auto maskID = g.AddNode(std::move(mask));
+    auto add = std::make_unique<AdditiveBlendNode>();
+    add->strength = 0.75f;
+    auto addID = g.AddNode(std::move(add));
+    auto halfID = g.AddNode(std::make_unique<HalfScaleNode>());
+    auto lonelyBlendID = g.AddNode(std::make_unique<BlendTreeNode>());
+
+    g.AddEdge({inputID, 0, fkID, 0});
+    g.AddEdge({fkID, 0, ikID, 0});
+    g.AddEdge({ikID, 0, blendID, 0});
+    g.AddEdge({restID, 0, blendID, 1});
+    g.AddEdge({blendID, 0, maskID, 0});
+    g.AddEdge({maskID, 0, addID, 0});
+    g.AddEdge({inputID, 0, addID, 1});
+    g.AddEdge({addID, 0, halfID, 0});
+    g.AddEdge({halfID, 0, lonelyBlendID, 1});
+    t.nodes = {inputID, restID, fkID, ikID, blendID, maskID, addID, halfID, lonelyBlendID};
+}
+
+} // namespace
+
+void test_det_anim_crowd_matches_single() {
+    const uint32_t instances = 37;   // not a multiple of the SIMD width
+    BoneContext ctx;
+    ctx.boneCount = 6;
+
+    CrowdPose poses;
+    poses.Resize(instances, ctx.boneCount);
+    uint32_t state = 12345;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / 16777216.0f * 4.0f - 2.0f;
+    };
+    for (uint32_t i = 0; i < instances; ++i) {
+        for (uint32_t b = 0; b < ctx.boneCount; ++b) {
+            BoneTransform t{next(), next(), next(), next(), next(), next(), next()};
+            poses.SetBone(i, b, t);
+        }
+    }
+
+    CrowdTestGraph crowd;
+    BuildCrowdTestGraph(crowd);
+    crowd.input->crowd = &poses;
+    assert(crowd.graph.Compile());
+    CrowdEvalOptions options;
+    options.chunkSize = 8;
+    assert(crowd.graph.ExecuteCrowd(ctx, instances, options));
+
+    CrowdTestGraph single;
+    BuildCrowdTestGraph(single);
+    assert(single.graph.Compile());
+    std::vector<float> aos;
+    for (uint32_t i = 0; i < instances; ++i) {
+        poses.GatherInstance(i, single.input->pose);
+        assert(single.graph.Execute(ctx));
+        for (BoneNodeID id : single.nodes) {
+            const BoneValue* expected = single.graph.GetOutput(id, 0);
+            const CrowdPose* actual = crowd.graph.GetCrowdOutput(id, 0);
+            assert(expected && actual);
+            actual->GatherInstance(i, aos);
+            assert(aos.size() == expected->data.size());
+            assert(std::memcmp(aos.data(), expected->data.data(), aos.size() * sizeof(float)) == 0);
+        }
+    }
+    std::cout << "[PASS] test_det_anim_crowd_matches_single" << std::endl;
+}
+
+void test_det_anim_crowd_chunking_invariant() {
+    BoneContext ctx;
+    ctx.boneCount = 5;
+    CrowdTestGraph a;
+    BuildCrowdTestGraph(a);
+    a.input->pose.assign(ctx.boneCount * 7, 0.25f);
+    assert(a.graph.Compile());
+    CrowdEvalOptions serial;
+    serial.parallel = false;
+    assert(a.graph.ExecuteCrowd(ctx, 203, serial));
+
+    CrowdTestGraph b;
+    BuildCrowdTestGraph(b);
+    b.input->pose = a.input->pose;
+    assert(b.graph.Compile());
+    CrowdEvalOptions chunked;
+    chunked.chunkSize = 5;   // rounded up to whole SIMD groups
+    assert(b.graph.ExecuteCrowd(ctx, 203, chunked));
+
+    BoneNodeID last = a.nodes.back();
+    const CrowdPose* pa = a.graph.GetCrowdOutput(last, 0);
+    const CrowdPose* pb = b.graph.GetCrowdOutput(last, 0);
+    for (uint32_t c = 0; c < kBoneChannels; ++c) {
+        assert(pa->lanes[c].size() == 203u * 5u);
+        assert(std::memcmp(pa->lanes[c].data(), pb->lanes[c].data(),
+                           pa->lanes[c].size() * sizeof(float)) == 0);
+    }
+
+    // Re-running with another crowd size reuses the plan
+    assert(b.graph.ExecuteCrowd(ctx, 16, chunked));
+    assert(b.graph.GetCrowdOutput(last, 0)->instanceCount == 16);
+    assert(b.graph.GetCrowdOutput(9999, 0) == nullptr);
+    std::cout << "[PASS] test_det_anim_crowd_chunking_invariant" << std::endl;
+}
@@ -0,0 +1,180 @@
+#include "../engine/assets/FileWatcher.h"
+#include "../engine/assets/AssetRegistry.h"
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+
+using namespace atlas::asset;
+
+namespace {
+
+std::string WatchTmp(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir.string();
+}
+
+void WriteText(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << text;
+}
+
+}
+
+void test_file_watcher_reports_writes() {
+    if (FileWatcher::AvailableBackend() == FileWatchBackend::None) {
+        std::cout << "[SKIP] test_file_watcher_reports_writes (no backend)" << std::endl;
+        return;
+    }
+    std::string dir = WatchTmp("atlas_watch_writes");
+    FileWatcher watcher;
+    watcher.SetDebounce(std::chrono::milliseconds(0));
+    assert(watcher.Watch(dir));
+    assert(watcher.IsWatching());
+    assert(watcher.Poll().empty());
+
+    std::string path = (std::filesystem::path(dir) / "ship.atlas").string();
+    WriteText(path, "v1");
+    auto changed = watcher.Poll();
+    assert(changed.size() == 1 && changed[0] == path);
+    assert(watcher.Poll().empty());
+
+    // Save through a temp file and rename
+    std::string tmp = path + ".tmp";
+    WriteText(tmp, "v2");
+    std::filesystem::rename(tmp, path);
+    changed = watcher.Poll();
+    assert(std::find(changed.begin(), changed.end(), path) != changed.end());
+
+    assert(!watcher.Watch(dir + "/missing"));
+    watcher.Close();
+    assert(!watcher.IsWatching());
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_file_watcher_reports_writes" << std::endl;
+}
+
+void test_file_watcher_debounce() {
+    if (FileWatcher::AvailableBackend() == FileWatchBackend::None) {
+        std::cout << "[SKIP] test_file_watcher_debounce (no backend)" << std::endl;
+        return;
+    }
+    std::string dir = WatchTmp("atlas_watch_debounce");
+    FileWatcher watcher;
+    watcher.SetDebounce(std::chrono::milliseconds(100));
+    assert(watcher.Watch(dir));
+
+    std::string path = (std::filesystem::path(dir) / "terrain.atlas").string();
+    auto start = FileWatcher::Clock::now();
+    for (int i = 0; i < 5; ++i) WriteText(path, "chunk " + std::to_string(i));
+
+    // Still settling: nothing reported, one coalesced change pending
+    assert(watcher.Poll(start).empty());
+    assert(watcher.PendingCount() == 1);
+
+    auto changed = watcher.Poll(start + std::chrono::milliseconds(500));
+    assert(changed.size() == 1 && changed[0] == path);
+    assert(watcher.PendingCount() == 0);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_file_watcher_debounce" << std::endl;
+}
+
+void test_file_watcher_new_directory() {
+    if (FileWatcher::AvailableBackend() == FileWatchBackend::None) {
+        std::cout << "[SKIP] test_file_watcher_new_directory (no backend)" << std::endl;
+        return;
+    }
+    std::string dir = WatchTmp("atlas_watch_subdir");
+    FileWatcher watcher;
+    watcher.SetDebounce(std::chrono::milliseconds(0));
+    assert(watcher.Watch(dir));
+    assert(watcher.WatchedDirectoryCount() == 1);
+
+    std::filesystem::create_directories(std::filesystem::path(dir) / "meshes");
+    watcher.Poll();
+    assert(watcher.WatchedDirectoryCount() == 2);
+
+    std::string path = (std::filesystem::path(dir) / "meshes" / "hull.atlas").string();
+    WriteText(path, "hull");
+    auto changed = watcher.Poll();
+    assert(changed.size() == 1 && changed[0] == path);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_file_watcher_new_directory" << std::endl;
+}
+
+void test_registry_watcher_reload() {
+    std::string dir = WatchTmp("atlas_watch_registry");
+    WriteText(dir + "/ship.atlas", "v1");
+    WriteText(dir + "/station.atlas", "v1");
+
+    AssetRegistry registry;
+    registry.Scan(dir);
+    if (!registry.EnableFileWatcher(std::chrono::milliseconds(0))) {
+        std::filesystem::remove_all(dir);
+        std::cout << "[SKIP] test_registry_watcher_reload (no backend)" << std::endl;
+        return;
+    }
+    assert(registry.IsFileWatcherEnabled());
+    assert(registry.PollHotReload() == 0);
+
+    std::vector<std::string> reloaded;
+    registry.SetReloadCallback([&](const AssetEntry& e) { reloaded.push_back(e.id); });
+    WriteText(registry.Get("ship")->path, "v2");
+    WriteText(dir + "/untracked.txt", "ignored");
+
+    assert(registry.PollHotReload() == 1);
+    assert((reloaded == std::vector<std::string>{"ship"}));
+    assert(registry.Get("ship")->version == 2);
+    assert(registry.Get("station")->version == 1);
+    assert(registry.PollHotReload() == 0);
+
+    // Back to timestamp polling
+    registry.DisableFileWatcher();
+    assert(!registry.IsFileWatcherEnabled());
+    std::string station = registry.Get("station")->path;
+    std::filesystem::last_write_time(station,
+        std::filesystem::last_write_time(station) + std::chrono::seconds(5));
+    assert(registry.PollHotReload() == 1);
+    assert(registry.Get("station")->version == 2);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_registry_watcher_reload" << std::endl;
+}
+
+void test_registry_reload_dependents() {
+    std::string dir = WatchTmp("atlas_watch_dependents");
+    for (const char* id : {"texture", "material", "mesh", "prop", "unrelated"}) {
+        WriteText(dir + "/" + id + ".atlas", id);
+    }
+
+    AssetRegistry registry;
+    registry.Scan(dir);
+    registry.AddDependency("material", "texture");
+    registry.AddDependency("mesh", "material");
+    registry.AddDependency("prop", "mesh");
+    registry.AddDependency("prop", "texture");
+
+    std::vector<std::string> order;
+    size_t batches = 0;
+    registry.SetBatchReloadCallback([&](const std::vector<const AssetEntry*>& batch) {
+        batches++;
+        for (const auto* e : batch) order.push_back(e->id);
+    });
+
+    std::string texture = registry.Get("texture")->path;
+    std::filesystem::last_write_time(texture,
+        std::filesystem::last_write_time(texture) + std::chrono::seconds(5));
+
+    assert(registry.PollHotReload() == 4);
+    assert(batches == 1);
+    assert((order == std::vector<std::string>{"texture", "material", "mesh", "prop"}));
+    assert(registry.Get("prop")->version == 2);
+    assert(registry.Get("unrelated")->version == 1);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_registry_reload_dependents" << std::endl;
+}
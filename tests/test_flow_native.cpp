@@ -0,0 +1,316 @@
+#include "../engine/flow/FlowGraphNative.h"
+#include "../engine/flow/FlowGraphCodegen.h"
+#include "../engine/production/AssetCooker.h"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+
+using namespace atlas::flow;
+
+namespace {
+
+FlowNodeIR MakeNode(uint32_t id, const std::string& type, const std::string& stateName = "") {
+    FlowNodeIR node;
+    node.id = id;
+    node.type = type;
+    if (!stateName.empty()) node.properties.push_back({"stateName", stateName});
+    return node;
+}
+
+// Menu -> Transition <- Condition; Transition -> Timer -> Gameplay
+FlowGraphIR MakeMenuFlow() {
+    FlowGraphIR ir;
+    ir.name = "MenuFlow";
+    ir.graphType = "Gameplay";
+    ir.nodes.push_back(MakeNode(1, "State", "MainMenu"));
+    ir.nodes.push_back(MakeNode(2, "Condition"));
+    ir.nodes.push_back(MakeNode(3, "Transition"));
+    ir.nodes.push_back(MakeNode(4, "Timer"));
+    ir.nodes.push_back(MakeNode(5, "State", "Gameplay"));
+    ir.nodes.push_back(MakeNode(6, "State"));
+    ir.edges.push_back({1, 0, 3, 0});
+    ir.edges.push_back({2, 0, 3, 1});
+    ir.edges.push_back({3, 0, 4, 0});
+    ir.edges.push_back({4, 0, 5, 0});
+    return ir;
+}
+
+std::string TempDir(const char* name) {
+    auto dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir.string();
+}
+
+void AssertSameValues(const FlowGraphIR& ir, FlowGraphRuntime& a, FlowGraphRuntime& b) {
+    for (float t : {0.0f, 0.5f, 1.0f, 3.0f}) {
+        FlowContext ctx{t, true, static_cast<uint32_t>(t * 60)};
+        assert(a.Execute(ctx));
+        assert(b.Execute(ctx));
+        for (const auto& n : ir.nodes) {
+            assert(a.GetValue(n.id) == b.GetValue(n.id));
+            assert(a.GetText(n.id) == b.GetText(n.id));
+        }
+    }
+}
+
+}
+
+void test_flow_native_ir_hash() {
+    FlowGraphIR a = MakeMenuFlow();
+    FlowGraphIR b = MakeMenuFlow();
+    assert(HashFlowGraphIR(a) == HashFlowGraphIR(b));
+
+    // Editor layout does not make a binary stale
+    b.nodes[0].posX = 120.0f;
+    b.nodes[0].category = "Flow";
+    assert(HashFlowGraphIR(a) == HashFlowGraphIR(b));
+
+    b.nodes[0].properties[0].second = "Settings";
+    assert(HashFlowGraphIR(a) != HashFlowGraphIR(b));
+    FlowGraphIR c = MakeMenuFlow();
+    c.edges.pop_back();
+    assert(HashFlowGraphIR(a) != HashFlowGraphIR(c));
+    std::cout << "[PASS] test_flow_native_ir_hash" << std::endl;
+}
+
+void test_flow_native_interpreter_fallback() {
+    FlowGraphIR ir = MakeMenuFlow();
+    FlowGraphRuntime runtime;
+    assert(runtime.Load(ir));
+    assert(!runtime.IsNative());
+    assert(runtime.NativeStatus() == atlas::module::ModuleLoadResult::NotFound);
+    assert(runtime.Execute({0.0f, false, 0}));
+    assert(runtime.GetValue(1) == 1.0f);     // untriggered state is active
+    assert(runtime.GetValue(3) == 0.0f);     // condition 0 < 0.5
+    assert(runtime.GetValue(5) == 0.0f);
+    assert(runtime.GetText(1) == "MainMenu");
+    assert(runtime.GetText(6) == "MainMenu"); // StateNode default
+    assert(runtime.GetText(3).empty());
+
+    FlowGraphIR unknown = ir;
+    unknown.nodes.push_back(MakeNode(7, "Teleport"));
+    FlowGraphRuntime bad;
+    assert(!bad.Load(unknown));
+    std::cout << "[PASS] test_flow_native_interpreter_fallback" << std::endl;
+}
+
+void test_flow_native_source_escapes_name() {
+    FlowGraphIR ir = MakeMenuFlow();
+    ir.name = "Menu\nstatic int injected = (__builtin_trap(), 0); /* */";
+    ir.graphType = "Gameplay\r\n#error injected";
+    std::string source = FlowGraphCodegen::GenerateNative(ir, HashFlowGraphIR(ir), kFlowNativeAbiVersion);
+    assert(!source.empty());
+    assert(source.find("injected =") == std::string::npos);
+    assert(source.find("#error") == std::string::npos);
+    assert(source.find("/* */") == std::string::npos);
+    // Only the two header comment lines precede the first include
+    assert(source.find("#include") == source.find('\n', source.find("// Graph: ")) + 1);
+    std::cout << "[PASS] test_flow_native_source_escapes_name" << std::endl;
+}
+
+void test_flow_native_build_and_load() {
+    FlowGraphIR ir = MakeMenuFlow();
+    std::string dir = TempDir("atlas_flow_native_build");
+    FlowNativeBuildResult build = FlowGraphNativeBuilder::Build(ir, dir);
+    if (!build.success) {
+        std::cout << "[SKIP] test_flow_native_build_and_load (no system compiler: "
+                  << build.log << ")" << std::endl;
+        return;
+    }
+    assert(build.irHash == HashFlowGraphIR(ir));
+    assert(std::filesystem::exists(build.sourcePath));
+
+    FlowGraphRuntime native;
+    assert(native.Load(ir, build.libraryPath));
+    assert(native.IsNative());
+    assert(native.NativeStatus() == atlas::module::ModuleLoadResult::Success);
+    FlowGraphRuntime interpreted;
+    assert(interpreted.Load(ir));
+    AssertSameValues(ir, native, interpreted);
+
+    // A library built from another IR is stale and ignored
+    FlowGraphIR edited = ir;
+    edited.edges.pop_back();
+    FlowGraphRuntime stale;
+    assert(stale.Load(edited, build.libraryPath));
+    assert(!stale.IsNative());
+    assert(stale.NativeStatus() == atlas::module::ModuleLoadResult::HashMismatch);
+    assert(stale.Execute({0.0f, false, 0}));
+    assert(stale.GetValue(5) == 1.0f);       // Gameplay no longer fed by the timer
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_flow_native_build_and_load" << std::endl;
+}
+
+void test_flow_native_build_paths_not_shell_expanded() {
+    std::string root = TempDir("atlas_flow_native_shell");
+    std::string marker = (std::filesystem::path(root) / "expanded").string();
+    std::string dir = (std::filesystem::path(root) / ("out $(touch " + marker + ") `touch " + marker +
+                                                      "` \" '")).string();
+    FlowNativeBuildResult build = FlowGraphNativeBuilder::Build(MakeMenuFlow(), dir);
+    assert(!std::filesystem::exists(marker));
+    if (!build.success) {
+        std::cout << "[SKIP] test_flow_native_build_paths_not_shell_expanded (no system compiler: "
+                  << build.log << ")" << std::endl;
+        std::filesystem::remove_all(root);
+        return;
+    }
+    assert(std::filesystem::path(build.libraryPath).parent_path() == std::filesystem::path(dir));
+    assert(std::filesystem::exists(build.libraryPath));
+
+    // A compiler that cannot be started is a failed build, not a crash
+    FlowNativeBuildOptions missing;
+    missing.compiler = "atlas-no-such-compiler";
+    FlowNativeBuildResult failed = FlowGraphNativeBuilder::Build(MakeMenuFlow(), root, missing);
+    assert(!failed.success);
+    assert(!failed.log.empty());
+
+    std::filesystem::remove_all(root);
+    std::cout << "[PASS] test_flow_native_build_paths_not_shell_expanded" << std::endl;
+}
+
+void test_flow_native_cook() {
+    std::string src = TempDir("atlas_flow_native_src");
+    std::string out = TempDir("atlas_flow_native_cooked");
+    FlowGraphIR ir = MakeMenuFlow();
+    {
+        std::ofstream f(std::filesystem::path(src) / "menu.flowir");
+        f << ir.ToJSON();
+    }
+
+    // Native building is opt-in
+    atlas::production::AssetCooker plain;
+    plain.SetOutputDir(out);
+    plain.SetIncremental(false);
+    assert(!plain.BuildNativeFlowGraphs());
+    assert(plain.CookAll(src).cookedAssets == 1);
+    assert(plain.CookLog().back().nativePath.empty());
+    assert(!std::filesystem::exists(FlowGraphNativeBuilder::LibraryPath(out, "menu")));
+
+    atlas::production::AssetCooker cooker;
+    cooker.SetOutputDir(out);
+    cooker.SetBuildNativeFlowGraphs(true);
+    auto stats = cooker.CookAll(src);
+    assert(stats.totalAssets == 1);
+    assert(stats.cookedAssets == 1);
+    const auto entry = cooker.CookLog().back();
+    assert(std::filesystem::exists(entry.outputPath));
+    if (entry.nativePath.empty()) {
+        std::cout << "[SKIP] test_flow_native_cook (no system compiler)" << std::endl;
+        return;
+    }
+    assert(entry.nativePath == FlowGraphNativeBuilder::LibraryPath(out, "menu"));
+
+    // Re-cooking an unchanged graph keeps the existing library
+    auto stamp = std::filesystem::last_write_time(entry.nativePath);
+    assert(cooker.CookFlowGraph("menu", (std::filesystem::path(src) / "menu.flowir").string()) ==
+           atlas::production::CookResult::Success);
+    assert(cooker.CookLog().back().nativePath == entry.nativePath);
+    assert(std::filesystem::last_write_time(entry.nativePath) == stamp);
+    assert(FlowGraphNativeBuilder::IsUpToDate(entry.nativePath, HashFlowGraphIR(ir)));
+
+    // A library whose sidecar records another IR is rebuilt
+    {
+        std::ofstream sidecar(FlowGraphNativeBuilder::HashPath(entry.nativePath), std::ios::trunc);
+        sidecar << kFlowNativeAbiVersion << " 1\n";
+    }
+    assert(!FlowGraphNativeBuilder::IsUpToDate(entry.nativePath, HashFlowGraphIR(ir)));
+    assert(cooker.CookFlowGraph("menu", (std::filesystem::path(src) / "menu.flowir").string()) ==
+           atlas::production::CookResult::Success);
+    assert(FlowGraphNativeBuilder::IsUpToDate(entry.nativePath, HashFlowGraphIR(ir)));
+
+    {
+        FlowGraphRuntime runtime;
+        assert(runtime.Load(ir, cooker.CookLog().back().nativePath));
+        assert(runtime.IsNative());
+    }
+
+    // A graph whose name sanitizes to the same string gets its own library
+    FlowGraphIR other = MakeMenuFlow();
+    other.name = "Menu_Flow";
+    other.edges.pop_back();
+    std::string otherPath = (std::filesystem::path(src) / "menu_b.flowir").string();
+    {
+        std::ofstream f(otherPath);
+        f << other.ToJSON();
+    }
+    ir.name = "Menu Flow";
+    {
+        std::ofstream f(std::filesystem::path(src) / "menu.flowir");
+        f << ir.ToJSON();
+    }
+    assert(cooker.CookFlowGraph("menu", (std::filesystem::path(src) / "menu.flowir").string()) ==
+           atlas::production::CookResult::Success);
+    assert(cooker.CookFlowGraph("menu_b", otherPath) == atlas::production::CookResult::Success);
+    std::string otherLibrary = cooker.CookLog().back().nativePath;
+    assert(otherLibrary == FlowGraphNativeBuilder::LibraryPath(out, "menu_b"));
+    assert(otherLibrary != entry.nativePath);
+    FlowGraphRuntime first;
+    assert(first.Load(ir, entry.nativePath));
+    assert(first.IsNative());
+    FlowGraphRuntime second;
+    assert(second.Load(other, otherLibrary));
+    assert(second.IsNative());
+
+    std::filesystem::remove_all(src);
+    std::filesystem::remove_all(out);
+    std::cout << "[PASS] test_flow_native_cook" << std::endl;
+}
+
+void test_flow_native_parallel_cook_colliding_names() {
+    std::string src = TempDir("atlas_flow_native_par_src");
+    std::string out = TempDir("atlas_flow_native_par_out");
+    // Both names sanitize to Main_Menu; each graph differs in its edges
+    FlowGraphIR a = MakeMenuFlow();
+    a.name = "Main Menu";
+    FlowGraphIR b = MakeMenuFlow();
+    b.name = "Main_Menu";
+    b.edges.pop_back();
+    {
+        std::ofstream f(std::filesystem::path(src) / "main_menu_a.flowir");
+        f << a.ToJSON();
+    }
+    {
+        std::ofstream f(std::filesystem::path(src) / "main_menu_b.flowir");
+        f << b.ToJSON();
+    }
+
+    atlas::production::AssetCooker cooker;
+    cooker.SetOutputDir(out);
+    cooker.SetBuildNativeFlowGraphs(true);
+    cooker.SetParallel(true);
+    auto stats = cooker.CookAll(src);
+    assert(stats.cookedAssets == 2 && stats.failedAssets == 0);
+
+    std::string libA, libB;
+    for (const auto& entry : cooker.CookLog()) {
+        if (entry.sourceId == "main_menu_a") libA = entry.nativePath;
+        if (entry.sourceId == "main_menu_b") libB = entry.nativePath;
+    }
+    if (libA.empty() || libB.empty()) {
+        std::cout << "[SKIP] test_flow_native_parallel_cook_colliding_names (no system compiler)"
+                  << std::endl;
+        std::filesystem::remove_all(src);
+        std::filesystem::remove_all(out);
+        return;
+    }
+    assert(libA != libB);
+    assert(FlowGraphNativeBuilder::IsUpToDate(libA, HashFlowGraphIR(a)));
+    assert(FlowGraphNativeBuilder::IsUpToDate(libB, HashFlowGraphIR(b)));
+
+    FlowGraphRuntime runtimeA;
+    assert(runtimeA.Load(a, libA));
+    assert(runtimeA.IsNative());
+    FlowGraphRuntime runtimeB;
+    assert(runtimeB.Load(b, libB));
+    assert(runtimeB.IsNative());
+    FlowGraphRuntime interpretedA;
+    assert(interpretedA.Load(a));
+    AssertSameValues(a, runtimeA, interpretedA);
+
+    std::filesystem::remove_all(src);
+    std::filesystem::remove_all(out);
+    std::cout << "[PASS] test_flow_native_parallel_cook_colliding_names" << std::endl;
+}
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <algorithm>
 #include <set>
 
 using namespace atlas::world;
@@ -109,3 +110,131 @@ void test_galaxy_star_classes() {
 
     std::cout << "[PASS] test_galaxy_star_classes" << std::endl;
 }
+
+void test_galaxy_region_matches_full() {
+    GalaxyParams params;
+    params.systemCount = 5000;
+    params.seed = 7;
+    params.galaxyRadius = 1000.0f;
+
+    auto all = GalaxyGenerator::Generate(params);
+    assert(all.size() == 5000);
+    for (size_t i = 0; i < all.size(); ++i) {
+        assert(all[i].id == i);
+        assert(std::sqrt(all[i].x * all[i].x + all[i].z * all[i].z) <= 1000.0 + 1e-6);
+    }
+
+    // Distance follows the centre-biased profile: half the systems within R/4
+    size_t inner = 0;
+    for (const auto& sys : all) {
+        if (std::sqrt(sys.x * sys.x + sys.z * sys.z) < 250.0) inner++;
+    }
+    assert(inner > 2000 && inner < 3000);
+
+    GalaxyGenerator generator(params);
+    const double regions[][4] = {
+        {-100.0, -100.0, 100.0, 100.0},
+        {-900.0, 200.0, -300.0, 950.0},
+        {333.3, -777.7, 334.0, -10.0},
+        {-5000.0, -5000.0, 5000.0, 5000.0},
+    };
+    for (const auto& r : regions) {
+        std::vector<StarSystem> expected;
+        for (const auto& sys : all) {
+            if (sys.x >= r[0] && sys.x <= r[2] && sys.z >= r[1] && sys.z <= r[3]) expected.push_back(sys);
+        }
+        auto region = generator.Region(r[0], r[1], r[2], r[3]);
+        assert(region.size() == expected.size());
+        for (size_t i = 0; i < region.size(); ++i) {
+            assert(region[i].id == expected[i].id);
+            assert(region[i].x == expected[i].x && region[i].y == expected[i].y && region[i].z == expected[i].z);
+            assert(region[i].starClass == expected[i].starClass);
+        }
+
+        auto capped = GalaxyGenerator::GenerateInRegion(params, r[0], r[1], r[2], r[3], 10);
+        assert(capped.size() == std::min<size_t>(10, expected.size()));
+        for (size_t i = 0; i < capped.size(); ++i) assert(capped[i].id == expected[i].id);
+    }
+
+    std::cout << "[PASS] test_galaxy_region_matches_full" << std::endl;
+}
+
+void test_galaxy_lazy_cells() {
+    GalaxyParams params;
+    params.systemCount = 200000;
+    params.seed = 42;
+
+    GalaxyGenerator generator(params, 64);
+    assert(generator.CellLevels() == 7);
+    assert(generator.CellsGenerated() == 0);
+
+    // Counts are known without generating any cell
+    uint64_t total = 0;
+    for (uint32_t cz = 0; cz < generator.CellsPerSide(); ++cz) {
+        for (uint32_t cx = 0; cx < generator.CellsPerSide(); ++cx) {
+            total += generator.CellSystemCount(cx, cz);
+        }
+    }
+    assert(total == 200000);
+    assert(generator.CellsGenerated() == 0);
+
+    // A small region touches only the cells it overlaps
+    double cell = generator.CellSize();
+    auto region = generator.Region(-3000.0, 1000.0, -3000.0 + cell, 1000.0 + cell);
+    assert(!region.empty());
+    uint64_t generated = generator.CellsGenerated();
+    assert(generated >= 1 && generated <= 4);
+
+    // Repeated queries are served from the cache
+    auto again = generator.Region(-3000.0, 1000.0, -3000.0 + cell, 1000.0 + cell);
+    assert(again.size() == region.size());
+    assert(generator.CellsGenerated() == generated);
+
+    // Least recently used cells are evicted
+    generator.SetCacheCapacity(2);
+    assert(generator.CachedCellCount() <= 2);
+    generator.Region(0.0, 0.0, 4.0 * cell, 4.0 * cell);
+    assert(generator.CachedCellCount() == 2);
+    uint32_t mid = generator.CellsPerSide() / 2;
+    generator.Cell(mid, mid);
+    generator.Cell(mid + 1, mid);
+    uint64_t before = generator.CellsGenerated();
+    generator.Cell(mid, mid);
+    assert(generator.CellsGenerated() == before);
+    generator.Cell(mid, mid + 1);       // evicts (mid + 1, mid)
+    generator.Cell(mid, mid);
+    assert(generator.CellsGenerated() == before + 1);
+    generator.Cell(mid + 1, mid);
+    assert(generator.CellsGenerated() == before + 2);
+
+    std::cout << "[PASS] test_galaxy_lazy_cells" << std::endl;
+}
+
+void test_galaxy_nearest() {
+    GalaxyParams params;
+    params.systemCount = 3000;
+    params.seed = 99;
+    params.galaxyRadius = 2000.0f;
+
+    auto all = GalaxyGenerator::Generate(params);
+    GalaxyGenerator generator(params);
+    const double points[][3] = {{0.0, 0.0, 0.0}, {850.0, 10.0, -300.0}, {-1990.0, 0.0, 1990.0}, {5000.0, 0.0, 0.0}};
+    for (const auto& p : points) {
+        auto distance = [&](const StarSystem& s) {
+            return (s.x - p[0]) * (s.x - p[0]) + (s.y - p[1]) * (s.y - p[1]) + (s.z - p[2]) * (s.z - p[2]);
+        };
+        auto expected = all;
+        std::sort(expected.begin(), expected.end(), [&](const StarSystem& a, const StarSystem& b) {
+            double da = distance(a), db = distance(b);
+            return da != db ? da < db : a.id < b.id;
+        });
+
+        auto nearest = generator.Nearest(p[0], p[1], p[2], 12);
+        assert(nearest.size() == 12);
+        for (size_t i = 0; i < nearest.size(); ++i) assert(nearest[i].id == expected[i].id);
+    }
+    assert(generator.Nearest(0.0, 0.0, 0.0, 0).empty());
+    assert(generator.Nearest(0.0, 0.0, 0.0, 10000).size() == 3000);
+
+    std::cout << "[PASS] test_galaxy_nearest" << std::endl;
+}
@@ -42,3 +42,26 @@ void test_heightfield_mesh_lod() {
     assert(mesh1.vertices.size() < mesh0.vertices.size());
     std::cout << "[PASS] test_heightfield_mesh_lod" << std::endl;
 }
+
+void test_heightfield_mesh_stitch() {
+    atlas::world::Heightfield hf;
+    hf.size = 9;
+    hf.scale = 1.0f;
+    for (int i = 0; i < 81; ++i) hf.data.push_back(static_cast<float>((i * 37) % 11));
+
+    auto plain = atlas::world::HeightfieldMesher::BuildMesh(hf, 0);
+    auto mesh = atlas::world::HeightfieldMesher::BuildMesh(hf, 0, atlas::world::kStitchPosX);
+    assert(mesh.vertices.size() == plain.vertices.size());
+    assert(mesh.indices == plain.indices);
+
+    // Odd vertices on the +x edge sit halfway between the even ones,
+    // which are exactly the vertices a LOD 1 neighbour has there
+    for (int z = 0; z < 9; ++z) {
+        float y = mesh.vertices[(z * 9 + 8) * 3 + 1];
+        if (z % 2 == 0) assert(y == hf.At(8, z));
+        else assert(y == 0.5f * (hf.At(8, z - 1) + hf.At(8, z + 1)));
+        // The opposite edge is untouched
+        assert(mesh.vertices[(z * 9) * 3 + 1] == hf.At(0, z));
+    }
+    std::cout << "[PASS] test_heightfield_mesh_stitch" << std::endl;
+}
@@ -12,15 +12,18 @@ void test_lod_decimate_mesh() {
     auto decimated = atlas::procedural::DecimateMesh(cube, 0.5f);
     assert(decimated.IsValid());
     assert(decimated.TriangleCount() == 6);
-    assert(decimated.VertexCount() == cube.VertexCount());
+    assert(decimated.VertexCount() < cube.VertexCount());
 
     // keepFactor 1.0 should keep all
     auto full = atlas::procedural::DecimateMesh(cube, 1.0f);
     assert(full.TriangleCount() == 12);
 
-    // keepFactor 0.25 should keep 3 triangles
+    // keepFactor 0.25 asks for 3 triangles; a closed mesh bottoms out at
+    // a tetrahedron, so the collapse stops at 4
     auto quarter = atlas::procedural::DecimateMesh(cube, 0.25f);
-    assert(quarter.TriangleCount() == 3);
+    assert(quarter.IsValid());
+    assert(quarter.TriangleCount() == 4);
+    assert(quarter.VertexCount() == 4);
 
     std::cout << "[PASS] test_lod_decimate_mesh" << std::endl;
 }
@@ -87,10 +90,10 @@ void test_lod_chain_generation() {
     assert(std::fabs(chain.levels[1].reductionFactor - 0.5f) < 0.01f);
     assert(chain.levels[1].mesh.TriangleCount() == 6);
 
-    // Level 2: quarter detail (3 triangles)
+    // Level 2: quarter detail (target 3, tetrahedron floor of 4)
     assert(chain.levels[2].level == 2);
     assert(std::fabs(chain.levels[2].reductionFactor - 0.25f) < 0.01f);
-    assert(chain.levels[2].mesh.TriangleCount() == 3);
+    assert(chain.levels[2].mesh.TriangleCount() == 4);
 
     // Each level should have fewer or equal triangles
     for (size_t i = 1; i < chain.levels.size(); ++i) {
@@ -177,8 +180,8 @@ void test_lod_graph_decimate_pipeline() {
     assert(output->LevelCount() == 2);
     // After decimating cube (12 tris) by 0.5, we get 6 tris as base
     assert(output->levels[0].mesh.TriangleCount() == 6);
-    // Level 1 at half of that = 3
-    assert(output->levels[1].mesh.TriangleCount() == 3);
+    // Level 1 targets 3 but stops at the tetrahedron
+    assert(output->levels[1].mesh.TriangleCount() == 4);
 
     std::cout << "[PASS] test_lod_graph_decimate_pipeline" << std::endl;
 }
@@ -214,3 +217,108 @@ void test_lod_graph_lod_chain_output() {
 
     std::cout << "[PASS] test_lod_graph_lod_chain_output" << std::endl;
 }
+
+// Flat n x n grid in the XZ plane, two triangles per cell
+static atlas::procedural::MeshData MakeGrid(int n) {
+    atlas::procedural::MeshData mesh;
+    for (int z = 0; z <= n; ++z) {
+        for (int x = 0; x <= n; ++x) {
+            mesh.vertices.insert(mesh.vertices.end(), {static_cast<float>(x), 0.0f, static_cast<float>(z)});
+            mesh.normals.insert(mesh.normals.end(), {0.0f, 1.0f, 0.0f});
+        }
+    }
+    for (int z = 0; z < n; ++z) {
+        for (int x = 0; x < n; ++x) {
+            uint32_t a = static_cast<uint32_t>(z * (n + 1) + x);
+            uint32_t b = a + 1;
+            uint32_t c = a + static_cast<uint32_t>(n + 1);
+            uint32_t d = c + 1;
+            mesh.indices.insert(mesh.indices.end(), {a, c, b, b, c, d});
+        }
+    }
+    return mesh;
+}
+
+void test_lod_merge_vertices_spatial_hash() {
+    // Each grid vertex is emitted twice (once per "chunk"), with a jitter
+    // below the threshold on the copy.
+    atlas::procedural::MeshData mesh;
+    const int n = 40;
+    for (int copy = 0; copy < 2; ++copy) {
+        for (int z = 0; z < n; ++z) {
+            for (int x = 0; x < n; ++x) {
+                float j = copy ? 0.004f : 0.0f;
+                mesh.vertices.insert(mesh.vertices.end(), {x * 0.1f + j, 0.0f, z * 0.1f - j});
+                mesh.normals.insert(mesh.normals.end(), {0.0f, 1.0f, 0.0f});
+            }
+        }
+    }
+    uint32_t half = static_cast<uint32_t>(n * n);
+    mesh.indices = {0, half + 1, static_cast<uint32_t>(n)};
+
+    auto merged = atlas::procedural::MergeNearbyVertices(mesh, 0.01f);
+    assert(merged.IsValid());
+    assert(merged.VertexCount() == static_cast<size_t>(n * n));
+    // Copies map onto the originals, which keep their input order
+    assert(merged.TriangleCount() == 1);
+    assert(merged.indices[0] == 0);
+    assert(merged.indices[1] == 1);
+    assert(merged.indices[2] == static_cast<uint32_t>(n));
+    assert(merged.vertices[3] == 0.1f);
+
+    std::cout << "[PASS] test_lod_merge_vertices_spatial_hash" << std::endl;
+}
+
+void test_lod_simplify_flat_grid() {
+    auto grid = MakeGrid(32);
+    assert(grid.TriangleCount() == 2048);
+
+    auto simplified = atlas::procedural::SimplifyMesh(grid, 200);
+    assert(simplified.IsValid());
+    assert(simplified.TriangleCount() <= 200);
+    assert(simplified.TriangleCount() >= 190);
+
+    // A planar surface has zero quadric error: every vertex stays on the
+    // plane and the boundary planes keep the outline intact.
+    float minX = 1e9f, maxX = -1e9f, minZ = 1e9f, maxZ = -1e9f;
+    for (size_t i = 0; i < simplified.vertices.size(); i += 3) {
+        assert(std::fabs(simplified.vertices[i + 1]) < 1e-4f);
+        minX = std::fmin(minX, simplified.vertices[i]);
+        maxX = std::fmax(maxX, simplified.vertices[i]);
+        minZ = std::fmin(minZ, simplified.vertices[i + 2]);
+        maxZ = std::fmax(maxZ, simplified.vertices[i + 2]);
+    }
+    assert(std::fabs(minX) < 1e-3f && std::fabs(maxX - 32.0f) < 1e-3f);
+    assert(std::fabs(minZ) < 1e-3f && std::fabs(maxZ - 32.0f) < 1e-3f);
+
+    // No triangle is flipped relative to the +Y facing input
+    for (size_t i = 0; i < simplified.indices.size(); i += 3) {
+        const float* a = &simplified.vertices[simplified.indices[i] * 3];
+        const float* b = &simplified.vertices[simplified.indices[i + 1] * 3];
+        const float* c = &simplified.vertices[simplified.indices[i + 2] * 3];
+        float ny = (b[2] - a[2]) * (c[0] - a[0]) - (b[0] - a[0]) * (c[2] - a[2]);
+        assert(ny > 0.0f);
+    }
+
+    std::cout << "[PASS] test_lod_simplify_flat_grid" << std::endl;
+}
+
+void test_lod_chain_parallel_deterministic() {
+    auto sphere = atlas::procedural::GenerateSphere(2.0f, 24);
+    auto chain = atlas::procedural::GenerateLODChain(sphere, 5);
+    assert(chain.LevelCount() == 5);
+
+    for (size_t i = 0; i < chain.levels.size(); ++i) {
+        // Levels baked on workers match a serial bake exactly
+        auto serial = atlas::procedural::DecimateMesh(sphere, chain.levels[i].reductionFactor);
+        assert(serial.indices == chain.levels[i].mesh.indices);
+        assert(serial.vertices == chain.levels[i].mesh.vertices);
+        if (i > 0) {
+            size_t target = static_cast<size_t>(sphere.TriangleCount() * chain.levels[i].reductionFactor);
+            assert(chain.levels[i].mesh.TriangleCount() <= target);
+            assert(chain.levels[i].mesh.TriangleCount() < chain.levels[i - 1].mesh.TriangleCount());
+        }
+    }
+
+    std::cout << "[PASS] test_lod_chain_parallel_deterministic" << std::endl;
+}
@@ -1,8 +1,14 @@
 #include "../engine/core/Logger.h"
+#include "../engine/core/CrashHandler.h"
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <cassert>
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace atlas;
 
@@ -48,3 +54,175 @@ void test_logger_writes_to_file() {
 
     std::cout << "[PASS] test_logger_writes_to_file" << std::endl;
 }
+
+namespace {
+
+std::string ReadLog() {
+    std::ifstream f((std::filesystem::path("logs") / "atlas.log").string());
+    return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+}
+
+size_t CountOf(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) count++;
+    return count;
+}
+
+}
+
+void test_logger_async_multithreaded() {
+    std::filesystem::remove_all("logs");
+    Logger::Init();
+    LogAsyncOptions options;
+    options.capacity = 64;   // small ring: producers block on it
+    options.console = false;
+    Logger::EnableAsync(options);
+    assert(Logger::IsAsync());
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([t] {
+            for (int i = 0; i < 500; ++i) {
+                Logger::Info("async-burst t" + std::to_string(t) + " #" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& p : producers) p.join();
+    Logger::Flush();
+
+    std::string content = ReadLog();
+    assert(CountOf(content, "async-burst") == 2000);
+    assert(content.find("async-burst t3 #499\n") != std::string::npos);
+    assert(Logger::DroppedCount() == 0);
+
+    // Each producer's lines stay in order
+    assert(content.find("async-burst t1 #10\n") < content.find("async-burst t1 #11\n"));
+
+    Logger::Shutdown();
+    assert(!Logger::IsAsync());
+    std::filesystem::remove_all("logs");
+    std::cout << "[PASS] test_logger_async_multithreaded" << std::endl;
+}
+
+void test_logger_async_drop_policy() {
+    std::filesystem::remove_all("logs");
+    Logger::Init();
+    LogAsyncOptions options;
+    options.capacity = 16;
+    options.overflow = LogOverflow::Drop;
+    options.console = false;
+    Logger::EnableAsync(options);
+
+    // Hold the writer inside the sink so the ring fills up
+    std::atomic<bool> release{false};
+    std::atomic<int> seen{0};
+    Logger::SetSink([&](const std::string&) {
+        seen++;
+        while (!release.load()) std::this_thread::yield();
+    });
+    Logger::Info("drop-first");
+    while (seen.load() == 0) std::this_thread::yield();
+    for (int i = 0; i < 100; ++i) Logger::Info("drop-fill " + std::to_string(i));
+    assert(Logger::DroppedCount() == 100 - 16);
+
+    release = true;
+    Logger::Flush();
+    Logger::SetSink(nullptr);
+    std::string content = ReadLog();
+    assert(CountOf(content, "drop-fill") == 16);
+    assert(content.find("drop-fill 15\n") != std::string::npos);
+
+    Logger::Shutdown();
+    std::filesystem::remove_all("logs");
+    std::cout << "[PASS] test_logger_async_drop_policy" << std::endl;
+}
+
+void test_logger_async_sink_logs_into_full_ring() {
+    std::filesystem::remove_all("logs");
+    Logger::Init();
+    LogAsyncOptions options;
+    options.capacity = 16;
+    options.overflow = LogOverflow::Block;
+    options.console = false;
+    Logger::EnableAsync(options);
+
+    // Fill the ring while the writer is held in the sink, then let the
+    // sink log: it must not wait on the ring only its own thread drains
+    std::atomic<bool> release{false};
+    std::atomic<int> seen{0};
+    Logger::SetSink([&](const std::string& line) {
+        if (line.find("sink-echo") != std::string::npos) return;
+        seen++;
+        while (!release.load()) std::this_thread::yield();
+        Logger::Info("sink-echo " + std::to_string(seen.load()));
+    });
+    Logger::Info("block-first");
+    while (seen.load() == 0) std::this_thread::yield();
+    for (int i = 0; i < 16; ++i) Logger::Info("block-fill " + std::to_string(i));
+
+    release = true;
+    Logger::Flush();
+    Logger::SetSink(nullptr);
+    std::string content = ReadLog();
+    assert(CountOf(content, "block-fill") == 16);
+    assert(CountOf(content, "sink-echo") == 17);
+    assert(Logger::DroppedCount() == 0);
+
+    Logger::Shutdown();
+    std::filesystem::remove_all("logs");
+    std::cout << "[PASS] test_logger_async_sink_logs_into_full_ring" << std::endl;
+}
+
+void test_logger_level_filter() {
+    std::filesystem::remove_all("logs");
+    Logger::Init();
+    Logger::SetLevel(LogLevel::Warn);
+    assert(!Logger::Enabled(LogLevel::Info) && Logger::Enabled(LogLevel::Error));
+
+    int formatted = 0;
+    auto message = [&formatted](const char* text) {
+        formatted++;
+        return std::string(text);
+    };
+    Logger::Info("filtered-info");
+    ATLAS_LOG_INFO(message("filtered-macro"));
+    ATLAS_LOG_WARN(message("kept-warn"));
+    assert(formatted == 1);   // the filtered message was never built
+    Logger::SetLevel(LogLevel::Info);
+    Logger::Shutdown();
+
+    std::string content = ReadLog();
+    assert(content.find("filtered-") == std::string::npos);
+    assert(content.find("[WARN]") != std::string::npos && content.find("kept-warn") != std::string::npos);
+    std::filesystem::remove_all("logs");
+    std::cout << "[PASS] test_logger_level_filter" << std::endl;
+}
+
+void test_logger_crash_drains_async() {
+    std::filesystem::remove_all("logs");
+    Logger::Init();
+    LogAsyncOptions options;
+    options.console = false;
+    Logger::EnableAsync(options);
+
+    // Slow writer: without the drain these lines would still be queued
+    std::atomic<bool> blocked{true};
+    Logger::SetSink([&](const std::string&) {
+        if (blocked.exchange(false)) std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    });
+    for (int i = 0; i < 50; ++i) Logger::Error("before-crash " + std::to_string(i));
+
+    atlas::core::CrashHandler handler;
+    bool reported = false;
+    handler.SetCrashCallback([&](const atlas::core::CrashReport&) {
+        reported = true;
+        assert(CountOf(ReadLog(), "before-crash") == 50);
+    });
+    handler.ReportCrash("test crash");
+    assert(reported);
+
+    Logger::SetSink(nullptr);
+    Logger::Shutdown();
+    std::filesystem::remove_all("logs");
+    std::cout << "[PASS] test_logger_crash_drains_async" << std::endl;
+}
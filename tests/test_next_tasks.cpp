@@ -112,7 +112,7 @@ void test_replay_save_point_serialization() {
     {
         ReplayRecorder loader;
         assert(loader.LoadReplay(path));
-        assert(loader.Header().version == 3);
+        assert(loader.Header().version == 4);
         auto pts = loader.SavePoints();
         assert(pts.size() == 1);
         assert(pts[0] == 3);
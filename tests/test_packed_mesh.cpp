@@ -0,0 +1,195 @@
+#include "../engine/world/PackedMesh.h"
+#include "../engine/world/HeightfieldMesher.h"
+#include "../engine/world/TerrainMeshGenerator.h"
+#include "../engine/procedural/ProceduralMeshGraph.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+
+using namespace atlas::world;
+
+static Heightfield MakeRollingHeightfield(int size) {
+    Heightfield hf;
+    hf.size = size;
+    hf.scale = 0.5f;
+    hf.data.resize(static_cast<size_t>(size) * size);
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            hf.data[static_cast<size_t>(z) * size + x] =
+                std::sin(x * 0.2f) * std::cos(z * 0.15f) * 4.0f;
+        }
+    }
+    return hf;
+}
+
+static float TriangleAreaSum(const PackedMesh& mesh) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < mesh.IndexCount(); i += 3) {
+        float a[3], b[3], c[3];
+        mesh.DecodePosition(mesh.Index(i), a);
+        mesh.DecodePosition(mesh.Index(i + 1), b);
+        mesh.DecodePosition(mesh.Index(i + 2), c);
+        float ux = b[0] - a[0], uy = b[1] - a[1], uz = b[2] - a[2];
+        float vx = c[0] - a[0], vy = c[1] - a[1], vz = c[2] - a[2];
+        float nx = uy * vz - uz * vy, ny = uz * vx - ux * vz, nz = ux * vy - uy * vx;
+        sum += 0.5f * std::sqrt(nx * nx + ny * ny + nz * nz);
+    }
+    return sum;
+}
+
+void test_packed_mesh_octahedral_roundtrip() {
+    const float dirs[][3] = {
+        {0, 1, 0}, {0, -1, 0}, {1, 0, 0}, {0, 0, -1},
+        {0.577f, 0.577f, 0.577f}, {-0.3f, 0.4f, -0.866f}, {0.8f, -0.6f, 0.0f}
+    };
+    for (auto& d : dirs) {
+        float len = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        float n[3] = {d[0] / len, d[1] / len, d[2] / len};
+        int8_t ox, oy;
+        EncodeOctahedral(n[0], n[1], n[2], ox, oy);
+        float r[3];
+        DecodeOctahedral(ox, oy, r[0], r[1], r[2]);
+        float dot = n[0] * r[0] + n[1] * r[1] + n[2] * r[2];
+        // snorm8 octahedral keeps normals within ~2 degrees
+        assert(dot > 0.999f);
+    }
+    std::cout << "[PASS] test_packed_mesh_octahedral_roundtrip" << std::endl;
+}
+
+void test_packed_mesh_heightfield_chunk() {
+    Heightfield hf = MakeRollingHeightfield(65);
+    MeshData mesh = HeightfieldMesher::BuildMesh(hf, 0);
+    PackedMesh packed = HeightfieldMesher::BuildPackedMesh(hf, 0);
+
+    assert(packed.hasUVs);
+    assert(packed.stride == 12);
+    assert(packed.VertexCount() == mesh.vertices.size() / 3);
+    assert(packed.IndexCount() == mesh.indices.size());
+    assert(packed.Uses16BitIndices());
+
+    size_t unpackedBytes = (mesh.vertices.size() + mesh.normals.size() + mesh.uvs.size()) * sizeof(float) +
+                           mesh.indices.size() * sizeof(uint32_t);
+    assert(packed.MemoryBytes() * 2 < unpackedBytes);
+
+    // Positions decode within one quantization step of the bounds
+    float stepY = (packed.boundsMax[1] - packed.boundsMin[1]) / 65535.0f;
+    for (size_t v = 0; v < packed.VertexCount(); ++v) {
+        float p[3];
+        packed.DecodePosition(v, p);
+        int ix = static_cast<int>(std::lround(p[0] / hf.scale));
+        int iz = static_cast<int>(std::lround(p[2] / hf.scale));
+        assert(std::fabs(p[1] - hf.At(ix, iz)) <= stepY);
+        float uv[2];
+        packed.DecodeUV(v, uv);
+        assert(std::fabs(uv[0] - ix / 64.0f) < 1e-4f);
+    }
+
+    // Reordering keeps the same surface
+    PackedMesh unordered = HeightfieldMesher::Pack(mesh, {false, false, 32});
+    assert(std::fabs(TriangleAreaSum(packed) - TriangleAreaSum(unordered)) < 1e-2f);
+
+    std::cout << "[PASS] test_packed_mesh_heightfield_chunk" << std::endl;
+}
+
+void test_packed_mesh_terrain_chunk() {
+    ChunkCoord chunk = {2, 0, 3, 0};
+    auto heightFn = [](float x, float z) { return std::sin(x * 0.1f) + std::cos(z * 0.1f); };
+    TerrainMesh mesh = TerrainMeshGenerator::Generate(chunk, 32, 64.0f, heightFn);
+    PackedMesh packed = TerrainMeshGenerator::GeneratePacked(chunk, 32, 64.0f, heightFn);
+
+    assert(!packed.hasUVs);
+    assert(packed.stride == 8);
+    assert(packed.VertexCount() == mesh.vertices.size());
+    assert(packed.TriangleCount() == mesh.indices.size() / 3);
+
+    size_t unpackedBytes = mesh.vertices.size() * sizeof(Vertex) + mesh.indices.size() * sizeof(uint32_t);
+    assert(packed.MemoryBytes() * 2 < unpackedBytes);
+
+    // Bounds follow the chunk origin
+    assert(std::fabs(packed.boundsMin[0] - 128.0f) < 1e-4f);
+    assert(std::fabs(packed.boundsMax[2] - 256.0f) < 1e-4f);
+
+    // Decoded normals stay close to the generator's normals
+    PackedMesh inOrder = TerrainMeshGenerator::Pack(mesh, {false, false, 32});
+    for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+        float n[3];
+        inOrder.DecodeNormal(v, n);
+        const Vertex& src = mesh.vertices[v];
+        assert(n[0] * src.nx + n[1] * src.ny + n[2] * src.nz > 0.999f);
+    }
+
+    std::cout << "[PASS] test_packed_mesh_terrain_chunk" << std::endl;
+}
+
+void test_packed_mesh_vertex_cache_order() {
+    Heightfield hf = MakeRollingHeightfield(65);
+    MeshData mesh = HeightfieldMesher::BuildMesh(hf, 0);
+
+    float before = ComputeACMR(mesh.indices.data(), mesh.indices.size(), 16);
+    auto optimized = OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(),
+                                         mesh.vertices.size() / 3, 32);
+    assert(optimized.size() == mesh.indices.size());
+    float after = ComputeACMR(optimized.data(), optimized.size(), 16);
+    // Row-major 64-quad rows miss on almost every vertex
+    assert(before > 0.9f);
+    assert(after < 0.8f);
+    assert(after < before);
+
+    // Every input triangle is still present exactly once
+    std::vector<uint64_t> a, b;
+    auto key = [](const uint32_t* t) {
+        uint64_t x = t[0], y = t[1], z = t[2];
+        if (x > y) std::swap(x, y);
+        if (y > z) std::swap(y, z);
+        if (x > y) std::swap(x, y);
+        return (x << 42) | (y << 21) | z;
+    };
+    for (size_t i = 0; i < mesh.indices.size(); i += 3) a.push_back(key(&mesh.indices[i]));
+    for (size_t i = 0; i < optimized.size(); i += 3) b.push_back(key(&optimized[i]));
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    assert(a == b);
+
+    std::cout << "[PASS] test_packed_mesh_vertex_cache_order" << std::endl;
+}
+
+void test_packed_mesh_32bit_indices() {
+    Heightfield hf;
+    hf.size = 300;
+    hf.data.assign(300 * 300, 1.0f);
+    PackedMesh packed = HeightfieldMesher::BuildPackedMesh(hf, 0);
+    assert(packed.VertexCount() == 90000);
+    assert(!packed.Uses16BitIndices());
+    assert(packed.Index(packed.IndexCount() - 1) < packed.VertexCount());
+
+    // A flat field has zero height extent; every vertex decodes to it
+    float p[3];
+    packed.DecodePosition(12345, p);
+    assert(p[1] == 1.0f);
+
+    std::cout << "[PASS] test_packed_mesh_32bit_indices" << std::endl;
+}
+
+void test_packed_mesh_procedural_output() {
+    atlas::procedural::ProceduralMeshGraph graph;
+    auto prim = graph.AddNode(atlas::procedural::ProceduralNodeType::Primitive);
+    graph.SetNodeProperty(prim, "shape", "sphere");
+    graph.SetNodeProperty(prim, "segments", "16");
+    auto out = graph.AddNode(atlas::procedural::ProceduralNodeType::Output);
+    graph.AddEdge({prim, 0, out, 0});
+
+    assert(graph.GetPackedOutput().VertexCount() == 0);
+    assert(graph.Compile());
+    assert(graph.Execute());
+
+    const auto* mesh = graph.GetOutput();
+    auto packed = graph.GetPackedOutput();
+    assert(packed.VertexCount() == mesh->VertexCount());
+    assert(packed.TriangleCount() == mesh->TriangleCount());
+    assert(packed.Uses16BitIndices());
+    assert(packed.MemoryBytes() * 2 < (mesh->vertices.size() + mesh->normals.size()) * sizeof(float) +
+                                       mesh->indices.size() * sizeof(uint32_t));
+
+    std::cout << "[PASS] test_packed_mesh_procedural_output" << std::endl;
+}
@@ -224,3 +224,148 @@ void test_procedural_texture_non_repeating() {
     assert(mat1.albedo != mat2.albedo);
     std::cout << "[PASS] test_procedural_texture_non_repeating" << std::endl;
 }
+
+static void BuildTiledTestGraph(atlas::procedural::ProceduralMaterialGraph& graph,
+                                const std::string& w, const std::string& h) {
+    using atlas::procedural::MaterialNodeType;
+    auto noise = graph.AddNode(MaterialNodeType::Noise);
+    graph.SetNodeProperty(noise, "width", w);
+    graph.SetNodeProperty(noise, "height", h);
+    graph.SetNodeProperty(noise, "seed", "1234");
+    graph.SetNodeProperty(noise, "scale", "1.5");
+    auto checker = graph.AddNode(MaterialNodeType::Checker);
+    graph.SetNodeProperty(checker, "width", w);
+    graph.SetNodeProperty(checker, "height", h);
+    graph.SetNodeProperty(checker, "tileSize", "7");
+    auto blend = graph.AddNode(MaterialNodeType::Blend);
+    graph.SetNodeProperty(blend, "factor", "0.3");
+    auto normal = graph.AddNode(MaterialNodeType::NormalMap);
+    graph.SetNodeProperty(normal, "strength", "2.0");
+    auto normal2 = graph.AddNode(MaterialNodeType::NormalMap);
+    auto out = graph.AddNode(MaterialNodeType::Output);
+    graph.AddEdge({noise, 0, blend, 0});
+    graph.AddEdge({checker, 0, blend, 1});
+    graph.AddEdge({blend, 0, normal, 0});
+    graph.AddEdge({normal, 0, normal2, 0});
+    graph.AddEdge({normal2, 0, out, 0});
+}
+
+void test_material_noise_stream_jump() {
+    using namespace atlas::procedural;
+    auto full = GenerateNoiseTexture(37, 11, 77, 1.0f);
+    NoiseStreamJumper stream(77, 37);
+
+    std::vector<float> albedo(13 * 5 * 4), normal(13 * 5 * 3), rough(13 * 5), metal(13 * 5);
+    MaterialTile tile;
+    tile.x0 = 20;
+    tile.y0 = 4;
+    tile.width = 13;
+    tile.height = 5;
+    tile.albedo = albedo.data();
+    tile.normal = normal.data();
+    tile.roughness = rough.data();
+    tile.metallic = metal.data();
+    FillNoiseTile(tile, stream, 37, 1.0f);
+
+    for (uint32_t y = 4; y < 9; ++y)
+        for (uint32_t x = 20; x < 33; ++x)
+            assert(rough[tile.Index(x, y)] == full.roughness[y * 37 + x]);
+    std::cout << "[PASS] test_material_noise_stream_jump" << std::endl;
+}
+
+void test_material_graph_tiled_matches_full() {
+    using namespace atlas::procedural;
+    // Sizes that are not tile multiples exercise partial edge tiles
+    ProceduralMaterialGraph graph;
+    BuildTiledTestGraph(graph, "150", "97");
+    assert(graph.Compile());
+    assert(graph.Execute());
+    MaterialData full = *graph.GetOutput();
+    assert(full.IsValid());
+
+    for (bool parallel : {false, true}) {
+        for (uint32_t ts : {64u, 16u, 5u}) {
+            TiledEvalOptions options;
+            options.tileSize = ts;
+            options.parallel = parallel;
+            assert(graph.ExecuteTiled(options));
+            const MaterialData* tiled = graph.GetOutput();
+            assert(tiled != nullptr);
+            assert(tiled->width == 150 && tiled->height == 97);
+            assert(tiled->albedo == full.albedo);
+            assert(tiled->normal == full.normal);
+            assert(tiled->roughness == full.roughness);
+            assert(tiled->metallic == full.metallic);
+            assert(graph.GetEncodedOutput() == nullptr);
+        }
+    }
+    std::cout << "[PASS] test_material_graph_tiled_matches_full" << std::endl;
+}
+
+void test_material_graph_tiled_encoded() {
+    using namespace atlas::procedural;
+    ProceduralMaterialGraph graph;
+    BuildTiledTestGraph(graph, "80", "70");
+    assert(graph.Compile());
+    assert(graph.Execute());
+    MaterialData full = *graph.GetOutput();
+
+    TiledEvalOptions options;
+    options.format = MaterialPixelFormat::Float16;
+    assert(graph.ExecuteTiled(options));
+    const EncodedMaterialData* half = graph.GetEncodedOutput();
+    assert(half != nullptr);
+    assert(half->PixelCount() == full.PixelCount());
+    assert(half->MemoryBytes() == full.PixelCount() * 9 * 2);
+    for (size_t i = 0; i < full.PixelCount() * 3; ++i)
+        assert(std::fabs(half->Normal(i) - full.normal[i]) <= 1e-3f);
+    for (size_t i = 0; i < full.PixelCount(); ++i)
+        assert(std::fabs(half->Roughness(i) - full.roughness[i]) <= 5e-4f);
+
+    options.format = MaterialPixelFormat::UNorm8;
+    assert(graph.ExecuteTiled(options));
+    const EncodedMaterialData* bytes = graph.GetEncodedOutput();
+    assert(bytes->MemoryBytes() == full.PixelCount() * 9);
+    for (size_t i = 0; i < full.PixelCount() * 4; ++i)
+        assert(std::fabs(bytes->Albedo(i) - full.albedo[i]) <= 0.5f / 255.0f + 1e-6f);
+    for (size_t i = 0; i < full.PixelCount() * 3; ++i)
+        assert(std::fabs(bytes->Normal(i) - full.normal[i]) <= 1.0f / 255.0f + 1e-6f);
+
+    assert(HalfToFloat(FloatToHalf(1.0f)) == 1.0f);
+    assert(HalfToFloat(FloatToHalf(-0.5f)) == -0.5f);
+    assert(HalfToFloat(FloatToHalf(65504.0f)) == 65504.0f);
+    assert(std::isinf(HalfToFloat(FloatToHalf(1e6f))));
+    assert(HalfToFloat(FloatToHalf(1e-6f)) > 0.0f);
+    std::cout << "[PASS] test_material_graph_tiled_encoded" << std::endl;
+}
+
+void test_material_graph_tiled_fallback() {
+    using namespace atlas::procedural;
+    // Mismatched blend inputs produce an empty material either way
+    ProceduralMaterialGraph graph;
+    auto a = graph.AddNode(MaterialNodeType::SolidColor);
+    graph.SetNodeProperty(a, "width", "8");
+    auto b = graph.AddNode(MaterialNodeType::SolidColor);
+    graph.SetNodeProperty(b, "width", "16");
+    auto blend = graph.AddNode(MaterialNodeType::Blend);
+    auto out = graph.AddNode(MaterialNodeType::Output);
+    graph.AddEdge({a, 0, blend, 0});
+    graph.AddEdge({b, 0, blend, 1});
+    graph.AddEdge({blend, 0, out, 0});
+
+    assert(!graph.ExecuteTiled());
+    assert(graph.Compile());
+    assert(graph.ExecuteTiled());
+    assert(graph.GetOutput() != nullptr);
+    assert(!graph.GetOutput()->IsValid());
+
+    // Fixing the size makes the tiled path produce the blend
+    graph.SetNodeProperty(b, "width", "8");
+    assert(graph.Compile());
+    TiledEvalOptions options;
+    options.tileSize = 3;
+    assert(graph.ExecuteTiled(options));
+    assert(graph.GetOutput()->IsValid());
+    assert(graph.GetOutput()->width == 8);
+    std::cout << "[PASS] test_material_graph_tiled_fallback" << std::endl;
+}
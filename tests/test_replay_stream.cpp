@@ -0,0 +1,248 @@
+#include "../engine/sim/ReplayRecorder.h"
+#include "../editor/panels/ReplayTimelinePanel.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace atlas::sim;
+
+namespace {
+
+std::vector<uint8_t> InputFor(uint32_t tick) {
+    // Repetitive enough to compress
+    return {static_cast<uint8_t>(tick & 0xFF), 1, 0, 0, 0, 0, 0, 0};
+}
+
+void RecordTicks(ReplayRecorder& recorder, uint32_t first, uint32_t last) {
+    for (uint32_t t = first; t <= last; ++t) {
+        recorder.RecordFrame(t, InputFor(t), 0x1000 + t);
+    }
+}
+
+}
+
+void test_replay_stream_round_trip() {
+    std::string path = "test_replay_stream.rply";
+    {
+        ReplayRecorder recorder;
+        assert(recorder.StartRecordingToFile(path, 30, 7, 16));
+        assert(recorder.FilePath() == path);
+        RecordTicks(recorder, 0, 99);
+        // Only the block being filled is held in memory
+        assert(recorder.Frames().size() < 16);
+        assert(recorder.FrameCount() == 100);
+        recorder.StopRecording();
+
+        assert(recorder.State() == ReplayState::Idle);
+        assert(recorder.FrameCount() == 100);
+        assert(recorder.DurationTicks() == 99);
+        assert(recorder.FrameAtTick(42)->stateHash == 0x1000 + 42);
+    }
+
+    ReplayRecorder loader;
+    assert(loader.LoadReplay(path));
+    assert(loader.State() == ReplayState::Playing);
+    assert(loader.Header().version == REPLAY_FORMAT_VERSION);
+    assert(loader.Header().seed == 7);
+    assert(loader.FrameCount() == 100);
+    assert(loader.BlockTicks() == 16);
+
+    uint32_t expected = 0;
+    loader.ForEachFrame(0, [&](const ReplayFrame& frame) {
+        assert(frame.tick == expected);
+        assert(frame.inputData == InputFor(expected));
+        assert(frame.stateHash == 0x1000 + expected);
+        ++expected;
+    });
+    assert(expected == 100);
+    assert(loader.Frames().size() == 100);
+
+    std::remove(path.c_str());
+    std::cout << "[PASS] test_replay_stream_round_trip" << std::endl;
+}
+
+void test_replay_stream_random_access() {
+    std::string path = "test_replay_stream_seek.rply";
+    ReplayRecorder recorder;
+    recorder.StartRecording(30);
+    RecordTicks(recorder, 10, 500);
+    // A gap of several empty windows
+    RecordTicks(recorder, 900, 950);
+    recorder.StopRecording();
+    assert(recorder.SaveReplay(path));
+
+    ReplayRecorder loader;
+    assert(loader.LoadReplay(path));
+    assert(loader.FrameAtTick(9) == nullptr);
+    assert(loader.FrameAtTick(10)->stateHash == 0x1000 + 10);
+    assert(loader.FrameAtTick(500)->stateHash == 0x1000 + 500);
+    assert(loader.FrameAtTick(700) == nullptr);
+    assert(loader.FrameAtTick(901)->inputData == InputFor(901));
+    assert(loader.FrameAtTick(255)->stateHash == 0x1000 + 255);
+    assert(loader.FrameAtTick(951) == nullptr);
+    assert(loader.DurationTicks() == 950);
+
+    size_t visited = 0;
+    loader.ForEachFrame(600, [&](const ReplayFrame& frame) {
+        assert(frame.tick >= 900);
+        ++visited;
+    });
+    assert(visited == 51);
+
+    std::remove(path.c_str());
+    std::cout << "[PASS] test_replay_stream_random_access" << std::endl;
+}
+
+void test_replay_stream_save_points() {
+    std::string path = "test_replay_stream_sp.rply";
+    {
+        ReplayRecorder recorder;
+        assert(recorder.StartRecordingToFile(path, 30, 0, 8));
+        RecordTicks(recorder, 0, 40);
+        recorder.MarkSavePoint(3);     // already written
+        recorder.MarkSavePoint(40);    // still pending
+        recorder.MarkSavePoint(99);    // never recorded
+        recorder.StopRecording();
+        assert(recorder.SavePoints() == (std::vector<uint32_t>{3, 40}));
+    }
+
+    ReplayRecorder loader;
+    assert(loader.LoadReplay(path));
+    assert(loader.SavePoints() == (std::vector<uint32_t>{3, 40}));
+    assert(loader.FrameAtTick(3)->isSavePoint);
+    assert(!loader.FrameAtTick(4)->isSavePoint);
+    loader.MarkSavePoint(20);
+    assert(loader.FrameAtTick(20)->isSavePoint);
+
+    // Marks made while playing are kept when saved back over the file
+    assert(loader.SaveReplay(path));
+    ReplayRecorder reloaded;
+    assert(reloaded.LoadReplay(path));
+    assert(reloaded.SavePoints() == (std::vector<uint32_t>{3, 20, 40}));
+
+    std::remove(path.c_str());
+    std::cout << "[PASS] test_replay_stream_save_points" << std::endl;
+}
+
+void test_replay_stream_recovers_unfinished_file() {
+    std::string path = "test_replay_stream_cut.rply";
+    {
+        ReplayRecorder recorder;
+        assert(recorder.StartRecordingToFile(path, 30, 0, 10));
+        RecordTicks(recorder, 0, 59);
+        recorder.StopRecording();
+    }
+
+    // Drop the index and part of the last block, as a crash would
+    ReplayFooter footer;
+    {
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(-static_cast<std::streamoff>(sizeof(footer)), std::ios::end);
+        in.read(reinterpret_cast<char*>(&footer), sizeof(footer));
+    }
+    assert(footer.blockCount == 6);
+    std::filesystem::resize_file(path, footer.indexOffset - 8);
+
+    ReplayRecorder loader;
+    assert(loader.LoadReplay(path));
+    assert(loader.FrameCount() == 50);
+    assert(loader.DurationTicks() == 49);
+    assert(loader.FrameAtTick(49)->stateHash == 0x1000 + 49);
+    assert(loader.FrameAtTick(55) == nullptr);
+    assert(loader.SavePoints().empty());
+
+    std::remove(path.c_str());
+    std::cout << "[PASS] test_replay_stream_recovers_unfinished_file" << std::endl;
+}
+
+void test_replay_stream_rejects_corrupt_block() {
+    std::string path = "test_replay_stream_bad.rply";
+    ReplayRecorder recorder;
+    recorder.StartRecording(30);
+    RecordTicks(recorder, 0, 20);
+    recorder.StopRecording();
+    assert(recorder.SaveReplay(path));
+
+    {
+        // Flip a byte of the first block's data
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(sizeof(ReplayHeader) + sizeof(ReplayStreamInfo) + sizeof(ReplayBlockHeader) + 4);
+        char c = 0;
+        f.read(&c, 1);
+        f.seekp(-1, std::ios::cur);
+        c = static_cast<char>(c ^ 0x5A);
+        f.write(&c, 1);
+    }
+
+    ReplayRecorder loader;
+    assert(loader.LoadReplay(path));
+    assert(loader.FrameAtTick(5) == nullptr);
+
+    std::remove(path.c_str());
+    std::cout << "[PASS] test_replay_stream_rejects_corrupt_block" << std::endl;
+}
+
+void test_replay_stream_loads_v3() {
+    std::string path = "test_replay_stream_v3.rply";
+    ReplayRecorder recorder;
+    recorder.StartRecording(60, 3);
+    RecordTicks(recorder, 1, 30);
+    recorder.MarkSavePoint(12);
+    recorder.StopRecording();
+    assert(recorder.SaveReplay(path, 3));
+    assert(!recorder.SaveReplay(path, 2));
+
+    auto v3Size = std::filesystem::file_size(path);
+    ReplayRecorder loader;
+    assert(loader.LoadReplay(path));
+    assert(loader.Header().version == 3);
+    assert(loader.FilePath().empty());
+    assert(loader.FrameCount() == 30);
+    assert(loader.SavePoints() == (std::vector<uint32_t>{12}));
+
+    // Converting to v4 keeps every frame and compresses them
+    assert(loader.SaveReplay(path));
+    assert(std::filesystem::file_size(path) < v3Size);
+    ReplayRecorder converted;
+    assert(converted.LoadReplay(path));
+    assert(converted.Header().version == REPLAY_FORMAT_VERSION);
+    assert(converted.FrameCount() == 30);
+    assert(converted.FrameAtTick(12)->isSavePoint);
+    assert(converted.FrameAtTick(30)->inputData == InputFor(30));
+
+    std::remove(path.c_str());
+    std::cout << "[PASS] test_replay_stream_loads_v3" << std::endl;
+}
+
+void test_replay_timeline_seeks_file() {
+    std::string path = "test_replay_stream_panel.rply";
+    ReplayRecorder recorder;
+    assert(recorder.StartRecordingToFile(path, 30, 0, 32));
+    RecordTicks(recorder, 0, 299);
+    recorder.StopRecording();
+
+    atlas::editor::ReplayTimelinePanel panel;
+    panel.LoadReplay(recorder);
+    assert(panel.TickRate() == 30);
+    assert(panel.TotalTicks() == 300);
+
+    panel.SetCurrentTick(250);
+    assert(panel.CurrentFrame()->stateHash == 0x1000 + 250);
+    panel.SetCurrentTick(5);
+    assert(panel.CurrentFrame()->stateHash == 0x1000 + 5);
+    panel.SetCurrentTick(1000);
+    assert(panel.GetCurrentTick() == 299);
+    assert(panel.GetInputFrameAt(100).stateHash == 0x1000 + 100);
+    assert(panel.GetInputFrames(280, 284).size() == 5);
+
+    // Injection edits a private copy, not the file
+    panel.InjectInput(10, {9, 9});
+    assert(panel.CurrentFrame()->tick == 299);
+    assert(panel.GetInputFrameAt(10).dataSize == 2);
+    assert(recorder.FrameAtTick(10)->inputData == InputFor(10));
+
+    std::remove(path.c_str());
+    std::cout << "[PASS] test_replay_timeline_seeks_file" << std::endl;
+}
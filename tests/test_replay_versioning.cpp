@@ -6,7 +6,7 @@ using namespace atlas::sim;
 
 void test_replay_version_defaults() {
     ReplayVersionRegistry reg;
-    assert(reg.CurrentVersion() == 3);
+    assert(reg.CurrentVersion() == 4);
     assert(reg.MinimumVersion() == 1);
     assert(reg.VersionCount() == 0);
     assert(reg.MigrationCount() == 0);
@@ -108,17 +108,22 @@ void test_replay_version_migration_path() {
     reg.RegisterDefaults();
 
     auto path = reg.MigrationPath(1);
-    assert(path.size() == 2);  // v1→v2, v2→v3
+    assert(path.size() == 3);  // v1→v2, v2→v3, v3→v4
     assert(path[0].fromVersion == 1);
     assert(path[0].toVersion == 2);
     assert(path[1].fromVersion == 2);
     assert(path[1].toVersion == 3);
+    assert(path[2].fromVersion == 3);
+    assert(path[2].toVersion == 4);
 
     auto path2 = reg.MigrationPath(2);
-    assert(path2.size() == 1);
+    assert(path2.size() == 2);
 
     auto path3 = reg.MigrationPath(3);
-    assert(path3.empty());  // Already at current
+    assert(path3.size() == 1);
+
+    auto path4 = reg.MigrationPath(4);
+    assert(path4.empty());  // Already at current
 
     std::cout << "[PASS] test_replay_version_migration_path" << std::endl;
 }
@@ -130,6 +135,7 @@ void test_replay_version_can_migrate() {
     assert(reg.CanMigrate(1));
     assert(reg.CanMigrate(2));
     assert(reg.CanMigrate(3));
+    assert(reg.CanMigrate(4));
 
     std::cout << "[PASS] test_replay_version_can_migrate" << std::endl;
 }
@@ -149,7 +155,7 @@ void test_replay_version_all_versions() {
     reg.RegisterDefaults();
 
     auto versions = reg.AllVersions();
-    assert(versions.size() == 3);
+    assert(versions.size() == 4);
 
     std::cout << "[PASS] test_replay_version_all_versions" << std::endl;
 }
@@ -158,13 +164,13 @@ void test_replay_version_migration_execution() {
     ReplayVersionRegistry reg;
     reg.RegisterDefaults();
 
-    // Simulate migration: v1 frame data → v3
+    // Simulate migration: v1 frame data → v4
     std::vector<uint8_t> headerData;
     std::vector<std::vector<uint8_t>> frameData;
     frameData.push_back({0x01, 0x02, 0x03});  // One frame of raw data
 
     auto path = reg.MigrationPath(1);
-    assert(path.size() == 2);
+    assert(path.size() == 3);
 
     // Apply migrations
     for (const auto& step : path) {
@@ -174,6 +180,7 @@ void test_replay_version_migration_execution() {
 
     // After v1→v2: each frame gets 8 bytes (hash field)
     // After v2→v3: each frame gets 1 byte (isSavePoint)
+    // v3→v4 leaves frame fields as they are
     assert(frameData[0].size() == 3 + 8 + 1);  // 12 bytes total
 
     std::cout << "[PASS] test_replay_version_migration_execution" << std::endl;
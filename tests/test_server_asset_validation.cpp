@@ -0,0 +1,186 @@
+#include "../engine/assets/ServerAssetValidator.h"
+#include "../engine/assets/AssetHash.h"
+#include "../engine/sim/StateHasher.h"
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+
+using namespace atlas::asset;
+
+namespace {
+
+std::vector<uint8_t> Payload(size_t size, uint32_t seed) {
+    std::vector<uint8_t> out(size);
+    for (auto& b : out) {
+        seed = seed * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(seed >> 24);
+    }
+    return out;
+}
+
+uint64_t WriteAsset(const std::string& path, const std::vector<uint8_t>& payload,
+                    AssetHashAlgorithm algorithm = AssetHashAlgorithm::Fnv1a) {
+    AssetHeader hdr;
+    hdr.size = static_cast<uint32_t>(payload.size());
+    hdr.hash = HashAssetBytes(payload.data(), payload.size(), algorithm);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+    out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    return hdr.hash;
+}
+
+std::string ValidationTmp(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir.string();
+}
+
+}
+
+void test_asset_hash_stream() {
+    auto bytes = [](const char* s) { return reinterpret_cast<const uint8_t*>(s); };
+    assert(HashAssetBytes(nullptr, 0, AssetHashAlgorithm::XXH64) == 0xEF46DB3751D8E999ULL);
+    assert(HashAssetBytes(bytes("a"), 1, AssetHashAlgorithm::XXH64) == 0xD24EC4F1A98C6E5BULL);
+    assert(HashAssetBytes(bytes("abc"), 3, AssetHashAlgorithm::XXH64) == 0x44BC2CF5AD770999ULL);
+
+    // Fnv1a is the value headers and manifests already record
+    auto data = Payload(1000, 3);
+    assert(HashAssetBytes(data.data(), data.size()) ==
+           atlas::sim::StateHasher::HashCombine(0, data.data(), data.size()));
+
+    // Any split of the input hashes the same
+    for (auto algorithm : {AssetHashAlgorithm::Fnv1a, AssetHashAlgorithm::XXH64}) {
+        uint64_t whole = HashAssetBytes(data.data(), data.size(), algorithm);
+        for (size_t step : {1u, 7u, 31u, 32u, 33u, 500u}) {
+            AssetHashStream stream(algorithm);
+            for (size_t i = 0; i < data.size(); i += step) {
+                stream.Update(data.data() + i, std::min(step, data.size() - i));
+            }
+            assert(stream.Finish() == whole);
+        }
+    }
+    std::cout << "[PASS] test_asset_hash_stream" << std::endl;
+}
+
+void test_asset_hash_file_chunked() {
+    std::string dir = ValidationTmp("atlas_hash_file");
+    std::string path = dir + "/big.atlasb";
+    auto payload = Payload(ASSET_HASH_CHUNK_SIZE * 2 + 123, 9);
+    uint64_t expected = WriteAsset(path, payload);
+
+    assert(AssetValidator::ComputeFileHash(path) == expected);
+    uint64_t hash = 0, size = 0;
+    assert(HashAssetFile(path, AssetHashAlgorithm::Fnv1a, hash, &size));
+    assert(hash == expected && size == payload.size());
+
+    // A payload shorter than its header declares is unreadable
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+    assert(!HashAssetFile(path, AssetHashAlgorithm::Fnv1a, hash));
+    assert(AssetValidator::ComputeFileHash(path) == 0);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_asset_hash_file_chunked" << std::endl;
+}
+
+void test_server_validate_all_parallel() {
+    std::string dir = ValidationTmp("atlas_validate_parallel");
+    ServerAssetValidator validator;
+    for (int i = 0; i < 40; ++i) {
+        std::string id = "asset_" + std::to_string(100 + i);
+        auto algorithm = i % 2 ? AssetHashAlgorithm::XXH64 : AssetHashAlgorithm::Fnv1a;
+        uint64_t hash = WriteAsset(dir + "/" + id + ".atlasb", Payload(4096 + i, i), algorithm);
+        validator.RegisterAsset(id, i % 10 == 3 ? hash + 1 : hash, 1, algorithm);
+    }
+    validator.RegisterAsset("asset_missing", 1);
+
+    std::vector<ServerValidationResult> results;
+    assert(validator.ValidateAll(dir, results) == 5);
+    assert(results.size() == 41);
+    for (size_t i = 1; i < results.size(); ++i) {
+        assert(results[i - 1].assetId < results[i].assetId);
+    }
+    assert(results[3].assetId == "asset_103" && !results[3].accepted);
+    assert(results[3].reason.find("Hash mismatch") != std::string::npos);
+    assert(results.back().reason.find("File not found") != std::string::npos);
+
+    const auto& stats = validator.LastStats();
+    assert(stats.validated == 41 && stats.failed == 5 && stats.skipped == 0);
+    assert(stats.bytesHashed > 40u * 4096u);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_server_validate_all_parallel" << std::endl;
+}
+
+void test_server_validate_strict_stops() {
+    std::string dir = ValidationTmp("atlas_validate_strict");
+    ServerAssetValidator validator;
+    for (const char* id : {"a", "b", "c", "d", "e"}) {
+        uint64_t hash = WriteAsset(dir + "/" + id + ".atlasb", Payload(64, id[0]));
+        validator.RegisterAsset(id, std::string(id) == "b" ? 0 : hash);
+    }
+    validator.SetStrict(true);
+    validator.SetParallel(false);
+
+    std::vector<ServerValidationResult> results;
+    assert(validator.ValidateAll(dir, results) == 1);
+    assert(results.size() == 2);
+    assert(results[0].accepted && !results[1].accepted);
+    assert(validator.LastStats().skipped == 3);
+
+    // In parallel, in-flight checks finish but the run still fails
+    validator.SetParallel(true);
+    results.clear();
+    assert(validator.ValidateAll(dir, results) >= 1);
+    assert(validator.LastStats().validated + validator.LastStats().skipped == 5);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_server_validate_strict_stops" << std::endl;
+}
+
+void test_server_validate_hash_cache() {
+    std::string dir = ValidationTmp("atlas_validate_cache");
+    std::string cachePath = dir + "/hash.cache";
+    auto registerAll = [&](ServerAssetValidator& v) {
+        for (int i = 0; i < 6; ++i) {
+            std::string id = "cached_" + std::to_string(i);
+            v.RegisterAsset(id, HashAssetBytes(Payload(2048, i).data(), 2048));
+        }
+    };
+    for (int i = 0; i < 6; ++i) {
+        WriteAsset(dir + "/cached_" + std::to_string(i) + ".atlasb", Payload(2048, i));
+    }
+
+    std::vector<ServerValidationResult> results;
+    {
+        ServerAssetValidator cold;
+        registerAll(cold);
+        cold.SetHashCachePath(cachePath);
+        assert(cold.ValidateAll(dir, results) == 0);
+        assert(cold.LastStats().cacheHits == 0);
+        assert(cold.HashCacheSize() == 6);
+        assert(std::filesystem::exists(cachePath));
+    }
+
+    // Warm restart: nothing is read
+    ServerAssetValidator warm;
+    registerAll(warm);
+    warm.SetHashCachePath(cachePath);
+    assert(warm.HashCacheSize() == 6);
+    results.clear();
+    assert(warm.ValidateAll(dir, results) == 0);
+    assert(warm.LastStats().cacheHits == 6);
+    assert(warm.LastStats().bytesHashed == 0);
+
+    // A rewritten file misses the cache and is checked again
+    WriteAsset(dir + "/cached_2.atlasb", Payload(2049, 77));
+    results.clear();
+    assert(warm.ValidateAll(dir, results) == 1);
+    assert(warm.LastStats().cacheHits == 5);
+    assert(!results[2].accepted);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_server_validate_hash_cache" << std::endl;
+}
@@ -0,0 +1,135 @@
+#include "../engine/net/SoakHarness.h"
+#include "../engine/sim/ReplayRecorder.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+
+using namespace atlas::net;
+
+void test_input_frame_encoding() {
+    InputFrame f{42, 7, 0.5f, -1.0f};
+    auto bytes = EncodeInputFrame(f);
+    assert(bytes.size() == INPUT_FRAME_WIRE_SIZE);
+
+    InputFrame out;
+    assert(DecodeInputFrame(bytes.data(), bytes.size(), out));
+    assert(out.tick == 42 && out.playerID == 7);
+    assert(out.moveX == 0.5f && out.moveY == -1.0f);
+    assert(!DecodeInputFrame(bytes.data(), bytes.size() - 1, out));
+
+    std::cout << "[PASS] test_input_frame_encoding" << std::endl;
+}
+
+void test_net_deliver_between_contexts() {
+    NetContext client;
+    client.Init(NetMode::Client);
+    NetContext server;
+    server.Init(NetMode::Server);
+
+    Packet pkt;
+    pkt.type = INPUT_FRAME_PACKET_TYPE;
+    pkt.payload = EncodeInputFrame(InputFrame{1, 1, 1.0f, 0.0f});
+    client.Send(0, pkt);
+
+    QueuedPacket out;
+    assert(client.PopOutgoing(out));
+    server.Deliver(out.packet);
+    assert(!client.PopOutgoing(out));
+
+    // Nothing loops back to the sender
+    client.Poll();
+    Packet received;
+    assert(!client.Receive(received));
+
+    assert(server.Receive(received));
+    assert(received.type == INPUT_FRAME_PACKET_TYPE);
+    assert(NetContext::ValidateChecksum(received));
+    assert(!server.Receive(received));
+
+    std::cout << "[PASS] test_net_deliver_between_contexts" << std::endl;
+}
+
+void test_soak_harness_run() {
+    SoakConfig cfg;
+    cfg.clients = 8;
+    cfg.ticks = 40;
+    cfg.worldEntities = 32;
+    cfg.maxSnapshots = 10;
+    cfg.tickBudgetMs = 1000.0;
+    SoakReport report = SoakHarness(cfg).Run();
+
+    assert(report.clients == 8 && report.ticks == 40);
+    assert(report.inputsApplied == 8 * 40);
+    assert(report.inputsDropped == 0);
+    assert(report.tickP50Ms <= report.tickP90Ms);
+    assert(report.tickP90Ms <= report.tickP99Ms);
+    assert(report.tickP99Ms <= report.tickMaxMs);
+    assert(!report.MissedBudget());
+    assert(report.ticksOverBudget == 0);
+    assert(report.bytesUpPerClientTick == static_cast<double>(INPUT_FRAME_WIRE_SIZE));
+    // Every player moves every tick, so each client receives at least
+    // the eight player positions per tick
+    assert(report.bytesDownPerClientTick > 8 * 8.0);
+    assert(report.snapshotCount == 10);
+    assert(report.snapshotBytes > 0);
+    assert(report.Summary().find("8 clients, 40 ticks") == 0);
+
+    std::cout << "[PASS] test_soak_harness_run" << std::endl;
+}
+
+void test_soak_harness_replay_script() {
+    atlas::sim::ReplayRecorder recorder;
+    recorder.StartRecording(30);
+    for (uint32_t t = 0; t < 10; ++t) {
+        // Moving on even ticks, idle (no input recorded) on odd ones
+        std::vector<uint8_t> data;
+        if (t % 2 == 0) data = EncodeInputFrame(InputFrame{t, 1, 1.0f, 0.0f});
+        recorder.RecordFrame(t, data);
+    }
+    recorder.StopRecording();
+
+    std::string path = "test_soak_script.rply";
+    assert(recorder.SaveReplay(path));
+
+    SoakConfig cfg;
+    cfg.clients = 3;
+    cfg.ticks = 20;
+    cfg.tickBudgetMs = 1000.0;
+    SoakHarness harness(cfg);
+    assert(!harness.LoadInputScript(std::string("missing_soak_script.rply")));
+    assert(harness.LoadInputScript(path));
+    std::remove(path.c_str());
+    assert(harness.InputScript().size() == 10);
+    assert(harness.InputScript()[0].moveX == 1.0f);
+    assert(harness.InputScript()[1].moveX == 0.0f);
+
+    SoakReport report = harness.Run();
+    assert(report.inputsApplied == 3 * 20);
+    assert(report.inputsDropped == 0);
+    assert(report.bytesDownPerClientTick > 0.0);
+
+    std::cout << "[PASS] test_soak_harness_replay_script" << std::endl;
+}
+
+void test_soak_harness_ramp() {
+    SoakConfig cfg;
+    cfg.ticks = 5;
+
+    cfg.tickBudgetMs = 1000.0;
+    SoakRamp held = SoakHarness::Ramp(cfg, 6);
+    assert(held.firstMissedClients == 0);
+    assert(held.runs.size() == 4);   // 1, 2, 4, 6
+    assert(held.runs[0].clients == 1);
+    assert(held.runs[2].clients == 4);
+    assert(held.runs[3].clients == 6);
+
+    // A budget nothing can meet stops the ramp at the first run
+    cfg.tickBudgetMs = 1e-9;
+    SoakRamp missed = SoakHarness::Ramp(cfg, 64);
+    assert(missed.runs.size() == 1);
+    assert(missed.firstMissedClients == 1);
+    assert(missed.runs[0].MissedBudget());
+    assert(missed.runs[0].ticksOverBudget == 5);
+
+    std::cout << "[PASS] test_soak_harness_ramp" << std::endl;
+}
@@ -114,3 +114,65 @@ void test_soundgraph_deterministic() {
     assert(a == c);
     std::cout << "[PASS] test_soundgraph_deterministic" << std::endl;
 }
+
+void test_soundgraph_block_phase_continuity() {
+    using namespace atlas::sound;
+    // Two 128-sample blocks must equal one 256-sample block
+    SoundGraph streamed;
+    auto osc = streamed.AddNode(std::make_unique<OscillatorNode>());
+    SoundContext half{48000, 128, 0};
+    assert(streamed.Compile(half));
+    std::vector<float> joined;
+    for (int i = 0; i < 2; ++i) {
+        assert(streamed.Execute(half));
+        auto& data = streamed.GetOutput(osc, 0)->data;
+        joined.insert(joined.end(), data.begin(), data.end());
+    }
+
+    SoundGraph whole;
+    auto osc2 = whole.AddNode(std::make_unique<OscillatorNode>());
+    assert(whole.Compile());
+    assert(whole.Execute({48000, 256, 0}));
+    auto& reference = whole.GetOutput(osc2, 0)->data;
+    for (size_t i = 0; i < 256; ++i) {
+        assert(std::fabs(joined[i] - reference[i]) < 1e-5f);
+    }
+
+    // Reset restarts the waveform
+    streamed.Reset();
+    assert(streamed.Execute(half));
+    assert(streamed.GetOutput(osc, 0)->data[1] == joined[1]);
+    std::cout << "[PASS] test_soundgraph_block_phase_continuity" << std::endl;
+}
+
+void test_soundgraph_envelope_gate() {
+    using namespace atlas::sound;
+    SoundGraph graph;
+    auto gateNode = std::make_unique<ParameterNode>(1.0f, SoundPinType::Trigger);
+    ParameterNode* gate = gateNode.get();
+    auto attack = graph.AddNode(std::make_unique<ParameterNode>(0.001f));
+    auto release = graph.AddNode(std::make_unique<ParameterNode>(0.002f));
+    auto gateId = graph.AddNode(std::move(gateNode));
+    auto env = graph.AddNode(std::make_unique<EnvelopeNode>());
+    graph.AddEdge({attack, 0, env, 0});
+    graph.AddEdge({release, 0, env, 3});
+    graph.AddEdge({gateId, 0, env, 4});
+    SoundContext ctx{48000, 64, 0};
+    assert(graph.Compile(ctx));
+
+    // 48-sample attack then 4800-sample decay towards sustain 0.7
+    assert(graph.Execute(ctx));
+    assert(std::fabs(graph.GetOutput(env, 0)->data[47] - 47.0f / 48.0f) < 1e-6f);
+    for (int i = 0; i < 100; ++i) graph.Execute(ctx);
+    assert(std::fabs(graph.GetOutput(env, 0)->data[63] - 0.7f) < 1e-6f);
+
+    // Closing the gate releases to silence over 96 samples
+    gate->Set(0.0f);
+    graph.Execute(ctx);
+    float first = graph.GetOutput(env, 0)->data[0];
+    assert(std::fabs(first - 0.7f) < 1e-6f);
+    graph.Execute(ctx);
+    graph.Execute(ctx);
+    assert(graph.GetOutput(env, 0)->data[63] == 0.0f);
+    std::cout << "[PASS] test_soundgraph_envelope_gate" << std::endl;
+}
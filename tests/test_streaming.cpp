@@ -1,5 +1,11 @@
 #include "../engine/world/WorldStreamer.h"
+#include "../engine/world/ChunkIO.h"
 #include "../engine/world/VoxelGridLayout.h"
+#include "../engine/world/CubeSphereLayout.h"
+#include "../engine/world/CubeSphereLOD.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <cassert>
 #include <filesystem>
@@ -120,3 +126,305 @@ void test_streamer_duplicate_request() {
 
     std::cout << "[PASS] test_streamer_duplicate_request" << std::endl;
 }
+
+namespace {
+
+std::string StreamTmp(const std::string& name) {
+    std::string dir = std::filesystem::temp_directory_path().string() + "/" + name;
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+size_t CountFiles(const std::string& dir) {
+    if (!std::filesystem::exists(dir)) return 0;
+    size_t n = 0;
+    for (const auto& e : std::filesystem::directory_iterator(dir)) n += e.is_regular_file() ? 1 : 0;
+    return n;
+}
+
+std::vector<uint8_t> ChunkBytes(int seed, size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>(seed * 31 + i * 7);
+    return data;
+}
+
+}
+
+void test_chunk_region_store() {
+    std::string dir = StreamTmp("atlas_region_store");
+    ChunkRegionStore store(dir);
+
+    // 16x16 chunks share a region file; negative coords get their own
+    std::vector<ChunkRegionStore::PendingWrite> writes;
+    for (int x = 0; x < 16; ++x) {
+        for (int z = 0; z < 4; ++z) writes.push_back({{x, 0, z, 0}, ChunkBytes(x * 16 + z, 100 + x)});
+    }
+    writes.push_back({{-1, 0, -1, 0}, ChunkBytes(999, 10)});
+    assert(store.WriteBatch(writes) == 0);
+    assert(CountFiles(dir) == 2);
+
+    std::vector<uint8_t> out;
+    assert(store.Read({3, 0, 2, 0}, out) && out == ChunkBytes(3 * 16 + 2, 103));
+    assert(store.Read({-1, 0, -1, 0}, out) && out == ChunkBytes(999, 10));
+    assert(!store.Read({5, 0, 9, 0}, out));
+    assert(!store.Read({5, 1, 0, 0}, out));
+
+    // Rewrites never touch the previous copy, even when they would fit in it
+    std::string region = store.RegionPath({0, 0, 0, 0});
+    auto before = std::filesystem::file_size(region);
+    assert(store.Write({3, 0, 2, 0}, ChunkBytes(1, 50)));
+    assert(std::filesystem::file_size(region) == before + 50);
+    assert(store.Write({4, 0, 2, 0}, ChunkBytes(2, 4000)));
+    assert(store.Read({3, 0, 2, 0}, out) && out == ChunkBytes(1, 50));
+    assert(store.Read({4, 0, 2, 0}, out) && out == ChunkBytes(2, 4000));
+    assert(store.Read({5, 0, 2, 0}, out) && out == ChunkBytes(5 * 16 + 2, 105));
+
+    // Superseded copies are compacted away once they outweigh the live data
+    for (int i = 0; i < 64; ++i) assert(store.Write({4, 0, 2, 0}, ChunkBytes(i, 4000)));
+    assert(std::filesystem::file_size(region) < before + 64 * 1024 + 3 * 4000);
+    assert(!std::filesystem::exists(region + ".tmp"));
+    assert(store.Read({4, 0, 2, 0}, out) && out == ChunkBytes(63, 4000));
+    assert(store.Read({3, 0, 2, 0}, out) && out == ChunkBytes(1, 50));
+    assert(store.Read({15, 0, 3, 0}, out) && out == ChunkBytes(15 * 16 + 3, 115));
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_chunk_region_store" << std::endl;
+}
+
+void test_chunk_io_priority() {
+    std::string dir = StreamTmp("atlas_chunk_io_priority");
+    ChunkIOQueue io(dir);
+    for (int x = 0; x < 10; ++x) io.QueueWrite(x, {x, 0, 0, 0}, ChunkBytes(x, 64));
+    assert(io.Flush());
+    assert(io.CompletedWrites() == 10);
+
+    // Queued while paused, served nearest to the viewer first
+    io.SetPaused(true);
+    for (int x = 0; x < 10; ++x) {
+        io.QueueRead(x, {x, 0, 0, 0}, WorldPos{x * 16.0, 0.0, 0.0});
+    }
+    io.QueueRead(42, {42, 0, 0, 0}, WorldPos{42 * 16.0, 0.0, 0.0});   // never written
+    assert(io.CancelRead(3));
+    io.SetViewer(WorldPos{200.0, 0.0, 0.0});
+    assert(io.PendingReads() == 10);
+    assert(io.TakeCompleted().empty());
+    assert(io.Flush());
+
+    auto done = io.TakeCompleted();
+    std::vector<uint64_t> order;
+    for (const auto& r : done) {
+        order.push_back(r.key);
+        if (r.key != 42) assert(r.ok && r.data == ChunkBytes(static_cast<int>(r.key), 64));
+        else assert(!r.ok);
+    }
+    assert((order == std::vector<uint64_t>{9, 8, 7, 6, 5, 4, 2, 1, 0, 42}));
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_chunk_io_priority" << std::endl;
+}
+
+void test_streamer_async_cache() {
+    std::string dir = StreamTmp("atlas_streamer_async");
+    VoxelGridLayout layout;
+    layout.chunkSize = 16;
+    WorldStreamer streamer(layout, dir);
+    ChunkIOQueue* io = streamer.IOQueue();
+    assert(io);
+
+    io->SetPaused(true);
+    for (int i = 0; i < 40; ++i) streamer.SetChunkData({i % 8, 0, i / 8, 0}, ChunkBytes(i, 4096));
+    for (int i = 0; i < 40; ++i) streamer.UnloadChunk({i % 8, 0, i / 8, 0});
+    assert(streamer.CachedCount() == 40);
+    assert(CountFiles(dir) == 0);   // nothing written on this thread
+
+    for (int i = 0; i < 40; ++i) assert(streamer.RequestLoad({i % 8, 0, i / 8, 0}));
+    assert(streamer.GetChunkState({0, 0, 0, 0}) == ChunkState::Loading);
+    assert(streamer.ApplyCompletedIO() == 0);
+
+    // Loaded only once finished reads are applied
+    assert(io->Flush());
+    assert(CountFiles(dir) == 1);
+    assert(streamer.LoadedCount() == 0);
+    assert(streamer.ApplyCompletedIO() == 40);
+    assert(streamer.LoadedCount() == 40);
+    assert(streamer.CachedCount() == 0);
+
+    // A read abandoned by unloading leaves the chunk cached
+    streamer.UnloadChunk({1, 0, 1, 0});
+    assert(streamer.RequestLoad({1, 0, 1, 0}));
+    streamer.UnloadChunk({1, 0, 1, 0});
+    assert(streamer.GetChunkState({1, 0, 1, 0}) == ChunkState::Cached);
+    io->Flush();
+    streamer.ApplyCompletedIO();
+    assert(streamer.GetChunkState({1, 0, 1, 0}) == ChunkState::Cached);
+    assert(streamer.LoadChunkFromCache({1, 0, 1, 0}));
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_streamer_async_cache" << std::endl;
+}
+
+void test_streamer_frame_time() {
+    std::string dir = StreamTmp("atlas_streamer_frames");
+    VoxelGridLayout layout;
+    layout.chunkSize = 16;
+    WorldStreamer streamer(layout, dir);
+
+    // The disk stays untouched while the worker is held, so any frame
+    // that needed it would never finish
+    streamer.IOQueue()->SetPaused(true);
+    double worstMs = 0.0;
+    for (int frame = 0; frame < 120; ++frame) {
+        WorldPos viewer{frame * 8.0, 0.0, 0.0};
+        auto start = std::chrono::steady_clock::now();
+        streamer.Update(viewer, 0, 64.0f, 96.0f);
+        for (int x = -5; x <= 5; ++x) {
+            for (int z = -5; z <= 5; ++z) {
+                ChunkCoord c{static_cast<int>(viewer.x / 16) + x, 0, z, 0};
+                if (streamer.GetChunkState(c) == ChunkState::Loading) streamer.SetChunkData(c, ChunkBytes(x + z, 8192));
+            }
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        worstMs = std::max(worstMs, ms);
+    }
+    assert(streamer.CachedCount() > 0);
+    assert(CountFiles(dir) == 0);
+    assert(worstMs < 250.0);
+
+    assert(streamer.IOQueue()->Flush());
+    assert(CountFiles(dir) > 0);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "[PASS] test_streamer_frame_time (worst " << worstMs << " ms)" << std::endl;
+}
+
+void test_streamer_incremental_ring() {
+    VoxelGridLayout layout;
+    layout.chunkSize = 16;
+    WorldStreamer streamer(layout);
+
+    streamer.Update({8.0, 8.0, 8.0}, 0, 40.0f, 64.0f);
+    assert(streamer.RingRebuildCount() == 1);
+    size_t ring = streamer.RingSize();
+    assert(ring > 1);
+    assert(streamer.GetChunkState({2, 0, 0, 0}) == ChunkState::Loading);
+    assert(streamer.GetChunkState({3, 0, 0, 0}) == ChunkState::Unloaded);
+
+    // Moving inside the viewer's chunk does not touch the ring
+    streamer.Update({12.0, 8.0, 3.0}, 0, 40.0f, 64.0f);
+    assert(streamer.RingRebuildCount() == 1);
+
+    // Crossing into the next chunk brings in the new edge only
+    streamer.Update({24.0, 8.0, 8.0}, 0, 40.0f, 64.0f);
+    assert(streamer.RingRebuildCount() == 2);
+    assert(streamer.RingSize() == ring);
+    assert(streamer.GetChunkState({3, 0, 0, 0}) == ChunkState::Loading);
+    assert(streamer.GetChunkState({0, 1, 0, 0}) == ChunkState::Unloaded);   // one horizontal layer
+
+    // A radius change rebuilds without moving
+    streamer.Update({24.0, 8.0, 8.0}, 0, 20.0f, 64.0f);
+    assert(streamer.RingRebuildCount() == 3);
+    assert(streamer.RingSize() == 5);
+    std::cout << "[PASS] test_streamer_incremental_ring" << std::endl;
+}
+
+void test_streamer_hysteresis() {
+    VoxelGridLayout layout;
+    layout.chunkSize = 16;
+    WorldStreamer streamer(layout);
+
+    streamer.Update({8.0, 8.0, 8.0}, 0, 40.0f, 56.0f);
+    for (int x = -3; x <= 3; ++x) {
+        for (int z = -3; z <= 3; ++z) {
+            if (streamer.GetChunkState({x, 0, z, 0}) == ChunkState::Loading) {
+                streamer.SetChunkData({x, 0, z, 0}, ChunkBytes(x + z, 16));
+            }
+        }
+    }
+    size_t loaded = streamer.LoadedCount();
+    assert(loaded == streamer.RingSize());
+
+    // 48 units away: outside the load radius, inside the unload radius
+    streamer.Update({40.0, 8.0, 8.0}, 0, 40.0f, 56.0f);
+    assert(streamer.GetChunkState({-1, 0, 0, 0}) == ChunkState::Loaded);
+    // 64 units away: dropped
+    assert(streamer.GetChunkState({-2, 0, 0, 0}) == ChunkState::Unloaded);
+
+    // Stepping back does not reload what stayed
+    streamer.Update({8.0, 8.0, 8.0}, 0, 40.0f, 56.0f);
+    assert(streamer.GetChunkState({-1, 0, 0, 0}) == ChunkState::Loaded);
+    assert(streamer.GetChunkState({-2, 0, 0, 0}) == ChunkState::Loading);
+
+    // Counters agree with the chunk list, which is nearest first
+    auto chunks = streamer.GetLoadedChunks();
+    assert(chunks.size() == streamer.LoadedCount());
+    assert(chunks.front().x == 0 && chunks.front().z == 0);
+    double last = 0.0;
+    for (const auto& c : chunks) {
+        assert(streamer.GetChunkState(c) == ChunkState::Loaded);
+        double d = std::hypot(c.x * 16.0, c.z * 16.0);
+        assert(d >= last);
+        last = d;
+    }
+    std::cout << "[PASS] test_streamer_hysteresis" << std::endl;
+}
+
+void test_streamer_cube_sphere_faces() {
+    CubeSphereLayout layout;
+    layout.radius = 1000.0;
+    WorldStreamer streamer(layout);
+
+    // Viewer on the +Z face right next to its +X edge
+    ChunkCoord edge{7, 4, POS_Z, 3};
+    streamer.Update(layout.ChunkToWorld(edge), 3, 400.0f, 500.0f);
+    assert(streamer.GetChunkState(edge) == ChunkState::Loading);
+
+    bool otherFace = false;
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            if (streamer.GetChunkState({x, y, POS_X, 3}) == ChunkState::Loading) otherFace = true;
+        }
+    }
+    assert(otherFace);
+    assert(streamer.GetChunkState({0, 4, NEG_Z, 3}) == ChunkState::Unloaded);
+    std::cout << "[PASS] test_streamer_cube_sphere_faces" << std::endl;
+}
+
+void test_streamer_lod_selection() {
+    CubeSphereLayout layout;
+    layout.radius = 1000.0;
+    PlanetLODParams params;
+    params.maxNodes = 200;
+    CubeSphereLODSelector selector(layout, params);
+    WorldStreamer streamer(layout);
+
+    // Chunks of several LODs stream together
+    WorldPos viewer{0.0, 0.0, 1002.0};
+    selector.Select(viewer);
+    std::vector<ChunkCoord> wanted = selector.Chunks();
+    streamer.UpdateSelection(viewer, wanted);
+    int minLod = 99, maxLod = -1;
+    for (const auto& c : wanted) {
+        assert(streamer.GetChunkState(c) == ChunkState::Loading);
+        streamer.SetChunkData(c, ChunkBytes(c.lod, 8));
+        minLod = std::min(minLod, c.lod);
+        maxLod = std::max(maxLod, c.lod);
+    }
+    assert(maxLod > minLod);
+    assert(streamer.LoadedCount() == wanted.size());
+    assert(streamer.RingSize() == wanted.size());
+
+    // Flying to the far side swaps the selection; nothing else stays
+    WorldPos other{0.0, 0.0, -1002.0};
+    selector.Select(other);
+    std::vector<ChunkCoord> next = selector.Chunks();
+    streamer.UpdateSelection(other, next);
+    assert(next.size() <= params.maxNodes);
+    assert(streamer.LoadedCount() <= next.size());
+    for (const auto& c : streamer.GetLoadedChunks()) {
+        bool selected = false;
+        for (const auto& n : next) selected |= (n.x == c.x && n.y == c.y && n.z == c.z && n.lod == c.lod);
+        assert(selected);
+    }
+    for (const auto& c : next) assert(streamer.GetChunkState(c) != ChunkState::Unloaded);
+    std::cout << "[PASS] test_streamer_lod_selection" << std::endl;
+}
@@ -1,6 +1,7 @@
 #include "../engine/tile/TileChunkBuilder.h"
 #include <iostream>
 #include <cassert>
+#include <map>
 #include <set>
 
 using namespace atlas::tile;
@@ -183,3 +184,102 @@ void test_chunk_builder_flip_flags() {
     assert(chunk.vertices[3].v == 0.0f);
     std::cout << "[PASS] test_chunk_builder_flip_flags" << std::endl;
 }
+
+void test_tile_chunk_grid_storage() {
+    TileChunkGrid grid;
+    grid[{0, 0}].tileAssetId = 1;
+    grid[{7, 7}].tileAssetId = 2;
+    grid[{-1, -1}].tileAssetId = 3;
+    grid[{-9, 4}].tileAssetId = 4;
+    assert(grid.size() == 4);
+    assert(grid.ChunkCount() == 3);
+    assert(grid.at({-1, -1}).tileAssetId == 3);
+    assert(grid.count({-9, 4}) == 1 && grid.count({-8, 4}) == 0);
+
+    const auto* chunk = grid.FindChunk(-1, -1);
+    assert(chunk && chunk->Count() == 1);
+    assert(chunk->Has(TileChunkGrid::CellIndex({-1, -1})));
+    assert(TileChunkGrid::CellIndex({-1, -1}) == 63);
+
+    // Iteration visits every tile exactly once
+    uint32_t idSum = 0;
+    size_t visited = 0;
+    for (const auto& [coord, tile] : grid) {
+        assert(grid.at(coord).tileAssetId == tile.tileAssetId);
+        idSum += tile.tileAssetId;
+        visited++;
+    }
+    assert(visited == 4 && idSum == 10);
+
+    // Emptied chunks are dropped
+    assert(grid.erase({-1, -1}) == 1);
+    assert(grid.erase({-1, -1}) == 0);
+    assert(grid.FindChunk(-1, -1) == nullptr);
+    assert(grid.ChunkCount() == 2 && grid.size() == 3);
+    std::cout << "[PASS] test_tile_chunk_grid_storage" << std::endl;
+}
+
+void test_chunk_builder_row_major_order() {
+    TileMap map;
+    map.gridCellSize = 16;
+    TileLayer layer;
+    layer.tiles[{1, 0}] = TileInstance{1};
+    layer.tiles[{0, 1}] = TileInstance{2};
+    layer.tiles[{0, 0}] = TileInstance{3};
+
+    TileChunk chunk;
+    TileChunkBuilder::Build(map, layer, {0, 0}, chunk);
+    assert(chunk.VertexCount() == 12);
+    assert(chunk.vertices[0].x == 0.0f && chunk.vertices[0].y == 0.0f);
+    assert(chunk.vertices[4].x == 16.0f && chunk.vertices[4].y == 0.0f);
+    assert(chunk.vertices[8].x == 0.0f && chunk.vertices[8].y == 16.0f);
+    assert(chunk.indices[6] == 4 && chunk.indices[17] == 11);
+
+    // Rebuilding reuses the buffers
+    const TileVertex* buffer = chunk.vertices.data();
+    layer.tiles.erase({0, 1});
+    TileChunkBuilder::Build(map, layer, {0, 0}, chunk);
+    assert(chunk.VertexCount() == 8);
+    assert(chunk.vertices.data() == buffer);
+    std::cout << "[PASS] test_chunk_builder_row_major_order" << std::endl;
+}
+
+void test_chunk_builder_rebuild_dirty() {
+    TileMap map;
+    TileLayer layer;
+    std::set<ChunkCoord> dirty;
+    for (int32_t y = -20; y < 30; ++y) {
+        for (int32_t x = -12; x < 40; x += (y & 3) + 1) {
+            layer.tiles[{x, y}] = TileInstance{static_cast<uint32_t>(x * 100 + y + 5000)};
+            TileChunkBuilder::MarkDirty(dirty, {x, y});
+        }
+    }
+    size_t dirtyCount = dirty.size();
+
+    std::map<ChunkCoord, TileChunk> chunks;
+    TileChunkBuilder::RebuildDirty(map, layer, dirty, chunks);
+    assert(dirty.empty());
+    assert(chunks.size() == dirtyCount);
+    for (const auto& [coord, chunk] : chunks) {
+        TileChunk serial;
+        TileChunkBuilder::Build(map, layer, coord, serial);
+        assert(serial.VertexCount() == chunk.VertexCount());
+        for (size_t i = 0; i < serial.vertices.size(); ++i) {
+            assert(serial.vertices[i].x == chunk.vertices[i].x);
+            assert(serial.vertices[i].y == chunk.vertices[i].y);
+        }
+        assert(serial.indices == chunk.indices);
+    }
+
+    // Erasing a chunk's only tiles removes its mesh
+    for (int32_t y = 0; y < 8; ++y) {
+        for (int32_t x = 0; x < 8; ++x) {
+            layer.tiles.erase({x, y});
+            TileChunkBuilder::MarkDirty(dirty, {x, y});
+        }
+    }
+    TileChunkBuilder::RebuildDirty(map, layer, dirty, chunks);
+    assert(chunks.count(ChunkCoord{0, 0}) == 0);
+    assert(chunks.size() == dirtyCount - 1);
+    std::cout << "[PASS] test_chunk_builder_rebuild_dirty" << std::endl;
+}
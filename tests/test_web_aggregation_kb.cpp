@@ -63,7 +63,11 @@ void test_kb_search() {
     auto result = kb.Search("engine");
     assert(result.totalMatches == 3);
     // Results should be sorted by relevance (highest first)
-    assert(result.entries[0].relevanceScore >= result.entries[1].relevanceScore);
+    assert(result.scores.size() == 3);
+    assert(result.scores[0] >= result.scores[1]);
+    assert(result.scores[1] >= result.scores[2]);
+    // "engines" only matches as a prefix, so it ranks last
+    assert(result.entries[2].title == "Unrelated");
     std::cout << "[PASS] test_kb_search" << std::endl;
 }
 
@@ -158,3 +162,103 @@ void test_kb_clear() {
     assert(kb.EntryCount() == 0);
     std::cout << "[PASS] test_kb_clear" << std::endl;
 }
+
+void test_kb_search_bm25_ranking() {
+    atlas::ai::WebAggregationKB kb;
+    atlas::ai::KBEntry e;
+    e.title = "Physics"; e.content = "rigid body solver rigid body contacts";
+    uint64_t physics = kb.AddEntry(e);
+    e.title = "Rendering"; e.content = "shadow maps and the rigid pipeline";
+    kb.AddEntry(e);
+    e.title = "Rigid bodies"; e.content = "notes";
+    uint64_t titled = kb.AddEntry(e);
+    e.title = "Audio"; e.content = "mixing voices";
+    kb.AddEntry(e);
+
+    // Every query token must match; title hits weigh more
+    auto result = kb.Search("rigid bod");
+    assert(result.totalMatches == 2);
+    assert(result.entries[0].id == titled || result.entries[0].id == physics);
+    assert(result.scores[0] >= result.scores[1]);
+
+    result = kb.Search("RIGID");
+    assert(result.totalMatches == 3);
+    assert(result.entries.back().title == "Rendering");
+
+    // Prefix matching and truncation to maxResults
+    result = kb.Search("sha", 1);
+    assert(result.totalMatches == 1 && result.entries.size() == 1);
+    assert(result.entries[0].title == "Rendering");
+    assert(kb.Search("shadowy").totalMatches == 0);
+    assert(kb.Search("").totalMatches == 4);
+
+    // Tie on score falls back to relevanceScore
+    atlas::ai::WebAggregationKB ties;
+    atlas::ai::KBEntry a; a.title = "same words"; a.relevanceScore = 0.1;
+    atlas::ai::KBEntry b; b.title = "same words"; b.relevanceScore = 0.8;
+    ties.AddEntry(a);
+    ties.AddEntry(b);
+    assert(ties.Search("same").entries[0].relevanceScore == 0.8);
+    std::cout << "[PASS] test_kb_search_bm25_ranking" << std::endl;
+}
+
+void test_kb_index_incremental() {
+    atlas::ai::WebAggregationKB kb;
+    atlas::ai::KBEntry e;
+    e.title = "Terrain streaming"; e.category = "world"; e.tags = {"lod", "io"};
+    uint64_t a = kb.AddEntry(e);
+    e.title = "Terrain shading"; e.category = "render"; e.tags = {"lod"};
+    uint64_t b = kb.AddEntry(e);
+    assert(kb.TermCount() == 3);
+
+    kb.RemoveEntry(a);
+    assert(kb.Search("streaming").totalMatches == 0);
+    assert(kb.Search("terrain").totalMatches == 1);
+    assert(kb.SearchByCategory("world").totalMatches == 0);
+    assert(kb.CategoryCount() == 1);
+    assert(kb.SearchByTag("lod").totalMatches == 1);
+    assert(kb.ListTags().size() == 1);
+    assert(kb.TermCount() == 2);
+
+    kb.RemoveEntry(b);
+    kb.RemoveEntry(b);
+    assert(kb.TermCount() == 0);
+    assert(kb.Search("terrain").totalMatches == 0);
+    std::cout << "[PASS] test_kb_index_incremental" << std::endl;
+}
+
+void test_kb_export_import_index() {
+    atlas::ai::WebAggregationKB kb;
+    atlas::ai::KBEntry e;
+    e.title = "Navmesh baking"; e.content = "tiles and \"quoted\" text"; e.tags = {"ai"};
+    kb.AddEntry(e);
+    e.title = "Removed"; e.tags = {};
+    uint64_t removed = kb.AddEntry(e);
+    e.title = "Navmesh queries"; e.category = "ai";
+    kb.AddEntry(e);
+    kb.RemoveEntry(removed);
+
+    std::string json = kb.ExportJSON();
+    // Empty fields are left out
+    assert(json.find("\"source\"") == std::string::npos);
+    assert(json.find("\"timestamp\"") == std::string::npos);
+
+    atlas::ai::WebAggregationKB copy;
+    assert(copy.ImportJSON(json));
+    assert(copy.EntryCount() == 2);
+    assert(copy.Search("navmesh").totalMatches == 2);
+    assert(copy.Search("quoted").totalMatches == 2);
+    assert(copy.GetEntry(1)->content == "tiles and \"quoted\" text");
+    assert(copy.SearchByTag("ai").totalMatches == 1);
+    assert(copy.SearchByCategory("ai").totalMatches == 1);
+    assert(copy.TermCount() == kb.TermCount());
+
+    // Ids are not reused after a round trip
+    assert(copy.AddEntry(e) == removed + 2);
+
+    // Re-importing replaces entries instead of indexing them twice
+    assert(copy.ImportJSON(json));
+    assert(copy.Search("navmesh").totalMatches == 3);
+    assert(copy.Search("navmesh").entries.size() == 3);
+    std::cout << "[PASS] test_kb_export_import_index" << std::endl;
+}
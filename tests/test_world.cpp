@@ -1,8 +1,11 @@
 #include "../engine/world/CubeSphereLayout.h"
+#include "../engine/world/CubeSphereLOD.h"
 #include "../engine/world/VoxelGridLayout.h"
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <unordered_map>
 
 using namespace atlas::world;
 
@@ -77,3 +80,120 @@ void test_voxel_neighbors() {
     std::cout << "[PASS] test_voxel_neighbors" << std::endl;
 }
 
+
+void test_cube_sphere_face_edge_neighbors() {
+    CubeSphereLayout layout;
+    layout.radius = 1000.0;
+
+    auto same = [](const ChunkCoord& a, const ChunkCoord& b) {
+        return a.x == b.x && a.y == b.y && a.z == b.z && a.lod == b.lod;
+    };
+
+    // Every chunk of every face has four neighbours, and adjacency is mutual
+    std::vector<ChunkCoord> neighbors, back;
+    for (int face = POS_X; face <= NEG_Z; ++face) {
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 4; ++x) {
+                ChunkCoord chunk{x, y, face, 2};
+                layout.GetNeighbors(chunk, neighbors);
+                assert(neighbors.size() == 4);
+                for (const auto& n : neighbors) {
+                    assert(!same(n, chunk));
+                    layout.GetNeighbors(n, back);
+                    bool mutual = false;
+                    for (const auto& b : back) mutual |= same(b, chunk);
+                    assert(mutual);
+                }
+            }
+        }
+    }
+
+    // The +X edge of +Z continues onto +X
+    layout.GetNeighbors({3, 1, POS_Z, 2}, neighbors);
+    assert(neighbors[1].z == POS_X && neighbors[1].x == 0 && neighbors[1].y == 1);
+    std::cout << "[PASS] test_cube_sphere_face_edge_neighbors" << std::endl;
+}
+
+namespace {
+
+// Checks a selection covers the planet once and is restricted
+void CheckPlanetSelection(const CubeSphereLayout& layout, const std::vector<PlanetLODNode>& nodes) {
+    std::unordered_map<uint64_t, const PlanetLODNode*> byKey;
+    double area = 0.0;
+    for (const auto& node : nodes) {
+        byKey[layout.MakeChunkID(node.chunk).value] = &node;
+        area += std::ldexp(1.0, -2 * node.chunk.lod);
+    }
+    assert(byKey.size() == nodes.size());
+    assert(std::abs(area - 6.0) < 1e-9);
+
+    std::vector<ChunkCoord> neighbors;
+    for (const auto& node : nodes) {
+        layout.GetNeighbors(node.chunk, neighbors);
+        for (int e = 0; e < 4; ++e) {
+            int lod = node.neighborLod[e];
+            assert(std::abs(lod - node.chunk.lod) <= 1);
+            assert(((node.stitchMask >> e) & 1) == (lod < node.chunk.lod ? 1 : 0));
+            if (lod < node.chunk.lod) {
+                ChunkCoord coarse{neighbors[e].x >> 1, neighbors[e].y >> 1, neighbors[e].z, lod};
+                assert(byKey.count(layout.MakeChunkID(coarse).value));
+            } else if (lod == node.chunk.lod) {
+                assert(byKey.count(layout.MakeChunkID(neighbors[e]).value));
+            }
+        }
+    }
+}
+
+}
+
+void test_cube_sphere_lod_selection() {
+    CubeSphereLayout layout;
+    layout.radius = 1000.0;
+    PlanetLODParams params;
+    params.maxScreenError = 8.0;
+    params.maxNodes = 4096;
+    CubeSphereLODSelector selector(layout, params);
+
+    // Far away the whole planet is a handful of chunks
+    const auto& far = selector.Select({0.0, 0.0, 1e7});
+    assert(far.size() == 6);
+    CheckPlanetSelection(layout, far);
+
+    // Near the surface detail concentrates under the viewer
+    WorldPos viewer{0.0, 0.0, 1001.0};
+    const auto& near = selector.Select(viewer);
+    CheckPlanetSelection(layout, near);
+    assert(!selector.BudgetReached());
+    assert(selector.ForcedSplitCount() > 0);
+
+    ChunkCoord under = layout.WorldToChunk(viewer, layout.MaxLOD());
+    int underLod = -1;
+    int finest = 0;
+    for (const auto& node : near) {
+        finest = std::max(finest, node.chunk.lod);
+        int up = layout.MaxLOD() - node.chunk.lod;
+        if (node.chunk.z == under.z && node.chunk.x == (under.x >> up) && node.chunk.y == (under.y >> up)) {
+            underLod = node.chunk.lod;
+        }
+    }
+    assert(underLod == finest && finest == layout.MaxLOD());
+    assert(selector.ScreenError(ChunkCoord{0, 0, NEG_Z, 0}, viewer) < selector.ScreenError(under, viewer));
+    std::cout << "[PASS] test_cube_sphere_lod_selection (" << near.size() << " nodes)" << std::endl;
+}
+
+void test_cube_sphere_lod_budget() {
+    // The leaf budget holds whatever the planet radius
+    for (double radius : {1000.0, 6371000.0, 7e8}) {
+        CubeSphereLayout layout;
+        layout.radius = radius;
+        PlanetLODParams params;
+        params.maxNodes = 300;
+        CubeSphereLODSelector selector(layout, params);
+
+        const auto& nodes = selector.Select({0.0, radius + 2.0, 0.0});
+        assert(nodes.size() <= params.maxNodes);
+        assert(selector.BudgetReached());
+        CheckPlanetSelection(layout, nodes);
+    }
+    std::cout << "[PASS] test_cube_sphere_lod_budget" << std::endl;
+}
@@ -17,12 +17,17 @@ Replay binary format (little-endian):
         tickRate:   uint32
         frameCount: uint32
         seed:       uint32
-    Per frame:
+    v3, per frame:
         tick:       uint32
         dataLen:    uint32
         inputData:  dataLen bytes
         stateHash:  uint64
         isSavePoint: uint8 (1 = true, 0 = false)
+    v4 (see engine/sim/ReplayRecorder.h):
+        stream info (16 bytes): blockTicks, baseTick, reserved[2]
+        blocks: 32-byte block header, then frames (tick, dataLen,
+                inputData, stateHash), LZ compressed when flagged
+        index, save-point ticks, 24-byte footer
 """
 
 import struct
@@ -94,6 +99,79 @@ def read_frames(f, frame_count):
     return frames
 
 
+def lz_decompress(src, raw_size):
+    """Decode an asset LZ block (engine/assets/AssetArchive.cpp)."""
+    out = bytearray()
+    ip = 0
+
+    def length(ip, n):
+        while True:
+            b = src[ip]
+            ip += 1
+            n += b
+            if b != 255:
+                return ip, n
+
+    while ip < len(src):
+        token = src[ip]
+        ip += 1
+        lit = token >> 4
+        if lit == 15:
+            ip, lit = length(ip, lit)
+        out += src[ip:ip + lit]
+        ip += lit
+        if ip >= len(src):
+            break
+        offset = src[ip] | (src[ip + 1] << 8)
+        ip += 2
+        match = token & 15
+        if match == 15:
+            ip, match = length(ip, match)
+        for _ in range(match + 4):
+            out.append(out[-offset])
+    if len(out) != raw_size:
+        raise ValueError("corrupt LZ block")
+    return bytes(out)
+
+
+def read_blocks(data):
+    """Read the frames of a v4 replay from every block after the header."""
+    pos = HEADER_SIZE + 16
+    frames = []
+    while pos + 32 <= len(data):
+        magic, first_tick, count, raw_size, stored_size, compression = \
+            struct.unpack_from("<5IB", data, pos)
+        if magic != 0x4B4C4252:
+            break  # index reached
+        stored = data[pos + 32:pos + 32 + stored_size]
+        pos += 32 + stored_size
+        raw = lz_decompress(stored, raw_size) if compression == 1 else stored
+        at = 0
+        for _ in range(count):
+            tick, data_len = struct.unpack_from("<II", raw, at)
+            at += 8
+            input_data = raw[at:at + data_len]
+            at += data_len
+            state_hash = struct.unpack_from("<Q", raw, at)[0]
+            at += 8
+            frames.append({
+                "tick": tick,
+                "inputData": input_data,
+                "stateHash": state_hash,
+                "isSavePoint": False,
+            })
+
+    # Save points follow the index; a file without a footer has none
+    if len(data) >= 24:
+        index_offset, block_count, sp_count, _, magic = struct.unpack_from("<QIIII", data, len(data) - 24)
+        if magic == 0x58444952:
+            sp_at = index_offset + block_count * 16
+            ticks = set(struct.unpack_from(f"<{sp_count}I", data, sp_at))
+            for f in frames:
+                f["isSavePoint"] = f["tick"] in ticks
+    return frames
+
+
 def load_replay(path):
     """Load a replay file, returning (header, frames)."""
     with open(path, "rb") as f:
@@ -101,7 +179,11 @@ def load_replay(path):
         if header is None:
             print(f"Error: invalid replay header in {path}", file=sys.stderr)
             sys.exit(1)
-        frames = read_frames(f, header["frameCount"])
+        if header["version"] >= 4:
+            f.seek(0)
+            frames = read_blocks(f.read())
+        else:
+            frames = read_frames(f, header["frameCount"])
     return header, frames
 
 